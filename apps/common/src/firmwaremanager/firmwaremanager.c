@@ -244,6 +244,27 @@ void firmwaremanager_exit(void)
     instance_l.fInitialized = FALSE;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set the maximum number of parallel firmware transmissions
+
+This function sets the upper limit of firmware image transmissions running in
+parallel. It can be called at runtime, the new limit applies to transmissions
+started afterwards.
+
+\param maxTransmissions_p [in]  Maximum number of parallel transmissions, 0
+                                selects the default value.
+
+\return This functions returns a value of \ref tFirmwareRet.
+
+\ingroup module_app_firmwaremanager
+*/
+//------------------------------------------------------------------------------
+tFirmwareRet firmwaremanager_setMaxParallelTransmissions(UINT maxTransmissions_p)
+{
+    return firmwareupdate_setMaxParallelTransmissions(maxTransmissions_p);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Firmware manager thread
@@ -89,6 +89,7 @@ extern "C"
 
 tFirmwareRet firmwaremanager_init(const char* fwInfoFileName_p);
 void         firmwaremanager_exit(void);
+tFirmwareRet firmwaremanager_setMaxParallelTransmissions(UINT maxTransmissions_p);
 
 tOplkError   firmwaremanager_thread(void);
 
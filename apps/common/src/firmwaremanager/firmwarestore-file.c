@@ -44,6 +44,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -75,26 +82,47 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief Loaded firmware store image
+
+This structure describes the loaded content of a file. It is shared by all
+store instances which refer to the same file, e.g. when several nodes are
+updated with the same firmware image at the same time.
+*/
+typedef struct tFirmwareStoreImage
+{
+    char                        aFilename[FWSTORE_FILEPATH_LENGTH]; ///< File name
+    void*                       pData;                  ///< File data pointer
+    size_t                      dataSize;               ///< File data size
+    BOOL                        fMapped;                ///< Data is mapped instead of allocated
+    UINT                        refCount;               ///< Number of store instances using the image
+    struct tFirmwareStoreImage* pNext;                  ///< Next loaded image
+} tFirmwareStoreImage;
+
 /**
 \brief Firmware store instance
 */
 typedef struct tFirmwareStoreInstance
 {
-    char    aFilename[FWSTORE_FILEPATH_LENGTH];     ///< File name
-    char    aPathToFile[FWSTORE_FILEPATH_LENGTH];   ///< Path to file
-    FILE*   pStorageFd;                             ///< File descriptor
-    void*   pData;                                  ///< File data pointer
-    size_t  dataSize;                               ///< File data size
+    char                    aFilename[FWSTORE_FILEPATH_LENGTH];     ///< File name
+    char                    aPathToFile[FWSTORE_FILEPATH_LENGTH];   ///< Path to file
+    tFirmwareStoreImage*    pImage;                                 ///< Loaded image
 } tFirmwareStoreInstance;
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
 
+static tFirmwareStoreImage* pImageList_l = NULL;    ///< List of loaded images
+
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
 
+static tFirmwareRet acquireImage(const char* pFilename_p,
+                                 tFirmwareStoreImage** ppImage_p);
+static void releaseImage(tFirmwareStoreImage* pImage_p);
+static tFirmwareRet loadImageData(tFirmwareStoreImage* pImage_p);
 static tFirmwareRet allocAndReadData(FILE* pFile_p,
                                      void** ppBuffer_p, size_t* pDataSize_p);
 static tFirmwareRet flushData(tFirmwareStoreHandle pHandle_p);
@@ -139,7 +167,7 @@ tFirmwareRet firmwarestore_create(const tFirmwareStoreConfig* pConfig_p,
     }
 
     memset(instance, 0, sizeof(tFirmwareStoreInstance));
-    strncpy(instance->aFilename, pConfig_p->pFilename, FWSTORE_FILEPATH_LENGTH);
+    strncpy(instance->aFilename, pConfig_p->pFilename, FWSTORE_FILEPATH_LENGTH - 1);
 
     getPathToFile(instance->aFilename, instance->aPathToFile);
 
@@ -170,6 +198,7 @@ tFirmwareRet firmwarestore_destroy (tFirmwareStoreHandle pHandle_p)
     if (pHandle_p == NULL)
     {
         ret = kFwReturnInvalidInstance;
+        goto EXIT;
     }
 
     ret = flushData(pHandle_p);
@@ -179,6 +208,7 @@ tFirmwareRet firmwarestore_destroy (tFirmwareStoreHandle pHandle_p)
         free (pHandle_p);
     }
 
+EXIT:
     return ret;
 }
 
@@ -186,11 +216,15 @@ tFirmwareRet firmwarestore_destroy (tFirmwareStoreHandle pHandle_p)
 /**
 \brief  Load data represented by the firmware store instance
 
-This function acquires necessary resources and frees the data. All
+This function acquires necessary resources and loads the data. All
 acquired resources can be flushed manually by calling
 \ref firmwarestore_flushData, unflushed resources will be freed within
 \ref firmwarestore_destroy.
 
+The file is mapped read-only into memory where the platform supports it, so
+its content is only paged in while it is accessed. Instances referring to the
+same file share a single mapping.
+
 \param pHandle_p [in] Handle of the firmware store module
 
 \return This functions returns a value of \ref tFirmwareRet.
@@ -208,15 +242,11 @@ tFirmwareRet firmwarestore_loadData(tFirmwareStoreHandle pHandle_p)
         goto EXIT;
     }
 
-    pHandle_p->pStorageFd = fopen(pHandle_p->aFilename, FWSTORE_READ_MODE);
-    if (pHandle_p->pStorageFd == NULL)
+    if (pHandle_p->pImage == NULL)
     {
-        ret = kFwReturnFileOperationFailed;
-        goto EXIT;
+        ret = acquireImage(pHandle_p->aFilename, &pHandle_p->pImage);
     }
 
-    ret = allocAndReadData(pHandle_p->pStorageFd, &pHandle_p->pData, &pHandle_p->dataSize);
-
 EXIT:
     return ret;
 }
@@ -255,7 +285,8 @@ tFirmwareRet firmwarestore_flushData(tFirmwareStoreHandle pHandle_p)
 \brief  Access the data provided by the firmware store instance
 
 This function provides access to the data represented by the firmware store
-module.
+module. The returned buffer is read-only and may be shared with other store
+instances referring to the same file.
 
 \param pHandle_p [in] Handle of the firmware store module
 \param ppData_p [out] Pointer which will be filled with the data buffer
@@ -283,15 +314,15 @@ tFirmwareRet firmwarestore_getData(tFirmwareStoreHandle pHandle_p,
         goto EXIT;
     }
 
-    if (pHandle_p->pData == NULL)
+    if (pHandle_p->pImage == NULL)
     {
-        ret = allocAndReadData(pHandle_p->pStorageFd, &pHandle_p->pData, &pHandle_p->dataSize);
+        ret = acquireImage(pHandle_p->aFilename, &pHandle_p->pImage);
     }
 
     if (ret == kFwReturnOk)
     {
-        *ppData_p = pHandle_p->pData;
-        *pDataSize_p = pHandle_p->dataSize;
+        *ppData_p = pHandle_p->pImage->pData;
+        *pDataSize_p = pHandle_p->pImage->dataSize;
     }
 
 EXIT:
@@ -342,6 +373,175 @@ EXIT:
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Acquire a loaded image
+
+The function returns the already loaded image of the given file or loads it if
+no other store instance uses it yet.
+
+\param pFilename_p [in] File name
+\param ppImage_p [out]  Pointer which will be filled with the image
+
+\return This functions returns a value of \ref tFirmwareRet.
+*/
+//------------------------------------------------------------------------------
+static tFirmwareRet acquireImage(const char* pFilename_p,
+                                 tFirmwareStoreImage** ppImage_p)
+{
+    tFirmwareRet            ret = kFwReturnOk;
+    tFirmwareStoreImage*    pImage;
+
+    for (pImage = pImageList_l; pImage != NULL; pImage = pImage->pNext)
+    {
+        if (strcmp(pImage->aFilename, pFilename_p) == 0)
+        {
+            pImage->refCount++;
+            *ppImage_p = pImage;
+            goto EXIT;
+        }
+    }
+
+    pImage = malloc(sizeof(tFirmwareStoreImage));
+    if (pImage == NULL)
+    {
+        ret = kFwReturnNoResource;
+        goto EXIT;
+    }
+
+    memset(pImage, 0, sizeof(tFirmwareStoreImage));
+    strncpy(pImage->aFilename, pFilename_p, FWSTORE_FILEPATH_LENGTH - 1);
+
+    ret = loadImageData(pImage);
+    if (ret != kFwReturnOk)
+    {
+        free(pImage);
+        goto EXIT;
+    }
+
+    pImage->refCount = 1u;
+    pImage->pNext = pImageList_l;
+    pImageList_l = pImage;
+
+    *ppImage_p = pImage;
+
+EXIT:
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release a loaded image
+
+The function drops a reference of the given image. The image data is unmapped
+or freed when the last store instance releases it.
+
+\param pImage_p [in]    Image to be released
+*/
+//------------------------------------------------------------------------------
+static void releaseImage(tFirmwareStoreImage* pImage_p)
+{
+    tFirmwareStoreImage** ppIter;
+
+    pImage_p->refCount--;
+    if (pImage_p->refCount == 0u)
+    {
+        for (ppIter = &pImageList_l; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+        {
+            if (*ppIter == pImage_p)
+            {
+                *ppIter = pImage_p->pNext;
+                break;
+            }
+        }
+
+#if !defined(_WIN32)
+        if (pImage_p->fMapped)
+        {
+            (void)munmap(pImage_p->pData, pImage_p->dataSize);
+        }
+        else
+#endif
+        {
+            free(pImage_p->pData);
+        }
+
+        free(pImage_p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load the data of an image
+
+The function maps the image file read-only into memory. The mapping is
+advised for sequential access, so the file is read ahead while the data is
+transmitted. If the file can't be mapped (e.g. it is empty or the platform
+doesn't support it) the data is read into an allocated buffer instead.
+
+\param pImage_p [in, out]   Image to be loaded
+
+\return This functions returns a value of \ref tFirmwareRet.
+*/
+//------------------------------------------------------------------------------
+static tFirmwareRet loadImageData(tFirmwareStoreImage* pImage_p)
+{
+    tFirmwareRet    ret = kFwReturnOk;
+    FILE*           pFile;
+#if !defined(_WIN32)
+    int             fd;
+    struct stat     fileStat;
+    void*           pMap = MAP_FAILED;
+
+    fd = open(pImage_p->aFilename, O_RDONLY);
+    if (fd < 0)
+    {
+        ret = kFwReturnFileOperationFailed;
+        goto EXIT;
+    }
+
+    if ((fstat(fd, &fileStat) == 0) && (fileStat.st_size > 0))
+    {
+        pMap = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    close(fd);
+
+    if (pMap != MAP_FAILED)
+    {
+        (void)posix_madvise(pMap, (size_t)fileStat.st_size, POSIX_MADV_SEQUENTIAL);
+
+        pImage_p->pData = pMap;
+        pImage_p->dataSize = (size_t)fileStat.st_size;
+        pImage_p->fMapped = TRUE;
+        goto EXIT;
+    }
+#endif
+
+    pFile = fopen(pImage_p->aFilename, FWSTORE_READ_MODE);
+    if (pFile == NULL)
+    {
+        ret = kFwReturnFileOperationFailed;
+        goto EXIT;
+    }
+
+    ret = allocAndReadData(pFile, &pImage_p->pData, &pImage_p->dataSize);
+
+    if (fclose(pFile) != 0)
+    {
+        ret = kFwReturnFileOperationFailed;
+    }
+
+    if (ret != kFwReturnOk)
+    {
+        free(pImage_p->pData);
+        pImage_p->pData = NULL;
+    }
+
+EXIT:
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Allocate buffer and read data from file
@@ -415,27 +615,13 @@ EXIT:
 //------------------------------------------------------------------------------
 static tFirmwareRet flushData(tFirmwareStoreHandle pHandle_p)
 {
-    tFirmwareRet    ret = kFwReturnOk;
-    int             result;
-
-    if (pHandle_p->pStorageFd != NULL)
+    if (pHandle_p->pImage != NULL)
     {
-        result = fclose(pHandle_p->pStorageFd);
-
-        if (result == 0)
-        {
-            pHandle_p->pStorageFd = NULL;
-        }
-        else
-        {
-            ret = kFwReturnFileOperationFailed;
-        }
+        releaseImage(pHandle_p->pImage);
+        pHandle_p->pImage = NULL;
     }
 
-    free(pHandle_p->pData);
-    pHandle_p->pData = NULL;
-
-    return ret;
+    return kFwReturnOk;
 }
 
 //------------------------------------------------------------------------------
@@ -48,6 +48,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdio.h>
 #include <errno.h>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -78,7 +84,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define FIRMWARE_UPDATE_INVALID_SDO     ((tSdoComConHdl)-1) ///< Invalid SDO handle
 
 #if !defined(FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS)
-#define FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS 5        ///< Number of parallel transmissions of firmware images
+#define FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS 5        ///< Default maximum number of parallel transmissions of firmware images
+#endif
+
+#if !defined(FIRMWARE_UPDATE_THROUGHPUT_WINDOW_MS)
+#define FIRMWARE_UPDATE_THROUGHPUT_WINDOW_MS 2000           ///< Minimum period for measuring the transmission throughput [ms]
 #endif
 
 //------------------------------------------------------------------------------
@@ -107,6 +117,12 @@ typedef struct
     tFirmwareUpdateTransmissionInfo aTransmissions[FIRMWARE_UPDATE_MAX_NODE_ID]; ///< Node transmission array
     size_t                          numberOfStartedTransmissions;   ///< Number of started transmissions
     size_t                          numberOfFinishedTransmissions;  ///< Number of finished/aborted transmissions
+    UINT                            maxParallelTransmissions;       ///< Upper limit of parallel transmissions
+    UINT                            parallelTransmissionLimit;      ///< Current limit of parallel transmissions
+    BOOL                            fIncreaseLimit;                 ///< Direction of the next limit adaption
+    UINT32                          windowStartTime;                ///< Start time of the throughput measurement [ms]
+    ULONGLONG                       windowBytes;                    ///< Bytes transferred in the measurement period
+    ULONGLONG                       lastThroughput;                 ///< Throughput of the last measurement period [bytes/s]
 } tFirmwareUpdateInstance;
 
 //------------------------------------------------------------------------------
@@ -131,6 +147,10 @@ static tFirmwareRet transmissionSucceeded(tFirmwareUpdateTransmissionInfo* pInfo
 static void cleanupTransmission(tFirmwareUpdateTransmissionInfo* pInfo_p);
 static void cleanupInstance(void);
 static BOOL isTransmissionAllowed(tFirmwareUpdateTransmissionInfo* pInfo_p);
+static void startPendingTransmissions(void);
+static void adaptParallelTransmissionLimit(const tFirmwareUpdateTransmissionInfo* pInfo_p,
+                                           BOOL fSucceeded_p);
+static UINT32 getTickCount(void);
 
 static tFirmwareUpdateTransmissionInfo* getNextPendingTransmission(void);
 
@@ -166,6 +186,14 @@ tFirmwareRet firmwareupdate_init(const tFirmwareUpdateConfig* pConfig_p)
 
     memcpy(&instance_l.config, pConfig_p, sizeof(tFirmwareUpdateConfig));
 
+    instance_l.maxParallelTransmissions = pConfig_p->maxParallelTransmissions;
+    if (instance_l.maxParallelTransmissions == 0u)
+    {
+        instance_l.maxParallelTransmissions = FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS;
+    }
+
+    instance_l.parallelTransmissionLimit = instance_l.maxParallelTransmissions;
+
     instance_l.fInitialized = TRUE;
 
 EXIT:
@@ -295,6 +323,8 @@ tFirmwareRet firmwareupdate_processSdoEvent(const tSdoComFinished* pSdoComFinish
         fSucceeded = FALSE;
     }
 
+    adaptParallelTransmissionLimit(pInfo, fSucceeded);
+
     if (fSucceeded)
     {
         ret = transmissionSucceeded(pInfo);
@@ -306,6 +336,8 @@ tFirmwareRet firmwareupdate_processSdoEvent(const tSdoComFinished* pSdoComFinish
 
     ret = startTransmission(pInfo);
 
+    startPendingTransmissions();
+
 EXIT:
     if (ret != kFwReturnOk)
     {
@@ -367,6 +399,47 @@ EXIT:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set the maximum number of parallel transmissions
+
+This function sets the upper limit of parallel firmware image transmissions.
+Within this limit the module adapts the number of parallel transmissions to the
+measured SDO throughput. Transmissions which are already running are not
+affected, the new limit applies to the transmissions started afterwards.
+
+\param maxTransmissions_p [in]  Maximum number of parallel transmissions, 0
+                                selects the default value.
+
+\return This functions returns a value of \ref tFirmwareRet.
+
+\ingroup module_app_firmwaremanager
+*/
+//------------------------------------------------------------------------------
+tFirmwareRet firmwareupdate_setMaxParallelTransmissions(UINT maxTransmissions_p)
+{
+    tFirmwareRet ret = kFwReturnOk;
+
+    if (!instance_l.fInitialized)
+    {
+        ret = kFwReturnInvalidInstance;
+        goto EXIT;
+    }
+
+    if (maxTransmissions_p == 0u)
+    {
+        maxTransmissions_p = FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS;
+    }
+
+    instance_l.maxParallelTransmissions = maxTransmissions_p;
+    instance_l.parallelTransmissionLimit = maxTransmissions_p;
+    instance_l.fIncreaseLimit = FALSE;
+    instance_l.lastThroughput = 0u;
+
+EXIT:
+    return ret;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -506,6 +579,13 @@ static tFirmwareRet transmitFirmware(tFirmwareUpdateTransmissionInfo* pInfo_p)
         goto EXIT;
     }
 
+    if (instance_l.numberOfStartedTransmissions == instance_l.numberOfFinishedTransmissions)
+    {
+        // Restart the throughput measurement, idle periods must not count
+        instance_l.windowStartTime = getTickCount();
+        instance_l.windowBytes = 0u;
+    }
+
     instance_l.numberOfStartedTransmissions++;
     pInfo_p->fTranmissionActive = TRUE;
 
@@ -558,8 +638,13 @@ static tFirmwareRet startTransmission(tFirmwareUpdateTransmissionInfo* pInfo_p)
 //------------------------------------------------------------------------------
 static void transmissionFailed(tFirmwareUpdateTransmissionInfo* pInfo_p)
 {
+    // Transmissions which failed to start were never counted as started
+    if (pInfo_p->fTranmissionActive)
+    {
+        instance_l.numberOfFinishedTransmissions++;
+    }
+
     pInfo_p->fTranmissionActive = FALSE;
-    instance_l.numberOfFinishedTransmissions++;
 
     if (pInfo_p->pUpdateList->fIsNode)
     {
@@ -584,8 +669,7 @@ static void transmissionFailed(tFirmwareUpdateTransmissionInfo* pInfo_p)
 //------------------------------------------------------------------------------
 static tFirmwareRet transmissionSucceeded(tFirmwareUpdateTransmissionInfo* pInfo_p)
 {
-    tFirmwareRet                        ret = kFwReturnOk;
-    tFirmwareUpdateTransmissionInfo*    pNextInfo;
+    tFirmwareRet ret = kFwReturnOk;
 
     FWM_TRACE("Update finished for node: %u index: 0x%x subindex: 0x%x\n",
               pInfo_p->pUpdateList->nodeId, pInfo_p->pUpdateList->index,
@@ -613,18 +697,6 @@ static tFirmwareRet transmissionSucceeded(tFirmwareUpdateTransmissionInfo* pInfo
 
     instance_l.numberOfFinishedTransmissions++;
 
-    if (pInfo_p->pUpdateList->pNext == NULL)
-    {
-        pNextInfo = getNextPendingTransmission();
-
-        if (pNextInfo != NULL)
-        {
-            FWM_TRACE("Start next pending transmission for node 0x%X\n",
-                      pNextInfo->pUpdateList->nodeId);
-            startTransmission(pNextInfo);
-        }
-    }
-
     cleanupTransmission(pInfo_p);
 
     return ret;
@@ -674,6 +746,14 @@ static void cleanupInstance(void)
     }
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get next pending transmission
+
+\return This functions returns a pointer to the transmission information of
+        the next node with pending updates or NULL if there is none.
+*/
+//------------------------------------------------------------------------------
 static tFirmwareUpdateTransmissionInfo* getNextPendingTransmission(void)
 {
     tFirmwareUpdateTransmissionInfo*    pInfo = NULL;
@@ -708,8 +788,130 @@ static BOOL isTransmissionAllowed(tFirmwareUpdateTransmissionInfo* pInfo_p)
 
     UNUSED_PARAMETER(pInfo_p);
 
-    return (numberOfActiveTransmissions < FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS);
+    return (numberOfActiveTransmissions < instance_l.parallelTransmissionLimit);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start pending transmissions
+
+The function starts postponed transmissions as long as the current limit of
+parallel transmissions allows it.
+*/
+//------------------------------------------------------------------------------
+static void startPendingTransmissions(void)
+{
+    tFirmwareUpdateTransmissionInfo* pNextInfo;
+
+    while (isTransmissionAllowed(NULL))
+    {
+        pNextInfo = getNextPendingTransmission();
+        if (pNextInfo == NULL)
+        {
+            break;
+        }
+
+        FWM_TRACE("Start next pending transmission for node 0x%X\n",
+                  pNextInfo->pUpdateList->nodeId);
+
+        (void)startTransmission(pNextInfo);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Adapt the limit of parallel transmissions
+
+All transmissions share the asynchronous phase of the POWERLINK cycle, so more
+parallel transmissions don't necessarily transfer more data. They only hold
+more images in memory and delay the completion of each node. Therefore the
+limit is adapted by a hill climbing on the SDO throughput measured over
+periods of at least \ref FIRMWARE_UPDATE_THROUGHPUT_WINDOW_MS. The limit is
+stepped in one direction until the throughput drops noticeably, then the
+direction is reversed. A failed transmission (e.g. an SDO timeout) halves the
+limit.
+
+\param pInfo_p [in]         Pointer to information of the finished transmission
+\param fSucceeded_p [in]    Flag if the transmission succeeded
+*/
+//------------------------------------------------------------------------------
+static void adaptParallelTransmissionLimit(const tFirmwareUpdateTransmissionInfo* pInfo_p,
+                                           BOOL fSucceeded_p)
+{
+    UINT32      now = getTickCount();
+    UINT32      elapsed;
+    ULONGLONG   throughput;
+
+    if (!fSucceeded_p)
+    {
+        instance_l.parallelTransmissionLimit = (instance_l.parallelTransmissionLimit + 1u) / 2u;
+        instance_l.fIncreaseLimit = FALSE;
+        instance_l.lastThroughput = 0u;
+        instance_l.windowStartTime = now;
+        instance_l.windowBytes = 0u;
+        goto EXIT;
+    }
+
+    instance_l.windowBytes += pInfo_p->firmwareSize;
+
+    elapsed = now - instance_l.windowStartTime;
+    if (elapsed < FIRMWARE_UPDATE_THROUGHPUT_WINDOW_MS)
+    {
+        goto EXIT;
+    }
+
+    throughput = (instance_l.windowBytes * 1000u) / elapsed;
+
+    // Turn around if the last step reduced the throughput by more than 1/8
+    if (throughput < (instance_l.lastThroughput - (instance_l.lastThroughput / 8u)))
+    {
+        instance_l.fIncreaseLimit = !instance_l.fIncreaseLimit;
+    }
+
+    if (instance_l.fIncreaseLimit)
+    {
+        if (instance_l.parallelTransmissionLimit < instance_l.maxParallelTransmissions)
+        {
+            instance_l.parallelTransmissionLimit++;
+        }
+    }
+    else
+    {
+        if (instance_l.parallelTransmissionLimit > 1u)
+        {
+            instance_l.parallelTransmissionLimit--;
+        }
+    }
+
+    FWM_TRACE("Throughput %lu bytes/s, parallel transmission limit %u\n",
+              (unsigned long)throughput, instance_l.parallelTransmissionLimit);
+
+    instance_l.lastThroughput = throughput;
+    instance_l.windowStartTime = now;
+    instance_l.windowBytes = 0u;
+
+EXIT:
+    return;
+}
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get tick count
+
+\return This functions returns the current tick count in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT32 getTickCount(void)
+{
+#if defined(_WIN32)
+    return (UINT32)GetTickCount();
+#else
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (UINT32)((now.tv_sec * 1000) + (now.tv_nsec / 1000000));
+#endif
 }
 
 /// \}
@@ -85,6 +85,7 @@ typedef struct
     tFirmwareUpdateNodeCb pfnNodeUpdateComplete;    ///< Node update complete callback
     tFirmwareUpdateNodeCb pfnModuleUpdateComplete;  ///< Modules of a node update complete callback
     tFirmwareUpdateNodeCb pfnError;                 ///< Node update error callback
+    UINT                  maxParallelTransmissions; ///< Maximum number of parallel transmissions (0 = default)
 } tFirmwareUpdateConfig;
 
 /**
@@ -120,6 +121,7 @@ tFirmwareRet    firmwareupdate_processUpdateList(tFirmwareUpdateList* ppList_p);
 tFirmwareRet    firmwareupdate_processSdoEvent(const tSdoComFinished* pSdoComFinished_p);
 tFirmwareRet    firmwareupdate_getTransmissionStatus(UINT nodeId_p,
                                                      tFirmwareUpdateTransmissionStatus* pStatus_p);
+tFirmwareRet    firmwareupdate_setMaxParallelTransmissions(UINT maxTransmissions_p);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,436 @@
+/**
+********************************************************************************
+\file   main.c
+
+\brief  Main file of the network simulator
+
+This file contains the main file of the openPOWERLINK network simulator. It
+runs one MN and up to 239 CNs in a single process on a virtual clock and
+reports the boot time, the SDO throughput and the PDO latency of the network.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simengine.h"
+#include "simnode.h"
+#include "simnet.h"
+#include "simcdc.h"
+#include "simbench.h"
+
+#include <getopt/getopt.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define DEFAULT_CN_COUNT            3
+#define DEFAULT_HOP_DELAY           500         // [ns]
+#define DEFAULT_CN_TX_LATENCY       1000        // [ns]
+#define DEFAULT_DURATION            10          // [s]
+#define DEFAULT_SDO_PARALLEL        4
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    UINT            cnCount;
+    UINT32          cycleLen;
+    tSimNetConfig   netConfig;
+    UINT            duration;
+    UINT            sdoParallel;
+    BOOL            fVerbose;
+    char            aModuleDir[1024];
+} tOptions;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT8*   pCdc_l = NULL;      // Network configuration, used by the MN until it is destroyed
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static int          getOptions(int argc_p,
+                               char* const argv_p[],
+                               tOptions* pOpts_p);
+static tOplkError   initNetwork(const tOptions* pOpts_p);
+static void         printStatistics(double wallTime_p);
+static double       getWallTime(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  main function
+
+This is the main function of the openPOWERLINK network simulator.
+
+\param[in]      argc                Number of arguments
+\param[in]      argv                Pointer to argument strings
+
+\return Returns an exit code
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    tOplkError  ret;
+    tOptions    opts;
+    double      startTime;
+
+    if (getOptions(argc, argv, &opts) < 0)
+        return 1;
+
+    printf("----------------------------------------------------\n");
+    printf("openPOWERLINK network simulator\n");
+    printf("----------------------------------------------------\n");
+
+    startTime = getWallTime();
+
+    ret = initNetwork(&opts);
+    if (ret == kErrorOk)
+    {
+        simengine_run((UINT64)opts.duration * 1000000000ULL);
+        simbench_report();
+        printStatistics(getWallTime() - startTime);
+    }
+    else
+        fprintf(stderr, "Initializing the simulation failed with 0x%X\n", ret);
+
+    simbench_exit();
+    simnode_exit();
+    simcdc_free(pCdc_l);
+    simnet_exit();
+    simengine_exit();
+
+    return (ret == kErrorOk) ? 0 : 1;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the simulated network
+
+The function sets up the engine, the network and the nodes, creates the stacks
+of all nodes with the generated network configuration and boots them.
+
+\param[in]      pOpts_p             Command line options
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError initNetwork(const tOptions* pOpts_p)
+{
+    tOplkError      ret;
+    tSimCdcConfig   cdcConfig;
+    tSimNodeConfig  nodeConfig;
+    tSimBenchConfig benchConfig;
+    size_t          cdcSize;
+    UINT            nodeIndex;
+
+    ret = simengine_init();
+    if (ret != kErrorOk)
+        goto Exit;
+
+    ret = simnet_init(&pOpts_p->netConfig);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    memset(&cdcConfig, 0, sizeof(cdcConfig));
+    cdcConfig.cnCount = pOpts_p->cnCount;
+    cdcConfig.pdoCnCount = (pOpts_p->cnCount < SIMCDC_MAX_PDO_CN) ? pOpts_p->cnCount : SIMCDC_MAX_PDO_CN;
+    cdcConfig.cycleLen = pOpts_p->cycleLen;
+    simcdc_calcTiming(&cdcConfig, pOpts_p->netConfig.cnTxLatency);
+
+    ret = simcdc_build(&cdcConfig, &pCdc_l, &cdcSize);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    memset(&benchConfig, 0, sizeof(benchConfig));
+    benchConfig.cnCount = pOpts_p->cnCount;
+    benchConfig.pdoCnCount = cdcConfig.pdoCnCount;
+    benchConfig.sdoParallel = pOpts_p->sdoParallel;
+    benchConfig.fVerbose = pOpts_p->fVerbose;
+    ret = simbench_init(&benchConfig);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    memset(&nodeConfig, 0, sizeof(nodeConfig));
+    nodeConfig.pModuleDir = pOpts_p->aModuleDir;
+    nodeConfig.cnCount = pOpts_p->cnCount;
+    nodeConfig.cycleLen = cdcConfig.cycleLen;
+    nodeConfig.asyncSlotTimeout = cdcConfig.asyncSlotTimeout;
+    nodeConfig.fVerbose = pOpts_p->fVerbose;
+    nodeConfig.pfnCbEvent = simbench_cbEvent;
+    nodeConfig.pfnCbSync = simbench_cbSync;
+    ret = simnode_init(&nodeConfig);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    printf("Network:         1 MN, %u CNs (%u with PDO), %s topology\n",
+           pOpts_p->cnCount, cdcConfig.pdoCnCount,
+           (pOpts_p->netConfig.topology == kSimNetTopologyLine) ? "line" : "hub");
+    printf("Cycle:           %u us, async slot timeout %u ns\n",
+           cdcConfig.cycleLen, cdcConfig.asyncSlotTimeout);
+    printf("Configuration:   %lu bytes\n", (unsigned long)cdcSize);
+
+    for (nodeIndex = 0; nodeIndex < simnode_getCount(); nodeIndex++)
+    {
+        if (nodeIndex == SIMNODE_MN_INDEX)
+            ret = simnode_create(nodeIndex, pCdc_l, cdcSize);
+        else
+            ret = simnode_create(nodeIndex, NULL, 0);
+        if (ret != kErrorOk)
+            goto Exit;
+
+        ret = simbench_setupProcessImage(nodeIndex);
+        if (ret != kErrorOk)
+            goto Exit;
+    }
+
+    for (nodeIndex = 0; nodeIndex < simnode_getCount(); nodeIndex++)
+    {
+        ret = simnode_boot(nodeIndex);
+        if (ret != kErrorOk)
+            goto Exit;
+    }
+
+Exit:
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print the simulation statistics
+
+\param[in]      wallTime_p          Wall clock time of the simulation [s]
+*/
+//------------------------------------------------------------------------------
+static void printStatistics(double wallTime_p)
+{
+    tSimNetStatistics   statistics;
+    double              simTime = simengine_getTime() / 1e9;
+
+    simnet_getStatistics(&statistics);
+
+    printf("\nNetwork\n");
+    printf("  Frames                %llu sent (%llu bytes), %llu received, %llu filtered\n",
+           (unsigned long long)statistics.txFrames,
+           (unsigned long long)statistics.txBytes,
+           (unsigned long long)statistics.rxFrames,
+           (unsigned long long)statistics.filteredFrames);
+    printf("  Collisions            %llu\n", (unsigned long long)statistics.collisions);
+
+    printf("\nSimulation\n");
+    printf("  Virtual time          %.3f s\n", simTime);
+    printf("  Wall clock time       %.3f s\n", wallTime_p);
+    printf("  Speed                 %.2f x real time\n", (wallTime_p > 0.0) ? (simTime / wallTime_p) : 0.0);
+    printf("  Events                %llu\n", (unsigned long long)simengine_getEventCount());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the wall clock time
+
+\return The function returns the monotonic wall clock time in seconds.
+*/
+//------------------------------------------------------------------------------
+static double getWallTime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get command line parameters
+
+The function parses the supplied command line parameters and stores the
+options at pOpts_p.
+
+\param[in]      argc_p              Argument count.
+\param[in]      argv_p              Pointer to arguments.
+\param[out]     pOpts_p             Pointer to store options
+
+\return The function returns the parsing status.
+\retval 0           Successfully parsed
+\retval -1          Parsing error
+*/
+//------------------------------------------------------------------------------
+static int getOptions(int argc_p,
+                      char* const argv_p[],
+                      tOptions* pOpts_p)
+{
+    int     opt;
+    ssize_t len;
+    char*   pSeparator;
+
+    /* setup default parameters */
+    memset(pOpts_p, 0, sizeof(tOptions));
+    pOpts_p->cnCount = DEFAULT_CN_COUNT;
+    pOpts_p->netConfig.topology = kSimNetTopologyHub;
+    pOpts_p->netConfig.hopDelay = DEFAULT_HOP_DELAY;
+    pOpts_p->netConfig.cnTxLatency = DEFAULT_CN_TX_LATENCY;
+    pOpts_p->netConfig.fRxFilter = TRUE;
+    pOpts_p->duration = DEFAULT_DURATION;
+    pOpts_p->sdoParallel = DEFAULT_SDO_PARALLEL;
+
+    // The node modules are installed next to the executable
+    len = readlink("/proc/self/exe", pOpts_p->aModuleDir, sizeof(pOpts_p->aModuleDir) - 1);
+    if (len > 0)
+    {
+        pOpts_p->aModuleDir[len] = '\0';
+        pSeparator = strrchr(pOpts_p->aModuleDir, '/');
+        if (pSeparator != NULL)
+            *pSeparator = '\0';
+    }
+    else
+        strncpy(pOpts_p->aModuleDir, ".", sizeof(pOpts_p->aModuleDir));
+
+    /* get command line parameters */
+    while ((opt = getopt(argc_p, argv_p, "n:c:t:d:l:s:p:m:fv")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                pOpts_p->cnCount = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'c':
+                pOpts_p->cycleLen = strtoul(optarg, NULL, 10);
+                break;
+
+            case 't':
+                if (strcmp(optarg, "line") == 0)
+                    pOpts_p->netConfig.topology = kSimNetTopologyLine;
+                else if (strcmp(optarg, "hub") == 0)
+                    pOpts_p->netConfig.topology = kSimNetTopologyHub;
+                else
+                    opt = '?';
+                break;
+
+            case 'd':
+                pOpts_p->netConfig.hopDelay = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'l':
+                pOpts_p->netConfig.cnTxLatency = strtoul(optarg, NULL, 10);
+                break;
+
+            case 's':
+                pOpts_p->duration = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'p':
+                pOpts_p->sdoParallel = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'm':
+                strncpy(pOpts_p->aModuleDir, optarg, sizeof(pOpts_p->aModuleDir) - 1);
+                break;
+
+            case 'f':
+                pOpts_p->netConfig.fRxFilter = FALSE;
+                break;
+
+            case 'v':
+                pOpts_p->fVerbose = TRUE;
+                break;
+
+            default:
+                break;
+        }
+
+        if ((opt == '?') || (opt == ':'))
+            break;
+    }
+
+    if ((opt != -1) || (pOpts_p->cnCount == 0) || (pOpts_p->cnCount > SIMNODE_MAX_CN))
+    {
+        printf("Usage: %s [-n CN_COUNT] [-c CYCLE_LEN] [-t hub|line] [-d HOP_DELAY] [-l CN_LATENCY]\n"
+               "          [-s DURATION] [-p SDO_PARALLEL] [-m MODULE_DIR] [-f] [-v]\n", argv_p[0]);
+        printf(" -n CN_COUNT: Number of CNs (1 - %u, default %u)\n", SIMNODE_MAX_CN, DEFAULT_CN_COUNT);
+        printf(" -c CYCLE_LEN: Cycle length in us (default: calculated from the network)\n");
+        printf(" -t hub|line: Network topology (default hub)\n");
+        printf(" -d HOP_DELAY: Propagation delay per hub or line hop in ns (default %u)\n", DEFAULT_HOP_DELAY);
+        printf(" -l CN_LATENCY: Tx latency of the CNs in ns (default %u)\n", DEFAULT_CN_TX_LATENCY);
+        printf(" -s DURATION: Simulated time in s (default %u)\n", DEFAULT_DURATION);
+        printf(" -p SDO_PARALLEL: Number of concurrent SDO transfers of the MN (default %u)\n",
+               DEFAULT_SDO_PARALLEL);
+        printf(" -m MODULE_DIR: Directory of the node modules (default: directory of the executable)\n");
+        printf(" -f: Disable the emulation of the PRes Rx filters of the CNs\n");
+        printf(" -v: Print the events and traces of the nodes\n");
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/// \}
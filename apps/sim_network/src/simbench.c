@@ -0,0 +1,855 @@
+/**
+********************************************************************************
+\file   simbench.c
+
+\brief  Benchmarks of the network simulator
+
+This file contains the benchmark application of the network simulator. It
+replaces the demo applications on all simulated nodes and measures
+
+- the boot time of the network, i.e. the virtual time until the NMT states are
+  reached and the configuration manager has configured the CNs,
+- the SDO throughput of the MN, which reads the device name of the CNs with a
+  configurable number of concurrent transfers once the network is operational,
+- the PDO latency: the MN sends a token to every PDO CN, the CN application
+  echoes it. The one-way latency is measured from the MN application to the CN
+  application, the round trip time back to the MN application.
+
+All times are virtual times of the simulation engine.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simbench.h"
+#include "simengine.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMBENCH_SDO_INDEX          0x1008      // NMT_ManufactDevName_VS
+#define SIMBENCH_SDO_SUBINDEX       0x00
+#define SIMBENCH_SDO_BUFFER_SIZE    256
+#define SIMBENCH_SDO_RETRY_DELAY    1000000     // Delay before retrying a rejected SDO transfer [ns]
+#define SIMBENCH_PDO_TIMEOUT        100000000   // Timeout for a PDO token echo [ns]
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief CN boot states
+
+The enumeration lists the NMT states of the CNs which are recorded for the boot
+time measurement.
+*/
+typedef enum
+{
+    kSimBenchStatePreOp1 = 0,           ///< NMT_CS_PRE_OPERATIONAL_1
+    kSimBenchStatePreOp2,               ///< NMT_CS_PRE_OPERATIONAL_2
+    kSimBenchStateReadyToOp,            ///< NMT_CS_READY_TO_OPERATE
+    kSimBenchStateOperational,          ///< NMT_CS_OPERATIONAL
+    kSimBenchStateCount
+} eSimBenchState;
+
+/**
+\brief Statistics of a measured value
+
+The structure accumulates the samples of a measured time.
+*/
+typedef struct
+{
+    UINT64      count;                  ///< Number of samples
+    UINT64      sum;                    ///< Sum of the samples [ns]
+    UINT64      min;                    ///< Minimum sample [ns]
+    UINT64      max;                    ///< Maximum sample [ns]
+} tSimBenchStat;
+
+/**
+\brief Benchmark data of a node
+
+The structure contains the benchmark data of a node. The PDO token data of a
+CN is shared by the MN (sender) and the CN (echo).
+*/
+typedef struct
+{
+    UINT64          aStateTime[kSimBenchStateCount];    ///< Time the boot states were reached first [ns]
+    BOOL            fOperational;                       ///< Node is operational
+    UINT32          cfmBytes;                           ///< Bytes downloaded by the configuration manager
+    UINT8           token;                              ///< Last PDO token sent by the MN
+    BOOL            fTokenPending;                      ///< PDO token is waiting for its echo
+    UINT64          tokenTime;                          ///< Time the PDO token was sent [ns]
+    UINT8           lastToken;                          ///< Last PDO token seen by the CN
+    tSdoComConHdl   sdoComConHdl;                       ///< SDO connection of the MN to the CN
+    BOOL            fSdoConnection;                     ///< SDO connection is defined
+} tSimBenchNode;
+
+/**
+\brief SDO transfer slot
+
+The structure describes one of the concurrent SDO transfers of the MN.
+*/
+typedef struct
+{
+    UINT            nodeId;                             ///< Node ID of the current transfer
+    UINT64          startTime;                          ///< Start time of the current transfer [ns]
+    UINT            size;                               ///< Buffer size of the current transfer
+    UINT8           aData[SIMBENCH_SDO_BUFFER_SIZE];    ///< Transfer buffer
+} tSimBenchSdoSlot;
+
+/**
+\brief Benchmark instance
+
+The structure contains the instance data of the benchmark application.
+*/
+typedef struct
+{
+    tSimBenchConfig     config;                 ///< Benchmark configuration
+    tSimBenchNode*      pNodes;                 ///< Node data, indexed by node index
+    tSimBenchSdoSlot*   pSdoSlots;              ///< SDO transfer slots
+    UINT64              mnOperationalTime;      ///< Time the MN reached NMT_MS_OPERATIONAL [ns]
+    UINT64              networkOperationalTime; ///< Time all CNs were operational [ns]
+    UINT                cnOperationalCount;     ///< Number of operational CNs
+    UINT                cfmCount;               ///< Number of finished CN configurations
+    UINT                cfmErrorCount;          ///< Number of failed CN configurations
+    UINT64              cfmLastTime;            ///< Time of the last finished CN configuration [ns]
+    BOOL                fSdoStarted;            ///< SDO benchmark is running
+    UINT64              sdoStartTime;           ///< Start time of the SDO benchmark [ns]
+    UINT64              sdoBytes;               ///< Bytes read by SDO
+    UINT                sdoAbortCount;          ///< Number of aborted SDO transfers
+    tSimBenchStat       sdoLatency;             ///< Duration of the SDO transfers
+    tSimBenchStat       pdoLatency;             ///< One-way PDO latency MN -> CN
+    tSimBenchStat       pdoRoundTrip;           ///< PDO round trip time MN -> CN -> MN
+    UINT                pdoLostCount;           ///< Number of PDO tokens without echo
+    UINT                errorCount;             ///< Number of critical errors
+    UINT                warningCount;           ///< Number of warnings
+} tSimBenchInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSimBenchInstance    instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void processNmtStateChange(UINT nodeIndex_p,
+                                  tNmtState nmtState_p);
+static void startSdoBenchmark(void);
+static void startSdoTransfer(UINT nodeIndex_p,
+                             UINT64 slot_p,
+                             void* pArg_p);
+static void processSdoFinished(const tSdoComFinished* pSdoInfo_p);
+static void processSyncMn(tSimNode* pNode_p);
+static void processSyncCn(tSimNode* pNode_p);
+static void addSample(tSimBenchStat* pStat_p,
+                      UINT64 value_p);
+static void printStat(const char* pName_p,
+                      const tSimBenchStat* pStat_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the benchmark application
+
+\param[in]      pConfig_p           Benchmark configuration
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simbench_init(const tSimBenchConfig* pConfig_p)
+{
+    memset(&instance_l, 0, sizeof(instance_l));
+    instance_l.config = *pConfig_p;
+
+    if (instance_l.config.sdoParallel > instance_l.config.cnCount)
+        instance_l.config.sdoParallel = instance_l.config.cnCount;
+
+    instance_l.pNodes = (tSimBenchNode*)calloc(pConfig_p->cnCount + 1, sizeof(tSimBenchNode));
+    instance_l.pSdoSlots = (tSimBenchSdoSlot*)calloc(instance_l.config.sdoParallel + 1,
+                                                     sizeof(tSimBenchSdoSlot));
+    if ((instance_l.pNodes == NULL) || (instance_l.pSdoSlots == NULL))
+    {
+        simbench_exit();
+        return kErrorNoResource;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the benchmark application
+
+The function closes the SDO connections of the MN. It must be called before the
+nodes are destroyed.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simbench_exit(void)
+{
+    tSimNode*   pMn = simnode_getNode(SIMNODE_MN_INDEX);
+    UINT        nodeId;
+
+    if (instance_l.pNodes != NULL)
+    {
+        for (nodeId = 1; nodeId <= instance_l.config.cnCount; nodeId++)
+        {
+            if (instance_l.pNodes[nodeId].fSdoConnection && (pMn != NULL))
+                pMn->api.pfnFreeSdoChannel(instance_l.pNodes[nodeId].sdoComConHdl);
+        }
+    }
+
+    free(instance_l.pNodes);
+    free(instance_l.pSdoSlots);
+    memset(&instance_l, 0, sizeof(instance_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up the process image of a node
+
+The function allocates and links the process image of a node after its stack
+was created. The MN exchanges one byte with each PDO CN, a PDO CN one byte with
+the MN.
+
+\param[in]      nodeIndex_p         Index of the node
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simbench_setupProcessImage(UINT nodeIndex_p)
+{
+    tOplkError  ret;
+    tSimNode*   pNode = simnode_getNode(nodeIndex_p);
+    UINT        size;
+    UINT        varEntries;
+
+    if (nodeIndex_p == SIMNODE_MN_INDEX)
+        size = instance_l.config.pdoCnCount;
+    else
+        size = (nodeIndex_p <= instance_l.config.pdoCnCount) ? 1 : 0;
+
+    if (size == 0)
+        return kErrorOk;
+
+    ret = pNode->api.pfnAllocProcessImage(size, size);
+    if (ret != kErrorOk)
+        return ret;
+
+    // Process image offset n - 1 belongs to node ID n
+    varEntries = size;
+    ret = pNode->api.pfnLinkProcessImageObject(pNode->fMn ? 0xA040 : 0x6000,
+                                               1, 0, FALSE, 1, &varEntries);
+    if (ret != kErrorOk)
+        return ret;
+    if (varEntries != size)
+        return kErrorApiPISizeExceeded;
+
+    varEntries = size;
+    ret = pNode->api.pfnLinkProcessImageObject(pNode->fMn ? 0xA4C0 : 0x6200,
+                                               1, 0, TRUE, 1, &varEntries);
+    if (ret != kErrorOk)
+        return ret;
+    if (varEntries != size)
+        return kErrorApiPISizeExceeded;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  API event callback of the nodes
+
+The function is the event callback of all simulated nodes. It records the NMT
+state changes and the configuration results and processes finished SDO
+transfers.
+
+\param[in]      simHdl_p            Node index
+\param[in]      eventType_p         Type of the event
+\param[in]      pEventArg_p         Event argument
+\param[in]      pUserArg_p          User argument (unused)
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simbench_cbEvent(tSimulationInstanceHdl simHdl_p,
+                            tOplkApiEventType eventType_p,
+                            const tOplkApiEventArg* pEventArg_p,
+                            void* pUserArg_p)
+{
+    UNUSED_PARAMETER(pUserArg_p);
+
+    switch (eventType_p)
+    {
+        case kOplkApiEventNmtStateChange:
+            processNmtStateChange(simHdl_p, pEventArg_p->nmtStateChange.newNmtState);
+            break;
+
+        case kOplkApiEventNode:
+            if (instance_l.config.fVerbose)
+            {
+                printf("%10.6f [%3u] Node %u event 0x%02X state 0x%04X\n",
+                       simengine_getTime() / 1e9, (UINT)simHdl_p, pEventArg_p->nodeEvent.nodeId,
+                       pEventArg_p->nodeEvent.nodeEvent, pEventArg_p->nodeEvent.nmtState);
+            }
+            break;
+
+        case kOplkApiEventCfmProgress:
+            if (pEventArg_p->cfmProgress.nodeId <= instance_l.config.cnCount)
+                instance_l.pNodes[pEventArg_p->cfmProgress.nodeId].cfmBytes = pEventArg_p->cfmProgress.bytesDownloaded;
+
+            if (instance_l.config.fVerbose &&
+                ((pEventArg_p->cfmProgress.error != kErrorOk) || (pEventArg_p->cfmProgress.sdoAbortCode != 0)))
+            {
+                printf("%10.6f [%3u] CFM of node %u: 0x%04X/%u returned 0x%04X, SDO abort code 0x%08X\n",
+                       simengine_getTime() / 1e9, (UINT)simHdl_p, pEventArg_p->cfmProgress.nodeId,
+                       pEventArg_p->cfmProgress.objectIndex, pEventArg_p->cfmProgress.objectSubIndex,
+                       pEventArg_p->cfmProgress.error, pEventArg_p->cfmProgress.sdoAbortCode);
+            }
+            break;
+
+        case kOplkApiEventCfmResult:
+            instance_l.cfmCount++;
+            instance_l.cfmLastTime = simengine_getTime();
+            if (pEventArg_p->cfmResult.nodeCommand == kNmtNodeCommandConfErr)
+            {
+                instance_l.cfmErrorCount++;
+                if (instance_l.config.fVerbose)
+                {
+                    printf("%10.6f [%3u] CFM of node %u failed\n",
+                           simengine_getTime() / 1e9, (UINT)simHdl_p, pEventArg_p->cfmResult.nodeId);
+                }
+            }
+            break;
+
+        case kOplkApiEventSdo:
+            if (simHdl_p == SIMNODE_MN_INDEX)
+                processSdoFinished(&pEventArg_p->sdoInfo);
+            break;
+
+        case kOplkApiEventCriticalError:
+            instance_l.errorCount++;
+            if (instance_l.config.fVerbose)
+            {
+                printf("%10.6f [%3u] Critical error 0x%04X\n",
+                       simengine_getTime() / 1e9, (UINT)simHdl_p, pEventArg_p->internalError.oplkError);
+            }
+            break;
+
+        case kOplkApiEventWarning:
+            instance_l.warningCount++;
+            if (instance_l.config.fVerbose)
+            {
+                printf("%10.6f [%3u] Warning 0x%04X\n",
+                       simengine_getTime() / 1e9, (UINT)simHdl_p, pEventArg_p->internalError.oplkError);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process sync callback of the nodes
+
+The function is the synchronous application of all simulated nodes. It sends
+and echoes the PDO tokens.
+
+\param[in]      simHdl_p            Node index
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simbench_cbSync(tSimulationInstanceHdl simHdl_p)
+{
+    tOplkError  ret;
+    tSimNode*   pNode = simnode_getNode(simHdl_p);
+
+    if ((simHdl_p == SIMNODE_MN_INDEX) ?
+        (instance_l.config.pdoCnCount == 0) :
+        (simHdl_p > instance_l.config.pdoCnCount))
+        return kErrorOk;
+
+    ret = pNode->api.pfnExchangeProcessImageOut();
+    if (ret != kErrorOk)
+        return ret;
+
+    if (pNode->fMn)
+        processSyncMn(pNode);
+    else
+        processSyncCn(pNode);
+
+    return pNode->api.pfnExchangeProcessImageIn();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print the benchmark results
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simbench_report(void)
+{
+    static const char*  apStateName[kSimBenchStateCount] =
+    {
+        "PreOperational1",
+        "PreOperational2",
+        "ReadyToOperate",
+        "Operational",
+    };
+    UINT64              first;
+    UINT64              last;
+    UINT64              cfmBytes = 0;
+    UINT                reached;
+    UINT                state;
+    UINT                nodeId;
+    UINT64              duration;
+
+    printf("\nBoot (virtual time of first / last CN)\n");
+    for (state = 0; state < kSimBenchStateCount; state++)
+    {
+        first = SIMENGINE_TIME_INFINITE;
+        last = 0;
+        reached = 0;
+
+        for (nodeId = 1; nodeId <= instance_l.config.cnCount; nodeId++)
+        {
+            UINT64 time = instance_l.pNodes[nodeId].aStateTime[state];
+
+            if (time == 0)
+                continue;
+
+            reached++;
+            if (time < first)
+                first = time;
+            if (time > last)
+                last = time;
+        }
+
+        if (reached == 0)
+            printf("  CN %-18s not reached\n", apStateName[state]);
+        else
+        {
+            printf("  CN %-18s %10.3f ms / %10.3f ms (%u of %u CNs)\n",
+                   apStateName[state], first / 1e6, last / 1e6, reached, instance_l.config.cnCount);
+        }
+    }
+
+    if (instance_l.mnOperationalTime != 0)
+        printf("  MN Operational        %10.3f ms\n", instance_l.mnOperationalTime / 1e6);
+    else
+        printf("  MN Operational        not reached\n");
+
+    if (instance_l.networkOperationalTime != 0)
+        printf("  Network operational   %10.3f ms\n", instance_l.networkOperationalTime / 1e6);
+
+    for (nodeId = 1; nodeId <= instance_l.config.cnCount; nodeId++)
+        cfmBytes += instance_l.pNodes[nodeId].cfmBytes;
+
+    printf("  Configured CNs        %u (%u failed), %llu bytes, last at %.3f ms\n",
+           instance_l.cfmCount, instance_l.cfmErrorCount, (unsigned long long)cfmBytes,
+           instance_l.cfmLastTime / 1e6);
+
+    printf("\nSDO (%u concurrent reads of 0x%04X/%u)\n",
+           instance_l.config.sdoParallel, SIMBENCH_SDO_INDEX, SIMBENCH_SDO_SUBINDEX);
+    if (instance_l.fSdoStarted && (simengine_getTime() > instance_l.sdoStartTime))
+    {
+        duration = simengine_getTime() - instance_l.sdoStartTime;
+        printf("  Transfers             %llu (%u aborted) in %.3f ms\n",
+               (unsigned long long)instance_l.sdoLatency.count, instance_l.sdoAbortCount, duration / 1e6);
+        printf("  Throughput            %.1f transfers/s, %.1f bytes/s\n",
+               instance_l.sdoLatency.count * 1e9 / duration, instance_l.sdoBytes * 1e9 / duration);
+        printStat("Transfer time", &instance_l.sdoLatency);
+    }
+    else
+        printf("  not started (network not operational)\n");
+
+    printf("\nPDO (%u CNs)\n", instance_l.config.pdoCnCount);
+    printStat("One-way latency", &instance_l.pdoLatency);
+    printStat("Round trip time", &instance_l.pdoRoundTrip);
+    printf("  Lost tokens           %u\n", instance_l.pdoLostCount);
+
+    printf("\nErrors                  %u critical errors, %u warnings\n",
+           instance_l.errorCount, instance_l.warningCount);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process an NMT state change
+
+\param[in]      nodeIndex_p         Index of the node
+\param[in]      nmtState_p          New NMT state of the node
+*/
+//------------------------------------------------------------------------------
+static void processNmtStateChange(UINT nodeIndex_p,
+                                  tNmtState nmtState_p)
+{
+    tSimBenchNode*  pBenchNode = &instance_l.pNodes[nodeIndex_p];
+    UINT64          now = simengine_getTime();
+    int             state = -1;
+
+    if (instance_l.config.fVerbose)
+        printf("%10.6f [%3u] NMT state 0x%04X\n", now / 1e9, nodeIndex_p, nmtState_p);
+
+    if (nodeIndex_p == SIMNODE_MN_INDEX)
+    {
+        if ((nmtState_p == kNmtMsOperational) && (instance_l.mnOperationalTime == 0))
+        {
+            instance_l.mnOperationalTime = now;
+            startSdoBenchmark();
+        }
+        return;
+    }
+
+    switch (nmtState_p)
+    {
+        case kNmtCsPreOperational1:
+            state = kSimBenchStatePreOp1;
+            break;
+
+        case kNmtCsPreOperational2:
+            state = kSimBenchStatePreOp2;
+            break;
+
+        case kNmtCsReadyToOperate:
+            state = kSimBenchStateReadyToOp;
+            break;
+
+        case kNmtCsOperational:
+            state = kSimBenchStateOperational;
+            break;
+
+        default:
+            break;
+    }
+
+    if ((state >= 0) && (pBenchNode->aStateTime[state] == 0))
+        pBenchNode->aStateTime[state] = now;
+
+    if ((nmtState_p == kNmtCsOperational) && !pBenchNode->fOperational)
+    {
+        pBenchNode->fOperational = TRUE;
+        instance_l.cnOperationalCount++;
+        if ((instance_l.cnOperationalCount == instance_l.config.cnCount) &&
+            (instance_l.networkOperationalTime == 0))
+        {
+            instance_l.networkOperationalTime = now;
+            startSdoBenchmark();
+        }
+    }
+    else if ((nmtState_p != kNmtCsOperational) && pBenchNode->fOperational)
+    {
+        pBenchNode->fOperational = FALSE;
+        instance_l.cnOperationalCount--;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start the SDO benchmark
+
+The function starts the concurrent SDO transfers of the MN as soon as the MN
+and all CNs are operational. Slot s reads from the node IDs s + 1,
+s + 1 + n, s + 1 + 2n, ... for n concurrent transfers, so the slots never
+access the same CN.
+*/
+//------------------------------------------------------------------------------
+static void startSdoBenchmark(void)
+{
+    UINT    slot;
+
+    if (instance_l.fSdoStarted ||
+        (instance_l.mnOperationalTime == 0) ||
+        (instance_l.networkOperationalTime == 0))
+        return;
+
+    instance_l.fSdoStarted = TRUE;
+    instance_l.sdoStartTime = simengine_getTime();
+
+    // The transfers are started from the engine, not from the event callback
+    for (slot = 0; slot < instance_l.config.sdoParallel; slot++)
+    {
+        instance_l.pSdoSlots[slot].nodeId = slot + 1;
+        simengine_schedule(instance_l.sdoStartTime, startSdoTransfer, SIMNODE_MN_INDEX, slot, NULL);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start an SDO transfer
+
+The function is an event handler of the simulation engine. It starts the next
+SDO transfer of a slot.
+
+\param[in]      nodeIndex_p         Index of the MN
+\param[in]      slot_p              SDO transfer slot
+\param[in]      pArg_p              Unused
+*/
+//------------------------------------------------------------------------------
+static void startSdoTransfer(UINT nodeIndex_p,
+                             UINT64 slot_p,
+                             void* pArg_p)
+{
+    tOplkError          ret;
+    tSimNode*           pMn = simnode_getNode(nodeIndex_p);
+    tSimBenchSdoSlot*   pSlot = &instance_l.pSdoSlots[slot_p];
+    tSimBenchNode*      pBenchNode = &instance_l.pNodes[pSlot->nodeId];
+
+    UNUSED_PARAMETER(pArg_p);
+
+    pSlot->startTime = simengine_getTime();
+    pSlot->size = sizeof(pSlot->aData);
+
+    ret = pMn->api.pfnReadObject(&pBenchNode->sdoComConHdl,
+                                 pSlot->nodeId,
+                                 SIMBENCH_SDO_INDEX,
+                                 SIMBENCH_SDO_SUBINDEX,
+                                 pSlot->aData,
+                                 &pSlot->size,
+                                 kSdoTypeAsnd,
+                                 pSlot);
+    if (ret == kErrorApiTaskDeferred)
+    {
+        pBenchNode->fSdoConnection = TRUE;
+        simnode_process(pMn);
+    }
+    else
+    {
+        // The connection is still in use, e.g. by the configuration manager
+        simengine_schedule(pSlot->startTime + SIMBENCH_SDO_RETRY_DELAY,
+                           startSdoTransfer, nodeIndex_p, slot_p, NULL);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process a finished SDO transfer
+
+The function records the result of an SDO transfer of the benchmark and
+schedules the next transfer of the slot.
+
+\param[in]      pSdoInfo_p          SDO transfer result
+*/
+//------------------------------------------------------------------------------
+static void processSdoFinished(const tSdoComFinished* pSdoInfo_p)
+{
+    tSimBenchSdoSlot*   pSlot = (tSimBenchSdoSlot*)pSdoInfo_p->pUserArg;
+    UINT                slot;
+
+    if ((pSlot < instance_l.pSdoSlots) ||
+        (pSlot >= &instance_l.pSdoSlots[instance_l.config.sdoParallel]))
+        return;
+
+    if (pSdoInfo_p->sdoComConState == kSdoComTransferFinished)
+    {
+        addSample(&instance_l.sdoLatency, simengine_getTime() - pSlot->startTime);
+        instance_l.sdoBytes += pSdoInfo_p->transferredBytes;
+    }
+    else
+        instance_l.sdoAbortCount++;
+
+    slot = (UINT)(pSlot - instance_l.pSdoSlots);
+    pSlot->nodeId += instance_l.config.sdoParallel;
+    if (pSlot->nodeId > instance_l.config.cnCount)
+        pSlot->nodeId = slot + 1;
+
+    simengine_schedule(simengine_getTime(), startSdoTransfer, SIMNODE_MN_INDEX, slot, NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Synchronous application of the MN
+
+The function checks the echoes of the PDO tokens and sends a new token to every
+operational PDO CN which has echoed its last token.
+
+\param[in]      pNode_p             MN
+*/
+//------------------------------------------------------------------------------
+static void processSyncMn(tSimNode* pNode_p)
+{
+    UINT8*          pIn = (UINT8*)pNode_p->api.pfnGetProcessImageIn();
+    const UINT8*    pOut = (const UINT8*)pNode_p->api.pfnGetProcessImageOut();
+    UINT64          now = simengine_getTime();
+    tSimBenchNode*  pBenchNode;
+    UINT            nodeId;
+
+    for (nodeId = 1; nodeId <= instance_l.config.pdoCnCount; nodeId++)
+    {
+        pBenchNode = &instance_l.pNodes[nodeId];
+        if (!pBenchNode->fOperational)
+            continue;
+
+        if (pBenchNode->fTokenPending)
+        {
+            if (pOut[nodeId - 1] == pBenchNode->token)
+            {
+                addSample(&instance_l.pdoRoundTrip, now - pBenchNode->tokenTime);
+                pBenchNode->fTokenPending = FALSE;
+            }
+            else if ((now - pBenchNode->tokenTime) > SIMBENCH_PDO_TIMEOUT)
+            {
+                instance_l.pdoLostCount++;
+                pBenchNode->fTokenPending = FALSE;
+            }
+        }
+
+        if (!pBenchNode->fTokenPending)
+        {
+            pBenchNode->token = (UINT8)((pBenchNode->token % 255) + 1);
+            pBenchNode->tokenTime = now;
+            pBenchNode->fTokenPending = TRUE;
+            pIn[nodeId - 1] = pBenchNode->token;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Synchronous application of a CN
+
+The function echoes the PDO token of the MN.
+
+\param[in]      pNode_p             CN
+*/
+//------------------------------------------------------------------------------
+static void processSyncCn(tSimNode* pNode_p)
+{
+    UINT8*          pIn = (UINT8*)pNode_p->api.pfnGetProcessImageIn();
+    const UINT8*    pOut = (const UINT8*)pNode_p->api.pfnGetProcessImageOut();
+    tSimBenchNode*  pBenchNode = &instance_l.pNodes[pNode_p->nodeIndex];
+    UINT8           token = pOut[0];
+
+    if ((token != 0) && (token != pBenchNode->lastToken))
+    {
+        pBenchNode->lastToken = token;
+        if (pBenchNode->fTokenPending && (token == pBenchNode->token))
+            addSample(&instance_l.pdoLatency, simengine_getTime() - pBenchNode->tokenTime);
+    }
+
+    pIn[0] = token;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add a sample to a statistic
+
+\param[in,out]  pStat_p             Statistic
+\param[in]      value_p             Sample [ns]
+*/
+//------------------------------------------------------------------------------
+static void addSample(tSimBenchStat* pStat_p,
+                      UINT64 value_p)
+{
+    if ((pStat_p->count == 0) || (value_p < pStat_p->min))
+        pStat_p->min = value_p;
+    if (value_p > pStat_p->max)
+        pStat_p->max = value_p;
+
+    pStat_p->sum += value_p;
+    pStat_p->count++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print a statistic
+
+\param[in]      pName_p             Name of the measured value
+\param[in]      pStat_p             Statistic
+*/
+//------------------------------------------------------------------------------
+static void printStat(const char* pName_p,
+                      const tSimBenchStat* pStat_p)
+{
+    if (pStat_p->count == 0)
+    {
+        printf("  %-21s no samples\n", pName_p);
+        return;
+    }
+
+    printf("  %-21s min %9.3f us, avg %9.3f us, max %9.3f us (%llu samples)\n",
+           pName_p,
+           pStat_p->min / 1e3,
+           ((double)pStat_p->sum / pStat_p->count) / 1e3,
+           pStat_p->max / 1e3,
+           (unsigned long long)pStat_p->count);
+}
+
+/// \}
@@ -0,0 +1,88 @@
+/**
+********************************************************************************
+\file   simbench.h
+
+\brief  Definitions for the benchmarks of the network simulator
+
+This file contains the definitions of the benchmark application which runs on
+top of the simulated nodes.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_simbench_H_
+#define _INC_simbench_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simnode.h"
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Benchmark configuration
+
+The structure contains the parameters of the benchmark application.
+*/
+typedef struct
+{
+    UINT        cnCount;            ///< Number of CNs
+    UINT        pdoCnCount;         ///< Number of CNs exchanging PDOs with the MN
+    UINT        sdoParallel;        ///< Number of concurrent SDO transfers of the MN
+    BOOL        fVerbose;           ///< Print the events of the nodes
+} tSimBenchConfig;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError  simbench_init(const tSimBenchConfig* pConfig_p);
+void        simbench_exit(void);
+tOplkError  simbench_setupProcessImage(UINT nodeIndex_p);
+tOplkError  simbench_cbEvent(tSimulationInstanceHdl simHdl_p,
+                             tOplkApiEventType eventType_p,
+                             const tOplkApiEventArg* pEventArg_p,
+                             void* pUserArg_p);
+tOplkError  simbench_cbSync(tSimulationInstanceHdl simHdl_p);
+void        simbench_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_simbench_H_ */
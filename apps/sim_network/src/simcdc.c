@@ -0,0 +1,452 @@
+/**
+********************************************************************************
+\file   simcdc.c
+
+\brief  Network configuration of the simulator
+
+This file generates the concise device configuration (CDC) of the simulated
+network in memory. The configuration follows the output of openCONFIGURATOR
+for the demo projects: every CN is a mandatory node which gets its PDO mapping,
+its cycle timing and its loss of frame thresholds by the configuration manager
+of the MN. The MN exchanges one byte of process data with each of the first
+CNs, limited by the number of PDO channels in its object dictionary.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simcdc.h"
+#include "simnet.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMCDC_WAIT_SOC_PREQ            1000        // 0x1F8A/1 WaitSoCPReq_U32 [ns]
+#define SIMCDC_TIMING_MARGIN            1000        // Margin added to calculated timeouts [ns]
+#define SIMCDC_CYCLE_ROUNDING           10          // Granularity of calculated cycle lengths [us]
+#define SIMCDC_HEADER_SIZE              24          // Ethernet and POWERLINK header of PReq/PRes
+#define SIMCDC_SOC_SOA_SIZE             60          // Size of SoC and SoA frames
+#define SIMCDC_ASND_MAX_SIZE            1514        // Maximum size of an ASnd frame
+#define SIMCDC_LOSS_OF_SOC_TOLERANCE    50000000    // 0x1C14 LossOfSocTolerance [ns]
+#define SIMCDC_CONF_DATE                0x00002F74  // Expected configuration date
+#define SIMCDC_CONF_TIME                0x02BEE28F  // Expected configuration time
+#define SIMCDC_NODE_ASSIGN              0x0000000F  // Node exists, CN, start CN, mandatory
+#define SIMCDC_NODE_ASSIGN_VALID        0x80000000  // Node assignment is valid
+#define SIMCDC_CN_ENTRY_SIZE_MAX        256         // Upper bound of a CN configuration
+#define SIMCDC_MN_ENTRY_SIZE_MAX        128         // Upper bound of the MN entries per CN
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief CDC buffer
+
+The structure describes a CDC or a CN configuration under construction.
+*/
+typedef struct
+{
+    UINT8*      pData;          ///< Buffer
+    size_t      size;           ///< Used size
+    UINT32      entryCount;     ///< Number of entries
+} tSimCdcBuffer;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void     addEntry(tSimCdcBuffer* pBuffer_p,
+                         UINT index_p,
+                         UINT subindex_p,
+                         UINT size_p,
+                         UINT64 value_p);
+static void     addDomain(tSimCdcBuffer* pBuffer_p,
+                          UINT index_p,
+                          UINT subindex_p,
+                          const tSimCdcBuffer* pDomain_p);
+static void     putLe(UINT8* pDst_p,
+                      UINT size_p,
+                      UINT64 value_p);
+static void     buildCnConfig(const tSimCdcConfig* pConfig_p,
+                              UINT nodeId_p,
+                              tSimCdcBuffer* pBuffer_p);
+static UINT64   getPdoMapping(UINT index_p,
+                              UINT subindex_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate the cycle timing
+
+The function calculates the PRes timeout of each CN from the PReq and PRes
+transmission times, the propagation delays of the topology and the Tx latency
+of the CNs. If no async slot timeout or cycle length is given, they are
+calculated to fit the isochronous phase and a maximum size ASnd frame.
+
+\param[in,out]  pConfig_p           Network configuration
+\param[in]      cnTxLatency_p       Tx latency of the CNs [ns]
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simcdc_calcTiming(tSimCdcConfig* pConfig_p,
+                       UINT32 cnTxLatency_p)
+{
+    UINT32  pdoFrameTime = simnet_getFrameTime(SIMCDC_HEADER_SIZE + SIMCDC_PDO_PAYLOAD);
+    UINT32  ifgTime = SIMNET_IFG_SIZE * 8 * SIMNET_BIT_TIME_NS;
+    UINT32  maxPropagation = 0;
+    UINT32  propagation;
+    UINT64  cycleTime;
+    UINT    nodeId;
+
+    cycleTime = SIMCDC_WAIT_SOC_PREQ + simnet_getFrameTime(SIMCDC_SOC_SOA_SIZE) + ifgTime;
+
+    for (nodeId = 1; nodeId <= pConfig_p->cnCount; nodeId++)
+    {
+        propagation = simnet_getPropagationDelay(SIMNODE_MN_INDEX, nodeId);
+        if (propagation > maxPropagation)
+            maxPropagation = propagation;
+
+        // PReq out, PRes back, both with propagation and inter frame gap
+        pConfig_p->aPresTimeout[nodeId] = (2 * (pdoFrameTime + propagation + ifgTime)) +
+                                          cnTxLatency_p + SIMCDC_TIMING_MARGIN;
+        cycleTime += pConfig_p->aPresTimeout[nodeId];
+    }
+
+    if (pConfig_p->asyncSlotTimeout == 0)
+    {
+        pConfig_p->asyncSlotTimeout = simnet_getFrameTime(SIMCDC_SOC_SOA_SIZE) +
+                                      simnet_getFrameTime(SIMCDC_ASND_MAX_SIZE) +
+                                      (2 * (maxPropagation + ifgTime)) +
+                                      cnTxLatency_p + SIMCDC_TIMING_MARGIN;
+    }
+
+    if (pConfig_p->cycleLen == 0)
+    {
+        cycleTime += pConfig_p->asyncSlotTimeout + SIMCDC_TIMING_MARGIN;
+        cycleTime = (cycleTime + (SIMCDC_CYCLE_ROUNDING * 1000) - 1) / (SIMCDC_CYCLE_ROUNDING * 1000);
+        pConfig_p->cycleLen = (UINT32)cycleTime * SIMCDC_CYCLE_ROUNDING;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build the concise device configuration
+
+The function generates the CDC of the network in the binary format which is
+read by oplk_setCdcBuffer().
+
+\param[in]      pConfig_p           Network configuration
+\param[out]     ppCdc_p             Pointer to store the CDC buffer (free it
+                                    with \ref simcdc_free)
+\param[out]     pCdcSize_p          Pointer to store the CDC size
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simcdc_build(const tSimCdcConfig* pConfig_p,
+                        UINT8** ppCdc_p,
+                        size_t* pCdcSize_p)
+{
+    tSimCdcBuffer   cdc;
+    tSimCdcBuffer   cnConfig;
+    UINT            nodeId;
+    UINT            channel;
+
+    cdc.pData = (UINT8*)malloc(sizeof(UINT32) +
+                               (pConfig_p->cnCount * (SIMCDC_CN_ENTRY_SIZE_MAX + SIMCDC_MN_ENTRY_SIZE_MAX)) +
+                               SIMCDC_MN_ENTRY_SIZE_MAX);
+    cnConfig.pData = (UINT8*)malloc(SIMCDC_CN_ENTRY_SIZE_MAX);
+    if ((cdc.pData == NULL) || (cnConfig.pData == NULL))
+    {
+        free(cdc.pData);
+        free(cnConfig.pData);
+        return kErrorNoResource;
+    }
+
+    cdc.size = sizeof(UINT32);
+    cdc.entryCount = 0;
+
+    // Configuration of the MN
+    for (nodeId = 1; nodeId <= pConfig_p->cnCount; nodeId++)
+        addEntry(&cdc, 0x1F81, nodeId, 4, SIMCDC_NODE_ASSIGN);
+
+    for (channel = 0; channel < pConfig_p->pdoCnCount; channel++)
+    {
+        addEntry(&cdc, 0x1600 + channel, 0, 1, 0);
+        addEntry(&cdc, 0x1A00 + channel, 0, 1, 0);
+    }
+
+    addEntry(&cdc, 0x1006, 0, 4, pConfig_p->cycleLen);
+    addEntry(&cdc, 0x1C02, 3, 4, 0x28);
+
+    for (nodeId = 1; nodeId <= pConfig_p->cnCount; nodeId++)
+        addEntry(&cdc, 0x1C09, nodeId, 4, 0x28);
+
+    addEntry(&cdc, 0x1C14, 0, 4, SIMCDC_LOSS_OF_SOC_TOLERANCE);
+
+    for (nodeId = 1; nodeId <= pConfig_p->cnCount; nodeId++)
+    {
+        addEntry(&cdc, 0x1F26, nodeId, 4, SIMCDC_CONF_DATE);
+        addEntry(&cdc, 0x1F27, nodeId, 4, SIMCDC_CONF_TIME);
+    }
+
+    addEntry(&cdc, 0x1F8A, 2, 4, pConfig_p->asyncSlotTimeout);
+
+    for (nodeId = 1; nodeId <= pConfig_p->cnCount; nodeId++)
+        addEntry(&cdc, 0x1F92, nodeId, 4, pConfig_p->aPresTimeout[nodeId]);
+
+    // PDO channel n of the MN communicates with node ID n + 1
+    for (channel = 0; channel < pConfig_p->pdoCnCount; channel++)
+    {
+        addEntry(&cdc, 0x1400 + channel, 1, 1, channel + 1);
+        addEntry(&cdc, 0x1600 + channel, 1, 8, getPdoMapping(0xA4C0, channel + 1));
+    }
+
+    for (channel = 0; channel < pConfig_p->pdoCnCount; channel++)
+    {
+        addEntry(&cdc, 0x1800 + channel, 1, 1, channel + 1);
+        addEntry(&cdc, 0x1A00 + channel, 1, 8, getPdoMapping(0xA040, channel + 1));
+    }
+
+    for (channel = 0; channel < pConfig_p->pdoCnCount; channel++)
+    {
+        addEntry(&cdc, 0x1600 + channel, 0, 1, 1);
+        addEntry(&cdc, 0x1A00 + channel, 0, 1, 1);
+    }
+
+    // Configurations of the CNs
+    for (nodeId = 1; nodeId <= pConfig_p->cnCount; nodeId++)
+    {
+        buildCnConfig(pConfig_p, nodeId, &cnConfig);
+        addDomain(&cdc, 0x1F22, nodeId, &cnConfig);
+    }
+
+    for (nodeId = 1; nodeId <= pConfig_p->cnCount; nodeId++)
+        addEntry(&cdc, 0x1F81, nodeId, 4, SIMCDC_NODE_ASSIGN_VALID | SIMCDC_NODE_ASSIGN);
+
+    putLe(cdc.pData, 4, cdc.entryCount);
+    free(cnConfig.pData);
+
+    *ppCdc_p = cdc.pData;
+    *pCdcSize_p = cdc.size;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a concise device configuration
+
+\param[in]      pCdc_p              CDC buffer returned by \ref simcdc_build
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simcdc_free(UINT8* pCdc_p)
+{
+    free(pCdc_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add an entry to a CDC buffer
+
+\param[in,out]  pBuffer_p           CDC buffer
+\param[in]      index_p             Object index
+\param[in]      subindex_p          Object subindex
+\param[in]      size_p              Size of the value
+\param[in]      value_p             Value
+*/
+//------------------------------------------------------------------------------
+static void addEntry(tSimCdcBuffer* pBuffer_p,
+                     UINT index_p,
+                     UINT subindex_p,
+                     UINT size_p,
+                     UINT64 value_p)
+{
+    UINT8*  pEntry = pBuffer_p->pData + pBuffer_p->size;
+
+    putLe(&pEntry[0], 2, index_p);
+    putLe(&pEntry[2], 1, subindex_p);
+    putLe(&pEntry[3], 4, size_p);
+    putLe(&pEntry[7], size_p, value_p);
+
+    pBuffer_p->size += 7 + size_p;
+    pBuffer_p->entryCount++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add a domain entry to a CDC buffer
+
+\param[in,out]  pBuffer_p           CDC buffer
+\param[in]      index_p             Object index
+\param[in]      subindex_p          Object subindex
+\param[in]      pDomain_p           Domain content (a CN configuration)
+*/
+//------------------------------------------------------------------------------
+static void addDomain(tSimCdcBuffer* pBuffer_p,
+                      UINT index_p,
+                      UINT subindex_p,
+                      const tSimCdcBuffer* pDomain_p)
+{
+    UINT8*  pEntry = pBuffer_p->pData + pBuffer_p->size;
+
+    putLe(&pEntry[0], 2, index_p);
+    putLe(&pEntry[2], 1, subindex_p);
+    putLe(&pEntry[3], 4, pDomain_p->size);
+    memcpy(&pEntry[7], pDomain_p->pData, pDomain_p->size);
+
+    pBuffer_p->size += 7 + pDomain_p->size;
+    pBuffer_p->entryCount++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store a value in little endian byte order
+
+\param[out]     pDst_p              Destination
+\param[in]      size_p              Size of the value
+\param[in]      value_p             Value
+*/
+//------------------------------------------------------------------------------
+static void putLe(UINT8* pDst_p,
+                  UINT size_p,
+                  UINT64 value_p)
+{
+    UINT    index;
+
+    for (index = 0; index < size_p; index++)
+    {
+        pDst_p[index] = (UINT8)value_p;
+        value_p >>= 8;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build the configuration of a CN
+
+The configuration is stored in the CDC as domain 0x1F22 of the CN and written
+to the CN by the configuration manager of the MN.
+
+\param[in]      pConfig_p           Network configuration
+\param[in]      nodeId_p            Node ID of the CN
+\param[out]     pBuffer_p           Buffer for the configuration
+*/
+//------------------------------------------------------------------------------
+static void buildCnConfig(const tSimCdcConfig* pConfig_p,
+                          UINT nodeId_p,
+                          tSimCdcBuffer* pBuffer_p)
+{
+    BOOL    fPdo = (nodeId_p <= pConfig_p->pdoCnCount);
+
+    pBuffer_p->size = sizeof(UINT32);
+    pBuffer_p->entryCount = 0;
+
+    addEntry(pBuffer_p, 0x1600, 0, 1, 0);
+    addEntry(pBuffer_p, 0x1A00, 0, 1, 0);
+    addEntry(pBuffer_p, 0x1006, 0, 4, pConfig_p->cycleLen);
+    addEntry(pBuffer_p, 0x1020, 1, 4, SIMCDC_CONF_DATE);
+    addEntry(pBuffer_p, 0x1020, 2, 4, SIMCDC_CONF_TIME);
+    addEntry(pBuffer_p, 0x1C0B, 3, 4, 0x50);
+    addEntry(pBuffer_p, 0x1C0D, 3, 4, 0x50);
+    addEntry(pBuffer_p, 0x1C14, 0, 4, SIMCDC_LOSS_OF_SOC_TOLERANCE);
+    addEntry(pBuffer_p, 0x1F98, 4, 2, SIMCDC_PDO_PAYLOAD);
+    addEntry(pBuffer_p, 0x1F98, 5, 2, SIMCDC_PDO_PAYLOAD);
+
+    if (fPdo)
+    {
+        addEntry(pBuffer_p, 0x1600, 1, 8, getPdoMapping(0x6200, 1));
+        addEntry(pBuffer_p, 0x1A00, 1, 8, getPdoMapping(0x6000, 1));
+        addEntry(pBuffer_p, 0x1600, 0, 1, 1);
+        addEntry(pBuffer_p, 0x1A00, 0, 1, 1);
+    }
+
+    putLe(pBuffer_p->pData, 4, pBuffer_p->entryCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a PDO mapping entry
+
+\param[in]      index_p             Mapped object index
+\param[in]      subindex_p          Mapped object subindex
+
+\return The function returns a mapping entry for an 8-bit object at offset 0.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getPdoMapping(UINT index_p,
+                            UINT subindex_p)
+{
+    return (8ULL << 48) | ((UINT64)subindex_p << 16) | index_p;
+}
+
+/// \}
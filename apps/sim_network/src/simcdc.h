@@ -0,0 +1,88 @@
+/**
+********************************************************************************
+\file   simcdc.h
+
+\brief  Definitions for the network configuration of the simulator
+
+This file contains the definitions for generating the concise device
+configuration (CDC) of the simulated network.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_simcdc_H_
+#define _INC_simcdc_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simnode.h"
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMCDC_MAX_PDO_CN               40      // Number of PDO channels of the MN object dictionary
+#define SIMCDC_PDO_PAYLOAD              36      // PReq/PRes payload limit
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Network configuration
+
+The structure contains the parameters of the concise device configuration.
+*/
+typedef struct
+{
+    UINT        cnCount;                            ///< Number of CNs (node IDs 1 to cnCount)
+    UINT        pdoCnCount;                         ///< Number of CNs exchanging PDOs with the MN (node IDs 1 to pdoCnCount)
+    UINT32      cycleLen;                           ///< Cycle length [us]
+    UINT32      asyncSlotTimeout;                   ///< Async slot timeout [ns]
+    UINT32      aPresTimeout[SIMNODE_MAX_CN + 1];   ///< PRes timeout of the CNs, indexed by node ID [ns]
+} tSimCdcConfig;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void        simcdc_calcTiming(tSimCdcConfig* pConfig_p,
+                              UINT32 cnTxLatency_p);
+tOplkError  simcdc_build(const tSimCdcConfig* pConfig_p,
+                         UINT8** ppCdc_p,
+                         size_t* pCdcSize_p);
+void        simcdc_free(UINT8* pCdc_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_simcdc_H_ */
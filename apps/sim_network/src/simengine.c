@@ -0,0 +1,372 @@
+/**
+********************************************************************************
+\file   simengine.c
+
+\brief  Discrete-event simulation engine
+
+This file contains the virtual-time engine of the network simulator. Events are
+kept in a binary heap which is ordered by their due time. Events with the same
+due time are processed in the order they were scheduled, so a simulation run is
+fully deterministic.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simengine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMENGINE_INITIAL_QUEUE_SIZE    1024
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Scheduled event
+
+The structure describes an event in the event queue of the engine.
+*/
+typedef struct
+{
+    UINT64          time;           ///< Due time of the event [ns]
+    UINT64          seq;            ///< Sequence number for a stable order of simultaneous events
+    tSimEngineCb    pfnCb;          ///< Event handler
+    UINT            nodeIndex;      ///< Node index passed to the handler
+    UINT64          arg;            ///< Integer argument passed to the handler
+    void*           pArg;           ///< Pointer argument passed to the handler
+} tSimEngineEvent;
+
+/**
+\brief Engine instance
+
+The structure contains the instance data of the simulation engine.
+*/
+typedef struct
+{
+    UINT64              now;            ///< Current virtual time [ns]
+    UINT64              nextSeq;        ///< Sequence number of the next scheduled event
+    UINT64              eventCount;     ///< Number of processed events
+    BOOL                fStop;          ///< Stop request for simengine_run()
+    tSimEngineEvent*    pQueue;         ///< Binary heap of pending events
+    size_t              queueLen;       ///< Number of pending events
+    size_t              queueSize;      ///< Allocated size of the heap
+} tSimEngineInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSimEngineInstance   instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL isEarlier(const tSimEngineEvent* pFirst_p,
+                      const tSimEngineEvent* pSecond_p);
+static void popEvent(tSimEngineEvent* pEvent_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the simulation engine
+
+The function initializes the event queue and resets the virtual clock to zero.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simengine_init(void)
+{
+    memset(&instance_l, 0, sizeof(instance_l));
+
+    instance_l.pQueue = (tSimEngineEvent*)malloc(sizeof(tSimEngineEvent) * SIMENGINE_INITIAL_QUEUE_SIZE);
+    if (instance_l.pQueue == NULL)
+        return kErrorNoResource;
+
+    instance_l.queueSize = SIMENGINE_INITIAL_QUEUE_SIZE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the simulation engine
+
+The function discards all pending events and frees the event queue.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simengine_exit(void)
+{
+    free(instance_l.pQueue);
+    memset(&instance_l, 0, sizeof(instance_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the virtual time
+
+\return The function returns the current virtual time in nanoseconds.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+UINT64 simengine_getTime(void)
+{
+    return instance_l.now;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the number of processed events
+
+\return The function returns the number of events processed since the engine
+        was initialized.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+UINT64 simengine_getEventCount(void)
+{
+    return instance_l.eventCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Schedule an event
+
+The function inserts an event into the event queue. Events in the past are
+processed at the current virtual time.
+
+\param[in]      time_p              Absolute due time of the event [ns]
+\param[in]      pfnCb_p             Event handler
+\param[in]      nodeIndex_p         Node index passed to the handler
+\param[in]      arg_p               Integer argument passed to the handler
+\param[in]      pArg_p              Pointer argument passed to the handler
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simengine_schedule(UINT64 time_p,
+                              tSimEngineCb pfnCb_p,
+                              UINT nodeIndex_p,
+                              UINT64 arg_p,
+                              void* pArg_p)
+{
+    tSimEngineEvent event;
+    size_t          pos;
+    size_t          parent;
+
+    if (instance_l.queueLen == instance_l.queueSize)
+    {
+        tSimEngineEvent* pQueue;
+
+        pQueue = (tSimEngineEvent*)realloc(instance_l.pQueue,
+                                           sizeof(tSimEngineEvent) * instance_l.queueSize * 2);
+        if (pQueue == NULL)
+            return kErrorNoResource;
+
+        instance_l.pQueue = pQueue;
+        instance_l.queueSize *= 2;
+    }
+
+    event.time = (time_p < instance_l.now) ? instance_l.now : time_p;
+    event.seq = instance_l.nextSeq++;
+    event.pfnCb = pfnCb_p;
+    event.nodeIndex = nodeIndex_p;
+    event.arg = arg_p;
+    event.pArg = pArg_p;
+
+    // Sift up
+    pos = instance_l.queueLen++;
+    while (pos > 0)
+    {
+        parent = (pos - 1) / 2;
+        if (!isEarlier(&event, &instance_l.pQueue[parent]))
+            break;
+
+        instance_l.pQueue[pos] = instance_l.pQueue[parent];
+        pos = parent;
+    }
+    instance_l.pQueue[pos] = event;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run the simulation
+
+The function processes the scheduled events in time order until the queue is
+empty, the next event is later than the given end time or
+\ref simengine_stop is called by an event handler. The virtual clock is
+advanced to the time of each processed event and finally to the end time.
+
+\param[in]      endTime_p           Absolute end time of the run [ns]
+                                    (SIMENGINE_TIME_INFINITE runs until the
+                                    queue is empty or the run is stopped)
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simengine_run(UINT64 endTime_p)
+{
+    tSimEngineEvent event;
+
+    instance_l.fStop = FALSE;
+
+    while (!instance_l.fStop &&
+           (instance_l.queueLen > 0) &&
+           (instance_l.pQueue[0].time <= endTime_p))
+    {
+        popEvent(&event);
+        instance_l.now = event.time;
+        instance_l.eventCount++;
+        event.pfnCb(event.nodeIndex, event.arg, event.pArg);
+    }
+
+    if (!instance_l.fStop && (endTime_p != SIMENGINE_TIME_INFINITE) && (instance_l.now < endTime_p))
+        instance_l.now = endTime_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stop the simulation
+
+The function requests \ref simengine_run to return after the currently
+processed event.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simengine_stop(void)
+{
+    instance_l.fStop = TRUE;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare two events
+
+\param[in]      pFirst_p            First event
+\param[in]      pSecond_p           Second event
+
+\return The function returns TRUE if the first event is due before the second.
+*/
+//------------------------------------------------------------------------------
+static BOOL isEarlier(const tSimEngineEvent* pFirst_p,
+                      const tSimEngineEvent* pSecond_p)
+{
+    if (pFirst_p->time != pSecond_p->time)
+        return (pFirst_p->time < pSecond_p->time);
+
+    return (pFirst_p->seq < pSecond_p->seq);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove the earliest event from the queue
+
+\param[out]     pEvent_p            Removed event
+*/
+//------------------------------------------------------------------------------
+static void popEvent(tSimEngineEvent* pEvent_p)
+{
+    tSimEngineEvent last;
+    size_t          pos = 0;
+    size_t          child;
+
+    *pEvent_p = instance_l.pQueue[0];
+    last = instance_l.pQueue[--instance_l.queueLen];
+
+    // Sift down
+    for (;;)
+    {
+        child = (2 * pos) + 1;
+        if (child >= instance_l.queueLen)
+            break;
+
+        if (((child + 1) < instance_l.queueLen) &&
+            isEarlier(&instance_l.pQueue[child + 1], &instance_l.pQueue[child]))
+            child++;
+
+        if (!isEarlier(&instance_l.pQueue[child], &last))
+            break;
+
+        instance_l.pQueue[pos] = instance_l.pQueue[child];
+        pos = child;
+    }
+
+    if (instance_l.queueLen > 0)
+        instance_l.pQueue[pos] = last;
+}
+
+/// \}
@@ -0,0 +1,90 @@
+/**
+********************************************************************************
+\file   simengine.h
+
+\brief  Definitions for the discrete-event simulation engine
+
+This file contains the definitions of the virtual-time engine of the network
+simulator.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_simengine_H_
+#define _INC_simengine_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplk.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMENGINE_TIME_INFINITE     0xFFFFFFFFFFFFFFFFULL
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Event handler
+
+This callback function is called by the engine when the virtual clock reaches
+the time of a scheduled event.
+
+\param[in]      nodeIndex_p         Index of the node the event belongs to
+\param[in]      arg_p               Integer argument of the event
+\param[in]      pArg_p              Pointer argument of the event
+*/
+typedef void (*tSimEngineCb)(UINT nodeIndex_p, UINT64 arg_p, void* pArg_p);
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError  simengine_init(void);
+void        simengine_exit(void);
+UINT64      simengine_getTime(void);
+UINT64      simengine_getEventCount(void);
+tOplkError  simengine_schedule(UINT64 time_p,
+                               tSimEngineCb pfnCb_p,
+                               UINT nodeIndex_p,
+                               UINT64 arg_p,
+                               void* pArg_p);
+void        simengine_run(UINT64 endTime_p);
+void        simengine_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_simengine_H_ */
@@ -0,0 +1,562 @@
+/**
+********************************************************************************
+\file   simnet.c
+
+\brief  Simulated Ethernet network
+
+This file contains the Ethernet network model of the network simulator. Frames
+are serialized on the transmitting port with 100 Mbit/s timing (preamble, FCS
+and inter frame gap included) and delivered to the Rx handlers of all receiving
+nodes after the propagation delay of the topology.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simnet.h"
+#include "simengine.h"
+
+#include <oplk/frame.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMNET_MAX_FRAME_SIZE       1518    // Maximum frame size without FCS (incl. VLAN tag)
+#define SIMNET_FILTER_SIZE          22      // Number of frame bytes covered by an Rx filter
+#define SIMNET_SRC_NODEID_OFFSET    16      // Offset of the source node ID in a POWERLINK frame
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Frame on the network
+
+The structure contains a transmitted frame. It is shared by all receivers and
+freed after the last reception. The receivers are ordered by their propagation
+delay, receivers with the same delay get the frame with a single event.
+*/
+typedef struct
+{
+    UINT            refCount;       ///< Number of pending reception events
+    UINT            srcIndex;       ///< Index of the transmitting node
+    UINT64          txStart;        ///< Start of the transmission [ns]
+    UINT*           pReceiver;      ///< Indices of the receiving nodes
+    UINT            size;           ///< Frame size without FCS
+    UINT8           aData[1];       ///< Frame data (allocated with the frame size)
+} tSimNetFrame;
+
+/**
+\brief Network instance
+
+The structure contains the instance data of the network model.
+*/
+typedef struct
+{
+    tSimNetConfig       config;                             ///< Network configuration
+    tSimNetStatistics   statistics;                         ///< Network statistics
+    UINT8               aRxBuffer[SIMNET_MAX_FRAME_SIZE];   ///< Rx buffer passed to the receiving node
+} tSimNetInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSimNetInstance  instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL isReceiver(tSimNode* pNode_p,
+                       const UINT8* pFrame_p,
+                       UINT frameSize_p);
+static BOOL matchesRxFilter(tSimNode* pNode_p,
+                            const UINT8* pFrame_p,
+                            UINT frameSize_p);
+static void txCompleted(UINT nodeIndex_p,
+                        UINT64 arg_p,
+                        void* pArg_p);
+static UINT addReceiver(tSimNetFrame* pFrame_p,
+                        UINT receiverCount_p,
+                        UINT nodeIndex_p);
+static void frameReceived(UINT nodeIndex_p,
+                          UINT64 arg_p,
+                          void* pArg_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the network
+
+\param[in]      pConfig_p           Network configuration
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_init(const tSimNetConfig* pConfig_p)
+{
+    memset(&instance_l, 0, sizeof(instance_l));
+    instance_l.config = *pConfig_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the network
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnet_exit(void)
+{
+    memset(&instance_l, 0, sizeof(instance_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a frame
+
+The function starts the transmission of a frame. The transmission starts when
+the Tx port of the node is idle. The Tx handler of the buffer is called at the
+end of the transmission, the receivers get the frame after the additional
+propagation delay.
+
+\param[in,out]  pNode_p             Transmitting node
+\param[in]      pTxBuffer_p         Tx buffer to send
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_sendFrame(tSimNode* pNode_p,
+                            tEdrvTxBuffer* pTxBuffer_p)
+{
+    tOplkError      ret = kErrorOk;
+    UINT64          txEnd;
+    UINT32          delay;
+    UINT            nodeCount = simnode_getCount();
+    UINT            receiverCount = 0;
+    UINT            first;
+    UINT            last;
+    UINT            hops;
+    tSimNetFrame*   pFrame;
+    size_t          dataSize;
+
+    if ((pTxBuffer_p->txFrameSize > SIMNET_MAX_FRAME_SIZE) ||
+        (pTxBuffer_p->txFrameSize < SIMNET_FILTER_SIZE))
+        return kErrorEdrvInvalidParam;
+
+    // The receiver list is stored behind the frame data
+    dataSize = (sizeof(tSimNetFrame) + pTxBuffer_p->txFrameSize + sizeof(UINT) - 1) & ~(sizeof(UINT) - 1);
+    pFrame = (tSimNetFrame*)malloc(dataSize + (sizeof(UINT) * nodeCount));
+    if (pFrame == NULL)
+        return kErrorNoResource;
+
+    pFrame->refCount = 0;
+    pFrame->srcIndex = pNode_p->nodeIndex;
+    pFrame->pReceiver = (UINT*)((UINT8*)pFrame + dataSize);
+    pFrame->size = pTxBuffer_p->txFrameSize;
+    memcpy(pFrame->aData, pTxBuffer_p->pBuffer, pFrame->size);
+
+    pFrame->txStart = simengine_getTime();
+    if (!pNode_p->fMn)
+        pFrame->txStart += instance_l.config.cnTxLatency;
+    if (pFrame->txStart < pNode_p->txBusyUntil)
+        pFrame->txStart = pNode_p->txBusyUntil;
+
+    txEnd = pFrame->txStart + simnet_getFrameTime(pTxBuffer_p->txFrameSize);
+    pNode_p->txBusyUntil = txEnd + (SIMNET_IFG_SIZE * 8 * SIMNET_BIT_TIME_NS);
+
+    instance_l.statistics.txFrames++;
+    instance_l.statistics.txBytes += pTxBuffer_p->txFrameSize;
+
+    if (pTxBuffer_p->pfnTxHandler != NULL)
+    {
+        ret = simengine_schedule(txEnd, txCompleted, pNode_p->nodeIndex, 0, pTxBuffer_p);
+        if (ret != kErrorOk)
+        {
+            free(pFrame);
+            return ret;
+        }
+    }
+
+    // Collect the receivers ordered by their distance to the transmitter
+    if (instance_l.config.topology == kSimNetTopologyLine)
+    {
+        for (hops = 1; hops < nodeCount; hops++)
+        {
+            if (pNode_p->nodeIndex >= hops)
+                receiverCount = addReceiver(pFrame, receiverCount, pNode_p->nodeIndex - hops);
+            if (pNode_p->nodeIndex + hops < nodeCount)
+                receiverCount = addReceiver(pFrame, receiverCount, pNode_p->nodeIndex + hops);
+        }
+    }
+    else
+    {
+        for (first = 0; first < nodeCount; first++)
+        {
+            if (first != pNode_p->nodeIndex)
+                receiverCount = addReceiver(pFrame, receiverCount, first);
+        }
+    }
+
+    // Schedule a reception event for each group of receivers with the same delay
+    for (first = 0; first < receiverCount; first = last)
+    {
+        delay = simnet_getPropagationDelay(pNode_p->nodeIndex, pFrame->pReceiver[first]);
+        for (last = first + 1; last < receiverCount; last++)
+        {
+            if (simnet_getPropagationDelay(pNode_p->nodeIndex, pFrame->pReceiver[last]) != delay)
+                break;
+        }
+
+        ret = simengine_schedule(txEnd + delay, frameReceived, pNode_p->nodeIndex,
+                                 ((UINT64)first << 32) | last, pFrame);
+        if (ret != kErrorOk)
+            break;
+
+        pFrame->refCount++;
+    }
+
+    if (pFrame->refCount == 0)
+        free(pFrame);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the transmission time of a frame
+
+\param[in]      frameSize_p         Frame size without FCS
+
+\return The function returns the time the frame occupies the wire (preamble and
+        FCS included, inter frame gap excluded) [ns].
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+UINT32 simnet_getFrameTime(UINT frameSize_p)
+{
+    if (frameSize_p < SIMNET_MIN_FRAME_SIZE)
+        frameSize_p = SIMNET_MIN_FRAME_SIZE;
+
+    return (SIMNET_PREAMBLE_SIZE + frameSize_p + SIMNET_FCS_SIZE) * 8 * SIMNET_BIT_TIME_NS;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the propagation delay between two nodes
+
+\param[in]      srcIndex_p          Index of the transmitting node
+\param[in]      dstIndex_p          Index of the receiving node
+
+\return The function returns the propagation delay [ns].
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+UINT32 simnet_getPropagationDelay(UINT srcIndex_p,
+                                  UINT dstIndex_p)
+{
+    UINT    hops;
+
+    if (instance_l.config.topology == kSimNetTopologyLine)
+        hops = (srcIndex_p > dstIndex_p) ? (srcIndex_p - dstIndex_p) : (dstIndex_p - srcIndex_p);
+    else
+        hops = 1;
+
+    return hops * instance_l.config.hopDelay;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the network statistics
+
+\param[out]     pStatistics_p       Network statistics
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnet_getStatistics(tSimNetStatistics* pStatistics_p)
+{
+    *pStatistics_p = instance_l.statistics;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check whether a node receives a frame
+
+The function compares the destination address with the MAC address and the
+multicast addresses of the node. If Rx filtering is enabled, PRes frames are
+only passed to a CN if one of the DLL Rx filters of the CN matches.
+
+\param[in]      pNode_p             Receiving node
+\param[in]      pFrame_p            Frame data
+\param[in]      frameSize_p         Frame size
+
+\return The function returns TRUE if the node receives the frame.
+*/
+//------------------------------------------------------------------------------
+static BOOL isReceiver(tSimNode* pNode_p,
+                       const UINT8* pFrame_p,
+                       UINT frameSize_p)
+{
+    static const UINT8  aBroadcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    UINT                index;
+    BOOL                fReceive = FALSE;
+
+    if (pNode_p->pfnRxHandler == NULL)
+        return FALSE;
+
+    if ((pFrame_p[0] & 0x01) == 0)
+        return (memcmp(pFrame_p, pNode_p->aMacAddr, 6) == 0);
+
+    if (memcmp(pFrame_p, aBroadcast, 6) == 0)
+        return TRUE;
+
+    for (index = 0; index < pNode_p->multicastCount; index++)
+    {
+        if (memcmp(pFrame_p, pNode_p->aMulticast[index], 6) == 0)
+        {
+            fReceive = TRUE;
+            break;
+        }
+    }
+
+    if (fReceive && instance_l.config.fRxFilter && !pNode_p->fMn &&
+        (pFrame_p[12] == (UINT8)(C_DLL_ETHERTYPE_EPL >> 8)) &&
+        (pFrame_p[13] == (UINT8)(C_DLL_ETHERTYPE_EPL & 0xFF)) &&
+        (pFrame_p[14] == kMsgTypePres))
+    {
+        fReceive = matchesRxFilter(pNode_p, pFrame_p, frameSize_p);
+        if (!fReceive)
+            instance_l.statistics.filteredFrames++;
+    }
+
+    return fReceive;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Match a PRes frame against the Rx filters of a node
+
+The header of a PRes frame only depends on its source node, so the result is
+cached per source node ID until the DLL changes its filters.
+
+\param[in,out]  pNode_p             Receiving node
+\param[in]      pFrame_p            Frame data
+\param[in]      frameSize_p         Frame size
+
+\return The function returns TRUE if an enabled Rx filter matches or the node
+        did not set up its Rx filters.
+*/
+//------------------------------------------------------------------------------
+static BOOL matchesRxFilter(tSimNode* pNode_p,
+                            const UINT8* pFrame_p,
+                            UINT frameSize_p)
+{
+    const tEdrvFilter*  pFilter;
+    UINT                entry;
+    UINT                index;
+
+    UINT8*              pCached;
+
+    UNUSED_PARAMETER(frameSize_p);
+
+    if ((pNode_p->pFilter == NULL) || (pNode_p->filterCount == 0))
+        return TRUE;
+
+    pCached = &pNode_p->aPresFilter[pFrame_p[SIMNET_SRC_NODEID_OFFSET]];
+    if (*pCached != SIMNODE_PRES_FILTER_UNKNOWN)
+        return (*pCached == SIMNODE_PRES_FILTER_ACCEPT);
+
+    *pCached = SIMNODE_PRES_FILTER_REJECT;
+    for (entry = 0; entry < pNode_p->filterCount; entry++)
+    {
+        pFilter = &pNode_p->pFilter[entry];
+        if (!pFilter->fEnable)
+            continue;
+
+        for (index = 0; index < SIMNET_FILTER_SIZE; index++)
+        {
+            if ((pFrame_p[index] & pFilter->aFilterMask[index]) !=
+                (pFilter->aFilterValue[index] & pFilter->aFilterMask[index]))
+                break;
+        }
+
+        if (index == SIMNET_FILTER_SIZE)
+        {
+            *pCached = SIMNODE_PRES_FILTER_ACCEPT;
+            break;
+        }
+    }
+
+    return (*pCached == SIMNODE_PRES_FILTER_ACCEPT);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Transmission completed
+
+\param[in]      nodeIndex_p         Index of the transmitting node
+\param[in]      arg_p               Unused
+\param[in]      pArg_p              Tx buffer
+*/
+//------------------------------------------------------------------------------
+static void txCompleted(UINT nodeIndex_p,
+                        UINT64 arg_p,
+                        void* pArg_p)
+{
+    tSimNode*       pNode = simnode_getNode(nodeIndex_p);
+    tEdrvTxBuffer*  pTxBuffer = (tEdrvTxBuffer*)pArg_p;
+
+    UNUSED_PARAMETER(arg_p);
+
+    if (pNode->pfnRxHandler == NULL)
+        return;     // Ethernet driver was shut down
+
+    pTxBuffer->pfnTxHandler(pTxBuffer);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add a receiver of a frame
+
+\param[in,out]  pFrame_p            Frame
+\param[in]      receiverCount_p     Current number of receivers
+\param[in]      nodeIndex_p         Index of the node
+
+\return The function returns the new number of receivers.
+*/
+//------------------------------------------------------------------------------
+static UINT addReceiver(tSimNetFrame* pFrame_p,
+                        UINT receiverCount_p,
+                        UINT nodeIndex_p)
+{
+    if (isReceiver(simnode_getNode(nodeIndex_p), pFrame_p->aData, pFrame_p->size))
+        pFrame_p->pReceiver[receiverCount_p++] = nodeIndex_p;
+
+    return receiverCount_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Frame received
+
+The frame is passed to the Rx handlers of a group of receivers with the same
+propagation delay. Each node gets the frame in a private buffer. A reception
+which starts before the previous one ended is counted as collision.
+
+\param[in]      nodeIndex_p         Index of the transmitting node
+\param[in]      arg_p               First (upper 32 bits) and end (lower 32 bits)
+                                    index of the receiver group
+\param[in]      pArg_p              Frame
+*/
+//------------------------------------------------------------------------------
+static void frameReceived(UINT nodeIndex_p,
+                          UINT64 arg_p,
+                          void* pArg_p)
+{
+    tSimNetFrame*   pFrame = (tSimNetFrame*)pArg_p;
+    UINT            receiver = (UINT)(arg_p >> 32);
+    UINT            end = (UINT)(arg_p & 0xFFFFFFFF);
+    UINT64          rxStart;
+    tSimNode*       pNode;
+    tEdrvRxBuffer   rxBuffer;
+    tTimestamp      timestamp;
+
+    rxStart = pFrame->txStart + simnet_getPropagationDelay(nodeIndex_p, pFrame->pReceiver[receiver]);
+    timestamp.timeStamp = (TIME_STAMP_T)simengine_getTime();
+
+    for (; receiver < end; receiver++)
+    {
+        pNode = simnode_getNode(pFrame->pReceiver[receiver]);
+
+        if (rxStart < pNode->rxBusyUntil)
+            instance_l.statistics.collisions++;
+        pNode->rxBusyUntil = simengine_getTime();
+
+        if (pNode->pfnRxHandler == NULL)
+            continue;   // Ethernet driver was shut down
+
+        memcpy(instance_l.aRxBuffer, pFrame->aData, pFrame->size);
+
+        rxBuffer.bufferInFrame = kEdrvBufferLastInFrame;
+        rxBuffer.rxFrameSize = pFrame->size;
+        rxBuffer.pBuffer = instance_l.aRxBuffer;
+        rxBuffer.pRxTimeStamp = &timestamp;
+
+        instance_l.statistics.rxFrames++;
+        pNode->pfnRxHandler(&rxBuffer);
+    }
+
+    if (--pFrame->refCount == 0)
+        free(pFrame);
+}
+
+/// \}
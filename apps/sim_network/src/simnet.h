@@ -0,0 +1,120 @@
+/**
+********************************************************************************
+\file   simnet.h
+
+\brief  Definitions for the simulated Ethernet network
+
+This file contains the definitions of the Ethernet network model of the network
+simulator.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_simnet_H_
+#define _INC_simnet_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simnode.h"
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMNET_BIT_TIME_NS          10      // 100 Mbit/s Ethernet
+#define SIMNET_PREAMBLE_SIZE        8       // Preamble and start frame delimiter
+#define SIMNET_FCS_SIZE             4       // Frame check sequence
+#define SIMNET_MIN_FRAME_SIZE       60      // Minimum frame size without FCS
+#define SIMNET_IFG_SIZE             12      // Inter frame gap
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Network topology
+
+The enumeration lists the supported network topologies.
+*/
+typedef enum
+{
+    kSimNetTopologyHub  = 0,    ///< All nodes are connected to a single hub
+    kSimNetTopologyLine = 1     ///< The nodes are daisy-chained, the MN is at the end of the line
+} eSimNetTopology;
+
+/// Data type for the enumerator \ref eSimNetTopology.
+typedef UINT32 tSimNetTopology;
+
+/**
+\brief Network configuration
+
+The structure contains the parameters of the simulated network.
+*/
+typedef struct
+{
+    tSimNetTopology     topology;           ///< Network topology
+    UINT32              hopDelay;           ///< Propagation delay of a hop (cable and hub) [ns]
+    UINT32              cnTxLatency;        ///< Delay between the transmit request and the start of transmission of a CN [ns]
+    BOOL                fRxFilter;          ///< Apply the Rx filters of the CNs to PRes frames
+} tSimNetConfig;
+
+/**
+\brief Network statistics
+
+The structure contains the statistics of the simulated network.
+*/
+typedef struct
+{
+    UINT64              txFrames;           ///< Number of transmitted frames
+    UINT64              txBytes;            ///< Number of transmitted bytes (without preamble and FCS)
+    UINT64              rxFrames;           ///< Number of frames passed to a node
+    UINT64              filteredFrames;     ///< Number of frames dropped by an Rx filter
+    UINT64              collisions;         ///< Number of overlapping receptions at a node
+} tSimNetStatistics;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError  simnet_init(const tSimNetConfig* pConfig_p);
+void        simnet_exit(void);
+tOplkError  simnet_sendFrame(tSimNode* pNode_p,
+                             tEdrvTxBuffer* pTxBuffer_p);
+UINT32      simnet_getFrameTime(UINT frameSize_p);
+UINT32      simnet_getPropagationDelay(UINT srcIndex_p,
+                                       UINT dstIndex_p);
+void        simnet_getStatistics(tSimNetStatistics* pStatistics_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_simnet_H_ */
@@ -0,0 +1,1582 @@
+/**
+********************************************************************************
+\file   simnode.c
+
+\brief  Simulated POWERLINK nodes
+
+This file contains the node instances of the network simulator. Each node loads
+a private copy of a node module which contains the openPOWERLINK simulation
+library and the object dictionary of the node. The copies are loaded from
+anonymous memory files, so every node gets its own instance of the static
+stack variables. The functions of the simulation interface are implemented on
+top of the virtual clock of the simulation engine.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "simnode.h"
+#include "simnet.h"
+#include "simengine.h"
+
+#include <sim-api.h>
+#include <sim-apievent.h>
+#include <sim-edrv.h>
+#include <sim-hrestimer.h>
+#include <sim-processsync.h>
+#include <sim-target.h>
+#include <sim-timer.h>
+#include <sim-trace.h>
+
+#include <dlfcn.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMNODE_MODULE_MN               "libsimnode-mn.so"
+#define SIMNODE_MODULE_CN               "libsimnode-cn.so"
+#define SIMNODE_MN_NODEID               0xF0
+#define SIMNODE_IP_ADDR                 0xC0A86400      // 192.168.100.0
+#define SIMNODE_SUBNET_MASK             0xFFFFFF00      // 255.255.255.0
+#define SIMNODE_DEFAULT_GATEWAY         0xC0A864FE      // 192.168.100.C_ADR_RT1_DEF_NODE_ID
+#define SIMNODE_PROCESS_INTERVAL        10000000        // Interval of the main loop of a node [ns]
+#define SIMNODE_TIMER_TABLE_INCREMENT   32
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Node module image
+
+The structure contains the file content of a node module.
+*/
+typedef struct
+{
+    UINT8*          pImage;         ///< File content
+    size_t          size;           ///< File size
+} tSimNodeModule;
+
+/**
+\brief Simulation interface setters of a node module
+
+The structure contains the functions of a node module which connect the
+simulation interface to the simulator.
+*/
+typedef struct
+{
+    BOOL    (*pfnSetEdrvFunctions)(tSimulationInstanceHdl simHdl_p, tEdrvFunctions functions_p);
+    BOOL    (*pfnSetHresTimerFunctions)(tSimulationInstanceHdl simHdl_p, tHresTimerFunctions functions_p);
+    BOOL    (*pfnSetTimerFunctions)(tSimulationInstanceHdl simHdl_p, tTimerFunctions functions_p);
+    BOOL    (*pfnSetTargetFunctions)(tSimulationInstanceHdl simHdl_p, tTargetFunctions functions_p);
+    BOOL    (*pfnSetTraceFunctions)(tSimulationInstanceHdl simHdl_p, tTraceFunctions functions_p);
+    BOOL    (*pfnSetProcessSyncFunctions)(tSimulationInstanceHdl simHdl_p, tProcessSyncFunctions functions_p);
+    BOOL    (*pfnSetApiEventFunctions)(tSimulationInstanceHdl simHdl_p, tApiEventFunctions functions_p);
+} tSimNodeSetters;
+
+/**
+\brief Symbol table entry
+
+The structure describes a symbol which is resolved from a node module.
+*/
+typedef struct
+{
+    const char*     pName;          ///< Symbol name
+    size_t          offset;         ///< Offset of the function pointer in the target structure
+} tSimNodeSymbol;
+
+/**
+\brief Node instance
+
+The structure contains the instance data of the node module.
+*/
+typedef struct
+{
+    tSimNodeConfig  config;         ///< Node configuration
+    tSimNode*       pNodes;         ///< Node table
+    UINT            nodeCount;      ///< Number of nodes
+    tSimNodeModule  moduleMn;       ///< MN module image
+    tSimNodeModule  moduleCn;       ///< CN module image
+} tSimNodeInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSimNodeInstance         instance_l;
+
+static const tSimNodeSymbol     aApiSymbols_l[] =
+{
+    {"oplk_initialize",                 offsetof(tSimNodeApi, pfnInitialize)},
+    {"oplk_exit",                       offsetof(tSimNodeApi, pfnExit)},
+    {"sim_oplkCreate",                  offsetof(tSimNodeApi, pfnCreate)},
+    {"oplk_destroy",                    offsetof(tSimNodeApi, pfnDestroy)},
+    {"oplk_execNmtCommand",             offsetof(tSimNodeApi, pfnExecNmtCommand)},
+    {"oplk_process",                    offsetof(tSimNodeApi, pfnProcess)},
+    {"oplk_setCdcBuffer",               offsetof(tSimNodeApi, pfnSetCdcBuffer)},
+    {"oplk_readObject",                 offsetof(tSimNodeApi, pfnReadObject)},
+    {"oplk_freeSdoChannel",             offsetof(tSimNodeApi, pfnFreeSdoChannel)},
+    {"oplk_allocProcessImage",          offsetof(tSimNodeApi, pfnAllocProcessImage)},
+    {"oplk_freeProcessImage",           offsetof(tSimNodeApi, pfnFreeProcessImage)},
+    {"oplk_linkProcessImageObject",     offsetof(tSimNodeApi, pfnLinkProcessImageObject)},
+    {"oplk_exchangeProcessImageIn",     offsetof(tSimNodeApi, pfnExchangeProcessImageIn)},
+    {"oplk_exchangeProcessImageOut",    offsetof(tSimNodeApi, pfnExchangeProcessImageOut)},
+    {"oplk_getProcessImageIn",          offsetof(tSimNodeApi, pfnGetProcessImageIn)},
+    {"oplk_getProcessImageOut",         offsetof(tSimNodeApi, pfnGetProcessImageOut)},
+    {"obdcreate_initObd",               offsetof(tSimNodeApi, pfnInitObd)},
+    {"sim_userTimerCallback",           offsetof(tSimNodeApi, pfnUserTimerCallback)},
+    {NULL,                              0}
+};
+
+static const tSimNodeSymbol     aSetterSymbols_l[] =
+{
+    {"sim_setEdrvFunctions",            offsetof(tSimNodeSetters, pfnSetEdrvFunctions)},
+    {"sim_setHresTimerFunctions",       offsetof(tSimNodeSetters, pfnSetHresTimerFunctions)},
+    {"sim_setTimerFunctions",           offsetof(tSimNodeSetters, pfnSetTimerFunctions)},
+    {"sim_setTargetFunctions",          offsetof(tSimNodeSetters, pfnSetTargetFunctions)},
+    {"sim_setTraceFunctions",           offsetof(tSimNodeSetters, pfnSetTraceFunctions)},
+    {"sim_setProcessSyncFunctions",     offsetof(tSimNodeSetters, pfnSetProcessSyncFunctions)},
+    {"sim_setApiEventFunctions",        offsetof(tSimNodeSetters, pfnSetApiEventFunctions)},
+    {NULL,                              0}
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError   readModule(const char* pFileName_p,
+                               tSimNodeModule* pModule_p);
+static tOplkError   loadModule(tSimNode* pNode_p,
+                               const tSimNodeModule* pModule_p);
+static tOplkError   resolveSymbols(void* pLibHandle_p,
+                                   const tSimNodeSymbol* pSymbols_p,
+                                   void* pTarget_p);
+static tOplkError   connectSimInterface(tSimNode* pNode_p,
+                                        const tSimNodeSetters* pSetters_p);
+static tSimNode*    getNode(tSimulationInstanceHdl simHdl_p);
+
+// Ethernet driver
+static tOplkError   initEdrv(tSimulationInstanceHdl simHdl_p,
+                             const tEdrvInitParam* pInitParam_p);
+static tOplkError   exitEdrv(tSimulationInstanceHdl simHdl_p);
+static const UINT8* getMacAddr(tSimulationInstanceHdl simHdl_p);
+static tOplkError   sendTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                 tEdrvTxBuffer* pBuffer_p);
+static tOplkError   allocTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                  tEdrvTxBuffer* pBuffer_p);
+static tOplkError   freeTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                 tEdrvTxBuffer* pBuffer_p);
+static tOplkError   changeRxFilter(tSimulationInstanceHdl simHdl_p,
+                                   tEdrvFilter* pFilter_p,
+                                   UINT count_p,
+                                   UINT entryChanged_p,
+                                   UINT changeFlags_p);
+static tOplkError   clearRxMulticastMacAddr(tSimulationInstanceHdl simHdl_p,
+                                            const UINT8* pMacAddr_p);
+static tOplkError   setRxMulticastMacAddr(tSimulationInstanceHdl simHdl_p,
+                                          const UINT8* pMacAddr_p);
+
+// High-resolution timer
+static tOplkError   initExitHresTimer(tSimulationInstanceHdl simHdl_p);
+static tOplkError   modifyHresTimer(tSimulationInstanceHdl simHdl_p,
+                                    tTimerHdl* pTimerHdl_p,
+                                    ULONGLONG time_p,
+                                    tTimerkCallback pfnCallback_p,
+                                    ULONG argument_p,
+                                    BOOL fContinue_p);
+static tOplkError   deleteHresTimer(tSimulationInstanceHdl simHdl_p,
+                                    tTimerHdl* pTimerHdl_p);
+static void         hresTimerExpired(UINT nodeIndex_p,
+                                     UINT64 arg_p,
+                                     void* pArg_p);
+static void         processLoop(UINT nodeIndex_p,
+                                UINT64 arg_p,
+                                void* pArg_p);
+
+// User timer
+static tOplkError   initExitTimer(tSimulationInstanceHdl simHdl_p);
+static tOplkError   setTimer(tSimulationInstanceHdl simHdl_p,
+                             tTimerHdl* pTimerHdl_p,
+                             ULONG timeInMs_p,
+                             tTimerArg argument_p);
+static tOplkError   modifyTimer(tSimulationInstanceHdl simHdl_p,
+                                tTimerHdl* pTimerHdl_p,
+                                ULONG timeInMs_p,
+                                tTimerArg argument_p);
+static tOplkError   deleteTimer(tSimulationInstanceHdl simHdl_p,
+                                tTimerHdl* pTimerHdl_p);
+static BOOL         isTimerActive(tSimulationInstanceHdl simHdl_p,
+                                  tTimerHdl timerHdl_p);
+static tOplkError   startTimer(tSimNode* pNode_p,
+                               UINT index_p,
+                               ULONG timeInMs_p,
+                               tTimerArg argument_p);
+static void         timerExpired(UINT nodeIndex_p,
+                                 UINT64 arg_p,
+                                 void* pArg_p);
+
+// Target
+static tOplkError   initExitTarget(tSimulationInstanceHdl simHdl_p);
+static void         msleep(tSimulationInstanceHdl simHdl_p,
+                           UINT32 milliSeconds_p);
+static tOplkError   setIp(tSimulationInstanceHdl simHdl_p,
+                          const char* ifName_p,
+                          UINT32 ipAddress_p,
+                          UINT32 subnetMask_p,
+                          UINT16 mtu_p);
+static tOplkError   setDefaultGateway(tSimulationInstanceHdl simHdl_p,
+                                      UINT32 defaultGateway_p);
+static UINT32       getTick(tSimulationInstanceHdl simHdl_p);
+static tOplkError   setLed(tSimulationInstanceHdl simHdl_p,
+                           tLedType ledType_p,
+                           BOOL fLedOn_p);
+
+// Trace
+static void         printTrace(tSimulationInstanceHdl simHdl_p,
+                          const char* pMsg_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the simulated nodes
+
+The function loads one MN and the configured number of CN module copies and
+connects their simulation interfaces to the simulator. Node index 0 is the MN,
+the CNs follow with their node ID as index.
+
+\param[in]      pConfig_p           Node configuration
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnode_init(const tSimNodeConfig* pConfig_p)
+{
+    tOplkError      ret;
+    char            aFileName[1024];
+    UINT            nodeIndex;
+    tSimNode*       pNode;
+
+    memset(&instance_l, 0, sizeof(instance_l));
+    instance_l.config = *pConfig_p;
+
+    if ((pConfig_p->cnCount == 0) || (pConfig_p->cnCount > SIMNODE_MAX_CN))
+        return kErrorInvalidNodeId;
+
+    snprintf(aFileName, sizeof(aFileName), "%s/%s", pConfig_p->pModuleDir, SIMNODE_MODULE_MN);
+    ret = readModule(aFileName, &instance_l.moduleMn);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    snprintf(aFileName, sizeof(aFileName), "%s/%s", pConfig_p->pModuleDir, SIMNODE_MODULE_CN);
+    ret = readModule(aFileName, &instance_l.moduleCn);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    instance_l.nodeCount = pConfig_p->cnCount + 1;
+    instance_l.pNodes = (tSimNode*)calloc(instance_l.nodeCount, sizeof(tSimNode));
+    if (instance_l.pNodes == NULL)
+    {
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
+    for (nodeIndex = 0; nodeIndex < instance_l.nodeCount; nodeIndex++)
+    {
+        pNode = &instance_l.pNodes[nodeIndex];
+
+        pNode->nodeIndex = nodeIndex;
+        pNode->fMn = (nodeIndex == SIMNODE_MN_INDEX);
+        pNode->nodeId = pNode->fMn ? SIMNODE_MN_NODEID : nodeIndex;
+        pNode->fVerbose = pConfig_p->fVerbose;
+
+        // Locally administered unicast address
+        pNode->aMacAddr[0] = 0x02;
+        pNode->aMacAddr[5] = (UINT8)pNode->nodeId;
+
+        ret = loadModule(pNode, pNode->fMn ? &instance_l.moduleMn : &instance_l.moduleCn);
+        if (ret != kErrorOk)
+            goto Exit;
+    }
+
+Exit:
+    if (ret != kErrorOk)
+        simnode_exit();
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the simulated nodes
+
+The function destroys the stacks of all nodes and unloads the node modules.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnode_exit(void)
+{
+    UINT        nodeIndex;
+    tSimNode*   pNode;
+
+    if (instance_l.pNodes != NULL)
+    {
+        for (nodeIndex = 0; nodeIndex < instance_l.nodeCount; nodeIndex++)
+        {
+            pNode = &instance_l.pNodes[nodeIndex];
+
+            if (pNode->fStackCreated)
+            {
+                pNode->api.pfnFreeProcessImage();
+                pNode->api.pfnDestroy();
+                pNode->api.pfnExit();
+            }
+
+            if (pNode->pLibHandle != NULL)
+                dlclose(pNode->pLibHandle);
+
+            if (pNode->moduleFd > 0)
+                close(pNode->moduleFd);
+
+            free(pNode->pTimer);
+        }
+
+        free(instance_l.pNodes);
+    }
+
+    free(instance_l.moduleMn.pImage);
+    free(instance_l.moduleCn.pImage);
+    memset(&instance_l, 0, sizeof(instance_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create the stack of a node
+
+The function initializes the object dictionary and creates the openPOWERLINK
+stack of the node. The MN additionally gets the concise device configuration
+of the network.
+
+\param[in]      nodeIndex_p         Index of the node
+\param[in]      pCdc_p              Concise device configuration (MN only)
+\param[in]      cdcSize_p           Size of the concise device configuration
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnode_create(UINT nodeIndex_p,
+                          const void* pCdc_p,
+                          size_t cdcSize_p)
+{
+    tOplkError          ret;
+    tSimNode*           pNode = &instance_l.pNodes[nodeIndex_p];
+    tOplkApiInitParam   initParam;
+
+    memset(&initParam, 0, sizeof(initParam));
+    initParam.sizeOfInitParam = sizeof(initParam);
+
+    initParam.nodeId = pNode->nodeId;
+    initParam.hwParam.pDevName = "sim";
+    initParam.ipAddress = SIMNODE_IP_ADDR | initParam.nodeId;
+    memcpy(initParam.aMacAddress, pNode->aMacAddr, sizeof(initParam.aMacAddress));
+
+    initParam.fAsyncOnly              = FALSE;
+    initParam.featureFlags            = UINT_MAX;
+    initParam.cycleLen                = instance_l.config.cycleLen;
+    initParam.isochrTxMaxPayload      = pNode->fMn ? 256 : C_DLL_ISOCHR_MAX_PAYL;
+    initParam.isochrRxMaxPayload      = pNode->fMn ? 1490 : C_DLL_ISOCHR_MAX_PAYL;
+    initParam.presMaxLatency          = 50000;
+    initParam.preqActPayloadLimit     = 36;
+    initParam.presActPayloadLimit     = 36;
+    initParam.asndMaxLatency          = 150000;
+    initParam.multiplCylceCnt         = 0;
+    initParam.asyncMtu                = 1500;
+    initParam.prescaler               = 2;
+    initParam.lossOfFrameTolerance    = 500000;
+    initParam.asyncSlotTimeout        = instance_l.config.asyncSlotTimeout;
+    initParam.waitSocPreq             = 1000;
+    initParam.deviceType              = UINT_MAX;
+    initParam.vendorId                = UINT_MAX;
+    initParam.productCode             = UINT_MAX;
+    initParam.revisionNumber          = UINT_MAX;
+    initParam.serialNumber            = UINT_MAX;
+    initParam.subnetMask              = SIMNODE_SUBNET_MASK;
+    initParam.defaultGateway          = SIMNODE_DEFAULT_GATEWAY;
+    sprintf((char*)initParam.sHostname, "%02x-%08x", initParam.nodeId, initParam.vendorId);
+    initParam.syncNodeId              = C_ADR_SYNC_ON_SOA;
+    initParam.fSyncOnPrcNode          = FALSE;
+    initParam.pEventUserArg           = pNode;
+
+    ret = pNode->api.pfnInitObd(&initParam.obdInitParam);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    ret = pNode->api.pfnInitialize();
+    if (ret != kErrorOk)
+        goto Exit;
+
+    // The simulation interface replaces the event and sync callbacks
+    ret = pNode->api.pfnCreate(&initParam);
+    if (ret != kErrorOk)
+    {
+        pNode->api.pfnExit();
+        goto Exit;
+    }
+
+    pNode->fStackCreated = TRUE;
+
+    ret = simengine_schedule(simengine_getTime() + SIMNODE_PROCESS_INTERVAL,
+                             processLoop, nodeIndex_p, 0, NULL);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    if (pCdc_p != NULL)
+        ret = pNode->api.pfnSetCdcBuffer(pCdc_p, cdcSize_p);
+
+Exit:
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Boot a node
+
+The function starts the NMT state machine of the node.
+
+\param[in]      nodeIndex_p         Index of the node
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnode_boot(UINT nodeIndex_p)
+{
+    tOplkError  ret;
+    tSimNode*   pNode = &instance_l.pNodes[nodeIndex_p];
+
+    ret = pNode->api.pfnExecNmtCommand(kNmtEventSwReset);
+    simnode_process(pNode);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the number of nodes
+
+\return The function returns the number of simulated nodes (MN and CNs).
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+UINT simnode_getCount(void)
+{
+    return instance_l.nodeCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a node
+
+\param[in]      nodeIndex_p         Index of the node
+
+\return The function returns the node or NULL if the index is invalid.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tSimNode* simnode_getNode(UINT nodeIndex_p)
+{
+    if (nodeIndex_p >= instance_l.nodeCount)
+        return NULL;
+
+    return &instance_l.pNodes[nodeIndex_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the user layer of a node
+
+The function calls oplk_process() of the node. It is called periodically like
+the main loop of an application and after calls into the API of a node. Frames
+and timers are processed directly by the stack of the node, because the kernel
+and user layer events of a node are passed synchronously.
+
+\param[in]      pNode_p             Node to process
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnode_process(tSimNode* pNode_p)
+{
+    if (!pNode_p->fStackCreated)
+        return;
+
+    pNode_p->api.pfnProcess();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a node module
+
+\param[in]      pFileName_p         File name of the module
+\param[out]     pModule_p           Module image
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError readModule(const char* pFileName_p,
+                             tSimNodeModule* pModule_p)
+{
+    FILE*   pFile;
+    long    size;
+
+    pFile = fopen(pFileName_p, "rb");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "Unable to open node module %s!\n", pFileName_p);
+        return kErrorNoResource;
+    }
+
+    if ((fseek(pFile, 0, SEEK_END) != 0) || ((size = ftell(pFile)) <= 0) ||
+        (fseek(pFile, 0, SEEK_SET) != 0))
+    {
+        fclose(pFile);
+        return kErrorNoResource;
+    }
+
+    pModule_p->pImage = (UINT8*)malloc((size_t)size);
+    if ((pModule_p->pImage == NULL) ||
+        (fread(pModule_p->pImage, 1, (size_t)size, pFile) != (size_t)size))
+    {
+        fclose(pFile);
+        return kErrorNoResource;
+    }
+
+    pModule_p->size = (size_t)size;
+    fclose(pFile);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load a private copy of a node module
+
+The dynamic loader maps a file only once. Therefore, the module image is copied
+into an anonymous memory file for each node, which is then loaded as a distinct
+shared object. The loader also identifies objects by their path, so the file
+stays open until the node is unloaded to keep the paths unique.
+
+\param[in,out]  pNode_p             Node to load the module for
+\param[in]      pModule_p           Module image
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError loadModule(tSimNode* pNode_p,
+                             const tSimNodeModule* pModule_p)
+{
+    tOplkError      ret;
+    tSimNodeSetters setters;
+    char            aName[32];
+    char            aPath[64];
+    int             fd;
+    size_t          written = 0;
+    ssize_t         count;
+
+    snprintf(aName, sizeof(aName), "simnode-%u", pNode_p->nodeIndex);
+    fd = memfd_create(aName, 0);
+    if (fd < 0)
+    {
+        fprintf(stderr, "memfd_create() failed for node %u!\n", pNode_p->nodeIndex);
+        return kErrorNoResource;
+    }
+
+    while (written < pModule_p->size)
+    {
+        count = write(fd, pModule_p->pImage + written, pModule_p->size - written);
+        if (count <= 0)
+        {
+            close(fd);
+            return kErrorNoResource;
+        }
+        written += (size_t)count;
+    }
+
+    snprintf(aPath, sizeof(aPath), "/proc/self/fd/%d", fd);
+    pNode_p->pLibHandle = dlopen(aPath, RTLD_NOW | RTLD_LOCAL);
+    pNode_p->moduleFd = fd;
+    if (pNode_p->pLibHandle == NULL)
+    {
+        fprintf(stderr, "Loading node module failed for node %u: %s\n",
+                pNode_p->nodeIndex, dlerror());
+        return kErrorNoResource;
+    }
+
+    ret = resolveSymbols(pNode_p->pLibHandle, aApiSymbols_l, &pNode_p->api);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = resolveSymbols(pNode_p->pLibHandle, aSetterSymbols_l, &setters);
+    if (ret != kErrorOk)
+        return ret;
+
+    return connectSimInterface(pNode_p, &setters);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Resolve symbols of a node module
+
+\param[in]      pLibHandle_p        Handle of the loaded module
+\param[in]      pSymbols_p          Symbol table (terminated by a NULL name)
+\param[out]     pTarget_p           Structure receiving the function pointers
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError resolveSymbols(void* pLibHandle_p,
+                                 const tSimNodeSymbol* pSymbols_p,
+                                 void* pTarget_p)
+{
+    void*   pSymbol;
+
+    for (; pSymbols_p->pName != NULL; pSymbols_p++)
+    {
+        pSymbol = dlsym(pLibHandle_p, pSymbols_p->pName);
+        if (pSymbol == NULL)
+        {
+            fprintf(stderr, "Node module lacks symbol %s!\n", pSymbols_p->pName);
+            return kErrorNoResource;
+        }
+
+        // Object to function pointer conversion as recommended by POSIX for dlsym()
+        memcpy((UINT8*)pTarget_p + pSymbols_p->offset, &pSymbol, sizeof(pSymbol));
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Connect the simulation interface of a node
+
+\param[in]      pNode_p             Node
+\param[in]      pSetters_p          Simulation interface setters of the node module
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError connectSimInterface(tSimNode* pNode_p,
+                                      const tSimNodeSetters* pSetters_p)
+{
+    tSimulationInstanceHdl  simHdl = pNode_p->nodeIndex;
+    tEdrvFunctions          edrvFunctions;
+    tHresTimerFunctions     hresTimerFunctions;
+    tTimerFunctions         timerFunctions;
+    tTargetFunctions        targetFunctions;
+    tTraceFunctions         traceFunctions;
+    tProcessSyncFunctions   processSyncFunctions;
+    tApiEventFunctions      apiEventFunctions;
+
+    edrvFunctions.pfnInit = initEdrv;
+    edrvFunctions.pfnExit = exitEdrv;
+    edrvFunctions.pfnGetMacAddr = getMacAddr;
+    edrvFunctions.pfnSendTxBuffer = sendTxBuffer;
+    edrvFunctions.pfnAllocTxBuffer = allocTxBuffer;
+    edrvFunctions.pfnFreeTxBuffer = freeTxBuffer;
+    edrvFunctions.pfnChangeRxFilter = changeRxFilter;
+    edrvFunctions.pfnClearMulticastMacAddr = clearRxMulticastMacAddr;
+    edrvFunctions.pfnSetMulticastMacAddr = setRxMulticastMacAddr;
+
+    hresTimerFunctions.pfnInitHresTimer = initExitHresTimer;
+    hresTimerFunctions.pfnExitHresTimer = initExitHresTimer;
+    hresTimerFunctions.pfnModifyHresTimer = modifyHresTimer;
+    hresTimerFunctions.pfnDeleteHresTimer = deleteHresTimer;
+
+    timerFunctions.pfnInitTimer = initExitTimer;
+    timerFunctions.pfnExitTimer = initExitTimer;
+    timerFunctions.pfnSetTimer = setTimer;
+    timerFunctions.pfnModifyTimer = modifyTimer;
+    timerFunctions.pfnDeleteTimer = deleteTimer;
+    timerFunctions.pfnIsTimerActive = isTimerActive;
+
+    targetFunctions.pfnInit = initExitTarget;
+    targetFunctions.pfnExit = initExitTarget;
+    targetFunctions.pfnMsleep = msleep;
+    targetFunctions.pfnSetIp = setIp;
+    targetFunctions.pfnSetDefaultGateway = setDefaultGateway;
+    targetFunctions.pfnGetTick = getTick;
+    targetFunctions.pfnSetLed = setLed;
+
+    traceFunctions.pfnTrace = printTrace;
+
+    processSyncFunctions.pfnCbProcessSync = instance_l.config.pfnCbSync;
+    apiEventFunctions.pfnCbEvent = instance_l.config.pfnCbEvent;
+
+    if (!pSetters_p->pfnSetEdrvFunctions(simHdl, edrvFunctions) ||
+        !pSetters_p->pfnSetHresTimerFunctions(simHdl, hresTimerFunctions) ||
+        !pSetters_p->pfnSetTimerFunctions(simHdl, timerFunctions) ||
+        !pSetters_p->pfnSetTargetFunctions(simHdl, targetFunctions) ||
+        !pSetters_p->pfnSetTraceFunctions(simHdl, traceFunctions) ||
+        !pSetters_p->pfnSetProcessSyncFunctions(simHdl, processSyncFunctions) ||
+        !pSetters_p->pfnSetApiEventFunctions(simHdl, apiEventFunctions))
+    {
+        fprintf(stderr, "Connecting the simulation interface failed for node %u!\n",
+                pNode_p->nodeIndex);
+        return kErrorNoResource;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get node of a simulation instance handle
+
+\param[in]      simHdl_p            Simulation instance handle
+
+\return The function returns the node.
+*/
+//------------------------------------------------------------------------------
+static tSimNode* getNode(tSimulationInstanceHdl simHdl_p)
+{
+    return &instance_l.pNodes[simHdl_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the Ethernet driver of a node
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      pInitParam_p        Ethernet driver initialization parameters
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError initEdrv(tSimulationInstanceHdl simHdl_p,
+                           const tEdrvInitParam* pInitParam_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+    static const UINT8 aZeroMac[6] = {0};
+
+    pNode->pfnRxHandler = pInitParam_p->pfnRxHandler;
+    if (memcmp(pInitParam_p->aMacAddr, aZeroMac, sizeof(aZeroMac)) != 0)
+        memcpy(pNode->aMacAddr, pInitParam_p->aMacAddr, sizeof(pNode->aMacAddr));
+
+    pNode->pFilter = NULL;
+    pNode->filterCount = 0;
+    memset(pNode->aPresFilter, SIMNODE_PRES_FILTER_UNKNOWN, sizeof(pNode->aPresFilter));
+    pNode->multicastCount = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the Ethernet driver of a node
+
+\param[in]      simHdl_p            Simulation instance handle
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError exitEdrv(tSimulationInstanceHdl simHdl_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+
+    pNode->pfnRxHandler = NULL;
+    pNode->pFilter = NULL;
+    pNode->filterCount = 0;
+    memset(pNode->aPresFilter, SIMNODE_PRES_FILTER_UNKNOWN, sizeof(pNode->aPresFilter));
+    pNode->multicastCount = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get MAC address of a node
+
+\param[in]      simHdl_p            Simulation instance handle
+
+\return The function returns the MAC address of the node.
+*/
+//------------------------------------------------------------------------------
+static const UINT8* getMacAddr(tSimulationInstanceHdl simHdl_p)
+{
+    return getNode(simHdl_p)->aMacAddr;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a Tx buffer
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      pBuffer_p           Tx buffer to send
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sendTxBuffer(tSimulationInstanceHdl simHdl_p,
+                               tEdrvTxBuffer* pBuffer_p)
+{
+    return simnet_sendFrame(getNode(simHdl_p), pBuffer_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate a Tx buffer
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError allocTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                tEdrvTxBuffer* pBuffer_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+
+    pBuffer_p->pBuffer = (UINT8*)calloc(1, pBuffer_p->maxBufferSize);
+    if (pBuffer_p->pBuffer == NULL)
+        return kErrorEdrvNoFreeBufEntry;
+
+    pBuffer_p->txBufferNumber.pArg = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a Tx buffer
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError freeTxBuffer(tSimulationInstanceHdl simHdl_p,
+                               tEdrvTxBuffer* pBuffer_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+
+    free(pBuffer_p->pBuffer);
+    pBuffer_p->pBuffer = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change the Rx filters of a node
+
+The DLL passes its complete filter table, which is kept for the Rx filter
+emulation of the network. The cached filter results of the node are discarded.
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      pFilter_p           Rx filter table
+\param[in]      count_p             Number of filter entries
+\param[in]      entryChanged_p      Index of the changed entry
+\param[in]      changeFlags_p       Changed properties
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError changeRxFilter(tSimulationInstanceHdl simHdl_p,
+                                 tEdrvFilter* pFilter_p,
+                                 UINT count_p,
+                                 UINT entryChanged_p,
+                                 UINT changeFlags_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+
+    UNUSED_PARAMETER(entryChanged_p);
+    UNUSED_PARAMETER(changeFlags_p);
+
+    pNode->pFilter = pFilter_p;
+    pNode->filterCount = (pFilter_p != NULL) ? count_p : 0;
+    memset(pNode->aPresFilter, SIMNODE_PRES_FILTER_UNKNOWN, sizeof(pNode->aPresFilter));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove an Rx multicast address of a node
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      pMacAddr_p          Multicast address
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError clearRxMulticastMacAddr(tSimulationInstanceHdl simHdl_p,
+                                          const UINT8* pMacAddr_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+    UINT        index;
+
+    for (index = 0; index < pNode->multicastCount; index++)
+    {
+        if (memcmp(pNode->aMulticast[index], pMacAddr_p, 6) == 0)
+        {
+            pNode->multicastCount--;
+            memmove(pNode->aMulticast[index], pNode->aMulticast[index + 1],
+                    (pNode->multicastCount - index) * 6);
+            break;
+        }
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add an Rx multicast address to a node
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      pMacAddr_p          Multicast address
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setRxMulticastMacAddr(tSimulationInstanceHdl simHdl_p,
+                                        const UINT8* pMacAddr_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+    UINT        index;
+
+    for (index = 0; index < pNode->multicastCount; index++)
+    {
+        if (memcmp(pNode->aMulticast[index], pMacAddr_p, 6) == 0)
+            return kErrorOk;
+    }
+
+    if (pNode->multicastCount >= SIMNODE_MAX_MULTICAST)
+        return kErrorEdrvNoFreeBufEntry;
+
+    memcpy(pNode->aMulticast[pNode->multicastCount++], pMacAddr_p, 6);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize or shut down the high-resolution timers of a node
+
+\param[in]      simHdl_p            Simulation instance handle
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError initExitHresTimer(tSimulationInstanceHdl simHdl_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+
+    // Pending expiries are discarded by the handle check
+    memset(pNode->aHresTimer, 0, sizeof(pNode->aHresTimer));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Modify a high-resolution timer
+
+The timer handle contains the timer slot in the lower 8 bits and a serial
+number above. Each modification assigns a new serial number, so expiries of the
+previous timeout are discarded and zombie callbacks cannot occur.
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in,out]  pTimerHdl_p         Pointer to timer handle
+\param[in]      time_p              Relative timeout [ns]
+\param[in]      pfnCallback_p       Timer callback
+\param[in]      argument_p          Timer argument
+\param[in]      fContinue_p         TRUE for a continuous timer
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError modifyHresTimer(tSimulationInstanceHdl simHdl_p,
+                                  tTimerHdl* pTimerHdl_p,
+                                  ULONGLONG time_p,
+                                  tTimerkCallback pfnCallback_p,
+                                  ULONG argument_p,
+                                  BOOL fContinue_p)
+{
+    tSimNode*           pNode = getNode(simHdl_p);
+    tSimNodeHresTimer*  pTimer;
+    UINT                slot;
+
+    if ((pTimerHdl_p == NULL) || (pfnCallback_p == NULL))
+        return kErrorTimerInvalidHandle;
+
+    if (*pTimerHdl_p == 0)
+    {
+        for (slot = 0; slot < SIMNODE_HRESTIMER_COUNT; slot++)
+        {
+            if (pNode->aHresTimer[slot].timerHdl == 0)
+                break;
+        }
+
+        if (slot >= SIMNODE_HRESTIMER_COUNT)
+            return kErrorTimerNoTimerCreated;
+    }
+    else
+    {
+        slot = (UINT)(*pTimerHdl_p & 0xFF) - 1;
+        if (slot >= SIMNODE_HRESTIMER_COUNT)
+            return kErrorTimerInvalidHandle;
+    }
+
+    pTimer = &pNode->aHresTimer[slot];
+    pNode->hresTimerSerial++;
+    pTimer->timerHdl = ((tTimerHdl)pNode->hresTimerSerial << 8) | (slot + 1);
+    pTimer->pfnCallback = pfnCallback_p;
+    pTimer->argument = argument_p;
+    pTimer->period = fContinue_p ? time_p : 0;
+    pTimer->dueTime = simengine_getTime() + time_p;
+    *pTimerHdl_p = pTimer->timerHdl;
+
+    return simengine_schedule(pTimer->dueTime, hresTimerExpired,
+                              pNode->nodeIndex, pTimer->timerHdl, NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Delete a high-resolution timer
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in,out]  pTimerHdl_p         Pointer to timer handle
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError deleteHresTimer(tSimulationInstanceHdl simHdl_p,
+                                  tTimerHdl* pTimerHdl_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+    UINT        slot;
+
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    if (*pTimerHdl_p == 0)
+        return kErrorOk;
+
+    slot = (UINT)(*pTimerHdl_p & 0xFF) - 1;
+    if (slot >= SIMNODE_HRESTIMER_COUNT)
+        return kErrorTimerInvalidHandle;
+
+    if (pNode->aHresTimer[slot].timerHdl == *pTimerHdl_p)
+        pNode->aHresTimer[slot].timerHdl = 0;
+
+    *pTimerHdl_p = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  High-resolution timer expiry
+
+Continuous timers are rescheduled relative to their previous due time, so they
+do not drift.
+
+\param[in]      nodeIndex_p         Index of the node
+\param[in]      arg_p               Timer handle of the expiry
+\param[in]      pArg_p              Unused
+*/
+//------------------------------------------------------------------------------
+static void hresTimerExpired(UINT nodeIndex_p,
+                             UINT64 arg_p,
+                             void* pArg_p)
+{
+    tSimNode*           pNode = &instance_l.pNodes[nodeIndex_p];
+    tSimNodeHresTimer*  pTimer;
+    tTimerEventArg      eventArg;
+
+    UNUSED_PARAMETER(pArg_p);
+
+    pTimer = &pNode->aHresTimer[(arg_p & 0xFF) - 1];
+    if (pTimer->timerHdl != (tTimerHdl)arg_p)
+        return;     // Timer was modified or deleted
+
+    if (pTimer->period != 0)
+    {
+        pTimer->dueTime += pTimer->period;
+        simengine_schedule(pTimer->dueTime, hresTimerExpired, nodeIndex_p, arg_p, NULL);
+    }
+
+    memset(&eventArg, 0, sizeof(eventArg));
+    eventArg.timerHdl.handle = pTimer->timerHdl;
+    eventArg.argument.value = (UINT32)pTimer->argument;
+
+    pTimer->pfnCallback(&eventArg);
+    simnode_process(pNode);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Main loop of a node
+
+The function processes the user layer of a node and reschedules itself like the
+main loop of an application.
+
+\param[in]      nodeIndex_p         Index of the node
+\param[in]      arg_p               Unused
+\param[in]      pArg_p              Unused
+*/
+//------------------------------------------------------------------------------
+static void processLoop(UINT nodeIndex_p,
+                        UINT64 arg_p,
+                        void* pArg_p)
+{
+    tSimNode*   pNode = &instance_l.pNodes[nodeIndex_p];
+
+    UNUSED_PARAMETER(arg_p);
+    UNUSED_PARAMETER(pArg_p);
+
+    if (!pNode->fStackCreated)
+        return;
+
+    simnode_process(pNode);
+    simengine_schedule(simengine_getTime() + SIMNODE_PROCESS_INTERVAL,
+                       processLoop, nodeIndex_p, 0, NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize or shut down the user timers of a node
+
+\param[in]      simHdl_p            Simulation instance handle
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError initExitTimer(tSimulationInstanceHdl simHdl_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+
+    // Pending expiries are discarded by the serial number check
+    if (pNode->pTimer != NULL)
+        memset(pNode->pTimer, 0, sizeof(tSimNodeTimer) * pNode->timerCount);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create and set a user timer
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[out]     pTimerHdl_p         Pointer to store the timer handle
+\param[in]      timeInMs_p          Timeout [ms]
+\param[in]      argument_p          Timer argument
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setTimer(tSimulationInstanceHdl simHdl_p,
+                           tTimerHdl* pTimerHdl_p,
+                           ULONG timeInMs_p,
+                           tTimerArg argument_p)
+{
+    tSimNode*       pNode = getNode(simHdl_p);
+    tSimNodeTimer*  pTable;
+    UINT            index;
+
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    for (index = 0; index < pNode->timerCount; index++)
+    {
+        if (!pNode->pTimer[index].fUsed)
+            break;
+    }
+
+    if (index == pNode->timerCount)
+    {
+        pTable = (tSimNodeTimer*)realloc(pNode->pTimer,
+                                         sizeof(tSimNodeTimer) * (pNode->timerCount + SIMNODE_TIMER_TABLE_INCREMENT));
+        if (pTable == NULL)
+            return kErrorTimerNoTimerCreated;
+
+        memset(&pTable[pNode->timerCount], 0, sizeof(tSimNodeTimer) * SIMNODE_TIMER_TABLE_INCREMENT);
+        pNode->pTimer = pTable;
+        pNode->timerCount += SIMNODE_TIMER_TABLE_INCREMENT;
+    }
+
+    pNode->pTimer[index].fUsed = TRUE;
+    *pTimerHdl_p = index + 1;
+
+    return startTimer(pNode, index, timeInMs_p, argument_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Modify a user timer
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in,out]  pTimerHdl_p         Pointer to timer handle
+\param[in]      timeInMs_p          Timeout [ms]
+\param[in]      argument_p          Timer argument
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError modifyTimer(tSimulationInstanceHdl simHdl_p,
+                              tTimerHdl* pTimerHdl_p,
+                              ULONG timeInMs_p,
+                              tTimerArg argument_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+    UINT        index;
+
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    if (*pTimerHdl_p == 0)
+        return setTimer(simHdl_p, pTimerHdl_p, timeInMs_p, argument_p);
+
+    index = (UINT)*pTimerHdl_p - 1;
+    if ((index >= pNode->timerCount) || !pNode->pTimer[index].fUsed)
+        return kErrorTimerInvalidHandle;
+
+    return startTimer(pNode, index, timeInMs_p, argument_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Delete a user timer
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in,out]  pTimerHdl_p         Pointer to timer handle
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError deleteTimer(tSimulationInstanceHdl simHdl_p,
+                              tTimerHdl* pTimerHdl_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+    UINT        index;
+
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    if (*pTimerHdl_p == 0)
+        return kErrorOk;
+
+    index = (UINT)*pTimerHdl_p - 1;
+    if (index < pNode->timerCount)
+    {
+        pNode->pTimer[index].fUsed = FALSE;
+        pNode->pTimer[index].fActive = FALSE;
+        pNode->pTimer[index].serial++;
+    }
+
+    *pTimerHdl_p = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check whether a user timer is active
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      timerHdl_p          Timer handle
+
+\return The function returns TRUE if the timer is running.
+*/
+//------------------------------------------------------------------------------
+static BOOL isTimerActive(tSimulationInstanceHdl simHdl_p,
+                          tTimerHdl timerHdl_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+    UINT        index = (UINT)timerHdl_p - 1;
+
+    if ((timerHdl_p == 0) || (index >= pNode->timerCount))
+        return FALSE;
+
+    return pNode->pTimer[index].fActive;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start a user timer
+
+The expiry event carries the table index and the serial number of the timeout,
+so a restarted or deleted timer discards its previous expiry.
+
+\param[in,out]  pNode_p             Node
+\param[in]      index_p             Index of the timer in the timer table
+\param[in]      timeInMs_p          Timeout [ms]
+\param[in]      argument_p          Timer argument
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError startTimer(tSimNode* pNode_p,
+                             UINT index_p,
+                             ULONG timeInMs_p,
+                             tTimerArg argument_p)
+{
+    tSimNodeTimer*  pTimer = &pNode_p->pTimer[index_p];
+
+    pTimer->serial++;
+    pTimer->fActive = TRUE;
+    pTimer->argument = argument_p;
+
+    return simengine_schedule(simengine_getTime() + ((UINT64)timeInMs_p * 1000000ULL),
+                              timerExpired,
+                              pNode_p->nodeIndex,
+                              ((UINT64)pTimer->serial << 32) | index_p,
+                              NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  User timer expiry
+
+\param[in]      nodeIndex_p         Index of the node
+\param[in]      arg_p               Serial number and table index of the timer
+\param[in]      pArg_p              Unused
+*/
+//------------------------------------------------------------------------------
+static void timerExpired(UINT nodeIndex_p,
+                         UINT64 arg_p,
+                         void* pArg_p)
+{
+    tSimNode*       pNode = &instance_l.pNodes[nodeIndex_p];
+    UINT            index = (UINT)(arg_p & 0xFFFFFFFF);
+    tSimNodeTimer*  pTimer;
+
+    UNUSED_PARAMETER(pArg_p);
+
+    if (index >= pNode->timerCount)
+        return;
+
+    pTimer = &pNode->pTimer[index];
+    if (!pTimer->fActive || (pTimer->serial != (UINT32)(arg_p >> 32)))
+        return;     // Timer was modified or deleted
+
+    pTimer->fActive = FALSE;
+    pNode->api.pfnUserTimerCallback(index + 1, pTimer->argument);
+    simnode_process(pNode);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize or shut down the target functions of a node
+
+\param[in]      simHdl_p            Simulation instance handle
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError initExitTarget(tSimulationInstanceHdl simHdl_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Sleep
+
+Sleeping would block the whole simulation, so the call returns immediately.
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      milliSeconds_p      Sleep time [ms]
+*/
+//------------------------------------------------------------------------------
+static void msleep(tSimulationInstanceHdl simHdl_p,
+                   UINT32 milliSeconds_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+    UNUSED_PARAMETER(milliSeconds_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set IP address
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      ifName_p            Interface name
+\param[in]      ipAddress_p         IP address
+\param[in]      subnetMask_p        Subnet mask
+\param[in]      mtu_p               MTU
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setIp(tSimulationInstanceHdl simHdl_p,
+                        const char* ifName_p,
+                        UINT32 ipAddress_p,
+                        UINT32 subnetMask_p,
+                        UINT16 mtu_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+    UNUSED_PARAMETER(ifName_p);
+    UNUSED_PARAMETER(ipAddress_p);
+    UNUSED_PARAMETER(subnetMask_p);
+    UNUSED_PARAMETER(mtu_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set default gateway
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      defaultGateway_p    Default gateway
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setDefaultGateway(tSimulationInstanceHdl simHdl_p,
+                                    UINT32 defaultGateway_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+    UNUSED_PARAMETER(defaultGateway_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get tick count
+
+\param[in]      simHdl_p            Simulation instance handle
+
+\return The function returns the virtual time in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT32 getTick(tSimulationInstanceHdl simHdl_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+
+    return (UINT32)(simengine_getTime() / 1000000ULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set LED
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      ledType_p           LED type
+\param[in]      fLedOn_p            LED state
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setLed(tSimulationInstanceHdl simHdl_p,
+                         tLedType ledType_p,
+                         BOOL fLedOn_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+    UNUSED_PARAMETER(ledType_p);
+    UNUSED_PARAMETER(fLedOn_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print a stack trace message
+
+\param[in]      simHdl_p            Simulation instance handle
+\param[in]      pMsg_p              Trace message
+*/
+//------------------------------------------------------------------------------
+static void printTrace(tSimulationInstanceHdl simHdl_p,
+                       const char* pMsg_p)
+{
+    tSimNode*   pNode = getNode(simHdl_p);
+
+    if (pNode->fVerbose)
+    {
+        printf("%10.6f [%3u] %s",
+               (double)simengine_getTime() / 1e9,
+               pNode->nodeId,
+               pMsg_p);
+    }
+}
+
+/// \}
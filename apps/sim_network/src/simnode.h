@@ -0,0 +1,201 @@
+/**
+********************************************************************************
+\file   simnode.h
+
+\brief  Definitions for the simulated POWERLINK nodes
+
+This file contains the definitions of the node instances of the network
+simulator. Every node runs its own copy of the openPOWERLINK stack which is
+connected to the simulation through the simulation interface.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_simnode_H_
+#define _INC_simnode_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplk.h>
+#include <oplk/event.h>
+#include <sim.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMNODE_MN_INDEX                0       // Node index of the MN
+#define SIMNODE_MAX_CN                  239     // Maximum number of simulated CNs
+#define SIMNODE_MAX_MULTICAST           8       // Maximum number of Rx multicast addresses per node
+#define SIMNODE_HRESTIMER_COUNT         8       // High-resolution timers per node
+
+#define SIMNODE_PRES_FILTER_UNKNOWN     0       // PRes Rx filter result is not cached
+#define SIMNODE_PRES_FILTER_REJECT      1       // PRes frames of the source node are rejected
+#define SIMNODE_PRES_FILTER_ACCEPT      2       // PRes frames of the source node are received
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Stack API of a node
+
+The structure contains the functions of the openPOWERLINK stack copy of a node.
+They are resolved from the node module when the node is created.
+*/
+typedef struct
+{
+    tOplkError  (*pfnInitialize)(void);
+    void        (*pfnExit)(void);
+    tOplkError  (*pfnCreate)(tOplkApiInitParam* pInitParam_p);
+    tOplkError  (*pfnDestroy)(void);
+    tOplkError  (*pfnExecNmtCommand)(tNmtEvent nmtEvent_p);
+    tOplkError  (*pfnProcess)(void);
+    tOplkError  (*pfnSetCdcBuffer)(const void* pCdc_p, size_t cdcSize_p);
+    tOplkError  (*pfnReadObject)(tSdoComConHdl* pSdoComConHdl_p,
+                                 UINT nodeId_p,
+                                 UINT index_p,
+                                 UINT subindex_p,
+                                 void* pDstData_le_p,
+                                 UINT* pSize_p,
+                                 tSdoType sdoType_p,
+                                 void* pUserArg_p);
+    tOplkError  (*pfnFreeSdoChannel)(tSdoComConHdl sdoComConHdl_p);
+    tOplkError  (*pfnAllocProcessImage)(UINT sizeProcessImageIn_p,
+                                        UINT sizeProcessImageOut_p);
+    tOplkError  (*pfnFreeProcessImage)(void);
+    tOplkError  (*pfnLinkProcessImageObject)(UINT objIndex_p,
+                                             UINT firstSubindex_p,
+                                             UINT offsetPI_p,
+                                             BOOL fOutputPI_p,
+                                             tObdSize entrySize_p,
+                                             UINT* pVarEntries_p);
+    tOplkError  (*pfnExchangeProcessImageIn)(void);
+    tOplkError  (*pfnExchangeProcessImageOut)(void);
+    void*       (*pfnGetProcessImageIn)(void);
+    void*       (*pfnGetProcessImageOut)(void);
+    tOplkError  (*pfnInitObd)(tObdInitParam* pInitParam_p);
+    void        (*pfnUserTimerCallback)(tTimerHdl timerHdl_p, tTimerArg argument_p);
+} tSimNodeApi;
+
+/**
+\brief High-resolution timer of a node
+
+The structure describes a high-resolution timer of a simulated node.
+*/
+typedef struct
+{
+    tTimerHdl       timerHdl;       ///< Current handle of the timer (0 if unused)
+    tTimerkCallback pfnCallback;    ///< Timer callback of the stack
+    ULONG           argument;       ///< Timer argument of the stack
+    UINT64          period;         ///< Period of a continuous timer (0 for a one-shot timer) [ns]
+    UINT64          dueTime;        ///< Due time of the next expiry [ns]
+} tSimNodeHresTimer;
+
+/**
+\brief User timer of a node
+
+The structure describes a user timer of a simulated node.
+*/
+typedef struct
+{
+    BOOL            fUsed;          ///< Timer entry is in use
+    BOOL            fActive;        ///< Timer is running
+    UINT32          serial;         ///< Serial number of the current timeout
+    tTimerArg       argument;       ///< Timer argument of the stack
+} tSimNodeTimer;
+
+/**
+\brief Simulated node
+
+The structure contains the instance data of a simulated node. The node index is
+used as simulation instance handle of the node.
+*/
+typedef struct
+{
+    UINT                nodeIndex;                                  ///< Index of the node in the simulation
+    UINT                nodeId;                                     ///< POWERLINK node ID
+    BOOL                fMn;                                        ///< Node is the MN
+    void*               pLibHandle;                                 ///< Handle of the loaded node module
+    int                 moduleFd;                                   ///< Memory file of the loaded node module
+    tSimNodeApi         api;                                        ///< Stack API of the node
+    BOOL                fStackCreated;                              ///< Stack was created successfully
+    UINT8               aMacAddr[6];                                ///< MAC address of the node
+    tEdrvRxHandler      pfnRxHandler;                               ///< Rx handler of the Ethernet driver
+    tEdrvFilter*        pFilter;                                    ///< Rx filter table of the DLL
+    UINT                filterCount;                                ///< Number of Rx filter entries
+    UINT8               aPresFilter[C_ADR_BROADCAST + 1];           ///< Cached Rx filter results for PRes frames per source node ID
+    UINT8               aMulticast[SIMNODE_MAX_MULTICAST][6];       ///< Rx multicast addresses
+    UINT                multicastCount;                             ///< Number of Rx multicast addresses
+    tSimNodeHresTimer   aHresTimer[SIMNODE_HRESTIMER_COUNT];        ///< High-resolution timers
+    UINT32              hresTimerSerial;                            ///< Serial number for high-resolution timer handles
+    tSimNodeTimer*      pTimer;                                     ///< User timer table
+    UINT                timerCount;                                 ///< Size of the user timer table
+    UINT64              txBusyUntil;                                ///< End of the last transmission incl. IFG [ns]
+    UINT64              rxBusyUntil;                                ///< End of the last reception [ns]
+    BOOL                fVerbose;                                   ///< Print stack traces
+} tSimNode;
+
+/**
+\brief Node configuration
+
+The structure contains the parameters for creating the simulated nodes.
+*/
+typedef struct
+{
+    const char*         pModuleDir;     ///< Directory of the node modules
+    UINT                cnCount;        ///< Number of CNs
+    UINT32              cycleLen;       ///< POWERLINK cycle length [us]
+    UINT32              asyncSlotTimeout; ///< Async slot timeout of the MN [ns]
+    BOOL                fVerbose;       ///< Print stack traces
+    tSimEventCb         pfnCbEvent;     ///< API event callback of the simulation
+    tSimProcessSyncCb   pfnCbSync;      ///< Process sync callback of the simulation
+} tSimNodeConfig;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError  simnode_init(const tSimNodeConfig* pConfig_p);
+void        simnode_exit(void);
+tOplkError  simnode_create(UINT nodeIndex_p,
+                           const void* pCdc_p,
+                           size_t cdcSize_p);
+tOplkError  simnode_boot(UINT nodeIndex_p);
+UINT        simnode_getCount(void);
+tSimNode*   simnode_getNode(UINT nodeIndex_p);
+void        simnode_process(tSimNode* pNode_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_simnode_H_ */
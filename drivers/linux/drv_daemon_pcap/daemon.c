@@ -184,7 +184,8 @@ int main(int argc, char* argv[])
     fExit = FALSE;
     while (!fExit)
     {
-        target_msleep(1);
+        // ctrlk_process() blocks until a command is received or the command
+        // wait timeout elapsed, therefore no additional sleep is required.
         if (console_kbhit())
         {
             cKey = (char)console_getch();
@@ -61,9 +61,57 @@ OPTION (CFG_COMPILE_SHARED_LIBRARY              "Build openPOWERLINK library as
 # Options for library features
 
 OPTION (CFG_INCLUDE_MN_REDUNDANCY               "Compile MN redundancy functions into MN libraries" OFF)
+OPTION (CFG_EDRV_RAWSOCK                        "Use raw socket (PACKET_MMAP) Ethernet driver instead of pcap in userspace libraries" OFF)
+CMAKE_DEPENDENT_OPTION (CFG_EDRV_RAWSOCK_TXTIME "Send the cyclic frames of the MN time triggered with launch times (SO_TXTIME)" OFF
+                                                "CFG_EDRV_RAWSOCK;NOT CFG_EDRV_XDP" OFF)
+SET(CFG_EDRV_RAWSOCK_TXTIME_LEAD "150000" CACHE STRING "Time the frames of a cycle are handed to the raw socket Ethernet driver ahead of their launch [ns]")
+OPTION (CFG_EDRV_XDP                            "Use AF_XDP Ethernet driver instead of pcap in userspace libraries" OFF)
+CMAKE_DEPENDENT_OPTION (CFG_EDRV_XDP_BUSY_POLL  "Busy-poll the AF_XDP rings on a dedicated CPU core" OFF
+                                                "CFG_EDRV_XDP" OFF)
+SET(CFG_EDRV_XDP_BUSY_POLL_CPU "1" CACHE STRING "CPU core of the busy-polling AF_XDP driver thread")
+SET(CFG_EDRV_XDP_QUEUE_ID "0" CACHE STRING "Network device queue used by the AF_XDP driver")
+OPTION (CFG_HRESTIMER_HYBRID                    "Use single-thread hybrid sleep/spin high-resolution timer in userspace libraries" OFF)
+SET(CFG_HRESTIMER_HYBRID_SPIN_WINDOW "50000" CACHE STRING "Busy-wait time of the hybrid high-resolution timer before a deadline [ns]")
+SET(CFG_HRESTIMER_HYBRID_CPU "-1" CACHE STRING "CPU core of the hybrid high-resolution timer thread (-1 = not bound)")
+CMAKE_DEPENDENT_OPTION (CFG_HRESTIMER_HYBRID_SCHED_DEADLINE "Run the hybrid high-resolution timer thread with SCHED_DEADLINE" OFF
+                                                "CFG_HRESTIMER_HYBRID" OFF)
+SET(CFG_TIMESYNC_BUSY_POLL_TIME "0" CACHE STRING "Time oplk_waitSyncEvent() busy-polls for the next sync event before it sleeps [ns] (0 = disabled)")
 CMAKE_DEPENDENT_OPTION (CFG_STORE_RESTORE       "Support storing of OD in non-volatile memory (file system)" ON
                                                 "CFG_COMPILE_LIB_CN OR CFG_COMPILE_LIB_CNAPP_USERINTF OR CFG_COMPILE_LIB_CNAPP_KERNELINTF" OFF)
 
+################################################################################
+# Select Ethernet driver of userspace libraries
+
+IF(CFG_EDRV_XDP)
+    SET(HARDWARE_DRIVER_LINUXUSER_SOURCES ${HARDWARE_DRIVER_LINUXUSER_SOURCES} ${EDRV_LINUXUSER_XDP_SOURCES})
+    ADD_DEFINITIONS(-DCONFIG_EDRV_XDP_QUEUE_ID=${CFG_EDRV_XDP_QUEUE_ID})
+    IF(CFG_EDRV_XDP_BUSY_POLL)
+        ADD_DEFINITIONS(-DCONFIG_EDRV_XDP_BUSY_POLL=TRUE -DCONFIG_EDRV_XDP_BUSY_POLL_CPU=${CFG_EDRV_XDP_BUSY_POLL_CPU})
+    ENDIF()
+ELSEIF(CFG_EDRV_RAWSOCK)
+    SET(HARDWARE_DRIVER_LINUXUSER_SOURCES ${HARDWARE_DRIVER_LINUXUSER_SOURCES} ${EDRV_LINUXUSER_RAWSOCK_SOURCES})
+ELSE()
+    SET(HARDWARE_DRIVER_LINUXUSER_SOURCES ${HARDWARE_DRIVER_LINUXUSER_SOURCES} ${EDRV_LINUXUSER_PCAP_SOURCES})
+ENDIF()
+
+################################################################################
+# Select high-resolution timer of userspace libraries
+
+IF(CFG_HRESTIMER_HYBRID)
+    SET(HARDWARE_DRIVER_LINUXUSER_SOURCES ${HARDWARE_DRIVER_LINUXUSER_SOURCES} ${HRESTIMER_LINUXUSER_HYBRID_SOURCES})
+    ADD_DEFINITIONS(-DCONFIG_HRESTIMER_SPIN_WINDOW=${CFG_HRESTIMER_HYBRID_SPIN_WINDOW} -DCONFIG_HRESTIMER_CPU=${CFG_HRESTIMER_HYBRID_CPU})
+    IF(CFG_HRESTIMER_HYBRID_SCHED_DEADLINE)
+        ADD_DEFINITIONS(-DCONFIG_HRESTIMER_SCHED_DEADLINE=TRUE)
+    ENDIF()
+ELSE()
+    SET(HARDWARE_DRIVER_LINUXUSER_SOURCES ${HARDWARE_DRIVER_LINUXUSER_SOURCES} ${HRESTIMER_LINUXUSER_POSIX_SOURCES})
+ENDIF()
+
+################################################################################
+# Sync event busy-polling of userspace application libraries
+
+ADD_DEFINITIONS(-DCONFIG_TIMESYNC_BUSY_POLL_TIME=${CFG_TIMESYNC_BUSY_POLL_TIME})
+
 ################################################################################
 # Add library subdirectories
 
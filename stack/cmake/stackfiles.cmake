@@ -259,8 +259,7 @@ SET(EVENT_UCAL_WINDOWSIOCTL_SOURCES
     )
 
 SET(EVENT_UCAL_SIM_SOURCES
-    ${USER_SOURCE_DIR}/event/eventucal-nooscircbuf.c
-    ${USER_SOURCE_DIR}/event/eventucalintf-circbuf.c
+    ${USER_SOURCE_DIR}/event/eventucal-direct.c
     )
 
 ################################################################################
@@ -272,7 +271,7 @@ SET(PDO_UCAL_LOCAL_SOURCES
 
 SET(PDO_UCAL_POSIX_SOURCES
     ${USER_SOURCE_DIR}/pdo/pdoucalmem-posixshm.c
-    ${USER_SOURCE_DIR}/timesync/timesyncucal-bsdsem.c
+    ${USER_SOURCE_DIR}/timesync/timesyncucal-futex.c
     )
 
 SET(PDO_UCAL_LINUXMMAPIOCTL_SOURCES
@@ -327,6 +326,7 @@ SET(KERNEL_SOURCES
     ${KERNEL_SOURCE_DIR}/ctrl/ctrlk.c
     ${KERNEL_SOURCE_DIR}/led/ledk.c
     ${KERNEL_SOURCE_DIR}/led/ledktimer.c
+    ${KERNEL_SOURCE_DIR}/latency/latencyk.c
     )
 
 ################################################################################
@@ -436,7 +436,7 @@ SET(PDO_KCAL_LOCAL_SOURCES
 
 SET(PDO_KCAL_POSIXMEM_SOURCES
     ${KERNEL_SOURCE_DIR}/pdo/pdokcalmem-posixshm.c
-    ${KERNEL_SOURCE_DIR}/timesync/timesynckcal-bsdsem.c
+    ${KERNEL_SOURCE_DIR}/timesync/timesynckcal-futex.c
     )
 
 SET(PDO_KCAL_LINUXKERNEL_SOURCES
@@ -464,9 +464,29 @@ SET(PDO_KCAL_DUALPROCSHM_SOURCES
 
 SET(HARDWARE_DRIVER_LINUXUSER_SOURCES
     ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
-    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
     ${EDRV_SOURCE_DIR}/edrvcyclic.c
+    ${COMMON_SOURCE_DIR}/bufalloc/bufalloc.c
+    )
+
+SET(EDRV_LINUXUSER_PCAP_SOURCES
     ${EDRV_SOURCE_DIR}/edrv-pcap_linux.c
+    ${EDRV_SOURCE_DIR}/edrvrxpool.c
+    )
+
+SET(EDRV_LINUXUSER_RAWSOCK_SOURCES
+    ${EDRV_SOURCE_DIR}/edrv-rawsock_linux.c
+    )
+
+SET(EDRV_LINUXUSER_XDP_SOURCES
+    ${EDRV_SOURCE_DIR}/edrv-xdp_linux.c
+    )
+
+SET(HRESTIMER_LINUXUSER_POSIX_SOURCES
+    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
+    )
+
+SET(HRESTIMER_LINUXUSER_HYBRID_SOURCES
+    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix_hybrid.c
     )
 
 SET(HARDWARE_DRIVER_WINDOWS_SOURCES
@@ -779,6 +799,7 @@ SET(KERNEL_HEADERS
     ${STACK_INCLUDE_DIR}/kernel/timestamp.h
     ${STACK_INCLUDE_DIR}/kernel/synctimer.h
     ${STACK_INCLUDE_DIR}/kernel/errhndk.h
+    ${STACK_INCLUDE_DIR}/kernel/latencyk.h
     ${STACK_INCLUDE_DIR}/kernel/eventk.h
     ${STACK_INCLUDE_DIR}/kernel/eventkcal.h
     ${STACK_INCLUDE_DIR}/kernel/eventkcalintf.h
@@ -789,6 +810,7 @@ SET(KERNEL_HEADERS
     ${STACK_INCLUDE_DIR}/kernel/veth.h
     ${STACK_INCLUDE_DIR}/kernel/edrv.h
     ${STACK_INCLUDE_DIR}/kernel/edrvcyclic.h
+    ${STACK_INCLUDE_DIR}/kernel/edrvrxpool.h
     ${STACK_INCLUDE_DIR}/kernel/timesynck.h
     ${STACK_INCLUDE_DIR}/kernel/timesynckcal.h
     )
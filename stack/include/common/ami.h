@@ -4,6 +4,11 @@
 
 \brief  Definitions for the abstract memory interface (ami)
 
+With GCC compatible compilers the conversion functions are implemented inline
+in this header (see CONFIG_AMI_INLINE). They use unaligned-safe loads and
+stores and the byte swap builtins of the compiler, so a conversion compiles to
+a single load or store on little endian targets. Otherwise the functions are
+provided by the architecture specific implementation in common/ami.
 *******************************************************************************/
 
 /*------------------------------------------------------------------------------
@@ -52,13 +57,53 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define ami_getUint8Be(pAddr_p) (*(const UINT8*)(pAddr_p))
 #define ami_getUint8Le(pAddr_p) (*(const UINT8*)(pAddr_p))
 
+// The architecture specific implementations define AMI_OUT_OF_LINE to get the
+// prototypes instead of the inline functions.
+#if ((CONFIG_AMI_INLINE != FALSE) && defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+     !defined(AMI_OUT_OF_LINE))
+#define AMI_USE_INLINE
+#endif
+
+#ifdef AMI_USE_INLINE
+
+#define AMI_INLINE                      static __inline__ __attribute__((always_inline))
+
+// Conversion between platform byte order and little/big endian
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define AMI_SWAP_LE16(val_p)            __builtin_bswap16(val_p)
+#define AMI_SWAP_LE32(val_p)            __builtin_bswap32(val_p)
+#define AMI_SWAP_LE64(val_p)            __builtin_bswap64(val_p)
+#define AMI_SWAP_BE16(val_p)            (val_p)
+#define AMI_SWAP_BE32(val_p)            (val_p)
+#define AMI_SWAP_BE64(val_p)            (val_p)
+#else
+#define AMI_SWAP_LE16(val_p)            (val_p)
+#define AMI_SWAP_LE32(val_p)            (val_p)
+#define AMI_SWAP_LE64(val_p)            (val_p)
+#define AMI_SWAP_BE16(val_p)            __builtin_bswap16(val_p)
+#define AMI_SWAP_BE32(val_p)            __builtin_bswap32(val_p)
+#define AMI_SWAP_BE64(val_p)            __builtin_bswap64(val_p)
+#endif
+
+#endif /* AMI_USE_INLINE */
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+#ifdef AMI_USE_INLINE
+
+// Types for unaligned accesses which may alias any other type
+typedef UINT16 tAmiUnalignedUint16 __attribute__((aligned(1), may_alias));
+typedef UINT32 tAmiUnalignedUint32 __attribute__((aligned(1), may_alias));
+typedef UINT64 tAmiUnalignedUint64 __attribute__((aligned(1), may_alias));
+
+#endif /* AMI_USE_INLINE */
 
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
+#ifndef AMI_USE_INLINE
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -117,8 +162,319 @@ UINT64 ami_getUint64Le(const void* pAddr_p);
 void ami_setTimeOfDay(void* pAddr_p, const tTimeOfDay* pTimeOfDay_p);
 void ami_getTimeOfDay(const void* pAddr_p, tTimeOfDay* pTimeOfDay_p);
 
+// Conversion functions for arrays
+void ami_setUint16ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p);
+void ami_getUint16ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p);
+void ami_setUint32ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p);
+void ami_getUint32ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p);
+void ami_setUint64ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p);
+void ami_getUint64ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p);
+
 #ifdef __cplusplus
 }
 #endif
 
+#else /* AMI_USE_INLINE */
+
+//------------------------------------------------------------------------------
+// inline functions
+//------------------------------------------------------------------------------
+
+// Unaligned access to memory in platform byte order
+AMI_INLINE UINT16 ami_loadUint16(const void* pAddr_p)
+{
+    return *(const tAmiUnalignedUint16*)pAddr_p;
+}
+
+AMI_INLINE UINT32 ami_loadUint32(const void* pAddr_p)
+{
+    return *(const tAmiUnalignedUint32*)pAddr_p;
+}
+
+AMI_INLINE UINT64 ami_loadUint64(const void* pAddr_p)
+{
+    return *(const tAmiUnalignedUint64*)pAddr_p;
+}
+
+AMI_INLINE void ami_storeUint16(void* pAddr_p, UINT16 val_p)
+{
+    *(tAmiUnalignedUint16*)pAddr_p = val_p;
+}
+
+AMI_INLINE void ami_storeUint32(void* pAddr_p, UINT32 val_p)
+{
+    *(tAmiUnalignedUint32*)pAddr_p = val_p;
+}
+
+AMI_INLINE void ami_storeUint64(void* pAddr_p, UINT64 val_p)
+{
+    *(tAmiUnalignedUint64*)pAddr_p = val_p;
+}
+
+// Conversion functions for data type WORD
+AMI_INLINE void ami_setUint16Be(void* pAddr_p, UINT16 uint16Val_p)
+{
+    ami_storeUint16(pAddr_p, AMI_SWAP_BE16(uint16Val_p));
+}
+
+AMI_INLINE void ami_setUint16Le(void* pAddr_p, UINT16 uint16Val_p)
+{
+    ami_storeUint16(pAddr_p, AMI_SWAP_LE16(uint16Val_p));
+}
+
+AMI_INLINE UINT16 ami_getUint16Be(const void* pAddr_p)
+{
+    return AMI_SWAP_BE16(ami_loadUint16(pAddr_p));
+}
+
+AMI_INLINE UINT16 ami_getUint16Le(const void* pAddr_p)
+{
+    return AMI_SWAP_LE16(ami_loadUint16(pAddr_p));
+}
+
+// Conversion functions for data type DWORD
+AMI_INLINE void ami_setUint32Be(void* pAddr_p, UINT32 uint32Val_p)
+{
+    ami_storeUint32(pAddr_p, AMI_SWAP_BE32(uint32Val_p));
+}
+
+AMI_INLINE void ami_setUint32Le(void* pAddr_p, UINT32 uint32Val_p)
+{
+    ami_storeUint32(pAddr_p, AMI_SWAP_LE32(uint32Val_p));
+}
+
+AMI_INLINE UINT32 ami_getUint32Be(const void* pAddr_p)
+{
+    return AMI_SWAP_BE32(ami_loadUint32(pAddr_p));
+}
+
+AMI_INLINE UINT32 ami_getUint32Le(const void* pAddr_p)
+{
+    return AMI_SWAP_LE32(ami_loadUint32(pAddr_p));
+}
+
+// Conversion functions for data type QWORD
+AMI_INLINE void ami_setUint64Be(void* pAddr_p, UINT64 uint64Val_p)
+{
+    ami_storeUint64(pAddr_p, AMI_SWAP_BE64(uint64Val_p));
+}
+
+AMI_INLINE void ami_setUint64Le(void* pAddr_p, UINT64 uint64Val_p)
+{
+    ami_storeUint64(pAddr_p, AMI_SWAP_LE64(uint64Val_p));
+}
+
+AMI_INLINE UINT64 ami_getUint64Be(const void* pAddr_p)
+{
+    return AMI_SWAP_BE64(ami_loadUint64(pAddr_p));
+}
+
+AMI_INLINE UINT64 ami_getUint64Le(const void* pAddr_p)
+{
+    return AMI_SWAP_LE64(ami_loadUint64(pAddr_p));
+}
+
+// Conversion functions for data type DWORD24
+AMI_INLINE void ami_setUint24Be(void* pAddr_p, UINT32 uint32Val_p)
+{
+    ami_setUint16Be(pAddr_p, (UINT16)(uint32Val_p >> 8));
+    ((UINT8*)pAddr_p)[2] = (UINT8)uint32Val_p;
+}
+
+AMI_INLINE void ami_setUint24Le(void* pAddr_p, UINT32 uint32Val_p)
+{
+    ami_setUint16Le(pAddr_p, (UINT16)uint32Val_p);
+    ((UINT8*)pAddr_p)[2] = (UINT8)(uint32Val_p >> 16);
+}
+
+AMI_INLINE UINT32 ami_getUint24Be(const void* pAddr_p)
+{
+    return ((UINT32)ami_getUint16Be(pAddr_p) << 8) |
+           ((const UINT8*)pAddr_p)[2];
+}
+
+AMI_INLINE UINT32 ami_getUint24Le(const void* pAddr_p)
+{
+    return (UINT32)ami_getUint16Le(pAddr_p) |
+           ((UINT32)((const UINT8*)pAddr_p)[2] << 16);
+}
+
+// Conversion functions for data type QWORD40
+AMI_INLINE void ami_setUint40Be(void* pAddr_p, UINT64 uint64Val_p)
+{
+    ami_setUint32Be(pAddr_p, (UINT32)(uint64Val_p >> 8));
+    ((UINT8*)pAddr_p)[4] = (UINT8)uint64Val_p;
+}
+
+AMI_INLINE void ami_setUint40Le(void* pAddr_p, UINT64 uint64Val_p)
+{
+    ami_setUint32Le(pAddr_p, (UINT32)uint64Val_p);
+    ((UINT8*)pAddr_p)[4] = (UINT8)(uint64Val_p >> 32);
+}
+
+AMI_INLINE UINT64 ami_getUint40Be(const void* pAddr_p)
+{
+    return ((UINT64)ami_getUint32Be(pAddr_p) << 8) |
+           ((const UINT8*)pAddr_p)[4];
+}
+
+AMI_INLINE UINT64 ami_getUint40Le(const void* pAddr_p)
+{
+    return (UINT64)ami_getUint32Le(pAddr_p) |
+           ((UINT64)((const UINT8*)pAddr_p)[4] << 32);
+}
+
+// Conversion functions for data type QWORD48
+AMI_INLINE void ami_setUint48Be(void* pAddr_p, UINT64 uint64Val_p)
+{
+    ami_setUint32Be(pAddr_p, (UINT32)(uint64Val_p >> 16));
+    ami_setUint16Be((UINT8*)pAddr_p + 4, (UINT16)uint64Val_p);
+}
+
+AMI_INLINE void ami_setUint48Le(void* pAddr_p, UINT64 uint64Val_p)
+{
+    ami_setUint32Le(pAddr_p, (UINT32)uint64Val_p);
+    ami_setUint16Le((UINT8*)pAddr_p + 4, (UINT16)(uint64Val_p >> 32));
+}
+
+AMI_INLINE UINT64 ami_getUint48Be(const void* pAddr_p)
+{
+    return ((UINT64)ami_getUint32Be(pAddr_p) << 16) |
+           ami_getUint16Be((const UINT8*)pAddr_p + 4);
+}
+
+AMI_INLINE UINT64 ami_getUint48Le(const void* pAddr_p)
+{
+    return (UINT64)ami_getUint32Le(pAddr_p) |
+           ((UINT64)ami_getUint16Le((const UINT8*)pAddr_p + 4) << 32);
+}
+
+// Conversion functions for data type QWORD56
+AMI_INLINE void ami_setUint56Be(void* pAddr_p, UINT64 uint64Val_p)
+{
+    ami_setUint48Be(pAddr_p, uint64Val_p >> 8);
+    ((UINT8*)pAddr_p)[6] = (UINT8)uint64Val_p;
+}
+
+AMI_INLINE void ami_setUint56Le(void* pAddr_p, UINT64 uint64Val_p)
+{
+    ami_setUint48Le(pAddr_p, uint64Val_p);
+    ((UINT8*)pAddr_p)[6] = (UINT8)(uint64Val_p >> 48);
+}
+
+AMI_INLINE UINT64 ami_getUint56Be(const void* pAddr_p)
+{
+    return (ami_getUint48Be(pAddr_p) << 8) |
+           ((const UINT8*)pAddr_p)[6];
+}
+
+AMI_INLINE UINT64 ami_getUint56Le(const void* pAddr_p)
+{
+    return ami_getUint48Le(pAddr_p) |
+           ((UINT64)((const UINT8*)pAddr_p)[6] << 48);
+}
+
+// Conversion functions for type tTimeOfDay
+AMI_INLINE void ami_setTimeOfDay(void* pAddr_p, const tTimeOfDay* pTimeOfDay_p)
+{
+    ami_setUint32Le(pAddr_p, pTimeOfDay_p->msec & 0x0FFFFFFF);
+    ami_setUint16Le((UINT8*)pAddr_p + 4, pTimeOfDay_p->days);
+}
+
+AMI_INLINE void ami_getTimeOfDay(const void* pAddr_p, tTimeOfDay* pTimeOfDay_p)
+{
+    pTimeOfDay_p->msec = ami_getUint32Le(pAddr_p) & 0x0FFFFFFF;
+    pTimeOfDay_p->days = ami_getUint16Le((const UINT8*)pAddr_p + 4);
+}
+
+// Conversion functions for arrays
+// On little endian targets the arrays are copied. Otherwise the conversion loops
+// are vectorized by the compiler (-O3 or -ftree-vectorize) if the target provides
+// byte shuffle instructions (e.g. AltiVec, NEON, SSSE3).
+AMI_INLINE void ami_setUint16ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p)
+{
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    tAmiUnalignedUint16*        pAddr = (tAmiUnalignedUint16*)pAddr_p;
+    const tAmiUnalignedUint16*  pVal = (const tAmiUnalignedUint16*)pVal_p;
+    UINT                        i;
+
+    for (i = 0; i < count_p; i++)
+        pAddr[i] = AMI_SWAP_LE16(pVal[i]);
+#else
+    __builtin_memcpy(pAddr_p, pVal_p, count_p * 2);
+#endif
+}
+
+AMI_INLINE void ami_getUint16ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p)
+{
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    const tAmiUnalignedUint16*  pAddr = (const tAmiUnalignedUint16*)pAddr_p;
+    tAmiUnalignedUint16*        pVal = (tAmiUnalignedUint16*)pVal_p;
+    UINT                        i;
+
+    for (i = 0; i < count_p; i++)
+        pVal[i] = AMI_SWAP_LE16(pAddr[i]);
+#else
+    __builtin_memcpy(pVal_p, pAddr_p, count_p * 2);
+#endif
+}
+
+AMI_INLINE void ami_setUint32ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p)
+{
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    tAmiUnalignedUint32*        pAddr = (tAmiUnalignedUint32*)pAddr_p;
+    const tAmiUnalignedUint32*  pVal = (const tAmiUnalignedUint32*)pVal_p;
+    UINT                        i;
+
+    for (i = 0; i < count_p; i++)
+        pAddr[i] = AMI_SWAP_LE32(pVal[i]);
+#else
+    __builtin_memcpy(pAddr_p, pVal_p, count_p * 4);
+#endif
+}
+
+AMI_INLINE void ami_getUint32ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p)
+{
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    const tAmiUnalignedUint32*  pAddr = (const tAmiUnalignedUint32*)pAddr_p;
+    tAmiUnalignedUint32*        pVal = (tAmiUnalignedUint32*)pVal_p;
+    UINT                        i;
+
+    for (i = 0; i < count_p; i++)
+        pVal[i] = AMI_SWAP_LE32(pAddr[i]);
+#else
+    __builtin_memcpy(pVal_p, pAddr_p, count_p * 4);
+#endif
+}
+
+AMI_INLINE void ami_setUint64ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p)
+{
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    tAmiUnalignedUint64*        pAddr = (tAmiUnalignedUint64*)pAddr_p;
+    const tAmiUnalignedUint64*  pVal = (const tAmiUnalignedUint64*)pVal_p;
+    UINT                        i;
+
+    for (i = 0; i < count_p; i++)
+        pAddr[i] = AMI_SWAP_LE64(pVal[i]);
+#else
+    __builtin_memcpy(pAddr_p, pVal_p, count_p * 8);
+#endif
+}
+
+AMI_INLINE void ami_getUint64ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p)
+{
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    const tAmiUnalignedUint64*  pAddr = (const tAmiUnalignedUint64*)pAddr_p;
+    tAmiUnalignedUint64*        pVal = (tAmiUnalignedUint64*)pVal_p;
+    UINT                        i;
+
+    for (i = 0; i < count_p; i++)
+        pVal[i] = AMI_SWAP_LE64(pAddr[i]);
+#else
+    __builtin_memcpy(pVal_p, pAddr_p, count_p * 8);
+#endif
+}
+
+#endif /* AMI_USE_INLINE */
+
 #endif /* _INC_common_ami_H_ */
@@ -45,6 +45,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #define NR_OF_CIRC_BUFFERS              20
 #define CIRCBUF_BLOCK_ALIGNMENT         4
+#define CIRCBUF_READ_MULTIPLE_ALIGNMENT 8       // Alignment of the blocks read by circbuf_readMultiple()
 
 #undef  DEBUG_CIRCBUF_SIZE_CHECK                // Add debug code for retrieving maximum used buffer size
 
@@ -74,6 +75,26 @@ Data type for the enumerator \ref eCircBufError.
 */
 typedef UINT32 tCircBufError;
 
+/**
+*  \brief Access modes of the circular buffer library
+*
+*  The enumeration defines the access modes of a circular buffer. The mode is
+*  selected when the buffer is allocated and applies to all connected instances.
+*  The SPSC mode requires the buffer to be located in cache-coherent memory.
+*/
+typedef enum
+{
+    kCircBufModeLocked                  =  0,   ///< Any number of writers and readers, accesses are locked
+    kCircBufModeSpsc                    =  1    ///< Single writer and single reader, accesses are lock-free
+} eCircBufMode;
+
+/**
+\brief Circular buffer access mode data type
+
+Data type for the enumerator \ref eCircBufMode.
+*/
+typedef UINT32 tCircBufMode;
+
 /**
 *  \brief Header for circular buffer
 *
@@ -88,11 +109,30 @@ typedef struct
     UINT32              readOffset;         ///< The read offset
     UINT32              freeSize;           ///< Available space in buffer
     UINT32              dataCount;          ///< The entry count
+    UINT32              mode;               ///< The access mode (\ref eCircBufMode)
+    UINT32              writeCount;         ///< Number of written bytes in SPSC mode (modified by the writer only)
+    UINT32              readCount;          ///< Number of read bytes in SPSC mode (modified by the reader only)
+    UINT32              writeBlockCount;    ///< Number of written blocks in SPSC mode (modified by the writer only)
+    UINT32              readBlockCount;     ///< Number of read blocks in SPSC mode (modified by the reader only)
 #ifdef DEBUG_CIRCBUF_SIZE_CHECK
     UINT32              maxSize;            ///< Maximum used space in circular buffer
 #endif
 } tCircBufHeader;
 
+/**
+*  \brief Data block descriptor for writing multiple blocks
+*
+*  The struct describes a data block written by circbuf_writeMultiple(). A
+*  block can be composed of two source data parts.
+*/
+typedef struct
+{
+    const void*         pData;              ///< Pointer to the first part of the block
+    size_t              size;               ///< Size of the first part of the block
+    const void*         pData2;             ///< Pointer to the second part of the block (may be NULL)
+    size_t              size2;              ///< Size of the second part of the block
+} tCircBufWriteBlock;
+
 /**
 *  \brief Circular buffer instance
 *
@@ -105,6 +145,7 @@ typedef struct
     void*               pCircBuf;                   ///< Pointer to the circular buffer
     void*               pCircBufArchInstance;       ///< Pointer to architecture specific stuff
     UINT8               bufferId;                   ///< The id of the circular buffer
+    BOOL                fSpsc;                      ///< The buffer is accessed in SPSC mode
     VOIDFUNCPTR         pfnSigCb;                   ///< Pointer to the signaling callback function
 } tCircBufInstance;
 
@@ -116,7 +157,8 @@ extern "C"
 {
 #endif
 
-tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufInstance** ppInstance_p);
+tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufMode mode_p,
+                            tCircBufInstance** ppInstance_p);
 tCircBufError circbuf_free(tCircBufInstance* pInstance_p);
 tCircBufError circbuf_connect(UINT8 id_p, tCircBufInstance** ppInstance_p);
 tCircBufError circbuf_disconnect(tCircBufInstance* pInstance_p);
@@ -129,6 +171,10 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p, const voi
 tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
                                size_t size_p, size_t* pDataBlockSize_p)
                                SECTION_CIRCBUF_READ_DATA;
+tCircBufError circbuf_writeMultiple(tCircBufInstance* pInstance_p, const tCircBufWriteBlock* aBlocks_p,
+                                    UINT blockCount_p, UINT* pWrittenCount_p);
+tCircBufError circbuf_readMultiple(tCircBufInstance* pInstance_p, void* pData_p, size_t size_p,
+                                   size_t* aBlockSize_p, UINT maxBlockCount_p, UINT* pReadCount_p);
 UINT32        circbuf_getDataCount(const tCircBufInstance* pInstance_p);
 tCircBufError circBuf_setSignaling(tCircBufInstance* pInstance_p, VOIDFUNCPTR pfnSigCb_p);
 
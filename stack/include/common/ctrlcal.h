@@ -49,6 +49,21 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+/**
+\brief Control CAL signals
+
+This enumeration lists the signals which can be exchanged between the user and
+the kernel layer through the control CAL.
+*/
+typedef enum
+{
+    kCtrlCalSignalCmd       = 0,            ///< A command was written by the user layer
+    kCtrlCalSignalReturn,                   ///< A return value was written by the kernel layer
+    kCtrlCalSignalCount                     ///< Number of signals
+} eCtrlCalSignal;
+
+/// Data type for the enumerator \ref eCtrlCalSignal.
+typedef UINT32 tCtrlCalSignal;
 
 //------------------------------------------------------------------------------
 // function prototypes
@@ -66,6 +81,11 @@ void       ctrlcal_writeData(UINT offset_p,
 tOplkError ctrlcal_readData(void* pDest_p,
                             UINT offset_p,
                             size_t length_p);
+UINT32     ctrlcal_getSignalCount(tCtrlCalSignal signal_p);
+void       ctrlcal_sendSignal(tCtrlCalSignal signal_p);
+BOOL       ctrlcal_waitSignal(tCtrlCalSignal signal_p,
+                              UINT32 signalCount_p,
+                              UINT32 timeoutMs_p);
 
 #ifdef __cplusplus
 }
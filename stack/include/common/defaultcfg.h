@@ -262,4 +262,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_PDO_SETUP_WAIT_TIME                      500
 #endif
 
+#ifndef CONFIG_PDO_CACHE_LINE_SIZE
+#define CONFIG_PDO_CACHE_LINE_SIZE                      0                   // alignment of the PDO channel buffers (0 = packed)
+#endif
+
+#ifndef CONFIG_LATENCY_HISTOGRAM
+#define CONFIG_LATENCY_HISTOGRAM                        FALSE               // record latency histograms of the isochronous hot path
+#endif
+
+#ifndef CONFIG_AMI_INLINE
+#define CONFIG_AMI_INLINE                               TRUE                // use the header-inline AMI with GCC compatible compilers
+#endif
+
 #endif /* _INC_common_defaultcfg_H_ */
@@ -50,6 +50,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define PDO_PREQ_NODE_ID                0x00    // NodeId for PReq RPDO
 #define PDO_PRES_NODE_ID                0x00    // NodeId for PRes TPDO
 
+#if (CONFIG_PDO_CACHE_LINE_SIZE > 0)
+#define PDO_CHANNEL_ALIGN(size)         (((size) + (CONFIG_PDO_CACHE_LINE_SIZE - 1)) & \
+                                         ~(CONFIG_PDO_CACHE_LINE_SIZE - 1))
+#else
+#define PDO_CHANNEL_ALIGN(size)         (size)
+#endif
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -117,6 +124,10 @@ typedef struct
 This structure specifies a PDO channel buffer. Each PDO channel has got an
 offset in the buffers, and specifies the currently used buffer for consuming
 data, producing data and a clean buffer.
+
+If \ref CONFIG_PDO_CACHE_LINE_SIZE is set, the structure is padded to a full
+cache line, so that the buffer information of adjacent channels does not share
+a cache line.
 */
 typedef struct
 {
@@ -125,6 +136,10 @@ typedef struct
     OPLK_ATOMIC_T       writeBuf;               ///< Current buffer to produce data to
     OPLK_ATOMIC_T       cleanBuf;               ///< Current clean (i.e. unused) buffer
     UINT8               newData;                ///< Flag indicating whether new data has been produced
+#if (CONFIG_PDO_CACHE_LINE_SIZE > 0)
+    UINT8               aPadding[CONFIG_PDO_CACHE_LINE_SIZE -
+                                 sizeof(UINT32) - (3 * sizeof(OPLK_ATOMIC_T)) - sizeof(UINT8)];    ///< Padding to a full cache line
+#endif
 } tPdoBufferInfo;
 
 /**
@@ -137,6 +152,9 @@ typedef struct
 {
     UINT16              valid;                                      ///< Defines whether the memory region is valid
     UINT32              pdoMemSize;                                 ///< Size of the overall PDO memory
+#if (CONFIG_PDO_CACHE_LINE_SIZE > 0)
+    UINT8               aPadding[CONFIG_PDO_CACHE_LINE_SIZE - (2 * sizeof(UINT32))];   ///< Padding to align the channel arrays to a cache line
+#endif
     tPdoBufferInfo      rxChannelInfo[D_PDO_RPDOChannels_U16];      ///< Array of RPDO channels
     tPdoBufferInfo      txChannelInfo[D_PDO_TPDOChannels_U16];      ///< Array of TPDO channels
     OPLK_LOCK_T         lock;                                       ///< Locking variable
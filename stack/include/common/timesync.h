@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 #define TIMESYNC_SYNC_BSDSEM            "/semTimeSyncSync"
+#define TIMESYNC_SYNC_SHM               "/shmTimeSyncSync"
 
 //------------------------------------------------------------------------------
 // typedef
@@ -79,6 +80,25 @@ typedef struct
     tTimesyncSocTime        aTripleBuf[3];  ///< Triple buffer
 } tTimesyncSocTimeTripleBuf;
 
+/**
+\brief  Sync event memory
+
+This structure defines the memory which is shared between the kernel and user
+layer to signal sync events with a sequence number. For every sync event the
+kernel layer stores the SoC time of the cycle in the buffer selected by the
+next sequence number, increments the sequence number and wakes up the user
+layer threads sleeping on it. The user layer compares the sequence number with
+the last one it has processed, so it always continues with the latest sync
+event and detects missed ones. A SoC time buffer is consistent if the sequence
+number didn't change while the buffer was read.
+*/
+typedef struct
+{
+    UINT32                  syncSeq;        ///< Sequence number of the latest sync event
+    UINT32                  waiterCount;    ///< Number of user threads sleeping on the sequence number
+    tTimesyncSocTime        aSocTime[2];    ///< SoC time buffers (selected by the sequence number)
+} tTimesyncSyncMemory;
+
 /**
 \brief  Timesync shared memory
 
@@ -53,6 +53,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+/**
+\brief Kernel event CAL statistics
+
+The structure contains the statistics of the kernel event handler thread. It is
+provided by event CAL implementations using an event handler thread.
+*/
+typedef struct
+{
+    UINT32              wakeupCount;                ///< Number of event thread wakeups
+    UINT32              eventCount;                 ///< Number of processed events
+    UINT32              maxEventsPerWakeup;         ///< Maximum number of events processed in a single wakeup
+    UINT32              maxQueueDepthKInt;          ///< Maximum number of pending events in the kernel internal queue
+    UINT32              maxQueueDepthU2K;           ///< Maximum number of pending events in the user-to-kernel queue
+} tEventkCalStatistics;
 
 //------------------------------------------------------------------------------
 // function prototypes
@@ -76,6 +90,9 @@ int        eventkcal_getEventForUser(ULONG arg);
 // TODO: Check if they can be revised to merge with Linux APIs
 void       eventkcal_postEventFromUser(const void* pEvent_p);
 void       eventkcal_getEventForUser(void* pEvent_p, size_t* pSize_p);
+#elif (TARGET_SYSTEM == _LINUX_)
+/* functions used in eventkcal-linux.c */
+void       eventkcal_getStatistics(tEventkCalStatistics* pStatistics_p);
 #endif
 
 #ifdef __cplusplus
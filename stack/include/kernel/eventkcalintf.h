@@ -47,6 +47,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// Maximum number of events processed with a single queue access
+#define EVENTKCAL_MAX_BATCH_EVENTS      32
 
 //------------------------------------------------------------------------------
 // typedef
@@ -64,7 +66,7 @@ extern "C"
 tOplkError eventkcal_initQueueCircbuf(tEventQueue eventQueue_p);
 tOplkError eventkcal_exitQueueCircbuf(tEventQueue eventQueue_p);
 tOplkError eventkcal_postEventCircbuf(tEventQueue eventQueue_p, const tEvent* pEvent_p) SECTION_EVENTKCAL_CIRCBUF_POST;
-tOplkError eventkcal_processEventCircbuf(tEventQueue eventQueue_p);
+tOplkError eventkcal_processEventCircbuf(tEventQueue eventQueue_p, UINT maxEventCount_p, UINT* pEventCount_p);
 tOplkError eventkcal_getEventCircbuf(tEventQueue eventQueue_p, UINT8* pDataBuffer_p, size_t* pReadSize_p);
 UINT       eventkcal_getEventCountCircbuf(tEventQueue eventQueue_p);
 tOplkError eventkcal_setSignalingCircbuf(tEventQueue eventQueue_p, VOIDFUNCPTR pfnSignalCb_p);
@@ -0,0 +1,108 @@
+/**
+********************************************************************************
+\file   kernel/latencyk.h
+
+\brief  Definitions for kernel latency histogram module
+
+This file contains definitions and declarations of the kernel latency
+histogram module.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_kernel_latencyk_H_
+#define _INC_kernel_latencyk_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define LATENCYK_HISTOGRAM_BUCKETS      32      // Bucket n counts latencies in [2^n, 2^(n+1)) ns
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief Latency probes
+
+This enumeration lists the measuring points of the isochronous hot path.
+*/
+typedef enum
+{
+    kLatencyProbeSocToPres = 0,     ///< SoC received/sent until a PRes frame is processed
+    kLatencyProbeRxToPdo,           ///< PRes/PReq frame received until the RPDO is copied
+    kLatencyProbeTpdoToTx,          ///< First TPDO of a cycle copied until the cycle Tx list is started
+    kLatencyProbeHresTimerWakeup,   ///< Planned wakeup of the hybrid hres timer thread until it runs (sleep overshoot)
+    kLatencyProbeHresTimerLateness, ///< Hybrid hres timer deadline until the timer callback is called
+    kLatencyProbeCount              ///< Number of probes
+} eLatencyProbe;
+
+/// Data type for the enumerator \ref eLatencyProbe.
+typedef UINT32 tLatencyProbe;
+
+/**
+\brief Latency histogram
+
+This structure contains the latency histogram of a single probe.
+All times are in nanoseconds.
+*/
+typedef struct
+{
+    UINT32      count;                                  ///< Number of recorded samples
+    UINT32      minLatency;                             ///< Minimum latency
+    UINT32      maxLatency;                             ///< Maximum latency
+    ULONGLONG   sumLatency;                             ///< Sum of all latencies (for the mean value)
+    UINT32      aBucket[LATENCYK_HISTOGRAM_BUCKETS];    ///< Logarithmic histogram buckets
+} tLatencyHistogram;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError latencyk_init(void);
+void       latencyk_exit(void);
+UINT32     latencyk_getTimestamp(void);
+void       latencyk_start(tLatencyProbe probe_p, UINT32 timeStamp_p);
+UINT32     latencyk_getStartTimestamp(tLatencyProbe probe_p);
+void       latencyk_stop(tLatencyProbe probe_p, BOOL fFinish_p);
+void       latencyk_record(tLatencyProbe probe_p, UINT32 latency_p);
+tOplkError latencyk_getHistogram(tLatencyProbe probe_p, tLatencyHistogram* pHistogram_p);
+void       latencyk_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_kernel_latencyk_H_ */
@@ -55,14 +55,32 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // typedef
 //------------------------------------------------------------------------------
 
+/**
+\brief PDO lookup table channel descriptor
+
+The following structure describes a PDO channel within a lookup table entry.
+It holds a copy of the channel parameters needed for processing a frame, so
+that the PDO channel table does not need to be accessed in the fast path.
+*/
+typedef struct
+{
+    UINT16              offset;                                         ///< Offset of the channel payload in the frame
+    UINT16              size;                                           ///< Size of the channel payload
+    UINT16              nextChannelOffset;                              ///< Offset of the following PDO channel
+    UINT8               mappingVersion;                                 ///< Expected mapping version of the channel
+    UINT8               channelId;                                      ///< ID of the PDO channel
+} tPdoklutChannel;
+
 /**
 \brief PDO lookup table entry
 
-The following structure defines a PDO lookup table entry.
+The following structure defines a PDO lookup table entry. It contains the
+descriptors of all PDO channels of a node in the order of their configuration.
 */
 typedef struct
 {
-    UINT8               channelId[PDOKLUT_MAX_CHANNELS_PER_NODE];       ///< Array to store PDO channel IDs for the node.
+    UINT8               channelCount;                                   ///< Number of valid channel descriptors
+    tPdoklutChannel     aChannel[PDOKLUT_MAX_CHANNELS_PER_NODE];        ///< Channel descriptors of the node
 } tPdoklutEntry;
 
 
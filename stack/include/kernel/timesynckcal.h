@@ -61,6 +61,7 @@ tOplkError timesynckcal_init(void);
 void       timesynckcal_exit(void);
 tOplkError timesynckcal_controlSync(BOOL fEnable_p);
 tOplkError timesynckcal_sendSyncEvent(void);
+tOplkError timesynckcal_setSocTime(const tTimesyncSocTime* pSocTime_p);
 
 #if (((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__)) || \
      ((TARGET_SYSTEM == _WIN32_) && defined(_KERNEL_MODE)))
@@ -514,6 +514,18 @@ typedef struct
     BOOL            fValidRelTime;                  ///< TRUE if relative time is validated
 } tOplkApiSocTimeInfo;
 
+/**
+\brief  Sync event information structure
+
+This structure provides the information about a sync event to the API.
+*/
+typedef struct
+{
+    UINT32              syncSeq;                    ///< Sequence number of the sync event
+    UINT32              missedCount;                ///< Number of sync events missed since the last call
+    tOplkApiSocTimeInfo socTime;                    ///< SoC time of the cycle of the sync event
+} tOplkApiSyncEventInfo;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -601,6 +613,8 @@ OPLKDLLEXPORT tOplkError oplk_getIdentResponse(UINT nodeId_p,
 OPLKDLLEXPORT tOplkError oplk_getEthMacAddr(UINT8* pMacAddr_p);
 OPLKDLLEXPORT BOOL oplk_checkKernelStack(void);
 OPLKDLLEXPORT tOplkError oplk_waitSyncEvent(ULONG timeout_p);
+OPLKDLLEXPORT tOplkError oplk_waitSyncEventInfo(ULONG timeout_p,
+                                                tOplkApiSyncEventInfo* pSyncInfo_p);
 OPLKDLLEXPORT UINT32 oplk_getVersion(void);
 OPLKDLLEXPORT const char* oplk_getVersionString(void);
 OPLKDLLEXPORT UINT32 oplk_getStackConfiguration(void);
@@ -623,6 +637,10 @@ OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageIn(void);
 OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageOut(void);
 OPLKDLLEXPORT void* oplk_getProcessImageIn(void);
 OPLKDLLEXPORT void* oplk_getProcessImageOut(void);
+OPLKDLLEXPORT tOplkError oplk_acquireProcessImageOut(const void** ppImage_p);
+OPLKDLLEXPORT tOplkError oplk_releaseProcessImageOut(void);
+OPLKDLLEXPORT tOplkError oplk_acquireProcessImageIn(void** ppImage_p);
+OPLKDLLEXPORT tOplkError oplk_releaseProcessImageIn(void);
 
 // objdict specific process image functions
 OPLKDLLEXPORT OPLK_DEPRECATED tOplkError oplk_setupProcessImage(void);
@@ -53,6 +53,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+/**
+\brief User event CAL statistics
+
+The structure contains the statistics of the user event handler thread. It is
+provided by event CAL implementations using an event handler thread.
+*/
+typedef struct
+{
+    UINT32              wakeupCount;                ///< Number of event thread wakeups
+    UINT32              eventCount;                 ///< Number of processed events
+    UINT32              maxEventsPerWakeup;         ///< Maximum number of events processed in a single wakeup
+    UINT32              maxQueueDepthK2U;           ///< Maximum number of pending events in the kernel-to-user queue
+    UINT32              maxQueueDepthUInt;          ///< Maximum number of pending events in the user internal queue
+} tEventuCalStatistics;
 
 //------------------------------------------------------------------------------
 // function prototypes
@@ -68,6 +82,11 @@ tOplkError eventucal_postKernelEvent(const tEvent* pEvent_p);
 tOplkError eventucal_postUserEvent(const tEvent* pEvent_p);
 void       eventucal_process(void);
 
+#if (TARGET_SYSTEM == _LINUX_)
+/* functions used in eventucal-linux.c */
+void       eventucal_getStatistics(tEventuCalStatistics* pStatistics_p);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
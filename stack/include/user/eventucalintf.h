@@ -48,6 +48,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// Maximum number of events processed with a single queue access
+#define EVENTUCAL_MAX_BATCH_EVENTS      32
 
 //------------------------------------------------------------------------------
 // typedef
@@ -65,7 +67,7 @@ extern "C"
 tOplkError eventucal_initQueueCircbuf(tEventQueue eventQueue_p);
 tOplkError eventucal_exitQueueCircbuf(tEventQueue eventQueue_p);
 tOplkError eventucal_postEventCircbuf(tEventQueue eventQueue_p, const tEvent* pEvent_p);
-tOplkError eventucal_processEventCircbuf(tEventQueue eventQueue_p);
+tOplkError eventucal_processEventCircbuf(tEventQueue eventQueue_p, UINT maxEventCount_p, UINT* pEventCount_p);
 UINT       eventucal_getEventCountCircbuf(tEventQueue eventQueue_p);
 tOplkError eventucal_setSignalingCircbuf(tEventQueue eventQueue_p, VOIDFUNCPTR pfnSignalCb_p);
 
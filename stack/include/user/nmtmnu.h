@@ -73,6 +73,54 @@ typedef struct
     UINT32   prcPResTimeFirstCorrectionNs;      ///< First correction time of a PRes in PRC mode (in ns)
     UINT32   prcPResTimeFirstNegOffsetNs;       ///< First negative offset of a PRes in PRC mode (in ns)
 } tNmtMnuConfigParam;
+
+/**
+* \brief Boot phases
+*
+* This enumeration lists the phases of the MN boot-up which are timed in the
+* boot report. The first phases are timed per CN, the remaining ones cover the
+* whole network.
+*/
+typedef enum
+{
+    kNmtMnuBootPhaseIdentify = 0,       ///< CN: BootStep1 started until the IdentResponse is received
+    kNmtMnuBootPhaseConfig,             ///< CN: Software check and configuration (e.g. ConciseDCF download)
+    kNmtMnuBootPhaseBootStep1,          ///< Network: MN in PreOperational1 until the boot event BootStep1Finish
+    kNmtMnuBootPhaseBootStep2,          ///< Network: MN in PreOperational2
+    kNmtMnuBootPhaseCheckCom,           ///< Network: MN in ReadyToOperate (CheckCommunication)
+    kNmtMnuBootPhaseStartNodes,         ///< Network: MN in Operational until all CNs are started
+    kNmtMnuBootPhaseCount               ///< Number of boot phases
+} eNmtMnuBootPhase;
+
+/// Data type for the enumerator \ref eNmtMnuBootPhase.
+typedef UINT32 tNmtMnuBootPhase;
+
+/**
+* \brief Boot phase timing
+*
+* This structure contains the timing of a single boot phase. All times are in
+* milliseconds. The node statistics are only used for the per-CN phases.
+*/
+typedef struct
+{
+    UINT32      startTime;                  ///< Tick count when the phase was entered first
+    UINT32      endTime;                    ///< Tick count when the phase was left last
+    UINT        enterCount;                 ///< Number of times the phase was entered
+    UINT        nodeCount;                  ///< Number of CNs which completed the phase
+    UINT32      maxNodeTime;                ///< Maximum time a single CN spent in the phase
+    UINT32      sumNodeTime;                ///< Sum of the times all CNs spent in the phase
+} tNmtMnuBootPhaseTime;
+
+/**
+* \brief Boot report
+*
+* This structure contains the timing report of the last MN boot-up.
+*/
+typedef struct
+{
+    tNmtMnuBootPhaseTime    aPhase[kNmtMnuBootPhaseCount];  ///< Timing of the boot phases
+    UINT                    peakParallelConfig;             ///< Max. number of CNs which were configured concurrently
+} tNmtMnuBootReport;
 #endif
 
 //------------------------------------------------------------------------------
@@ -105,6 +153,7 @@ tOplkError nmtmnu_getDiagnosticInfo(UINT* pMandatorySlaveCount_p,
                                     UINT* pSignalSlaveCount_p,
                                     UINT16* pflags_p);
 tOplkError nmtmnu_configPrc(const tNmtMnuConfigParam* pConfigParam_p);
+tOplkError nmtmnu_getBootReport(tNmtMnuBootReport* pBootReport_p);
 #endif
 
 #ifdef __cplusplus
@@ -90,6 +90,13 @@ tOplkError pdou_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p);
 tOplkError pdou_copyRxPdoToPi(void);
 tOplkError pdou_copyTxPdoFromPi(void);
 tOplkError pdou_registerEventPdoChangeCb(tPdoCbEventPdoChange pfnCbEventPdoChange_p);
+tOplkError pdou_setDirectProcessImage(BOOL fTx_p,
+                                      void* pImage_p,
+                                      size_t imageSize_p);
+tOplkError pdou_acquireRxPdoBuffer(const void** ppPdo_p);
+tOplkError pdou_releaseRxPdoBuffer(void);
+tOplkError pdou_acquireTxPdoBuffer(void** ppPdo_p);
+tOplkError pdou_releaseTxPdoBuffer(void);
 
 #ifdef __cplusplus
 }
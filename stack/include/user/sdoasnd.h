@@ -47,6 +47,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#ifndef CONFIG_SDO_MAX_CONNECTION_ASND
+#define CONFIG_SDO_MAX_CONNECTION_ASND     5
+#endif
 
 //------------------------------------------------------------------------------
 // typedef
@@ -243,6 +243,20 @@ typedef struct
     UINT8               targetSubIndex;      ///< Object subindex to access
 } tSdoComCon;
 
+/**
+\brief  SDO command layer connection link
+
+This structure links the command layer connections which use the same sequence
+layer connection. It is kept apart from \ref tSdoComCon, so that clearing a
+connection doesn't break the chain.
+*/
+typedef struct
+{
+    tSdoComConHdl       nextCon;        ///< Next connection in the chain (CONFIG_SDO_MAX_CONNECTION_COM = end)
+    UINT                seqConIndex;    ///< Sequence layer connection index of the chain (CONFIG_SDO_MAX_CONNECTION_SEQ = not linked)
+    BOOL                fInUse;         ///< Connection is allocated
+} tSdoComConLink;
+
 /**
 \brief  SDO command layer instance structure
 
@@ -250,7 +264,11 @@ This structure describes a SDO command layer instance
 */
 typedef struct
 {
-    tSdoComCon          sdoComCon[CONFIG_SDO_MAX_CONNECTION_COM];   ///< Array to store command layer connections
+    tSdoComCon*         paSdoComCon;                                ///< Array to store command layer connections, allocated at init
+    tSdoComConLink*     paConLink;                                  ///< Array of connection links, allocated at init
+    tSdoComConHdl*      paFreeCon;                                  ///< Stack of free connection handles, allocated at init
+    UINT                freeConCount;                               ///< Number of entries on the free connection stack
+    tSdoComConHdl*      paFirstConBySeq;                            ///< First connection per sequence layer connection, allocated at init
 #if defined(CONFIG_INCLUDE_SDOS)
     tSdoComConHdl       sdoObdConCounter;                           ///< OD connection handle counter for object accesses
     tComdLayerObdCb     pfnProcessObdWrite;                         ///< OD callback function for WriteByIndex processing
@@ -297,4 +315,7 @@ void       sdocomint_fillCmdFrameDataSegm(tAsySdoCom* pCommandFrame_p,
 void       sdocomint_updateHdlTransfSize(tSdoComCon* pSdoComCon_p,
                                          size_t tranferredBytes_p,
                                          BOOL fTransferComplete);
+tSdoComConHdl sdocomint_allocCon(void);
+void       sdocomint_freeCon(tSdoComCon* pSdoComCon_p);
+void       sdocomint_updateSeqConLink(tSdoComConHdl sdoComConHdl_p);
 #endif /* _INC_user_sdocomint_H_ */
@@ -54,6 +54,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SDO_SEQ_HANDLE_MASK         0xC000
 #define SDO_SEQ_INVALID_HDL         0x3FFF
 
+#ifndef CONFIG_SDO_MAX_CONNECTION_SEQ
+#define CONFIG_SDO_MAX_CONNECTION_SEQ   5
+#endif
+
+#ifndef CONFIG_SDO_SEQ_HISTORY_SIZE
+#define CONFIG_SDO_SEQ_HISTORY_SIZE     5       // default send window of a connection
+#endif
+
+#ifndef CONFIG_SDO_SEQ_HISTORY_POOL_SIZE
+#define CONFIG_SDO_SEQ_HISTORY_POOL_SIZE    (CONFIG_SDO_MAX_CONNECTION_SEQ * CONFIG_SDO_SEQ_HISTORY_SIZE)
+#endif
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -116,6 +128,7 @@ tOplkError sdoseq_sendData(tSdoSeqConHdl sdoSeqConHdl_p,
 tOplkError sdoseq_processEvent(const tEvent* pEvent_p);
 tOplkError sdoseq_deleteCon(tSdoSeqConHdl sdoSeqConHdl_p);
 tOplkError sdoseq_setTimeout(UINT32 timeout_p);
+tOplkError sdoseq_setWindowSize(UINT windowSize_p);
 
 #ifdef __cplusplus
 }
@@ -53,6 +53,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define SDOUDP_INADDR_ANY               0
 
+#ifndef CONFIG_SDO_MAX_CONNECTION_UDP
+#define CONFIG_SDO_MAX_CONNECTION_UDP   5
+#endif
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
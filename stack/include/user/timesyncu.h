@@ -59,6 +59,8 @@ extern "C"
 
 tOplkError timesyncu_init(tSyncCb pfnSyncCb_p);
 void       timesyncu_exit(void);
+tOplkError timesyncu_waitSyncEvent(ULONG timeout_p,
+                                   tOplkApiSyncEventInfo* pSyncInfo_p);
 tOplkError timesyncu_getSocTime(tOplkApiSocTimeInfo* pSocTime_p);
 
 #ifdef __cplusplus
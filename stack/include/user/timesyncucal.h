@@ -48,6 +48,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+/**
+\brief  Sync event information
+
+This structure contains the information about a received sync event. The user
+timesync module initializes it with the sequence number following the last
+received sync event, no missed sync events and an invalid SoC time. CAL
+implementations which signal sync events with a sequence number overwrite it.
+*/
+typedef struct
+{
+    UINT32                  syncSeq;        ///< Sequence number of the sync event
+    UINT32                  missedCount;    ///< Number of sync events missed since the last received one
+    tTimesyncSocTime        socTime;        ///< SoC time of the cycle of the sync event
+} tTimesyncSyncEvent;
 
 //------------------------------------------------------------------------------
 // function prototypes
@@ -59,7 +73,8 @@ extern "C"
 
 tOplkError timesyncucal_init(tSyncCb pfnSyncCb_p);
 void       timesyncucal_exit(void);
-tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p);
+tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p,
+                                      tTimesyncSyncEvent* pSyncEvent_p);
 tOplkError timesyncucal_callSyncCb(void);
 
 tTimesyncSharedMemory* timesyncucal_getSharedMemory(void);
@@ -112,9 +112,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // time when CN processing the isochronous task (sync callback of application and cycle preparation)
 #define CONFIG_DLL_PROCESS_SYNC                     DLL_PROCESS_SYNC_ON_SOC
 
-// Disable deferred release of rx-buffers until EdrvPcap supports it
+// Pass received ASnd frames by reference to the user layer, the Edrv Rx buffer
+// pool buffer is released after the frame has been processed
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC    FALSE
-#define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC   FALSE
+#define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC   TRUE
 
 //==============================================================================
 // OBD specific defines
@@ -135,6 +136,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_OBD_CALC_OD_SIGNATURE                TRUE
 #endif
 
+//==============================================================================
+// PDO module specific defines
+//==============================================================================
+
+// Align the buffer information and the payload of each PDO channel to cache
+// lines of this size (0 = packed). The user and kernel layer must use the same value!
+#ifndef CONFIG_PDO_CACHE_LINE_SIZE
+#define CONFIG_PDO_CACHE_LINE_SIZE                  64
+#endif
+
 //==============================================================================
 // Timer module specific defines
 //==============================================================================
@@ -107,6 +107,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC    FALSE
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC   FALSE
 
+//==============================================================================
+// PDO module specific defines
+//==============================================================================
+
+// Align the buffer information and the payload of each PDO channel to cache
+// lines of this size (0 = packed). The user and kernel layer must use the same value!
+#ifndef CONFIG_PDO_CACHE_LINE_SIZE
+#define CONFIG_PDO_CACHE_LINE_SIZE                  64
+#endif
+
 //==============================================================================
 // Timer module specific defines
 //==============================================================================
@@ -68,6 +68,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_INCLUDE_LEDK
 
 #define CONFIG_DLLCAL_QUEUE                         CIRCBUF_QUEUE
+// Request queues sized for the maximum number of CNs
+#define CONFIG_DLLCAL_SIZE_CIRCBUF_REQ_IDENT        8192
+#define CONFIG_DLLCAL_SIZE_CIRCBUF_REQ_STATUS       8192
 
 #define CONFIG_VETH_SET_DEFAULT_GATEWAY             FALSE
 
@@ -144,9 +147,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //==============================================================================
 
 // increase the number of SDO channels, because we are master
-#define CONFIG_SDO_MAX_CONNECTION_ASND              100
-#define CONFIG_SDO_MAX_CONNECTION_SEQ               100
-#define CONFIG_SDO_MAX_CONNECTION_COM               100
+// (one channel per node ID, the connection tables are allocated at init)
+#define CONFIG_SDO_MAX_CONNECTION_ASND              254
+#define CONFIG_SDO_MAX_CONNECTION_SEQ               254
+#define CONFIG_SDO_MAX_CONNECTION_COM               254
 #define CONFIG_SDO_MAX_CONNECTION_UDP               50
 
 //==============================================================================
@@ -114,9 +114,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // time when CN processing the isochronous task (sync callback of application and cycle preparation)
 #define CONFIG_DLL_PROCESS_SYNC                     DLL_PROCESS_SYNC_ON_SOC
 
-// Disable deferred release of rx-buffers until EdrvPcap supports it
+// Pass received ASnd frames by reference to the user layer, the Edrv Rx buffer
+// pool buffer is released after the frame has been processed
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC    FALSE
-#define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC   FALSE
+#define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC   TRUE
 
 //==============================================================================
 // OBD specific defines
@@ -139,6 +140,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // openCONFIGURATOR uses this range for mapping objects.
 #define CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART      TRUE
 
+//==============================================================================
+// PDO module specific defines
+//==============================================================================
+
+// Align the buffer information and the payload of each PDO channel to cache
+// lines of this size (0 = packed). The user and kernel layer must use the same value!
+#ifndef CONFIG_PDO_CACHE_LINE_SIZE
+#define CONFIG_PDO_CACHE_LINE_SIZE                  64
+#endif
+
 //==============================================================================
 // Timer module specific defines
 //==============================================================================
@@ -151,9 +162,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //==============================================================================
 
 // increase the number of SDO channels, because we are master
-#define CONFIG_SDO_MAX_CONNECTION_ASND              100
-#define CONFIG_SDO_MAX_CONNECTION_SEQ               100
-#define CONFIG_SDO_MAX_CONNECTION_COM               100
+// (one channel per node ID, the connection tables are allocated at init)
+#define CONFIG_SDO_MAX_CONNECTION_ASND              254
+#define CONFIG_SDO_MAX_CONNECTION_SEQ               254
+#define CONFIG_SDO_MAX_CONNECTION_COM               254
 #define CONFIG_SDO_MAX_CONNECTION_UDP               50
 
 #endif // _INC_oplkcfg_H_
@@ -105,11 +105,10 @@ tOplkError target_init(void)
     sigset_t    mask;
 
     /*
-     * We have to block the real time signals used by the timer modules so
-     * that they are able to wait on them using sigwaitinfo!
+     * We have to block the real time signal used by the high-resolution timer
+     * module so that it is able to wait on it using sigwaitinfo!
      */
     sigemptyset(&mask);
-    sigaddset(&mask, SIGRTMIN);
     sigaddset(&mask, SIGRTMIN + 1);
     pthread_sigmask(SIG_BLOCK, &mask, NULL);
 
@@ -392,8 +391,11 @@ The function returns the current timestamp in nanoseconds.
 //------------------------------------------------------------------------------
 ULONGLONG target_getCurrentTimestamp(void)
 {
-    // Not implemented for this target
-    return 0ULL;
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((ULONGLONG)curTime.tv_sec * 1000000000ULL) + (ULONGLONG)curTime.tv_nsec;
 }
 
 //------------------------------------------------------------------------------
@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // includes
 //------------------------------------------------------------------------------
+#define AMI_OUT_OF_LINE
 #include <common/ami.h>
 
 //============================================================================//
@@ -884,3 +885,177 @@ void ami_getTimeOfDay(const void* pAddr_p, tTimeOfDay* pTimeOfDay_p)
     pTimeOfDay_p->msec = ami_getUint32Le(((const UINT8*)pAddr_p)) & 0x0FFFFFFF;
     pTimeOfDay_p->days = ami_getUint16Le(((const UINT8*)pAddr_p) + 4);
 }
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set array of Uint16 to little endian
+
+Sets an array of 16 bit values to a buffer in little endian
+
+\param[out]     pAddr_p             Pointer to the destination buffer
+\param[in]      pVal_p              Pointer to the source array
+\param[in]      count_p             Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint16ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p)
+{
+    UINT    i;
+    UINT16  val;
+
+    // Check parameter validity
+    ASSERT(pAddr_p != NULL);
+    ASSERT(pVal_p != NULL);
+
+    for (i = 0; i < count_p; i++)
+    {
+        OPLK_MEMCPY(&val, (const UINT8*)pVal_p + (i * 2), 2);
+        ami_setUint16Le((UINT8*)pAddr_p + (i * 2), val);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get array of Uint16 from little endian
+
+Reads an array of 16 bit values from a buffer in little endian
+
+\param[in]      pAddr_p             Pointer to the source buffer
+\param[out]     pVal_p              Pointer to the destination array
+\param[in]      count_p             Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint16ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p)
+{
+    UINT    i;
+    UINT16  val;
+
+    // Check parameter validity
+    ASSERT(pAddr_p != NULL);
+    ASSERT(pVal_p != NULL);
+
+    for (i = 0; i < count_p; i++)
+    {
+        val = ami_getUint16Le((const UINT8*)pAddr_p + (i * 2));
+        OPLK_MEMCPY((UINT8*)pVal_p + (i * 2), &val, 2);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set array of Uint32 to little endian
+
+Sets an array of 32 bit values to a buffer in little endian
+
+\param[out]     pAddr_p             Pointer to the destination buffer
+\param[in]      pVal_p              Pointer to the source array
+\param[in]      count_p             Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint32ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p)
+{
+    UINT    i;
+    UINT32  val;
+
+    // Check parameter validity
+    ASSERT(pAddr_p != NULL);
+    ASSERT(pVal_p != NULL);
+
+    for (i = 0; i < count_p; i++)
+    {
+        OPLK_MEMCPY(&val, (const UINT8*)pVal_p + (i * 4), 4);
+        ami_setUint32Le((UINT8*)pAddr_p + (i * 4), val);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get array of Uint32 from little endian
+
+Reads an array of 32 bit values from a buffer in little endian
+
+\param[in]      pAddr_p             Pointer to the source buffer
+\param[out]     pVal_p              Pointer to the destination array
+\param[in]      count_p             Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint32ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p)
+{
+    UINT    i;
+    UINT32  val;
+
+    // Check parameter validity
+    ASSERT(pAddr_p != NULL);
+    ASSERT(pVal_p != NULL);
+
+    for (i = 0; i < count_p; i++)
+    {
+        val = ami_getUint32Le((const UINT8*)pAddr_p + (i * 4));
+        OPLK_MEMCPY((UINT8*)pVal_p + (i * 4), &val, 4);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set array of Uint64 to little endian
+
+Sets an array of 64 bit values to a buffer in little endian
+
+\param[out]     pAddr_p             Pointer to the destination buffer
+\param[in]      pVal_p              Pointer to the source array
+\param[in]      count_p             Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_setUint64ArrayLe(void* pAddr_p, const void* pVal_p, UINT count_p)
+{
+    UINT    i;
+    UINT64  val;
+
+    // Check parameter validity
+    ASSERT(pAddr_p != NULL);
+    ASSERT(pVal_p != NULL);
+
+    for (i = 0; i < count_p; i++)
+    {
+        OPLK_MEMCPY(&val, (const UINT8*)pVal_p + (i * 8), 8);
+        ami_setUint64Le((UINT8*)pAddr_p + (i * 8), val);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get array of Uint64 from little endian
+
+Reads an array of 64 bit values from a buffer in little endian
+
+\param[in]      pAddr_p             Pointer to the source buffer
+\param[out]     pVal_p              Pointer to the destination array
+\param[in]      count_p             Number of values to convert
+
+\ingroup module_ami
+*/
+//------------------------------------------------------------------------------
+void ami_getUint64ArrayLe(const void* pAddr_p, void* pVal_p, UINT count_p)
+{
+    UINT    i;
+    UINT64  val;
+
+    // Check parameter validity
+    ASSERT(pAddr_p != NULL);
+    ASSERT(pVal_p != NULL);
+
+    for (i = 0; i < count_p; i++)
+    {
+        val = ami_getUint64Le((const UINT8*)pAddr_p + (i * 8));
+        OPLK_MEMCPY((UINT8*)pVal_p + (i * 8), &val, 8);
+    }
+}
@@ -61,6 +61,16 @@ calling circbuf_connect(). The same applies for deinitialization.
 After all connected instances are disconnected by calling circbuf_disconnect(),
 the main instance can clean up and free the buffer by calling circbuf_free().
 
+If a buffer is accessed by exactly one writer and one reader, it can be
+allocated in the single producer/single consumer mode (\ref kCircBufModeSpsc).
+In this mode the writer and the reader only modify their own offsets and
+counters in the buffer header, therefore no lock is needed for reading and
+writing data.
+
+Consumers and producers that handle many small blocks can use
+circbuf_readMultiple() and circbuf_writeMultiple() to transfer several blocks
+with a single lock and signaling cycle.
+
 *******************************************************************************/
 
 //------------------------------------------------------------------------------
@@ -92,6 +102,15 @@ the main instance can clean up and free the buffer by calling circbuf_free().
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// Accessors for the header fields shared lock-free in SPSC mode
+#if defined(__GNUC__)
+#define CIRCBUF_LOAD_ACQUIRE(pVar_p)            __atomic_load_n((pVar_p), __ATOMIC_ACQUIRE)
+#define CIRCBUF_STORE_RELEASE(pVar_p, val_p)    __atomic_store_n((pVar_p), (val_p), __ATOMIC_RELEASE)
+#else
+// Volatile accesses provide acquire/release semantics with MSVC on x86/x64
+#define CIRCBUF_LOAD_ACQUIRE(pVar_p)            (*(volatile UINT32*)(pVar_p))
+#define CIRCBUF_STORE_RELEASE(pVar_p, val_p)    (*(volatile UINT32*)(pVar_p) = (val_p))
+#endif
 
 //------------------------------------------------------------------------------
 // local types
@@ -104,6 +123,16 @@ the main instance can clean up and free the buffer by calling circbuf_free().
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tCircBufError writeDataSpsc(tCircBufInstance* pInstance_p,
+                                   const void* pData_p, size_t size_p,
+                                   const void* pData2_p, size_t size2_p,
+                                   BOOL fSignal_p);
+static tCircBufError readDataSpsc(tCircBufInstance* pInstance_p, void* pData_p,
+                                  size_t size_p, size_t* pDataBlockSize_p);
+static UINT32 copyToBuffer(UINT8* pCircBuf_p, UINT32 bufferSize_p, UINT32 offset_p,
+                           const void* pData_p, UINT32 size_p);
+static UINT32 copyFromBuffer(const UINT8* pCircBuf_p, UINT32 bufferSize_p, UINT32 offset_p,
+                             void* pData_p, UINT32 size_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -117,6 +146,10 @@ The function allocates a circular buffer.
 
 \param[in]      id_p                The ID of the buffer to allocate,
 \param[in]      size_p              The size of the buffer to allocate.
+\param[in]      mode_p              The access mode of the buffer. In the
+                                    \ref kCircBufModeSpsc mode the buffer must
+                                    be accessed by a single writer and a single
+                                    reader only.
 \param[out]     ppInstance_p        A pointer to store the pointer to the instance
                                     of the allocated circular buffer.
 
@@ -125,7 +158,10 @@ The function allocates a circular buffer.
 \ingroup module_lib_circbuf
 */
 //------------------------------------------------------------------------------
-tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufInstance** ppInstance_p)
+tCircBufError circbuf_alloc(UINT8 id_p,
+                            size_t size_p,
+                            tCircBufMode mode_p,
+                            tCircBufInstance** ppInstance_p)
 {
     size_t              alignedSize;
     tCircBufInstance*   pInstance;
@@ -134,7 +170,8 @@ tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufInstance** ppInst
     // Check parameter validity
     ASSERT(ppInstance_p != NULL);
 
-    if ((size_p == 0) || (id_p >= NR_OF_CIRC_BUFFERS))
+    if ((size_p == 0) || (id_p >= NR_OF_CIRC_BUFFERS) ||
+        ((mode_p != kCircBufModeLocked) && (mode_p != kCircBufModeSpsc)))
     {
         DEBUG_LVL_ERROR_TRACE("%s() invalid arg!\n", __func__);
         return kCircBufInvalidArg;
@@ -156,10 +193,16 @@ tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufInstance** ppInst
     pInstance->pCircBufHeader->readOffset = 0;
     pInstance->pCircBufHeader->writeOffset = 0;
     pInstance->pCircBufHeader->dataCount = 0;
+    pInstance->pCircBufHeader->mode = mode_p;
+    pInstance->pCircBufHeader->writeCount = 0;
+    pInstance->pCircBufHeader->readCount = 0;
+    pInstance->pCircBufHeader->writeBlockCount = 0;
+    pInstance->pCircBufHeader->readBlockCount = 0;
 #ifdef DEBUG_CIRCBUF_SIZE_CHECK
     pInstance->pCircBufHeader->maxSize = 0;
 #endif
     pInstance->pfnSigCb = NULL;
+    pInstance->fSpsc = (mode_p == kCircBufModeSpsc);
 
     OPLK_DCACHE_FLUSH(pInstance->pCircBufHeader, sizeof(tCircBufHeader));
     *ppInstance_p = pInstance;
@@ -226,6 +269,14 @@ tCircBufError circbuf_connect(UINT8 id_p, tCircBufInstance** ppInstance_p)
         return kCircBufNoResource;
     }
 
+    // On single process targets the instance is shared with the primary
+    // instance, which may allocate the buffer (and set the mode) later.
+    if (pInstance->pCircBufHeader != NULL)
+    {
+        OPLK_DCACHE_INVALIDATE(pInstance->pCircBufHeader, sizeof(tCircBufHeader));
+        pInstance->fSpsc = (pInstance->pCircBufHeader->mode == kCircBufModeSpsc);
+    }
+
     *ppInstance_p = pInstance;
 
     return kCircBufOk;
@@ -259,7 +310,8 @@ tCircBufError circbuf_disconnect(tCircBufInstance* pInstance_p)
 \brief  Reset a circular buffer
 
 The function resets a circular buffer. The read and write pointer are set
-to the start address of the buffer.
+to the start address of the buffer. In SPSC mode the writer and the reader must
+not access the buffer while it is reset.
 
 \param[in]      pInstance_p         Pointer to circular buffer instance to be reset.
 
@@ -281,6 +333,10 @@ void circbuf_reset(tCircBufInstance* pInstance_p)
     pHeader->writeOffset = 0;
     pHeader->freeSize = pHeader->bufferSize;
     pHeader->dataCount = 0;
+    pHeader->writeCount = 0;
+    pHeader->readCount = 0;
+    pHeader->writeBlockCount = 0;
+    pHeader->readBlockCount = 0;
 
     OPLK_DCACHE_FLUSH(pInstance_p->pCircBufHeader, sizeof(tCircBufHeader));
     circbuf_unlock(pInstance_p);
@@ -317,6 +373,9 @@ tCircBufError circbuf_writeData(tCircBufInstance* pInstance_p,
     if ((pData_p == NULL) || (size_p == 0))
         return kCircBufOk;
 
+    if (pInstance_p->fSpsc)
+        return writeDataSpsc(pInstance_p, pData_p, size_p, NULL, 0, TRUE);
+
     blockSize     = ((UINT32)size_p + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
     fullBlockSize = blockSize + (UINT32)sizeof(UINT32);
 
@@ -415,6 +474,9 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p,
         return kCircBufOk;
     }
 
+    if (pInstance_p->fSpsc)
+        return writeDataSpsc(pInstance_p, pData_p, size_p, pData2_p, size2_p, TRUE);
+
     pHeader = pInstance_p->pCircBufHeader;
     pCircBuf = (UINT8*)pInstance_p->pCircBuf;
     blockSize = ((UINT32)size_p + (UINT32)size2_p + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
@@ -527,6 +589,9 @@ tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
     if ((pData_p == NULL) || (size_p == 0))
         return kCircBufOk;
 
+    if (pInstance_p->fSpsc)
+        return readDataSpsc(pInstance_p, pData_p, size_p, pDataBlockSize_p);
+
     pHeader = pInstance_p->pCircBufHeader;
     pCircBuf = (UINT8*)pInstance_p->pCircBuf;
 
@@ -586,6 +651,242 @@ tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
     return kCircBufOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Write multiple data blocks to a circular buffer
+
+The function writes several data blocks to a circular buffer. In locked mode
+all blocks are written in a single critical section. The signaling callback is
+called once after all blocks are written. The blocks are written in order until
+a block doesn't fit into the buffer anymore.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      aBlocks_p           Array of data blocks to be written.
+\param[in]      blockCount_p        Number of data blocks in the array.
+\param[out]     pWrittenCount_p     Pointer to store the number of written blocks.
+
+\return The function returns a tCircBufError error code.
+\retval kCircBufOk                  All blocks are written.
+\retval kCircBufBufferFull          Not all blocks fit into the buffer.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+tCircBufError circbuf_writeMultiple(tCircBufInstance* pInstance_p,
+                                    const tCircBufWriteBlock* aBlocks_p,
+                                    UINT blockCount_p,
+                                    UINT* pWrittenCount_p)
+{
+    UINT32                      dataSize;
+    UINT32                      fullBlockSize;
+    UINT32                      offset;
+    tCircBufHeader*             pHeader;
+    UINT8*                      pCircBuf;
+    const tCircBufWriteBlock*   pBlock;
+    UINT                        count;
+    tCircBufError               ret = kCircBufOk;
+
+    // Check parameter validity
+    ASSERT(pInstance_p != NULL);
+    ASSERT(pWrittenCount_p != NULL);
+    ASSERT((aBlocks_p != NULL) || (blockCount_p == 0));
+
+    pHeader = pInstance_p->pCircBufHeader;
+    pCircBuf = (UINT8*)pInstance_p->pCircBuf;
+
+    if (pInstance_p->fSpsc)
+    {
+        for (count = 0; count < blockCount_p; count++)
+        {
+            pBlock = &aBlocks_p[count];
+            ret = writeDataSpsc(pInstance_p,
+                                pBlock->pData, pBlock->size,
+                                pBlock->pData2, (pBlock->pData2 != NULL) ? pBlock->size2 : 0,
+                                FALSE);
+            if (ret != kCircBufOk)
+                break;
+        }
+    }
+    else
+    {
+        circbuf_lock(pInstance_p);
+        OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+
+        for (count = 0; count < blockCount_p; count++)
+        {
+            pBlock = &aBlocks_p[count];
+            dataSize = (UINT32)pBlock->size;
+            if (pBlock->pData2 != NULL)
+                dataSize += (UINT32)pBlock->size2;
+
+            fullBlockSize = ((dataSize + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1)) +
+                            (UINT32)sizeof(UINT32);
+            if (fullBlockSize > pHeader->freeSize)
+            {
+                ret = kCircBufBufferFull;
+                break;
+            }
+
+            // The size header never wraps because blocks and buffer size are aligned
+            *(UINT32*)(pCircBuf + pHeader->writeOffset) = dataSize;
+            OPLK_DCACHE_FLUSH(pCircBuf + pHeader->writeOffset, sizeof(UINT32));
+
+            offset = copyToBuffer(pCircBuf, pHeader->bufferSize,
+                                  pHeader->writeOffset + (UINT32)sizeof(UINT32),
+                                  pBlock->pData, (UINT32)pBlock->size);
+            if (pBlock->pData2 != NULL)
+            {
+                copyToBuffer(pCircBuf, pHeader->bufferSize, offset,
+                             pBlock->pData2, (UINT32)pBlock->size2);
+            }
+
+            offset = pHeader->writeOffset + fullBlockSize;
+            if (offset >= pHeader->bufferSize)
+                offset -= pHeader->bufferSize;
+            pHeader->writeOffset = offset;
+            pHeader->freeSize -= fullBlockSize;
+            pHeader->dataCount++;
+        }
+
+#ifdef DEBUG_CIRCBUF_SIZE_CHECK
+        if (pHeader->bufferSize - pHeader->freeSize > pHeader->maxSize)
+            pHeader->maxSize = pHeader->bufferSize - pHeader->freeSize;
+#endif
+        OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+        circbuf_unlock(pInstance_p);
+    }
+
+    *pWrittenCount_p = count;
+
+    if ((count > 0) && (pInstance_p->pfnSigCb != NULL))
+    {
+        pInstance_p->pfnSigCb();
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read multiple data blocks from a circular buffer
+
+The function reads as many data blocks from a circular buffer as fit into the
+destination buffer, up to the given maximum number of blocks. In locked mode
+all blocks are read in a single critical section. The blocks are stored one
+after another in the destination buffer, each block starts at an offset aligned
+to \ref CIRCBUF_READ_MULTIPLE_ALIGNMENT.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[out]     pData_p             Pointer to store the read data blocks.
+\param[in]      size_p              The size of the destination buffer.
+\param[out]     aBlockSize_p        Array to store the sizes of the read blocks.
+                                    It must provide maxBlockCount_p entries.
+\param[in]      maxBlockCount_p     Maximum number of blocks to read.
+\param[out]     pReadCount_p        Pointer to store the number of read blocks.
+
+\return The function returns a tCircBufError error code.
+\retval kCircBufOk                  At least one block is read.
+\retval kCircBufNoReadableData      The buffer is empty.
+\retval kCircBufReadsizeTooSmall    The first block doesn't fit into the destination buffer.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+tCircBufError circbuf_readMultiple(tCircBufInstance* pInstance_p,
+                                   void* pData_p,
+                                   size_t size_p,
+                                   size_t* aBlockSize_p,
+                                   UINT maxBlockCount_p,
+                                   UINT* pReadCount_p)
+{
+    UINT32              dataSize;
+    UINT32              fullBlockSize;
+    UINT32              offset;
+    size_t              destOffset = 0;
+    tCircBufHeader*     pHeader;
+    UINT8*              pCircBuf;
+    UINT                count;
+    tCircBufError       ret = kCircBufOk;
+
+    // Check parameter validity
+    ASSERT(pInstance_p != NULL);
+    ASSERT(pData_p != NULL);
+    ASSERT(aBlockSize_p != NULL);
+    ASSERT(pReadCount_p != NULL);
+
+    pHeader = pInstance_p->pCircBufHeader;
+    pCircBuf = (UINT8*)pInstance_p->pCircBuf;
+
+    if (pInstance_p->fSpsc)
+    {
+        for (count = 0; count < maxBlockCount_p; count++)
+        {
+            ret = readDataSpsc(pInstance_p, (UINT8*)pData_p + destOffset,
+                               size_p - destOffset, &aBlockSize_p[count]);
+            if (ret != kCircBufOk)
+                break;
+
+            destOffset += (aBlockSize_p[count] + (CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1)) &
+                          ~(size_t)(CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1);
+            if (destOffset >= size_p)
+            {
+                count++;
+                break;
+            }
+        }
+    }
+    else
+    {
+        circbuf_lock(pInstance_p);
+        OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+
+        for (count = 0; count < maxBlockCount_p; count++)
+        {
+            if (pHeader->freeSize == pHeader->bufferSize)
+            {
+                ret = kCircBufNoReadableData;
+                break;
+            }
+
+            OPLK_DCACHE_INVALIDATE((pCircBuf + pHeader->readOffset), sizeof(UINT32));
+            dataSize = *(const UINT32*)(pCircBuf + pHeader->readOffset);
+            if (destOffset + dataSize > size_p)
+            {
+                ret = kCircBufReadsizeTooSmall;
+                break;
+            }
+
+            fullBlockSize = ((dataSize + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1)) +
+                            (UINT32)sizeof(UINT32);
+
+            copyFromBuffer(pCircBuf, pHeader->bufferSize,
+                           pHeader->readOffset + (UINT32)sizeof(UINT32),
+                           (UINT8*)pData_p + destOffset, dataSize);
+
+            offset = pHeader->readOffset + fullBlockSize;
+            if (offset >= pHeader->bufferSize)
+                offset -= pHeader->bufferSize;
+            pHeader->readOffset = offset;
+            pHeader->freeSize += fullBlockSize;
+            pHeader->dataCount--;
+
+            aBlockSize_p[count] = dataSize;
+            destOffset += (dataSize + (CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1)) &
+                          ~(size_t)(CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1);
+        }
+
+        if (count > 0)
+            OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+
+        circbuf_unlock(pInstance_p);
+    }
+
+    *pReadCount_p = count;
+
+    // Report an error only if no block could be read at all
+    return (count > 0) ? kCircBufOk : ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get the available data count
@@ -601,12 +902,21 @@ The function returns the available data count
 //------------------------------------------------------------------------------
 UINT32 circbuf_getDataCount(const tCircBufInstance* pInstance_p)
 {
-    const tCircBufHeader*   pHeader;
+    tCircBufHeader*         pHeader;
+    UINT32                  writeBlockCount;
 
     // Check parameter validity
     ASSERT(pInstance_p != NULL);
 
     pHeader = pInstance_p->pCircBufHeader;
+
+    if (pInstance_p->fSpsc)
+    {
+        OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+        writeBlockCount = CIRCBUF_LOAD_ACQUIRE(&pHeader->writeBlockCount);
+        return writeBlockCount - CIRCBUF_LOAD_ACQUIRE(&pHeader->readBlockCount);
+    }
+
     OPLK_DCACHE_INVALIDATE(&pHeader->dataCount, sizeof(UINT32));
 
     return pHeader->dataCount;
@@ -664,4 +974,223 @@ tCircBufError circBuf_setSignaling(tCircBufInstance* pInstance_p, VOIDFUNCPTR pf
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Write data to a circular buffer in SPSC mode
+
+The function writes one or two source data blocks as a single data block to a
+circular buffer without locking. Only the writer modifies the write offset and
+the write counters, the reader's counters are only read. The written data is
+published by storing the write counters with release semantics.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      pData_p             Pointer to the first data block to be written.
+\param[in]      size_p              The size of the first data block to be written.
+\param[in]      pData2_p            Pointer to the second data block to be written.
+                                    May be NULL.
+\param[in]      size2_p             The size of the second data block to be written.
+\param[in]      fSignal_p           Call the signaling callback after writing.
+
+\return The function returns a tCircBufError error code.
+*/
+//------------------------------------------------------------------------------
+static tCircBufError writeDataSpsc(tCircBufInstance* pInstance_p,
+                                   const void* pData_p, size_t size_p,
+                                   const void* pData2_p, size_t size2_p,
+                                   BOOL fSignal_p)
+{
+    UINT32              dataSize;
+    UINT32              fullBlockSize;
+    UINT32              usedSize;
+    UINT32              offset;
+    tCircBufHeader*     pHeader;
+    UINT8*              pCircBuf;
+
+    pHeader = pInstance_p->pCircBufHeader;
+    pCircBuf = (UINT8*)pInstance_p->pCircBuf;
+    dataSize = (UINT32)(size_p + size2_p);
+    fullBlockSize = ((dataSize + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1)) +
+                    (UINT32)sizeof(UINT32);
+
+    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+
+    // The counters are free running, the difference is valid in case of an overflow
+    usedSize = pHeader->writeCount - CIRCBUF_LOAD_ACQUIRE(&pHeader->readCount);
+    if (fullBlockSize > (pHeader->bufferSize - usedSize))
+        return kCircBufBufferFull;
+
+    // The size header never wraps because blocks and buffer size are aligned
+    offset = pHeader->writeOffset;
+    *(UINT32*)(pCircBuf + offset) = dataSize;
+    OPLK_DCACHE_FLUSH(pCircBuf + offset, sizeof(UINT32));
+
+    offset = copyToBuffer(pCircBuf, pHeader->bufferSize, offset + (UINT32)sizeof(UINT32),
+                          pData_p, (UINT32)size_p);
+    if (pData2_p != NULL)
+    {
+        copyToBuffer(pCircBuf, pHeader->bufferSize, offset,
+                     pData2_p, (UINT32)size2_p);
+    }
+
+    offset = pHeader->writeOffset + fullBlockSize;
+    if (offset >= pHeader->bufferSize)
+        offset -= pHeader->bufferSize;
+    pHeader->writeOffset = offset;
+
+#ifdef DEBUG_CIRCBUF_SIZE_CHECK
+    if (usedSize + fullBlockSize > pHeader->maxSize)
+        pHeader->maxSize = usedSize + fullBlockSize;
+#endif
+
+    // Publish the block, the byte counter must be visible before the block counter
+    CIRCBUF_STORE_RELEASE(&pHeader->writeCount, pHeader->writeCount + fullBlockSize);
+    CIRCBUF_STORE_RELEASE(&pHeader->writeBlockCount, pHeader->writeBlockCount + 1);
+    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+
+    if (fSignal_p && (pInstance_p->pfnSigCb != NULL))
+    {
+        pInstance_p->pfnSigCb();
+    }
+
+    return kCircBufOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read data from a circular buffer in SPSC mode
+
+The function reads a data block from a circular buffer without locking. Only
+the reader modifies the read offset and the read counters. The freed space is
+returned to the writer by storing the read counters with release semantics.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[out]     pData_p             Pointer to store the read data.
+\param[in]      size_p              The size of the destination buffer to store the data.
+\param[out]     pDataBlockSize_p    Pointer to store the size of the read data.
+
+\return The function returns a tCircBufError error code.
+*/
+//------------------------------------------------------------------------------
+static tCircBufError readDataSpsc(tCircBufInstance* pInstance_p, void* pData_p,
+                                  size_t size_p, size_t* pDataBlockSize_p)
+{
+    UINT32              dataSize;
+    UINT32              fullBlockSize;
+    UINT32              offset;
+    tCircBufHeader*     pHeader;
+    UINT8*              pCircBuf;
+
+    pHeader = pInstance_p->pCircBufHeader;
+    pCircBuf = (UINT8*)pInstance_p->pCircBuf;
+
+    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+    if (CIRCBUF_LOAD_ACQUIRE(&pHeader->writeCount) == pHeader->readCount)
+        return kCircBufNoReadableData;
+
+    offset = pHeader->readOffset;
+    OPLK_DCACHE_INVALIDATE(pCircBuf + offset, sizeof(UINT32));
+    dataSize = *(const UINT32*)(pCircBuf + offset);
+    if (dataSize > size_p)
+        return kCircBufReadsizeTooSmall;
+
+    fullBlockSize = ((dataSize + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1)) +
+                    (UINT32)sizeof(UINT32);
+
+    copyFromBuffer(pCircBuf, pHeader->bufferSize, offset + (UINT32)sizeof(UINT32),
+                   pData_p, dataSize);
+
+    offset += fullBlockSize;
+    if (offset >= pHeader->bufferSize)
+        offset -= pHeader->bufferSize;
+    pHeader->readOffset = offset;
+
+    // Release the block, the byte counter must be visible before the block counter
+    CIRCBUF_STORE_RELEASE(&pHeader->readCount, pHeader->readCount + fullBlockSize);
+    CIRCBUF_STORE_RELEASE(&pHeader->readBlockCount, pHeader->readBlockCount + 1);
+    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+
+    *pDataBlockSize_p = dataSize;
+    return kCircBufOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy data into the circular buffer
+
+The function copies data into the circular buffer memory and wraps around at
+the end of the buffer.
+
+\param[in,out]  pCircBuf_p          Pointer to the circular buffer memory.
+\param[in]      bufferSize_p        Size of the circular buffer memory.
+\param[in]      offset_p            Offset to copy the data to.
+\param[in]      pData_p             Pointer to the data to be copied.
+\param[in]      size_p              Size of the data to be copied.
+
+\return The function returns the offset following the copied data.
+*/
+//------------------------------------------------------------------------------
+static UINT32 copyToBuffer(UINT8* pCircBuf_p, UINT32 bufferSize_p, UINT32 offset_p,
+                           const void* pData_p, UINT32 size_p)
+{
+    UINT32  chunkSize;
+
+    if (offset_p >= bufferSize_p)
+        offset_p -= bufferSize_p;
+
+    if (offset_p + size_p <= bufferSize_p)
+    {
+        OPLK_MEMCPY(pCircBuf_p + offset_p, pData_p, size_p);
+        OPLK_DCACHE_FLUSH(pCircBuf_p + offset_p, size_p);
+        return offset_p + size_p;
+    }
+
+    chunkSize = bufferSize_p - offset_p;
+    OPLK_MEMCPY(pCircBuf_p + offset_p, pData_p, chunkSize);
+    OPLK_DCACHE_FLUSH(pCircBuf_p + offset_p, chunkSize);
+    OPLK_MEMCPY(pCircBuf_p, (const UINT8*)pData_p + chunkSize, size_p - chunkSize);
+    OPLK_DCACHE_FLUSH(pCircBuf_p, size_p - chunkSize);
+
+    return size_p - chunkSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy data from the circular buffer
+
+The function copies data from the circular buffer memory and wraps around at
+the end of the buffer.
+
+\param[in]      pCircBuf_p          Pointer to the circular buffer memory.
+\param[in]      bufferSize_p        Size of the circular buffer memory.
+\param[in]      offset_p            Offset to copy the data from.
+\param[out]     pData_p             Pointer to store the copied data.
+\param[in]      size_p              Size of the data to be copied.
+
+\return The function returns the offset following the copied data.
+*/
+//------------------------------------------------------------------------------
+static UINT32 copyFromBuffer(const UINT8* pCircBuf_p, UINT32 bufferSize_p, UINT32 offset_p,
+                             void* pData_p, UINT32 size_p)
+{
+    UINT32  chunkSize;
+
+    if (offset_p >= bufferSize_p)
+        offset_p -= bufferSize_p;
+
+    if (offset_p + size_p <= bufferSize_p)
+    {
+        OPLK_DCACHE_INVALIDATE(pCircBuf_p + offset_p, size_p);
+        OPLK_MEMCPY(pData_p, pCircBuf_p + offset_p, size_p);
+        return offset_p + size_p;
+    }
+
+    chunkSize = bufferSize_p - offset_p;
+    OPLK_DCACHE_INVALIDATE(pCircBuf_p + offset_p, chunkSize);
+    OPLK_MEMCPY(pData_p, pCircBuf_p + offset_p, chunkSize);
+    OPLK_DCACHE_INVALIDATE(pCircBuf_p, size_p - chunkSize);
+    OPLK_MEMCPY((UINT8*)pData_p + chunkSize, pCircBuf_p, size_p - chunkSize);
+
+    return size_p - chunkSize;
+}
+
 /// \}
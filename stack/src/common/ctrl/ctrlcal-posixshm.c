@@ -7,6 +7,10 @@
 The file contains a posix shared memory implementation which can be used by the
 memory block control CAL modules.
 
+The signals between the user and the kernel layer are implemented with futexes
+located behind the control memory block in the shared memory. A waiting process
+sleeps in the kernel until the signal counter is changed by the other process.
+
 \ingroup module_ctrl
 *******************************************************************************/
 
@@ -48,6 +52,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sys/types.h>
 #include <fcntl.h>           /* For O_* constants */
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <limits.h>
+#include <time.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -77,14 +85,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief Control CAL signal
+
+The structure contains the futex of a control CAL signal.
+*/
+typedef struct
+{
+    UINT32          signalCount;            ///< Signal counter used as futex word
+    UINT32          waiterCount;            ///< Number of processes waiting for the signal
+} tCtrlCalSignalFutex;
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static int          fd_l;
-static UINT8*       pCtrlMem_l;
-static int          size_l;
-static BOOL         fCreator_l;
+static int                  fd_l;
+static UINT8*               pCtrlMem_l;
+static int                  size_l;
+static BOOL                 fCreator_l;
+static tCtrlCalSignalFutex* pSignal_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -110,6 +129,11 @@ The function initializes the control CAL module.
 tOplkError ctrlcal_init(UINT size_p)
 {
     struct stat stat;
+    UINT        signalOffset;
+
+    // The signal futexes are located behind the control memory block
+    signalOffset = (size_p + sizeof(UINT32) - 1) & ~(sizeof(UINT32) - 1);
+    size_p = signalOffset + (sizeof(tCtrlCalSignalFutex) * kCtrlCalSignalCount);
 
     fd_l = shm_open(CTRL_SHM_NAME, O_RDWR | O_CREAT, 0);
     if (fd_l < 0)
@@ -150,6 +174,7 @@ tOplkError ctrlcal_init(UINT size_p)
     {
         OPLK_MEMSET(pCtrlMem_l, 0, size_p);
     }
+    pSignal_l = (tCtrlCalSignalFutex*)(pCtrlMem_l + signalOffset);
     size_l = size_p;
 
     return kErrorOk;
@@ -178,6 +203,7 @@ tOplkError ctrlcal_exit(void)
             shm_unlink(CTRL_SHM_NAME);
         fd_l = 0;
         pCtrlMem_l = 0;
+        pSignal_l = NULL;
         size_l = 0;
     }
 
@@ -246,6 +272,94 @@ tOplkError ctrlcal_readData(void* pDest_p,
     return kErrorOk;
 }
 
+
+//------------------------------------------------------------------------------
+/**
+\brief Get signal counter
+
+The function returns the current counter of the specified signal. The counter
+has to be read before the signaled condition is checked. Afterwards,
+ctrlcal_waitSignal() is called with the read counter to wait for the signal.
+Thus, no signal sent in between can be lost.
+
+\param[in]      signal_p            Signal to read the counter from.
+
+\return The function returns the signal counter.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+UINT32 ctrlcal_getSignalCount(tCtrlCalSignal signal_p)
+{
+    if ((pSignal_l == NULL) || (signal_p >= kCtrlCalSignalCount))
+        return 0;
+
+    return __atomic_load_n(&pSignal_l[signal_p].signalCount, __ATOMIC_SEQ_CST);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Send signal
+
+The function sends the specified signal and wakes up all processes waiting for
+it. The system call is only executed if there is a waiting process.
+
+\param[in]      signal_p            Signal to send.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+void ctrlcal_sendSignal(tCtrlCalSignal signal_p)
+{
+    tCtrlCalSignalFutex*    pSignal;
+
+    if ((pSignal_l == NULL) || (signal_p >= kCtrlCalSignalCount))
+        return;
+
+    pSignal = &pSignal_l[signal_p];
+    __atomic_add_fetch(&pSignal->signalCount, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pSignal->waiterCount, __ATOMIC_SEQ_CST) != 0)
+        syscall(SYS_futex, &pSignal->signalCount, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Wait for signal
+
+The function waits until the counter of the specified signal differs from the
+provided counter or until the timeout elapsed.
+
+\param[in]      signal_p            Signal to wait for.
+\param[in]      signalCount_p       Signal counter read by ctrlcal_getSignalCount().
+\param[in]      timeoutMs_p         Timeout in milliseconds.
+
+\return The function returns TRUE if the signal was sent, otherwise FALSE.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+BOOL ctrlcal_waitSignal(tCtrlCalSignal signal_p,
+                        UINT32 signalCount_p,
+                        UINT32 timeoutMs_p)
+{
+    tCtrlCalSignalFutex*    pSignal;
+    struct timespec         timeout;
+
+    if ((pSignal_l == NULL) || (signal_p >= kCtrlCalSignalCount))
+        return FALSE;
+
+    pSignal = &pSignal_l[signal_p];
+    timeout.tv_sec = timeoutMs_p / 1000;
+    timeout.tv_nsec = (timeoutMs_p % 1000) * 1000000;
+
+    __atomic_add_fetch(&pSignal->waiterCount, 1, __ATOMIC_SEQ_CST);
+    // The kernel puts the process to sleep only if the counter is unchanged
+    syscall(SYS_futex, &pSignal->signalCount, FUTEX_WAIT, signalCount_p, &timeout, NULL, 0);
+    __atomic_sub_fetch(&pSignal->waiterCount, 1, __ATOMIC_SEQ_CST);
+
+    return (__atomic_load_n(&pSignal->signalCount, __ATOMIC_SEQ_CST) != signalCount_p);
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
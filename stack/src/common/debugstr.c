@@ -483,6 +483,7 @@ static const tRetValInfo retValInfo_l[] =
     { kErrorApiPIInvalidPIPointer,    "Process image: pointer to application's process image is invalid"},
     { kErrorApiPINonBlockingNotSupp,  "Process image: non-blocking copy jobs are not supported on this target"},
     { kErrorApiNotInitialized,        "API called but stack is not initialized/running"},
+    { kErrorApiPILayoutMismatch,      "Process image: layout does not match the PDO payload layout"},
 };
 
 static const tEmergErrCodeInfo emergErrCodeInfo_l[] =
@@ -76,6 +76,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/veth.h>
 #endif
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+#include <kernel/latencyk.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -450,6 +454,12 @@ static tOplkError initStack(void)
     if (ret != kErrorOk)
         return ret;
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+    ret = latencyk_init();
+    if (ret != kErrorOk)
+        return ret;
+#endif
+
     ret = nmtk_init();
     if (ret != kErrorOk)
         return ret;
@@ -579,6 +589,10 @@ static tOplkError shutdownStack(void)
 
     edrv_exit();
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+    latencyk_exit();
+#endif
+
     errhndk_exit();
 
     return kErrorOk;
@@ -70,6 +70,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define CTRL_CMD_WAIT_TIMEOUT       20      // [ms] maximum time ctrlkcal_process() waits for a command
 
 //------------------------------------------------------------------------------
 // local types
@@ -78,6 +79,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static UINT32       cmdSignalCount_l;       ///< Command signal counter read before the last command check
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -141,7 +143,9 @@ void ctrlkcal_exit(void)
 /**
 \brief  Process kernel control CAL module
 
-This function provides processing time for the CAL module.
+This function provides processing time for the CAL module. It blocks until the
+user layer signals a new command or until CTRL_CMD_WAIT_TIMEOUT elapsed. Thus,
+the caller is able to process commands immediately without polling.
 
 \return The function returns a tOplkError error code.
 
@@ -150,6 +154,8 @@ This function provides processing time for the CAL module.
 //------------------------------------------------------------------------------
 tOplkError ctrlkcal_process(void)
 {
+    ctrlcal_waitSignal(kCtrlCalSignalCmd, cmdSignalCount_l, CTRL_CMD_WAIT_TIMEOUT);
+
     return kErrorOk;
 }
 
@@ -175,6 +181,9 @@ tOplkError ctrlkcal_getCmd(tCtrlCmdType* pCmd_p)
     // Check parameter validity
     ASSERT(pCmd_p != NULL);
 
+    // Signals sent after this point wake up the next ctrlkcal_process() call
+    cmdSignalCount_l = ctrlcal_getSignalCount(kCtrlCalSignalCmd);
+
     ret = ctrlcal_readData(&cmd, offsetof(tCtrlBuf, ctrlCmd.cmd), sizeof(tCtrlCmdType));
     if (ret == kErrorOk)
         *pCmd_p = cmd;
@@ -202,6 +211,7 @@ void ctrlkcal_sendReturn(UINT16 retval_p)
     ctrlCmd.retVal = retval_p;
 
     ctrlcal_writeData(offsetof(tCtrlBuf, ctrlCmd), &ctrlCmd, sizeof(tCtrlCmd));
+    ctrlcal_sendSignal(kCtrlCalSignalReturn);
 }
 
 //------------------------------------------------------------------------------
@@ -174,23 +174,27 @@ static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
         case kDllCalQueueTxGen:
             error = circbuf_alloc(CIRCBUF_DLLCAL_TXGEN,
                                   CONFIG_DLLCAL_BUFFER_SIZE_TX_GEN,
+                                  kCircBufModeLocked,
                                   &pDllCalCircBufInstance->pCircBufInstance);
             break;
 
         case kDllCalQueueTxNmt:
             error = circbuf_alloc(CIRCBUF_DLLCAL_TXNMT,
                                   CONFIG_DLLCAL_BUFFER_SIZE_TX_NMT,
+                                  kCircBufModeLocked,
                                   &pDllCalCircBufInstance->pCircBufInstance);
             break;
 
         case kDllCalQueueTxSync:
             error = circbuf_alloc(CIRCBUF_DLLCAL_TXSYNC, CONFIG_DLLCAL_BUFFER_SIZE_TX_SYNC,
+                                  kCircBufModeLocked,
                                   &pDllCalCircBufInstance->pCircBufInstance);
             break;
 
         case kDllCalQueueTxVeth:
             error = circbuf_alloc(CIRCBUF_DLLCAL_TXVETH,
                                   CONFIG_DLLCAL_BUFFER_SIZE_TX_VETH,
+                                  kCircBufModeLocked,
                                   &pDllCalCircBufInstance->pCircBufInstance);
             break;
 
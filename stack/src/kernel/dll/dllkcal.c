@@ -254,6 +254,7 @@ tOplkError dllkcal_init(void)
     }
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_NMT,
                             CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_NMT,
+                            kCircBufModeLocked,
                             &instance_l.pQueueCnRequestNmt);
     if (circErr != kCircBufOk)
     {
@@ -263,6 +264,7 @@ tOplkError dllkcal_init(void)
 
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_GEN,
                             CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_GEN,
+                            kCircBufModeLocked,
                             &instance_l.pQueueCnRequestGen);
     if (circErr != kCircBufOk)
     {
@@ -272,6 +274,7 @@ tOplkError dllkcal_init(void)
 
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_IDENT,
                             CONFIG_DLLCAL_SIZE_CIRCBUF_REQ_IDENT,
+                            kCircBufModeLocked,
                             &instance_l.pQueueIdentReq);
     if (circErr != kCircBufOk)
     {
@@ -281,6 +284,7 @@ tOplkError dllkcal_init(void)
 
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_STATUS,
                             CONFIG_DLLCAL_SIZE_CIRCBUF_REQ_STATUS,
+                            kCircBufModeLocked,
                             &instance_l.pQueueStatusReq);
     if (circErr != kCircBufOk)
     {
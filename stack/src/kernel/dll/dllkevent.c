@@ -1031,13 +1031,11 @@ static tOplkError processSyncMn(tNmtState nmtState_p, BOOL fReadyFlag_p)
     pTxBuffer->timeOffsetNs = nextTimeOffsetNs;
     pTxFrame = (tPlkFrame*)pTxBuffer->pBuffer;
 
-#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     // Forward SoC time information to timesync module. Note that this SoC time
     // info is sent after the current cycle is completed (due to double buffers)!
     ret = timesynck_setSocTime(&dllkInstance_g.socTime);
     if (ret != kErrorOk)
         return ret;
-#endif
 
     // Set SoC relative time
     ami_setUint64Le(&pTxFrame->data.soc.relativeTimeLe, dllkInstance_g.socTime.relTime);
@@ -72,6 +72,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/timestamp.h>
 #endif
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+#include <kernel/latencyk.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -189,11 +193,17 @@ tEdrvReleaseRxBuffer dllkframe_processFrameReceived(tEdrvRxBuffer* pRxBuffer_p)
     tPlkFrame*              pFrame;
     tFrameInfo              frameInfo;
     tMsgType                msgType;
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+    UINT32                  rxTimeStamp;
+#endif
     TGT_DLLK_DECLARE_FLAGS
 
     TGT_DLLK_ENTER_CRITICAL_SECTION()
 
     BENCHMARK_MOD_02_SET(3);
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+    rxTimeStamp = latencyk_getTimestamp();
+#endif
     nmtState = dllkInstance_g.nmtState;
     if (nmtState <= kNmtGsResetConfiguration)
         goto Exit;
@@ -278,19 +288,33 @@ tEdrvReleaseRxBuffer dllkframe_processFrameReceived(tEdrvRxBuffer* pRxBuffer_p)
                 goto Exit;
             }
             nmtEvent = kNmtEventDllCePreq;
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+            // the Rx timestamp is forwarded with the RPDO event
+            latencyk_start(kLatencyProbeRxToPdo, rxTimeStamp);
+#endif
             ret = processReceivedPreq(&frameInfo, nmtState, &releaseRxBuffer);
             if (ret != kErrorOk)
                 goto Exit;
             break;
 
         case kMsgTypePres:
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+            // the Rx timestamp is forwarded with the RPDO event
+            latencyk_start(kLatencyProbeRxToPdo, rxTimeStamp);
+#endif
             ret = processReceivedPres(&frameInfo, nmtState, &nmtEvent, &releaseRxBuffer);
             if (ret != kErrorOk)
                 goto Exit;
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+            latencyk_stop(kLatencyProbeSocToPres, FALSE);
+#endif
             break;
 
         case kMsgTypeSoc:
             nmtEvent = kNmtEventDllCeSoc;
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+            latencyk_start(kLatencyProbeSocToPres, rxTimeStamp);
+#endif
             ret = processReceivedSoc(pRxBuffer_p, nmtState);
             if (ret != kErrorOk)
                 goto Exit;
@@ -2192,12 +2216,10 @@ static tOplkError processReceivedSoc(const tEdrvRxBuffer* pRxBuffer_p,
 
         dllkInstance_g.socTime.relTime = relTime;
 
-#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
         // Forward Soc time stamp to timesync modules
         ret = timesynck_setSocTime(&dllkInstance_g.socTime);
         if (ret != kErrorOk)
             return ret;
-#endif
     }
 
     // reprogram timer
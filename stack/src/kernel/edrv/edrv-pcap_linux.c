@@ -43,6 +43,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <common/ftracedebug.h>
 #include <kernel/edrv.h>
+#include <kernel/edrvrxpool.h>
 
 #include <unistd.h>
 #include <pcap.h>
@@ -148,6 +149,12 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
     // save the init data
     edrvInstance_l.initParam = *pEdrvInitParam_p;
 
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    // Received frames are passed in pool buffers which may be released later
+    if (edrvrxpool_init(EDRV_MAX_FRAME_SIZE) != kErrorOk)
+        return kErrorEdrvInit;
+#endif
+
     /* if no MAC address was specified read MAC address of used
      * Ethernet interface
      */
@@ -231,6 +238,10 @@ tOplkError edrv_exit(void)
     // Close pcap instance
     pcap_close(edrvInstance_l.pPcap);
 
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    edrvrxpool_exit();
+#endif
+
     // Destroy the mutex
     pthread_mutex_destroy(&edrvInstance_l.mutex);
 
@@ -457,6 +468,29 @@ tOplkError edrv_setRxMulticastMacAddr(const UINT8* pMacAddr_p)
     return kErrorOk;
 }
 
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+//------------------------------------------------------------------------------
+/**
+\brief  Release Rx buffer
+
+This function releases a late release Rx buffer to the Rx buffer pool.
+
+\param[in,out]  pRxBuffer_p         Rx buffer to be released
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_releaseRxBuffer(tEdrvRxBuffer* pRxBuffer_p)
+{
+    // Check parameter validity
+    ASSERT(pRxBuffer_p != NULL);
+
+    return edrvrxpool_releaseBuffer(pRxBuffer_p->pBuffer);
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -488,7 +522,11 @@ static void packetHandler(u_char* pParam_p,
         rxBuffer.pBuffer = (UINT8*)pPktData_p;
 
         FTRACE_MARKER("%s RX", __func__);
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+        edrvrxpool_receiveFrame(pInstance->initParam.pfnRxHandler, &rxBuffer);
+#else
         pInstance->initParam.pfnRxHandler(&rxBuffer);
+#endif
     }
     else
     {   // self generated traffic
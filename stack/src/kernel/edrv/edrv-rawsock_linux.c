@@ -0,0 +1,1482 @@
+/**
+********************************************************************************
+\file   edrv-rawsock_linux.c
+
+\brief  Implementation of Linux raw socket Ethernet driver
+
+This file contains the implementation of the Linux raw socket Ethernet driver.
+It uses a packet socket with memory mapped receive and transmit rings
+(PACKET_MMAP). Frames are received from the RX ring without copying them into
+userspace. Frames to be sent are copied into the TX ring, which is flushed to
+the network device bypassing the queuing discipline. The transmission of a
+frame is completed when the kernel returns its TX ring slot, so no loopback of
+self generated frames is needed.
+
+The rings use the TPACKET_V2 format. The block based TPACKET_V3 format only
+hands over a block when it is full or its retire timeout (at least 1 ms) has
+expired, which is too slow for POWERLINK cycle times.
+
+If time triggered sending is enabled (EDRV_USE_TTTX), the cyclic Edrv hands
+the frames of a whole cycle to the driver ahead of time, each with its launch
+time (CLOCK_TAI). If an ETF or taprio queuing discipline is installed on the
+interface, the frames are passed through it with an SCM_TXTIME launch time, so
+the kernel (or the network device) sends them on time. Otherwise, e.g. on a
+veth pair, the worker thread holds back the frames in the TX ring and flushes
+each one at its launch time.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/ftracedebug.h>
+#include <kernel/edrv.h>
+
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <semaphore.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+
+#if (EDRV_USE_TTTX != FALSE)
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/net_tstamp.h>
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EDRV_MAX_FRAME_SIZE         0x0600
+
+#define EDRV_RING_FRAME_SIZE        2048                // Size of a ring slot, holds header and maximum frame
+#define EDRV_RING_BLOCK_SIZE        4096                // Size of a ring block (one page)
+#define EDRV_RX_FRAME_COUNT         256                 // Number of RX ring slots
+#define EDRV_TX_FRAME_COUNT         64                  // Number of TX ring slots
+
+#define EDRV_TX_RETRY_INTERVAL_NS   1000000ULL          // Check interval for TX slots not yet taken by the kernel [ns]
+#define EDRV_LINK_POLL_INTERVAL_NS  100000000ULL        // Polling interval for the link status [ns]
+
+// Offset of the frame data in a ring slot
+#define EDRV_RING_DATA_OFFSET       TPACKET_ALIGN(sizeof(struct tpacket2_hdr))
+
+#if (EDRV_USE_TTTX != FALSE)
+#ifndef CLOCK_TAI
+#define CLOCK_TAI                   11
+#endif
+
+#define EDRV_NETLINK_BUFFER_SIZE    8192                // Size of the netlink receive buffer for the qdisc query
+#define EDRV_TX_IMMEDIATE_LAUNCH_NS 20000               // Launch delay of frames without launch time if the qdisc enforces launch times [ns]
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Structure describing an instance of the Edrv
+
+This structure describes an instance of the Ethernet driver.
+*/
+typedef struct
+{
+    tEdrvInitParam      initParam;                              ///< Init parameters
+    int                 sock;                                   ///< Packet socket
+    int                 wakeFd;                                 ///< Event file descriptor to wake up the worker thread
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    int                 rxEpollFd;                              ///< Edge-triggered epoll instance signaling received frames
+#endif
+    UINT8*              pRing;                                  ///< Memory mapped RX and TX rings
+    size_t              ringSize;                               ///< Size of the mapped rings
+    UINT8*              pRxRing;                                ///< Start of the RX ring
+    UINT8*              pTxRing;                                ///< Start of the TX ring
+    UINT                rxIndex;                                ///< Next RX ring slot to be processed
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    BOOL                afRxSlotLent[EDRV_RX_FRAME_COUNT];      ///< RX ring slots lent to the stack until edrv_releaseRxBuffer()
+#endif
+    UINT                txHead;                                 ///< Next TX ring slot to be filled
+    UINT                txTail;                                 ///< Oldest TX ring slot waiting for completion
+    UINT                txPendingCount;                         ///< Number of TX ring slots waiting for completion
+    tEdrvTxBuffer*      apTxBuffer[EDRV_TX_FRAME_COUNT];        ///< TX buffers of the pending TX ring slots
+#if (EDRV_USE_TTTX != FALSE)
+    BOOL                fQdiscLaunchTime;                       ///< Launch times are enforced by a queuing discipline (SO_TXTIME)
+    UINT                txWaitingCount;                         ///< Number of pending TX ring slots waiting for their launch time
+    UINT64              aLaunchTime[EDRV_TX_FRAME_COUNT];       ///< Launch times of the waiting TX ring slots
+#endif
+    pthread_mutex_t     mutex;                                  ///< Mutex for locking of critical sections
+    sem_t               syncSem;                                ///< Semaphore for signaling the start of the worker thread
+    pthread_t           hThread;                                ///< Handle of the worker thread
+    volatile BOOL       fStopThread;                            ///< Flag to stop the worker thread
+    volatile BOOL       fLinkUp;                                ///< Link status, polled by the worker thread
+} tEdrvInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEdrvInstance edrvInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void*                workerThread(void* pArgument_p);
+static void                 processRxRing(tEdrvInstance* pInstance_p);
+static UINT                 processTxCompletion(tEdrvInstance* pInstance_p);
+static tOplkError           openSocket(tEdrvInstance* pInstance_p);
+static void                 closeSocket(tEdrvInstance* pInstance_p);
+static struct tpacket2_hdr* getRingSlot(UINT8* pRing_p, UINT index_p);
+static UINT32               loadSlotStatus(const struct tpacket2_hdr* pSlot_p);
+static void                 storeSlotStatus(struct tpacket2_hdr* pSlot_p, UINT32 status_p);
+static void                 getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p);
+static BOOL                 getLinkStatus(int sock_p, const char* pIfName_p);
+static UINT64               getMonotonicTime(void);
+#if (EDRV_USE_TTTX != FALSE)
+static void                 flushTxRing(const tEdrvInstance* pInstance_p, UINT64 launchTime_p);
+static UINT64               processTxLaunch(tEdrvInstance* pInstance_p);
+static BOOL                 isLaunchTimeQdiscInstalled(int ifIndex_p);
+static UINT64               getTaiTime(void);
+#endif
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Ethernet driver initialization
+
+This function initializes the Ethernet driver.
+
+\param[in]      pEdrvInitParam_p    Edrv initialization parameters
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
+{
+    struct sched_param  schedParam;
+    tOplkError          ret;
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    struct epoll_event  event;
+#endif
+
+    // Check parameter validity
+    ASSERT(pEdrvInitParam_p != NULL);
+
+    // clear instance structure
+    OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+    edrvInstance_l.sock = -1;
+    edrvInstance_l.wakeFd = -1;
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    edrvInstance_l.rxEpollFd = -1;
+#endif
+
+    if (pEdrvInitParam_p->hwParam.pDevName == NULL)
+        return kErrorEdrvInit;
+
+    // save the init data
+    edrvInstance_l.initParam = *pEdrvInitParam_p;
+
+    /* if no MAC address was specified read MAC address of used
+     * Ethernet interface
+     */
+    if ((edrvInstance_l.initParam.aMacAddr[0] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[1] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[2] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[3] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[4] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[5] == 0))
+    {   // read MAC address from controller
+        getMacAdrs(edrvInstance_l.initParam.hwParam.pDevName,
+                   edrvInstance_l.initParam.aMacAddr);
+    }
+
+    ret = openSocket(&edrvInstance_l);
+    if (ret != kErrorOk)
+        goto ExitSocket;
+
+    edrvInstance_l.wakeFd = eventfd(0, EFD_NONBLOCK);
+    if (edrvInstance_l.wakeFd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't create eventfd (%s)\n", __func__, strerror(errno));
+        ret = kErrorEdrvInit;
+        goto ExitSocket;
+    }
+
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    // The socket stays readable while the last received slot is lent, so the
+    // worker thread waits for new frames edge-triggered
+    edrvInstance_l.rxEpollFd = epoll_create1(0);
+    if (edrvInstance_l.rxEpollFd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't create epoll instance (%s)\n", __func__, strerror(errno));
+        ret = kErrorEdrvInit;
+        goto ExitSocket;
+    }
+
+    OPLK_MEMSET(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = edrvInstance_l.sock;
+    if (epoll_ctl(edrvInstance_l.rxEpollFd, EPOLL_CTL_ADD, edrvInstance_l.sock, &event) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't add socket to epoll instance (%s)\n", __func__, strerror(errno));
+        ret = kErrorEdrvInit;
+        goto ExitSocket;
+    }
+#endif
+
+    if (pthread_mutex_init(&edrvInstance_l.mutex, NULL) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't init mutex\n", __func__);
+        ret = kErrorEdrvInit;
+        goto ExitSocket;
+    }
+
+    if (sem_init(&edrvInstance_l.syncSem, 0, 0) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't init semaphore\n", __func__);
+        ret = kErrorEdrvInit;
+        goto ExitMutex;
+    }
+
+    if (pthread_create(&edrvInstance_l.hThread, NULL,
+                       workerThread,  &edrvInstance_l) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't create worker thread!\n", __func__);
+        ret = kErrorEdrvInit;
+        goto ExitSemaphore;
+    }
+
+    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_MEDIUM;
+    if (pthread_setschedparam(edrvInstance_l.hThread, SCHED_FIFO, &schedParam) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
+    }
+
+#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
+    pthread_setname_np(edrvInstance_l.hThread, "oplk-edrvrawsock");
+#endif
+
+    /* wait until thread is started */
+    sem_wait(&edrvInstance_l.syncSem);
+
+    return kErrorOk;
+
+ExitSemaphore:
+    sem_destroy(&edrvInstance_l.syncSem);
+
+ExitMutex:
+    pthread_mutex_destroy(&edrvInstance_l.mutex);
+
+ExitSocket:
+    closeSocket(&edrvInstance_l);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down Ethernet driver
+
+This function shuts down the Ethernet driver.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_exit(void)
+{
+    UINT64  value = 1;
+
+    // Stop the worker thread and wait for it to terminate
+    edrvInstance_l.fStopThread = TRUE;
+    if (write(edrvInstance_l.wakeFd, &value, sizeof(value)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't wake worker thread (%s)\n", __func__, strerror(errno));
+    }
+    pthread_join(edrvInstance_l.hThread, NULL);
+
+    // Close the socket and unmap the rings
+    closeSocket(&edrvInstance_l);
+
+    // Destroy the mutex
+    pthread_mutex_destroy(&edrvInstance_l.mutex);
+    sem_destroy(&edrvInstance_l.syncSem);
+
+    // Clear instance structure
+    OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get MAC address
+
+This function returns the MAC address of the Ethernet controller
+
+\return The function returns a pointer to the MAC address.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+const UINT8* edrv_getMacAddr(void)
+{
+    return edrvInstance_l.initParam.aMacAddr;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send Tx buffer
+
+This function sends the Tx buffer. The frame is copied into the next free TX
+ring slot and all requested slots are flushed to the network device. The Tx
+handler is called by the worker thread as soon as the kernel has released the
+slot again.
+
+With time triggered sending, a frame with a valid launch time is either passed
+to the queuing discipline with this launch time, or held back in the TX ring
+until the worker thread flushes it at its launch time. Frames without a launch
+time are held back as well as long as earlier frames are waiting, so the frame
+order is kept.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    struct tpacket2_hdr*    pSlot;
+    UINT64                  value = 1;
+#if (EDRV_USE_TTTX != FALSE)
+    UINT64                  launchTime;
+    BOOL                    fHoldBack;
+#endif
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    FTRACE_MARKER("%s", __func__);
+
+    if (pBuffer_p->txBufferNumber.pArg != NULL)
+        return kErrorInvalidOperation;
+
+    if (!edrvInstance_l.fLinkUp)
+    {
+        /* there's no link! We pretend that packet is sent and immediately call
+         * tx handler! Otherwise the stack would hang! */
+        if (pBuffer_p->pfnTxHandler != NULL)
+        {
+            pBuffer_p->pfnTxHandler(pBuffer_p);
+        }
+        return kErrorOk;
+    }
+
+    pthread_mutex_lock(&edrvInstance_l.mutex);
+
+    pSlot = getRingSlot(edrvInstance_l.pTxRing, edrvInstance_l.txHead);
+    if ((edrvInstance_l.txPendingCount == EDRV_TX_FRAME_COUNT) ||
+        (loadSlotStatus(pSlot) != TP_STATUS_AVAILABLE))
+    {
+        pthread_mutex_unlock(&edrvInstance_l.mutex);
+        DEBUG_LVL_EDRV_TRACE("%s() TX ring is full\n", __func__);
+        return kErrorEdrvNoFreeTxDesc;
+    }
+
+    OPLK_MEMCPY((UINT8*)pSlot + EDRV_RING_DATA_OFFSET, pBuffer_p->pBuffer, pBuffer_p->txFrameSize);
+    pSlot->tp_len = pBuffer_p->txFrameSize;
+
+    // Mark the buffer as pending until the slot is released by the kernel
+    pBuffer_p->txBufferNumber.pArg = &edrvInstance_l;
+    edrvInstance_l.apTxBuffer[edrvInstance_l.txHead] = pBuffer_p;
+
+#if (EDRV_USE_TTTX != FALSE)
+    launchTime = (pBuffer_p->fLaunchTimeValid) ? pBuffer_p->launchTime.nanoseconds : 0;
+    if (edrvInstance_l.fQdiscLaunchTime && (launchTime == 0))
+    {   // The queuing discipline drops frames without launch time
+        launchTime = getTaiTime() + EDRV_TX_IMMEDIATE_LAUNCH_NS;
+    }
+    fHoldBack = (!edrvInstance_l.fQdiscLaunchTime &&
+                 ((launchTime != 0) || (edrvInstance_l.txWaitingCount > 0)));
+    if (fHoldBack)
+    {   // The worker thread requests the slot at its launch time
+        edrvInstance_l.aLaunchTime[edrvInstance_l.txHead] = launchTime;
+        edrvInstance_l.txWaitingCount++;
+    }
+    else
+        storeSlotStatus(pSlot, TP_STATUS_SEND_REQUEST);
+#else
+    storeSlotStatus(pSlot, TP_STATUS_SEND_REQUEST);
+#endif
+
+    edrvInstance_l.txHead = (edrvInstance_l.txHead + 1) % EDRV_TX_FRAME_COUNT;
+    edrvInstance_l.txPendingCount++;
+
+    // Flush while holding the mutex, so no slot with another launch time can
+    // be requested in the meantime and sent along with this one
+#if (EDRV_USE_TTTX != FALSE)
+    if (!fHoldBack)
+        flushTxRing(&edrvInstance_l, launchTime);
+#else
+    // Flush all requested slots of the TX ring with a single system call
+    if ((send(edrvInstance_l.sock, NULL, 0, MSG_DONTWAIT) < 0) &&
+        (errno != EAGAIN) && (errno != ENOBUFS))
+    {
+        DEBUG_LVL_EDRV_TRACE("%s() send failed (%s)\n", __func__, strerror(errno));
+    }
+#endif
+
+    pthread_mutex_unlock(&edrvInstance_l.mutex);
+
+    // The worker thread completes the slot as soon as the kernel has taken it
+    if (write(edrvInstance_l.wakeFd, &value, sizeof(value)) < 0)
+    {
+        DEBUG_LVL_EDRV_TRACE("%s() couldn't wake worker thread (%s)\n", __func__, strerror(errno));
+    }
+
+    return kErrorOk;
+}
+
+#if (EDRV_USE_TTTX != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Get current MAC time
+
+This function returns the current time of the clock which is used for the
+launch times of the frames (CLOCK_TAI).
+
+\param[out]     pCurtime_p          Pointer to store the current time [ns]
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_getMacTime(UINT64* pCurtime_p)
+{
+    // Check parameter validity
+    ASSERT(pCurtime_p != NULL);
+
+    *pCurtime_p = getTaiTime();
+
+    return kErrorOk;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate Tx buffer
+
+This function allocates a Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_allocTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    if (pBuffer_p->maxBufferSize > EDRV_MAX_FRAME_SIZE)
+        return kErrorEdrvNoFreeBufEntry;
+
+    // allocate buffer with malloc
+    pBuffer_p->pBuffer = (UINT8*)OPLK_MALLOC(pBuffer_p->maxBufferSize);
+    if (pBuffer_p->pBuffer == NULL)
+        return kErrorEdrvNoFreeBufEntry;
+
+    pBuffer_p->txBufferNumber.pArg = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free Tx buffer
+
+This function releases the Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_freeTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    UINT8* pBuffer;
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    pBuffer = pBuffer_p->pBuffer;
+
+    // mark buffer as free, before actually freeing it
+    pBuffer_p->pBuffer = NULL;
+
+    OPLK_FREE(pBuffer);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change Rx filter setup
+
+This function changes the Rx filter setup. The parameter entryChanged_p
+selects the Rx filter entry that shall be changed and \p changeFlags_p determines
+the property.
+If \p entryChanged_p is equal or larger count_p all Rx filters shall be changed.
+
+\note Rx filters are not supported by this driver!
+
+\param[in,out]  pFilter_p           Base pointer of Rx filter array
+\param[in]      count_p             Number of Rx filter array entries
+\param[in]      entryChanged_p      Index of Rx filter entry that shall be changed
+\param[in]      changeFlags_p       Bit mask that selects the changing Rx filter property
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
+                               UINT count_p,
+                               UINT entryChanged_p,
+                               UINT changeFlags_p)
+{
+    UNUSED_PARAMETER(pFilter_p);
+    UNUSED_PARAMETER(count_p);
+    UNUSED_PARAMETER(entryChanged_p);
+    UNUSED_PARAMETER(changeFlags_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear multicast address entry
+
+This function removes the multicast entry from the Ethernet controller.
+
+\note The multicast filters are not supported by this driver.
+
+\param[in]      pMacAddr_p          Multicast address
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_clearRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set multicast address entry
+
+This function sets a multicast entry into the Ethernet controller.
+
+\note The multicast filters are not supported by this driver.
+
+\param[in]      pMacAddr_p          Multicast address.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_setRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return kErrorOk;
+}
+
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+//------------------------------------------------------------------------------
+/**
+\brief  Release Rx buffer
+
+This function releases a late release Rx buffer. The RX ring slot holding the
+frame is returned to the kernel.
+
+\param[in,out]  pRxBuffer_p         Rx buffer to be released
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_releaseRxBuffer(tEdrvRxBuffer* pRxBuffer_p)
+{
+    size_t  offset;
+    UINT    index;
+
+    // Check parameter validity
+    ASSERT(pRxBuffer_p != NULL);
+
+    if ((edrvInstance_l.pRxRing == NULL) || (pRxBuffer_p->pBuffer < edrvInstance_l.pRxRing))
+        return kErrorEdrvInvalidRxBuf;
+
+    offset = (size_t)(pRxBuffer_p->pBuffer - edrvInstance_l.pRxRing);
+    index = (UINT)(offset / EDRV_RING_FRAME_SIZE);
+    if ((index >= EDRV_RX_FRAME_COUNT) ||
+        !__atomic_load_n(&edrvInstance_l.afRxSlotLent[index], __ATOMIC_ACQUIRE))
+        return kErrorEdrvInvalidRxBuf;
+
+    // The slot must be owned by the kernel before the worker thread may see it
+    // as not lent, otherwise it would process the old frame again
+    storeSlotStatus(getRingSlot(edrvInstance_l.pRxRing, index), TP_STATUS_KERNEL);
+    __atomic_store_n(&edrvInstance_l.afRxSlotLent[index], FALSE, __ATOMIC_RELEASE);
+
+    return kErrorOk;
+}
+#endif
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Edrv worker thread
+
+This function implements the edrv worker thread. It waits for received frames
+and processes the RX ring. After edrv_sendTxBuffer() woke it up, it completes
+the TX ring slots taken by the kernel. Slots which the kernel hasn't taken yet
+are checked again every EDRV_TX_RETRY_INTERVAL_NS. Frames held back in the TX
+ring are flushed at their launch times. The link status is polled every
+EDRV_LINK_POLL_INTERVAL_NS, so edrv_sendTxBuffer() doesn't need a system call
+to query it.
+
+\param[in,out]  pArgument_p         User specific pointer pointing to the instance structure
+
+\return The function returns a thread error code.
+*/
+//------------------------------------------------------------------------------
+static void* workerThread(void* pArgument_p)
+{
+    tEdrvInstance*          pInstance = (tEdrvInstance*)pArgument_p;
+    struct pollfd           aPollFd[2];
+    struct timespec         txRetryInterval;
+    struct timespec         linkPollInterval;
+    const struct timespec*  pTimeout;
+    UINT64                  nextLinkPoll;
+    UINT64                  now;
+    UINT64                  value;
+    UINT                    txRequestedCount;
+    int                     pollRet;
+#if (EDRV_USE_TTTX != FALSE)
+    struct timespec         launchWaitTime;
+    UINT64                  nextLaunchTime;
+    UINT64                  waitTime;
+#endif
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    struct epoll_event      event;
+#endif
+
+    DEBUG_LVL_EDRV_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
+
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    aPollFd[0].fd = pInstance->rxEpollFd;
+#else
+    aPollFd[0].fd = pInstance->sock;
+#endif
+    aPollFd[0].events = POLLIN;
+    aPollFd[1].fd = pInstance->wakeFd;
+    aPollFd[1].events = POLLIN;
+
+    txRetryInterval.tv_sec = (time_t)(EDRV_TX_RETRY_INTERVAL_NS / 1000000000ULL);
+    txRetryInterval.tv_nsec = (long)(EDRV_TX_RETRY_INTERVAL_NS % 1000000000ULL);
+    linkPollInterval.tv_sec = (time_t)(EDRV_LINK_POLL_INTERVAL_NS / 1000000000ULL);
+    linkPollInterval.tv_nsec = (long)(EDRV_LINK_POLL_INTERVAL_NS % 1000000000ULL);
+
+    // The link status must be valid before the first frame is sent
+    pInstance->fLinkUp = getLinkStatus(pInstance->sock, pInstance->initParam.hwParam.pDevName);
+    nextLinkPoll = getMonotonicTime() + EDRV_LINK_POLL_INTERVAL_NS;
+
+    // signal that thread is successfully started
+    sem_post(&pInstance->syncSem);
+
+    while (!pInstance->fStopThread)
+    {
+        now = getMonotonicTime();
+        if (now >= nextLinkPoll)
+        {
+            pInstance->fLinkUp = getLinkStatus(pInstance->sock, pInstance->initParam.hwParam.pDevName);
+            nextLinkPoll = now + EDRV_LINK_POLL_INTERVAL_NS;
+        }
+
+        // Frames may already be available, so process the rings before waiting
+        processRxRing(pInstance);
+#if (EDRV_USE_TTTX != FALSE)
+        nextLaunchTime = processTxLaunch(pInstance);
+#endif
+        txRequestedCount = processTxCompletion(pInstance);
+
+        // The kernel takes requested slots while they are flushed, so only
+        // slots it couldn't take yet need to be checked again
+        pTimeout = (txRequestedCount > 0) ? &txRetryInterval : &linkPollInterval;
+
+#if (EDRV_USE_TTTX != FALSE)
+        // Don't sleep beyond the launch time of the next waiting slot
+        if (nextLaunchTime != 0)
+        {
+            now = getTaiTime();
+            waitTime = (nextLaunchTime > now) ? (nextLaunchTime - now) : 0;
+            if ((txRequestedCount == 0) || (waitTime < EDRV_TX_RETRY_INTERVAL_NS))
+            {
+                launchWaitTime.tv_sec = (time_t)(waitTime / 1000000000ULL);
+                launchWaitTime.tv_nsec = (long)(waitTime % 1000000000ULL);
+                pTimeout = &launchWaitTime;
+            }
+        }
+#endif
+
+        pollRet = ppoll(aPollFd, 2, pTimeout, NULL);
+        if ((pollRet < 0) && (errno != EINTR))
+        {
+            DEBUG_LVL_ERROR_TRACE("%s(): poll failed (%s)\n", __func__, strerror(errno));
+            break;
+        }
+
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+        // Rearm the edge-triggered notification before the RX ring is processed
+        if ((pollRet > 0) && ((aPollFd[0].revents & POLLIN) != 0))
+            epoll_wait(pInstance->rxEpollFd, &event, 1, 0);
+#endif
+
+        if ((pollRet > 0) && ((aPollFd[1].revents & POLLIN) != 0))
+        {
+            if (read(pInstance->wakeFd, &value, sizeof(value)) < 0)
+            {
+                DEBUG_LVL_EDRV_TRACE("%s(): reading eventfd failed (%s)\n", __func__, strerror(errno));
+            }
+        }
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the RX ring
+
+This function forwards all frames available in the RX ring to the dllk and
+returns the slots to the kernel. Frames sent by the local host are filtered out.
+If the dllk releases a frame later, its slot is lent to the stack and returned
+to the kernel by edrv_releaseRxBuffer(). The ring isn't processed beyond a slot
+which is still lent.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void processRxRing(tEdrvInstance* pInstance_p)
+{
+    struct tpacket2_hdr*        pSlot;
+    const struct sockaddr_ll*   pAddr;
+    tEdrvRxBuffer               rxBuffer;
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    BOOL*                       pfLent;
+#endif
+
+    for (;;)
+    {
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+        // A lent slot still holds the old frame
+        pfLent = &pInstance_p->afRxSlotLent[pInstance_p->rxIndex];
+        if (__atomic_load_n(pfLent, __ATOMIC_ACQUIRE))
+            break;
+#endif
+
+        pSlot = getRingSlot(pInstance_p->pRxRing, pInstance_p->rxIndex);
+        if ((loadSlotStatus(pSlot) & TP_STATUS_USER) == 0)
+            break;
+
+        pAddr = (const struct sockaddr_ll*)((UINT8*)pSlot + EDRV_RING_DATA_OFFSET);
+        if (pAddr->sll_pkttype != PACKET_OUTGOING)
+        {
+            rxBuffer.bufferInFrame = kEdrvBufferLastInFrame;
+            rxBuffer.rxFrameSize = pSlot->tp_snaplen;
+            rxBuffer.pBuffer = (UINT8*)pSlot + pSlot->tp_mac;
+            rxBuffer.pRxTimeStamp = NULL;
+
+            FTRACE_MARKER("%s RX", __func__);
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+            // The slot is lent before the frame is passed on, because the
+            // stack may release it before the Rx handler returns
+            __atomic_store_n(pfLent, TRUE, __ATOMIC_RELAXED);
+            if (pInstance_p->initParam.pfnRxHandler(&rxBuffer) == kEdrvReleaseRxBufferLater)
+            {
+                pInstance_p->rxIndex = (pInstance_p->rxIndex + 1) % EDRV_RX_FRAME_COUNT;
+                continue;
+            }
+            __atomic_store_n(pfLent, FALSE, __ATOMIC_RELAXED);
+#else
+            pInstance_p->initParam.pfnRxHandler(&rxBuffer);
+#endif
+        }
+
+        storeSlotStatus(pSlot, TP_STATUS_KERNEL);
+        pInstance_p->rxIndex = (pInstance_p->rxIndex + 1) % EDRV_RX_FRAME_COUNT;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process completed TX ring slots
+
+This function calls the Tx handlers of all frames whose TX ring slots have been
+taken by the kernel. The kernel copies the frame out of the slot or keeps the
+slot busy (TP_STATUS_SENDING) until the frame is sent, so the Tx buffer can be
+reused at once. edrv_sendTxBuffer() only reuses the slot after the kernel
+released it. The slots are completed in the order they were sent.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+
+\return The function returns the number of requested TX ring slots which the
+        kernel hasn't taken yet.
+*/
+//------------------------------------------------------------------------------
+static UINT processTxCompletion(tEdrvInstance* pInstance_p)
+{
+    struct tpacket2_hdr*    pSlot;
+    tEdrvTxBuffer*          pTxBuffer;
+    UINT32                  status;
+    UINT                    requestedCount;
+
+    pthread_mutex_lock(&pInstance_p->mutex);
+    for (;;)
+    {
+#if (EDRV_USE_TTTX != FALSE)
+        // Slots waiting for their launch time haven't been requested yet
+        requestedCount = pInstance_p->txPendingCount - pInstance_p->txWaitingCount;
+#else
+        requestedCount = pInstance_p->txPendingCount;
+#endif
+        if (requestedCount == 0)
+            break;
+
+        pSlot = getRingSlot(pInstance_p->pTxRing, pInstance_p->txTail);
+        status = loadSlotStatus(pSlot);
+        if ((status & TP_STATUS_SEND_REQUEST) != 0)
+            break;
+
+        if ((status & TP_STATUS_WRONG_FORMAT) != 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s(): frame in TX slot %u was dropped\n", __func__, pInstance_p->txTail);
+            storeSlotStatus(pSlot, TP_STATUS_AVAILABLE);
+        }
+
+        pTxBuffer = pInstance_p->apTxBuffer[pInstance_p->txTail];
+        pInstance_p->apTxBuffer[pInstance_p->txTail] = NULL;
+        pInstance_p->txTail = (pInstance_p->txTail + 1) % EDRV_TX_FRAME_COUNT;
+        pInstance_p->txPendingCount--;
+        pthread_mutex_unlock(&pInstance_p->mutex);
+
+        FTRACE_MARKER("%s TX-complete", __func__);
+        pTxBuffer->txBufferNumber.pArg = NULL;
+        if (pTxBuffer->pfnTxHandler != NULL)
+        {
+            pTxBuffer->pfnTxHandler(pTxBuffer);
+        }
+
+        pthread_mutex_lock(&pInstance_p->mutex);
+    }
+    pthread_mutex_unlock(&pInstance_p->mutex);
+
+    return requestedCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open the packet socket
+
+This function opens the packet socket, sets up and maps the RX and TX rings and
+binds the socket to the Ethernet interface in promiscuous mode.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError openSocket(tEdrvInstance* pInstance_p)
+{
+    struct tpacket_req  req;
+    struct sockaddr_ll  addr;
+    struct packet_mreq  mreq;
+    int                 version = TPACKET_V2;
+    int                 option = 1;
+    int                 ifIndex;
+
+    ifIndex = (int)if_nametoindex(pInstance_p->initParam.hwParam.pDevName);
+    if (ifIndex == 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() unknown interface %s\n",
+                              __func__, pInstance_p->initParam.hwParam.pDevName);
+        return kErrorEdrvInit;
+    }
+
+    pInstance_p->sock = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (pInstance_p->sock < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't open packet socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set TPACKET_V2 (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+#if (EDRV_USE_TTTX != FALSE)
+    pInstance_p->fQdiscLaunchTime = FALSE;
+#if defined(SO_TXTIME)
+    if (isLaunchTimeQdiscInstalled(ifIndex))
+    {
+        struct sock_txtime  txTime;
+
+        OPLK_MEMSET(&txTime, 0, sizeof(txTime));
+        txTime.clockid = CLOCK_TAI;
+        if (setsockopt(pInstance_p->sock, SOL_SOCKET, SO_TXTIME, &txTime, sizeof(txTime)) == 0)
+        {
+            pInstance_p->fQdiscLaunchTime = TRUE;
+        }
+        else
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() couldn't set SO_TXTIME (%s)\n", __func__, strerror(errno));
+        }
+    }
+#endif
+    DEBUG_LVL_ALWAYS_TRACE("%s() launch times are enforced by %s\n", __func__,
+                           (pInstance_p->fQdiscLaunchTime) ? "the queuing discipline" : "software");
+#endif
+
+#ifdef PACKET_QDISC_BYPASS
+#if (EDRV_USE_TTTX != FALSE)
+    // The launch time queuing discipline must not be bypassed
+    if (!pInstance_p->fQdiscLaunchTime)
+#endif
+    {
+        // Hand frames directly to the driver, this also skips the loopback to other packet sockets
+        if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_QDISC_BYPASS, &option, sizeof(option)) < 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() couldn't set qdisc bypass (%s)\n", __func__, strerror(errno));
+        }
+    }
+#endif
+
+    // Drop malformed frames instead of blocking the TX ring
+    if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_LOSS, &option, sizeof(option)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set packet loss (%s)\n", __func__, strerror(errno));
+    }
+
+    OPLK_MEMSET(&req, 0, sizeof(req));
+    req.tp_block_size = EDRV_RING_BLOCK_SIZE;
+    req.tp_frame_size = EDRV_RING_FRAME_SIZE;
+    req.tp_block_nr = (EDRV_RX_FRAME_COUNT * EDRV_RING_FRAME_SIZE) / EDRV_RING_BLOCK_SIZE;
+    req.tp_frame_nr = EDRV_RX_FRAME_COUNT;
+    if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set up RX ring (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    req.tp_block_nr = (EDRV_TX_FRAME_COUNT * EDRV_RING_FRAME_SIZE) / EDRV_RING_BLOCK_SIZE;
+    req.tp_frame_nr = EDRV_TX_FRAME_COUNT;
+    if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set up TX ring (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    // The RX ring is followed by the TX ring in the mapped memory
+    pInstance_p->ringSize = (size_t)(EDRV_RX_FRAME_COUNT + EDRV_TX_FRAME_COUNT) * EDRV_RING_FRAME_SIZE;
+    pInstance_p->pRing = (UINT8*)mmap(NULL, pInstance_p->ringSize, PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_LOCKED, pInstance_p->sock, 0);
+    if (pInstance_p->pRing == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't map rings (%s)\n", __func__, strerror(errno));
+        pInstance_p->pRing = NULL;
+        return kErrorEdrvInit;
+    }
+    pInstance_p->pRxRing = pInstance_p->pRing;
+    pInstance_p->pTxRing = pInstance_p->pRing + ((size_t)EDRV_RX_FRAME_COUNT * EDRV_RING_FRAME_SIZE);
+
+    OPLK_MEMSET(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = ifIndex;
+    if (bind(pInstance_p->sock, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't bind socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    OPLK_MEMSET(&mreq, 0, sizeof(mreq));
+    mreq.mr_ifindex = ifIndex;
+    mreq.mr_type = PACKET_MR_PROMISC;
+    if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set promiscuous mode (%s)\n", __func__, strerror(errno));
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close the packet socket
+
+This function unmaps the rings and closes the packet socket and the event file
+descriptor.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void closeSocket(tEdrvInstance* pInstance_p)
+{
+    if (pInstance_p->pRing != NULL)
+    {
+        munmap(pInstance_p->pRing, pInstance_p->ringSize);
+        pInstance_p->pRing = NULL;
+    }
+
+    if (pInstance_p->sock >= 0)
+    {
+        close(pInstance_p->sock);
+        pInstance_p->sock = -1;
+    }
+
+    if (pInstance_p->wakeFd >= 0)
+    {
+        close(pInstance_p->wakeFd);
+        pInstance_p->wakeFd = -1;
+    }
+
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+    if (pInstance_p->rxEpollFd >= 0)
+    {
+        close(pInstance_p->rxEpollFd);
+        pInstance_p->rxEpollFd = -1;
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get ring slot
+
+This function returns the header of a slot in a mapped ring.
+
+\param[in]      pRing_p             Start of the ring
+\param[in]      index_p             Index of the slot
+
+\return The function returns a pointer to the slot header.
+*/
+//------------------------------------------------------------------------------
+static struct tpacket2_hdr* getRingSlot(UINT8* pRing_p, UINT index_p)
+{
+    return (struct tpacket2_hdr*)(pRing_p + ((size_t)index_p * EDRV_RING_FRAME_SIZE));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load slot status
+
+This function reads the status of a ring slot, which is shared with the kernel.
+The slot contents written by the kernel are visible after the status is read.
+
+\param[in]      pSlot_p             Pointer to the slot header
+
+\return The function returns the slot status.
+*/
+//------------------------------------------------------------------------------
+static UINT32 loadSlotStatus(const struct tpacket2_hdr* pSlot_p)
+{
+    return __atomic_load_n(&pSlot_p->tp_status, __ATOMIC_ACQUIRE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store slot status
+
+This function hands a ring slot over to the kernel by writing its status. The
+slot contents are visible to the kernel before the status is written.
+
+\param[in,out]  pSlot_p             Pointer to the slot header
+\param[in]      status_p            New slot status
+*/
+//------------------------------------------------------------------------------
+static void storeSlotStatus(struct tpacket2_hdr* pSlot_p, UINT32 status_p)
+{
+    __atomic_store_n(&pSlot_p->tp_status, status_p, __ATOMIC_RELEASE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get Edrv MAC address
+
+This function gets the interface's MAC address.
+
+\param[in]      pIfName_p           Ethernet interface device name
+\param[out]     pMacAddr_p          Pointer to store MAC address
+*/
+//------------------------------------------------------------------------------
+static void getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p)
+{
+    INT             fd;
+    struct ifreq    ifr;
+
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    ifr.ifr_addr.sa_family = AF_INET;
+    strncpy(ifr.ifr_name, pIfName_p, IFNAMSIZ - 1);
+
+    ioctl(fd, SIOCGIFHWADDR, &ifr);
+
+    close(fd);
+
+    OPLK_MEMCPY(pMacAddr_p, ifr.ifr_hwaddr.sa_data, 6);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get link status
+
+This function returns the interface link status.
+
+\param[in]      sock_p              Socket used for querying the interface flags
+\param[in]      pIfName_p           Ethernet interface device name
+
+\return The function returns the link status.
+\retval TRUE    The link is up.
+\retval FALSE   The link is down.
+*/
+//------------------------------------------------------------------------------
+static BOOL getLinkStatus(int sock_p, const char* pIfName_p)
+{
+    struct ifreq    ethreq;
+
+    OPLK_MEMSET(&ethreq, 0, sizeof(ethreq));
+
+    /* set the name of the interface we wish to check */
+    strncpy(ethreq.ifr_name, pIfName_p, IFNAMSIZ - 1);
+
+    /* grab flags associated with this interface */
+    if (ioctl(sock_p, SIOCGIFFLAGS, &ethreq) < 0)
+        return FALSE;
+
+    return ((ethreq.ifr_flags & IFF_RUNNING) != 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+This function returns the current time of the monotonic clock.
+
+\return The function returns the current monotonic time [ns].
+*/
+//------------------------------------------------------------------------------
+static UINT64 getMonotonicTime(void)
+{
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+
+#if (EDRV_USE_TTTX != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Flush the TX ring
+
+This function flushes all requested slots of the TX ring with a single system
+call. If the launch times are enforced by the queuing discipline, the launch
+time is passed as SCM_TXTIME control message. The caller must hold the
+instance mutex, so the flush only covers the slots it has requested.
+
+\param[in]      pInstance_p         Pointer to the instance structure
+\param[in]      launchTime_p        Launch time of the frames [ns] (0 = none)
+*/
+//------------------------------------------------------------------------------
+static void flushTxRing(const tEdrvInstance* pInstance_p, UINT64 launchTime_p)
+{
+    struct msghdr   msg;
+    ssize_t         ret;
+#if defined(SCM_TXTIME)
+    union
+    {
+        struct cmsghdr  align;
+        UINT8           aBuffer[CMSG_SPACE(sizeof(UINT64))];
+    } control;
+    struct cmsghdr* pCmsg;
+#endif
+
+    OPLK_MEMSET(&msg, 0, sizeof(msg));
+
+#if defined(SCM_TXTIME)
+    if (pInstance_p->fQdiscLaunchTime && (launchTime_p != 0))
+    {
+        OPLK_MEMSET(&control, 0, sizeof(control));
+        msg.msg_control = control.aBuffer;
+        msg.msg_controllen = sizeof(control.aBuffer);
+
+        pCmsg = CMSG_FIRSTHDR(&msg);
+        pCmsg->cmsg_level = SOL_SOCKET;
+        pCmsg->cmsg_type = SCM_TXTIME;
+        pCmsg->cmsg_len = CMSG_LEN(sizeof(UINT64));
+        OPLK_MEMCPY(CMSG_DATA(pCmsg), &launchTime_p, sizeof(UINT64));
+    }
+#else
+    UNUSED_PARAMETER(launchTime_p);
+#endif
+
+    ret = sendmsg(pInstance_p->sock, &msg, MSG_DONTWAIT);
+    if ((ret < 0) && (errno != EAGAIN) && (errno != ENOBUFS))
+    {
+        DEBUG_LVL_EDRV_TRACE("%s() send failed (%s)\n", __func__, strerror(errno));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process TX ring slots waiting for their launch time
+
+This function requests all held back TX ring slots whose launch time has been
+reached and flushes them to the network device. Frames which missed their
+launch time are sent immediately.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+
+\return The function returns the launch time of the next waiting slot, or 0 if
+        no slot is waiting.
+*/
+//------------------------------------------------------------------------------
+static UINT64 processTxLaunch(tEdrvInstance* pInstance_p)
+{
+    UINT    index;
+    UINT64  now;
+    UINT64  nextLaunchTime = 0;
+    BOOL    fFlush = FALSE;
+
+    pthread_mutex_lock(&pInstance_p->mutex);
+    now = getTaiTime();
+    while (pInstance_p->txWaitingCount > 0)
+    {
+        index = (pInstance_p->txHead + EDRV_TX_FRAME_COUNT - pInstance_p->txWaitingCount) % EDRV_TX_FRAME_COUNT;
+        if (pInstance_p->aLaunchTime[index] > now)
+        {
+            nextLaunchTime = pInstance_p->aLaunchTime[index];
+            break;
+        }
+
+        storeSlotStatus(getRingSlot(pInstance_p->pTxRing, index), TP_STATUS_SEND_REQUEST);
+        pInstance_p->txWaitingCount--;
+        fFlush = TRUE;
+    }
+
+    // Slots are only held back if the queuing discipline doesn't enforce
+    // launch times, so no launch time is passed
+    if (fFlush)
+    {
+        FTRACE_MARKER("%s TX-launch", __func__);
+        flushTxRing(pInstance_p, 0);
+    }
+    pthread_mutex_unlock(&pInstance_p->mutex);
+
+    return nextLaunchTime;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check for a launch time queuing discipline
+
+This function queries the queuing disciplines of the network device over a
+netlink socket. The launch times can be passed to the kernel if an ETF or
+taprio queuing discipline is installed.
+
+\param[in]      ifIndex_p           Index of the network device
+
+\return The function returns TRUE if a launch time queuing discipline is
+        installed, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL isLaunchTimeQdiscInstalled(int ifIndex_p)
+{
+    struct
+    {
+        struct nlmsghdr     header;
+        struct tcmsg        tcm;
+    } request;
+    UINT8*                  pBuffer;
+    const struct nlmsghdr*  pMsg;
+    const struct tcmsg*     pTcm;
+    const struct rtattr*    pAttr;
+    ssize_t                 len;
+    int                     attrLen;
+    int                     fd;
+    BOOL                    fDone = FALSE;
+    BOOL                    fFound = FALSE;
+
+    fd = socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+    if (fd < 0)
+        return FALSE;
+
+    pBuffer = (UINT8*)OPLK_MALLOC(EDRV_NETLINK_BUFFER_SIZE);
+    if (pBuffer == NULL)
+        goto Exit;
+
+    OPLK_MEMSET(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct tcmsg));
+    request.header.nlmsg_type = RTM_GETQDISC;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.tcm.tcm_family = AF_UNSPEC;
+    request.tcm.tcm_ifindex = ifIndex_p;
+    if (send(fd, &request, request.header.nlmsg_len, 0) < 0)
+        goto Exit;
+
+    while (!fDone)
+    {
+        len = recv(fd, pBuffer, EDRV_NETLINK_BUFFER_SIZE, 0);
+        if (len <= 0)
+            break;
+
+        for (pMsg = (const struct nlmsghdr*)pBuffer;
+             NLMSG_OK(pMsg, len);
+             pMsg = NLMSG_NEXT(pMsg, len))
+        {
+            if ((pMsg->nlmsg_type == NLMSG_DONE) || (pMsg->nlmsg_type == NLMSG_ERROR))
+            {
+                fDone = TRUE;
+                break;
+            }
+
+            pTcm = (const struct tcmsg*)NLMSG_DATA(pMsg);
+            if ((pMsg->nlmsg_type != RTM_NEWQDISC) || (pTcm->tcm_ifindex != ifIndex_p))
+                continue;
+
+            attrLen = (int)(pMsg->nlmsg_len - NLMSG_LENGTH(sizeof(struct tcmsg)));
+            for (pAttr = (const struct rtattr*)((const UINT8*)pTcm + NLMSG_ALIGN(sizeof(struct tcmsg)));
+                 RTA_OK(pAttr, attrLen);
+                 pAttr = RTA_NEXT(pAttr, attrLen))
+            {
+                if ((pAttr->rta_type == TCA_KIND) &&
+                    ((strcmp((const char*)RTA_DATA(pAttr), "etf") == 0) ||
+                     (strcmp((const char*)RTA_DATA(pAttr), "taprio") == 0)))
+                {
+                    fFound = TRUE;
+                }
+            }
+        }
+    }
+
+Exit:
+    if (pBuffer != NULL)
+        OPLK_FREE(pBuffer);
+    close(fd);
+
+    return fFound;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get TAI time
+
+This function returns the current time of the clock used for the launch times.
+
+\return The function returns the current TAI time [ns].
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTaiTime(void)
+{
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_TAI, &curTime);
+
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+#endif
+
+/// \}
@@ -0,0 +1,1311 @@
+/**
+********************************************************************************
+\file   edrv-xdp_linux.c
+
+\brief  Implementation of Linux AF_XDP Ethernet driver
+
+This file contains the implementation of the Linux AF_XDP Ethernet driver.
+Frames are exchanged with the network device through an XDP socket and a
+userspace frame area (UMEM) shared with the kernel. A minimal XDP program
+redirects all frames received on the configured queue of the interface to the
+socket. The program is attached in native driver mode if supported by the
+network device, otherwise the generic XDP path is used (e.g. for veth pairs).
+
+In busy-poll mode the worker thread is bound to a dedicated CPU core and polls
+the rings without sleeping. Otherwise it waits for received frames and polls
+for TX completion only while frames are pending.
+
+The driver requires Linux 5.9 or newer and the capabilities CAP_NET_ADMIN and
+CAP_BPF (or CAP_SYS_ADMIN).
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/ftracedebug.h>
+#include <kernel/edrv.h>
+
+#include <stddef.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <net/if.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <linux/bpf.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef CONFIG_EDRV_XDP_QUEUE_ID
+#define CONFIG_EDRV_XDP_QUEUE_ID        0                   // Queue of the network device used by the driver
+#endif
+
+#ifndef CONFIG_EDRV_XDP_BUSY_POLL
+#define CONFIG_EDRV_XDP_BUSY_POLL       FALSE               // Poll the rings without sleeping
+#endif
+
+#ifndef CONFIG_EDRV_XDP_BUSY_POLL_CPU
+#define CONFIG_EDRV_XDP_BUSY_POLL_CPU   1                   // CPU core of the busy-polling worker thread
+#endif
+
+#ifndef AF_XDP
+#define AF_XDP                          44
+#endif
+
+#ifndef SOL_XDP
+#define SOL_XDP                         283
+#endif
+
+#define EDRV_MAX_FRAME_SIZE             0x0600
+
+#define EDRV_XDP_FRAME_SIZE             2048                // Size of a UMEM frame
+#define EDRV_XDP_RX_FRAME_COUNT         256                 // Number of UMEM frames for reception
+#define EDRV_XDP_TX_FRAME_COUNT         256                 // Number of UMEM frames for transmission
+#define EDRV_XDP_FRAME_COUNT            (EDRV_XDP_RX_FRAME_COUNT + EDRV_XDP_TX_FRAME_COUNT)
+#define EDRV_XDP_RING_SIZE              256                 // Number of entries of each ring (power of 2)
+#define EDRV_XDP_MAP_SIZE               64                  // Number of entries of the XSK map
+
+#define EDRV_TX_POLL_INTERVAL_NS        10000               // Polling interval for TX completion [ns]
+#define EDRV_BUSY_POLL_TIMEOUT_US       20                  // Busy-poll time of the network device [us]
+#define EDRV_BUSY_POLL_BUDGET           64                  // Busy-poll budget of the network device
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Structure describing a ring shared with the kernel
+
+This structure describes one of the rings of an XDP socket or its UMEM.
+*/
+typedef struct
+{
+    UINT32*             pProducer;                              ///< Producer index
+    UINT32*             pConsumer;                              ///< Consumer index
+    UINT32*             pFlags;                                 ///< Ring flags
+    void*               pEntries;                               ///< Ring entries
+    void*               pMap;                                   ///< Mapped memory of the ring
+    size_t              mapSize;                                ///< Size of the mapped memory
+} tXdpRing;
+
+/**
+\brief Structure describing an instance of the Edrv
+
+This structure describes an instance of the Ethernet driver.
+*/
+typedef struct
+{
+    tEdrvInitParam      initParam;                              ///< Init parameters
+    int                 xsk;                                    ///< XDP socket
+    int                 ioctlSock;                              ///< Socket for interface requests
+    int                 wakeFd;                                 ///< Event file descriptor to wake up the worker thread
+    int                 mapFd;                                  ///< XSK map of the XDP program
+    int                 progFd;                                 ///< XDP program
+    int                 linkFd;                                 ///< Link attaching the XDP program to the interface
+    int                 ifIndex;                                ///< Index of the network interface
+    BOOL                fPromiscSet;                            ///< Promiscuous mode was enabled by the driver
+    UINT8*              pUmem;                                  ///< Frame area shared with the kernel
+    tXdpRing            rxRing;                                 ///< RX ring
+    tXdpRing            txRing;                                 ///< TX ring
+    tXdpRing            fillRing;                               ///< Fill ring of the UMEM
+    tXdpRing            compRing;                               ///< Completion ring of the UMEM
+    UINT                aTxFreeFrame[EDRV_XDP_TX_FRAME_COUNT];  ///< Stack of free TX frames
+    UINT                txFreeCount;                            ///< Number of free TX frames
+    UINT                txPendingCount;                         ///< Number of TX frames waiting for completion
+    tEdrvTxBuffer*      apTxBuffer[EDRV_XDP_TX_FRAME_COUNT];    ///< TX buffers of the pending TX frames
+    pthread_mutex_t     mutex;                                  ///< Mutex for locking of critical sections
+    sem_t               syncSem;                                ///< Semaphore for signaling the start of the worker thread
+    pthread_t           hThread;                                ///< Handle of the worker thread
+    volatile BOOL       fStopThread;                            ///< Flag to stop the worker thread
+} tEdrvInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEdrvInstance edrvInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void*        workerThread(void* pArgument_p);
+static void         processRxRing(tEdrvInstance* pInstance_p);
+static void         processTxCompletion(tEdrvInstance* pInstance_p);
+static void         fillRxFrames(tEdrvInstance* pInstance_p, const UINT64* pAddr_p, UINT count_p);
+static void         kickTx(tEdrvInstance* pInstance_p);
+static tOplkError   openSocket(tEdrvInstance* pInstance_p);
+static tOplkError   mapRing(int sock_p, UINT64 pageOffset_p, const struct xdp_ring_offset* pOffset_p,
+                            size_t entrySize_p, tXdpRing* pRing_p);
+static tOplkError   attachProgram(tEdrvInstance* pInstance_p, UINT32* pXdpFlags_p);
+static void         closeSocket(tEdrvInstance* pInstance_p);
+static int          bpfSyscall(int cmd_p, union bpf_attr* pAttr_p);
+static void         setPromiscuousMode(tEdrvInstance* pInstance_p, BOOL fEnable_p);
+static void         getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p);
+static BOOL         getLinkStatus(int sock_p, const char* pIfName_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Ethernet driver initialization
+
+This function initializes the Ethernet driver.
+
+\param[in]      pEdrvInitParam_p    Edrv initialization parameters
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
+{
+    struct sched_param  schedParam;
+    tOplkError          ret;
+#if (CONFIG_EDRV_XDP_BUSY_POLL != FALSE)
+    cpu_set_t           cpuSet;
+#endif
+
+    // Check parameter validity
+    ASSERT(pEdrvInitParam_p != NULL);
+
+    // clear instance structure
+    OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+    edrvInstance_l.xsk = -1;
+    edrvInstance_l.ioctlSock = -1;
+    edrvInstance_l.wakeFd = -1;
+    edrvInstance_l.mapFd = -1;
+    edrvInstance_l.progFd = -1;
+    edrvInstance_l.linkFd = -1;
+
+    if (pEdrvInitParam_p->hwParam.pDevName == NULL)
+        return kErrorEdrvInit;
+
+    // save the init data
+    edrvInstance_l.initParam = *pEdrvInitParam_p;
+
+    /* if no MAC address was specified read MAC address of used
+     * Ethernet interface
+     */
+    if ((edrvInstance_l.initParam.aMacAddr[0] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[1] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[2] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[3] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[4] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[5] == 0))
+    {   // read MAC address from controller
+        getMacAdrs(edrvInstance_l.initParam.hwParam.pDevName,
+                   edrvInstance_l.initParam.aMacAddr);
+    }
+
+    ret = openSocket(&edrvInstance_l);
+    if (ret != kErrorOk)
+    {
+        closeSocket(&edrvInstance_l);
+        return ret;
+    }
+
+    if (pthread_mutex_init(&edrvInstance_l.mutex, NULL) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't init mutex\n", __func__);
+        closeSocket(&edrvInstance_l);
+        return kErrorEdrvInit;
+    }
+
+    if (sem_init(&edrvInstance_l.syncSem, 0, 0) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't init semaphore\n", __func__);
+        closeSocket(&edrvInstance_l);
+        return kErrorEdrvInit;
+    }
+
+    if (pthread_create(&edrvInstance_l.hThread, NULL,
+                       workerThread,  &edrvInstance_l) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't create worker thread!\n", __func__);
+        closeSocket(&edrvInstance_l);
+        return kErrorEdrvInit;
+    }
+
+#if (CONFIG_EDRV_XDP_BUSY_POLL != FALSE)
+    CPU_ZERO(&cpuSet);
+    CPU_SET(CONFIG_EDRV_XDP_BUSY_POLL_CPU, &cpuSet);
+    if (pthread_setaffinity_np(edrvInstance_l.hThread, sizeof(cpuSet), &cpuSet) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't bind worker thread to CPU %d!\n",
+                              __func__, CONFIG_EDRV_XDP_BUSY_POLL_CPU);
+    }
+#endif
+
+    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_MEDIUM;
+    if (pthread_setschedparam(edrvInstance_l.hThread, SCHED_FIFO, &schedParam) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
+    }
+
+#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
+    pthread_setname_np(edrvInstance_l.hThread, "oplk-edrvxdp");
+#endif
+
+    /* wait until thread is started */
+    sem_wait(&edrvInstance_l.syncSem);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down Ethernet driver
+
+This function shuts down the Ethernet driver.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_exit(void)
+{
+    UINT64  value = 1;
+
+    // Stop the worker thread and wait for it to terminate
+    edrvInstance_l.fStopThread = TRUE;
+    if (write(edrvInstance_l.wakeFd, &value, sizeof(value)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't wake worker thread (%s)\n", __func__, strerror(errno));
+    }
+    pthread_join(edrvInstance_l.hThread, NULL);
+
+    // Detach the XDP program, close the socket and release the UMEM
+    closeSocket(&edrvInstance_l);
+
+    // Destroy the mutex
+    pthread_mutex_destroy(&edrvInstance_l.mutex);
+    sem_destroy(&edrvInstance_l.syncSem);
+
+    // Clear instance structure
+    OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get MAC address
+
+This function returns the MAC address of the Ethernet controller
+
+\return The function returns a pointer to the MAC address.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+const UINT8* edrv_getMacAddr(void)
+{
+    return edrvInstance_l.initParam.aMacAddr;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send Tx buffer
+
+This function sends the Tx buffer. The frame is copied into a free UMEM frame
+which is queued to the TX ring. The Tx handler is called by the worker thread
+as soon as the frame is returned in the completion ring.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    struct xdp_desc*    pDesc;
+    UINT32              producer;
+    UINT                frame;
+    BOOL                fWakeWorker;
+    UINT64              value = 1;
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    FTRACE_MARKER("%s", __func__);
+
+    if (pBuffer_p->txBufferNumber.pArg != NULL)
+        return kErrorInvalidOperation;
+
+    if (getLinkStatus(edrvInstance_l.ioctlSock, edrvInstance_l.initParam.hwParam.pDevName) == FALSE)
+    {
+        /* there's no link! We pretend that packet is sent and immediately call
+         * tx handler! Otherwise the stack would hang! */
+        if (pBuffer_p->pfnTxHandler != NULL)
+        {
+            pBuffer_p->pfnTxHandler(pBuffer_p);
+        }
+        return kErrorOk;
+    }
+
+    pthread_mutex_lock(&edrvInstance_l.mutex);
+
+    // The TX ring has as many entries as TX frames, so it can't overflow
+    if (edrvInstance_l.txFreeCount == 0)
+    {
+        pthread_mutex_unlock(&edrvInstance_l.mutex);
+        DEBUG_LVL_EDRV_TRACE("%s() no free TX frame\n", __func__);
+        return kErrorEdrvNoFreeTxDesc;
+    }
+
+    frame = edrvInstance_l.aTxFreeFrame[--edrvInstance_l.txFreeCount];
+    OPLK_MEMCPY(edrvInstance_l.pUmem + ((size_t)frame * EDRV_XDP_FRAME_SIZE),
+                pBuffer_p->pBuffer, pBuffer_p->txFrameSize);
+
+    // Mark the buffer as pending until the frame is completed
+    pBuffer_p->txBufferNumber.pArg = &edrvInstance_l;
+    edrvInstance_l.apTxBuffer[frame - EDRV_XDP_RX_FRAME_COUNT] = pBuffer_p;
+
+    producer = *edrvInstance_l.txRing.pProducer;
+    pDesc = &((struct xdp_desc*)edrvInstance_l.txRing.pEntries)[producer & (EDRV_XDP_RING_SIZE - 1)];
+    pDesc->addr = (UINT64)frame * EDRV_XDP_FRAME_SIZE;
+    pDesc->len = pBuffer_p->txFrameSize;
+    pDesc->options = 0;
+    __atomic_store_n(edrvInstance_l.txRing.pProducer, producer + 1, __ATOMIC_RELEASE);
+
+    fWakeWorker = (edrvInstance_l.txPendingCount == 0);
+    edrvInstance_l.txPendingCount++;
+
+    pthread_mutex_unlock(&edrvInstance_l.mutex);
+
+    kickTx(&edrvInstance_l);
+
+#if (CONFIG_EDRV_XDP_BUSY_POLL == FALSE)
+    // The worker thread only polls for TX completion while frames are pending
+    if (fWakeWorker && (write(edrvInstance_l.wakeFd, &value, sizeof(value)) < 0))
+    {
+        DEBUG_LVL_EDRV_TRACE("%s() couldn't wake worker thread (%s)\n", __func__, strerror(errno));
+    }
+#else
+    UNUSED_PARAMETER(fWakeWorker);
+    UNUSED_PARAMETER(value);
+#endif
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate Tx buffer
+
+This function allocates a Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_allocTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    if (pBuffer_p->maxBufferSize > EDRV_MAX_FRAME_SIZE)
+        return kErrorEdrvNoFreeBufEntry;
+
+    // allocate buffer with malloc
+    pBuffer_p->pBuffer = (UINT8*)OPLK_MALLOC(pBuffer_p->maxBufferSize);
+    if (pBuffer_p->pBuffer == NULL)
+        return kErrorEdrvNoFreeBufEntry;
+
+    pBuffer_p->txBufferNumber.pArg = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free Tx buffer
+
+This function releases the Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_freeTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    UINT8* pBuffer;
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    pBuffer = pBuffer_p->pBuffer;
+
+    // mark buffer as free, before actually freeing it
+    pBuffer_p->pBuffer = NULL;
+
+    OPLK_FREE(pBuffer);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change Rx filter setup
+
+This function changes the Rx filter setup. The parameter entryChanged_p
+selects the Rx filter entry that shall be changed and \p changeFlags_p determines
+the property.
+If \p entryChanged_p is equal or larger count_p all Rx filters shall be changed.
+
+\note Rx filters are not supported by this driver!
+
+\param[in,out]  pFilter_p           Base pointer of Rx filter array
+\param[in]      count_p             Number of Rx filter array entries
+\param[in]      entryChanged_p      Index of Rx filter entry that shall be changed
+\param[in]      changeFlags_p       Bit mask that selects the changing Rx filter property
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
+                               UINT count_p,
+                               UINT entryChanged_p,
+                               UINT changeFlags_p)
+{
+    UNUSED_PARAMETER(pFilter_p);
+    UNUSED_PARAMETER(count_p);
+    UNUSED_PARAMETER(entryChanged_p);
+    UNUSED_PARAMETER(changeFlags_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear multicast address entry
+
+This function removes the multicast entry from the Ethernet controller.
+
+\note The multicast filters are not supported by this driver.
+
+\param[in]      pMacAddr_p          Multicast address
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_clearRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set multicast address entry
+
+This function sets a multicast entry into the Ethernet controller.
+
+\note The multicast filters are not supported by this driver.
+
+\param[in]      pMacAddr_p          Multicast address.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_setRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return kErrorOk;
+}
+
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+//------------------------------------------------------------------------------
+/**
+\brief  Release Rx buffer
+
+This function releases a late release Rx buffer. The UMEM frame holding the
+frame is returned to the kernel through the fill ring.
+
+\param[in,out]  pRxBuffer_p         Rx buffer to be released
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_releaseRxBuffer(tEdrvRxBuffer* pRxBuffer_p)
+{
+    UINT64  addr;
+
+    // Check parameter validity
+    ASSERT(pRxBuffer_p != NULL);
+
+    if ((edrvInstance_l.pUmem == NULL) || (pRxBuffer_p->pBuffer < edrvInstance_l.pUmem))
+        return kErrorEdrvInvalidRxBuf;
+
+    addr = (UINT64)(pRxBuffer_p->pBuffer - edrvInstance_l.pUmem);
+    if (addr >= ((UINT64)EDRV_XDP_RX_FRAME_COUNT * EDRV_XDP_FRAME_SIZE))
+        return kErrorEdrvInvalidRxBuf;
+
+    fillRxFrames(&edrvInstance_l, &addr, 1);
+
+    return kErrorOk;
+}
+#endif
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Edrv worker thread
+
+This function implements the edrv worker thread. It processes the RX ring and
+the completion ring. In busy-poll mode it polls the rings continuously,
+otherwise it waits for received frames and polls in short intervals only while
+TX frames are pending.
+
+\param[in,out]  pArgument_p         User specific pointer pointing to the instance structure
+
+\return The function returns a thread error code.
+*/
+//------------------------------------------------------------------------------
+static void* workerThread(void* pArgument_p)
+{
+    tEdrvInstance*  pInstance = (tEdrvInstance*)pArgument_p;
+#if (CONFIG_EDRV_XDP_BUSY_POLL == FALSE)
+    struct pollfd   aPollFd[2];
+    struct timespec txPollInterval;
+    UINT64          value;
+    int             pollRet;
+#endif
+
+    DEBUG_LVL_EDRV_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
+
+#if (CONFIG_EDRV_XDP_BUSY_POLL == FALSE)
+    aPollFd[0].fd = pInstance->xsk;
+    aPollFd[0].events = POLLIN;
+    aPollFd[1].fd = pInstance->wakeFd;
+    aPollFd[1].events = POLLIN;
+
+    txPollInterval.tv_sec = 0;
+    txPollInterval.tv_nsec = EDRV_TX_POLL_INTERVAL_NS;
+#endif
+
+    // signal that thread is successfully started
+    sem_post(&pInstance->syncSem);
+
+    while (!pInstance->fStopThread)
+    {
+        processRxRing(pInstance);
+        processTxCompletion(pInstance);
+
+#if (CONFIG_EDRV_XDP_BUSY_POLL != FALSE)
+        // Drive the busy-poll of the network device queue
+        recvfrom(pInstance->xsk, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+#else
+        if (pInstance->txPendingCount > 0)
+            kickTx(pInstance);
+
+        pollRet = ppoll(aPollFd, 2,
+                        (pInstance->txPendingCount > 0) ? &txPollInterval : NULL,
+                        NULL);
+        if ((pollRet < 0) && (errno != EINTR))
+        {
+            DEBUG_LVL_ERROR_TRACE("%s(): poll failed (%s)\n", __func__, strerror(errno));
+            break;
+        }
+
+        if ((pollRet > 0) && ((aPollFd[1].revents & POLLIN) != 0))
+        {
+            if (read(pInstance->wakeFd, &value, sizeof(value)) < 0)
+            {
+                DEBUG_LVL_EDRV_TRACE("%s(): reading eventfd failed (%s)\n", __func__, strerror(errno));
+            }
+        }
+#endif
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the RX ring
+
+This function forwards all frames available in the RX ring to the dllk and
+returns their UMEM frames to the kernel through the fill ring. If the dllk
+releases a frame later, its UMEM frame is lent to the stack and returned by
+edrv_releaseRxBuffer().
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void processRxRing(tEdrvInstance* pInstance_p)
+{
+    const struct xdp_desc*  pDesc;
+    tEdrvRxBuffer           rxBuffer;
+    UINT32                  consumer;
+    UINT32                  producer;
+    UINT64                  aFillAddr[EDRV_XDP_RING_SIZE];
+    UINT                    fillCount = 0;
+
+    consumer = *pInstance_p->rxRing.pConsumer;
+    producer = __atomic_load_n(pInstance_p->rxRing.pProducer, __ATOMIC_ACQUIRE);
+    if (consumer == producer)
+        return;
+
+    for (; consumer != producer; consumer++)
+    {
+        pDesc = &((const struct xdp_desc*)pInstance_p->rxRing.pEntries)[consumer & (EDRV_XDP_RING_SIZE - 1)];
+
+        rxBuffer.bufferInFrame = kEdrvBufferLastInFrame;
+        rxBuffer.rxFrameSize = pDesc->len;
+        rxBuffer.pBuffer = pInstance_p->pUmem + pDesc->addr;
+        rxBuffer.pRxTimeStamp = NULL;
+
+        FTRACE_MARKER("%s RX", __func__);
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+        if (pInstance_p->initParam.pfnRxHandler(&rxBuffer) == kEdrvReleaseRxBufferLater)
+            continue;
+#else
+        pInstance_p->initParam.pfnRxHandler(&rxBuffer);
+#endif
+
+        aFillAddr[fillCount++] = pDesc->addr;
+    }
+
+    __atomic_store_n(pInstance_p->rxRing.pConsumer, consumer, __ATOMIC_RELEASE);
+    fillRxFrames(pInstance_p, aFillAddr, fillCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Return RX frames to the kernel
+
+This function returns UMEM frames to the kernel through the fill ring. The
+frames are returned by the worker thread and by edrv_releaseRxBuffer(), so the
+fill ring is protected by the instance mutex.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+\param[in]      pAddr_p             Pointer to the UMEM addresses of the frames
+\param[in]      count_p             Number of frames
+*/
+//------------------------------------------------------------------------------
+static void fillRxFrames(tEdrvInstance* pInstance_p, const UINT64* pAddr_p, UINT count_p)
+{
+    UINT32  fillProducer;
+    UINT    i;
+
+    if (count_p == 0)
+        return;
+
+    pthread_mutex_lock(&pInstance_p->mutex);
+
+    // All RX frames are owned by the kernel, in the RX ring or lent to the
+    // stack, so the fill ring has room
+    fillProducer = *pInstance_p->fillRing.pProducer;
+    for (i = 0; i < count_p; i++)
+    {
+        ((UINT64*)pInstance_p->fillRing.pEntries)[fillProducer & (EDRV_XDP_RING_SIZE - 1)] = pAddr_p[i];
+        fillProducer++;
+    }
+    __atomic_store_n(pInstance_p->fillRing.pProducer, fillProducer, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&pInstance_p->mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the completion ring
+
+This function calls the Tx handlers of all frames returned in the completion
+ring and releases their UMEM frames.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void processTxCompletion(tEdrvInstance* pInstance_p)
+{
+    tEdrvTxBuffer*  pTxBuffer;
+    UINT32          consumer;
+    UINT32          producer;
+    UINT            frame;
+
+    consumer = *pInstance_p->compRing.pConsumer;
+    producer = __atomic_load_n(pInstance_p->compRing.pProducer, __ATOMIC_ACQUIRE);
+
+    for (; consumer != producer; consumer++)
+    {
+        frame = (UINT)(((const UINT64*)pInstance_p->compRing.pEntries)[consumer & (EDRV_XDP_RING_SIZE - 1)] /
+                       EDRV_XDP_FRAME_SIZE);
+        __atomic_store_n(pInstance_p->compRing.pConsumer, consumer + 1, __ATOMIC_RELEASE);
+
+        pthread_mutex_lock(&pInstance_p->mutex);
+        pTxBuffer = pInstance_p->apTxBuffer[frame - EDRV_XDP_RX_FRAME_COUNT];
+        pInstance_p->apTxBuffer[frame - EDRV_XDP_RX_FRAME_COUNT] = NULL;
+        pInstance_p->aTxFreeFrame[pInstance_p->txFreeCount++] = frame;
+        pInstance_p->txPendingCount--;
+        pthread_mutex_unlock(&pInstance_p->mutex);
+
+        FTRACE_MARKER("%s TX-complete", __func__);
+        pTxBuffer->txBufferNumber.pArg = NULL;
+        if (pTxBuffer->pfnTxHandler != NULL)
+        {
+            pTxBuffer->pfnTxHandler(pTxBuffer);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start transmission of the TX ring
+
+This function tells the kernel to process the TX ring if it requests a wakeup.
+Frames which can't be sent immediately stay in the ring and are sent with the
+next wakeup.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void kickTx(tEdrvInstance* pInstance_p)
+{
+    if ((__atomic_load_n(pInstance_p->txRing.pFlags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP) == 0)
+        return;
+
+    if ((sendto(pInstance_p->xsk, NULL, 0, MSG_DONTWAIT, NULL, 0) < 0) &&
+        (errno != EAGAIN) && (errno != EBUSY) && (errno != ENOBUFS) && (errno != ENETDOWN))
+    {
+        DEBUG_LVL_EDRV_TRACE("%s() sendto failed (%s)\n", __func__, strerror(errno));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open the XDP socket
+
+This function allocates and registers the UMEM, opens the XDP socket, maps its
+rings, binds it to the queue of the interface and attaches the XDP program
+redirecting the received frames to it.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError openSocket(tEdrvInstance* pInstance_p)
+{
+    struct xdp_umem_reg     umemReg;
+    struct xdp_mmap_offsets offsets;
+    struct sockaddr_xdp     addr;
+    union bpf_attr          attr;
+    socklen_t               optLen;
+    UINT32                  mapKey;
+    UINT32                  mapValue;
+    int                     ringSize = EDRV_XDP_RING_SIZE;
+    UINT32                  xdpFlags;
+    UINT64                  fillProducer;
+    UINT                    i;
+    tOplkError              ret;
+#if (CONFIG_EDRV_XDP_BUSY_POLL != FALSE)
+    int                     option;
+#endif
+
+    pInstance_p->ifIndex = (int)if_nametoindex(pInstance_p->initParam.hwParam.pDevName);
+    if (pInstance_p->ifIndex == 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() unknown interface %s\n",
+                              __func__, pInstance_p->initParam.hwParam.pDevName);
+        return kErrorEdrvInit;
+    }
+
+    pInstance_p->ioctlSock = socket(AF_INET, SOCK_DGRAM, 0);
+    pInstance_p->wakeFd = eventfd(0, EFD_NONBLOCK);
+    pInstance_p->xsk = socket(AF_XDP, SOCK_RAW, 0);
+    if ((pInstance_p->ioctlSock < 0) || (pInstance_p->wakeFd < 0) || (pInstance_p->xsk < 0))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't open sockets (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    // Allocate and register the UMEM, the first frames are used for reception
+    pInstance_p->pUmem = (UINT8*)mmap(NULL, (size_t)EDRV_XDP_FRAME_COUNT * EDRV_XDP_FRAME_SIZE,
+                                      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pInstance_p->pUmem == MAP_FAILED)
+    {
+        pInstance_p->pUmem = NULL;
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't allocate UMEM (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    OPLK_MEMSET(&umemReg, 0, sizeof(umemReg));
+    umemReg.addr = (UINT64)(uintptr_t)pInstance_p->pUmem;
+    umemReg.len = (UINT64)EDRV_XDP_FRAME_COUNT * EDRV_XDP_FRAME_SIZE;
+    umemReg.chunk_size = EDRV_XDP_FRAME_SIZE;
+    if (setsockopt(pInstance_p->xsk, SOL_XDP, XDP_UMEM_REG, &umemReg, sizeof(umemReg)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't register UMEM (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    if ((setsockopt(pInstance_p->xsk, SOL_XDP, XDP_UMEM_FILL_RING, &ringSize, sizeof(ringSize)) < 0) ||
+        (setsockopt(pInstance_p->xsk, SOL_XDP, XDP_UMEM_COMPLETION_RING, &ringSize, sizeof(ringSize)) < 0) ||
+        (setsockopt(pInstance_p->xsk, SOL_XDP, XDP_RX_RING, &ringSize, sizeof(ringSize)) < 0) ||
+        (setsockopt(pInstance_p->xsk, SOL_XDP, XDP_TX_RING, &ringSize, sizeof(ringSize)) < 0))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set up rings (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    optLen = sizeof(offsets);
+    if (getsockopt(pInstance_p->xsk, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &optLen) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't get ring offsets (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    if ((mapRing(pInstance_p->xsk, XDP_PGOFF_RX_RING, &offsets.rx,
+                 sizeof(struct xdp_desc), &pInstance_p->rxRing) != kErrorOk) ||
+        (mapRing(pInstance_p->xsk, XDP_PGOFF_TX_RING, &offsets.tx,
+                 sizeof(struct xdp_desc), &pInstance_p->txRing) != kErrorOk) ||
+        (mapRing(pInstance_p->xsk, XDP_UMEM_PGOFF_FILL_RING, &offsets.fr,
+                 sizeof(UINT64), &pInstance_p->fillRing) != kErrorOk) ||
+        (mapRing(pInstance_p->xsk, XDP_UMEM_PGOFF_COMPLETION_RING, &offsets.cr,
+                 sizeof(UINT64), &pInstance_p->compRing) != kErrorOk))
+    {
+        return kErrorEdrvInit;
+    }
+
+    // Hand all RX frames to the kernel, all TX frames are free
+    for (fillProducer = 0; fillProducer < EDRV_XDP_RX_FRAME_COUNT; fillProducer++)
+        ((UINT64*)pInstance_p->fillRing.pEntries)[fillProducer] = fillProducer * EDRV_XDP_FRAME_SIZE;
+    __atomic_store_n(pInstance_p->fillRing.pProducer, EDRV_XDP_RX_FRAME_COUNT, __ATOMIC_RELEASE);
+
+    for (i = 0; i < EDRV_XDP_TX_FRAME_COUNT; i++)
+        pInstance_p->aTxFreeFrame[i] = EDRV_XDP_RX_FRAME_COUNT + i;
+    pInstance_p->txFreeCount = EDRV_XDP_TX_FRAME_COUNT;
+
+    ret = attachProgram(pInstance_p, &xdpFlags);
+    if (ret != kErrorOk)
+        return ret;
+
+    // Zero-copy is only possible in native mode and if supported by the network driver
+    OPLK_MEMSET(&addr, 0, sizeof(addr));
+    addr.sxdp_family = AF_XDP;
+    addr.sxdp_ifindex = (UINT32)pInstance_p->ifIndex;
+    addr.sxdp_queue_id = CONFIG_EDRV_XDP_QUEUE_ID;
+    addr.sxdp_flags = XDP_USE_NEED_WAKEUP | XDP_ZEROCOPY;
+    if (((xdpFlags & XDP_FLAGS_DRV_MODE) == 0) ||
+        (bind(pInstance_p->xsk, (struct sockaddr*)&addr, sizeof(addr)) < 0))
+    {
+        addr.sxdp_flags = XDP_USE_NEED_WAKEUP | XDP_COPY;
+        if (bind(pInstance_p->xsk, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() couldn't bind XDP socket (%s)\n", __func__, strerror(errno));
+            return kErrorEdrvInit;
+        }
+    }
+
+    DEBUG_LVL_EDRV_TRACE("%s() XDP socket bound in %s mode (%s)\n", __func__,
+                         ((xdpFlags & XDP_FLAGS_DRV_MODE) != 0) ? "native" : "generic",
+                         ((addr.sxdp_flags & XDP_ZEROCOPY) != 0) ? "zero-copy" : "copy");
+
+#if (CONFIG_EDRV_XDP_BUSY_POLL != FALSE)
+#ifdef SO_PREFER_BUSY_POLL
+    option = 1;
+    setsockopt(pInstance_p->xsk, SOL_SOCKET, SO_PREFER_BUSY_POLL, &option, sizeof(option));
+#endif
+#ifdef SO_BUSY_POLL
+    option = EDRV_BUSY_POLL_TIMEOUT_US;
+    setsockopt(pInstance_p->xsk, SOL_SOCKET, SO_BUSY_POLL, &option, sizeof(option));
+#endif
+#ifdef SO_BUSY_POLL_BUDGET
+    option = EDRV_BUSY_POLL_BUDGET;
+    setsockopt(pInstance_p->xsk, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &option, sizeof(option));
+#endif
+#endif
+
+    // Register the socket for the queue, from now on frames are redirected to it
+    mapKey = CONFIG_EDRV_XDP_QUEUE_ID;
+    mapValue = (UINT32)pInstance_p->xsk;
+    OPLK_MEMSET(&attr, 0, sizeof(attr));
+    attr.map_fd = (UINT32)pInstance_p->mapFd;
+    attr.key = (UINT64)(uintptr_t)&mapKey;
+    attr.value = (UINT64)(uintptr_t)&mapValue;
+    if (bpfSyscall(BPF_MAP_UPDATE_ELEM, &attr) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't register XDP socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    // POWERLINK uses multicast addresses, so all frames are received like with pcap
+    setPromiscuousMode(pInstance_p, TRUE);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Map a ring of the XDP socket
+
+\param[in]      sock_p              XDP socket
+\param[in]      pageOffset_p        Page offset selecting the ring
+\param[in]      pOffset_p           Offsets of the ring members
+\param[in]      entrySize_p         Size of a ring entry
+\param[out]     pRing_p             Pointer to the ring structure to be filled
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError mapRing(int sock_p, UINT64 pageOffset_p, const struct xdp_ring_offset* pOffset_p,
+                          size_t entrySize_p, tXdpRing* pRing_p)
+{
+    UINT8*  pMap;
+
+    pRing_p->mapSize = (size_t)pOffset_p->desc + (EDRV_XDP_RING_SIZE * entrySize_p);
+    pMap = (UINT8*)mmap(NULL, pRing_p->mapSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, sock_p, (off_t)pageOffset_p);
+    if (pMap == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't map ring (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    pRing_p->pMap = pMap;
+    pRing_p->pProducer = (UINT32*)(pMap + pOffset_p->producer);
+    pRing_p->pConsumer = (UINT32*)(pMap + pOffset_p->consumer);
+    pRing_p->pFlags = (UINT32*)(pMap + pOffset_p->flags);
+    pRing_p->pEntries = pMap + pOffset_p->desc;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Attach the XDP program
+
+This function creates the XSK map, loads the XDP program redirecting frames of
+each queue to the socket registered in the map and attaches it to the
+interface. Native driver mode is tried first, then the generic XDP path.
+
+The program corresponds to:
+\code
+return bpf_redirect_map(&xskMap, ctx->rx_queue_index, XDP_PASS);
+\endcode
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+\param[out]     pXdpFlags_p         Pointer to store the used attach flags
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError attachProgram(tEdrvInstance* pInstance_p, UINT32* pXdpFlags_p)
+{
+    union bpf_attr          attr;
+    struct bpf_insn         aProgram[6];
+    static const char       aLicense[] = "Dual BSD/GPL";
+    static const UINT32     aAttachFlags[] = {XDP_FLAGS_DRV_MODE, XDP_FLAGS_SKB_MODE};
+    UINT                    i;
+
+    OPLK_MEMSET(&attr, 0, sizeof(attr));
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof(UINT32);
+    attr.value_size = sizeof(UINT32);
+    attr.max_entries = EDRV_XDP_MAP_SIZE;
+    pInstance_p->mapFd = bpfSyscall(BPF_MAP_CREATE, &attr);
+    if (pInstance_p->mapFd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't create XSK map (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    OPLK_MEMSET(aProgram, 0, sizeof(aProgram));
+    // r2 = ctx->rx_queue_index
+    aProgram[0].code = BPF_LDX | BPF_W | BPF_MEM;
+    aProgram[0].dst_reg = BPF_REG_2;
+    aProgram[0].src_reg = BPF_REG_1;
+    aProgram[0].off = (INT16)offsetof(struct xdp_md, rx_queue_index);
+    // r1 = xskMap (64 bit immediate load occupies two instructions)
+    aProgram[1].code = BPF_LD | BPF_DW | BPF_IMM;
+    aProgram[1].dst_reg = BPF_REG_1;
+    aProgram[1].src_reg = BPF_PSEUDO_MAP_FD;
+    aProgram[1].imm = pInstance_p->mapFd;
+    // r3 = XDP_PASS (action if no socket is registered for the queue)
+    aProgram[3].code = BPF_ALU64 | BPF_MOV | BPF_K;
+    aProgram[3].dst_reg = BPF_REG_3;
+    aProgram[3].imm = XDP_PASS;
+    // r0 = bpf_redirect_map(r1, r2, r3)
+    aProgram[4].code = BPF_JMP | BPF_CALL;
+    aProgram[4].imm = BPF_FUNC_redirect_map;
+    // return r0
+    aProgram[5].code = BPF_JMP | BPF_EXIT;
+
+    OPLK_MEMSET(&attr, 0, sizeof(attr));
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insns = (UINT64)(uintptr_t)aProgram;
+    attr.insn_cnt = sizeof(aProgram) / sizeof(aProgram[0]);
+    attr.license = (UINT64)(uintptr_t)aLicense;
+    pInstance_p->progFd = bpfSyscall(BPF_PROG_LOAD, &attr);
+    if (pInstance_p->progFd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't load XDP program (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    // The program is detached automatically when the link is closed
+    for (i = 0; i < sizeof(aAttachFlags) / sizeof(aAttachFlags[0]); i++)
+    {
+        OPLK_MEMSET(&attr, 0, sizeof(attr));
+        attr.link_create.prog_fd = (UINT32)pInstance_p->progFd;
+        attr.link_create.target_ifindex = (UINT32)pInstance_p->ifIndex;
+        attr.link_create.attach_type = BPF_XDP;
+        attr.link_create.flags = aAttachFlags[i];
+        pInstance_p->linkFd = bpfSyscall(BPF_LINK_CREATE, &attr);
+        if (pInstance_p->linkFd >= 0)
+        {
+            *pXdpFlags_p = aAttachFlags[i];
+            return kErrorOk;
+        }
+    }
+
+    DEBUG_LVL_ERROR_TRACE("%s() couldn't attach XDP program (%s)\n", __func__, strerror(errno));
+    return kErrorEdrvInit;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close the XDP socket
+
+This function detaches the XDP program, closes all file descriptors, unmaps the
+rings and releases the UMEM.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void closeSocket(tEdrvInstance* pInstance_p)
+{
+    tXdpRing*   apRing[4];
+    int*        apFd[6];
+    UINT        i;
+
+    if (pInstance_p->fPromiscSet)
+        setPromiscuousMode(pInstance_p, FALSE);
+
+    apRing[0] = &pInstance_p->rxRing;
+    apRing[1] = &pInstance_p->txRing;
+    apRing[2] = &pInstance_p->fillRing;
+    apRing[3] = &pInstance_p->compRing;
+    for (i = 0; i < 4; i++)
+    {
+        if (apRing[i]->pMap != NULL)
+        {
+            munmap(apRing[i]->pMap, apRing[i]->mapSize);
+            apRing[i]->pMap = NULL;
+        }
+    }
+
+    apFd[0] = &pInstance_p->linkFd;
+    apFd[1] = &pInstance_p->progFd;
+    apFd[2] = &pInstance_p->mapFd;
+    apFd[3] = &pInstance_p->xsk;
+    apFd[4] = &pInstance_p->wakeFd;
+    apFd[5] = &pInstance_p->ioctlSock;
+    for (i = 0; i < 6; i++)
+    {
+        if (*apFd[i] >= 0)
+        {
+            close(*apFd[i]);
+            *apFd[i] = -1;
+        }
+    }
+
+    if (pInstance_p->pUmem != NULL)
+    {
+        munmap(pInstance_p->pUmem, (size_t)EDRV_XDP_FRAME_COUNT * EDRV_XDP_FRAME_SIZE);
+        pInstance_p->pUmem = NULL;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Call the bpf system call
+
+\param[in]      cmd_p               BPF command
+\param[in,out]  pAttr_p             Attributes of the command
+
+\return The function returns the result of the system call.
+*/
+//------------------------------------------------------------------------------
+static int bpfSyscall(int cmd_p, union bpf_attr* pAttr_p)
+{
+    return (int)syscall(__NR_bpf, cmd_p, pAttr_p, sizeof(*pAttr_p));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set promiscuous mode of the interface
+
+The function enables the promiscuous mode if it isn't enabled yet and disables
+it again only if it was enabled by the driver.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+\param[in]      fEnable_p           Enable or disable the promiscuous mode
+*/
+//------------------------------------------------------------------------------
+static void setPromiscuousMode(tEdrvInstance* pInstance_p, BOOL fEnable_p)
+{
+    struct ifreq    ifr;
+
+    OPLK_MEMSET(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, pInstance_p->initParam.hwParam.pDevName, IFNAMSIZ - 1);
+    if (ioctl(pInstance_p->ioctlSock, SIOCGIFFLAGS, &ifr) < 0)
+        return;
+
+    if (fEnable_p && ((ifr.ifr_flags & IFF_PROMISC) == 0))
+    {
+        ifr.ifr_flags |= IFF_PROMISC;
+        pInstance_p->fPromiscSet = (ioctl(pInstance_p->ioctlSock, SIOCSIFFLAGS, &ifr) == 0);
+    }
+    else if (!fEnable_p && pInstance_p->fPromiscSet)
+    {
+        ifr.ifr_flags &= ~IFF_PROMISC;
+        ioctl(pInstance_p->ioctlSock, SIOCSIFFLAGS, &ifr);
+        pInstance_p->fPromiscSet = FALSE;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get Edrv MAC address
+
+This function gets the interface's MAC address.
+
+\param[in]      pIfName_p           Ethernet interface device name
+\param[out]     pMacAddr_p          Pointer to store MAC address
+*/
+//------------------------------------------------------------------------------
+static void getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p)
+{
+    INT             fd;
+    struct ifreq    ifr;
+
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    ifr.ifr_addr.sa_family = AF_INET;
+    strncpy(ifr.ifr_name, pIfName_p, IFNAMSIZ - 1);
+
+    ioctl(fd, SIOCGIFHWADDR, &ifr);
+
+    close(fd);
+
+    OPLK_MEMCPY(pMacAddr_p, ifr.ifr_hwaddr.sa_data, 6);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get link status
+
+This function returns the interface link status.
+
+\param[in]      sock_p              Socket used for querying the interface flags
+\param[in]      pIfName_p           Ethernet interface device name
+
+\return The function returns the link status.
+\retval TRUE    The link is up.
+\retval FALSE   The link is down.
+*/
+//------------------------------------------------------------------------------
+static BOOL getLinkStatus(int sock_p, const char* pIfName_p)
+{
+    struct ifreq    ethreq;
+
+    OPLK_MEMSET(&ethreq, 0, sizeof(ethreq));
+
+    /* set the name of the interface we wish to check */
+    strncpy(ethreq.ifr_name, pIfName_p, IFNAMSIZ - 1);
+
+    /* grab flags associated with this interface */
+    if (ioctl(sock_p, SIOCGIFFLAGS, &ethreq) < 0)
+        return FALSE;
+
+    return ((ethreq.ifr_flags & IFF_RUNNING) != 0);
+}
+
+/// \}
@@ -50,6 +50,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/target.h>
 #endif
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+#include <kernel/latencyk.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -88,7 +92,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif /* (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE) */
 
 #if (EDRV_USE_TTTX == TRUE)
-#define EDRV_SHIFT                                      150000ULL
+#ifndef EDRV_SHIFT
+#define EDRV_SHIFT                                      150000ULL   // Lead time of the cycle timer before the launch of the first frame [ns]
+#endif
 #endif
 
 //------------------------------------------------------------------------------
@@ -503,6 +509,11 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p)
     startNewCycleTimeStamp = target_getCurrentTimestamp();
 #endif
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+    // the SoC is sent with the first frame of the new cycle
+    latencyk_start(kLatencyProbeSocToPres, latencyk_getTimestamp());
+#endif
+
     if (edrvcyclicInstance_l.ppTxBufferList[edrvcyclicInstance_l.curTxBufferEntry] != NULL)
     {
         ret = kErrorEdrvTxListNotFinishedYet;
@@ -527,6 +538,10 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p)
         goto Exit;
     }
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+    latencyk_stop(kLatencyProbeTpdoToTx, TRUE);
+#endif
+
 #if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
     if (edrvcyclicInstance_l.startCycleTimeStamp != 0)
     {
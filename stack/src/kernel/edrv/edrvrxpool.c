@@ -0,0 +1,360 @@
+/**
+********************************************************************************
+\file   edrvrxpool.c
+
+\brief  Implementation of Ethernet driver Rx buffer pool
+
+This file contains the Rx buffer pool of the Ethernet driver. Ethernet drivers
+which receive frames into transient memory that can't be lent to the stack
+(e.g. a pcap capture buffer) copy each frame the DLL may keep for deferred
+processing into a preallocated pool buffer before passing it to the DLL. If the
+DLL keeps the frame (e.g. an ASnd frame forwarded to the user layer), the
+buffer is returned to the pool by edrv_releaseRxBuffer() after the frame has
+been processed. Thus, the frame data is passed by reference through the whole
+stack without further copies. Frames which are never deferred (e.g. the cyclic
+frames if only asynchronous frames are deferred) are passed without a copy.
+
+The free buffers are managed by the buffer allocation library (bufalloc).
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <common/bufalloc.h>
+#include <common/target.h>
+#include <kernel/edrvrxpool.h>
+#include <oplk/frame.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef CONFIG_EDRV_RX_POOL_BUFFERS
+#define CONFIG_EDRV_RX_POOL_BUFFERS     64          // Number of Rx buffers in the pool
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Structure describing the Rx buffer pool
+
+This structure describes the instance of the Rx buffer pool.
+*/
+typedef struct
+{
+    UINT8*          pBufferBase;                    ///< Start of the buffer memory
+    UINT            bufferSize;                     ///< Size of a single buffer
+    tBufAlloc*      pBufAlloc;                      ///< Buffer allocation instance holding the free buffers
+    OPLK_MUTEX_T    lockMutex;                      ///< Mutex protecting the buffer allocation instance
+    BOOL            fInitialized;                   ///< Flag determines if the pool is initialized
+} tEdrvRxPoolInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEdrvRxPoolInstance edrvRxPoolInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL isDeferrable(const tEdrvRxBuffer* pRxBuffer_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize Rx buffer pool
+
+The function allocates the buffers of the Rx buffer pool.
+
+\param[in]      bufferSize_p        Size of a single buffer (maximum frame size)
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvrxpool_init(UINT bufferSize_p)
+{
+    tBufData    bufData;
+    UINT        i;
+
+    OPLK_MEMSET(&edrvRxPoolInstance_l, 0, sizeof(edrvRxPoolInstance_l));
+
+    edrvRxPoolInstance_l.bufferSize = bufferSize_p;
+
+    edrvRxPoolInstance_l.pBufferBase = (UINT8*)OPLK_MALLOC(edrvRxPoolInstance_l.bufferSize *
+                                                           CONFIG_EDRV_RX_POOL_BUFFERS);
+    if (edrvRxPoolInstance_l.pBufferBase == NULL)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't allocate Rx buffers\n", __func__);
+        return kErrorNoResource;
+    }
+
+    edrvRxPoolInstance_l.pBufAlloc = bufalloc_init(CONFIG_EDRV_RX_POOL_BUFFERS);
+    if (edrvRxPoolInstance_l.pBufAlloc == NULL)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't initialize buffer allocation\n", __func__);
+        OPLK_FREE(edrvRxPoolInstance_l.pBufferBase);
+        return kErrorNoResource;
+    }
+
+    for (i = 0; i < CONFIG_EDRV_RX_POOL_BUFFERS; i++)
+    {
+        bufData.bufferNumber = i;
+        bufData.pBuffer = edrvRxPoolInstance_l.pBufferBase + (i * edrvRxPoolInstance_l.bufferSize);
+        bufalloc_addBuffer(edrvRxPoolInstance_l.pBufAlloc, &bufData);
+    }
+
+    if (target_createMutex("/edrvRxPoolMutex", &edrvRxPoolInstance_l.lockMutex) != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't create mutex\n", __func__);
+        bufalloc_exit(edrvRxPoolInstance_l.pBufAlloc);
+        OPLK_FREE(edrvRxPoolInstance_l.pBufferBase);
+        return kErrorNoResource;
+    }
+
+    edrvRxPoolInstance_l.fInitialized = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down Rx buffer pool
+
+The function frees the buffers of the Rx buffer pool. Buffers which are still
+held by the stack become invalid.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvrxpool_exit(void)
+{
+    if (!edrvRxPoolInstance_l.fInitialized)
+        return;
+
+    target_lockMutex(edrvRxPoolInstance_l.lockMutex);
+    edrvRxPoolInstance_l.fInitialized = FALSE;
+    target_unlockMutex(edrvRxPoolInstance_l.lockMutex);
+    target_destroyMutex(edrvRxPoolInstance_l.lockMutex);
+
+    bufalloc_exit(edrvRxPoolInstance_l.pBufAlloc);
+    OPLK_FREE(edrvRxPoolInstance_l.pBufferBase);
+
+    OPLK_MEMSET(&edrvRxPoolInstance_l, 0, sizeof(edrvRxPoolInstance_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a free Rx buffer
+
+The function takes a free buffer from the Rx buffer pool.
+
+\return The function returns a pointer to the buffer or NULL if no buffer is
+        available.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+UINT8* edrvrxpool_getBuffer(void)
+{
+    tBufData    bufData;
+    tOplkError  ret;
+
+    target_lockMutex(edrvRxPoolInstance_l.lockMutex);
+    ret = bufalloc_getBuffer(edrvRxPoolInstance_l.pBufAlloc, &bufData);
+    target_unlockMutex(edrvRxPoolInstance_l.lockMutex);
+
+    if (ret != kErrorOk)
+        return NULL;
+
+    return (UINT8*)bufData.pBuffer;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release an Rx buffer
+
+The function returns a buffer to the Rx buffer pool.
+
+\param[in]      pBuffer_p           Pointer to the buffer
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The buffer was returned to the pool.
+\retval kErrorEdrvInvalidRxBuf      The pointer doesn't belong to the pool.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvrxpool_releaseBuffer(const UINT8* pBuffer_p)
+{
+    tBufData    bufData;
+    size_t      offset;
+    tOplkError  ret = kErrorEdrvInvalidRxBuf;
+
+    target_lockMutex(edrvRxPoolInstance_l.lockMutex);
+
+    if (edrvRxPoolInstance_l.fInitialized &&
+        (pBuffer_p >= edrvRxPoolInstance_l.pBufferBase))
+    {
+        offset = (size_t)(pBuffer_p - edrvRxPoolInstance_l.pBufferBase);
+        bufData.bufferNumber = (UINT)(offset / edrvRxPoolInstance_l.bufferSize);
+        if ((bufData.bufferNumber < CONFIG_EDRV_RX_POOL_BUFFERS) &&
+            ((offset % edrvRxPoolInstance_l.bufferSize) == 0))
+        {
+            bufData.pBuffer = (void*)pBuffer_p;
+            if (bufalloc_releaseBuffer(edrvRxPoolInstance_l.pBufAlloc, &bufData) == kErrorOk)
+                ret = kErrorOk;
+        }
+    }
+
+    target_unlockMutex(edrvRxPoolInstance_l.lockMutex);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Pass a received frame to the Rx handler
+
+The function copies a frame from transient memory into a pool buffer and passes
+it to the Rx handler. The buffer is returned to the pool immediately unless the
+Rx handler requests to release it later. Frames which the DLL never defers are
+passed to the Rx handler in the transient memory, so they are neither copied
+nor dropped if the pool is empty.
+
+\param[in]      pfnRxHandler_p      Rx handler of the DLL
+\param[in,out]  pRxBuffer_p         Rx buffer describing the received frame. The
+                                    buffer pointer is replaced by the pool buffer.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The frame was passed to the Rx handler.
+\retval kErrorEdrvNoFreeBufEntry    The pool is empty, the frame was dropped.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvrxpool_receiveFrame(tEdrvRxHandler pfnRxHandler_p,
+                                   tEdrvRxBuffer* pRxBuffer_p)
+{
+    UINT8*  pBuffer;
+
+    // Check parameter validity
+    ASSERT(pRxBuffer_p != NULL);
+
+    if (!isDeferrable(pRxBuffer_p))
+    {
+        pfnRxHandler_p(pRxBuffer_p);
+        return kErrorOk;
+    }
+
+    if (pRxBuffer_p->rxFrameSize > edrvRxPoolInstance_l.bufferSize)
+        return kErrorEdrvInvalidRxBuf;
+
+    pBuffer = edrvrxpool_getBuffer();
+    if (pBuffer == NULL)
+    {
+        DEBUG_LVL_EDRV_TRACE("%s() no free Rx buffer, frame dropped\n", __func__);
+        return kErrorEdrvNoFreeBufEntry;
+    }
+
+    OPLK_MEMCPY(pBuffer, pRxBuffer_p->pBuffer, pRxBuffer_p->rxFrameSize);
+    pRxBuffer_p->pBuffer = pBuffer;
+
+    if (pfnRxHandler_p(pRxBuffer_p) == kEdrvReleaseRxBufferImmediately)
+        edrvrxpool_releaseBuffer(pBuffer);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if a frame may be deferred by the DLL
+
+The function checks if the DLL may keep a received frame for deferred
+processing. If only asynchronous frames are deferred, these are the ASnd
+frames. The cyclic frames (e.g. SoC, PReq and PRes) are released immediately.
+
+\param[in]      pRxBuffer_p         Rx buffer describing the received frame
+
+\return The function returns TRUE if the frame may be deferred, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL isDeferrable(const tEdrvRxBuffer* pRxBuffer_p)
+{
+#if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC == FALSE)
+    const tPlkFrame*    pFrame = (const tPlkFrame*)pRxBuffer_p->pBuffer;
+
+    if (pRxBuffer_p->rxFrameSize <= PLK_FRAME_OFFSET_MSG_TYPE)
+        return FALSE;
+
+    return ((ami_getUint16Be(&pFrame->etherType) == C_DLL_ETHERTYPE_EPL) &&
+            (ami_getUint8Le(&pFrame->messageType) == (UINT8)kMsgTypeAsnd));
+#else
+    UNUSED_PARAMETER(pRxBuffer_p);
+
+    return TRUE;
+#endif
+}
+
+/// \}
@@ -7,6 +7,11 @@
 This file implements the kernel event handler CAL module for the Linux
 userspace platform. It uses the circular buffer interface for all event queues.
 
+The event thread is woken up by a named semaphore. A wakeup processes all
+pending events, whereby the kernel internal queue has priority over the
+user-to-kernel queue. A signal is only posted if no wakeup is pending, thus
+a burst of events is handled with a single wakeup.
+
 \see eventkcalintf-circbuf.c
 
 \ingroup module_eventkcal
@@ -94,6 +99,7 @@ typedef struct
     BOOL                    fStopThread;
     sem_t*                  semUserData;
     sem_t*                  semKernelData;
+    tEventkCalStatistics    statistics;
     BOOL                    fInitialized;
 } tEventkCalInstance;
 
@@ -106,8 +112,10 @@ static tEventkCalInstance   instance_l;             ///< Instance variable of ke
 // local function prototypes
 //------------------------------------------------------------------------------
 static void* eventThread(void* arg);
+static void  processEvents(tEventkCalInstance* pInstance_p);
 static void  signalKernelEvent(void);
 static void  signalUserEvent(void);
+static void  signalEvent(sem_t* pSem_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -209,6 +217,7 @@ tOplkError eventkcal_exit(void)
     if (instance_l.fInitialized == TRUE)
     {
         instance_l.fStopThread = TRUE;
+        sem_post(instance_l.semKernelData);
         while (instance_l.fStopThread == TRUE)
         {
             target_msleep(10);
@@ -229,6 +238,13 @@ tOplkError eventkcal_exit(void)
         sem_unlink("/semUserEvent");
         sem_unlink("/semKernelEvent");
 
+        DEBUG_LVL_EVENTK_TRACE("%s(): wakeups:%u events:%u max/wakeup:%u max KInt:%u max U2K:%u\n",
+                               __func__,
+                               instance_l.statistics.wakeupCount,
+                               instance_l.statistics.eventCount,
+                               instance_l.statistics.maxEventsPerWakeup,
+                               instance_l.statistics.maxQueueDepthKInt,
+                               instance_l.statistics.maxQueueDepthU2K);
     }
     instance_l.fInitialized = FALSE;
 
@@ -297,6 +313,25 @@ void eventkcal_process(void)
     // Nothing to do, because we use threads
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get statistics of kernel event CAL module
+
+This function returns the statistics of the event handler thread.
+
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\ingroup module_eventkcal
+*/
+//------------------------------------------------------------------------------
+void eventkcal_getStatistics(tEventkCalStatistics* pStatistics_p)
+{
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    OPLK_MEMCPY(pStatistics_p, &instance_l.statistics, sizeof(tEventkCalStatistics));
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -328,18 +363,12 @@ static void* eventThread(void* arg)
 
         if (sem_timedwait(pInstance->semKernelData, &timeout) == 0)
         {
-            /* first handle kernel internal events --> higher priority! */
-            if (eventkcal_getEventCountCircbuf(kEventQueueKInt) > 0)
-            {
-                eventkcal_processEventCircbuf(kEventQueueKInt);
-            }
-            else
-            {
-                if (eventkcal_getEventCountCircbuf(kEventQueueU2K) > 0)
-                {
-                    eventkcal_processEventCircbuf(kEventQueueU2K);
-                }
-            }
+            // Consume all pending signals before the queues are read. Events
+            // posted afterwards signal the semaphore again and are not lost.
+            while (sem_trywait(pInstance->semKernelData) == 0)
+                ;
+
+            processEvents(pInstance);
         }
     }
 
@@ -347,6 +376,58 @@ static void* eventThread(void* arg)
     return 0;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process all pending events
+
+This function processes the event queues until they are empty. Kernel internal
+events have a higher priority. They are processed in batches, whereas the
+user-to-kernel events are processed one by one and the kernel internal queue is
+checked before each of them.
+
+\param[in,out]  pInstance_p         Pointer to the module instance.
+*/
+//------------------------------------------------------------------------------
+static void processEvents(tEventkCalInstance* pInstance_p)
+{
+    UINT32  eventCount = 0;
+    UINT32  queueDepth;
+    UINT    processedCount;
+
+    while (!pInstance_p->fStopThread)
+    {
+        /* first handle kernel internal events --> higher priority! */
+        queueDepth = eventkcal_getEventCountCircbuf(kEventQueueKInt);
+        if (queueDepth > 0)
+        {
+            if (queueDepth > pInstance_p->statistics.maxQueueDepthKInt)
+                pInstance_p->statistics.maxQueueDepthKInt = queueDepth;
+
+            eventkcal_processEventCircbuf(kEventQueueKInt,
+                                      EVENTKCAL_MAX_BATCH_EVENTS,
+                                      &processedCount);
+            eventCount += processedCount;
+            continue;
+        }
+
+        queueDepth = eventkcal_getEventCountCircbuf(kEventQueueU2K);
+        if (queueDepth == 0)
+            break;
+
+        if (queueDepth > pInstance_p->statistics.maxQueueDepthU2K)
+            pInstance_p->statistics.maxQueueDepthU2K = queueDepth;
+
+        // Only a single event, so the higher priority queue is checked again first
+        eventkcal_processEventCircbuf(kEventQueueU2K, 1, &processedCount);
+        eventCount += processedCount;
+    }
+
+    pInstance_p->statistics.wakeupCount++;
+    pInstance_p->statistics.eventCount += eventCount;
+    if (eventCount > pInstance_p->statistics.maxEventsPerWakeup)
+        pInstance_p->statistics.maxEventsPerWakeup = eventCount;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Signal a user event
@@ -357,7 +438,7 @@ the circular buffer library as signal callback function
 //------------------------------------------------------------------------------
 static void signalUserEvent(void)
 {
-    sem_post(instance_l.semUserData);
+    signalEvent(instance_l.semUserData);
 }
 
 //------------------------------------------------------------------------------
@@ -370,7 +451,28 @@ the circular buffer library as signal callback function
 //------------------------------------------------------------------------------
 static void signalKernelEvent(void)
 {
-    sem_post(instance_l.semKernelData);
+    signalEvent(instance_l.semKernelData);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal an event thread
+
+This function signals the semaphore of an event thread. If a signal is already
+pending, the event thread has not yet started to read the queues and will also
+process the just posted event. Therefore, no further signal is posted.
+
+\param[in]      pSem_p              Semaphore of the event thread to signal.
+*/
+//------------------------------------------------------------------------------
+static void signalEvent(sem_t* pSem_p)
+{
+    int     semValue;
+
+    if ((sem_getvalue(pSem_p, &semValue) == 0) && (semValue > 0))
+        return;
+
+    sem_post(pSem_p);
 }
 
 /// \}
@@ -537,13 +537,13 @@ static int eventThread(void* arg)
         /* first handle all kernel internal events --> higher priority! */
         while (eventkcal_getEventCountCircbuf(kEventQueueKInt) > 0)
         {
-            eventkcal_processEventCircbuf(kEventQueueKInt);
+            eventkcal_processEventCircbuf(kEventQueueKInt, 1, NULL);
             atomic_dec(&instance_l.kernelEventCount);
         }
 
         if (eventkcal_getEventCountCircbuf(kEventQueueU2K) > 0)
         {
-            eventkcal_processEventCircbuf(kEventQueueU2K);
+            eventkcal_processEventCircbuf(kEventQueueU2K, 1, NULL);
             atomic_dec(&instance_l.kernelEventCount);
         }
     }
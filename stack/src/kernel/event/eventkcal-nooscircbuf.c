@@ -242,7 +242,7 @@ void eventkcal_process(void)
         return;
 
     if (eventkcal_getEventCountCircbuf(kEventQueueKInt) > 0)
-        eventkcal_processEventCircbuf(kEventQueueKInt);
+        eventkcal_processEventCircbuf(kEventQueueKInt, 1, NULL);
 }
 
 //============================================================================//
@@ -302,7 +302,7 @@ void eventkcal_process(void)
     {
         if (eventkcal_getEventCountCircbuf(kEventQueueU2K) > 0)
         {
-            ret = eventkcal_processEventCircbuf(kEventQueueU2K);
+            ret = eventkcal_processEventCircbuf(kEventQueueU2K, 1, NULL);
         }
     }
 }
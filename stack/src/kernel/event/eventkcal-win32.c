@@ -304,13 +304,13 @@ static DWORD WINAPI eventThread(LPVOID arg)
                 /* first handle kernel internal events --> higher priority! */
                 if (eventkcal_getEventCountCircbuf(kEventQueueKInt) > 0)
                 {
-                    eventkcal_processEventCircbuf(kEventQueueKInt);
+                    eventkcal_processEventCircbuf(kEventQueueKInt, 1, NULL);
                 }
                 else
                 {
                     if (eventkcal_getEventCountCircbuf(kEventQueueU2K) > 0)
                     {
-                        eventkcal_processEventCircbuf(kEventQueueU2K);
+                        eventkcal_processEventCircbuf(kEventQueueU2K, 1, NULL);
                     }
                 }
                 break;
@@ -499,13 +499,13 @@ static void eventThread(void* pArg)
         /* first handle all kernel internal events --> higher priority! */
         while (eventkcal_getEventCountCircbuf(kEventQueueKInt) > 0)
         {
-            eventkcal_processEventCircbuf(kEventQueueKInt);
+            eventkcal_processEventCircbuf(kEventQueueKInt, 1, NULL);
             NdisInterlockedDecrement(&instance_l.kernelEventCount);
         }
 
         if (eventkcal_getEventCountCircbuf(kEventQueueU2K) > 0)
         {
-            eventkcal_processEventCircbuf(kEventQueueU2K);
+            eventkcal_processEventCircbuf(kEventQueueU2K, 1, NULL);
             NdisInterlockedDecrement(&instance_l.kernelEventCount);
         }
     }
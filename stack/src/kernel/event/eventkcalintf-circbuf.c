@@ -69,6 +69,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// Size of the receive buffer of a queue, it holds at least one maximum sized event
+#define EVENTKCAL_RX_BUFFER_SIZE        (sizeof(tEvent) + MAX_EVENT_ARG_SIZE)
 
 //------------------------------------------------------------------------------
 // local types
@@ -78,7 +80,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local vars
 //------------------------------------------------------------------------------
 static tCircBufInstance*        instance_l[kEventQueueNum];
-static BYTE                     aRxBuffer_l[kEventQueueNum][sizeof(tEvent) + MAX_EVENT_ARG_SIZE];
+static BYTE                     aRxBuffer_l[kEventQueueNum][EVENTKCAL_RX_BUFFER_SIZE];
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -125,6 +127,7 @@ tOplkError eventkcal_initQueueCircbuf(tEventQueue eventQueue_p)
         case kEventQueueKInt:
             circError = circbuf_alloc(CIRCBUF_KERNEL_INTERNAL_QUEUE,
                                       CONFIG_EVENT_SIZE_CIRCBUF_KERNEL_INTERNAL,
+                                      kCircBufModeLocked,
                                       &instance_l[eventQueue_p]);
             if (circError != kCircBufOk)
             {
@@ -136,6 +139,7 @@ tOplkError eventkcal_initQueueCircbuf(tEventQueue eventQueue_p)
         case kEventQueueU2K:
             circError = circbuf_alloc(CIRCBUF_USER_TO_KERNEL_QUEUE,
                                       CONFIG_EVENT_SIZE_CIRCBUF_USER_TO_KERNEL,
+                                      kCircBufModeLocked,
                                       &instance_l[eventQueue_p]);
             if (circError != kCircBufOk)
             {
@@ -147,6 +151,7 @@ tOplkError eventkcal_initQueueCircbuf(tEventQueue eventQueue_p)
         case kEventQueueK2U:
             circError = circbuf_alloc(CIRCBUF_KERNEL_TO_USER_QUEUE,
                                       CONFIG_EVENT_SIZE_CIRCBUF_KERNEL_TO_USER,
+                                      kCircBufModeLocked,
                                       &instance_l[eventQueue_p]);
             if (circError != kCircBufOk)
             {
@@ -158,6 +163,7 @@ tOplkError eventkcal_initQueueCircbuf(tEventQueue eventQueue_p)
         case kEventQueueUInt:
             circError = circbuf_alloc(CIRCBUF_USER_INTERNAL_QUEUE,
                                       CONFIG_EVENT_SIZE_CIRCBUF_USER_INTERNAL,
+                                      kCircBufModeLocked,
                                       &instance_l[eventQueue_p]);
             if (circError != kCircBufOk)
             {
@@ -260,12 +266,17 @@ tOplkError eventkcal_postEventCircbuf(tEventQueue eventQueue_p,
 
 //------------------------------------------------------------------------------
 /**
-\brief    Process event using circular buffers
+\brief    Process events using circular buffers
 
-This function reads a circular buffer event queue and processes the event
-by calling the event handlers process function.
+This function reads up to maxEventCount_p events from a circular buffer event
+queue with a single queue access and processes them by calling the event
+handlers process function. At most EVENTKCAL_MAX_BATCH_EVENTS events are
+processed per call.
 
-\param[in]      eventQueue_p        Event queue used for reading the event.
+\param[in]      eventQueue_p        Event queue used for reading the events.
+\param[in]      maxEventCount_p     Maximum number of events to be processed.
+\param[out]     pEventCount_p       Pointer to store the number of processed
+                                    events. May be NULL.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Function executes correctly
@@ -274,14 +285,26 @@ by calling the event handlers process function.
 \ingroup module_eventkcal
 */
 //------------------------------------------------------------------------------
-tOplkError eventkcal_processEventCircbuf(tEventQueue eventQueue_p)
+tOplkError eventkcal_processEventCircbuf(tEventQueue eventQueue_p,
+                                         UINT maxEventCount_p,
+                                         UINT* pEventCount_p)
 {
     tEvent*             pEvent;
     tCircBufError       error;
     tOplkError          ret = kErrorOk;
-    size_t              readSize;
+    tOplkError          processRet;
+    size_t              aReadSize[EVENTKCAL_MAX_BATCH_EVENTS];
+    UINT                readCount;
+    UINT                i;
+    size_t              offset;
     tCircBufInstance*   pCircBufInstance;
 
+    // Check parameter validity
+    ASSERT(maxEventCount_p > 0);
+
+    if (maxEventCount_p > EVENTKCAL_MAX_BATCH_EVENTS)
+        maxEventCount_p = EVENTKCAL_MAX_BATCH_EVENTS;
+
     if (eventQueue_p > kEventQueueNum)
     {
         DEBUG_LVL_ERROR_TRACE("%s() invalid queue %d!\n", __func__, eventQueue_p);
@@ -294,12 +317,17 @@ tOplkError eventkcal_processEventCircbuf(tEventQueue eventQueue_p)
         return kErrorInvalidInstanceParam;
     }
 
+    if (pEventCount_p != NULL)
+        *pEventCount_p = 0;
+
     pCircBufInstance = instance_l[eventQueue_p];
 
-    error = circbuf_readData(pCircBufInstance,
-                             aRxBuffer_l[eventQueue_p],
-                             sizeof(tEvent) + MAX_EVENT_ARG_SIZE,
-                             &readSize);
+    error = circbuf_readMultiple(pCircBufInstance,
+                                 aRxBuffer_l[eventQueue_p],
+                                 EVENTKCAL_RX_BUFFER_SIZE,
+                                 aReadSize,
+                                 maxEventCount_p,
+                                 &readCount);
     if (error != kCircBufOk)
     {
         if (error == kCircBufNoReadableData)
@@ -312,21 +340,34 @@ tOplkError eventkcal_processEventCircbuf(tEventQueue eventQueue_p)
 
         return kErrorGeneralError;
     }
-    pEvent = (tEvent*)aRxBuffer_l[eventQueue_p];
-    pEvent->eventArgSize = (UINT)(readSize - sizeof(tEvent));
 
-    if (pEvent->eventArgSize > 0)
-        pEvent->eventArg.pEventArg = &aRxBuffer_l[eventQueue_p][sizeof(tEvent)];
-    else
-        pEvent->eventArg.pEventArg = NULL;
-
-    DEBUG_LVL_EVENTK_TRACE("Process Kernel  type:%s(%d) sink:%s(%d) size:%d!\n",
-                           debugstr_getEventTypeStr(pEvent->eventType),
-                           pEvent->eventType,
-                           debugstr_getEventSinkStr(pEvent->eventSink),
-                           pEvent->eventSink,
-                           pEvent->eventArgSize);
-    ret = eventk_process(pEvent);
+    if (pEventCount_p != NULL)
+        *pEventCount_p = readCount;
+
+    offset = 0;
+    for (i = 0; i < readCount; i++)
+    {
+        pEvent = (tEvent*)&aRxBuffer_l[eventQueue_p][offset];
+        pEvent->eventArgSize = (UINT)(aReadSize[i] - sizeof(tEvent));
+
+        if (pEvent->eventArgSize > 0)
+            pEvent->eventArg.pEventArg = &aRxBuffer_l[eventQueue_p][offset + sizeof(tEvent)];
+        else
+            pEvent->eventArg.pEventArg = NULL;
+
+        DEBUG_LVL_EVENTK_TRACE("Process Kernel  type:%s(%d) sink:%s(%d) size:%d!\n",
+                               debugstr_getEventTypeStr(pEvent->eventType),
+                               pEvent->eventType,
+                               debugstr_getEventSinkStr(pEvent->eventSink),
+                               pEvent->eventSink,
+                               pEvent->eventArgSize);
+        processRet = eventk_process(pEvent);
+        if (processRet != kErrorOk)
+            ret = processRet;
+
+        offset += (aReadSize[i] + (CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1)) &
+                  ~(size_t)(CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1);
+    }
 
     return ret;
 }
@@ -0,0 +1,415 @@
+/**
+********************************************************************************
+\file   latencyk.c
+
+\brief  Implementation of kernel latency histogram module
+
+This file contains the implementation of the kernel latency histogram module.
+The module records the latencies of the isochronous hot path in logarithmic
+histograms which can be read by latencyk_getHistogram().
+
+Each histogram is written by exactly one context (the context which records
+the samples of the probe), therefore no locking is necessary. A reset of the
+histograms is only requested by the reader and executed by the writer with the
+next recorded sample.
+
+\ingroup module_latencyk
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/target.h>
+#include <kernel/latencyk.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Latency probe instance
+
+This structure contains the state and the histogram of a single latency probe.
+*/
+typedef struct
+{
+    tLatencyHistogram   histogram;              ///< Histogram of the probe
+    volatile UINT32     startTimeStamp;         ///< Timestamp of the running measurement
+    volatile BOOL       fStarted;               ///< Flag determines if a measurement is running
+    volatile BOOL       fResetRequest;          ///< Flag determines if the histogram shall be reset by the writer
+} tLatencykProbeInstance;
+
+/**
+\brief Latency module instance
+
+This structure contains the instance of the kernel latency histogram module.
+*/
+typedef struct
+{
+    tLatencykProbeInstance  aProbe[kLatencyProbeCount];     ///< Probe instances
+} tLatencykInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tLatencykInstance    latencykInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void  clearHistogram(tLatencyHistogram* pHistogram_p);
+static UINT  getBucketIndex(UINT32 latency_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize kernel latency histogram module
+
+The function initializes the kernel latency histogram module.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+tOplkError latencyk_init(void)
+{
+    tLatencyProbe   probe;
+
+    OPLK_MEMSET(&latencykInstance_l, 0, sizeof(latencykInstance_l));
+
+    for (probe = 0; probe < kLatencyProbeCount; probe++)
+        clearHistogram(&latencykInstance_l.aProbe[probe].histogram);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up kernel latency histogram module
+
+The function cleans up the kernel latency histogram module.
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+void latencyk_exit(void)
+{
+    OPLK_MEMSET(&latencykInstance_l, 0, sizeof(latencykInstance_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current timestamp
+
+The function returns the current timestamp used by the latency probes. The
+timestamp wraps around after approximately 4.29 s, which is sufficient for
+the measured latencies of a single POWERLINK cycle.
+
+\return The function returns the current timestamp in nanoseconds.
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+UINT32 latencyk_getTimestamp(void)
+{
+    return (UINT32)target_getCurrentTimestamp();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start latency measurement
+
+The function starts a latency measurement of the specified probe. A running
+measurement of the probe is restarted.
+
+\param[in]      probe_p             Latency probe
+\param[in]      timeStamp_p         Start timestamp (see latencyk_getTimestamp())
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+void latencyk_start(tLatencyProbe probe_p, UINT32 timeStamp_p)
+{
+    tLatencykProbeInstance* pProbe;
+
+    if (probe_p >= kLatencyProbeCount)
+        return;
+
+    pProbe = &latencykInstance_l.aProbe[probe_p];
+    pProbe->startTimeStamp = timeStamp_p;
+    pProbe->fStarted = TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get start timestamp of latency measurement
+
+The function returns the start timestamp of the running latency measurement of
+the specified probe. It is used to pass the start timestamp to a deferred
+context (e.g. with an event).
+
+\param[in]      probe_p             Latency probe
+
+\return The function returns the start timestamp or 0 if no measurement is
+        running.
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+UINT32 latencyk_getStartTimestamp(tLatencyProbe probe_p)
+{
+    if ((probe_p >= kLatencyProbeCount) ||
+        !latencykInstance_l.aProbe[probe_p].fStarted)
+        return 0;
+
+    return latencykInstance_l.aProbe[probe_p].startTimeStamp;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stop latency measurement
+
+The function records the time since the start of the running measurement of
+the specified probe. If no measurement is running, nothing is recorded.
+
+\param[in]      probe_p             Latency probe
+\param[in]      fFinish_p           If TRUE, the measurement is finished. If
+                                    FALSE, the measurement keeps running and
+                                    further samples relative to the same start
+                                    timestamp can be recorded.
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+void latencyk_stop(tLatencyProbe probe_p, BOOL fFinish_p)
+{
+    tLatencykProbeInstance* pProbe;
+
+    if (probe_p >= kLatencyProbeCount)
+        return;
+
+    pProbe = &latencykInstance_l.aProbe[probe_p];
+    if (!pProbe->fStarted)
+        return;
+
+    latencyk_record(probe_p, latencyk_getTimestamp() - pProbe->startTimeStamp);
+
+    if (fFinish_p)
+        pProbe->fStarted = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Record latency sample
+
+The function adds a latency sample to the histogram of the specified probe.
+It must only be called from a single context per probe.
+
+\param[in]      probe_p             Latency probe
+\param[in]      latency_p           Latency in nanoseconds
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+void latencyk_record(tLatencyProbe probe_p, UINT32 latency_p)
+{
+    tLatencykProbeInstance* pProbe;
+    tLatencyHistogram*      pHistogram;
+
+    if (probe_p >= kLatencyProbeCount)
+        return;
+
+    pProbe = &latencykInstance_l.aProbe[probe_p];
+    pHistogram = &pProbe->histogram;
+
+    if (pProbe->fResetRequest)
+    {
+        clearHistogram(pHistogram);
+        pProbe->fResetRequest = FALSE;
+    }
+
+    pHistogram->aBucket[getBucketIndex(latency_p)]++;
+    pHistogram->sumLatency += latency_p;
+
+    if (latency_p < pHistogram->minLatency)
+        pHistogram->minLatency = latency_p;
+
+    if (latency_p > pHistogram->maxLatency)
+        pHistogram->maxLatency = latency_p;
+
+    pHistogram->count++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get latency histogram
+
+The function copies the histogram of the specified probe. The histogram is
+read without locking, therefore a sample recorded concurrently might only be
+partly contained in the copy.
+
+\param[in]      probe_p             Latency probe
+\param[out]     pHistogram_p        Pointer to store the histogram
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+tOplkError latencyk_getHistogram(tLatencyProbe probe_p,
+                                 tLatencyHistogram* pHistogram_p)
+{
+    if ((probe_p >= kLatencyProbeCount) || (pHistogram_p == NULL))
+        return kErrorInvalidInstanceParam;
+
+    if (latencykInstance_l.aProbe[probe_p].fResetRequest)
+        clearHistogram(pHistogram_p);
+    else
+        OPLK_MEMCPY(pHistogram_p,
+                    &latencykInstance_l.aProbe[probe_p].histogram,
+                    sizeof(tLatencyHistogram));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset latency histograms
+
+The function requests a reset of all latency histograms. The histograms are
+cleared by their writers before the next sample is recorded.
+
+\ingroup module_latencyk
+*/
+//------------------------------------------------------------------------------
+void latencyk_reset(void)
+{
+    tLatencyProbe   probe;
+
+    for (probe = 0; probe < kLatencyProbeCount; probe++)
+        latencykInstance_l.aProbe[probe].fResetRequest = TRUE;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear histogram
+
+The function clears the specified histogram.
+
+\param[out]     pHistogram_p        Pointer to histogram
+*/
+//------------------------------------------------------------------------------
+static void clearHistogram(tLatencyHistogram* pHistogram_p)
+{
+    OPLK_MEMSET(pHistogram_p, 0, sizeof(tLatencyHistogram));
+    pHistogram_p->minLatency = 0xFFFFFFFFUL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get histogram bucket index
+
+The function returns the index of the histogram bucket for the specified
+latency. It is the position of the highest bit set in the latency value.
+
+\param[in]      latency_p           Latency in nanoseconds
+
+\return The function returns the bucket index.
+*/
+//------------------------------------------------------------------------------
+static UINT getBucketIndex(UINT32 latency_p)
+{
+    UINT    index = 0;
+
+    if (latency_p >= 0x00010000UL)
+    {
+        latency_p >>= 16;
+        index += 16;
+    }
+
+    if (latency_p >= 0x00000100UL)
+    {
+        latency_p >>= 8;
+        index += 8;
+    }
+
+    if (latency_p >= 0x00000010UL)
+    {
+        latency_p >>= 4;
+        index += 4;
+    }
+
+    if (latency_p >= 0x00000004UL)
+    {
+        latency_p >>= 2;
+        index += 2;
+    }
+
+    if (latency_p >= 0x00000002UL)
+        index += 1;
+
+    return index;
+}
+
+/// \}
@@ -48,6 +48,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/ami.h>
 #include <oplk/debugstr.h>
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+#include <kernel/latencyk.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -400,14 +404,16 @@ The function processes a received RxPDO.
 //------------------------------------------------------------------------------
 tOplkError pdok_processRxPdo(const tPlkFrame* pFrame_p, UINT frameSize_p)
 {
-    tOplkError      ret = kErrorOk;
-    BYTE            frameData;
-    UINT            nodeId;
-    tMsgType        msgType;
-    tPdoChannel*    pPdoChannel;
-    UINT            channelId;
-    UINT8           index;
-    UINT16          pdoPayloadSize;
+    tOplkError              ret = kErrorOk;
+    BYTE                    frameData;
+    UINT                    nodeId;
+    tMsgType                msgType;
+    const tPdoklutEntry*    pLutEntry;
+    const tPdoklutChannel*  pLutChannel;
+    const UINT8*            pPayload;
+    UINT8                   pdoVersion;
+    UINT8                   index;
+    UINT16                  pdoPayloadSize;
 
     // Check parameter validity
     ASSERT(pFrame_p != NULL);
@@ -437,42 +443,36 @@ tOplkError pdok_processRxPdo(const tPlkFrame* pFrame_p, UINT frameSize_p)
 
     if (pdokInstance_g.fRunning)
     {
-        // Get PDO channel reference
-        index = 0;
-        while ((channelId = pdoklut_getChannel(pdokInstance_g.aRxPdoLut, index, nodeId)) != PDOKLUT_INVALID_CHANNEL)
+        // Get the channel descriptors of the node
+        pLutEntry = &pdokInstance_g.aRxPdoLut[nodeId];
+        if (pLutEntry->channelCount == 0)
+            goto Exit;
+
+        // retrieve PDO version and payload size from frame
+        pdoVersion = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion) & PLK_VERSION_MAIN;
+        pdoPayloadSize = ami_getUint16Le(&pFrame_p->data.pres.sizeLe);
+        pPayload = &pFrame_p->data.pres.aPayload[0];
+
+        for (index = 0; index < pLutEntry->channelCount; index++)
         {
-            index++;
-            pPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[channelId];
+            pLutChannel = &pLutEntry->aChannel[index];
 
-            // retrieve PDO version from frame
-            frameData = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion);
-            if ((pPdoChannel->mappingVersion & PLK_VERSION_MAIN) != (frameData & PLK_VERSION_MAIN))
+            if ((pLutChannel->mappingVersion & PLK_VERSION_MAIN) != pdoVersion)
             {   // PDO versions do not match
                 // $$$ raise PDO error E_PDO_MAP_VERS
                 // terminate processing of this RPDO
                 goto Exit;
             }
 
-            // valid RPDO found
-            pdoPayloadSize = ami_getUint16Le(&pFrame_p->data.pres.sizeLe);
-            if (pPdoChannel->nextChannelOffset > pdoPayloadSize)
+            if (pLutChannel->nextChannelOffset > pdoPayloadSize)
             {   // RPDO is too short
                 // $$$ raise PDO error E_PDO_SHORT_RX, set Ret
                 goto Exit;
             }
 
-            /*
-            TRACE("%s() Channel:%d Node:%d MapObjectCnt:%d PdoSize:%d\n",
-                  __func__,
-                  channelId,
-                  nodeId,
-                  pPdoChannel->mappObjectCount,
-                  pPdoChannel->pdoSize);
-            */
-
-            pdokcal_writeRxPdo(channelId,
-                               &pFrame_p->data.pres.aPayload[0] + pPdoChannel->offset,
-                               pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+            pdokcal_writeRxPdo(pLutChannel->channelId,
+                               pPayload + pLutChannel->offset,
+                               pLutChannel->size);
         }
     }
 
@@ -580,14 +580,15 @@ This function copies a PDO into the specified frame.
 //---------------------------------------------------------------------------
 static tOplkError copyTxPdo(tPlkFrame* pFrame_p, UINT frameSize_p, BOOL fReadyFlag_p)
 {
-    tOplkError          ret = kErrorOk;
-    BYTE                flag1;
-    UINT                nodeId;
-    tMsgType            msgType;
-    tPdoChannel*        pPdoChannel;
-    UINT                channelId;
-    UINT16              pdoSize;
-    UINT                index;
+    tOplkError              ret = kErrorOk;
+    BYTE                    flag1;
+    UINT                    nodeId;
+    tMsgType                msgType;
+    const tPdoklutEntry*    pLutEntry;
+    const tPdoklutChannel*  pLutChannel;
+    UINT8*                  pPayload;
+    UINT16                  pdoSize;
+    UINT                    index;
 
     // set TPDO invalid, so that only fully processed TPDOs are sent as valid
     flag1 = ami_getUint8Le(&pFrame_p->data.pres.flag1);
@@ -607,32 +608,33 @@ static tOplkError copyTxPdo(tPlkFrame* pFrame_p, UINT frameSize_p, BOOL fReadyFl
 
     if (pdokInstance_g.fRunning)
     {
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+        // the first TPDO of the cycle starts the measurement
+        if (latencyk_getStartTimestamp(kLatencyProbeTpdoToTx) == 0)
+            latencyk_start(kLatencyProbeTpdoToTx, latencyk_getTimestamp());
+#endif
+
         pdoSize = 0;
 
-        // Get PDO channel reference
-        index = 0;
-        while ((channelId = pdoklut_getChannel(pdokInstance_g.aTxPdoLut, index, nodeId)) != PDOKLUT_INVALID_CHANNEL)
-        {
-            index++;
-            pPdoChannel = &pdokInstance_g.pdoChannels.pTxPdoChannel[channelId];
+        // Get the channel descriptors of the node
+        pLutEntry = &pdokInstance_g.aTxPdoLut[nodeId];
+        pPayload = &pFrame_p->data.pres.aPayload[0];
 
-            // TRACE("%s() Channel:%d Node:%d MapObjectCnt:%d PdoSize:%d\n",
-            //      __func__,
-            //      channelId,
-            //      nodeId,
-            //      pPdoChannel->mappObjectCount,
-            //      pPdoChannel->pdoSize);
+        for (index = 0; index < pLutEntry->channelCount; index++)
+        {
+            pLutChannel = &pLutEntry->aChannel[index];
 
-            if ((UINT32)(pPdoChannel->nextChannelOffset + 24) <= frameSize_p)
+            if ((UINT32)(pLutChannel->nextChannelOffset + 24) <= frameSize_p)
             {
                 // set PDO version in frame
-                ami_setUint8Le(&pFrame_p->data.pres.pdoVersion, pPdoChannel->mappingVersion);
+                ami_setUint8Le(&pFrame_p->data.pres.pdoVersion, pLutChannel->mappingVersion);
 
-                pdokcal_readTxPdo(channelId, &pFrame_p->data.pres.aPayload[0] + pPdoChannel->offset,
-                                  pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+                pdokcal_readTxPdo(pLutChannel->channelId,
+                                  pPayload + pLutChannel->offset,
+                                  pLutChannel->size);
 
                 // set PDO size in frame
-                pdoSize = pPdoChannel->nextChannelOffset;
+                pdoSize = pLutChannel->nextChannelOffset;
             }
             else
             {   // TPDO is too short or invalid
@@ -641,7 +643,6 @@ static tOplkError copyTxPdo(tPlkFrame* pFrame_p, UINT frameSize_p, BOOL fReadyFl
                 break;
             }
         }
-
     }
     else
     {
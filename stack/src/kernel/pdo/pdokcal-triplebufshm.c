@@ -156,13 +156,13 @@ tOplkError pdokcal_initPdoMem(const tPdoChannelSetup* pPdoChannels,
     if (pPdoMem_l != NULL)
         pdokcal_freeMem((BYTE*)pPdoMem_l, pdoMemRegionSize_l);
 
-    pdoMemRegionSize_l = (pdoMemSize * 3) + sizeof(tPdoMemRegion);
+    pdoMemRegionSize_l = (pdoMemSize * 3) + PDO_CHANNEL_ALIGN(sizeof(tPdoMemRegion));
     if (pdokcal_allocateMem(pdoMemRegionSize_l, &pMem) != kErrorOk)
         return kErrorNoResource;
 
     pPdoMem_l = (tPdoMemRegion*)pMem;
 
-    pTripleBuf_l[0] = (BYTE*)pPdoMem_l + sizeof(tPdoMemRegion);
+    pTripleBuf_l[0] = (BYTE*)pPdoMem_l + PDO_CHANNEL_ALIGN(sizeof(tPdoMemRegion));
     pTripleBuf_l[1] = pTripleBuf_l[0] + pdoMemSize;
     pTripleBuf_l[2] = pTripleBuf_l[1] + pdoMemSize;
 
@@ -320,7 +320,8 @@ tOplkError pdokcal_readTxPdo(UINT channelId_p, UINT8* pPayload_p, UINT16 pdoSize
 \brief  Setup PDO memory info
 
 The function sets up the PDO memory info. For each channel the offset in the
-shared buffer and the size are stored.
+shared buffer and the size are stored. The channel offsets are aligned with
+\ref PDO_CHANNEL_ALIGN.
 
 \param[in]      pPdoChannels_p      Pointer to PDO channel setup.
 \param[in,out]  pPdoMemRegion_p     Pointer to shared PDO memory region.
@@ -344,7 +345,7 @@ static void setupPdoMemInfo(const tPdoChannelSetup* pPdoChannels_p,
         pPdoMemRegion_p->rxChannelInfo[channelId].writeBuf = 1;
         pPdoMemRegion_p->rxChannelInfo[channelId].cleanBuf = 2;
         pPdoMemRegion_p->rxChannelInfo[channelId].newData = 0;
-        offset += pPdoChannel->nextChannelOffset - pPdoChannel->offset;
+        offset += PDO_CHANNEL_ALIGN(pPdoChannel->nextChannelOffset - pPdoChannel->offset);
     }
 
     for (channelId = 0, pPdoChannel = pPdoChannels_p->pTxPdoChannel;
@@ -357,7 +358,7 @@ static void setupPdoMemInfo(const tPdoChannelSetup* pPdoChannels_p,
         pPdoMemRegion_p->txChannelInfo[channelId].writeBuf = 1;
         pPdoMemRegion_p->txChannelInfo[channelId].cleanBuf = 2;
         pPdoMemRegion_p->txChannelInfo[channelId].newData = 0;
-        offset += pPdoChannel->nextChannelOffset - pPdoChannel->offset;
+        offset += PDO_CHANNEL_ALIGN(pPdoChannel->nextChannelOffset - pPdoChannel->offset);
     }
     pPdoMemRegion_p->pdoMemSize = offset;
 
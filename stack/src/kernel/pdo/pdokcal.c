@@ -47,6 +47,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/eventk.h>
 #include <common/ami.h>
 
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+#include <kernel/latencyk.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -188,6 +192,13 @@ tOplkError pdokcal_process(const tEvent* pEvent_p)
 
                 pFrame = (const tPlkFrame*)pEvent_p->eventArg.pEventArg;
                 ret = pdok_processRxPdo(pFrame, pEvent_p->eventArgSize);
+#endif
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+                if (pEvent_p->netTime.nsec != 0)
+                {
+                    latencyk_record(kLatencyProbeRxToPdo,
+                                    latencyk_getTimestamp() - pEvent_p->netTime.nsec);
+                }
 #endif
             }
             break;
@@ -227,6 +238,11 @@ static tOplkError cbProcessRpdo(const tFrameInfo* pFrameInfo_p)
 
     event.eventSink = kEventSinkPdokCal;
     event.eventType = kEventTypePdoRx;
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+    // forward Rx timestamp of the frame to the RPDO processing
+    event.netTime.sec = 0;
+    event.netTime.nsec = latencyk_getStartTimestamp(kLatencyProbeRxToPdo);
+#endif
 #if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE)
     event.eventArgSize = sizeof(tFrameInfo);
     event.eventArg.pEventArg = (void*)pFrameInfo_p;
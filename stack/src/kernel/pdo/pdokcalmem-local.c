@@ -76,6 +76,9 @@ UINT8*  pdokcalmem_pPdo_g;
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+#if (CONFIG_PDO_CACHE_LINE_SIZE > 0)
+static UINT8*   pPdoMemAlloc_l;     ///< Allocated memory block containing the aligned PDO memory
+#endif
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -144,6 +147,17 @@ tOplkError pdokcal_allocateMem(size_t memSize_p, UINT8** ppPdoMem_p)
 
     DEBUG_LVL_PDO_TRACE("%s()\n", __func__);
 
+#if (CONFIG_PDO_CACHE_LINE_SIZE > 0)
+    // The PDO memory must start at a cache line boundary
+    pPdoMemAlloc_l = (UINT8*)OPLK_MALLOC(memSize_p + CONFIG_PDO_CACHE_LINE_SIZE - 1);
+    if (pPdoMemAlloc_l == NULL)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() malloc failed!\n", __func__);
+        *ppPdoMem_p = NULL;
+        return kErrorNoResource;
+    }
+    pdokcalmem_pPdo_g = (UINT8*)PDO_CHANNEL_ALIGN((size_t)pPdoMemAlloc_l);
+#else
     pdokcalmem_pPdo_g = (UINT8*)OPLK_MALLOC(memSize_p);
     if (pdokcalmem_pPdo_g == NULL)
     {
@@ -151,6 +165,7 @@ tOplkError pdokcal_allocateMem(size_t memSize_p, UINT8** ppPdoMem_p)
         *ppPdoMem_p = NULL;
         return kErrorNoResource;
     }
+#endif
     *ppPdoMem_p = pdokcalmem_pPdo_g;
 
     DEBUG_LVL_PDO_TRACE("%s() Allocated memory for PDO at %p size:%d\n",
@@ -184,7 +199,13 @@ tOplkError pdokcal_freeMem(UINT8* pMem_p, size_t memSize_p)
     ASSERT(pMem_p != NULL);
 
     DEBUG_LVL_PDO_TRACE("%s()\n", __func__);
+#if (CONFIG_PDO_CACHE_LINE_SIZE > 0)
+    UNUSED_PARAMETER(pMem_p);
+    OPLK_FREE(pPdoMemAlloc_l);
+    pPdoMemAlloc_l = NULL;
+#else
     OPLK_FREE(pMem_p);
+#endif
 
     return kErrorOk;
 }
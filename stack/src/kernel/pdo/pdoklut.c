@@ -107,9 +107,10 @@ void pdoklut_clear(tPdoklutEntry* pLut_p, UINT32 numEntries_p)
 
     for (i = 0; i < numEntries_p; ++i)
     {
+        pLut_p[i].channelCount = 0;
         for (j = 0; j < PDOKLUT_MAX_CHANNELS_PER_NODE; ++j)
         {
-            pLut_p[i].channelId[j] = PDOKLUT_INVALID_CHANNEL;
+            pLut_p[i].aChannel[j].channelId = PDOKLUT_INVALID_CHANNEL;
         }
     }
 }
@@ -118,7 +119,10 @@ void pdoklut_clear(tPdoklutEntry* pLut_p, UINT32 numEntries_p)
 /**
 \brief  Add a new PDO channel to the lookup table
 
-This function adds a new PDO channel to the lookup table.
+This function adds a new PDO channel to the lookup table. The channel
+parameters needed for processing a frame are stored in the channel descriptor
+of the node's lookup table entry. If the channel is already contained in the
+entry, its descriptor is updated.
 
 \param[in,out]  pLut_p              Pointer to the PDO lookup table
 \param[in]      pPdoChannel_p       Pointer to the PDO channel which should be added to
@@ -134,9 +138,10 @@ tOplkError pdoklut_addChannel(tPdoklutEntry* pLut_p,
                               const tPdoChannel* pPdoChannel_p,
                               UINT channelId_p)
 {
-    tOplkError      ret = kErrorIllegalInstance;
-    int             i;
-    UINT8           nodeId;
+    int                 i;
+    UINT8               nodeId;
+    tPdoklutEntry*      pEntry;
+    tPdoklutChannel*    pChannel;
 
     // Check parameter validity
     ASSERT(pLut_p != NULL);
@@ -144,20 +149,31 @@ tOplkError pdoklut_addChannel(tPdoklutEntry* pLut_p,
 
     nodeId = pPdoChannel_p->nodeId;
     if (nodeId == 255)
-        return ret;
+        return kErrorIllegalInstance;
 
-    for (i = 0; i < PDOKLUT_MAX_CHANNELS_PER_NODE; ++i)
+    pEntry = &pLut_p[nodeId];
+    for (i = 0; i < pEntry->channelCount; ++i)
     {
-        if (pLut_p[nodeId].channelId[i] == PDOKLUT_INVALID_CHANNEL)
-        {
-            DEBUG_LVL_PDO_TRACE ("Adding PDO Lut channel:%d node:%d index:%d\n", channelId_p, nodeId, i);
-            pLut_p[nodeId].channelId[i] = channelId_p;
-            ret = kErrorOk;
+        if (pEntry->aChannel[i].channelId == channelId_p)
             break;
-        }
     }
 
-    return ret;
+    if (i >= PDOKLUT_MAX_CHANNELS_PER_NODE)
+        return kErrorIllegalInstance;
+
+    DEBUG_LVL_PDO_TRACE ("Adding PDO Lut channel:%d node:%d index:%d\n", channelId_p, nodeId, i);
+
+    pChannel = &pEntry->aChannel[i];
+    pChannel->offset = pPdoChannel_p->offset;
+    pChannel->size = pPdoChannel_p->nextChannelOffset - pPdoChannel_p->offset;
+    pChannel->nextChannelOffset = pPdoChannel_p->nextChannelOffset;
+    pChannel->mappingVersion = pPdoChannel_p->mappingVersion;
+    pChannel->channelId = (UINT8)channelId_p;
+
+    if (i == pEntry->channelCount)
+        pEntry->channelCount++;
+
+    return kErrorOk;
 }
 
 //------------------------------------------------------------------------------
@@ -182,16 +198,16 @@ UINT pdoklut_getChannel(const tPdoklutEntry* pLut_p, UINT8 index_p, UINT8 nodeId
     // Check parameter validity
     ASSERT(pLut_p != NULL);
 
-    if (index_p >= PDOKLUT_MAX_CHANNELS_PER_NODE)
+    if (index_p >= pLut_p[nodeId_p].channelCount)
     {
         DEBUG_LVL_PDO_TRACE("%s() INVALID CHANNEL: index:%d nodeId:%d\n", __func__, index_p, nodeId_p);
         return PDOKLUT_INVALID_CHANNEL;
     }
 
     DEBUG_LVL_PDO_TRACE ("%s() channel:%d index:%d nodeId:%d\n",
-            __func__, pLut_p[nodeId_p].channelId[index_p], index_p, nodeId_p);
+            __func__, pLut_p[nodeId_p].aChannel[index_p].channelId, index_p, nodeId_p);
 
-   return pLut_p[nodeId_p].channelId[index_p];
+   return pLut_p[nodeId_p].aChannel[index_p].channelId;
 }
 
 //============================================================================//
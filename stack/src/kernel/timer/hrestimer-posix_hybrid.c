@@ -0,0 +1,771 @@
+/**
+********************************************************************************
+\file   hrestimer-posix_hybrid.c
+
+\brief  High-resolution timer module for Linux using a hybrid sleep/spin thread
+
+This module is the target specific implementation of the high-resolution
+timer module for Linux userspace. All timers are served by a single timer
+thread. The thread sleeps until shortly before the next deadline and busy-waits
+on CLOCK_MONOTONIC for the remaining time (the spin window), so the wakeup
+latency of the operating system does not delay the timer callback. If the
+process can only run on a single CPU, busy-waiting is disabled.
+
+The timer thread can be bound to a dedicated CPU core and optionally runs with
+the SCHED_DEADLINE policy. If CONFIG_LATENCY_HISTOGRAM is enabled, the sleep
+overshoot and the lateness of the callbacks are recorded by the latencyk
+module.
+
+\ingroup module_hrestimer
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/hrestimer.h>
+
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+#include <kernel/latencyk.h>
+#endif
+
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TIMER_COUNT             2           ///< number of high-resolution timers
+#define TIMER_MIN_VAL_SINGLE    20000       ///< minimum timer interval for single timeouts
+#define TIMER_MIN_VAL_CYCLE     100000      ///< minimum timer interval for continuous timeouts
+
+/* macros for timer handles */
+#define TIMERHDL_MASK           0x0FFFFFFF
+#define TIMERHDL_SHIFT          28
+#define HDL_TO_IDX(hdl)         ((hdl >> TIMERHDL_SHIFT) - 1)
+#define HDL_INIT(idx)           ((idx + 1) << TIMERHDL_SHIFT)
+#define HDL_INC(hdl)            (((hdl + 1) & TIMERHDL_MASK) | (hdl & ~TIMERHDL_MASK))
+
+#ifndef CONFIG_HRESTIMER_SPIN_WINDOW
+#define CONFIG_HRESTIMER_SPIN_WINDOW        50000           // Busy-wait time before a deadline [ns]
+#endif
+
+#ifndef CONFIG_HRESTIMER_CPU
+#define CONFIG_HRESTIMER_CPU                -1              // CPU core of the timer thread (-1 = not bound)
+#endif
+
+#ifndef CONFIG_HRESTIMER_SCHED_DEADLINE
+#define CONFIG_HRESTIMER_SCHED_DEADLINE     FALSE           // Run the timer thread with SCHED_DEADLINE
+#endif
+
+#ifndef CONFIG_HRESTIMER_DEADLINE_RUNTIME
+#define CONFIG_HRESTIMER_DEADLINE_RUNTIME   50              // SCHED_DEADLINE runtime [% of the timer period]
+#endif
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//          P R I V A T E   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define NSEC_PER_SEC            1000000000ULL
+
+#if (CONFIG_HRESTIMER_SCHED_DEADLINE != FALSE)
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE          6
+#endif
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  High-resolution timer information structure
+
+The structure contains all necessary information for a high-resolution timer.
+*/
+typedef struct
+{
+    tTimerEventArg      eventArg;           ///< Event argument
+    tTimerkCallback     pfnCallback;        ///< Pointer to timer callback function
+    ULONGLONG           deadline;           ///< Absolute expiry time on CLOCK_MONOTONIC [ns]
+    ULONGLONG           period;             ///< Timer period [ns]
+    BOOL                fContinue;          ///< Flag determines if timer will be restarted continuously
+    BOOL                fArmed;             ///< Flag determines if the timer is running
+} tHresTimerInfo;
+
+/**
+\brief  High-resolution timer instance
+
+The structure defines a high-resolution timer module instance. The timer
+information is protected by the mutex. The generation counter is incremented
+with every change of the timers, so the timer thread can detect changes while it
+busy-waits without taking the mutex.
+*/
+typedef struct
+{
+    tHresTimerInfo      aTimerInfo[TIMER_COUNT];    ///< Array with timer information for a set of timers
+    pthread_t           threadId;                   ///< Timer thread Id
+    pthread_mutex_t     mutex;                      ///< Mutex protecting the timer information
+    pthread_cond_t      cond;                       ///< Condition signaling timer changes to the thread
+    UINT32              generation;                 ///< Change counter of the timer information
+    ULONGLONG           spinWindow;                 ///< Busy-wait time before a deadline [ns]
+    BOOL                fTerminate;                 ///< Thread termination flag
+#if (CONFIG_HRESTIMER_SCHED_DEADLINE != FALSE)
+    ULONGLONG           deadlinePeriod;             ///< Period of the applied SCHED_DEADLINE parameters
+#endif
+} tHresTimerInstance;
+
+#if (CONFIG_HRESTIMER_SCHED_DEADLINE != FALSE)
+/**
+\brief  Scheduling attributes
+
+The structure corresponds to struct sched_attr of the Linux kernel, which is
+not provided by all C libraries.
+*/
+typedef struct
+{
+    UINT32              size;               ///< Size of the structure
+    UINT32              schedPolicy;        ///< Scheduling policy
+    UINT64              schedFlags;         ///< Scheduling flags
+    INT32               schedNice;          ///< Nice value (SCHED_OTHER, SCHED_BATCH)
+    UINT32              schedPriority;      ///< Static priority (SCHED_FIFO, SCHED_RR)
+    UINT64              schedRuntime;       ///< Runtime (SCHED_DEADLINE) [ns]
+    UINT64              schedDeadline;      ///< Relative deadline (SCHED_DEADLINE) [ns]
+    UINT64              schedPeriod;        ///< Period (SCHED_DEADLINE) [ns]
+} tSchedAttr;
+#endif
+
+//------------------------------------------------------------------------------
+// module local vars
+//------------------------------------------------------------------------------
+static tHresTimerInstance       hresTimerInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void* timerThread(void* pParm_p);
+static tHresTimerInfo* getNextTimer(void);
+static void signalChange(void);
+static inline ULONGLONG getTime(void);
+static inline void toTimespec(ULONGLONG time_p, struct timespec* pTimespec_p);
+#if (CONFIG_HRESTIMER_SCHED_DEADLINE != FALSE)
+static void applyDeadlineScheduling(ULONGLONG period_p);
+#endif
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief    Initialize high-resolution timer module
+
+The function initializes the high-resolution timer module
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_init(void)
+{
+    struct sched_param  schedParam;
+    pthread_condattr_t  condAttr;
+    cpu_set_t           cpuSet;
+
+    OPLK_MEMSET(&hresTimerInstance_l, 0, sizeof(hresTimerInstance_l));
+
+    // Busy-waiting on a single CPU would starve the threads which restart or
+    // delete the timers (e.g. the Rx thread on a CN), so the thread only sleeps.
+    hresTimerInstance_l.spinWindow = CONFIG_HRESTIMER_SPIN_WINDOW;
+    if ((sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0) && (CPU_COUNT(&cpuSet) < 2))
+    {
+        DEBUG_LVL_TIMERH_TRACE("%s() Single CPU, busy-waiting disabled\n", __func__);
+        hresTimerInstance_l.spinWindow = 0;
+    }
+
+    if (pthread_mutex_init(&hresTimerInstance_l.mutex, NULL) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't init mutex!\n", __func__);
+        return kErrorNoResource;
+    }
+
+    // the thread sleeps until absolute times on CLOCK_MONOTONIC
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&hresTimerInstance_l.cond, &condAttr) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't init condition variable!\n", __func__);
+        pthread_condattr_destroy(&condAttr);
+        pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+        return kErrorNoResource;
+    }
+    pthread_condattr_destroy(&condAttr);
+
+    if (pthread_create(&hresTimerInstance_l.threadId, NULL,
+                       timerThread, NULL) != 0)
+    {
+        pthread_cond_destroy(&hresTimerInstance_l.cond);
+        pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+        return kErrorNoResource;
+    }
+
+    // A SCHED_DEADLINE thread must not be restricted to a subset of the CPUs
+#if (CONFIG_HRESTIMER_CPU >= 0) && (CONFIG_HRESTIMER_SCHED_DEADLINE == FALSE)
+    CPU_ZERO(&cpuSet);
+    CPU_SET(CONFIG_HRESTIMER_CPU, &cpuSet);
+    if (pthread_setaffinity_np(hresTimerInstance_l.threadId, sizeof(cpuSet), &cpuSet) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't bind timer thread to CPU %d!\n",
+                              __func__, CONFIG_HRESTIMER_CPU);
+    }
+#endif
+
+    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_HIGH;
+    if (pthread_setschedparam(hresTimerInstance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
+        hrestimer_exit();
+        return kErrorNoResource;
+    }
+
+#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
+    pthread_setname_np(hresTimerInstance_l.threadId, "oplk-hrtimer");
+#endif
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Shut down high-resolution timer module
+
+The function shuts down the high-resolution timer module.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_exit(void)
+{
+    tHresTimerInfo*     pTimerInfo;
+    UINT                index;
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+        pTimerInfo->eventArg.timerHdl.handle = 0;
+        pTimerInfo->pfnCallback = NULL;
+        pTimerInfo->fArmed = FALSE;
+    }
+
+    /* send exit signal to thread */
+    hresTimerInstance_l.fTerminate = TRUE;
+    signalChange();
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    /* wait until thread terminates */
+    DEBUG_LVL_TIMERH_TRACE("%s() Waiting for thread to exit...\n", __func__);
+    pthread_join(hresTimerInstance_l.threadId, NULL);
+    DEBUG_LVL_TIMERH_TRACE("%s() Thread exited!\n", __func__);
+
+    pthread_cond_destroy(&hresTimerInstance_l.cond);
+    pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Modify a high-resolution timer
+
+The function modifies the timeout of the timer with the specified handle.
+If the handle to which the pointer points to is zero, the timer must be created
+first. If it is not possible to stop the old timer, this function always assures
+that the old timer does not trigger the callback function with the same handle
+as the new timer. That means the callback function must check the passed handle
+with the one returned by this function. If these are unequal, the call can be
+discarded.
+
+\param[in,out]  pTimerHdl_p         Pointer to timer handle.
+\param[in]      time_p              Relative timeout in [ns].
+\param[in]      pfnCallback_p       Callback function, which is called when timer expires.
+                                    (The function is called mutually exclusive with
+                                    the Edrv callback functions (Rx and Tx)).
+\param[in]      argument_p          User-specific argument.
+\param[in]      fContinue_p         If TRUE, the callback function will be called continuously.
+                                    Otherwise, it is a one-shot timer.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_modifyTimer(tTimerHdl* pTimerHdl_p,
+                                 ULONGLONG time_p,
+                                 tTimerkCallback pfnCallback_p,
+                                 ULONG argument_p,
+                                 BOOL fContinue_p)
+{
+    tOplkError          ret = kErrorOk;
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+    ULONGLONG           startTime;
+
+    // check pointer to handle
+    if (pTimerHdl_p == NULL)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Invalid timer handle\n", __func__);
+        return kErrorTimerInvalidHandle;
+    }
+
+    // take the start time before waiting for the mutex
+    startTime = getTime();
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    if (*pTimerHdl_p == 0)
+    {   // no timer created yet -> search free timer info structure
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[0];
+        for (index = 0; index < TIMER_COUNT; index++, pTimerInfo++)
+        {
+            if (pTimerInfo->eventArg.timerHdl.handle == 0)
+            {   // free structure found
+                break;
+            }
+        }
+        if (index >= TIMER_COUNT)
+        {   // no free structure found
+            DEBUG_LVL_ERROR_TRACE("%s() Invalid timer index:%d\n", __func__, index);
+            ret = kErrorTimerNoTimerCreated;
+            goto Exit;
+        }
+        pTimerInfo->eventArg.timerHdl.handle = HDL_INIT(index);
+    }
+    else
+    {
+        index = HDL_TO_IDX(*pTimerHdl_p);
+        if (index >= TIMER_COUNT)
+        {   // invalid handle
+            DEBUG_LVL_ERROR_TRACE("%s() Invalid timer index:%d\n", __func__, index);
+            ret = kErrorTimerInvalidHandle;
+            goto Exit;
+        }
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+    }
+
+    // increase too small time values
+    if (fContinue_p != FALSE)
+    {
+        if (time_p < TIMER_MIN_VAL_CYCLE)
+            time_p = TIMER_MIN_VAL_CYCLE;
+    }
+    else
+    {
+        if (time_p < TIMER_MIN_VAL_SINGLE)
+            time_p = TIMER_MIN_VAL_SINGLE;
+    }
+
+    /* increment timer handle
+     * (if timer expires right after this statement, the user
+     * would detect an unknown timer handle and discard it) */
+    pTimerInfo->eventArg.timerHdl.handle = HDL_INC(pTimerInfo->eventArg.timerHdl.handle);
+    *pTimerHdl_p = pTimerInfo->eventArg.timerHdl.handle;
+
+    /* initialize timer info */
+    pTimerInfo->eventArg.argument.value = argument_p;
+    pTimerInfo->pfnCallback = pfnCallback_p;
+    pTimerInfo->fContinue = fContinue_p;
+    pTimerInfo->period = time_p;
+    pTimerInfo->deadline = startTime + time_p;
+    pTimerInfo->fArmed = TRUE;
+
+    DEBUG_LVL_TIMERH_TRACE("%s() timer:%lx timeout=%llu ns\n", __func__,
+                           pTimerInfo->eventArg.timerHdl.handle, time_p);
+
+    signalChange();
+
+Exit:
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Delete a high-resolution timer
+
+The function deletes a created high-resolution timer. The timer is specified
+by its timer handle. After deleting, the handle is reset to zero.
+
+\param[in,out]  pTimerHdl_p         Pointer to timer handle.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    tOplkError          ret = kErrorOk;
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    DEBUG_LVL_TIMERH_TRACE("%s() Deleting timer:%lx\n", __func__, *pTimerHdl_p);
+
+    if (*pTimerHdl_p == 0)
+    {   // no timer created yet
+        return ret;
+    }
+
+    index = HDL_TO_IDX(*pTimerHdl_p);
+    if (index >= TIMER_COUNT)
+    {   // invalid handle
+        return kErrorTimerInvalidHandle;
+    }
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+    if (pTimerInfo->eventArg.timerHdl.handle == *pTimerHdl_p)
+    {
+        *pTimerHdl_p = 0;
+        pTimerInfo->eventArg.timerHdl.handle = 0;
+        pTimerInfo->pfnCallback = NULL;
+        pTimerInfo->fArmed = FALSE;
+        signalChange();
+    }
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Control external synchronization interrupt
+
+This function enables/disables the external synchronization interrupt. If the
+external synchronization interrupt is not supported, the call is ignored.
+
+\param[in]      fEnable_p           Flag determines if sync should be enabled or disabled.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+void hrestimer_controlExtSyncIrq(BOOL fEnable_p)
+{
+    UNUSED_PARAMETER(fEnable_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set external synchronization interrupt time
+
+This function sets the time when the external synchronization interrupt shall
+be triggered to synchronize the host processor. If the external synchronization
+interrupt is not supported, the call is ignored.
+
+\param[in]      time_p              Time when the sync shall be triggered
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+void hrestimer_setExtSyncIrqTime(tTimestamp time_p)
+{
+    UNUSED_PARAMETER(time_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief    Timer thread function
+
+The function provides the main function of the timer thread. It serves all
+timers. The thread sleeps on the condition variable until the spin window of
+the next deadline begins or the timers are changed. Within the spin window it
+busy-waits without holding the mutex until the deadline is reached. If the
+timers are changed meanwhile, the next deadline is determined again. Finally
+the callback of the expired timer is called and a continuous timer is
+restarted relative to its last deadline.
+
+\param[in,out]  pParm_p             Thread parameter (unused!)
+
+\return Returns a void* as specified by the pthread interface but it is not used!
+*/
+//------------------------------------------------------------------------------
+static void* timerThread(void* pParm_p)
+{
+    tHresTimerInfo*     pTimerInfo;
+    tTimerkCallback     pfnCallback;
+    tTimerHdl           timerHdl;
+    ULONGLONG           deadline;
+    ULONGLONG           wakeupTime;
+    ULONGLONG           now;
+    UINT32              generation;
+    struct timespec     timeout;
+    int                 result;
+
+    UNUSED_PARAMETER(pParm_p);
+
+    DEBUG_LVL_TIMERH_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    while (!hresTimerInstance_l.fTerminate)
+    {
+        pTimerInfo = getNextTimer();
+        if (pTimerInfo == NULL)
+        {
+            pthread_cond_wait(&hresTimerInstance_l.cond, &hresTimerInstance_l.mutex);
+            continue;
+        }
+
+#if (CONFIG_HRESTIMER_SCHED_DEADLINE != FALSE)
+        if (pTimerInfo->fContinue && (pTimerInfo->period != hresTimerInstance_l.deadlinePeriod))
+        {
+            applyDeadlineScheduling(pTimerInfo->period);
+        }
+#endif
+
+        deadline = pTimerInfo->deadline;
+        wakeupTime = (deadline > hresTimerInstance_l.spinWindow) ?
+                     (deadline - hresTimerInstance_l.spinWindow) : 0;
+
+        now = getTime();
+        if (now < wakeupTime)
+        {
+            // sleep until the spin window starts or the timers are changed
+            toTimespec(wakeupTime, &timeout);
+            result = pthread_cond_timedwait(&hresTimerInstance_l.cond,
+                                            &hresTimerInstance_l.mutex, &timeout);
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+            if (result == ETIMEDOUT)
+            {
+                now = getTime();
+                if (now > wakeupTime)
+                    latencyk_record(kLatencyProbeHresTimerWakeup, (UINT32)(now - wakeupTime));
+            }
+#else
+            UNUSED_PARAMETER(result);
+#endif
+            continue;
+        }
+
+        // busy-wait for the deadline, a change of the timers restarts the loop
+        generation = hresTimerInstance_l.generation;
+        pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+        while ((now < deadline) &&
+               (__atomic_load_n(&hresTimerInstance_l.generation, __ATOMIC_ACQUIRE) == generation))
+        {
+            now = getTime();
+        }
+
+        pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+        if (hresTimerInstance_l.generation != generation)
+            continue;
+
+        timerHdl = pTimerInfo->eventArg.timerHdl.handle;
+        pfnCallback = pTimerInfo->pfnCallback;
+
+        if (pTimerInfo->fContinue)
+        {
+            /* calculate timeout value for next timer cycle */
+            pTimerInfo->deadline += pTimerInfo->period;
+        }
+        else
+        {
+            pTimerInfo->fArmed = FALSE;
+        }
+
+        pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+#if (CONFIG_LATENCY_HISTOGRAM != FALSE)
+        latencyk_record(kLatencyProbeHresTimerLateness, (UINT32)(getTime() - deadline));
+#endif
+
+        /* call callback function, the timer could be modified in the meantime */
+        if ((pfnCallback != NULL) && (timerHdl == pTimerInfo->eventArg.timerHdl.handle))
+        {
+            pfnCallback(&pTimerInfo->eventArg);
+        }
+
+        pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    }
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    DEBUG_LVL_TIMERH_TRACE("%s() Exiting!\n", __func__);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get next expiring timer
+
+The function returns the armed timer with the earliest deadline. It must be
+called with the mutex locked.
+
+\return Returns a pointer to the timer information or NULL if no timer is armed.
+*/
+//------------------------------------------------------------------------------
+static tHresTimerInfo* getNextTimer(void)
+{
+    tHresTimerInfo*     pNextTimer = NULL;
+    tHresTimerInfo*     pTimerInfo;
+    UINT                index;
+
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+        if (pTimerInfo->fArmed &&
+            ((pNextTimer == NULL) || (pTimerInfo->deadline < pNextTimer->deadline)))
+        {
+            pNextTimer = pTimerInfo;
+        }
+    }
+
+    return pNextTimer;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Signal a change of the timers
+
+The function notifies the timer thread about a change of the timer
+information. It must be called with the mutex locked.
+*/
+//------------------------------------------------------------------------------
+static void signalChange(void)
+{
+    __atomic_store_n(&hresTimerInstance_l.generation,
+                     hresTimerInstance_l.generation + 1, __ATOMIC_RELEASE);
+    pthread_cond_signal(&hresTimerInstance_l.cond);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get current time
+
+\return Returns the current time on CLOCK_MONOTONIC in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static inline ULONGLONG getTime(void)
+{
+    struct timespec     now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((ULONGLONG)now.tv_sec * NSEC_PER_SEC) + (ULONGLONG)now.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Convert nanoseconds to timespec
+
+\param[in]      time_p              Time in nanoseconds
+\param[out]     pTimespec_p         Pointer to store the converted time.
+*/
+//------------------------------------------------------------------------------
+static inline void toTimespec(ULONGLONG time_p, struct timespec* pTimespec_p)
+{
+    pTimespec_p->tv_sec = (time_t)(time_p / NSEC_PER_SEC);
+    pTimespec_p->tv_nsec = (long)(time_p % NSEC_PER_SEC);
+}
+
+#if (CONFIG_HRESTIMER_SCHED_DEADLINE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief    Apply SCHED_DEADLINE scheduling
+
+The function switches the calling timer thread to the SCHED_DEADLINE policy.
+The period and deadline are set to the period of the continuous timer, the
+runtime is CONFIG_HRESTIMER_DEADLINE_RUNTIME percent of it. The runtime has to
+cover the spin windows and all timer callbacks within a period, otherwise the
+thread is throttled until the next period. If the policy can't be applied, the
+thread keeps its SCHED_FIFO priority.
+
+\param[in]      period_p            Timer period in nanoseconds
+*/
+//------------------------------------------------------------------------------
+static void applyDeadlineScheduling(ULONGLONG period_p)
+{
+    tSchedAttr          attr;
+
+    hresTimerInstance_l.deadlinePeriod = period_p;
+
+    OPLK_MEMSET(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.schedPolicy = SCHED_DEADLINE;
+    attr.schedRuntime = (period_p * CONFIG_HRESTIMER_DEADLINE_RUNTIME) / 100;
+    attr.schedDeadline = period_p;
+    attr.schedPeriod = period_p;
+
+    if (syscall(SYS_sched_setattr, 0, &attr, 0) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set SCHED_DEADLINE (errno %d)!\n",
+                              __func__, errno);
+    }
+}
+#endif
+
+/// \}
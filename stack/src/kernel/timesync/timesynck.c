@@ -253,12 +253,14 @@ tOplkError timesynck_process(const tEvent* pEvent_p)
     return ret;
 }
 
-#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
 //------------------------------------------------------------------------------
 /**
 \brief  Set SoC time
 
-The function sets the given SoC time to the timesync module.
+The function sets the given SoC time to the timesync module. It is forwarded
+to the kernel CAL, which passes it to the user layer with the next sync event.
+If SoC time forwarding is enabled, it is also provided to the user layer
+through the SoC time triple buffer.
 
 \param[in]      pSocTime_p          Pointer to SoC time information structure
 
@@ -269,13 +271,21 @@ The function sets the given SoC time to the timesync module.
 //------------------------------------------------------------------------------
 tOplkError timesynck_setSocTime(const tTimesyncSocTime* pSocTime_p)
 {
+    tOplkError                  ret;
+#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     tTimesyncSocTimeTripleBuf*  pTripleBuf;
     OPLK_ATOMIC_T               writeBuf;
     tTimesyncSocTime*           pBuffer;
+#endif
 
     // Check parameter validity
     ASSERT(pSocTime_p != NULL);
 
+    ret = timesynckcal_setSocTime(pSocTime_p);
+    if (ret != kErrorOk)
+        return ret;
+
+#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     if (timesynckInstance_l.pSharedMemory == NULL)
     {
         // Looks like the CAL has no SoC time forward support, but feature is
@@ -301,10 +311,10 @@ tOplkError timesynck_setSocTime(const tTimesyncSocTime* pSocTime_p)
     OPLK_DCACHE_FLUSH(&pTripleBuf->clean, sizeof(pTripleBuf->clean));
     OPLK_DCACHE_FLUSH(&pTripleBuf->write, sizeof(pTripleBuf->write));
     OPLK_DCACHE_FLUSH(&pTripleBuf->newData, sizeof(pTripleBuf->newData));
+#endif
 
     return kErrorOk;
 }
-#endif
 
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
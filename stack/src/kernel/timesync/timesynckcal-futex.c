@@ -0,0 +1,297 @@
+/**
+********************************************************************************
+\file   timesynckcal-futex.c
+
+\brief  CAL kernel timesync module using a shared sequence number and futexes
+
+This file contains an implementation for the kernel CAL timesync module which
+signals sync events to the user layer of a different process. The sync events
+are counted by a sequence number in a POSIX shared memory segment. User layer
+threads which wait for the next sync event sleep on the sequence number with
+a futex and are only woken up by a system call if they actually sleep. The
+SoC time of the cycle is passed together with the sequence number.
+
+The sync module is responsible to synchronize the user layer.
+
+\ingroup module_timesynckcal
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/timesync.h>
+#include <kernel/timesynckcal.h>
+
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Kernel CAL timesync instance
+
+The structure contains the instance data of the kernel CAL timesync module.
+*/
+typedef struct
+{
+    int                     fd;             ///< File descriptor of the sync event shared memory
+    tTimesyncSyncMemory*    pSyncMem;       ///< Sync event shared memory
+    tTimesyncSocTime        socTime;        ///< SoC time of the current cycle
+} tTimesynckCalInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTimesynckCalInstance    instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize kernel CAL timesync module
+
+The function initializes the kernel CAL timesync module. It creates the sync
+event shared memory.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesynckcal_init(void)
+{
+    void*   pMem;
+
+    OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
+
+    shm_unlink(TIMESYNC_SYNC_SHM);
+
+    instance_l.fd = shm_open(TIMESYNC_SYNC_SHM, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (instance_l.fd == -1)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() creating shared memory failed!\n", __func__);
+        return kErrorNoResource;
+    }
+
+    if (ftruncate(instance_l.fd, sizeof(tTimesyncSyncMemory)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() resizing shared memory failed!\n", __func__);
+        goto Exit;
+    }
+
+    pMem = mmap(NULL,
+                sizeof(tTimesyncSyncMemory),
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED,
+                instance_l.fd,
+                0);
+    if (pMem == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mmap failed!\n", __func__);
+        goto Exit;
+    }
+
+    instance_l.pSyncMem = (tTimesyncSyncMemory*)pMem;
+    OPLK_MEMSET(instance_l.pSyncMem, 0, sizeof(*instance_l.pSyncMem));
+
+    return kErrorOk;
+
+Exit:
+    close(instance_l.fd);
+    shm_unlink(TIMESYNC_SYNC_SHM);
+    return kErrorNoResource;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up CAL timesync module
+
+The function cleans up the CAL timesync module
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+void timesynckcal_exit(void)
+{
+    if (instance_l.pSyncMem == NULL)
+        return;
+
+    munmap(instance_l.pSyncMem, sizeof(tTimesyncSyncMemory));
+    instance_l.pSyncMem = NULL;
+
+    close(instance_l.fd);
+    shm_unlink(TIMESYNC_SYNC_SHM);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a sync event
+
+The function sends a sync event. It stores the SoC time of the current cycle
+in the SoC time buffer of the next sequence number and publishes the sequence
+number. Sleeping user threads are woken up.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesynckcal_sendSyncEvent(void)
+{
+    tTimesyncSyncMemory*    pSyncMem = instance_l.pSyncMem;
+    UINT32                  syncSeq;
+
+    if (pSyncMem == NULL)
+        return kErrorNoResource;
+
+    // The sequence number is only written by this function
+    syncSeq = pSyncMem->syncSeq + 1;
+
+    OPLK_MEMCPY(&pSyncMem->aSocTime[syncSeq & 1], &instance_l.socTime, sizeof(tTimesyncSocTime));
+
+    // The sequence number is published before the waiters are checked. A user
+    // thread registers as waiter before it sleeps on the sequence number,
+    // therefore either it sees the new sequence number or it is woken up.
+    __atomic_store_n(&pSyncMem->syncSeq, syncSeq, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&pSyncMem->waiterCount, __ATOMIC_SEQ_CST) != 0)
+        syscall(SYS_futex, &pSyncMem->syncSeq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set SoC time
+
+The function sets the SoC time of the current cycle. It is passed to the user
+layer with the next sync event.
+
+\param[in]      pSocTime_p          Pointer to SoC time information structure
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesynckcal_setSocTime(const tTimesyncSocTime* pSocTime_p)
+{
+    // Check parameter validity
+    ASSERT(pSocTime_p != NULL);
+
+    instance_l.socTime = *pSocTime_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Enable sync events
+
+The function enables sync events.
+
+\param[in]      fEnable_p           Enable/disable sync event
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesynckcal_controlSync(BOOL fEnable_p)
+{
+    UNUSED_PARAMETER(fEnable_p);
+
+    return kErrorOk;
+}
+
+#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
+//------------------------------------------------------------------------------
+/**
+\brief  Get timesync shared memory
+
+The function returns the reference to the timesync shared memory.
+
+\return The function returns a pointer to the timesync shared memory.
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+tTimesyncSharedMemory* timesynckcal_getSharedMemory(void)
+{
+    // Not implemented yet
+    return NULL;
+}
+#endif
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+/// \}
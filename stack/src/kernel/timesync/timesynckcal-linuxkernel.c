@@ -154,6 +154,27 @@ tOplkError timesynckcal_sendSyncEvent(void)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set SoC time
+
+The function sets the SoC time of the current cycle. The SoC time isn't
+passed to the user layer with the sync event by this implementation.
+
+\param[in]      pSocTime_p          Pointer to SoC time information structure
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesynckcal_setSocTime(const tTimesyncSocTime* pSocTime_p)
+{
+    UNUSED_PARAMETER(pSocTime_p);
+
+    return kErrorOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Wait for a sync event
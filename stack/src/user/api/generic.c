@@ -1689,7 +1689,51 @@ tOplkError oplk_waitSyncEvent(ULONG timeout_p)
     if (!ctrlu_stackIsInitialized())
         return kErrorApiNotInitialized;
 
-    return timesyncucal_waitSyncEvent(timeout_p);
+    return timesyncu_waitSyncEvent(timeout_p, NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Wait for sync event and get sync event information
+
+The function waits for a sync event like \ref oplk_waitSyncEvent. Additionally,
+it provides the sequence number of the sync event, the number of sync events
+which were missed since the last call and the SoC time of the cycle which
+triggered the sync event.
+
+If the application is too slow to process every sync event, the function returns
+immediately with the latest sync event and reports the missed ones, instead of
+returning once for each of them.
+
+\note The sequence number and SoC time are provided by the Linux userspace
+      stack (daemon) only. On other targets the sequence number counts the
+      received sync events, no missed sync events are reported and the SoC time
+      is invalid.
+
+\param[in]      timeout_p           Specifies a timeout in microseconds. If 0 it waits
+                                    forever.
+\param[out]     pSyncInfo_p         Pointer to store the sync event information.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The sync event occurred.
+\retval kErrorApiInvalidParam       The pointer to the sync event information is
+                                    invalid.
+\retval kErrorGeneralError          An error or timeout occurred while waiting for the
+                                    sync event.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_waitSyncEventInfo(ULONG timeout_p,
+                                  tOplkApiSyncEventInfo* pSyncInfo_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (pSyncInfo_p == NULL)
+        return kErrorApiInvalidParam;
+
+    return timesyncu_waitSyncEvent(timeout_p, pSyncInfo_p);
 }
 
 //------------------------------------------------------------------------------
@@ -160,6 +160,10 @@ tOplkError oplk_allocProcessImage(UINT sizeProcessImageIn_p,
         OPLK_MEMSET(instance_l.outputImage.pImage, 0x00, sizeProcessImageOut_p);
     }
 
+    // Register the process images for the layout check of the direct access
+    pdou_setDirectProcessImage(TRUE, instance_l.inputImage.pImage, instance_l.inputImage.imageSize);
+    pdou_setDirectProcessImage(FALSE, instance_l.outputImage.pImage, instance_l.outputImage.imageSize);
+
     DEBUG_LVL_ALWAYS_TRACE("%s: Alloc(%p, %u, %p, %u)\n",
                            __func__,
                            instance_l.inputImage.pImage,
@@ -190,6 +194,9 @@ tOplkError oplk_freeProcessImage(void)
     if (!ctrlu_stackIsInitialized())
         return kErrorApiNotInitialized;
 
+    pdou_setDirectProcessImage(TRUE, NULL, 0);
+    pdou_setDirectProcessImage(FALSE, NULL, 0);
+
     if (instance_l.inputImage.pImage != NULL)
     {
         OPLK_FREE(instance_l.inputImage.pImage);
@@ -349,6 +356,138 @@ tOplkError oplk_exchangeProcessImageOut(void)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Acquire output process image for direct access
+
+The function provides zero-copy access to the output process image. Instead of
+copying the received PDO into the output process image, it returns a pointer
+to the latest received PDO buffer. This is only possible if the layout of the
+output process image exactly matches the payload of a single RPDO, which is
+checked when the PDO mapping gets active in NMT state ReadyToOperate.
+
+The returned buffer is valid until oplk_releaseProcessImageOut() is called or
+the PDO mapping is reconfigured by an NMT reset. Each successful call must be
+followed by exactly one call of oplk_releaseProcessImageOut() before the output
+process image is acquired again. The input process image may be acquired and
+oplk_exchangeProcessImageOut() / oplk_exchangeProcessImageIn() may be called
+meanwhile; oplk_exchangeProcessImageOut() doesn't update the RPDO of the
+acquired buffer until it is released.
+
+\param[out]     ppImage_p           Pointer to store the address of the output
+                                    process image.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The output process image is acquired.
+\retval kErrorApiInvalidParam       The output process image is already acquired.
+\retval kErrorApiPINotAllocated     Memory for process images is not allocated.
+\retval kErrorApiPILayoutMismatch   The process image doesn't match the PDO layout.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_acquireProcessImageOut(const void** ppImage_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (instance_l.outputImage.pImage == NULL)
+        return kErrorApiPINotAllocated;
+
+    return pdou_acquireRxPdoBuffer(ppImage_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release output process image
+
+The function releases the output process image acquired by
+oplk_acquireProcessImageOut().
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The output process image is released.
+\retval kErrorApiInvalidParam       The output process image isn't acquired.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_releaseProcessImageOut(void)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return pdou_releaseRxPdoBuffer();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Acquire input process image for direct access
+
+The function provides zero-copy access to the input process image. It returns
+a pointer to the PDO buffer which is transmitted next. This is only possible if
+the layout of the input process image exactly matches the payload of a single
+TPDO, which is checked when the PDO mapping gets active in NMT state
+ReadyToOperate.
+
+The buffer doesn't contain the previously written data, therefore the
+application has to write the complete process image. The data is handed over
+to the stack by oplk_releaseProcessImageIn(). Each successful call must be
+followed by exactly one call of oplk_releaseProcessImageIn() before the input
+process image is acquired again. The output process image may be acquired and
+oplk_exchangeProcessImageIn() / oplk_exchangeProcessImageOut() may be called
+meanwhile; oplk_exchangeProcessImageIn() doesn't transmit the TPDO of the
+acquired buffer. If the PDO mapping is reconfigured by an NMT reset before the
+release, the written data is discarded.
+
+\param[out]     ppImage_p           Pointer to store the address of the input
+                                    process image.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The input process image is acquired.
+\retval kErrorApiInvalidParam       The input process image is already acquired.
+\retval kErrorApiPINotAllocated     Memory for process images is not allocated.
+\retval kErrorApiPILayoutMismatch   The process image doesn't match the PDO layout.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_acquireProcessImageIn(void** ppImage_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (instance_l.inputImage.pImage == NULL)
+        return kErrorApiPINotAllocated;
+
+    return pdou_acquireTxPdoBuffer(ppImage_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release input process image
+
+The function hands over the input process image acquired by
+oplk_acquireProcessImageIn() to the stack.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The input process image is released.
+\retval kErrorApiInvalidParam       The input process image isn't acquired.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_releaseProcessImageIn(void)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return pdou_releaseTxPdoBuffer();
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get pointer to input process image
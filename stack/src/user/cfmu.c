@@ -47,6 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/ami.h>
 #include <user/cfmu.h>
 #include <user/sdocom.h>
+#include <user/sdocomint.h>
 #include <user/identu.h>
 #include <user/nmtu.h>
 #include <user/obdu.h>
@@ -89,6 +90,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// maximum number of ConciseDCF entries in one multiple write transfer
+// (the smallest sub-access consists of the sub-header and 4 bytes of padded data)
+#define CFM_MULTI_WRITE_MAX_ENTRIES (SDO_CMD_SEGM_TX_MAX_SIZE / (SDO_CMDL_HDR_WRITEMULTBYINDEX_SIZE + 4))
 
 //------------------------------------------------------------------------------
 // local types
@@ -134,6 +138,12 @@ typedef struct
     tCfmState               cfmState;                       ///< Current CFM state for the CN
     UINT                    curDataSize;                    ///< Size of the current entry to be written via SDO
     BOOL                    fDoStore;                       ///< Flag indicating whether a store command shall be issued
+    BOOL                    fMultiWrite;                    ///< Flag indicating whether the CN supports SDO multiple write by index
+    BOOL                    fMultiWriteSubAborted;          ///< Flag indicating whether the CN has rejected an entry of the current multiple write
+    UINT32                  multiWriteAbortCode;            ///< SDO abort code of the first entry rejected in the current multiple write
+    UINT                    multiAccCnt;                    ///< Number of ConciseDCF entries in the current multiple write
+    tSdoMultiAccEntry       aMultiAcc[CFM_MULTI_WRITE_MAX_ENTRIES];     ///< Sub-accesses of the current multiple write
+    UINT8                   aMultiBuffer[SDO_CMD_SEGM_TX_MAX_SIZE];     ///< Command layer payload buffer of the current multiple write
 } tCfmNodeInfo;
 
 /**
@@ -167,9 +177,15 @@ static tOplkError    finishConfig(tCfmNodeInfo* pNodeInfo_p,
                                   tNmtNodeCommand nmtNodeCommand_p);
 static tOplkError    downloadCycleLength(tCfmNodeInfo* pNodeInfo_p);
 static tOplkError    downloadObject(tCfmNodeInfo* pNodeInfo_p);
+static UINT          collectMultiWrite(tCfmNodeInfo* pNodeInfo_p);
+static void          confirmMultiWrite(tCfmNodeInfo* pNodeInfo_p,
+                                       UINT entryCount_p);
 static tOplkError    sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
                                     const void* pLeSrcData_p,
                                     UINT size_p);
+static tOplkError    sdoWriteMultiObjects(tCfmNodeInfo* pNodeInfo_p);
+static tOplkError    sdoStartTransfer(tCfmNodeInfo* pNodeInfo_p,
+                                      tSdoComTransParamByIndex* pTransParamByIndex_p);
 static tOplkError    cbSdoCon(const tSdoComFinished* pSdoComFinished_p);
 static tOplkError    finishDownload(tCfmNodeInfo* pNodeInfo_p);
 
@@ -356,6 +372,8 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
     }
 
     pNodeInfo->curDataSize = 0;
+    pNodeInfo->multiAccCnt = 0;
+    pNodeInfo->fMultiWriteSubAborted = FALSE;
 
     // fetch pointer to ConciseDCF from object 0x1F22
     // (this allows the application to link its own memory to this object)
@@ -387,6 +405,10 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
         return kErrorInvalidNodeId;
     }
 
+    // pack consecutive ConciseDCF entries if the CN supports multiple write by index
+    pNodeInfo->fMultiWrite = ((ami_getUint32Le(&pIdentResponse->featureFlagsLe) &
+                               NMT_FEATUREFLAGS_SDO_RW_MULTIPLE) != 0);
+
 #if defined(CONFIG_INCLUDE_NMT_RMN)
     if (ami_getUint32Le(&pIdentResponse->featureFlagsLe) & NMT_FEATUREFLAGS_CFM)
     {
@@ -738,7 +760,51 @@ static tOplkError cbSdoCon(const tSdoComFinished* pSdoComFinished_p)
         return kErrorInvalidNodeId;
 
     pNodeInfo->eventCnProgress.sdoAbortCode = pSdoComFinished_p->abortCode;
-    pNodeInfo->eventCnProgress.bytesDownloaded += pSdoComFinished_p->transferredBytes;
+
+    if (pSdoComFinished_p->sdoAccessType == kSdoAccessTypeMultiWrite)
+    {
+        switch (pSdoComFinished_p->sdoComConState)
+        {
+            case kSdoComTransferRxSubAborted:
+                // report the rejected entry, the download fails when the whole
+                // transfer has finished
+                if (pNodeInfo->fMultiWriteSubAborted == FALSE)
+                    pNodeInfo->multiWriteAbortCode = pSdoComFinished_p->abortCode;
+                pNodeInfo->fMultiWriteSubAborted = TRUE;
+                pNodeInfo->eventCnProgress.objectIndex = pSdoComFinished_p->targetIndex;
+                pNodeInfo->eventCnProgress.objectSubIndex = pSdoComFinished_p->targetSubIndex;
+                return callCbProgress(pNodeInfo);
+
+            case kSdoComTransferRxAborted:
+                if (pNodeInfo->cfmState == kCfmStateDownload)
+                {   // CN rejects the multiple write command
+                    // -> download the remaining entries one by one
+                    DEBUG_LVL_CFM_TRACE("CN%x - Multiple write aborted with 0x%08X, using single write\n",
+                                        pNodeInfo->eventCnProgress.nodeId,
+                                        pSdoComFinished_p->abortCode);
+                    pNodeInfo->fMultiWrite = FALSE;
+                    pNodeInfo->multiAccCnt = 0;
+                    pNodeInfo->eventCnProgress.sdoAbortCode = 0;
+                    return downloadObject(pNodeInfo);
+                }
+                break;
+
+            case kSdoComTransferFinished:
+                if (pNodeInfo->fMultiWriteSubAborted == FALSE)
+                    confirmMultiWrite(pNodeInfo, pSdoComFinished_p->multiSubAccCnt);
+                else
+                {   // the command layer reports the end of the transfer without
+                    // an abort code, so report the one of the rejected entry
+                    pNodeInfo->eventCnProgress.sdoAbortCode = pNodeInfo->multiWriteAbortCode;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    else
+        pNodeInfo->eventCnProgress.bytesDownloaded += pSdoComFinished_p->transferredBytes;
 
     ret = callCbProgress(pNodeInfo);
     if (ret != kErrorOk)
@@ -760,7 +826,8 @@ static tOplkError cbSdoCon(const tSdoComFinished* pSdoComFinished_p)
             break;
 
         case kCfmStateDownload:
-            if (pSdoComFinished_p->sdoComConState == kSdoComTransferFinished)
+            if ((pSdoComFinished_p->sdoComConState == kSdoComTransferFinished) &&
+                (pNodeInfo->fMultiWriteSubAborted == FALSE))
                 ret = downloadObject(pNodeInfo);
             else
                 ret = finishConfig(pNodeInfo, kNmtNodeCommandConfErr);      // configuration was not successful
@@ -856,7 +923,8 @@ static tOplkError downloadCycleLength(tCfmNodeInfo* pNodeInfo_p)
 \brief  Download object
 
 The function downloads the next object from the ConciseDCF to the specified
-node.
+node. If the node supports SDO multiple write by index, consecutive entries
+which fit into one command layer segment are downloaded in a single transfer.
 
 \param[in,out]  pNodeInfo_p         Node info of the node for which to download the next
                                     object.
@@ -874,6 +942,13 @@ static tOplkError downloadObject(tCfmNodeInfo* pNodeInfo_p)
 
     if (pNodeInfo_p->entriesRemaining > 0)
     {
+        if ((pNodeInfo_p->fMultiWrite != FALSE) &&
+            (collectMultiWrite(pNodeInfo_p) > 1))
+            return sdoWriteMultiObjects(pNodeInfo_p);
+
+        // single entry left or the next entry is too large for a multiple write
+        pNodeInfo_p->multiAccCnt = 0;
+
         if (pNodeInfo_p->bytesRemaining < CDC_OFFSET_DATA)
         {
             // not enough bytes left in ConciseDCF
@@ -1046,6 +1121,100 @@ static tOplkError finishDownload(tCfmNodeInfo* pNodeInfo_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Collect ConciseDCF entries for a multiple write
+
+The function collects the consecutive ConciseDCF entries starting at the
+current position which fit into one multiple write by index command segment.
+Collecting stops at the first entry which does not fit or is invalid. The
+ConciseDCF position is not changed until the entries are confirmed by
+confirmMultiWrite().
+
+\param[in,out]  pNodeInfo_p         Node info of the node for which to collect
+                                    the entries.
+
+\return The function returns the number of collected entries.
+*/
+//------------------------------------------------------------------------------
+static UINT collectMultiWrite(tCfmNodeInfo* pNodeInfo_p)
+{
+    const UINT8*        pData = pNodeInfo_p->pDataConciseDcf;
+    UINT32              bytesRemaining = pNodeInfo_p->bytesRemaining;
+    size_t              segmSize = 0;
+    size_t              subAccSize;
+    UINT                dataSize;
+    tSdoMultiAccEntry*  pMultiAcc;
+
+    pNodeInfo_p->multiAccCnt = 0;
+    while ((pNodeInfo_p->multiAccCnt < pNodeInfo_p->entriesRemaining) &&
+           (pNodeInfo_p->multiAccCnt < CFM_MULTI_WRITE_MAX_ENTRIES) &&
+           (bytesRemaining >= CDC_OFFSET_DATA))
+    {
+        dataSize = (UINT)ami_getUint32Le(&pData[CDC_OFFSET_SIZE]);
+        if ((dataSize == 0) ||
+            (dataSize > bytesRemaining - CDC_OFFSET_DATA) ||
+            (dataSize > SDO_CMD_SEGM_TX_MAX_SIZE))
+            break;
+
+        // sub-access data is padded to a multiple of 4 bytes
+        subAccSize = SDO_CMDL_HDR_WRITEMULTBYINDEX_SIZE + ((dataSize + 3) & ~3U);
+        if ((segmSize + subAccSize) > SDO_CMD_SEGM_TX_MAX_SIZE)
+            break;
+
+        pMultiAcc = &pNodeInfo_p->aMultiAcc[pNodeInfo_p->multiAccCnt];
+        pMultiAcc->index = ami_getUint16Le(&pData[CDC_OFFSET_INDEX]);
+        pMultiAcc->subIndex = ami_getUint8Le(&pData[CDC_OFFSET_SUBINDEX]);
+        pMultiAcc->pData_le = (void*)&pData[CDC_OFFSET_DATA];
+        pMultiAcc->dataSize = dataSize;
+
+        segmSize += subAccSize;
+        pData += CDC_OFFSET_DATA + dataSize;
+        bytesRemaining -= CDC_OFFSET_DATA + dataSize;
+        pNodeInfo_p->multiAccCnt++;
+    }
+
+    return pNodeInfo_p->multiAccCnt;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Confirm ConciseDCF entries of a multiple write
+
+The function forwards the ConciseDCF position and the download progress over
+the entries which were written by the finished multiple write transfer.
+
+\param[in,out]  pNodeInfo_p         Node info of the node for which to confirm
+                                    the entries.
+\param[in]      entryCount_p        Number of entries written by the transfer.
+*/
+//------------------------------------------------------------------------------
+static void confirmMultiWrite(tCfmNodeInfo* pNodeInfo_p,
+                              UINT entryCount_p)
+{
+    const tSdoMultiAccEntry*    pMultiAcc;
+    UINT32                      entrySize;
+    UINT                        i;
+
+    if (entryCount_p > pNodeInfo_p->multiAccCnt)
+        entryCount_p = pNodeInfo_p->multiAccCnt;
+
+    for (i = 0; i < entryCount_p; i++)
+    {
+        pMultiAcc = &pNodeInfo_p->aMultiAcc[i];
+        entrySize = CDC_OFFSET_DATA + pMultiAcc->dataSize;
+
+        pNodeInfo_p->pDataConciseDcf += entrySize;
+        pNodeInfo_p->bytesRemaining -= entrySize;
+        pNodeInfo_p->entriesRemaining--;
+        pNodeInfo_p->eventCnProgress.bytesDownloaded += entrySize;
+        pNodeInfo_p->eventCnProgress.objectIndex = pMultiAcc->index;
+        pNodeInfo_p->eventCnProgress.objectSubIndex = pMultiAcc->subIndex;
+    }
+
+    pNodeInfo_p->multiAccCnt = 0;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Write object by SDO transfer
@@ -1063,12 +1232,78 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
                                  const void* pLeSrcData_p,
                                  UINT size_p)
 {
-    tOplkError                  ret = kErrorOk;
     tSdoComTransParamByIndex    transParamByIndex;
 
     if ((pLeSrcData_p == NULL) || (size_p == 0))
         return kErrorApiInvalidParam;
 
+    OPLK_MEMSET(&transParamByIndex, 0, sizeof(transParamByIndex));
+    transParamByIndex.pData = (void*)pLeSrcData_p;
+    transParamByIndex.sdoAccessType = kSdoAccessTypeWrite;
+    transParamByIndex.dataSize = size_p;
+    transParamByIndex.index = (UINT16)pNodeInfo_p->eventCnProgress.objectIndex;
+    transParamByIndex.subindex = (UINT8)pNodeInfo_p->eventCnProgress.objectSubIndex;
+
+    return sdoStartTransfer(pNodeInfo_p, &transParamByIndex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write collected objects by SDO multiple write transfer
+
+The function writes the ConciseDCF entries collected by collectMultiWrite()
+to the OD of the specified node in one multiple write by index transfer.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to write to.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sdoWriteMultiObjects(tCfmNodeInfo* pNodeInfo_p)
+{
+    tSdoComTransParamByIndex    transParamByIndex;
+
+    pNodeInfo_p->curDataSize = 0;
+    pNodeInfo_p->fMultiWriteSubAborted = FALSE;
+    pNodeInfo_p->eventCnProgress.objectIndex = pNodeInfo_p->aMultiAcc[0].index;
+    pNodeInfo_p->eventCnProgress.objectSubIndex = pNodeInfo_p->aMultiAcc[0].subIndex;
+
+    OPLK_MEMSET(&transParamByIndex, 0, sizeof(transParamByIndex));
+    // the first sub-access is also passed as single access, because the
+    // command layer checks these parameters for all access types
+    transParamByIndex.pData = pNodeInfo_p->aMultiAcc[0].pData_le;
+    transParamByIndex.sdoAccessType = kSdoAccessTypeMultiWrite;
+    transParamByIndex.dataSize = pNodeInfo_p->aMultiAcc[0].dataSize;
+    transParamByIndex.index = (UINT16)pNodeInfo_p->aMultiAcc[0].index;
+    transParamByIndex.subindex = (UINT8)pNodeInfo_p->aMultiAcc[0].subIndex;
+    transParamByIndex.paMultiAcc = pNodeInfo_p->aMultiAcc;
+    transParamByIndex.multiAccCnt = pNodeInfo_p->multiAccCnt;
+    transParamByIndex.pMultiBuffer = pNodeInfo_p->aMultiBuffer;
+    transParamByIndex.multiBufSize = sizeof(pNodeInfo_p->aMultiBuffer);
+
+    return sdoStartTransfer(pNodeInfo_p, &transParamByIndex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start SDO transfer
+
+The function starts an SDO write transfer to the specified node. It defines
+the SDO command layer connection if necessary.
+
+\param[in,out]  pNodeInfo_p             Node info of the node to write to.
+\param[in,out]  pTransParamByIndex_p    Transfer parameters. The connection
+                                        handle, callback function and user
+                                        argument are set by this function.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sdoStartTransfer(tCfmNodeInfo* pNodeInfo_p,
+                                   tSdoComTransParamByIndex* pTransParamByIndex_p)
+{
+    tOplkError  ret = kErrorOk;
+
     if (pNodeInfo_p->sdoComConHdl == UINT_MAX)
     {
         // init command layer connection
@@ -1079,21 +1314,16 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
             return ret;
     }
 
-    transParamByIndex.pData = (void*)pLeSrcData_p;
-    transParamByIndex.sdoAccessType = kSdoAccessTypeWrite;
-    transParamByIndex.sdoComConHdl = pNodeInfo_p->sdoComConHdl;
-    transParamByIndex.dataSize = size_p;
-    transParamByIndex.index = (UINT16)pNodeInfo_p->eventCnProgress.objectIndex;
-    transParamByIndex.subindex = (UINT8)pNodeInfo_p->eventCnProgress.objectSubIndex;
-    transParamByIndex.pfnSdoFinishedCb = cbSdoCon;
-    transParamByIndex.pUserArg = pNodeInfo_p;
+    pTransParamByIndex_p->sdoComConHdl = pNodeInfo_p->sdoComConHdl;
+    pTransParamByIndex_p->pfnSdoFinishedCb = cbSdoCon;
+    pTransParamByIndex_p->pUserArg = pNodeInfo_p;
 
-    ret = sdocom_initTransferByIndex(&transParamByIndex);
+    ret = sdocom_initTransferByIndex(pTransParamByIndex_p);
     if (ret == kErrorSdoComHandleBusy)
     {
         ret = sdocom_abortTransfer(pNodeInfo_p->sdoComConHdl, SDO_AC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL);
         if (ret == kErrorOk)
-            ret = sdocom_initTransferByIndex(&transParamByIndex);
+            ret = sdocom_initTransferByIndex(pTransParamByIndex_p);
     }
     else if (ret == kErrorSdoSeqConnectionBusy)
     {
@@ -1114,8 +1344,8 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
             return ret;
 
         // retry transfer
-        transParamByIndex.sdoComConHdl = pNodeInfo_p->sdoComConHdl;
-        ret = sdocom_initTransferByIndex(&transParamByIndex);
+        pTransParamByIndex_p->sdoComConHdl = pNodeInfo_p->sdoComConHdl;
+        ret = sdocom_initTransferByIndex(pTransParamByIndex_p);
     }
 
     return ret;
@@ -55,7 +55,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define CMD_TIMEOUT_CNT     100     // loop counter for command timeout
+#define CMD_TIMEOUT         1000    // [ms] timeout waiting for the command return
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -154,7 +154,9 @@ tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p,
                                UINT16* pRetVal_p)
 {
     tCtrlCmd    ctrlCmd;
-    int         timeout;
+    UINT32      startTime;
+    UINT32      elapsedTime;
+    UINT32      signalCount;
 
     // Check parameter validity
     ASSERT(pRetVal_p != NULL);
@@ -166,11 +168,13 @@ tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p,
     ctrlcal_writeData(offsetof(tCtrlBuf, ctrlCmd),
                       &ctrlCmd,
                       sizeof(tCtrlCmd));
+    ctrlcal_sendSignal(kCtrlCalSignalCmd);
 
     /* wait for response */
-    for (timeout = 0; timeout < CMD_TIMEOUT_CNT; timeout++)
+    startTime = target_getTickCount();
+    for (;;)
     {
-        target_msleep(10);
+        signalCount = ctrlcal_getSignalCount(kCtrlCalSignalReturn);
         ctrlcal_readData(&ctrlCmd,
                          offsetof(tCtrlBuf, ctrlCmd),
                          sizeof(tCtrlCmd));
@@ -179,6 +183,12 @@ tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p,
             *pRetVal_p = ctrlCmd.retVal;
             return kErrorOk;
         }
+
+        elapsedTime = target_getTickCount() - startTime;
+        if (elapsedTime >= CMD_TIMEOUT)
+            break;
+
+        ctrlcal_waitSignal(kCtrlCalSignalReturn, signalCount, CMD_TIMEOUT - elapsedTime);
     }
 
     DEBUG_LVL_ERROR_TRACE("%s() Timeout waiting for return!\n", __func__);
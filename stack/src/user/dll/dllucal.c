@@ -812,8 +812,8 @@ static tOplkError handleRxAsyncFrameInfo(tFrameInfo* pFrameInfo_p)
 static tOplkError handleNotRxAsndFrame(const tDllAsndNotRx* pAsndNotRx_p)
 {
     tOplkError  ret = kErrorOk;
-    UINT8       aBuffer[DLLUCAL_NOTRX_FRAME_SIZE];
-    tPlkFrame*  pFrame = (tPlkFrame*)aBuffer;
+    tPlkFrame   frame;
+    tPlkFrame*  pFrame = &frame;
     tFrameInfo  frameInfo;
     UINT        asndServiceId;
 
@@ -7,6 +7,11 @@
 This file implements the user event handler CAL module for the Linux
 userspace platform. It uses the circular buffer interface for all event queues.
 
+The event thread is woken up by a named semaphore. A wakeup processes all
+pending events, whereby the kernel-to-user queue has priority over the user
+internal queue. A signal is only posted if no wakeup is pending, thus a burst
+of events is handled with a single wakeup.
+
 \see eventucalintf-circbuf.c
 
 \ingroup module_eventucal
@@ -93,6 +98,7 @@ typedef struct
     BOOL                    fStopThread;
     sem_t*                  semUserData;
     sem_t*                  semKernelData;
+    tEventuCalStatistics    statistics;
     BOOL                    fInitialized;
 } tEventuCalInstance;
 
@@ -105,8 +111,10 @@ static tEventuCalInstance       instance_l;             ///< Instance variable o
 // local function prototypes
 //------------------------------------------------------------------------------
 static void* eventThread(void* arg);
+static void  processEvents(tEventuCalInstance* pInstance_p);
 static void  signalUserEvent(void);
 static void  signalKernelEvent(void);
+static void  signalEvent(sem_t* pSem_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -205,6 +213,7 @@ tOplkError eventucal_exit(void)
     if (instance_l.fInitialized == TRUE)
     {
         instance_l.fStopThread = TRUE;
+        sem_post(instance_l.semUserData);
         while (instance_l.fStopThread == TRUE)
         {
             target_msleep(10);
@@ -222,6 +231,14 @@ tOplkError eventucal_exit(void)
 
         sem_close(instance_l.semUserData);
         sem_close(instance_l.semKernelData);
+
+        DEBUG_LVL_EVENTU_TRACE("%s(): wakeups:%u events:%u max/wakeup:%u max K2U:%u max UInt:%u\n",
+                               __func__,
+                               instance_l.statistics.wakeupCount,
+                               instance_l.statistics.eventCount,
+                               instance_l.statistics.maxEventsPerWakeup,
+                               instance_l.statistics.maxQueueDepthK2U,
+                               instance_l.statistics.maxQueueDepthUInt);
     }
     instance_l.fInitialized = FALSE;
 
@@ -300,6 +317,25 @@ void eventucal_process(void)
     // Nothing to do, because we use threads
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get statistics of user event CAL module
+
+This function returns the statistics of the event handler thread.
+
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\ingroup module_eventucal
+*/
+//------------------------------------------------------------------------------
+void eventucal_getStatistics(tEventuCalStatistics* pStatistics_p)
+{
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    OPLK_MEMCPY(pStatistics_p, &instance_l.statistics, sizeof(tEventuCalStatistics));
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -331,14 +367,12 @@ static void* eventThread(void* arg)
 
         if (sem_timedwait(pInstance->semUserData, &timeout) == 0)
         {
-            /* first handle all user to kernel events --> higher priority! */
-            if (eventucal_getEventCountCircbuf(kEventQueueK2U) > 0)
-                eventucal_processEventCircbuf(kEventQueueK2U);
-            else
-            {
-                if (eventucal_getEventCountCircbuf(kEventQueueUInt) > 0)
-                    eventucal_processEventCircbuf(kEventQueueUInt);
-            }
+            // Consume all pending signals before the queues are read. Events
+            // posted afterwards signal the semaphore again and are not lost.
+            while (sem_trywait(pInstance->semUserData) == 0)
+                ;
+
+            processEvents(pInstance);
         }
     }
     pInstance->fStopThread = FALSE;
@@ -346,6 +380,58 @@ static void* eventThread(void* arg)
     return 0;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process all pending events
+
+This function processes the event queues until they are empty. Kernel-to-user
+events have a higher priority. They are processed in batches, whereas the user
+internal events are processed one by one and the kernel-to-user queue is
+checked before each of them.
+
+\param[in,out]  pInstance_p         Pointer to the module instance.
+*/
+//------------------------------------------------------------------------------
+static void processEvents(tEventuCalInstance* pInstance_p)
+{
+    UINT32  eventCount = 0;
+    UINT32  queueDepth;
+    UINT    processedCount;
+
+    while (!pInstance_p->fStopThread)
+    {
+        /* first handle all kernel to user events --> higher priority! */
+        queueDepth = eventucal_getEventCountCircbuf(kEventQueueK2U);
+        if (queueDepth > 0)
+        {
+            if (queueDepth > pInstance_p->statistics.maxQueueDepthK2U)
+                pInstance_p->statistics.maxQueueDepthK2U = queueDepth;
+
+            eventucal_processEventCircbuf(kEventQueueK2U,
+                                      EVENTUCAL_MAX_BATCH_EVENTS,
+                                      &processedCount);
+            eventCount += processedCount;
+            continue;
+        }
+
+        queueDepth = eventucal_getEventCountCircbuf(kEventQueueUInt);
+        if (queueDepth == 0)
+            break;
+
+        if (queueDepth > pInstance_p->statistics.maxQueueDepthUInt)
+            pInstance_p->statistics.maxQueueDepthUInt = queueDepth;
+
+        // Only a single event, so the higher priority queue is checked again first
+        eventucal_processEventCircbuf(kEventQueueUInt, 1, &processedCount);
+        eventCount += processedCount;
+    }
+
+    pInstance_p->statistics.wakeupCount++;
+    pInstance_p->statistics.eventCount += eventCount;
+    if (eventCount > pInstance_p->statistics.maxEventsPerWakeup)
+        pInstance_p->statistics.maxEventsPerWakeup = eventCount;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Signal a user event
@@ -356,7 +442,7 @@ in the circular buffer library as signal callback function.
 //------------------------------------------------------------------------------
 static void signalUserEvent(void)
 {
-    sem_post(instance_l.semUserData);
+    signalEvent(instance_l.semUserData);
 }
 
 //------------------------------------------------------------------------------
@@ -369,7 +455,28 @@ in the circular buffer library as signal callback function.
 //------------------------------------------------------------------------------
 static void signalKernelEvent(void)
 {
-    sem_post(instance_l.semKernelData);
+    signalEvent(instance_l.semKernelData);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal an event thread
+
+This function signals the semaphore of an event thread. If a signal is already
+pending, the event thread has not yet started to read the queues and will also
+process the just posted event. Therefore, no further signal is posted.
+
+\param[in]      pSem_p              Semaphore of the event thread to signal.
+*/
+//------------------------------------------------------------------------------
+static void signalEvent(sem_t* pSem_p)
+{
+    int     semValue;
+
+    if ((sem_getvalue(pSem_p, &semValue) == 0) && (semValue > 0))
+        return;
+
+    sem_post(pSem_p);
 }
 
 /// \}
@@ -436,7 +436,7 @@ static void* eventProcessThread(void* pArg_p)
         if (sem_timedwait(instance_l.semUserData, &timeout) == 0)
         {
             if (eventucal_getEventCountCircbuf(kEventQueueUInt) > 0)
-                eventucal_processEventCircbuf(kEventQueueUInt);
+                eventucal_processEventCircbuf(kEventQueueUInt, 1, NULL);
         }
     }
 
@@ -224,7 +224,7 @@ This function will be called by the systems process function.
 void eventucal_process(void)
 {
     if (eventucal_getEventCountCircbuf(kEventQueueK2U) > 0)
-        eventucal_processEventCircbuf(kEventQueueK2U);
+        eventucal_processEventCircbuf(kEventQueueK2U, 1, NULL);
 }
 
 //============================================================================//
@@ -321,11 +321,11 @@ static DWORD WINAPI eventThread(LPVOID arg)
 
                 /* first handle all kernel to user events --> higher priority! */
                 if (eventucal_getEventCountCircbuf(kEventQueueK2U) > 0)
-                    eventucal_processEventCircbuf(kEventQueueK2U);
+                    eventucal_processEventCircbuf(kEventQueueK2U, 1, NULL);
                 else
                 {
                     if (eventucal_getEventCountCircbuf(kEventQueueUInt) > 0)
-                        eventucal_processEventCircbuf(kEventQueueUInt);
+                        eventucal_processEventCircbuf(kEventQueueUInt, 1, NULL);
                 }
                 break;
 
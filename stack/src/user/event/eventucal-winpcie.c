@@ -403,7 +403,7 @@ static DWORD WINAPI eventProcess(LPVOID pArg_p)
         {
             case WAIT_OBJECT_0:
                 if (eventucal_getEventCountCircbuf(kEventQueueUInt) > 0)
-                    eventucal_processEventCircbuf(kEventQueueUInt);
+                    eventucal_processEventCircbuf(kEventQueueUInt, 1, NULL);
                 break;
 
             case WAIT_TIMEOUT:
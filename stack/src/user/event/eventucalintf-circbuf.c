@@ -68,6 +68,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// Size of the receive buffer of a queue, it holds at least one maximum sized event
+#define EVENTUCAL_RX_BUFFER_SIZE        (sizeof(tEvent) + MAX_EVENT_ARG_SIZE)
 
 //------------------------------------------------------------------------------
 // local types
@@ -81,6 +83,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local vars
 //------------------------------------------------------------------------------
 static tCircBufInstance*       instance_l[kEventQueueNum];
+static BYTE                    aRxBuffer_l[kEventQueueNum][EVENTUCAL_RX_BUFFER_SIZE];
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -127,6 +130,7 @@ tOplkError eventucal_initQueueCircbuf(tEventQueue eventQueue_p)
         case kEventQueueUInt:
             circError = circbuf_alloc(CIRCBUF_USER_INTERNAL_QUEUE,
                                       CONFIG_EVENT_SIZE_CIRCBUF_USER_INTERNAL,
+                                      kCircBufModeLocked,
                                       &instance_l[eventQueue_p]);
             if (circError != kCircBufOk)
             {
@@ -240,12 +244,17 @@ tOplkError eventucal_postEventCircbuf(tEventQueue eventQueue_p,
 
 //------------------------------------------------------------------------------
 /**
-\brief    Process event using circular buffers
+\brief    Process events using circular buffers
 
-This function reads a circular buffer event queue and processes the event
-by calling the event handlers process function.
+This function reads up to maxEventCount_p events from a circular buffer event
+queue with a single queue access and processes them by calling the event
+handlers process function. At most EVENTUCAL_MAX_BATCH_EVENTS events are
+processed per call.
 
-\param[in]      eventQueue_p        Event queue used for reading the event.
+\param[in]      eventQueue_p        Event queue used for reading the events.
+\param[in]      maxEventCount_p     Maximum number of events to be processed.
+\param[out]     pEventCount_p       Pointer to store the number of processed
+                                    events. May be NULL.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Function executes correctly
@@ -254,14 +263,25 @@ by calling the event handlers process function.
 \ingroup module_eventucal
 */
 //------------------------------------------------------------------------------
-tOplkError eventucal_processEventCircbuf(tEventQueue eventQueue_p)
+tOplkError eventucal_processEventCircbuf(tEventQueue eventQueue_p,
+                                         UINT maxEventCount_p,
+                                         UINT* pEventCount_p)
 {
     tEvent*             pEvent;
     tCircBufError       error;
-    tOplkError          ret;
-    size_t              readSize;
+    tOplkError          ret = kErrorOk;
+    tOplkError          processRet;
+    size_t              aReadSize[EVENTUCAL_MAX_BATCH_EVENTS];
+    UINT                readCount;
+    UINT                i;
+    size_t              offset;
     tCircBufInstance*   pCircBufInstance;
-    BYTE                aRxBuffer[sizeof(tEvent) + MAX_EVENT_ARG_SIZE];
+
+    // Check parameter validity
+    ASSERT(maxEventCount_p > 0);
+
+    if (maxEventCount_p > EVENTUCAL_MAX_BATCH_EVENTS)
+        maxEventCount_p = EVENTUCAL_MAX_BATCH_EVENTS;
 
     if (eventQueue_p > kEventQueueNum)
         return kErrorInvalidInstanceParam;
@@ -269,12 +289,17 @@ tOplkError eventucal_processEventCircbuf(tEventQueue eventQueue_p)
     if (instance_l[eventQueue_p] == NULL)
         return kErrorInvalidInstanceParam;
 
+    if (pEventCount_p != NULL)
+        *pEventCount_p = 0;
+
     pCircBufInstance = instance_l[eventQueue_p];
 
-    error = circbuf_readData(pCircBufInstance,
-                             aRxBuffer,
-                             sizeof(tEvent) + MAX_EVENT_ARG_SIZE,
-                             &readSize);
+    error = circbuf_readMultiple(pCircBufInstance,
+                                 aRxBuffer_l[eventQueue_p],
+                                 EVENTUCAL_RX_BUFFER_SIZE,
+                                 aReadSize,
+                                 maxEventCount_p,
+                                 &readCount);
     if (error != kCircBufOk)
     {
         if (error == kCircBufNoReadableData)
@@ -288,15 +313,28 @@ tOplkError eventucal_processEventCircbuf(tEventQueue eventQueue_p)
         return kErrorGeneralError;
     }
 
-    pEvent = (tEvent*)aRxBuffer;
-    pEvent->eventArgSize = (UINT)(readSize - sizeof(tEvent));
+    if (pEventCount_p != NULL)
+        *pEventCount_p = readCount;
 
-    if (pEvent->eventArgSize > 0)
-        pEvent->eventArg.pEventArg = &aRxBuffer[sizeof(tEvent)];
-    else
-        pEvent->eventArg.pEventArg = NULL;
+    offset = 0;
+    for (i = 0; i < readCount; i++)
+    {
+        pEvent = (tEvent*)&aRxBuffer_l[eventQueue_p][offset];
+        pEvent->eventArgSize = (UINT)(aReadSize[i] - sizeof(tEvent));
+
+        if (pEvent->eventArgSize > 0)
+            pEvent->eventArg.pEventArg = &aRxBuffer_l[eventQueue_p][offset + sizeof(tEvent)];
+        else
+            pEvent->eventArg.pEventArg = NULL;
+
+        processRet = eventu_process(pEvent);
+        if (processRet != kErrorOk)
+            ret = processRet;
+
+        offset += (aReadSize[i] + (CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1)) &
+                  ~(size_t)(CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1);
+    }
 
-    ret = eventu_process(pEvent);
     return ret;
 }
 
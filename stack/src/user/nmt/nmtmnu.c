@@ -51,6 +51,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/syncu.h>
 #include <user/eventu.h>
 #include <common/ami.h>
+#include <common/target.h>
 #include <user/obdu.h>
 #include <oplk/frame.h>
 #include <oplk/benchmark.h>
@@ -93,6 +94,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NMTMNU_NODE_FLAG_HALTED                 0x0004  // boot process for this CN is halted
 #define NMTMNU_NODE_FLAG_NMT_CMD_ISSUED         0x0008  // NMT command was just issued, wrong NMT states will be tolerated
 #define NMTMNU_NODE_FLAG_PREOP2_REACHED         0x0010  // NodeAddIsochronous has been called, waiting for ISOCHRON
+#define NMTMNU_NODE_FLAG_CONFIG_ACTIVE          0x0020  // software check and configuration of the CN is in progress
 #define NMTMNU_NODE_FLAG_COUNT_STATREQ          0x0300  // counter for StatusRequest timer handle
 #define NMTMNU_NODE_FLAG_COUNT_LONGER           0x0C00  // counter for longer timeouts timer handle
 #define NMTMNU_NODE_FLAG_INC_STATREQ            0x0100  // increment for StatusRequest timer handle
@@ -173,6 +175,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // d.k. may be replaced by special (hash) function if node ID array is smaller than 254
 #define NMTMNU_GET_NODEINFO(nodeId_p) (&nmtMnuInstance_g.aNodeInfo[nodeId_p - 1])
 
+// boot phase of nodes and network which is currently not timed
+#define NMTMNU_BOOT_PHASE_NONE        kNmtMnuBootPhaseCount
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -282,6 +287,8 @@ typedef struct
     UINT32              pResTimeFirstNs;        ///< PRes time
     BOOL                fPrcSupportIsMissing;   ///< A node configured to be used for PRC is not supporting it
     UINT32              nodeCfgBackup;          ///< Backup of nodeCfg member is used if fPrcSupportIsMissing is TRUE
+    tNmtMnuBootPhase    bootPhase;              ///< Currently timed boot phase of the CN
+    UINT32              bootPhaseStartTime;     ///< Tick count when the CN entered the boot phase
 } tNmtMnuNodeInfo;
 
 /**
@@ -305,6 +312,9 @@ typedef struct
     UINT32              prcPResMnTimeoutNs;             ///< to be commented!
     UINT32              prcPResTimeFirstCorrectionNs;   ///< to be commented!
     UINT32              prcPResTimeFirstNegOffsetNs;    ///< to be commented!
+    UINT                activeConfigCount;              ///< Number of CNs whose configuration is in progress
+    tNmtMnuBootPhase    bootPhase;                      ///< Currently timed boot phase of the network
+    tNmtMnuBootReport   bootReport;                     ///< Timing report of the boot-up
 } tNmtMnuInstance;
 
 //------------------------------------------------------------------------------
@@ -405,6 +415,14 @@ static tNmtState  correctNmtState(UINT8 nmtState_p);
 
 static void handleMissingPrcSupport(UINT nodeId_p, UINT32 featureFlags_p);
 
+static void       startNodeConfig(tNmtMnuNodeInfo* pNodeInfo_p);
+static void       updateNodeConfig(UINT nodeId_p);
+static void       enterNodeBootPhase(tNmtMnuNodeInfo* pNodeInfo_p,
+                                     tNmtMnuBootPhase bootPhase_p);
+static void       leaveNodeBootPhase(tNmtMnuNodeInfo* pNodeInfo_p);
+static void       setNetworkBootPhase(tNmtMnuBootPhase bootPhase_p);
+static void       traceBootReport(void);
+
 /* internal node event handler functions */
 static INT processNodeEventNoIdentResponse(UINT nodeId_p,
                                            tNmtState nodeNmtState_p,
@@ -543,6 +561,7 @@ tOplkError nmtmnu_init(tNmtMnuCbNodeEvent pfnCbNodeEvent_p,
                        tNmtMnuCbBootEvent pfnCbBootEvent_p)
 {
     tOplkError  ret;
+    UINT        index;
 
     OPLK_MEMSET(&nmtMnuInstance_g, 0, sizeof(nmtMnuInstance_g));
 
@@ -555,6 +574,9 @@ tOplkError nmtmnu_init(tNmtMnuCbNodeEvent pfnCbNodeEvent_p,
     nmtMnuInstance_g.pfnCbNodeEvent = pfnCbNodeEvent_p;
     nmtMnuInstance_g.pfnCbBootEvent = pfnCbBootEvent_p;
     nmtMnuInstance_g.statusRequestDelay = 5000L;
+    nmtMnuInstance_g.bootPhase = NMTMNU_BOOT_PHASE_NONE;
+    for (index = 0; index < tabentries(nmtMnuInstance_g.aNodeInfo); index++)
+        nmtMnuInstance_g.aNodeInfo[index].bootPhase = NMTMNU_BOOT_PHASE_NONE;
 
     // register NmtMnResponse callback function
 
@@ -1082,6 +1104,7 @@ tOplkError nmtmnu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
 
         // node processes isochronous and asynchronous frames
         case kNmtMsPreOperational2:
+            setNetworkBootPhase(kNmtMnuBootPhaseBootStep2);
             ret = startBootStep2();
             // wait for NMT state change of CNs
             break;
@@ -1091,6 +1114,7 @@ tOplkError nmtmnu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
             // check if PRes of CNs are OK
             // d.k. that means wait CycleLength * MultiplexCycleCount (i.e. start timer)
             //      because Dllk checks PRes of CNs automatically in ReadyToOp
+            setNetworkBootPhase(kNmtMnuBootPhaseCheckCom);
             ret = startCheckCom();
             break;
 
@@ -1105,6 +1129,7 @@ tOplkError nmtmnu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
 #endif
             // send StartNode to CNs
             // wait for NMT state change of CNs
+            setNetworkBootPhase(kNmtMnuBootPhaseStartNodes);
             ret = startNodes();
             break;
 
@@ -1566,6 +1591,31 @@ tOplkError nmtmnu_configPrc(const tNmtMnuConfigParam* pConfigParam_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get boot report
+
+The function returns the timing report of the boot-up. The report is reset
+when BootStep1 is started and is complete after the boot event
+kNmtBootEventOperational.
+
+\param[out]     pBootReport_p       Pointer to store the boot report.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_nmtmnu
+*/
+//------------------------------------------------------------------------------
+tOplkError nmtmnu_getBootReport(tNmtMnuBootReport* pBootReport_p)
+{
+    if (pBootReport_p == NULL)
+        return kErrorNmtInvalidParam;
+
+    *pBootReport_p = nmtMnuInstance_g.bootReport;
+
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -1883,6 +1933,13 @@ static tOplkError startBootStep1(BOOL fNmtResetAllIssued_p)
     // start network scan
     nmtMnuInstance_g.mandatorySlaveCount = 0;
     nmtMnuInstance_g.signalSlaveCount = 0;
+
+    // restart the boot report
+    nmtMnuInstance_g.activeConfigCount = 0;
+    nmtMnuInstance_g.bootPhase = NMTMNU_BOOT_PHASE_NONE;
+    OPLK_MEMSET(&nmtMnuInstance_g.bootReport, 0, sizeof(nmtMnuInstance_g.bootReport));
+    setNetworkBootPhase(kNmtMnuBootPhaseBootStep1);
+
     // check 0x1F81
     localNodeId = obdu_getNodeId();
 
@@ -1894,6 +1951,9 @@ static tOplkError startBootStep1(BOOL fNmtResetAllIssued_p)
         if (ret != kErrorOk)
             goto Exit;
 
+        pNodeInfo->flags &= ~NMTMNU_NODE_FLAG_CONFIG_ACTIVE;
+        pNodeInfo->bootPhase = NMTMNU_BOOT_PHASE_NONE;
+
         if (subIndex != localNodeId)
         {
             // reset flags "not scanned" and "isochronous"
@@ -1926,6 +1986,8 @@ static tOplkError startBootStep1(BOOL fNmtResetAllIssued_p)
                         goto Exit;
                 }
 
+                enterNodeBootPhase(pNodeInfo, kNmtMnuBootPhaseIdentify);
+
                 // set flag "not scanned"
                 pNodeInfo->flags |= NMTMNU_NODE_FLAG_NOT_SCANNED;
                 nmtMnuInstance_g.signalSlaveCount++;
@@ -1951,6 +2013,7 @@ static tOplkError startBootStep1(BOOL fNmtResetAllIssued_p)
     for (; subIndex <= tabentries(nmtMnuInstance_g.aNodeInfo); subIndex++, pNodeInfo++)
     {   // clear node structure of unused entries
         OPLK_MEMSET(pNodeInfo, 0, sizeof(*pNodeInfo));
+        pNodeInfo->bootPhase = NMTMNU_BOOT_PHASE_NONE;
     }
 
 Exit:
@@ -2005,6 +2068,9 @@ static tOplkError resetRedundancy(void)
         if (ret != kErrorOk)
             goto Exit;
 
+        pNodeInfo->flags &= ~NMTMNU_NODE_FLAG_CONFIG_ACTIVE;
+        pNodeInfo->bootPhase = NMTMNU_BOOT_PHASE_NONE;
+
         if (subIndex != localNodeId)
         {
             // reset flags "not scanned" and "isochronous"
@@ -2038,6 +2104,7 @@ static tOplkError resetRedundancy(void)
     for (; subIndex <= tabentries(nmtMnuInstance_g.aNodeInfo); subIndex++, pNodeInfo++)
     {   // clear node structure of unused entries
         OPLK_MEMSET(pNodeInfo, 0, sizeof(*pNodeInfo));
+        pNodeInfo->bootPhase = NMTMNU_BOOT_PHASE_NONE;
     }
 
 Exit:
@@ -2590,6 +2657,9 @@ static INT processNodeEventIdentResponse(UINT nodeId_p,
                                 nodeId_p,
                                 pNodeInfo->nodeState);
 
+    if (pNodeInfo->bootPhase == kNmtMnuBootPhaseIdentify)
+        leaveNodeBootPhase(pNodeInfo);
+
     if ((pNodeInfo->nodeState != kNmtMnuNodeStateResetConf) &&
         (pNodeInfo->nodeState != kNmtMnuNodeStateConfRestored))
     {
@@ -2735,6 +2805,11 @@ static INT processNodeEventBoot(UINT nodeId_p,
 
     pNodeInfo = NMTMNU_GET_NODEINFO(nodeId_p);
 
+    if ((pNodeInfo->nodeState == kNmtMnuNodeStateIdentified) ||
+        (pNodeInfo->nodeState == kNmtMnuNodeStateSwOk) ||
+        (pNodeInfo->nodeState == kNmtMnuNodeStateConfRestored))
+        startNodeConfig(pNodeInfo);
+
     if (pNodeInfo->nodeState == kNmtMnuNodeStateIdentified)
     {
         if ((nmtMnuInstance_g.nmtStartup & NMT_STARTUP_SWVERSIONCHECK) != 0)
@@ -3653,6 +3728,7 @@ static tOplkError processInternalEvent(UINT nodeId_p,
 {
     tOplkError  ret = kErrorOk;
     tNmtState   nmtState;
+    INT         handlerResult;
 
     nmtState = nmtu_getNmtState();
 
@@ -3670,7 +3746,12 @@ static tOplkError processInternalEvent(UINT nodeId_p,
         goto Exit;
 
     // call internal node event handler
-    if (apfnNodeEventFuncs_l[nodeEvent_p](nodeId_p, nodeNmtState_p, nmtState, errorCode_p, &ret) < 0)
+    handlerResult = apfnNodeEventFuncs_l[nodeEvent_p](nodeId_p, nodeNmtState_p, nmtState, errorCode_p, &ret);
+
+    // finish the configuration timing if the CN has left the configuration
+    updateNodeConfig(nodeId_p);
+
+    if (handlerResult < 0)
         goto Exit;
 
     // check if network is ready to change local NMT state and this was not done before
@@ -3683,6 +3764,8 @@ static tOplkError processInternalEvent(UINT nodeId_p,
                     (nmtMnuInstance_g.mandatorySlaveCount == 0))
                 {   // all optional CNs scanned once and all mandatory CNs configured successfully
                     nmtMnuInstance_g.flags |= NMTMNU_FLAG_APP_INFORMED;
+                    // BootStep1 ends here, waiting for the application is not part of it
+                    setNetworkBootPhase(NMTMNU_BOOT_PHASE_NONE);
                     // inform application
                     ret = nmtMnuInstance_g.pfnCbBootEvent(kNmtBootEventBootStep1Finish,
                                                           nmtState,
@@ -3748,6 +3831,9 @@ static tOplkError processInternalEvent(UINT nodeId_p,
                     (nmtMnuInstance_g.mandatorySlaveCount == 0))
                 {   // all optional CNs scanned once and all mandatory CNs are OPERATIONAL
                     nmtMnuInstance_g.flags |= NMTMNU_FLAG_APP_INFORMED;
+                    setNetworkBootPhase(NMTMNU_BOOT_PHASE_NONE);
+                    traceBootReport();
+
                     // inform application
                     ret = nmtMnuInstance_g.pfnCbBootEvent(kNmtBootEventOperational,
                                                           nmtState,
@@ -5141,12 +5227,12 @@ static tOplkError sendNmtCommand(UINT nodeId_p,
 {
     tOplkError  ret = kErrorOk;
     tFrameInfo  frameInfo;
-    UINT8       aBuffer[C_DLL_MINSIZE_NMTCMDEXT];
+    tPlkFrame   frame;
     tPlkFrame*  pFrame;
 
     // build frame
-    pFrame = (tPlkFrame*)aBuffer;
-    OPLK_MEMSET(pFrame, 0x00, sizeof(aBuffer));
+    pFrame = &frame;
+    OPLK_MEMSET(pFrame, 0x00, C_DLL_MINSIZE_NMTCMDEXT);
     ami_setUint8Le(&pFrame->dstNodeId, (UINT8)nodeId_p);
     ami_setUint8Le(&pFrame->data.asnd.serviceId, (UINT8)kDllAsndNmtCommand);
     ami_setUint8Le(&pFrame->data.asnd.payload.nmtCommandService.nmtCommandId, (UINT8)nmtCommand_p);
@@ -5160,7 +5246,7 @@ static tOplkError sendNmtCommand(UINT nodeId_p,
 
     // build info structure
     frameInfo.frame.pBuffer = pFrame;
-    frameInfo.frameSize = sizeof(aBuffer);
+    frameInfo.frameSize = C_DLL_MINSIZE_NMTCMDEXT;
 
     // send NMT-Request
     ret = dllucal_sendAsyncFrame(&frameInfo, kDllAsyncReqPrioNmt);
@@ -5455,6 +5541,186 @@ static void handleMissingPrcSupport(UINT nodeId_p, UINT32 featureFlags_p)
     }
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Start configuration of a CN
+
+The function is called before the software check and configuration of the
+specified CN is started. It starts timing the configuration phase and records
+the number of concurrent CN configurations in the boot report.
+
+\param[in,out]  pNodeInfo_p         Pointer to node information structure.
+*/
+//------------------------------------------------------------------------------
+static void startNodeConfig(tNmtMnuNodeInfo* pNodeInfo_p)
+{
+    if ((pNodeInfo_p->flags & NMTMNU_NODE_FLAG_CONFIG_ACTIVE) != 0)
+        return;
+
+    pNodeInfo_p->flags |= NMTMNU_NODE_FLAG_CONFIG_ACTIVE;
+    nmtMnuInstance_g.activeConfigCount++;
+    if (nmtMnuInstance_g.activeConfigCount > nmtMnuInstance_g.bootReport.peakParallelConfig)
+        nmtMnuInstance_g.bootReport.peakParallelConfig = nmtMnuInstance_g.activeConfigCount;
+
+    enterNodeBootPhase(pNodeInfo_p, kNmtMnuBootPhaseConfig);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update configuration of a CN
+
+The function is called after every internal node event. It finishes timing
+the configuration phase of the specified CN if the CN has left the
+configuration, i.e. it was configured successfully, its configuration failed
+or it was lost.
+
+\param[in]      nodeId_p            Node ID of the CN.
+*/
+//------------------------------------------------------------------------------
+static void updateNodeConfig(UINT nodeId_p)
+{
+    tNmtMnuNodeInfo*    pNodeInfo;
+
+    if ((nodeId_p == 0) || (nodeId_p > tabentries(nmtMnuInstance_g.aNodeInfo)))
+        return;
+
+    pNodeInfo = NMTMNU_GET_NODEINFO(nodeId_p);
+    if ((pNodeInfo->flags & NMTMNU_NODE_FLAG_CONFIG_ACTIVE) == 0)
+        return;
+
+    switch (pNodeInfo->nodeState)
+    {
+        case kNmtMnuNodeStateIdentified:
+        case kNmtMnuNodeStateSwOk:
+        case kNmtMnuNodeStateConfRestored:
+        case kNmtMnuNodeStateResetConf:
+            // configuration is still in progress
+            return;
+
+        default:
+            break;
+    }
+
+    leaveNodeBootPhase(pNodeInfo);
+
+    pNodeInfo->flags &= ~NMTMNU_NODE_FLAG_CONFIG_ACTIVE;
+    nmtMnuInstance_g.activeConfigCount--;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Enter boot phase of a CN
+
+The function starts timing the specified boot phase of a CN. A boot phase
+which is currently timed for the CN is finished before.
+
+\param[in,out]  pNodeInfo_p         Pointer to node information structure.
+\param[in]      bootPhase_p         Boot phase the CN enters.
+*/
+//------------------------------------------------------------------------------
+static void enterNodeBootPhase(tNmtMnuNodeInfo* pNodeInfo_p,
+                               tNmtMnuBootPhase bootPhase_p)
+{
+    tNmtMnuBootPhaseTime*   pPhase = &nmtMnuInstance_g.bootReport.aPhase[bootPhase_p];
+
+    leaveNodeBootPhase(pNodeInfo_p);
+
+    pNodeInfo_p->bootPhase = bootPhase_p;
+    pNodeInfo_p->bootPhaseStartTime = target_getTickCount();
+
+    if (pPhase->enterCount == 0)
+        pPhase->startTime = pNodeInfo_p->bootPhaseStartTime;
+    pPhase->enterCount++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Leave boot phase of a CN
+
+The function finishes timing the current boot phase of a CN and adds the time
+the CN spent in the phase to the boot report.
+
+\param[in,out]  pNodeInfo_p         Pointer to node information structure.
+*/
+//------------------------------------------------------------------------------
+static void leaveNodeBootPhase(tNmtMnuNodeInfo* pNodeInfo_p)
+{
+    tNmtMnuBootPhaseTime*   pPhase;
+    UINT32                  now;
+    UINT32                  nodeTime;
+
+    if (pNodeInfo_p->bootPhase >= NMTMNU_BOOT_PHASE_NONE)
+        return;
+
+    pPhase = &nmtMnuInstance_g.bootReport.aPhase[pNodeInfo_p->bootPhase];
+    now = target_getTickCount();
+    nodeTime = now - pNodeInfo_p->bootPhaseStartTime;
+
+    pPhase->endTime = now;
+    pPhase->nodeCount++;
+    pPhase->sumNodeTime += nodeTime;
+    if (nodeTime > pPhase->maxNodeTime)
+        pPhase->maxNodeTime = nodeTime;
+
+    pNodeInfo_p->bootPhase = NMTMNU_BOOT_PHASE_NONE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set boot phase of the network
+
+The function finishes timing the current boot phase of the network and starts
+timing the specified one.
+
+\param[in]      bootPhase_p         Boot phase the network enters or
+                                    NMTMNU_BOOT_PHASE_NONE to stop timing.
+*/
+//------------------------------------------------------------------------------
+static void setNetworkBootPhase(tNmtMnuBootPhase bootPhase_p)
+{
+    UINT32  now = target_getTickCount();
+
+    if (nmtMnuInstance_g.bootPhase < NMTMNU_BOOT_PHASE_NONE)
+        nmtMnuInstance_g.bootReport.aPhase[nmtMnuInstance_g.bootPhase].endTime = now;
+
+    if (bootPhase_p < NMTMNU_BOOT_PHASE_NONE)
+    {
+        nmtMnuInstance_g.bootReport.aPhase[bootPhase_p].startTime = now;
+        nmtMnuInstance_g.bootReport.aPhase[bootPhase_p].enterCount++;
+    }
+
+    nmtMnuInstance_g.bootPhase = bootPhase_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Trace boot report
+
+The function prints the timing report of the boot-up to the NMT MN debug
+trace. The phase numbers correspond to \ref eNmtMnuBootPhase.
+*/
+//------------------------------------------------------------------------------
+static void traceBootReport(void)
+{
+    UINT    phase;
+
+    DEBUG_LVL_NMTMN_TRACE("nmtmnu: boot report (parallel configurations: peak %u)\n",
+                          nmtMnuInstance_g.bootReport.peakParallelConfig);
+
+    for (phase = 0; phase < kNmtMnuBootPhaseCount; phase++)
+    {
+        DEBUG_LVL_NMTMN_TRACE("nmtmnu:   phase %u: %lu ms, %u CNs, avg %lu ms, max %lu ms\n",
+                              phase,
+                              (ULONG)(nmtMnuInstance_g.bootReport.aPhase[phase].endTime -
+                                      nmtMnuInstance_g.bootReport.aPhase[phase].startTime),
+                              nmtMnuInstance_g.bootReport.aPhase[phase].nodeCount,
+                              (ULONG)((nmtMnuInstance_g.bootReport.aPhase[phase].nodeCount != 0) ?
+                                      (nmtMnuInstance_g.bootReport.aPhase[phase].sumNodeTime /
+                                       nmtMnuInstance_g.bootReport.aPhase[phase].nodeCount) : 0),
+                              (ULONG)nmtMnuInstance_g.bootReport.aPhase[phase].maxNodeTime);
+    }
+}
+
 /// \}
 
 #endif
@@ -7,6 +7,11 @@
 The file contains implementation for the object dictionary (OD) configuration
 store, load, restore functionality.
 
+The archive of an OD part is built in a memory buffer and written to a
+temporary file when it is closed. The temporary file replaces the archive
+atomically, so a power loss during a store operation keeps the previous
+archive. Archives are read by mapping the file into memory.
+
 \ingroup module_obdconf
 *******************************************************************************/
 
@@ -44,6 +49,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <oplk/obd.h>
+#include <common/ami.h>
 #include <user/obdconf.h>
 
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
@@ -51,6 +57,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if (TARGET_SYSTEM == _LINUX_)
 
 #include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #endif
 
@@ -94,15 +104,22 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OBD_ARCHIVE_FILENAME_EXTENSION      ".bin"
 #endif
 
+#define OBD_ARCHIVE_TMP_EXTENSION           ".tmp"      // Extension of the temporary archive file
+#define OBD_ARCHIVE_HEADER_SIZE             (2 * sizeof(UINT32))
+#define OBD_ARCHIVE_BUFFER_SIZE             1024        // Initial size of the archive buffer
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 typedef struct
 {
-    FILE*       pFdBkupArchiveFile;     ///< Handle for the opened OD part archive
+    UINT8*      pArchive;               ///< Buffer of the opened OD part archive
+    size_t      archiveSize;            ///< Size of the archive data in the buffer
+    size_t      bufferSize;             ///< Size of the allocated archive buffer (write only)
+    size_t      readOffset;             ///< Read position in the archive (read only)
+    BOOL        fWriteError;            ///< Flag to indicate that data couldn't be added to the archive
     const char* pBackupPath;            ///< The parent directory for the archives
     BOOL        fOpenForWrite;          ///< Flag to indicate whether the archive is opened for a write operation
-    UINT16      odDataCrc;              ///< 2 Byte CRC for the last opened archive
     tObdType    curOdPart;              ///< Currently opened OD part archive
 } tObdConfInstance;
 
@@ -118,6 +135,18 @@ static tObdConfInstance aObdConfInstance_l[1];
 static tOplkError getOdPartArchivePath(tObdPart odPart_p,
                                        const char* pBkupPath_p,
                                        char* pFilePathName_p);
+static tOplkError appendArchiveData(tObdConfInstance* pInstEntry_p,
+                                    const void* pData_p,
+                                    size_t size_p);
+static void       releaseArchive(tObdConfInstance* pInstEntry_p);
+static tOplkError writeArchiveFile(const char* pBkupPath_p,
+                                   const char* pFilePath_p,
+                                   const void* pData_p,
+                                   size_t size_p);
+static tOplkError mapArchiveFile(const char* pFilePath_p,
+                                 UINT8** ppArchive_p,
+                                 size_t* pSize_p);
+static void       unmapArchiveFile(UINT8* pArchive_p, size_t size_p);
 
 /***************************************************************************/
 /*          C L A S S  <Store/Load>                                        */
@@ -188,7 +217,7 @@ tOplkError obdconf_init(void)
 
     // Get current instance entry and initialize all members
     OPLK_MEMSET(pInstEntry, 0, sizeof(tObdConfInstance));
-    pInstEntry->pFdBkupArchiveFile = NULL;
+    pInstEntry->pArchive = NULL;
     pInstEntry->curOdPart = kObdPartNo;
 
     return ret;
@@ -198,7 +227,8 @@ tOplkError obdconf_init(void)
 /**
 \brief  Cleanup OD archive module
 
-The function cleans up OD archive module.
+The function cleans up OD archive module. An archive which is still opened
+is discarded.
 
 \return The function returns a tOplkError error code.
 
@@ -210,6 +240,8 @@ tOplkError obdconf_exit(void)
     tOplkError        ret = kErrorOk;
     tObdConfInstance* pInstEntry = &aObdConfInstance_l[0];
 
+    releaseArchive(pInstEntry);
+
     OPLK_MEMSET(pInstEntry, 0, sizeof(tObdConfInstance));
     obdConfSignature_l = (UINT32)~0U;
 
@@ -220,8 +252,8 @@ tOplkError obdconf_exit(void)
 /**
 \brief  Create an archive for the OD part
 
-The function creates an archive for the selected OD part.
-Existing archive is set invalid.
+The function creates an archive for the selected OD part. The archive is
+built in memory and replaces the existing archive when it is closed.
 
 \param[in]      odPart_p            OD part specifier
 \param[in]      odPartSignature_p   Signature for the specified OD part.
@@ -237,60 +269,30 @@ tOplkError obdconf_createPart(tObdPart odPart_p, UINT32 odPartSignature_p)
     char                aFilePath[MAX_PATH_LEN];
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
 
-    // Get the file path for current OD part and instance
+    // Check the OD part
     ret = getOdPartArchivePath(odPart_p, pInstEntry->pBackupPath, &aFilePath[0]);
     if (ret != kErrorOk)
-        goto Exit;
+        return ret;
 
-    // Is the file already opened?
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
-    {
-        ret = kErrorObdStoreInvalidState;
-        goto Exit;
-    }
+    // Is the archive already opened?
+    if (pInstEntry->pArchive != NULL)
+        return kErrorObdStoreInvalidState;
 
-    // Open file for writing
     pInstEntry->fOpenForWrite = TRUE;
+    pInstEntry->fWriteError = FALSE;
     pInstEntry->curOdPart = odPart_p;
-    pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "wb");
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
-    {
-        pInstEntry->curOdPart = kObdPartNo;
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
 
-    // Write target signature and calculate CRC for it
-    pInstEntry->odDataCrc = obdconf_calculateCrc16(0,
-                                                   &obdConfSignature_l,
-                                                   sizeof(obdConfSignature_l));
-    fwrite(&obdConfSignature_l,
-           sizeof(obdConfSignature_l),
-           1,
-           pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // Write OD signature and calculate CRC for it
-    pInstEntry->odDataCrc = obdconf_calculateCrc16(pInstEntry->odDataCrc,
-                                                   &odPartSignature_p,
-                                                   sizeof(odPartSignature_p));
-    fwrite(&odPartSignature_p,
-           sizeof(odPartSignature_p),
-           1,
-           pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile))
-    {
-        ret = kErrorObdStoreHwError;
+    // Write target signature and OD signature
+    ret = appendArchiveData(pInstEntry, &obdConfSignature_l, sizeof(obdConfSignature_l));
+    if (ret != kErrorOk)
         goto Exit;
-    }
 
-    ret = kErrorOk;
+    ret = appendArchiveData(pInstEntry, &odPartSignature_p, sizeof(odPartSignature_p));
 
 Exit:
+    if (ret != kErrorOk)
+        releaseArchive(pInstEntry);
+
     return ret;
 }
 
@@ -298,7 +300,8 @@ Exit:
 /**
 \brief  Delete the archive for the OD part
 
-The function deletes the archive for the selected OD part or sets it invalid.
+The function sets the archive for the selected OD part invalid. The archive is
+replaced by an archive with an invalid OD signature.
 
 \param[in]      odPart_p            OD part specifier
 
@@ -312,51 +315,26 @@ tOplkError obdconf_deletePart(tObdPart odPart_p)
     tOplkError          ret = kErrorObdStoreHwError;
     char                aFilePath[MAX_PATH_LEN];
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
+    UINT8               aArchive[OBD_ARCHIVE_HEADER_SIZE + sizeof(UINT16)];
     UINT32              data = (UINT32)~0U;
+    UINT16              dataCrc;
 
     // Get the file path for current OD part and instance
     ret = getOdPartArchivePath(odPart_p, pInstEntry->pBackupPath, &aFilePath[0]);
     if (ret != kErrorOk)
-        goto Exit;
+        return ret;
 
-    // Use the local file handle to avoid race condition
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
-    {
-        ret = kErrorObdStoreInvalidState;
-        goto Exit;
-    }
+    // An opened archive must not be replaced
+    if (pInstEntry->pArchive != NULL)
+        return kErrorObdStoreInvalidState;
 
-    pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "wb");
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // Set file position to OD part signature
-    fseek(pInstEntry->pFdBkupArchiveFile, sizeof(obdConfSignature_l), SEEK_SET);
-
-    // Mark the signature as invalid
-    fwrite(&data, sizeof(data), 1, pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // $$ Ideally recalculate the CRC and write to make the file as uncorrupted
-
-    ret = kErrorOk;
-
-Exit:
-    // Close archive file and set file handle invalid
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
-    {
-        fclose(pInstEntry->pFdBkupArchiveFile);
-        pInstEntry->pFdBkupArchiveFile = NULL;
-    }
+    // Build an archive with the target signature and an invalid OD signature
+    OPLK_MEMCPY(&aArchive[0], &obdConfSignature_l, sizeof(obdConfSignature_l));
+    OPLK_MEMCPY(&aArchive[sizeof(UINT32)], &data, sizeof(data));
+    dataCrc = obdconf_calculateCrc16(0, aArchive, OBD_ARCHIVE_HEADER_SIZE);
+    ami_setUint16Be(&aArchive[OBD_ARCHIVE_HEADER_SIZE], dataCrc);
 
-    return ret;
+    return writeArchiveFile(pInstEntry->pBackupPath, aFilePath, aArchive, sizeof(aArchive));
 }
 
 //------------------------------------------------------------------------------
@@ -376,7 +354,7 @@ to calling this function.
 //------------------------------------------------------------------------------
 tOplkError obdconf_openReadPart(tObdPart odPart_p)
 {
-    UINT8               ret = kErrorObdStoreHwError;
+    tOplkError          ret = kErrorObdStoreHwError;
     char                aFilePath[MAX_PATH_LEN];
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
 
@@ -385,30 +363,23 @@ tOplkError obdconf_openReadPart(tObdPart odPart_p)
     if (ret != kErrorOk)
         goto Exit;
 
-    // Is the file already opened?
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    // Is the archive already opened?
+    if (pInstEntry->pArchive != NULL)
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Open backup archive file for read
-    pInstEntry->fOpenForWrite = FALSE;
-    pInstEntry->curOdPart = odPart_p;
-    pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "rb");
-
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
-    {
-        // Backup archive file could not be opened
-        pInstEntry->curOdPart = kObdPartNo;
-        ret = kErrorObdStoreHwError;
+    // Map backup archive file for read
+    ret = mapArchiveFile(aFilePath, &pInstEntry->pArchive, &pInstEntry->archiveSize);
+    if (ret != kErrorOk)
         goto Exit;
-    }
 
-    // Set file position to the object data part
-    fseek(pInstEntry->pFdBkupArchiveFile, 2 * sizeof(UINT32), SEEK_SET);
+    pInstEntry->fOpenForWrite = FALSE;
+    pInstEntry->curOdPart = odPart_p;
 
-    ret = kErrorOk;
+    // Set read position to the object data part
+    pInstEntry->readOffset = OBD_ARCHIVE_HEADER_SIZE;
 
 Exit:
     return ret;
@@ -423,7 +394,7 @@ operation to load/store the OD configuration. The OD part archive must exist
 prior to calling this function.
 
 For a write operation, the function appends the calculated CRC to the end of
-archive.
+archive and replaces the archive file atomically.
 
 \param[in]      odPart_p            OD part specifier
 
@@ -435,7 +406,8 @@ archive.
 tOplkError obdconf_closePart(tObdPart odPart_p)
 {
     tOplkError          ret = kErrorOk;
-    UINT8               data;
+    char                aFilePath[MAX_PATH_LEN];
+    UINT8               aCrc[sizeof(UINT16)];
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
 
     if (odPart_p != pInstEntry->curOdPart)
@@ -444,39 +416,44 @@ tOplkError obdconf_closePart(tObdPart odPart_p)
         goto Exit;
     }
 
-    // Is the file not opened?
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    // Is the archive not opened?
+    if (pInstEntry->pArchive == NULL)
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // If file was opened for write we have to add the OD data CRC at the end of the file
+    // If archive was opened for write we have to add the OD data CRC and write it to the file
     if (pInstEntry->fOpenForWrite != FALSE)
     {
-        // Write CRC16 to end of the file (in big endian format)
-        data = (UINT8)((pInstEntry->odDataCrc >> 8) & 0xFF);
-        fwrite(&data, sizeof(data), 1, pInstEntry->pFdBkupArchiveFile);
-        if (ferror(pInstEntry->pFdBkupArchiveFile))
-        {   // Save error code and close the file
+        // An incomplete archive must not replace the existing one
+        if (pInstEntry->fWriteError != FALSE)
+        {
             ret = kErrorObdStoreHwError;
             goto CloseExit;
         }
 
-        data = (UINT8)((pInstEntry->odDataCrc >> 0) & 0xFF);
-        fwrite(&data, sizeof(data), 1, pInstEntry->pFdBkupArchiveFile);
-        if (ferror(pInstEntry->pFdBkupArchiveFile))
-        {   // Save error code and close the file
-            ret = kErrorObdStoreHwError;
+        ret = getOdPartArchivePath(odPart_p, pInstEntry->pBackupPath, &aFilePath[0]);
+        if (ret != kErrorOk)
             goto CloseExit;
-        }
+
+        // Append CRC16 to the archive (in big endian format)
+        ami_setUint16Be(aCrc, obdconf_calculateCrc16(0,
+                                                     pInstEntry->pArchive,
+                                                     pInstEntry->archiveSize));
+        ret = appendArchiveData(pInstEntry, aCrc, sizeof(aCrc));
+        if (ret != kErrorOk)
+            goto CloseExit;
+
+        ret = writeArchiveFile(pInstEntry->pBackupPath,
+                               aFilePath,
+                               pInstEntry->pArchive,
+                               pInstEntry->archiveSize);
     }
 
 CloseExit:
-    // Close archive file and set file handle invalid
-    fclose(pInstEntry->pFdBkupArchiveFile);
-    pInstEntry->curOdPart = kObdPartNo;
-    pInstEntry->pFdBkupArchiveFile = NULL;
+    // Release archive buffer and set archive invalid
+    releaseArchive(pInstEntry);
 
 Exit:
     return ret;
@@ -510,23 +487,17 @@ tOplkError obdconf_storePart(tObdPart odPart_p, const void* pData_p, size_t size
         goto Exit;
     }
 
-    // Is the file not opened?
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    // Is the archive not opened for write?
+    if ((pInstEntry->pArchive == NULL) || (pInstEntry->fOpenForWrite == FALSE))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Write current OD data to the file and calculate the CRC for it
-    pInstEntry->odDataCrc = obdconf_calculateCrc16(pInstEntry->odDataCrc, pData_p, size_p);
-    fwrite(pData_p, size_p, 1, pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    ret = kErrorOk;
+    // Add current OD data to the archive
+    ret = appendArchiveData(pInstEntry, pData_p, size_p);
+    if (ret != kErrorOk)
+        pInstEntry->fWriteError = TRUE;
 
 Exit:
     return ret;
@@ -555,7 +526,6 @@ tOplkError obdconf_loadPart(tObdPart odPart_p,
 {
     tOplkError          ret = kErrorObdStoreHwError;
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
-    size_t              count;
 
     if (odPart_p != pInstEntry->curOdPart)
     {
@@ -563,26 +533,22 @@ tOplkError obdconf_loadPart(tObdPart odPart_p,
         goto Exit;
     }
 
-    // Is the file not opened?
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    // Is the archive not opened for read?
+    if ((pInstEntry->pArchive == NULL) || (pInstEntry->fOpenForWrite != FALSE))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Read OD data from current file position
-    count = fread(pData_p, size_p, 1, pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile) || (count == 0))
+    // Read OD data from current archive position
+    if (size_p > (pInstEntry->archiveSize - pInstEntry->readOffset))
     {
         ret = kErrorObdStoreHwError;
         goto Exit;
     }
 
-    if (feof(pInstEntry->pFdBkupArchiveFile))
-    {
-        ret = kErrorObdStoreDataLimitExceeded;
-        goto Exit;
-    }
+    OPLK_MEMCPY(pData_p, &pInstEntry->pArchive[pInstEntry->readOffset], size_p);
+    pInstEntry->readOffset += size_p;
 
     ret = kErrorOk;
 
@@ -673,9 +639,7 @@ Exit:
 This function checks the data integrity and signature of the specified
 OD part archive and returns if the archive is valid or invalid.
 
-The OD part archive has to opened prior to calling this function.
-The function resets the read pointer for the archive to the beginning
-of the configuration data.
+The OD part archive must not be opened when calling this function.
 
 \param[in]      odPart_p            OD part specifier.
 \param[in]      odPartSignature_p   Signature for the specified OD part.
@@ -692,9 +656,8 @@ tOplkError obdconf_getPartArchiveState(tObdPart odPart_p, UINT32 odPartSignature
     tOplkError          ret = kErrorOk;
     UINT32              readTargetSign;
     UINT32              readOdSign;
-    UINT8               aTempBuffer[8];
-    size_t              count;
-    UINT16              dataCrc;
+    UINT8*              pArchive = NULL;
+    size_t              archiveSize = 0;
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
     char                aFilePath[MAX_PATH_LEN];
 
@@ -703,73 +666,43 @@ tOplkError obdconf_getPartArchiveState(tObdPart odPart_p, UINT32 odPartSignature
     if (ret != kErrorOk)
         goto Exit;
 
-    // Use the local file handle to avoid race conditions
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    // The archive must not be opened
+    if (pInstEntry->pArchive != NULL)
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Open backup archive file for read
-    pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "rb");
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
-    {
-        // Backup archive file could not be opened
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // Set file position to the begin of the file
-    fseek(pInstEntry->pFdBkupArchiveFile, 0, SEEK_SET);
-
-    // Read target signature and calculate the CRC for it
-    count = fread(&readTargetSign, sizeof(readTargetSign), 1, pInstEntry->pFdBkupArchiveFile);
-    dataCrc = obdconf_calculateCrc16(0, &readTargetSign, sizeof(readTargetSign));
-    if (ferror(pInstEntry->pFdBkupArchiveFile) || feof(pInstEntry->pFdBkupArchiveFile) || (count == 0))
-    {
-        ret = kErrorObdStoreHwError;
+    // Map backup archive file for read
+    ret = mapArchiveFile(aFilePath, &pArchive, &archiveSize);
+    if (ret != kErrorOk)
         goto Exit;
-    }
 
-    // Read OD signature and calculate the CRC for it
-    count = fread(&readOdSign, sizeof(readOdSign), 1, pInstEntry->pFdBkupArchiveFile);
-    dataCrc = obdconf_calculateCrc16(dataCrc, &readOdSign, sizeof(readOdSign));
-    if (ferror(pInstEntry->pFdBkupArchiveFile) || feof(pInstEntry->pFdBkupArchiveFile) || (count == 0))
+    if (archiveSize < OBD_ARCHIVE_HEADER_SIZE)
     {
         ret = kErrorObdStoreHwError;
         goto Exit;
     }
 
     // Check if both target signature and OD signature are correct
+    OPLK_MEMCPY(&readTargetSign, &pArchive[0], sizeof(readTargetSign));
+    OPLK_MEMCPY(&readOdSign, &pArchive[sizeof(UINT32)], sizeof(readOdSign));
     if ((readTargetSign != obdConfSignature_l) || (readOdSign  != odPartSignature_p))
     {
         ret = kErrorObdStoreDataObsolete;
         goto Exit;
     }
 
-    // Calculate OD data CRC over all data bytes
-    while (!feof(pInstEntry->pFdBkupArchiveFile))
-    {
-        count = fread(&aTempBuffer[0], 1, sizeof(aTempBuffer), pInstEntry->pFdBkupArchiveFile);
-        if (!ferror(pInstEntry->pFdBkupArchiveFile) && (count > 0))
-            dataCrc = obdconf_calculateCrc16(dataCrc, &aTempBuffer[0], count);
-        else
-            break;
-    }
-
-    // Check OD data CRC (always zero because CRC has to be set at the end of the file in big endian format)
-    if (dataCrc != 0)
+    // Check OD data CRC over the whole archive (always zero because CRC has to be set at the end of the file in big endian format)
+    if (obdconf_calculateCrc16(0, pArchive, archiveSize) != 0)
     {
         ret = kErrorObdStoreHwError;
         goto Exit;
     }
 
 Exit:
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
-    {
-        fclose(pInstEntry->pFdBkupArchiveFile);
-        pInstEntry->pFdBkupArchiveFile = NULL;
-    }
+    if (pArchive != NULL)
+        unmapArchiveFile(pArchive, archiveSize);
 
     return ret;
 }
@@ -878,6 +811,343 @@ Exit:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Append data to the archive
+
+The function appends data to the archive buffer of an archive opened for write.
+The buffer is enlarged if necessary.
+
+\param[in,out]  pInstEntry_p        Pointer to the instance.
+\param[in]      pData_p             Pointer to the data.
+\param[in]      size_p              Size of the data, in bytes.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError appendArchiveData(tObdConfInstance* pInstEntry_p,
+                                    const void* pData_p,
+                                    size_t size_p)
+{
+    UINT8*  pNewBuffer;
+    size_t  newSize;
+
+    if ((pInstEntry_p->archiveSize + size_p) > pInstEntry_p->bufferSize)
+    {
+        newSize = (pInstEntry_p->bufferSize != 0) ? pInstEntry_p->bufferSize : OBD_ARCHIVE_BUFFER_SIZE;
+        while (newSize < (pInstEntry_p->archiveSize + size_p))
+            newSize <<= 1;
+
+        pNewBuffer = (UINT8*)OPLK_MALLOC(newSize);
+        if (pNewBuffer == NULL)
+            return kErrorNoResource;
+
+        if (pInstEntry_p->pArchive != NULL)
+        {
+            OPLK_MEMCPY(pNewBuffer, pInstEntry_p->pArchive, pInstEntry_p->archiveSize);
+            OPLK_FREE(pInstEntry_p->pArchive);
+        }
+
+        pInstEntry_p->pArchive = pNewBuffer;
+        pInstEntry_p->bufferSize = newSize;
+    }
+
+    OPLK_MEMCPY(&pInstEntry_p->pArchive[pInstEntry_p->archiveSize], pData_p, size_p);
+    pInstEntry_p->archiveSize += size_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release the opened archive
+
+The function frees the archive buffer of an archive opened for write or unmaps
+the archive opened for read.
+
+\param[in,out]  pInstEntry_p        Pointer to the instance.
+*/
+//------------------------------------------------------------------------------
+static void releaseArchive(tObdConfInstance* pInstEntry_p)
+{
+    if (pInstEntry_p->pArchive != NULL)
+    {
+        if (pInstEntry_p->fOpenForWrite != FALSE)
+            OPLK_FREE(pInstEntry_p->pArchive);
+        else
+            unmapArchiveFile(pInstEntry_p->pArchive, pInstEntry_p->archiveSize);
+    }
+
+    pInstEntry_p->pArchive = NULL;
+    pInstEntry_p->archiveSize = 0;
+    pInstEntry_p->bufferSize = 0;
+    pInstEntry_p->readOffset = 0;
+    pInstEntry_p->fWriteError = FALSE;
+    pInstEntry_p->curOdPart = kObdPartNo;
+}
+
+#if (TARGET_SYSTEM == _LINUX_)
+//------------------------------------------------------------------------------
+/**
+\brief  Write archive file
+
+The function writes the archive to a temporary file, flushes it to the storage
+and renames it to the archive file. Afterwards the directory is flushed to make
+the rename persistent. Either the old or the new archive exists at any time.
+
+\param[in]      pBkupPath_p         Parent directory path string.
+\param[in]      pFilePath_p         Path of the archive file.
+\param[in]      pData_p             Pointer to the archive data.
+\param[in]      size_p              Size of the archive data, in bytes.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeArchiveFile(const char* pBkupPath_p,
+                                   const char* pFilePath_p,
+                                   const void* pData_p,
+                                   size_t size_p)
+{
+    char            aTmpFilePath[MAX_PATH_LEN];
+    const UINT8*    pData = (const UINT8*)pData_p;
+    ssize_t         written;
+    int             fd;
+
+    if ((strlen(pFilePath_p) + sizeof(OBD_ARCHIVE_TMP_EXTENSION)) > sizeof(aTmpFilePath))
+        return kErrorObdStoreHwError;
+
+    strcpy(aTmpFilePath, pFilePath_p);
+    strcat(aTmpFilePath, OBD_ARCHIVE_TMP_EXTENSION);
+
+    fd = open(aTmpFilePath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return kErrorObdStoreHwError;
+
+    while (size_p > 0)
+    {
+        written = write(fd, pData, size_p);
+        if (written <= 0)
+        {
+            close(fd);
+            unlink(aTmpFilePath);
+            return kErrorObdStoreHwError;
+        }
+
+        pData += written;
+        size_p -= (size_t)written;
+    }
+
+    if ((fsync(fd) != 0) || (close(fd) != 0))
+    {
+        unlink(aTmpFilePath);
+        return kErrorObdStoreHwError;
+    }
+
+    if (rename(aTmpFilePath, pFilePath_p) != 0)
+    {
+        unlink(aTmpFilePath);
+        return kErrorObdStoreHwError;
+    }
+
+    // Flush the directory entry of the renamed file
+    fd = open(((pBkupPath_p != NULL) && (pBkupPath_p[0] != '\0')) ? pBkupPath_p : ".",
+              O_RDONLY | O_DIRECTORY);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Map archive file
+
+The function maps an archive file read-only into memory.
+
+\param[in]      pFilePath_p         Path of the archive file.
+\param[out]     ppArchive_p         Pointer to store the address of the archive.
+\param[out]     pSize_p             Pointer to store the size of the archive.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError mapArchiveFile(const char* pFilePath_p,
+                                 UINT8** ppArchive_p,
+                                 size_t* pSize_p)
+{
+    struct stat fileStat;
+    void*       pArchive;
+    int         fd;
+
+    fd = open(pFilePath_p, O_RDONLY);
+    if (fd < 0)
+        return kErrorObdStoreHwError;
+
+    // An empty file can't be mapped and isn't a valid archive
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0))
+    {
+        close(fd);
+        return kErrorObdStoreHwError;
+    }
+
+    pArchive = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pArchive == MAP_FAILED)
+        return kErrorObdStoreHwError;
+
+    *ppArchive_p = (UINT8*)pArchive;
+    *pSize_p = (size_t)fileStat.st_size;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unmap archive file
+
+The function unmaps an archive file mapped by mapArchiveFile().
+
+\param[in]      pArchive_p          Address of the archive.
+\param[in]      size_p              Size of the archive.
+*/
+//------------------------------------------------------------------------------
+static void unmapArchiveFile(UINT8* pArchive_p, size_t size_p)
+{
+    munmap(pArchive_p, size_p);
+}
+
+#else
+//------------------------------------------------------------------------------
+/**
+\brief  Write archive file
+
+The function writes the archive to a temporary file, flushes it and replaces
+the archive file with it.
+
+\param[in]      pBkupPath_p         Parent directory path string.
+\param[in]      pFilePath_p         Path of the archive file.
+\param[in]      pData_p             Pointer to the archive data.
+\param[in]      size_p              Size of the archive data, in bytes.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeArchiveFile(const char* pBkupPath_p,
+                                   const char* pFilePath_p,
+                                   const void* pData_p,
+                                   size_t size_p)
+{
+    char    aTmpFilePath[MAX_PATH_LEN];
+    FILE*   pFile;
+    size_t  count;
+
+    UNUSED_PARAMETER(pBkupPath_p);
+
+    if ((strlen(pFilePath_p) + sizeof(OBD_ARCHIVE_TMP_EXTENSION)) > sizeof(aTmpFilePath))
+        return kErrorObdStoreHwError;
+
+    strcpy(aTmpFilePath, pFilePath_p);
+    strcat(aTmpFilePath, OBD_ARCHIVE_TMP_EXTENSION);
+
+    pFile = fopen(aTmpFilePath, "wb");
+    if (pFile == NULL)
+        return kErrorObdStoreHwError;
+
+    count = fwrite(pData_p, size_p, 1, pFile);
+    if ((count != 1) || (fflush(pFile) != 0))
+    {
+        fclose(pFile);
+        remove(aTmpFilePath);
+        return kErrorObdStoreHwError;
+    }
+
+    fclose(pFile);
+
+    if (!MoveFileExA(aTmpFilePath, pFilePath_p, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        remove(aTmpFilePath);
+        return kErrorObdStoreHwError;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Map archive file
+
+The function reads an archive file into a buffer.
+
+\param[in]      pFilePath_p         Path of the archive file.
+\param[out]     ppArchive_p         Pointer to store the address of the archive.
+\param[out]     pSize_p             Pointer to store the size of the archive.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError mapArchiveFile(const char* pFilePath_p,
+                                 UINT8** ppArchive_p,
+                                 size_t* pSize_p)
+{
+    FILE*   pFile;
+    long    fileSize;
+    UINT8*  pArchive;
+
+    pFile = fopen(pFilePath_p, "rb");
+    if (pFile == NULL)
+        return kErrorObdStoreHwError;
+
+    if ((fseek(pFile, 0, SEEK_END) != 0) ||
+        ((fileSize = ftell(pFile)) <= 0) ||
+        (fseek(pFile, 0, SEEK_SET) != 0))
+    {
+        fclose(pFile);
+        return kErrorObdStoreHwError;
+    }
+
+    pArchive = (UINT8*)OPLK_MALLOC((size_t)fileSize);
+    if (pArchive == NULL)
+    {
+        fclose(pFile);
+        return kErrorNoResource;
+    }
+
+    if (fread(pArchive, (size_t)fileSize, 1, pFile) != 1)
+    {
+        fclose(pFile);
+        OPLK_FREE(pArchive);
+        return kErrorObdStoreHwError;
+    }
+
+    fclose(pFile);
+
+    *ppArchive_p = pArchive;
+    *pSize_p = (size_t)fileSize;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unmap archive file
+
+The function frees an archive read by mapArchiveFile().
+
+\param[in]      pArchive_p          Address of the archive.
+\param[in]      size_p              Size of the archive.
+*/
+//------------------------------------------------------------------------------
+static void unmapArchiveFile(UINT8* pArchive_p, size_t size_p)
+{
+    UNUSED_PARAMETER(size_p);
+
+    OPLK_FREE(pArchive_p);
+}
+#endif
+
 /// \}
 
 #endif // if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
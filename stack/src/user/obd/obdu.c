@@ -71,6 +71,19 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define OBD_INDEX_TABLE_MIN_SIZE    16          // Min. number of slots of the index hash table
+
+// First index behind the device part
+#if (CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART == FALSE)
+#define OBD_DEVICE_PART_END         0x9FFF
+#else
+#define OBD_DEVICE_PART_END         0xFFFF
+#endif
+
+// Hash function of the index hash table (Fibonacci hashing)
+#define OBD_INDEX_HASH(index)       ((UINT)(((UINT32)(index) * 0x9E3779B1UL) >> 16))
+
+#define OBD_SIGNATURE_BUFFER_SIZE   256         // Size of the buffer for collecting OD signature data
 
 //------------------------------------------------------------------------------
 // local types
@@ -88,11 +101,24 @@ typedef struct
     tObdSize        (*pfnGetObjSize)(const tObdSubEntry* pSubIndexEntry_p);
 } tObdDataTypeSize;
 
+#if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
+// OD signature calculation, the data is collected in a buffer to calculate
+// the CRC over larger blocks
+typedef struct
+{
+    UINT16          crc;                                    // CRC of the already processed data
+    size_t          size;                                   // Number of collected bytes
+    UINT8           aData[OBD_SIGNATURE_BUFFER_SIZE];       // Collected data
+} tObdSignatureCalc;
+#endif
+
 typedef struct
 {
     tObdInitParam                   initParam;
     tObdAccessCallback              pfnAccessCb;
     tObdStoreLoadCallback           pfnStoreLoadObjectCb;
+    const tObdEntry**               paIndexTable;           ///< Hash table of all index entries (open addressing)
+    UINT                            indexTableMask;         ///< Number of hash table slots - 1
 #if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
     UINT32                          aOdSignature[3];
 #endif
@@ -161,11 +187,13 @@ static tOplkError   getEntry(UINT index_p,
 static const void*  getObjectDefaultPtr(const tObdSubEntry* pSubIndexEntry_p);
 static void*        getObjectCurrentPtr(const tObdSubEntry* pSubIndexEntry_p);
 static void*        getObjectDataPtr(const tObdSubEntry* pSubIndexEntry_p);
-static tObdEntry*   searchIndex(const tObdEntry* pObdEntry_p,
-                                UINT32 numEntries_p,
-                                UINT index_p);
-static tOplkError   getIndex(const tObdInitParam* pInitParam_p,
-                             UINT index_p,
+static tOplkError   buildIndexTable(const tObdInitParam* pInitParam_p);
+static void         freeIndexTable(void);
+static void         insertIndexEntries(const tObdEntry* pObdEntry_p,
+                                       UINT32 numEntries_p,
+                                       UINT firstIndex_p,
+                                       UINT endIndex_p);
+static tOplkError   getIndex(UINT index_p,
                              const tObdEntry** ppObdEntry_p);
 static tOplkError   getSubindex(const tObdEntry* pObdEntry_p,
                                 UINT subIndex_p,
@@ -189,7 +217,8 @@ static void         calcOdIndexNum(tObdInitParam* pInitParam_p);
 
 #if (CONFIG_OBD_CHECK_OBJECT_RANGE != FALSE)
 static tOplkError   checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
-                                     const void* pData_p);
+                                     const void* pData_p,
+                                     tObdSize size_p);
 #endif
 
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
@@ -204,6 +233,13 @@ static tOplkError   doStoreRestore(tObdAccess access_p,
 static tOplkError   callStoreCallback(const tObdCbStoreParam* pCbStoreParam_p);
 #endif // (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
 
+#if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
+static void         addSignatureData(tObdSignatureCalc* pSignCalc_p,
+                                     const void* pData_p,
+                                     size_t size_p);
+static UINT16       finishSignature(tObdSignatureCalc* pSignCalc_p);
+#endif
+
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
@@ -286,6 +322,10 @@ tOplkError obdu_init(const tObdInitParam* pInitParam_p,
 
     calcOdIndexNum(&obdInstance_l.initParam);
 
+    ret = buildIndexTable(&obdInstance_l.initParam);
+    if (ret != kErrorOk)
+        return ret;
+
     // initialize object dictionary
     // so all all VarEntries will be initialized to trash object and default values will be set to current data
     ret = obdu_accessOdPart(kObdPartAll, kObdDirInit);
@@ -306,6 +346,8 @@ The function shuts down the OD module.
 //------------------------------------------------------------------------------
 tOplkError obdu_exit(void)
 {
+    freeIndexTable();
+
     return kErrorOk;
 }
 
@@ -586,7 +628,7 @@ void* obdu_getObjectDataPtr(UINT index_p, UINT subIndex_p)
     const tObdSubEntry* pObdSubEntry;
 
     // get pointer to index structure
-    ret = getIndex(&obdInstance_l.initParam, index_p, &pObdEntry);
+    ret = getIndex(index_p, &pObdEntry);
     if (ret != kErrorOk)
         return NULL;
 
@@ -613,9 +655,11 @@ The function registers a user object dictionary.
 //------------------------------------------------------------------------------
 tOplkError obdu_registerUserOd(const tObdEntry* pUserOd_p)
 {
-    obdInitParam_l.pUserPart = (tObdEntry*)pUserOd_p;
+    obdInstance_l.initParam.pUserPart = (tObdEntry*)pUserOd_p;
+    obdInstance_l.initParam.numUser = (pUserOd_p != NULL) ? calcPartitionIndexNum(pUserOd_p) : 0;
 
-    return kErrorOk;
+    // The user OD entries have to be added to the index table
+    return buildIndexTable(&obdInstance_l.initParam);
 }
 #endif
 
@@ -679,7 +723,7 @@ tObdSize obdu_getDataSize(UINT index_p, UINT subIndex_p)
     const tObdEntry*    pObdEntry;
     const tObdSubEntry* pObdSubEntry;
 
-    ret = getIndex(&obdInstance_l.initParam, index_p, &pObdEntry);
+    ret = getIndex(index_p, &pObdEntry);
     if (ret != kErrorOk)
         return 0;
 
@@ -799,7 +843,7 @@ tOplkError obdu_isNumerical(UINT index_p,
     // Check parameter validity
     ASSERT(pfEntryNumerical_p != NULL);
 
-    ret = getIndex(&obdInstance_l.initParam, index_p, &pObdEntry);
+    ret = getIndex(index_p, &pObdEntry);
     if (ret != kErrorOk)
         return ret;
 
@@ -839,7 +883,7 @@ tOplkError obdu_getType(UINT index_p,
     // Check parameter validity
     ASSERT(pType_p != NULL);
 
-    ret = getIndex(&obdInstance_l.initParam, index_p, &pObdEntry);
+    ret = getIndex(index_p, &pObdEntry);
     if (ret != kErrorOk)
         return ret;
 
@@ -1022,7 +1066,11 @@ tOplkError obdu_writeEntryFromLe(UINT index_p,
     tObdCbParam         cbParam;
     void*               pDstData;
     tObdSize            obdSize;
-    UINT64              buffer;
+    union
+    {
+        UINT64          uint64;
+        tTimeOfDay      timeOfDay;
+    }                   buffer;
     void*               pBuffer = &buffer;
 
     // Check parameter validity
@@ -1087,7 +1135,7 @@ tOplkError obdu_writeEntryFromLe(UINT index_p,
 
         case kObdTypeTimeOfDay:
         case kObdTypeTimeDiff:
-            ami_getTimeOfDay(pSrcData_p, (tTimeOfDay*)pBuffer);
+            ami_getTimeOfDay(pSrcData_p, &buffer.timeOfDay);
             break;
 
         default:
@@ -1127,7 +1175,7 @@ tOplkError obdu_getAccessType(UINT index_p,
     // Check parameter validity
     ASSERT(pAccessType_p != NULL);
 
-    ret = getIndex(&obdInstance_l.initParam, index_p, &pObdEntry);
+    ret = getIndex(index_p, &pObdEntry);
     if (ret != kErrorOk)
         return ret;
 
@@ -1913,7 +1961,7 @@ static tOplkError writeEntryPost(const tObdEntry* pObdEntry_p,
     // now the range of the value may be checked
 #if (CONFIG_OBD_CHECK_OBJECT_RANGE != FALSE)
     {
-        ret = checkObjectRange(pSubEntry_p, pSrcData_p);
+        ret = checkObjectRange(pSubEntry_p, pSrcData_p, obdSize_p);
         if (ret != kErrorOk)
             return ret;
     }
@@ -2200,7 +2248,7 @@ static tOplkError getEntry(UINT index_p,
     tObdCbParam         cbParam;
     tOplkError          ret;
 
-    ret = getIndex(&obdInstance_l.initParam, index_p, &pObdEntry);
+    ret = getIndex(index_p, &pObdEntry);
     if (ret != kErrorOk)
         return ret;
 
@@ -2346,49 +2394,6 @@ static void* getObjectDataPtr(const tObdSubEntry* pSubIndexEntry_p)
     return pData;
 }
 
-//------------------------------------------------------------------------------
-/**
-\brief  Search for index in OBD
-
-The function searches for an index in an OD part. It uses a binary search
-algorithm for searching.
-
-\param[in]      pObdEntry_p         OD entry to start searching.
-\param[in]      numEntries_p        Number of OD entries.
-\param[in]      index_p             Index to search.
-
-\return The function returns the pointer to the OD entry of the searched index.
-        If the index isn't found it returns NULL.
-*/
-//------------------------------------------------------------------------------
-static tObdEntry* searchIndex(const tObdEntry* pObdEntry_p,
-                              UINT32 numEntries_p,
-                              UINT index_p)
-{
-    UINT32  first;
-    UINT32  last;
-    UINT32  middle;
-
-    if (numEntries_p == 0)
-        return NULL;
-
-    first = 0;
-    last = numEntries_p - 1;
-
-    while (first <= last)
-    {
-        middle = (first + last) >> 1;
-        if (pObdEntry_p[middle].index == index_p)
-            return (tObdEntry*)&pObdEntry_p[middle];
-        else if (pObdEntry_p[middle].index < index_p)
-            first = middle + 1;
-        else
-            last = middle - 1;
-    }
-
-    return NULL;
-}
-
 //------------------------------------------------------------------------------
 /**
 \brief  Calculate number of OD entries in partition
@@ -2447,105 +2452,156 @@ static void calcOdIndexNum(tObdInitParam* pInitParam_p)
 
 //------------------------------------------------------------------------------
 /**
-\brief  Get an index entry from the OD
+\brief  Build index table
 
-The function searches for an index entry in the OD.
+The function builds the hash table which is used to look up the index entries
+of the OD. The table uses open addressing with linear probing and has at least
+twice as many slots as the OD has indices. An already existing table is
+replaced.
+
+An index is only added for the partition which is searched for it, as the
+partitions only cover their index range. If an index exists in a static part
+and in the user OD, the static entry is used.
 
 \param[in]      pInitParam_p        Pointer to the OD initialization parameters.
-\param[in]      index_p             Index to search.
-\param[out]     ppObdEntry_p        Pointer to store OD entry.
 
 \return The function returns a tOplkError error code.
 */
 //------------------------------------------------------------------------------
-static tOplkError getIndex(const tObdInitParam* pInitParam_p,
-                           UINT index_p,
-                           const tObdEntry** ppObdEntry_p)
+static tOplkError buildIndexTable(const tObdInitParam* pInitParam_p)
 {
-    const tObdEntry*    pObdEntry;
-    UINT32              numEntries;
+    UINT32  numEntries;
+    UINT    tableSize;
 
-#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
-    UINT            nLoop;
+    freeIndexTable();
 
-    // if user OD is used then objects also has to be searched in user OD
-    // there is less code need if we do this in a loop
-    nLoop = 2;
+    numEntries = pInitParam_p->numGeneric +
+                 pInitParam_p->numManufacturer +
+                 pInitParam_p->numDevice;
+#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
+    numEntries += pInitParam_p->numUser;
 #endif
 
-    // get start address of OD part
-    // start address depends on object index because
-    // object dictionary is divided in 3 parts
-    if ((index_p >= 0x1000) && (index_p < 0x2000))
-    {
-        pObdEntry = pInitParam_p->pGenericPart;
-        numEntries = pInitParam_p->numGeneric;
-    }
-    else if ((index_p >= 0x2000) && (index_p < 0x6000))
-    {
-        pObdEntry = pInitParam_p->pManufacturerPart;
-        numEntries = pInitParam_p->numManufacturer;
-    }
+    tableSize = OBD_INDEX_TABLE_MIN_SIZE;
+    while (tableSize < (numEntries * 2))
+        tableSize <<= 1;
 
-    // index range 0xA000 to 0xFFFF is reserved for DSP-405
-    // DS-301 defines that range 0x6000 to 0x9FFF (!!!) is stored if "store" was written to 0x1010/3.
-    // Therefore default configuration is CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART = FALSE.
-    // But a CANopen Application which does not implement dynamic OD or user-OD
-    // but wants to use static objects 0xA000... should set
-    // CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART to TRUE.
-#if (CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART == FALSE)
-    else if ((index_p >= 0x6000) && (index_p < 0x9FFF))
-#else
-    else if ((index_p >= 0x6000) && (index_p < 0xFFFF))
+    obdInstance_l.paIndexTable = (const tObdEntry**)OPLK_MALLOC(tableSize * sizeof(const tObdEntry*));
+    if (obdInstance_l.paIndexTable == NULL)
+        return kErrorNoResource;
+
+    OPLK_MEMSET(obdInstance_l.paIndexTable, 0, tableSize * sizeof(const tObdEntry*));
+    obdInstance_l.indexTableMask = tableSize - 1;
+
+    insertIndexEntries(pInitParam_p->pGenericPart, pInitParam_p->numGeneric, 0x1000, 0x2000);
+    insertIndexEntries(pInitParam_p->pManufacturerPart, pInitParam_p->numManufacturer, 0x2000, 0x6000);
+    insertIndexEntries(pInitParam_p->pDevicePart, pInitParam_p->numDevice, 0x6000, OBD_DEVICE_PART_END);
+#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
+    insertIndexEntries(pInitParam_p->pUserPart, pInitParam_p->numUser, 0x0000, 0x10000);
 #endif
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free index table
+
+The function frees the index hash table.
+*/
+//------------------------------------------------------------------------------
+static void freeIndexTable(void)
+{
+    if (obdInstance_l.paIndexTable != NULL)
     {
-        pObdEntry = pInitParam_p->pDevicePart;
-        numEntries = pInitParam_p->numDevice;
+        OPLK_FREE(obdInstance_l.paIndexTable);
+        obdInstance_l.paIndexTable = NULL;
     }
 
-#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
-    // if index does not match in static OD then index only has to be searched in user OD
-    else
+    obdInstance_l.indexTableMask = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Insert index entries into the index table
+
+The function inserts the index entries of an OD part into the index hash table.
+Entries outside of the index range of the part and indices which are already
+in the table are skipped.
+
+\param[in]      pObdEntry_p         Pointer to the first index entry of the part.
+\param[in]      numEntries_p        Number of index entries of the part.
+\param[in]      firstIndex_p        First index of the range covered by the part.
+\param[in]      endIndex_p          First index behind the range covered by the part.
+*/
+//------------------------------------------------------------------------------
+static void insertIndexEntries(const tObdEntry* pObdEntry_p,
+                               UINT32 numEntries_p,
+                               UINT firstIndex_p,
+                               UINT endIndex_p)
+{
+    UINT    slot;
+
+    if (pObdEntry_p == NULL)
+        return;
+
+    for (; numEntries_p > 0; numEntries_p--, pObdEntry_p++)
     {
-        pObdEntry = pInitParam_p->pUserPart;            // begin from first entry of user OD part
+        if ((pObdEntry_p->index < firstIndex_p) || (pObdEntry_p->index >= endIndex_p))
+            continue;
 
-        // no user OD is available
-        if (pObdEntry == NULL)
-            return kErrorObdIndexNotExist;
+        slot = OBD_INDEX_HASH(pObdEntry_p->index) & obdInstance_l.indexTableMask;
+        while ((obdInstance_l.paIndexTable[slot] != NULL) &&
+               (obdInstance_l.paIndexTable[slot]->index != pObdEntry_p->index))
+            slot = (slot + 1) & obdInstance_l.indexTableMask;
 
-        numEntries = pInitParam_p->numUser;
-        nLoop = 1;                                      // loop must only run once
+        if (obdInstance_l.paIndexTable[slot] == NULL)
+            obdInstance_l.paIndexTable[slot] = pObdEntry_p;
     }
-#else
-    // no user OD is available, so other object can be found in OD
-    else
-        return kErrorObdIllegalPart;
-#endif
+}
 
-#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
-    do
-    {
-        if ((*ppObdEntry_p = searchIndex(pObdEntry, numEntries, index_p)) != NULL)
-            return kErrorOk;
+//------------------------------------------------------------------------------
+/**
+\brief  Get an index entry from the OD
 
-        // begin from first entry of user OD part
-        pObdEntry = pInitParam_p->pUserPart;
-        numEntries = pInitParam_p->numUser;
+The function looks up an index entry in the index hash table of the OD.
 
-        // no user OD is available
-        if (pObdEntry == NULL)
-            return kErrorObdIndexNotExist;
+\param[in]      index_p             Index to search.
+\param[out]     ppObdEntry_p        Pointer to store OD entry.
 
-        // switch next loop for user OD
-        nLoop--;
-    } while (nLoop > 0);
-#else
-    // No user OD we only need to search once
-    if ((*ppObdEntry_p = searchIndex(pObdEntry, numEntries, index_p)) != NULL)
-        return kErrorOk;
-#endif
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError getIndex(UINT index_p,
+                           const tObdEntry** ppObdEntry_p)
+{
+    const tObdEntry*    pObdEntry;
+    UINT                slot;
 
+    if (obdInstance_l.paIndexTable != NULL)
+    {
+        slot = OBD_INDEX_HASH(index_p) & obdInstance_l.indexTableMask;
+        while ((pObdEntry = obdInstance_l.paIndexTable[slot]) != NULL)
+        {
+            if (pObdEntry->index == index_p)
+            {
+                *ppObdEntry_p = pObdEntry;
+                return kErrorOk;
+            }
+
+            slot = (slot + 1) & obdInstance_l.indexTableMask;
+        }
+    }
+
+#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
     return kErrorObdIndexNotExist;
+#else
+    // no user OD is available, so other objects can't be found in OD
+    if ((index_p >= 0x1000) && (index_p < OBD_DEVICE_PART_END))
+        return kErrorObdIndexNotExist;
+
+    return kErrorObdIllegalPart;
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -2572,6 +2628,33 @@ static tOplkError getSubindex(const tObdEntry* pObdEntry_p,
     pSubEntry = pObdEntry_p->pSubIndex;
     nSubIndexCount = pObdEntry_p->count;
 
+    // An array consists of the entry for sub-index 0 and one entry for all elements
+    if ((nSubIndexCount > 1) && ((pSubEntry[1].access & kObdAccArray) != 0))
+    {
+        if (subIndex_p == 0)
+        {
+            *ppObdSubEntry_p = pSubEntry;
+            return kErrorOk;
+        }
+
+        if (subIndex_p < nSubIndexCount)
+        {
+            // update sub-index number (sub-index entry of an array is always in RAM !!!)
+            pSubEntry[1].subIndex = subIndex_p;
+            *ppObdSubEntry_p = &pSubEntry[1];
+            return kErrorOk;
+        }
+
+        return kErrorObdSubindexNotExist;
+    }
+
+    // The sub-indices of most records have no gaps, so try a direct access
+    if ((subIndex_p < nSubIndexCount) && (pSubEntry[subIndex_p].subIndex == subIndex_p))
+    {
+        *ppObdSubEntry_p = &pSubEntry[subIndex_p];
+        return kErrorOk;
+    }
+
     // search sub-index in sub-index table
     while (nSubIndexCount > 0)
     {
@@ -2638,7 +2721,12 @@ static tOplkError accessOdPartition(tObdPart currentOdPart_p,
 #endif
 
 #if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
-    UINT32              odCrc = 0;
+    tObdSignatureCalc   signCalc;
+#endif
+
+#if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
+    signCalc.crc = 0;
+    signCalc.size = 0;
 #endif
 
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
@@ -2666,8 +2754,8 @@ static tOplkError accessOdPartition(tObdPart currentOdPart_p,
 #if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
             if (direction_p == kObdDirInit)
             {
-                odCrc = obdconf_calculateCrc16(odCrc, &pObdEntry_p->index, sizeof(pObdEntry_p->index));
-                odCrc = obdconf_calculateCrc16(odCrc, &pObdEntry_p->count, sizeof(pObdEntry_p->count));
+                addSignatureData(&signCalc, &pObdEntry_p->index, sizeof(pObdEntry_p->index));
+                addSignatureData(&signCalc, &pObdEntry_p->count, sizeof(pObdEntry_p->count));
             }
 #endif
 
@@ -2681,9 +2769,9 @@ static tOplkError accessOdPartition(tObdPart currentOdPart_p,
 #if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
                 if (direction_p == kObdDirInit)
                 {
-                    odCrc = obdconf_calculateCrc16(odCrc, &pSubIndex->subIndex, sizeof(pSubIndex->subIndex));
-                    odCrc = obdconf_calculateCrc16(odCrc, &pSubIndex->type, sizeof(pSubIndex->type));
-                    odCrc = obdconf_calculateCrc16(odCrc, &pSubIndex->access, sizeof(pSubIndex->access));
+                    addSignatureData(&signCalc, &pSubIndex->subIndex, sizeof(pSubIndex->subIndex));
+                    addSignatureData(&signCalc, &pSubIndex->type, sizeof(pSubIndex->type));
+                    addSignatureData(&signCalc, &pSubIndex->access, sizeof(pSubIndex->access));
                 }
 #endif
 
@@ -2795,15 +2883,15 @@ static tOplkError accessOdPartition(tObdPart currentOdPart_p,
         switch (currentOdPart_p)
         {
             case kObdPartGen:
-                obdInstance_l.aOdSignature[0] = odCrc;
+                obdInstance_l.aOdSignature[0] = finishSignature(&signCalc);
                 break;
 
             case kObdPartMan:
-                obdInstance_l.aOdSignature[1] = odCrc;
+                obdInstance_l.aOdSignature[1] = finishSignature(&signCalc);
                 break;
 
             case kObdPartDev:
-                obdInstance_l.aOdSignature[2] = odCrc;
+                obdInstance_l.aOdSignature[2] = finishSignature(&signCalc);
                 break;
 
             default:
@@ -2959,27 +3047,44 @@ static tOplkError isNumerical(const tObdSubEntry* pObdSubEntry_p,
 /**
 \brief  Check value range of object
 
-The function checks the value range of an object.
-
-\note The pointer of data (pData_p) must point out to an even address, if
-ObjType is unequal to kObdTypeInt8 or kObdTypeUInt8!
+The function checks the value range of an object. The data is copied into a
+local buffer first, so it is never read beyond the given size.
 
 \param[in]      pSubIndexEntry_p    Pointer to the sub-index entry structure of the object.
 \param[in]      pData_p             Pointer to the data to be checked.
+\param[in]      size_p              Size of the data to be checked.
 
 \return The function returns a tOplkError error code.
 */
 //------------------------------------------------------------------------------
 static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
-                                   const void* pData_p)
+                                   const void* pData_p,
+                                   tObdSize size_p)
 {
     tOplkError  ret = kErrorOk;
     const void* pRangeData;
+    union
+    {
+        tObdInteger8    int8;
+        tObdUnsigned8   uint8;
+        tObdInteger16   int16;
+        tObdUnsigned16  uint16;
+        tObdInteger32   int32;
+        tObdUnsigned32  uint32;
+        tObdReal32      real32;
+        tObdInteger64   int64;
+        tObdUnsigned64  uint64;
+        tObdReal64      real64;
+    }           value;
 
     // check if data range has to be checked
     if ((pSubIndexEntry_p->access & kObdAccRange) == 0)
         return ret;
 
+    // numerical values are never larger than the buffer, all other types aren't checked
+    OPLK_MEMSET(&value, 0, sizeof(value));
+    OPLK_MEMCPY(&value, pData_p, (size_p < sizeof(value)) ? size_p : sizeof(value));
+
     pRangeData = pSubIndexEntry_p->pDefault;    // get address of default data
 
     // jump to called object type
@@ -2991,14 +3096,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
         // ObdTypes which has to be checked up because numerical values
         case kObdTypeInt8:
             pRangeData = ((const tObdInteger8*)pRangeData) + 1;     // switch to lower limit
-            if (*((const tObdInteger8*)pData_p) < *((const tObdInteger8*)pRangeData))
+            if (value.int8 < *((const tObdInteger8*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdInteger8*)pRangeData) + 1;     // switch to higher limit
-            if (*((const tObdInteger8*)pData_p) > *((const tObdInteger8*)pRangeData))
+            if (value.int8 > *((const tObdInteger8*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3006,14 +3111,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
 
         case kObdTypeUInt8:
             pRangeData = ((const tObdUnsigned8*)pRangeData) + 1;    // switch to lower limit
-            if (*((const tObdUnsigned8*)pData_p) < *((const tObdUnsigned8*)pRangeData))
+            if (value.uint8 < *((const tObdUnsigned8*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdUnsigned8*)pRangeData) + 1;    // switch to higher limit
-            if (*((const tObdUnsigned8*)pData_p) > *((const tObdUnsigned8*)pRangeData))
+            if (value.uint8 > *((const tObdUnsigned8*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3021,14 +3126,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
 
         case kObdTypeInt16:
             pRangeData = ((const tObdInteger16*)pRangeData) + 1;    // switch to lower limit
-            if (*((const tObdInteger16*)pData_p) < *((const tObdInteger16*)pRangeData))
+            if (value.int16 < *((const tObdInteger16*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdInteger16*)pRangeData) + 1;    // switch to higher limit
-            if (*((const tObdInteger16*)pData_p) > *((const tObdInteger16*)pRangeData))
+            if (value.int16 > *((const tObdInteger16*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3036,14 +3141,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
 
         case kObdTypeUInt16:
             pRangeData = ((const tObdUnsigned16*)pRangeData) + 1;   // switch to lower limit
-            if (*((const tObdUnsigned16*)pData_p) < *((const tObdUnsigned16*)pRangeData))
+            if (value.uint16 < *((const tObdUnsigned16*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdUnsigned16*)pRangeData) + 1;   // switch to higher limit
-            if (*((const tObdUnsigned16*)pData_p) > *((const tObdUnsigned16*)pRangeData))
+            if (value.uint16 > *((const tObdUnsigned16*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3051,14 +3156,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
 
         case kObdTypeInt32:
             pRangeData = ((const tObdInteger32*)pRangeData) + 1;    // switch to lower limit
-            if (*((const tObdInteger32*)pData_p) < *((const tObdInteger32*)pRangeData))
+            if (value.int32 < *((const tObdInteger32*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdInteger32*)pRangeData) + 1;    // switch to higher limit
-            if (*((const tObdInteger32*)pData_p) > *((const tObdInteger32*)pRangeData))
+            if (value.int32 > *((const tObdInteger32*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3066,14 +3171,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
 
         case kObdTypeUInt32:
             pRangeData = ((const tObdUnsigned32*)pRangeData) + 1;   // switch to lower limit
-            if (*((const tObdUnsigned32*)pData_p) < *((const tObdUnsigned32*)pRangeData))
+            if (value.uint32 < *((const tObdUnsigned32*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdUnsigned32*)pRangeData) + 1;   // switch to higher limit
-            if (*((const tObdUnsigned32*)pData_p) > *((const tObdUnsigned32*)pRangeData))
+            if (value.uint32 > *((const tObdUnsigned32*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3081,14 +3186,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
 
         case kObdTypeReal32:
             pRangeData = ((const tObdReal32*)pRangeData) + 1;       // switch to lower limit
-            if (*((const tObdReal32*)pData_p) < *((const tObdReal32*)pRangeData))
+            if (value.real32 < *((const tObdReal32*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdReal32*)pRangeData) + 1;       // switch to higher limit
-            if (*((const tObdReal32*)pData_p) > *((const tObdReal32*)pRangeData))
+            if (value.real32 > *((const tObdReal32*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3099,14 +3204,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
         case kObdTypeInt56:
         case kObdTypeInt64:
             pRangeData = ((const tObdInteger64*)pRangeData) + 1;    // switch to lower limit
-            if (*((const tObdInteger64*)pData_p) < *((const tObdInteger64*)pRangeData))
+            if (value.int64 < *((const tObdInteger64*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdInteger64*)pRangeData) + 1;    // switch to higher limit
-            if (*((const tObdInteger64*)pData_p) > *((const tObdInteger64*)pRangeData))
+            if (value.int64 > *((const tObdInteger64*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3117,14 +3222,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
         case kObdTypeUInt56:
         case kObdTypeUInt64:
             pRangeData = ((const tObdUnsigned64*)pRangeData) + 1;   // switch to lower limit
-            if (*((const tObdUnsigned64*)pData_p) < *((const tObdUnsigned64*)pRangeData))
+            if (value.uint64 < *((const tObdUnsigned64*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdUnsigned64*)pRangeData) + 1;   // switch to higher limit
-            if (*((const tObdUnsigned64*)pData_p) > *((const tObdUnsigned64*)pRangeData))
+            if (value.uint64 > *((const tObdUnsigned64*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3132,14 +3237,14 @@ static tOplkError checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
 
         case kObdTypeReal64:
             pRangeData = ((const tObdReal64*)pRangeData) + 1;       // switch to lower limit
-            if (*((const tObdReal64*)pData_p) < *((const tObdReal64*)pRangeData))
+            if (value.real64 < *((const tObdReal64*)pRangeData))
             {
                 ret = kErrorObdValueTooLow;
                 break;
             }
 
             pRangeData = ((const tObdReal64*)pRangeData) + 1;       // switch to higher limit
-            if (*((const tObdReal64*)pData_p) > *((const tObdReal64*)pRangeData))
+            if (value.real64 > *((const tObdReal64*)pRangeData))
             {
                 ret = kErrorObdValueTooHigh;
             }
@@ -3300,4 +3405,56 @@ static tOplkError callStoreCallback(const tObdCbStoreParam* pCbStoreParam_p)
 }
 #endif // (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
 
+#if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Add data to OD signature
+
+The function adds data to the OD signature calculation. The data is collected
+in a buffer and the CRC is calculated when the buffer is full.
+
+\param[in,out]  pSignCalc_p         Pointer to the signature calculation.
+\param[in]      pData_p             Pointer to the data.
+\param[in]      size_p              Size of the data.
+*/
+//------------------------------------------------------------------------------
+static void addSignatureData(tObdSignatureCalc* pSignCalc_p,
+                             const void* pData_p,
+                             size_t size_p)
+{
+    if ((pSignCalc_p->size + size_p) > sizeof(pSignCalc_p->aData))
+    {
+        pSignCalc_p->crc = obdconf_calculateCrc16(pSignCalc_p->crc,
+                                                  pSignCalc_p->aData,
+                                                  pSignCalc_p->size);
+        pSignCalc_p->size = 0;
+    }
+
+    OPLK_MEMCPY(&pSignCalc_p->aData[pSignCalc_p->size], pData_p, size_p);
+    pSignCalc_p->size += size_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish OD signature
+
+The function calculates the CRC over the remaining collected data and returns
+the OD signature.
+
+\param[in,out]  pSignCalc_p         Pointer to the signature calculation.
+
+\return The function returns the OD signature.
+*/
+//------------------------------------------------------------------------------
+static UINT16 finishSignature(tObdSignatureCalc* pSignCalc_p)
+{
+    pSignCalc_p->crc = obdconf_calculateCrc16(pSignCalc_p->crc,
+                                              pSignCalc_p->aData,
+                                              pSignCalc_p->size);
+    pSignCalc_p->size = 0;
+
+    return pSignCalc_p->crc;
+}
+#endif
+
 /// \}
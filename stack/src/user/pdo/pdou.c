@@ -134,6 +134,41 @@ typedef struct
     UINT16                  byteSizeOrType;         ///< The size of the data in bytes
 } tPdoMappObject;
 
+/**
+\brief PDO copy step
+
+This structure specifies a single step of the precompiled copy program of a PDO
+channel. A step either copies a run of adjacent byte-aligned objects by a
+single bulk copy or converts a single object which needs the AMI (non-native
+types). On big endian targets a bulk copy step only contains objects of the
+same size which are converted by the AMI array functions.
+*/
+typedef struct
+{
+    void*                   pVar;                   ///< Pointer to PDO data of the first object of this step
+    UINT16                  payloadOffset;          ///< Offset of the data in the PDO buffer
+    UINT16                  size;                   ///< Size of the bulk copy in bytes; 0 for a conversion step
+    UINT8                   elementSize;            ///< Size of the values of a bulk copy step which need byte order conversion; 1 for a plain memcpy
+    const tPdoMappObject*   pMappObject;            ///< Mapping object of a conversion step
+} tPdoCopyStep;
+
+/**
+\brief Direct process image access
+
+This structure describes the direct (zero-copy) access to a process image. If
+the layout of the process image exactly matches the payload of a single PDO
+channel, the application can access the PDO buffer of this channel directly.
+*/
+typedef struct
+{
+    void*                   pImage;                     ///< Pointer to the process image
+    size_t                  imageSize;                  ///< Size of the process image
+    UINT                    channelId;                  ///< Channel ID of the PDO channel matching the process image
+    BOOL                    fAvailable;                 ///< Flag determines if the layout matches
+    BOOL                    fAcquired;                  ///< Flag determines if the application holds the PDO buffer
+    UINT8*                  pPdo;                       ///< Pointer to the acquired PDO buffer (NULL if invalidated by a reconfiguration)
+} tPdoDirectImage;
+
 /**
 \brief User PDO module instance
 
@@ -146,6 +181,13 @@ typedef struct
     tPdoChannelSetup        pdoChannels;                ///< PDO channel setup
     tPdoMappObject*         paRxObject;                 ///< Pointer to RX channel objects
     tPdoMappObject*         paTxObject;                 ///< Pointer to TX channel objects
+    tPdoCopyStep*           paRxCopyStep;               ///< Pointer to RX channel copy programs
+    tPdoCopyStep*           paTxCopyStep;               ///< Pointer to TX channel copy programs
+    UINT*                   paRxCopyStepCount;          ///< Number of copy steps of each RX channel
+    UINT*                   paTxCopyStepCount;          ///< Number of copy steps of each TX channel
+    BOOL                    fCopyProgramValid;          ///< Flag determines if the copy programs are valid
+    tPdoDirectImage         directRx;                   ///< Direct access to the RXPDO (output) process image
+    tPdoDirectImage         directTx;                   ///< Direct access to the TXPDO (input) process image
     BOOL                    fAllocated;                 ///< Flag determines if PDOs are allocated
     BOOL                    fRunning;                   ///< Flag determines if PDO engine is running
     BOOL                    fInitialized;               ///< Flag determines if PDO module is initialized
@@ -215,6 +257,13 @@ static tOplkError copyVarToPdo(BYTE* pPayload_p,
 static tOplkError copyVarFromPdo(const BYTE* pPayload_p,
                                  const tPdoMappObject* pMappObject_p,
                                  UINT16 offsetInFrame_p);
+static void setupAllCopyPrograms(void);
+static void setupCopyProgram(BOOL fTx_p, UINT channelId_p);
+static UINT getBulkCopySize(const tPdoMappObject* pMappObject_p,
+                            UINT8* pElementSize_p);
+static tOplkError runRxCopyProgram(const BYTE* pPdo_p, UINT channelId_p);
+static tOplkError runTxCopyProgram(BYTE* pPdo_p, UINT channelId_p);
+static void setupDirectImage(BOOL fTx_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -312,6 +361,11 @@ tOplkError pdou_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
                 target_lockMutex(pdouInstance_g.lockMutex);
                 pdouInstance_g.fAllocated = FALSE;
                 pdouInstance_g.fRunning = FALSE;
+                pdouInstance_g.fCopyProgramValid = FALSE;
+                pdouInstance_g.directRx.fAvailable = FALSE;
+                pdouInstance_g.directRx.pPdo = NULL;
+                pdouInstance_g.directTx.fAvailable = FALSE;
+                pdouInstance_g.directTx.pPdo = NULL;
                 target_unlockMutex(pdouInstance_g.lockMutex);
 
                 for (mapParamIndex = PDOU_OBD_IDX_RX_MAPP_PARAM;
@@ -352,6 +406,11 @@ tOplkError pdou_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
             target_lockMutex(pdouInstance_g.lockMutex);
             pdouInstance_g.fAllocated = FALSE;
             pdouInstance_g.fRunning = FALSE;
+            pdouInstance_g.fCopyProgramValid = FALSE;
+            pdouInstance_g.directRx.fAvailable = FALSE;
+            pdouInstance_g.directRx.pPdo = NULL;
+            pdouInstance_g.directTx.fAvailable = FALSE;
+            pdouInstance_g.directTx.pPdo = NULL;
             target_unlockMutex(pdouInstance_g.lockMutex);
 
             // forward PDO configuration to pdok module
@@ -362,6 +421,18 @@ tOplkError pdou_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
             pdouInstance_g.fRunning = TRUE;
             break;
 
+        case kNmtCsReadyToOperate:
+        case kNmtMsReadyToOperate:
+            // the mapping is complete, compile the copy programs of all channels
+            if (pdouInstance_g.fAllocated)
+            {
+                target_lockMutex(pdouInstance_g.lockMutex);
+                setupAllCopyPrograms();
+                pdouInstance_g.fCopyProgramValid = TRUE;
+                target_unlockMutex(pdouInstance_g.lockMutex);
+            }
+            break;
+
         default:
             // do nothing
             break;
@@ -505,6 +576,11 @@ tOplkError pdou_copyRxPdoToPi(void)
         if (pPdoChannel->nodeId == PDO_INVALID_NODE_ID)
             continue;
 
+        // The buffer of this channel is held by the application
+        if ((pdouInstance_g.directRx.pPdo != NULL) &&
+            (pdouInstance_g.directRx.channelId == channelId))
+            continue;
+
         ret = pdoucal_getRxPdo(&pPdo, channelId, pPdoChannel->nextChannelOffset - pPdoChannel->offset);
         if (ret != kErrorOk)
         {
@@ -519,6 +595,17 @@ tOplkError pdou_copyRxPdoToPi(void)
                             pPdoChannel->nodeId,
                             pPdo);
 
+        if (pdouInstance_g.fCopyProgramValid)
+        {
+            ret = runRxCopyProgram(pPdo, channelId);
+            if (ret != kErrorOk)
+            {   // other fatal error occurred
+                target_unlockMutex(pdouInstance_g.lockMutex);
+                return ret;
+            }
+            continue;
+        }
+
         for (mappObjectCount = pPdoChannel->mappObjectCount,
              pMappObject = pdouInstance_g.paRxObject + (channelId * D_PDO_RPDOChannelObjects_U8);
              mappObjectCount > 0;
@@ -580,6 +667,13 @@ tOplkError pdou_copyTxPdoFromPi(void)
             continue;
         }
 
+        // The buffer of this channel is held by the application
+        if ((pdouInstance_g.directTx.pPdo != NULL) &&
+            (pdouInstance_g.directTx.channelId == channelId))
+        {
+            continue;
+        }
+
         pPdo = pdoucal_getTxPdoAdrs(channelId);
 
         DEBUG_LVL_PDO_TRACE("%s() channelId:%d pPdo: %p\n",
@@ -587,18 +681,30 @@ tOplkError pdou_copyTxPdoFromPi(void)
                             channelId,
                             pPdo);
 
-        for (mappObjectCount = pPdoChannel->mappObjectCount,
-             pMappObject = pdouInstance_g.paTxObject + (channelId * D_PDO_TPDOChannelObjects_U8);
-             mappObjectCount > 0;
-             mappObjectCount--, pMappObject++)
+        if (pdouInstance_g.fCopyProgramValid)
         {
-            ret = copyVarToPdo(pPdo, pMappObject, pPdoChannel->offset);
+            ret = runTxCopyProgram(pPdo, channelId);
             if (ret != kErrorOk)
             {   // other fatal error occurred
                 target_unlockMutex(pdouInstance_g.lockMutex);
                 return ret;
             }
         }
+        else
+        {
+            for (mappObjectCount = pPdoChannel->mappObjectCount,
+                 pMappObject = pdouInstance_g.paTxObject + (channelId * D_PDO_TPDOChannelObjects_U8);
+                 mappObjectCount > 0;
+                 mappObjectCount--, pMappObject++)
+            {
+                ret = copyVarToPdo(pPdo, pMappObject, pPdoChannel->offset);
+                if (ret != kErrorOk)
+                {   // other fatal error occurred
+                    target_unlockMutex(pdouInstance_g.lockMutex);
+                    return ret;
+                }
+            }
+        }
 
         // send PDO data to kernel layer
         ret = pdoucal_setTxPdo(channelId,
@@ -611,6 +717,245 @@ tOplkError pdou_copyTxPdoFromPi(void)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set process image for direct access
+
+The function sets the process image which shall be checked for direct
+(zero-copy) access. Direct access is available if the process image exactly
+matches the payload of a single PDO channel, i.e. the copy program of the
+channel consists of a single bulk copy which covers the whole process image
+and no other channel maps into the process image. The layout is checked
+whenever the copy programs are compiled.
+
+\param[in]      fTx_p               TRUE for the TXPDO (input) process image,
+                                    FALSE for the RXPDO (output) process image.
+\param[in]      pImage_p            Pointer to the process image. NULL disables
+                                    direct access.
+\param[in]      imageSize_p         Size of the process image.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tOplkError pdou_setDirectProcessImage(BOOL fTx_p,
+                                      void* pImage_p,
+                                      size_t imageSize_p)
+{
+    tPdoDirectImage*    pDirect;
+
+    pDirect = (fTx_p) ? &pdouInstance_g.directTx : &pdouInstance_g.directRx;
+
+    if (target_lockMutex(pdouInstance_g.lockMutex) != kErrorOk)
+        return kErrorIllegalInstance;
+
+    pDirect->pImage = pImage_p;
+    pDirect->imageSize = imageSize_p;
+    pDirect->fAvailable = FALSE;
+    pDirect->pPdo = NULL;
+    if (pdouInstance_g.fCopyProgramValid)
+        setupDirectImage(fTx_p);
+
+    target_unlockMutex(pdouInstance_g.lockMutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Acquire RXPDO buffer for direct access
+
+The function acquires the current clean RXPDO buffer of the channel which
+matches the output process image. The buffer stays valid until
+pdou_releaseRxPdoBuffer() is called or the PDO mapping is reconfigured.
+Meanwhile pdou_copyRxPdoToPi() skips this channel. Each successful call must
+be followed by exactly one call of pdou_releaseRxPdoBuffer().
+
+\param[out]     ppPdo_p             Pointer to store the address of the PDO buffer.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The buffer is successfully acquired.
+\retval kErrorApiInvalidParam       The buffer is already acquired.
+\retval kErrorApiPILayoutMismatch   The process image doesn't match a PDO channel.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tOplkError pdou_acquireRxPdoBuffer(const void** ppPdo_p)
+{
+    tOplkError          ret = kErrorOk;
+    tPdoDirectImage*    pDirect = &pdouInstance_g.directRx;
+    const tPdoChannel*  pPdoChannel;
+
+    if (ppPdo_p == NULL)
+        return kErrorApiInvalidParam;
+
+    if (target_lockMutex(pdouInstance_g.lockMutex) != kErrorOk)
+        return kErrorIllegalInstance;
+
+    if (pDirect->fAcquired)
+    {
+        ret = kErrorApiInvalidParam;
+        goto Exit;
+    }
+
+    if (!pdouInstance_g.fRunning || !pDirect->fAvailable)
+    {
+        ret = kErrorApiPILayoutMismatch;
+        goto Exit;
+    }
+
+    pPdoChannel = &pdouInstance_g.pdoChannels.pRxPdoChannel[pDirect->channelId];
+    ret = pdoucal_getRxPdo(&pDirect->pPdo,
+                           pDirect->channelId,
+                           pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+    if (ret != kErrorOk)
+    {
+        pDirect->pPdo = NULL;
+        goto Exit;
+    }
+
+    pDirect->fAcquired = TRUE;
+    *ppPdo_p = pDirect->pPdo;
+
+Exit:
+    target_unlockMutex(pdouInstance_g.lockMutex);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release RXPDO buffer
+
+The function releases the RXPDO buffer acquired by pdou_acquireRxPdoBuffer().
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The buffer is successfully released.
+\retval kErrorApiInvalidParam       The buffer isn't acquired.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tOplkError pdou_releaseRxPdoBuffer(void)
+{
+    tOplkError          ret = kErrorOk;
+    tPdoDirectImage*    pDirect = &pdouInstance_g.directRx;
+
+    if (target_lockMutex(pdouInstance_g.lockMutex) != kErrorOk)
+        return kErrorIllegalInstance;
+
+    if (!pDirect->fAcquired)
+        ret = kErrorApiInvalidParam;
+
+    pDirect->fAcquired = FALSE;
+    pDirect->pPdo = NULL;
+
+    target_unlockMutex(pdouInstance_g.lockMutex);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Acquire TXPDO buffer for direct access
+
+The function acquires the current write buffer of the TXPDO channel which
+matches the input process image. The application has to write the whole
+process image into the buffer because it contains outdated data. The buffer
+is handed over to the kernel layer by pdou_releaseTxPdoBuffer(). Meanwhile
+pdou_copyTxPdoFromPi() skips this channel. If the PDO mapping is reconfigured
+before the release, the written data is discarded. Each successful call must
+be followed by exactly one call of pdou_releaseTxPdoBuffer().
+
+\param[out]     ppPdo_p             Pointer to store the address of the PDO buffer.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The buffer is successfully acquired.
+\retval kErrorApiInvalidParam       The buffer is already acquired.
+\retval kErrorApiPILayoutMismatch   The process image doesn't match a PDO channel.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tOplkError pdou_acquireTxPdoBuffer(void** ppPdo_p)
+{
+    tOplkError          ret = kErrorOk;
+    tPdoDirectImage*    pDirect = &pdouInstance_g.directTx;
+
+    if (ppPdo_p == NULL)
+        return kErrorApiInvalidParam;
+
+    if (target_lockMutex(pdouInstance_g.lockMutex) != kErrorOk)
+        return kErrorIllegalInstance;
+
+    if (pDirect->fAcquired)
+    {
+        ret = kErrorApiInvalidParam;
+        goto Exit;
+    }
+
+    if (!pdouInstance_g.fRunning || !pDirect->fAvailable)
+    {
+        ret = kErrorApiPILayoutMismatch;
+        goto Exit;
+    }
+
+    pDirect->pPdo = pdoucal_getTxPdoAdrs(pDirect->channelId);
+    pDirect->fAcquired = TRUE;
+    *ppPdo_p = pDirect->pPdo;
+
+Exit:
+    target_unlockMutex(pdouInstance_g.lockMutex);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release TXPDO buffer
+
+The function hands over the TXPDO buffer acquired by pdou_acquireTxPdoBuffer()
+to the kernel layer.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The buffer is successfully released.
+\retval kErrorApiInvalidParam       The buffer isn't acquired.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tOplkError pdou_releaseTxPdoBuffer(void)
+{
+    tOplkError          ret = kErrorOk;
+    tPdoDirectImage*    pDirect = &pdouInstance_g.directTx;
+    const tPdoChannel*  pPdoChannel;
+
+    if (target_lockMutex(pdouInstance_g.lockMutex) != kErrorOk)
+        return kErrorIllegalInstance;
+
+    if (!pDirect->fAcquired)
+    {
+        ret = kErrorApiInvalidParam;
+        goto Exit;
+    }
+
+    // The buffer is NULL if the PDO mapping was reconfigured meanwhile
+    if (pDirect->pPdo != NULL)
+    {
+        pPdoChannel = &pdouInstance_g.pdoChannels.pTxPdoChannel[pDirect->channelId];
+        ret = pdoucal_setTxPdo(pDirect->channelId,
+                               pDirect->pPdo,
+                               pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+    }
+
+    pDirect->fAcquired = FALSE;
+    pDirect->pPdo = NULL;
+
+Exit:
+    target_unlockMutex(pdouInstance_g.lockMutex);
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Register PDO change callback function
@@ -862,6 +1207,18 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
             pdouInstance_g.paRxObject = NULL;
         }
 
+        if (pdouInstance_g.paRxCopyStep != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paRxCopyStep);
+            pdouInstance_g.paRxCopyStep = NULL;
+        }
+
+        if (pdouInstance_g.paRxCopyStepCount != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paRxCopyStepCount);
+            pdouInstance_g.paRxCopyStepCount = NULL;
+        }
+
         if (pAllocationParam_p->rxPdoChannelCount > 0)
         {
             pdouInstance_g.pdoChannels.pRxPdoChannel =
@@ -883,6 +1240,24 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
                 ret = kErrorPdoInitError;
                 goto Exit;
             }
+
+            pdouInstance_g.paRxCopyStep =
+                    (tPdoCopyStep*)OPLK_MALLOC(sizeof(tPdoCopyStep)
+                               * pAllocationParam_p->rxPdoChannelCount
+                               * D_PDO_RPDOChannelObjects_U8);
+            if (pdouInstance_g.paRxCopyStep == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
+
+            pdouInstance_g.paRxCopyStepCount =
+                    (UINT*)OPLK_MALLOC(sizeof(UINT) * pAllocationParam_p->rxPdoChannelCount);
+            if (pdouInstance_g.paRxCopyStepCount == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
         }
     }
 
@@ -908,6 +1283,18 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
             pdouInstance_g.paTxObject = NULL;
         }
 
+        if (pdouInstance_g.paTxCopyStep != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paTxCopyStep);
+            pdouInstance_g.paTxCopyStep = NULL;
+        }
+
+        if (pdouInstance_g.paTxCopyStepCount != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paTxCopyStepCount);
+            pdouInstance_g.paTxCopyStepCount = NULL;
+        }
+
         if (pAllocationParam_p->txPdoChannelCount > 0)
         {
             pdouInstance_g.pdoChannels.pTxPdoChannel =
@@ -927,6 +1314,24 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
                 ret = kErrorPdoInitError;
                 goto Exit;
             }
+
+            pdouInstance_g.paTxCopyStep =
+                    (tPdoCopyStep*)OPLK_MALLOC(sizeof(tPdoCopyStep)
+                               * pAllocationParam_p->txPdoChannelCount
+                               * D_PDO_TPDOChannelObjects_U8);
+            if (pdouInstance_g.paTxCopyStep == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
+
+            pdouInstance_g.paTxCopyStepCount =
+                    (UINT*)OPLK_MALLOC(sizeof(UINT) * pAllocationParam_p->txPdoChannelCount);
+            if (pdouInstance_g.paTxCopyStepCount == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
         }
     }
 
@@ -966,6 +1371,18 @@ static tOplkError freePdoChannels(void)
         pdouInstance_g.paRxObject = NULL;
     }
 
+    if (pdouInstance_g.paRxCopyStep != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paRxCopyStep);
+        pdouInstance_g.paRxCopyStep = NULL;
+    }
+
+    if (pdouInstance_g.paRxCopyStepCount != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paRxCopyStepCount);
+        pdouInstance_g.paRxCopyStepCount = NULL;
+    }
+
     if (pdouInstance_g.pdoChannels.pTxPdoChannel != NULL)
     {
         OPLK_FREE(pdouInstance_g.pdoChannels.pTxPdoChannel);
@@ -978,6 +1395,18 @@ static tOplkError freePdoChannels(void)
         pdouInstance_g.paTxObject = NULL;
     }
 
+    if (pdouInstance_g.paTxCopyStep != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paTxCopyStep);
+        pdouInstance_g.paTxCopyStep = NULL;
+    }
+
+    if (pdouInstance_g.paTxCopyStepCount != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paTxCopyStepCount);
+        pdouInstance_g.paTxCopyStepCount = NULL;
+    }
+
     return ret;
 }
 
@@ -1282,6 +1711,14 @@ static tOplkError configurePdoChannel(const tPdoChannelConf* pChannelConf_p)
         // Setup user channel configuration
         OPLK_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof(tPdoChannel));
 
+        if (pdouInstance_g.fCopyProgramValid)
+        {   // mapping changed at runtime, recompile the copy program of this channel
+            target_lockMutex(pdouInstance_g.lockMutex);
+            setupCopyProgram(pChannelConf_p->fTx, pChannelConf_p->channelId);
+            setupDirectImage(pChannelConf_p->fTx);
+            target_unlockMutex(pdouInstance_g.lockMutex);
+        }
+
         DEBUG_LVL_PDO_TRACE("%s(): pdoucal_postConfigureChannel(): TX:%d channel:%d offset:%d\n",
                             __func__,
                             pChannelConf_p->fTx,
@@ -1947,11 +2384,399 @@ static tOplkError copyVarFromPdo(const BYTE* pPayload_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Setup copy programs of all PDO channels
+
+The function compiles the copy programs of all configured RX and TX PDO
+channels.
+*/
+//------------------------------------------------------------------------------
+static void setupAllCopyPrograms(void)
+{
+    UINT    channelId;
+
+    for (channelId = 0;
+         channelId < pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+         channelId++)
+    {
+        setupCopyProgram(FALSE, channelId);
+    }
+
+    for (channelId = 0;
+         channelId < pdouInstance_g.pdoChannels.allocation.txPdoChannelCount;
+         channelId++)
+    {
+        setupCopyProgram(TRUE, channelId);
+    }
+
+    setupDirectImage(FALSE);
+    setupDirectImage(TRUE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Setup copy program of a PDO channel
+
+The function compiles the mapping objects of the specified PDO channel into a
+flat copy program. Consecutive mapping objects which are adjacent in the PDO
+payload as well as in the process variables and which can be copied without
+conversion are merged into a single bulk copy step. All other objects get a
+conversion step of their own which uses the AMI.
+
+\param[in]      fTx_p               TRUE for TXPDO, FALSE for RXPDO channel.
+\param[in]      channelId_p         Channel ID of the PDO channel.
+*/
+//------------------------------------------------------------------------------
+static void setupCopyProgram(BOOL fTx_p, UINT channelId_p)
+{
+    const tPdoChannel*      pPdoChannel;
+    const tPdoMappObject*   pMappObject;
+    tPdoCopyStep*           pFirstStep;
+    tPdoCopyStep*           pStep = NULL;
+    UINT*                   pStepCount;
+    UINT                    mappObjectCount;
+    UINT                    payloadOffset;
+    UINT                    size;
+    UINT8                   elementSize;
+    UINT                    stepCount = 0;
+
+    if (fTx_p)
+    {
+        pPdoChannel = &pdouInstance_g.pdoChannels.pTxPdoChannel[channelId_p];
+        pMappObject = &pdouInstance_g.paTxObject[channelId_p * D_PDO_TPDOChannelObjects_U8];
+        pFirstStep = &pdouInstance_g.paTxCopyStep[channelId_p * D_PDO_TPDOChannelObjects_U8];
+        pStepCount = &pdouInstance_g.paTxCopyStepCount[channelId_p];
+    }
+    else
+    {
+        pPdoChannel = &pdouInstance_g.pdoChannels.pRxPdoChannel[channelId_p];
+        pMappObject = &pdouInstance_g.paRxObject[channelId_p * D_PDO_RPDOChannelObjects_U8];
+        pFirstStep = &pdouInstance_g.paRxCopyStep[channelId_p * D_PDO_RPDOChannelObjects_U8];
+        pStepCount = &pdouInstance_g.paRxCopyStepCount[channelId_p];
+    }
+
+    if (pPdoChannel->nodeId == PDO_INVALID_NODE_ID)
+    {
+        *pStepCount = 0;
+        return;
+    }
+
+    for (mappObjectCount = pPdoChannel->mappObjectCount;
+         mappObjectCount > 0;
+         mappObjectCount--, pMappObject++)
+    {
+        payloadOffset = (PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject) >> 3) - pPdoChannel->offset;
+        size = getBulkCopySize(pMappObject, &elementSize);
+
+        if ((size != 0) &&
+            (pStep != NULL) &&
+            (pStep->size != 0) &&
+            (pStep->elementSize == elementSize) &&
+            ((pStep->payloadOffset + pStep->size) == payloadOffset) &&
+            (((BYTE*)pStep->pVar + pStep->size) == (BYTE*)PDO_MAPPOBJECT_GET_VAR(pMappObject)) &&
+            ((pStep->size + size) <= USHRT_MAX))
+        {   // object directly follows the previous bulk copy step, merge it
+            pStep->size += (UINT16)size;
+            continue;
+        }
+
+        pStep = &pFirstStep[stepCount];
+        pStep->pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject);
+        pStep->payloadOffset = (UINT16)payloadOffset;
+        pStep->size = (UINT16)size;
+        pStep->elementSize = elementSize;
+        pStep->pMappObject = pMappObject;
+        stepCount++;
+    }
+
+    *pStepCount = stepCount;
+
+    DEBUG_LVL_PDO_TRACE("%s() TX:%d channel:%d objects:%d steps:%d\n",
+                        __func__,
+                        fTx_p,
+                        channelId_p,
+                        pPdoChannel->mappObjectCount,
+                        stepCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get bulk copy size of mapping object
+
+The function determines if the specified mapping object can be copied in bulk,
+i.e. its representation in the PDO payload is identical to the process variable
+or it is an array element of a native type which only needs a byte order
+conversion.
+
+\param[in]      pMappObject_p       Pointer to mapping object.
+\param[out]     pElementSize_p      Pointer to store the size of the values
+                                    which need byte order conversion (1 if the
+                                    object is copied by memcpy).
+
+\return The function returns the size of the object in bytes if it can be
+        copied in bulk, otherwise 0.
+*/
+//------------------------------------------------------------------------------
+static UINT getBulkCopySize(const tPdoMappObject* pMappObject_p,
+                            UINT8* pElementSize_p)
+{
+    *pElementSize_p = 1;
+
+    switch (PDO_MAPPOBJECT_GET_TYPE(pMappObject_p))
+    {
+        case kObdTypeBool:
+        case kObdTypeInt8:
+        case kObdTypeUInt8:
+            return 1;
+
+        // on little endian systems the native types are stored in PDO byte order
+        case kObdTypeInt16:
+        case kObdTypeUInt16:
+#if CHECK_IF_BIG_ENDIAN()
+            *pElementSize_p = 2;
+#endif
+            return 2;
+
+        case kObdTypeInt32:
+        case kObdTypeUInt32:
+        case kObdTypeReal32:
+#if CHECK_IF_BIG_ENDIAN()
+            *pElementSize_p = 4;
+#endif
+            return 4;
+
+        case kObdTypeInt64:
+        case kObdTypeUInt64:
+        case kObdTypeReal64:
+#if CHECK_IF_BIG_ENDIAN()
+            *pElementSize_p = 8;
+#endif
+            return 8;
+
+        default:
+            break;
+    }
+
+    if (pMappObject_p->byteSizeOrType >= PDO_COMMUNICATION_PROFILE_START)
+    {   // strings and domains store the byte size instead of the type
+        return PDO_MAPPOBJECT_GET_BYTESIZE(pMappObject_p);
+    }
+
+    // non-native types (24/40/48/56 bit, time of day) need conversion
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run RXPDO copy program
+
+The function executes the copy program of the specified RX PDO channel and
+copies the PDO data into the process variables.
+
+\param[in]      pPdo_p              Pointer to PDO buffer of the channel.
+\param[in]      channelId_p         Channel ID of the PDO channel.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runRxCopyProgram(const BYTE* pPdo_p, UINT channelId_p)
+{
+    tOplkError          ret = kErrorOk;
+    const tPdoCopyStep* pStep;
+    UINT                stepCount;
+    UINT16              channelOffset;
+
+    channelOffset = pdouInstance_g.pdoChannels.pRxPdoChannel[channelId_p].offset;
+
+    for (stepCount = pdouInstance_g.paRxCopyStepCount[channelId_p],
+         pStep = &pdouInstance_g.paRxCopyStep[channelId_p * D_PDO_RPDOChannelObjects_U8];
+         stepCount > 0;
+         stepCount--, pStep++)
+    {
+        if (pStep->size != 0)
+        {
+            switch (pStep->elementSize)
+            {
+                case 2:
+                    ami_getUint16ArrayLe(pPdo_p + pStep->payloadOffset, pStep->pVar, pStep->size >> 1);
+                    break;
+
+                case 4:
+                    ami_getUint32ArrayLe(pPdo_p + pStep->payloadOffset, pStep->pVar, pStep->size >> 2);
+                    break;
+
+                case 8:
+                    ami_getUint64ArrayLe(pPdo_p + pStep->payloadOffset, pStep->pVar, pStep->size >> 3);
+                    break;
+
+                default:
+                    OPLK_MEMCPY(pStep->pVar, pPdo_p + pStep->payloadOffset, pStep->size);
+                    break;
+            }
+        }
+        else
+        {
+            ret = copyVarFromPdo(pPdo_p, pStep->pMappObject, channelOffset);
+            if (ret != kErrorOk)
+                break;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run TXPDO copy program
+
+The function executes the copy program of the specified TX PDO channel and
+copies the process variables into the PDO buffer.
+
+\param[out]     pPdo_p              Pointer to PDO buffer of the channel.
+\param[in]      channelId_p         Channel ID of the PDO channel.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runTxCopyProgram(BYTE* pPdo_p, UINT channelId_p)
+{
+    tOplkError          ret = kErrorOk;
+    const tPdoCopyStep* pStep;
+    UINT                stepCount;
+    UINT16              channelOffset;
+
+    channelOffset = pdouInstance_g.pdoChannels.pTxPdoChannel[channelId_p].offset;
+
+    for (stepCount = pdouInstance_g.paTxCopyStepCount[channelId_p],
+         pStep = &pdouInstance_g.paTxCopyStep[channelId_p * D_PDO_TPDOChannelObjects_U8];
+         stepCount > 0;
+         stepCount--, pStep++)
+    {
+        if (pStep->size != 0)
+        {
+            switch (pStep->elementSize)
+            {
+                case 2:
+                    ami_setUint16ArrayLe(pPdo_p + pStep->payloadOffset, pStep->pVar, pStep->size >> 1);
+                    break;
+
+                case 4:
+                    ami_setUint32ArrayLe(pPdo_p + pStep->payloadOffset, pStep->pVar, pStep->size >> 2);
+                    break;
+
+                case 8:
+                    ami_setUint64ArrayLe(pPdo_p + pStep->payloadOffset, pStep->pVar, pStep->size >> 3);
+                    break;
+
+                default:
+                    OPLK_MEMCPY(pPdo_p + pStep->payloadOffset, pStep->pVar, pStep->size);
+                    break;
+            }
+        }
+        else
+        {
+            ret = copyVarToPdo(pPdo_p, pStep->pMappObject, channelOffset);
+            if (ret != kErrorOk)
+                break;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Setup direct process image access
+
+The function checks if the layout of the process image set by
+pdou_setDirectProcessImage() exactly matches the payload of a single PDO
+channel of the specified direction. The copy programs must be compiled before.
+
+\param[in]      fTx_p               TRUE for the TXPDO (input) process image,
+                                    FALSE for the RXPDO (output) process image.
+*/
+//------------------------------------------------------------------------------
+static void setupDirectImage(BOOL fTx_p)
+{
+    tPdoDirectImage*        pDirect;
+    const tPdoChannel*      pPdoChannel;
+    const tPdoCopyStep*     pStep;
+    const UINT*             pStepCount;
+    const UINT8*            pImage;
+    UINT                    channelCount;
+    UINT                    channelObjects;
+    UINT                    channelId;
+    UINT                    stepCount;
+    BOOL                    fFound = FALSE;
+
+    if (fTx_p)
+    {
+        pDirect = &pdouInstance_g.directTx;
+        pPdoChannel = pdouInstance_g.pdoChannels.pTxPdoChannel;
+        pStep = pdouInstance_g.paTxCopyStep;
+        pStepCount = pdouInstance_g.paTxCopyStepCount;
+        channelCount = pdouInstance_g.pdoChannels.allocation.txPdoChannelCount;
+        channelObjects = D_PDO_TPDOChannelObjects_U8;
+    }
+    else
+    {
+        pDirect = &pdouInstance_g.directRx;
+        pPdoChannel = pdouInstance_g.pdoChannels.pRxPdoChannel;
+        pStep = pdouInstance_g.paRxCopyStep;
+        pStepCount = pdouInstance_g.paRxCopyStepCount;
+        channelCount = pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+        channelObjects = D_PDO_RPDOChannelObjects_U8;
+    }
+
+    pDirect->fAvailable = FALSE;
+    pImage = (const UINT8*)pDirect->pImage;
+    if ((pImage == NULL) || (pDirect->imageSize == 0))
+        return;
+
+    for (channelId = 0; channelId < channelCount; channelId++, pPdoChannel++)
+    {
+        if (pPdoChannel->nodeId == PDO_INVALID_NODE_ID)
+            continue;
+
+        for (stepCount = 0; stepCount < pStepCount[channelId]; stepCount++)
+        {
+            const tPdoCopyStep* pCurStep = &pStep[(channelId * channelObjects) + stepCount];
+            const UINT8*        pVar = (const UINT8*)pCurStep->pVar;
+
+            if ((pVar < pImage) || (pVar >= (pImage + pDirect->imageSize)))
+                continue;   // step doesn't access the process image
+
+            if (fFound ||
+                (pStepCount[channelId] != 1) ||
+                (pVar != pImage) ||
+                (pCurStep->payloadOffset != 0) ||
+                (pCurStep->size != pDirect->imageSize) ||
+                (pCurStep->elementSize != 1))
+            {   // process image is not exactly covered by a single channel without conversion
+                return;
+            }
+
+            fFound = TRUE;
+            pDirect->channelId = channelId;
+        }
+    }
+
+    pDirect->fAvailable = fFound;
+
+    DEBUG_LVL_PDO_TRACE("%s() TX:%d direct access:%d channel:%d\n",
+                        __func__,
+                        fTx_p,
+                        fFound,
+                        pDirect->channelId);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Calculate PDO memory size
 
-The function calculates the size needed for the PDO memory.
+The function calculates the size needed for the PDO memory. The size of each
+channel is aligned with \ref PDO_CHANNEL_ALIGN.
 
 \param[in]      pPdoChannels_p      Pointer to PDO channel setup.
 \param[out]     pRxPdoMemSize_p     Pointer to store size of RX PDO buffers.
@@ -1974,7 +2799,7 @@ static size_t calcPdoMemSize(const tPdoChannelSetup* pPdoChannels_p,
          channelId < pPdoChannels_p->allocation.rxPdoChannelCount;
          channelId++, pPdoChannel++)
     {
-        rxSize += (pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+        rxSize += PDO_CHANNEL_ALIGN(pPdoChannel->nextChannelOffset - pPdoChannel->offset);
     }
     if (pRxPdoMemSize_p != NULL)
         *pRxPdoMemSize_p = rxSize;
@@ -1984,7 +2809,7 @@ static size_t calcPdoMemSize(const tPdoChannelSetup* pPdoChannels_p,
          channelId < pPdoChannels_p->allocation.txPdoChannelCount;
          channelId++, pPdoChannel++)
     {
-        txSize += (pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+        txSize += PDO_CHANNEL_ALIGN(pPdoChannel->nextChannelOffset - pPdoChannel->offset);
     }
     if (pTxPdoMemSize_p != NULL)
         *pTxPdoMemSize_p = txSize;
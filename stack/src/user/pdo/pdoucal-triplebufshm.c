@@ -124,7 +124,7 @@ tOplkError pdoucal_initPdoMem(const tPdoChannelSetup* pPdoChannels_p,
     if (pPdoMem_l != NULL)
         pdoucal_cleanupPdoMem();
 
-    memSize_l = (pdoMemSize * 3) + sizeof(tPdoMemRegion);
+    memSize_l = (pdoMemSize * 3) + PDO_CHANNEL_ALIGN(sizeof(tPdoMemRegion));
     if (memSize_l != 0)
     {
         if (pdoucal_allocateMem(memSize_l, &pMem) != kErrorOk)
@@ -136,7 +136,7 @@ tOplkError pdoucal_initPdoMem(const tPdoChannelSetup* pPdoChannels_p,
 
     pPdoMem_l = (tPdoMemRegion*)pMem;
 
-    pTripleBuf_l[0] = (UINT8*)pPdoMem_l + sizeof(tPdoMemRegion);
+    pTripleBuf_l[0] = (UINT8*)pPdoMem_l + PDO_CHANNEL_ALIGN(sizeof(tPdoMemRegion));
     pTripleBuf_l[1] = pTripleBuf_l[0] + pdoMemSize;
     pTripleBuf_l[2] = pTripleBuf_l[1] + pdoMemSize;
 
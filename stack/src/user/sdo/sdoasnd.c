@@ -54,10 +54,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 
-#ifndef CONFIG_SDO_MAX_CONNECTION_ASND
-#define CONFIG_SDO_MAX_CONNECTION_ASND     5
-#endif
-
 //------------------------------------------------------------------------------
 // module global vars
 //------------------------------------------------------------------------------
@@ -81,7 +77,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // instance table
 typedef struct
 {
-    UINT                aSdoAsndConnection[CONFIG_SDO_MAX_CONNECTION_ASND];
+    UINT*               paSdoAsndConnection;            ///< Target node ID of each connection (0 = free), allocated at init
+    UINT*               paFreeCon;                      ///< Stack of free connection indices, allocated at init
+    UINT                freeConCount;                   ///< Number of entries on the free connection stack
+    UINT16              aConIndex[C_ADR_BROADCAST];     ///< Connection index + 1 per node ID (0 = no connection)
     tSequLayerReceiveCb pfnSdoAsySeqCb;
 } tSdoAsndInstance;
 
@@ -95,6 +94,8 @@ static tSdoAsndInstance  sdoAsndInstance_l;
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p);
+static UINT       getConnection(UINT nodeId_p);
+static void       freeTables(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -116,6 +117,7 @@ The function initializes a first instance of the SDO over ASnd module.
 tOplkError sdoasnd_init(tSequLayerReceiveCb pfnReceiveCb_p)
 {
     tOplkError  ret;
+    UINT        count;
 
     OPLK_MEMSET(&sdoAsndInstance_l, 0x00, sizeof(sdoAsndInstance_l));
 
@@ -126,7 +128,25 @@ tOplkError sdoasnd_init(tSequLayerReceiveCb pfnReceiveCb_p)
         return kErrorSdoUdpMissCb; //TODO: Wrong error code?
     }
 
+    // allocate the connection table and its free stack
+    sdoAsndInstance_l.paSdoAsndConnection = (UINT*)OPLK_MALLOC(sizeof(UINT) * CONFIG_SDO_MAX_CONNECTION_ASND);
+    sdoAsndInstance_l.paFreeCon = (UINT*)OPLK_MALLOC(sizeof(UINT) * CONFIG_SDO_MAX_CONNECTION_ASND);
+    if ((sdoAsndInstance_l.paSdoAsndConnection == NULL) ||
+        (sdoAsndInstance_l.paFreeCon == NULL))
+    {
+        freeTables();
+        return kErrorNoResource;
+    }
+
+    OPLK_MEMSET(sdoAsndInstance_l.paSdoAsndConnection, 0x00, sizeof(UINT) * CONFIG_SDO_MAX_CONNECTION_ASND);
+
+    // push in reverse order, so the lowest index is handed out first
+    for (count = CONFIG_SDO_MAX_CONNECTION_ASND; count > 0; count--)
+        sdoAsndInstance_l.paFreeCon[sdoAsndInstance_l.freeConCount++] = count - 1;
+
     ret = dllucal_regAsndService(kDllAsndSdo, sdoAsndCb, kDllAsndFilterLocal);
+    if (ret != kErrorOk)
+        freeTables();
 
     return ret;
 }
@@ -148,6 +168,8 @@ tOplkError sdoasnd_exit(void)
 
     ret = dllucal_regAsndService(kDllAsndSdo, NULL, kDllAsndFilterNone);
 
+    freeTables();
+
     return ret;
 }
 
@@ -168,10 +190,7 @@ The function initializes a SDO over ASnd connection to a node.
 //------------------------------------------------------------------------------
 tOplkError sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
 {
-    tOplkError  ret = kErrorOk;
-    UINT        count;
-    UINT        freeCon;
-    UINT*       pConnection;
+    UINT    conIndex;
 
     // Check parameter validity
     ASSERT(pSdoConHandle_p != NULL);
@@ -180,41 +199,18 @@ tOplkError sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
         (targetNodeId_p >= C_ADR_BROADCAST))
         return kErrorSdoAsndInvalidNodeId;
 
-    // get free entry in control structure
-    count = 0;
-    freeCon = CONFIG_SDO_MAX_CONNECTION_ASND;
-    pConnection = &sdoAsndInstance_l.aSdoAsndConnection[0];
-    while (count < CONFIG_SDO_MAX_CONNECTION_ASND)
-    {
-        if (*pConnection == targetNodeId_p)
-        {   // existing connection to target node found
-            // save handle for higher layer
-            *pSdoConHandle_p = (tSdoConHdl)(count | SDO_ASND_HANDLE);
-            return ret;
-        }
-        else if (*pConnection == 0)
-        {   // free entry-> save target nodeId
-            freeCon = count;
-        }
-
-        count++;
-        pConnection++;
-    }
-
-    if (freeCon == CONFIG_SDO_MAX_CONNECTION_ASND)
+    // get existing connection to the target node or a free entry
+    conIndex = getConnection(targetNodeId_p);
+    if (conIndex == CONFIG_SDO_MAX_CONNECTION_ASND)
     {
         // no free connection
-        ret = kErrorSdoAsndNoFreeHandle;
-    }
-    else
-    {
-        pConnection = &sdoAsndInstance_l.aSdoAsndConnection[freeCon];
-        *pConnection = targetNodeId_p;
-        // save handle for higher layer
-        *pSdoConHandle_p = (tSdoConHdl)(freeCon | SDO_ASND_HANDLE);
+        return kErrorSdoAsndNoFreeHandle;
     }
 
-    return ret;
+    // save handle for higher layer
+    *pSdoConHandle_p = (tSdoConHdl)(conIndex | SDO_ASND_HANDLE);
+
+    return kErrorOk;
 }
 
 //------------------------------------------------------------------------------
@@ -242,13 +238,13 @@ tOplkError sdoasnd_sendData(tSdoConHdl sdoConHandle_p,
 
     array = ((UINT)sdoConHandle_p & ~SDO_ASY_HANDLE_MASK);
 
-    if (array > CONFIG_SDO_MAX_CONNECTION_ASND)
+    if (array >= CONFIG_SDO_MAX_CONNECTION_ASND)
         return kErrorSdoAsndInvalidHandle;
 
     // fill Asnd header
     // own node id not needed -> filled by DLL
     ami_setUint8Le(&pSrcData_p->messageType, (UINT8)kMsgTypeAsnd);      // ASnd == 0x06
-    ami_setUint8Le(&pSrcData_p->dstNodeId, (UINT8)sdoAsndInstance_l.aSdoAsndConnection[array]);
+    ami_setUint8Le(&pSrcData_p->dstNodeId, (UINT8)sdoAsndInstance_l.paSdoAsndConnection[array]);
     ami_setUint8Le(&pSrcData_p->srcNodeId, 0x00);                       // set source-nodeid (filled by DLL 0)
     // calc size (add Ethernet and ASnd header size)
     dataSize_p += (size_t)((UINT8*)&pSrcData_p->data.asnd.payload.sdoSequenceFrame - (UINT8*)pSrcData_p);
@@ -279,13 +275,20 @@ tOplkError sdoasnd_deleteCon(tSdoConHdl sdoConHandle_p)
 {
     tOplkError  ret = kErrorOk;
     UINT        array;
+    UINT        nodeId;
 
     array = ((UINT)sdoConHandle_p & ~SDO_ASY_HANDLE_MASK);
-    if (array > CONFIG_SDO_MAX_CONNECTION_ASND)
+    if (array >= CONFIG_SDO_MAX_CONNECTION_ASND)
         return kErrorSdoAsndInvalidHandle;
 
-    // set target nodeId to 0
-    sdoAsndInstance_l.aSdoAsndConnection[array] = 0;
+    nodeId = sdoAsndInstance_l.paSdoAsndConnection[array];
+    if (nodeId == 0)
+        return ret;     // connection already deleted
+
+    // set target nodeId to 0 and return the entry to the free stack
+    sdoAsndInstance_l.paSdoAsndConnection[array] = 0;
+    sdoAsndInstance_l.aConIndex[nodeId] = 0;
+    sdoAsndInstance_l.paFreeCon[sdoAsndInstance_l.freeConCount++] = array;
 
     return ret;
 }
@@ -310,48 +313,29 @@ receiving ASnd frames.
 static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT            count;
-    UINT*           pConnection;
+    UINT            conIndex;
     UINT            nodeId;
-    UINT            freeEntry = 0xFFFF;
     tSdoConHdl      sdoConHdl;
     tPlkFrame*      pFrame;
 
     pFrame = pFrameInfo_p->frame.pBuffer;
     nodeId = ami_getUint8Le(&pFrame->srcNodeId);
 
-    // search corresponding entry in control structure
-    count = 0;
-    pConnection = &sdoAsndInstance_l.aSdoAsndConnection[0];
-    while (count < CONFIG_SDO_MAX_CONNECTION_ASND)
+    if ((nodeId == C_ADR_INVALID) || (nodeId >= C_ADR_BROADCAST))
     {
-        if (nodeId == *pConnection)
-            break;
-        else if ((*pConnection == 0) && (freeEntry == 0xFFFF))
-        {   // free entry
-            freeEntry = count;
-        }
-
-        count++;
-        pConnection++;
+        DEBUG_LVL_SDO_TRACE("%s(): invalid source node ID %u\n", __func__, nodeId);
+        return ret;
     }
 
-    if (count == CONFIG_SDO_MAX_CONNECTION_ASND)
+    // get corresponding entry in control structure or create a new one
+    conIndex = getConnection(nodeId);
+    if (conIndex == CONFIG_SDO_MAX_CONNECTION_ASND)
     {
-        if (freeEntry != 0xFFFF)
-        {
-            pConnection = &sdoAsndInstance_l.aSdoAsndConnection[freeEntry];
-            *pConnection = nodeId;
-            count = freeEntry;
-        }
-        else
-        {
-            DEBUG_LVL_SDO_TRACE("%s(): no free handle\n", __func__);
-            return ret;
-        }
+        DEBUG_LVL_SDO_TRACE("%s(): no free handle\n", __func__);
+        return ret;
     }
 
-    sdoConHdl = (tSdoConHdl)(count | SDO_ASND_HANDLE);
+    sdoConHdl = (tSdoConHdl)(conIndex | SDO_ASND_HANDLE);
     sdoAsndInstance_l.pfnSdoAsySeqCb(sdoConHdl,
                                      &pFrame->data.asnd.payload.sdoSequenceFrame,
                                      (pFrameInfo_p->frameSize - 18));
@@ -359,6 +343,61 @@ static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get connection of a node
+
+The function looks up the connection to the specified node in the node ID
+index. If no connection exists, a free entry is taken from the free connection
+stack and assigned to the node.
+
+\param[in]      nodeId_p            Node ID of the remote node (1 - 254).
+
+\return The function returns the connection index or
+        CONFIG_SDO_MAX_CONNECTION_ASND if no connection is available.
+*/
+//------------------------------------------------------------------------------
+static UINT getConnection(UINT nodeId_p)
+{
+    UINT    conIndex;
+
+    if (sdoAsndInstance_l.aConIndex[nodeId_p] != 0)
+        return sdoAsndInstance_l.aConIndex[nodeId_p] - 1;
+
+    if (sdoAsndInstance_l.freeConCount == 0)
+        return CONFIG_SDO_MAX_CONNECTION_ASND;
+
+    conIndex = sdoAsndInstance_l.paFreeCon[--sdoAsndInstance_l.freeConCount];
+    sdoAsndInstance_l.paSdoAsndConnection[conIndex] = nodeId_p;
+    sdoAsndInstance_l.aConIndex[nodeId_p] = (UINT16)(conIndex + 1);
+
+    return conIndex;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free connection tables
+
+The function frees the connection table and the free connection stack.
+*/
+//------------------------------------------------------------------------------
+static void freeTables(void)
+{
+    if (sdoAsndInstance_l.paSdoAsndConnection != NULL)
+    {
+        OPLK_FREE(sdoAsndInstance_l.paSdoAsndConnection);
+        sdoAsndInstance_l.paSdoAsndConnection = NULL;
+    }
+
+    if (sdoAsndInstance_l.paFreeCon != NULL)
+    {
+        OPLK_FREE(sdoAsndInstance_l.paFreeCon);
+        sdoAsndInstance_l.paFreeCon = NULL;
+    }
+
+    sdoAsndInstance_l.freeConCount = 0;
+}
+
 /// \}
 
 #endif
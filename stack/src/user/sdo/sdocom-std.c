@@ -82,6 +82,8 @@ static tOplkError sdoExit(void);
 static tOplkError processStateIdle(tSdoComConHdl sdoComConHdl_p,
                                    tSdoComConEvent sdoComConEvent_p,
                                    const tAsySdoCom* pRecvdCmdLayer_p);
+static void       unlinkCon(tSdoComConHdl sdoComConHdl_p);
+static void       freeConTables(void);
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
@@ -409,30 +411,33 @@ tOplkError sdocomint_processCmdLayerConnection(tSdoSeqConHdl sdoSeqConHdl_p,
                                                const tAsySdoCom* pSdoCom_p)
 {
     tOplkError      ret = kErrorSdoComNotResponsible;
-    tSdoComCon*     pSdoComCon;
-    tSdoComConHdl   hdlCount;
-    tSdoComConHdl   hdlFree;
-
-    // get pointer to first element of the array
-    pSdoComCon = &sdoComInstance_g.sdoComCon[0];
-    hdlCount = 0;
-    hdlFree = 0xFFFF;
-    while (hdlCount < CONFIG_SDO_MAX_CONNECTION_COM)
+    tSdoComConHdl   hdl;
+    tSdoComConHdl   nextHdl;
+    UINT            seqConIndex;
+
+    // walk the chain of command layer connections which use this sequence
+    // layer connection, links of connections which have been closed or
+    // invalidated in the meantime are skipped
+    seqConIndex = (UINT)(sdoSeqConHdl_p & ~SDO_SEQ_HANDLE_MASK);
+    if (seqConIndex < CONFIG_SDO_MAX_CONNECTION_SEQ)
     {
-        if (pSdoComCon->sdoSeqConHdl == sdoSeqConHdl_p)
-        {   // matching command layer handle found
-            ret = sdocomint_processState(hdlCount, sdoComConEvent_p, pSdoCom_p);
-        }
-        else if ((pSdoComCon->sdoSeqConHdl == 0) && (hdlFree == 0xFFFF))
-            hdlFree = hdlCount;
+        hdl = sdoComInstance_g.paFirstConBySeq[seqConIndex];
+        while (hdl != (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM)
+        {
+            nextHdl = sdoComInstance_g.paConLink[hdl].nextCon;
+            if (sdoComInstance_g.paSdoComCon[hdl].sdoSeqConHdl == sdoSeqConHdl_p)
+            {   // matching command layer handle found
+                ret = sdocomint_processState(hdl, sdoComConEvent_p, pSdoCom_p);
+            }
 
-        pSdoComCon++;
-        hdlCount++;
+            hdl = nextHdl;
+        }
     }
 
     if (ret == kErrorSdoComNotResponsible)
     {   // no responsible command layer handle found
-        if (hdlFree == 0xFFFF)
+        hdl = sdocomint_allocCon();
+        if (hdl == (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM)
         {   // no free handle delete connection immediately
             // 2008/04/14 m.u./d.k. This connection actually does not exist.
             //                      pSdoComCon is invalid.
@@ -441,16 +446,107 @@ tOplkError sdocomint_processCmdLayerConnection(tSdoSeqConHdl sdoSeqConHdl_p,
         }
         else
         {   // create new handle
-            hdlCount = hdlFree;
-            pSdoComCon = &sdoComInstance_g.sdoComCon[hdlCount];
-            pSdoComCon->sdoSeqConHdl = sdoSeqConHdl_p;
-            ret = sdocomint_processState(hdlCount, sdoComConEvent_p, pSdoCom_p);
+            sdoComInstance_g.paSdoComCon[hdl].sdoSeqConHdl = sdoSeqConHdl_p;
+            sdocomint_updateSeqConLink(hdl);
+            ret = sdocomint_processState(hdl, sdoComConEvent_p, pSdoCom_p);
         }
     }
 
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate a command layer connection
+
+The function takes a free command layer connection from the free connection
+stack. The connection is released with \ref sdocomint_freeCon.
+
+\return The function returns the handle of the allocated connection or
+        CONFIG_SDO_MAX_CONNECTION_COM if no free connection is available.
+*/
+//------------------------------------------------------------------------------
+tSdoComConHdl sdocomint_allocCon(void)
+{
+    tSdoComConHdl   hdl;
+
+    if (sdoComInstance_g.freeConCount == 0)
+        return (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM;
+
+    hdl = sdoComInstance_g.paFreeCon[--sdoComInstance_g.freeConCount];
+    sdoComInstance_g.paConLink[hdl].fInUse = TRUE;
+
+    return hdl;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a command layer connection
+
+The function cleans up the control structure of a command layer connection,
+removes it from its sequence layer connection chain and returns it to the free
+connection stack. Freeing a connection which isn't allocated only cleans up the
+control structure.
+
+\param[in,out]  pSdoComCon_p        Pointer to command layer connection structure.
+*/
+//------------------------------------------------------------------------------
+void sdocomint_freeCon(tSdoComCon* pSdoComCon_p)
+{
+    tSdoComConHdl   hdl;
+
+    hdl = (tSdoComConHdl)(pSdoComCon_p - sdoComInstance_g.paSdoComCon);
+
+    OPLK_MEMSET(pSdoComCon_p, 0x00, sizeof(tSdoComCon));
+    unlinkCon(hdl);
+
+    if (sdoComInstance_g.paConLink[hdl].fInUse)
+    {
+        sdoComInstance_g.paConLink[hdl].fInUse = FALSE;
+        sdoComInstance_g.paFreeCon[sdoComInstance_g.freeConCount++] = hdl;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update the sequence layer connection link of a command layer connection
+
+The function links a command layer connection into the chain of its current
+sequence layer connection handle. It must be called whenever a valid sequence
+layer connection handle is assigned to the connection. The chain is ordered by
+the command layer connection handle.
+
+\param[in]      sdoComConHdl_p      Handle of the command layer connection.
+*/
+//------------------------------------------------------------------------------
+void sdocomint_updateSeqConLink(tSdoComConHdl sdoComConHdl_p)
+{
+    tSdoComConLink* pLink = &sdoComInstance_g.paConLink[sdoComConHdl_p];
+    tSdoComConHdl*  pHdl;
+    tSdoSeqConHdl   sdoSeqConHdl;
+    UINT            seqConIndex;
+
+    sdoSeqConHdl = sdoComInstance_g.paSdoComCon[sdoComConHdl_p].sdoSeqConHdl;
+    seqConIndex = (UINT)(sdoSeqConHdl & ~SDO_SEQ_HANDLE_MASK);
+    if ((sdoSeqConHdl == 0) || (seqConIndex >= CONFIG_SDO_MAX_CONNECTION_SEQ))
+        seqConIndex = CONFIG_SDO_MAX_CONNECTION_SEQ;
+
+    if (pLink->seqConIndex == seqConIndex)
+        return;     // already linked to this chain
+
+    unlinkCon(sdoComConHdl_p);
+    if (seqConIndex == CONFIG_SDO_MAX_CONNECTION_SEQ)
+        return;
+
+    pHdl = &sdoComInstance_g.paFirstConBySeq[seqConIndex];
+    while ((*pHdl != (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM) && (*pHdl < sdoComConHdl_p))
+        pHdl = &sdoComInstance_g.paConLink[*pHdl].nextCon;
+
+    pLink->nextCon = *pHdl;
+    pLink->seqConIndex = seqConIndex;
+    *pHdl = sdoComConHdl_p;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Process SDO command layer state machine
@@ -478,7 +574,7 @@ tOplkError sdocomint_processState(tSdoComConHdl sdoComConHdl_p,
 #endif
 
     // get pointer to control structure
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     // process state machine
     switch (pSdoComCon->sdoComState)
@@ -545,10 +641,39 @@ The function initializes the command layer module.
 static tOplkError sdoInit(tComdLayerObdCb pfnObdWrite_p,
                           tComdLayerObdCb pfnObdRead_p)
 {
-    tOplkError ret = kErrorOk;
+    tOplkError  ret = kErrorOk;
+    UINT        count;
 
     OPLK_MEMSET(&sdoComInstance_g, 0x00, sizeof(sdoComInstance_g));
 
+    // allocate the connection tables
+    sdoComInstance_g.paSdoComCon = (tSdoComCon*)OPLK_MALLOC(sizeof(tSdoComCon) * CONFIG_SDO_MAX_CONNECTION_COM);
+    sdoComInstance_g.paConLink = (tSdoComConLink*)OPLK_MALLOC(sizeof(tSdoComConLink) * CONFIG_SDO_MAX_CONNECTION_COM);
+    sdoComInstance_g.paFreeCon = (tSdoComConHdl*)OPLK_MALLOC(sizeof(tSdoComConHdl) * CONFIG_SDO_MAX_CONNECTION_COM);
+    sdoComInstance_g.paFirstConBySeq = (tSdoComConHdl*)OPLK_MALLOC(sizeof(tSdoComConHdl) * CONFIG_SDO_MAX_CONNECTION_SEQ);
+    if ((sdoComInstance_g.paSdoComCon == NULL) ||
+        (sdoComInstance_g.paConLink == NULL) ||
+        (sdoComInstance_g.paFreeCon == NULL) ||
+        (sdoComInstance_g.paFirstConBySeq == NULL))
+    {
+        freeConTables();
+        return kErrorNoResource;
+    }
+
+    OPLK_MEMSET(sdoComInstance_g.paSdoComCon, 0x00, sizeof(tSdoComCon) * CONFIG_SDO_MAX_CONNECTION_COM);
+
+    // push in reverse order, so the lowest handle is handed out first
+    for (count = CONFIG_SDO_MAX_CONNECTION_COM; count > 0; count--)
+    {
+        sdoComInstance_g.paConLink[count - 1].nextCon = (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM;
+        sdoComInstance_g.paConLink[count - 1].seqConIndex = CONFIG_SDO_MAX_CONNECTION_SEQ;
+        sdoComInstance_g.paConLink[count - 1].fInUse = FALSE;
+        sdoComInstance_g.paFreeCon[sdoComInstance_g.freeConCount++] = (tSdoComConHdl)(count - 1);
+    }
+
+    for (count = 0; count < CONFIG_SDO_MAX_CONNECTION_SEQ; count++)
+        sdoComInstance_g.paFirstConBySeq[count] = (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM;
+
 #if defined(CONFIG_INCLUDE_SDOS)
     if ((pfnObdWrite_p != NULL) && (pfnObdRead_p != NULL))
     {
@@ -556,7 +681,10 @@ static tOplkError sdoInit(tComdLayerObdCb pfnObdWrite_p,
         sdoComInstance_g.pfnProcessObdRead = pfnObdRead_p;
     }
     else
+    {
+        freeConTables();
         return kErrorSdoComInvalidParam;
+    }
 #else
     UNUSED_PARAMETER(pfnObdWrite_p);
     UNUSED_PARAMETER(pfnObdRead_p);
@@ -564,7 +692,10 @@ static tOplkError sdoInit(tComdLayerObdCb pfnObdWrite_p,
 
     ret = sdoseq_init(sdocomint_receiveCb, sdocomint_conStateChangeCb);
     if (ret != kErrorOk)
+    {
+        freeConTables();
         return ret;
+    }
 
 #if (defined(WIN32) || defined(_WIN32))
     sdoComInstance_g.pCriticalSection = &sdoComInstance_g.criticalSection;
@@ -593,6 +724,8 @@ static tOplkError sdoExit(void)
 
     ret = sdoseq_exit();
 
+    freeConTables();
+
     return ret;
 }
 
@@ -621,7 +754,7 @@ static tOplkError processStateIdle(tSdoComConHdl sdoComConHdl_p,
     tOplkError  ret = kErrorOk;
     tSdoComCon* pSdoComCon;
 
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     switch (sdoComConEvent_p)
     {
@@ -644,7 +777,7 @@ static tOplkError processStateIdle(tSdoComConHdl sdoComConHdl_p,
         case kSdoComConEventTimeout:
         case kSdoComConEventConClosed:
             ret = sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);
-            OPLK_MEMSET(pSdoComCon, 0x00, sizeof(tSdoComCon));
+            sdocomint_freeCon(pSdoComCon);
             break;
 
         default:
@@ -654,4 +787,74 @@ static tOplkError processStateIdle(tSdoComConHdl sdoComConHdl_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Unlink a command layer connection
+
+The function removes a command layer connection from the chain of its sequence
+layer connection.
+
+\param[in]      sdoComConHdl_p      Handle of the command layer connection.
+*/
+//------------------------------------------------------------------------------
+static void unlinkCon(tSdoComConHdl sdoComConHdl_p)
+{
+    tSdoComConLink* pLink = &sdoComInstance_g.paConLink[sdoComConHdl_p];
+    tSdoComConHdl*  pHdl;
+
+    if (pLink->seqConIndex == CONFIG_SDO_MAX_CONNECTION_SEQ)
+        return;     // not linked
+
+    pHdl = &sdoComInstance_g.paFirstConBySeq[pLink->seqConIndex];
+    while (*pHdl != (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM)
+    {
+        if (*pHdl == sdoComConHdl_p)
+        {
+            *pHdl = pLink->nextCon;
+            break;
+        }
+
+        pHdl = &sdoComInstance_g.paConLink[*pHdl].nextCon;
+    }
+
+    pLink->nextCon = (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM;
+    pLink->seqConIndex = CONFIG_SDO_MAX_CONNECTION_SEQ;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free connection tables
+
+The function frees the command layer connection tables.
+*/
+//------------------------------------------------------------------------------
+static void freeConTables(void)
+{
+    if (sdoComInstance_g.paSdoComCon != NULL)
+    {
+        OPLK_FREE(sdoComInstance_g.paSdoComCon);
+        sdoComInstance_g.paSdoComCon = NULL;
+    }
+
+    if (sdoComInstance_g.paConLink != NULL)
+    {
+        OPLK_FREE(sdoComInstance_g.paConLink);
+        sdoComInstance_g.paConLink = NULL;
+    }
+
+    if (sdoComInstance_g.paFreeCon != NULL)
+    {
+        OPLK_FREE(sdoComInstance_g.paFreeCon);
+        sdoComInstance_g.paFreeCon = NULL;
+    }
+
+    if (sdoComInstance_g.paFirstConBySeq != NULL)
+    {
+        OPLK_FREE(sdoComInstance_g.paFirstConBySeq);
+        sdoComInstance_g.paFirstConBySeq = NULL;
+    }
+
+    sdoComInstance_g.freeConCount = 0;
+}
+
 /// \}
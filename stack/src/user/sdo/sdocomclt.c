@@ -139,20 +139,16 @@ tOplkError sdocomclt_defineConnection(tSdoComConHdl* pSdoComConHdl_p,
     if ((targetNodeId_p == C_ADR_INVALID) || (targetNodeId_p >= C_ADR_BROADCAST))
         return kErrorInvalidNodeId;
 
-    // search free control structure
-    pSdoComCon = &sdoComInstance_g.sdoComCon[0];
+    // search existing client connection with same node ID and same protocol type
+    // (done once per connection setup, so the linear search is acceptable here)
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[0];
     count = 0;
-    freeHdl = (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM;
     while (count < CONFIG_SDO_MAX_CONNECTION_COM)
     {
-        if (pSdoComCon->sdoSeqConHdl == 0)
+        if ((pSdoComCon->sdoSeqConHdl != 0) &&
+            (pSdoComCon->nodeId == targetNodeId_p) &&
+            (pSdoComCon->sdoProtocolType == protType_p))
         {
-            // free entry
-            freeHdl = (tSdoComConHdl)count;
-        }
-        else if ((pSdoComCon->nodeId == targetNodeId_p) && (pSdoComCon->sdoProtocolType == protType_p))
-        {
-            // existing client connection with same node ID and same protocol type
             *pSdoComConHdl_p = (tSdoComConHdl)count;
             return kErrorSdoComHandleExists;
         }
@@ -161,12 +157,14 @@ tOplkError sdocomclt_defineConnection(tSdoComConHdl* pSdoComConHdl_p,
         pSdoComCon++;
     }
 
+    // get free control structure
+    freeHdl = sdocomint_allocCon();
     if (freeHdl == (tSdoComConHdl)CONFIG_SDO_MAX_CONNECTION_COM)
         return kErrorSdoComNoFreeHandle;
 
     *pSdoComConHdl_p = freeHdl;                 // save handle for application
 
-    pSdoComCon = &sdoComInstance_g.sdoComCon[freeHdl];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[freeHdl];
     pSdoComCon->sdoProtocolType = protType_p;
     pSdoComCon->nodeId = targetNodeId_p;
     pSdoComCon->transactionId = 0;
@@ -174,22 +172,26 @@ tOplkError sdocomclt_defineConnection(tSdoComConHdl* pSdoComConHdl_p,
     switch (protType_p)
     {
         case kSdoTypeUdp:
-            ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeUdp);
-            if (ret != kErrorOk)
-                return ret;
-            break;
-
         case kSdoTypeAsnd:
-            ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeAsnd);
-            if (ret != kErrorOk)
-                return ret;
+            ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, protType_p);
             break;
 
         case kSdoTypePdo:       // SDO over PDO -> not supported
         default:
-            return kErrorSdoComUnsupportedProt;
+            ret = kErrorSdoComUnsupportedProt;
+            break;
+    }
+
+    if (pSdoComCon->sdoSeqConHdl == 0)
+    {   // no sequence layer connection -> release control structure
+        sdocomint_freeCon(pSdoComCon);
+        return ret;
     }
 
+    sdocomint_updateSeqConLink(freeHdl);
+    if (ret != kErrorOk)
+        return ret;
+
     ret = sdocomint_processState(freeHdl, kSdoComConEventInitCon, NULL);
     return ret;
 }
@@ -219,7 +221,7 @@ tOplkError sdocomclt_initTransferByIndex(const tSdoComTransParamByIndex* pSdoCom
         return kErrorSdoComInvalidHandle;
 
     // get pointer to control structure of connection
-    pSdoComCon = &sdoComInstance_g.sdoComCon[pSdoComTransParam_p->sdoComConHdl];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[pSdoComTransParam_p->sdoComConHdl];
 
     if (pSdoComCon->sdoSeqConHdl == 0)
         return kErrorSdoComInvalidHandle;
@@ -324,7 +326,7 @@ tOplkError sdocomclt_undefineConnection(tSdoComConHdl sdoComConHdl_p)
         return kErrorSdoComInvalidHandle;
 
     // get pointer to control structure
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     // $$$ d.k. abort a running transfer before closing the sequence layer
     if (((pSdoComCon->sdoSeqConHdl & ~SDO_SEQ_HANDLE_MASK) != SDO_SEQ_INVALID_HDL) &&
@@ -345,7 +347,7 @@ tOplkError sdocomclt_undefineConnection(tSdoComConHdl sdoComConHdl_p)
         }
     }
 
-    OPLK_MEMSET(pSdoComCon, 0x00, sizeof(tSdoComCon));
+    sdocomint_freeCon(pSdoComCon);
 
     return ret;
 }
@@ -372,7 +374,7 @@ tOplkError sdocomclt_getState(tSdoComConHdl sdoComConHdl_p,
         return kErrorSdoComInvalidHandle;
 
     // get pointer to control structure
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     // check if handle ok
     if (pSdoComCon->sdoSeqConHdl == 0)
@@ -438,7 +440,7 @@ UINT sdocomclt_getNodeId(tSdoComConHdl sdoComConHdl_p)
         return nodeId;
 
     // get pointer to control structure
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     if (pSdoComCon->sdoSeqConHdl == 0)
         return nodeId;
@@ -468,7 +470,7 @@ tOplkError sdocomclt_abortTransfer(tSdoComConHdl sdoComConHdl_p, UINT32 abortCod
         return kErrorSdoComInvalidHandle;
 
     // get pointer to control structure of connection
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     if (pSdoComCon->sdoSeqConHdl == 0)
         return kErrorSdoComInvalidHandle;
@@ -505,7 +507,7 @@ tOplkError sdocomclt_processStateWaitInit(tSdoComConHdl sdoComConHdl_p,
 
     UNUSED_PARAMETER(pRecvdCmdLayer_p);
 
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     // if connection handle is invalid reinit connection
     // d.k.: this will be done only on new events (i.e. InitTransfer)
@@ -516,12 +518,14 @@ tOplkError sdocomclt_processStateWaitInit(tSdoComConHdl sdoComConHdl_p,
         {
             case kSdoTypeUdp:
                 ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeUdp);
+                sdocomint_updateSeqConLink(sdoComConHdl_p);
                 if (ret != kErrorOk)
                     return ret;
                 break;
 
             case kSdoTypeAsnd:
                 ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeAsnd);
+                sdocomint_updateSeqConLink(sdoComConHdl_p);
                 if (ret != kErrorOk)
                     return ret;
                 break;
@@ -614,7 +618,7 @@ tOplkError sdocomclt_processStateConnected(tSdoComConHdl sdoComConHdl_p,
     UINT8       flag;
     tSdoComCon* pSdoComCon;
 
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     switch (sdoComConEvent_p)
     {
@@ -744,7 +748,7 @@ tOplkError sdocomclt_processStateSegmTransfer(tSdoComConHdl sdoComConHdl_p,
     UINT8       flag;
     tSdoComCon* pSdoComCon;
 
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     switch (sdoComConEvent_p)
     {
@@ -1094,7 +1098,7 @@ static tOplkError processFrame(tSdoComConHdl sdoComConHdl_p,
     UINT                        multWriteRespCnt = 0;
 
     // get pointer to control structure
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     transactionId = ami_getUint8Le(&pSdoCom_p->transactionId);
     if (pSdoComCon->transactionId != transactionId)
@@ -1157,10 +1161,11 @@ static tOplkError processFrame(tSdoComConHdl sdoComConHdl_p,
                                     pMultWriteResp++;
                                 }
 
+                                // the transfer is finished by the caller after the
+                                // transaction ID has been incremented
                                 pSdoComCon->targetIndex = 0;
                                 pSdoComCon->targetSubIndex = 0;
                                 pSdoComCon->lastAbortCode = 0;
-                                ret = transferFinished(sdoComConHdl_p, pSdoComCon, kSdoComTransferFinished);
                             }
                             break;
 
@@ -231,7 +231,7 @@ tOplkError sdocomsrv_processStateServerSegmTrans(tSdoComConHdl sdoComConHdl_p,
     tSdoComCon*     pSdoComCon;
     UINT8           flag;
 
-    pSdoComCon = &sdoComInstance_g.sdoComCon[sdoComConHdl_p];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[sdoComConHdl_p];
 
     switch (sdoComConEvent_p)
     {
@@ -289,7 +289,7 @@ tOplkError sdocomsrv_processStateServerSegmTrans(tSdoComConHdl sdoComConHdl_p,
         case kSdoComConEventTimeout:
         case kSdoComConEventConClosed:
             ret = sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);
-            OPLK_MEMSET(pSdoComCon, 0x00, sizeof(tSdoComCon));
+            sdocomint_freeCon(pSdoComCon);
             break;
 
         default:
@@ -1243,7 +1243,7 @@ static tOplkError obdSearchConnection(tSdoComConHdl sdoObdConHdl_p,
     tSdoComConHdl   hdlCount;
 
     // get pointer to first element of the array
-    pSdoComCon = &sdoComInstance_g.sdoComCon[0];
+    pSdoComCon = &sdoComInstance_g.paSdoComCon[0];
     hdlCount = 0;
 
     // get pointer to control structure of connection
@@ -1671,7 +1671,7 @@ static tOplkError obdFinishCb(tSdoObdConHdl* pObdHdl_p)
         assignSdoErrorCode(pObdHdl_p->plkError, &pSdoComCon->lastAbortCode);
         abortTransfer(pSdoComCon, pSdoComCon->lastAbortCode);
         ret = sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);
-        OPLK_MEMSET(pSdoComCon, 0x00, sizeof(tSdoComCon));
+        sdocomint_freeCon(pSdoComCon);
         goto Exit;
     }
 
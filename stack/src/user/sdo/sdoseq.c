@@ -59,18 +59,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define SDO_HISTORY_SIZE                5
-
-#ifndef CONFIG_SDO_MAX_CONNECTION_SEQ
-#define CONFIG_SDO_MAX_CONNECTION_SEQ   5
-#endif
-
 #define SDO_SEQ_RETRY_COUNT             2                       // number of ack requests before close (final timeout)
 #define SDO_SEQ_CMDL_INACTIVE_THLD      2                       // number of seq. layer sub timeouts before close if command layer is not active
 #define SDO_SEQ_NUM_THRESHOLD           100                     // threshold which distinguishes between old and new sequence numbers
-#define SDO_SEQ_FRAME_SIZE              24                      // frame with size of Asnd-Header-, SDO Sequence header size, SDO Command header and Ethernet-header size
 #define SDO_SEQ_HEADER_SIZE             4                       // size of the header of the SDO Sequence layer
 #define SDO_SEQ_TX_HISTORY_FRAME_SIZE   SDO_MAX_TX_FRAME_SIZE   // buffersize for one frame in history
+#define SDO_SEQ_MIN_HISTORY_SIZE        2                       // smallest send window granted to a connection
+#define SDO_SEQ_MAX_HISTORY_SIZE        24                      // largest send window, acks must stay below SDO_SEQ_NUM_THRESHOLD
 #define SDO_CON_MASK                    0x03                    // mask to get scon and rcon
 
 #define SEQ_NUM_MASK                    0xFC
@@ -123,16 +118,20 @@ typedef UINT32 tSdoSeqEvent;
 \brief  SDO sequence layer connection history
 
 This structure defines the SDO sequence layer connection history buffer.
+The frame buffers are taken from the history pool of the sequence layer
+instance when the connection is established.
 */
 typedef struct
 {
+    UINT8   windowSize;     ///< Number of history entries granted to the connection (send window)
     UINT8   freeEntries;    ///< Number of free history entries
     UINT8   writeIndex;     ///< Index of the next free buffer entry
     UINT8   ackIndex;       ///< Index of the next message which should become acknowledged
     UINT8   readIndex;      ///< Index between ackIndex and writeIndex to the next message for retransmission
-    UINT8   aHistoryFrame[SDO_HISTORY_SIZE][SDO_SEQ_TX_HISTORY_FRAME_SIZE];    ///< Array of the history frames
-    size_t  aFrameSize[SDO_HISTORY_SIZE];           ///< Array of sizes of the history frames
-    BOOL    afFrameFirstTxFailed[SDO_HISTORY_SIZE]; ///< Array of flags tagging frame as unsent
+    UINT8   lastAckSeqNum;  ///< Last acknowledged sequence number, used to detect repeated acknowledges
+    UINT8*  apHistoryFrame[SDO_SEQ_MAX_HISTORY_SIZE];               ///< Array of the history frame buffers
+    size_t  aFrameSize[SDO_SEQ_MAX_HISTORY_SIZE];                   ///< Array of sizes of the history frames
+    BOOL    afFrameFirstTxFailed[SDO_SEQ_MAX_HISTORY_SIZE];         ///< Array of flags tagging frame as unsent
                                                     /**< Array of flags indicating that the first attempt to
                                                          forward a frame to a lower layer send function failed
                                                          due to buffer overflow e.g. and should be repeated later */
@@ -189,7 +188,19 @@ This structure defines a SDO sequence layer instance.
 */
 typedef struct
 {
-    tSdoSeqCon              aSdoSeqCon[CONFIG_SDO_MAX_CONNECTION_SEQ];  ///< Array of sequence layer connections
+    tSdoSeqCon*             paSdoSeqCon;                                ///< Array of sequence layer connections, allocated at init
+    UINT*                   paFreeCon;                                  ///< Stack of free connection indices, allocated at init
+    UINT                    freeConCount;                               ///< Number of entries on the free connection stack
+    UINT8*                  paHistoryPool;                              ///< Pool of history frame buffers, allocated at init
+    UINT8**                 papFreeHistoryFrame;                        ///< Stack of free history frame buffers, allocated at init
+    UINT                    freeHistoryFrameCount;                      ///< Number of entries on the free history frame stack
+    UINT                    windowSize;                                 ///< Send window requested for new connections
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+    UINT16                  aUdpConIndex[CONFIG_SDO_MAX_CONNECTION_UDP];    ///< Connection index + 1 per UDP connection (0 = none)
+#endif
+#if defined(CONFIG_INCLUDE_SDO_ASND)
+    UINT16                  aAsndConIndex[CONFIG_SDO_MAX_CONNECTION_ASND];  ///< Connection index + 1 per ASnd connection (0 = none)
+#endif
     tSdoComReceiveCb        pfnSdoComRecvCb;                            ///< Pointer to receive callback function
     tSdoComConCb            pfnSdoComConCb;                             ///< Pointer to connection callback function
     UINT32                  sdoSeqTimeout;                              ///< Configured Sequence layer sub-timeout
@@ -254,17 +265,20 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
                             const tAsySdoSeq* pSdoSeqData_p,
                             size_t dataSize_p);
 static tOplkError initHistory(tSdoSeqCon* pSdoSeqCon_p);
+static void       releaseHistory(tSdoSeqCon* pSdoSeqCon_p);
 static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
                                     const tPlkFrame* pFrame_p,
                                     size_t size_p,
                                     BOOL fTxFailed_p);
 static tOplkError sendAllTxHistory(tSdoSeqCon* pSdoSeqCon_p);
+static tOplkError sendUnsentTxHistory(tSdoSeqCon* pSdoSeqCon_p);
 static tOplkError deleteAckedFrameFromHistory(tSdoSeqCon* pSdoSeqCon_p,
                                               UINT8 recvSeqNumber_p);
 static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
                                   tPlkFrame** ppFrame_p,
                                   size_t* pSize_p,
                                   BOOL fInitRead_p);
+static void       setHistoryFrameSent(tSdoSeqCon* pSdoSeqCon_p);
 static UINT8      getFreeHistoryEntries(const tSdoSeqCon* pSdoSeqCon_p);
 static tOplkError setTimer(tSdoSeqCon* pSdoSeqCon_p, ULONG timeout_p);
 static void       processFinalTimeout(tSdoSeqCon* pSdoSeqCon_p,
@@ -280,6 +294,12 @@ static tOplkError sendHistoryOldestSegm(tSdoSeqCon* pSdoSeqCon_p,
                                         UINT8 recvSeqNumber_p);
 static void       forceRetransmissionRequest(tSdoSeqCon* pSdoSeqCon_p,
                                              BOOL fEnable_p);
+static UINT16*    getConIndexEntry(tSdoConHdl conHandle_p);
+static UINT       findCon(tSdoConHdl conHandle_p);
+static UINT       allocCon(tSdoConHdl conHandle_p);
+static void       freeCon(UINT handle_p);
+static void       freeConTable(void);
+static void       freeHistoryPool(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -305,6 +325,7 @@ tOplkError sdoseq_init(tSdoComReceiveCb pfnSdoComRecvCb_p,
                        tSdoComConCb pfnSdoComConCb_p)
 {
     tOplkError  ret = kErrorOk;
+    UINT        count;
 
     if (pfnSdoComRecvCb_p == NULL)
         return kErrorSdoSeqMissCb;
@@ -316,7 +337,46 @@ tOplkError sdoseq_init(tSdoComReceiveCb pfnSdoComRecvCb_p,
     else
         sdoSeqInstance_l.pfnSdoComConCb = pfnSdoComConCb_p;
 
-    OPLK_MEMSET(&sdoSeqInstance_l.aSdoSeqCon[0], 0x00, sizeof(sdoSeqInstance_l.aSdoSeqCon));
+    // allocate the connection table and its free stack
+    sdoSeqInstance_l.paSdoSeqCon = (tSdoSeqCon*)OPLK_MALLOC(sizeof(tSdoSeqCon) * CONFIG_SDO_MAX_CONNECTION_SEQ);
+    sdoSeqInstance_l.paFreeCon = (UINT*)OPLK_MALLOC(sizeof(UINT) * CONFIG_SDO_MAX_CONNECTION_SEQ);
+    if ((sdoSeqInstance_l.paSdoSeqCon == NULL) ||
+        (sdoSeqInstance_l.paFreeCon == NULL))
+    {
+        freeConTable();
+        return kErrorNoResource;
+    }
+
+    OPLK_MEMSET(sdoSeqInstance_l.paSdoSeqCon, 0x00, sizeof(tSdoSeqCon) * CONFIG_SDO_MAX_CONNECTION_SEQ);
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+    OPLK_MEMSET(sdoSeqInstance_l.aUdpConIndex, 0x00, sizeof(sdoSeqInstance_l.aUdpConIndex));
+#endif
+#if defined(CONFIG_INCLUDE_SDO_ASND)
+    OPLK_MEMSET(sdoSeqInstance_l.aAsndConIndex, 0x00, sizeof(sdoSeqInstance_l.aAsndConIndex));
+#endif
+
+    // push in reverse order, so the lowest index is handed out first
+    for (count = CONFIG_SDO_MAX_CONNECTION_SEQ; count > 0; count--)
+        sdoSeqInstance_l.paFreeCon[sdoSeqInstance_l.freeConCount++] = count - 1;
+
+    // allocate the history frame pool shared by all connections
+    sdoSeqInstance_l.paHistoryPool = (UINT8*)OPLK_MALLOC(SDO_SEQ_TX_HISTORY_FRAME_SIZE * CONFIG_SDO_SEQ_HISTORY_POOL_SIZE);
+    sdoSeqInstance_l.papFreeHistoryFrame = (UINT8**)OPLK_MALLOC(sizeof(UINT8*) * CONFIG_SDO_SEQ_HISTORY_POOL_SIZE);
+    if ((sdoSeqInstance_l.paHistoryPool == NULL) ||
+        (sdoSeqInstance_l.papFreeHistoryFrame == NULL))
+    {
+        freeHistoryPool();
+        freeConTable();
+        return kErrorNoResource;
+    }
+
+    for (count = CONFIG_SDO_SEQ_HISTORY_POOL_SIZE; count > 0; count--)
+    {
+        sdoSeqInstance_l.papFreeHistoryFrame[sdoSeqInstance_l.freeHistoryFrameCount++] =
+            &sdoSeqInstance_l.paHistoryPool[(count - 1) * SDO_SEQ_TX_HISTORY_FRAME_SIZE];
+    }
+
+    sdoSeqInstance_l.windowSize = min(CONFIG_SDO_SEQ_HISTORY_SIZE, SDO_SEQ_MAX_HISTORY_SIZE);
 
 #if (defined(WIN32) || defined(_WIN32))
     // create critical section for process function
@@ -362,21 +422,26 @@ tOplkError sdoseq_exit(void)
     tSdoSeqCon* pSdoSeqCon;
 
     // delete timer of open connections
-    count = 0;
-    pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[0];
-    while (count < CONFIG_SDO_MAX_CONNECTION_SEQ)
+    if (sdoSeqInstance_l.paSdoSeqCon != NULL)
     {
-        if (pSdoSeqCon->conHandle != 0)
-            timeru_deleteTimer(&pSdoSeqCon->timerHandle);
+        count = 0;
+        pSdoSeqCon = &sdoSeqInstance_l.paSdoSeqCon[0];
+        while (count < CONFIG_SDO_MAX_CONNECTION_SEQ)
+        {
+            if (pSdoSeqCon->conHandle != 0)
+                timeru_deleteTimer(&pSdoSeqCon->timerHandle);
 
-        count++;
-        pSdoSeqCon++;
+            count++;
+            pSdoSeqCon++;
+        }
     }
 
 #if (defined(WIN32) || defined(_WIN32))
     // delete critical section for process function
     DeleteCriticalSection(sdoSeqInstance_l.pCriticalSection);
 #endif
+    freeHistoryPool();
+    freeConTable();
     OPLK_MEMSET(&sdoSeqInstance_l, 0x00, sizeof(sdoSeqInstance_l));
 
 #if defined(CONFIG_INCLUDE_SDO_UDP)
@@ -419,10 +484,8 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
                           tSdoType sdoType_p)
 {
     tOplkError  ret = kErrorOk;
-    UINT        count;
-    UINT        freeCon;
+    UINT        handle;
     tSdoConHdl  conHandle = (tSdoConHdl)~0U;
-    tSdoSeqCon* pSdoSeqCon;
 
     // Check parameter validity
     ASSERT(pSdoSeqConHdl_p != NULL);
@@ -459,26 +522,12 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
             return kErrorSdoSeqUnsupportedProt;
     }
 
-    // find existing connection to the same node or find empty entry for connection
-    count = 0;
-    freeCon = CONFIG_SDO_MAX_CONNECTION_SEQ;
-    pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[0];
-
-    while (count < CONFIG_SDO_MAX_CONNECTION_SEQ)
-    {
-        if (pSdoSeqCon->conHandle == conHandle)
-            break;
-
-        if (pSdoSeqCon->conHandle == 0)
-            freeCon = count;
-
-        count++;
-        pSdoSeqCon++;
-    }
-
-    if (count == CONFIG_SDO_MAX_CONNECTION_SEQ)
+    // find existing connection to the same node or get a free entry for the connection
+    handle = findCon(conHandle);
+    if (handle == CONFIG_SDO_MAX_CONNECTION_SEQ)
     {
-        if (freeCon == CONFIG_SDO_MAX_CONNECTION_SEQ)
+        handle = allocCon(conHandle);
+        if (handle == CONFIG_SDO_MAX_CONNECTION_SEQ)
         {   // no free entry found
             switch (sdoType_p)
             {
@@ -506,18 +555,11 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
             }
             return kErrorSdoSeqNoFreeHandle;
         }
-        else
-        {   // free entry found
-            pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[freeCon];
-            pSdoSeqCon->conHandle = conHandle;
-            pSdoSeqCon->useCount++;     // increment use counter
-            count = freeCon;
-        }
     }
 
-    *pSdoSeqConHdl_p = (tSdoSeqConHdl)(count | SDO_ASY_HANDLE); // set handle
+    *pSdoSeqConHdl_p = (tSdoSeqConHdl)(handle | SDO_ASY_HANDLE); // set handle
 
-    ret = processState(count, 0, NULL, NULL, kSdoSeqEventInitCon);
+    ret = processState(handle, 0, NULL, NULL, kSdoSeqEventInitCon);
 
     return ret;
 }
@@ -549,19 +591,19 @@ tOplkError sdoseq_sendData(tSdoSeqConHdl sdoSeqConHdl_p,
     handle = ((UINT)sdoSeqConHdl_p & ~SDO_SEQ_HANDLE_MASK);
 
     // check if connection ready
-    if (sdoSeqInstance_l.aSdoSeqCon[handle].sdoSeqState == kSdoSeqStateIdle)
+    if (sdoSeqInstance_l.paSdoSeqCon[handle].sdoSeqState == kSdoSeqStateIdle)
     {
         // no connection with this handle
         return kErrorSdoSeqInvalidHdl;
     }
     else
     {
-        if (sdoSeqInstance_l.aSdoSeqCon[handle].sdoSeqState != kSdoSeqStateConnected)
+        if (sdoSeqInstance_l.paSdoSeqCon[handle].sdoSeqState != kSdoSeqStateConnected)
             return kErrorSdoSeqConnectionBusy;
     }
 
     // calling send function from application counts as reset of flow control
-    forceRetransmissionRequest(&sdoSeqInstance_l.aSdoSeqCon[handle], FALSE);
+    forceRetransmissionRequest(&sdoSeqInstance_l.paSdoSeqCon[handle], FALSE);
 
     ret = processState(handle, dataSize_p, pData_p, NULL, kSdoSeqEventFrameSend);
 
@@ -587,7 +629,6 @@ tOplkError sdoseq_processEvent(const tEvent* pEvent_p)
     tTimerEventArg*     pTimerEventArg;
     tSdoSeqCon*         pSdoSeqCon;
     tTimerHdl           timerHdl;
-    UINT                count;
 
     if (pEvent_p == NULL)
         return kErrorSdoSeqInvalidEvent;
@@ -612,16 +653,16 @@ tOplkError sdoseq_processEvent(const tEvent* pEvent_p)
     timeru_deleteTimer(&pSdoSeqCon->timerHandle);
 
     // get index number of control structure
-    count = 0;
-    while (&sdoSeqInstance_l.aSdoSeqCon[count] != pSdoSeqCon)
-    {
-        count++;
-        if (count > CONFIG_SDO_MAX_CONNECTION_SEQ)
-            return ret;
-    }
+    if ((pSdoSeqCon < sdoSeqInstance_l.paSdoSeqCon) ||
+        (pSdoSeqCon >= &sdoSeqInstance_l.paSdoSeqCon[CONFIG_SDO_MAX_CONNECTION_SEQ]))
+        return ret;
 
     // process event and call process function if needed
-    ret = processState(count, 0, NULL, NULL, kSdoSeqEventTimeout);
+    ret = processState((UINT)(pSdoSeqCon - sdoSeqInstance_l.paSdoSeqCon),
+                       0,
+                       NULL,
+                       NULL,
+                       kSdoSeqEventTimeout);
 
     return ret;
 }
@@ -652,7 +693,7 @@ tOplkError sdoseq_deleteCon(tSdoSeqConHdl sdoSeqConHdl_p)
     if (handle >= CONFIG_SDO_MAX_CONNECTION_SEQ)
         return kErrorSdoSeqInvalidHdl;
 
-    pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[handle];    // get pointer to connection
+    pSdoSeqCon = &sdoSeqInstance_l.paSdoSeqCon[handle];    // get pointer to connection
 
     // Check if connection is already closed
     if (pSdoSeqCon->useCount == 0)
@@ -680,8 +721,9 @@ tOplkError sdoseq_deleteCon(tSdoSeqConHdl sdoSeqConHdl_p)
         timeru_deleteTimer(&pSdoSeqCon->timerHandle);
 
         // cleanup control structure
+        releaseHistory(pSdoSeqCon);
+        freeCon(handle);
         OPLK_MEMSET(pSdoSeqCon, 0x00, sizeof(tSdoSeqCon));
-        pSdoSeqCon->sdoSeqConHistory.freeEntries = SDO_HISTORY_SIZE;
     }
 
     return ret;
@@ -709,6 +751,33 @@ tOplkError sdoseq_setTimeout(UINT32 timeout_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set sequence layer send window
+
+The function sets the send window (number of unacknowledged frames in the Tx
+history) requested for new connections. Each connection takes the frame
+buffers of its window from a shared pool when it is established. If the pool
+cannot provide the whole window, the connection gets a smaller one.
+
+\param[in]      windowSize_p        Requested send window in frames.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sdo_seq
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoseq_setWindowSize(UINT windowSize_p)
+{
+    if ((windowSize_p < SDO_SEQ_MIN_HISTORY_SIZE) ||
+        (windowSize_p > SDO_SEQ_MAX_HISTORY_SIZE))
+        return kErrorApiInvalidParam;
+
+    sdoSeqInstance_l.windowSize = windowSize_p;
+
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -1662,7 +1731,7 @@ static tOplkError processState(UINT handle_p,
         return kErrorSdoSeqInvalidHdl;
 
     // get pointer to connection
-    pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[handle_p];
+    pSdoSeqCon = &sdoSeqInstance_l.paSdoSeqCon[handle_p];
 
     // check size
     if ((pData_p == NULL) && (pRecvFrame_p == NULL) && (dataSize_p != 0))
@@ -1758,16 +1827,14 @@ static tOplkError sendFrame(tSdoSeqCon* pSdoSeqCon_p,
 {
     tOplkError  ret = kErrorOk;
     tOplkError  retReplace = kErrorOk;
-    UINT8       aFrame[SDO_SEQ_FRAME_SIZE];
+    tPlkFrame   frame;
     tPlkFrame*  pFrame;
-    tPlkFrame*  pFrameResend;
-    size_t      frameSizeResend;
     UINT8       freeEntries = 0;
 
     if (pData_p == NULL)
     {   // set pointer to own frame
-        OPLK_MEMSET(&aFrame[0], 0x00, sizeof(aFrame));
-        pFrame = (tPlkFrame*)&aFrame[0];
+        OPLK_MEMSET(&frame, 0x00, sizeof(frame));
+        pFrame = &frame;
     }
     else
     {
@@ -1797,23 +1864,7 @@ static tOplkError sendFrame(tSdoSeqCon* pSdoSeqCon_p,
 
         // send unsent frames from history first to prevent retransmission request
         // caused by newer frames "overtaking" unsent frames internally
-        ret = readFromHistory(pSdoSeqCon_p, &pFrameResend, &frameSizeResend, TRUE);
-        while ((pFrameResend != NULL) && (frameSizeResend != 0))
-        {
-            if (ret == kErrorRetry)
-            { // resend unsent frame
-                ret = sendToLowerLayer(pSdoSeqCon_p, frameSizeResend, pFrameResend);
-                if (ret == kErrorDllAsyncTxBufferFull)
-                {
-                    ret = kErrorOk; // ignore unsent frames
-                    break;          // stop sending old frames
-                }
-                if (ret != kErrorOk)
-                    goto Exit;
-            }
-            // read next frame
-            ret = readFromHistory(pSdoSeqCon_p, &pFrameResend, &frameSizeResend, FALSE);
-        }
+        ret = sendUnsentTxHistory(pSdoSeqCon_p);
     }
     else
     {   // frame not stored to history
@@ -1895,15 +1946,10 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
                             size_t dataSize_p)
 {
     tOplkError  ret = kErrorOk;
-    UINT        count;
-    UINT        freeEntry;
-    tSdoSeqCon* pSdoSeqCon;
+    UINT        handle;
 
     do
     {
-        count = 0;
-        freeEntry = CONFIG_SDO_MAX_CONNECTION_SEQ;
-
 #if (defined(WIN32) || defined(_WIN32))
         EnterCriticalSection(sdoSeqInstance_l.pCriticalSectionReceive);
 #endif
@@ -1912,22 +1958,12 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
                             conHdl_p,
                             ((const UINT8*)pSdoSeqData_p)[0]);
 
-        // search control structure for this connection
-        pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[count];
-        while (count < CONFIG_SDO_MAX_CONNECTION_SEQ)
-        {
-            if (pSdoSeqCon->conHandle == conHdl_p)
-                break;
-            else if ((pSdoSeqCon->conHandle == 0) && (freeEntry == CONFIG_SDO_MAX_CONNECTION_SEQ))
-                freeEntry = count;   // free entry
-
-            count++;
-            pSdoSeqCon++;
-        }
-
-        if (count == CONFIG_SDO_MAX_CONNECTION_SEQ)
+        // look up control structure for this connection
+        handle = findCon(conHdl_p);
+        if (handle == CONFIG_SDO_MAX_CONNECTION_SEQ)
         {   // new connection
-            if (freeEntry == CONFIG_SDO_MAX_CONNECTION_SEQ)
+            handle = allocCon(conHdl_p);
+            if (handle == CONFIG_SDO_MAX_CONNECTION_SEQ)
             {
                 ret = kErrorSdoSeqNoFreeHandle;
 #if (defined(WIN32) || defined(_WIN32))
@@ -1935,13 +1971,6 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
 #endif
                 return ret;
             }
-            else
-            {
-                pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[freeEntry];
-                pSdoSeqCon->conHandle = conHdl_p;    // save handle from lower layer
-                pSdoSeqCon->useCount++;
-                count = freeEntry;
-            }
         }
 
 #if (defined(WIN32) || defined(_WIN32))
@@ -1949,7 +1978,7 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
 #endif
 
         // call process function with pointer of frame and event kSdoSeqEventFrameRec
-        ret = processState(count, dataSize_p, NULL, pSdoSeqData_p, kSdoSeqEventFrameRec);
+        ret = processState(handle, dataSize_p, NULL, pSdoSeqData_p, kSdoSeqEventFrameRec);
     } while (ret == kErrorRetry);
 
     return ret;
@@ -1959,22 +1988,60 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
 /**
 \brief  Initialize history buffer
 
-The function initializes the history buffer of a SDO connection.
+The function initializes the history buffer of a SDO connection. It takes the
+frame buffers of the send window from the history pool. If the pool cannot
+provide the requested window, the connection gets the remaining buffers.
 
 \param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
 
 \return The function returns a tOplkError error code.
+\retval kErrorOk                    History buffer is initialized
+\retval kErrorSdoSeqNoFreeHistory   The pool cannot provide the minimum window
 */
 //------------------------------------------------------------------------------
 static tOplkError initHistory(tSdoSeqCon* pSdoSeqCon_p)
 {
-    pSdoSeqCon_p->sdoSeqConHistory.freeEntries = SDO_HISTORY_SIZE;
-    pSdoSeqCon_p->sdoSeqConHistory.ackIndex = 0;
-    pSdoSeqCon_p->sdoSeqConHistory.writeIndex = 0;
+    tSdoSeqConHistory*  pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+    UINT                windowSize;
+    UINT                count;
+
+    // return the buffers of a previous connection before taking new ones
+    releaseHistory(pSdoSeqCon_p);
+
+    windowSize = min(sdoSeqInstance_l.windowSize, sdoSeqInstance_l.freeHistoryFrameCount);
+    if (windowSize < SDO_SEQ_MIN_HISTORY_SIZE)
+        return kErrorSdoSeqNoFreeHistory;
+
+    for (count = 0; count < windowSize; count++)
+        pHistory->apHistoryFrame[count] = sdoSeqInstance_l.papFreeHistoryFrame[--sdoSeqInstance_l.freeHistoryFrameCount];
+
+    pHistory->windowSize = (UINT8)windowSize;
+    pHistory->freeEntries = (UINT8)windowSize;
+    pHistory->lastAckSeqNum = pSdoSeqCon_p->recvSeqNum & SEQ_NUM_MASK;
 
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Release history buffer
+
+The function returns the frame buffers of a SDO connection to the history pool.
+
+\param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
+*/
+//------------------------------------------------------------------------------
+static void releaseHistory(tSdoSeqCon* pSdoSeqCon_p)
+{
+    tSdoSeqConHistory*  pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+    UINT                count;
+
+    for (count = 0; count < pHistory->windowSize; count++)
+        sdoSeqInstance_l.papFreeHistoryFrame[sdoSeqInstance_l.freeHistoryFrameCount++] = pHistory->apHistoryFrame[count];
+
+    OPLK_MEMSET(pHistory, 0x00, sizeof(tSdoSeqConHistory));
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Add frame to the history buffer
@@ -2009,7 +2076,7 @@ static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
     // check if a free entry is available
     if (pHistory->freeEntries > 0)
     {   // write message in free entry
-        pHistoryFrame = (tPlkFrame*)pHistory->aHistoryFrame[pHistory->writeIndex];
+        pHistoryFrame = (tPlkFrame*)pHistory->apHistoryFrame[pHistory->writeIndex];
 
         OPLK_MEMCPY(&pHistoryFrame->messageType,
                     &pFrame_p->messageType,
@@ -2018,7 +2085,7 @@ static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
         pHistory->afFrameFirstTxFailed[pHistory->writeIndex] = fTxFailed_p;
         pHistory->freeEntries--;
         pHistory->writeIndex++;
-        if (pHistory->writeIndex == SDO_HISTORY_SIZE)    // check if write-index ran over array-border
+        if (pHistory->writeIndex == pHistory->windowSize)   // check if write-index ran over array-border
             pHistory->writeIndex = 0;
     }
     else
@@ -2062,6 +2129,8 @@ static tOplkError sendAllTxHistory(tSdoSeqCon* pSdoSeqCon_p)
         if (ret != kErrorOk)
             return ret;
 
+        setHistoryFrameSent(pSdoSeqCon_p);
+
         ret = readFromHistory(pSdoSeqCon_p, &pFrame, &frameSize, FALSE);
         if (ret == kErrorRetry)
             ret = kErrorOk; // ignore unsent frames info
@@ -2073,6 +2142,45 @@ static tOplkError sendAllTxHistory(tSdoSeqCon* pSdoSeqCon_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Send the unsent frames of the history buffer
+
+The function sends all frames of the Tx history buffer which could not be
+passed to the lower layer yet. Frames which were already sent are not
+repeated.
+
+\param[in,out]  pSdoSeqCon_p        Pointer to sequence layer connection information.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sendUnsentTxHistory(tSdoSeqCon* pSdoSeqCon_p)
+{
+    tOplkError  ret;
+    size_t      frameSize;
+    tPlkFrame*  pFrame;
+
+    ret = readFromHistory(pSdoSeqCon_p, &pFrame, &frameSize, TRUE);
+    while ((pFrame != NULL) && (frameSize != 0))
+    {
+        if (ret == kErrorRetry)
+        {   // send unsent frame
+            ret = sendToLowerLayer(pSdoSeqCon_p, frameSize, pFrame);
+            if (ret == kErrorDllAsyncTxBufferFull)
+                return kErrorOk;    // ignore unsent frames and stop sending old frames
+            if (ret != kErrorOk)
+                return ret;
+
+            setHistoryFrameSent(pSdoSeqCon_p);
+        }
+        // read next frame
+        ret = readFromHistory(pSdoSeqCon_p, &pFrame, &frameSize, FALSE);
+    }
+
+    return kErrorOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Delete acknowledged frame from the history buffer
@@ -2100,12 +2208,12 @@ static tOplkError deleteAckedFrameFromHistory(tSdoSeqCon* pSdoSeqCon_p,
     // release all acknowledged frames from history buffer
 
     // check if there are entries in history
-    if (pHistory->freeEntries < SDO_HISTORY_SIZE)
+    if (pHistory->freeEntries < pHistory->windowSize)
     {
         ackIndex = pHistory->ackIndex;
         do
         {
-            pHistoryFrame = (tPlkFrame*)pHistory->aHistoryFrame[ackIndex];
+            pHistoryFrame = (tPlkFrame*)pHistory->apHistoryFrame[ackIndex];
 
             currentSeqNum = (pHistoryFrame->data.asnd.payload.sdoSequenceFrame.sendSeqNumCon & SEQ_NUM_MASK);
             if (((recvSeqNumber_p - currentSeqNum) & SEQ_NUM_MASK) < SDO_SEQ_NUM_THRESHOLD)
@@ -2114,7 +2222,7 @@ static tOplkError deleteAckedFrameFromHistory(tSdoSeqCon* pSdoSeqCon_p,
                 pHistory->afFrameFirstTxFailed[ackIndex] = FALSE;
                 ackIndex++;
                 pHistory->freeEntries++;
-                if (ackIndex == SDO_HISTORY_SIZE)
+                if (ackIndex == pHistory->windowSize)
                     ackIndex = 0;
             }
             else
@@ -2169,7 +2277,7 @@ static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
     }
 
     // history buffer not empty and end of read iteration not yet reached
-    if ((pHistory->freeEntries < SDO_HISTORY_SIZE) &&
+    if ((pHistory->freeEntries < pHistory->windowSize) &&
         ((pHistory->writeIndex != pHistory->readIndex) ||
          ((pHistory->freeEntries == 0) && fInitRead_p)))
     {
@@ -2191,10 +2299,10 @@ static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
                             pHistory->aFrameSize[pHistory->readIndex]);
 
         // return pointer to stored frame
-        *ppFrame_p = (tPlkFrame*)pHistory->aHistoryFrame[pHistory->readIndex];
+        *ppFrame_p = (tPlkFrame*)pHistory->apHistoryFrame[pHistory->readIndex];
         *pSize_p = pHistory->aFrameSize[pHistory->readIndex];   // save size
         pHistory->readIndex++;
-        if (pHistory->readIndex == SDO_HISTORY_SIZE)
+        if (pHistory->readIndex == pHistory->windowSize)
             pHistory->readIndex = 0;
     }
     else
@@ -2214,6 +2322,25 @@ static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Mark history frame as sent
+
+The function clears the unsent flag of the frame which was returned by the last
+call of readFromHistory(), after it was passed to the lower layer.
+
+\param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
+*/
+//------------------------------------------------------------------------------
+static void setHistoryFrameSent(tSdoSeqCon* pSdoSeqCon_p)
+{
+    tSdoSeqConHistory*  pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+    UINT8               index;
+
+    index = (pHistory->readIndex == 0) ? (pHistory->windowSize - 1) : (pHistory->readIndex - 1);
+    pHistory->afFrameFirstTxFailed[index] = FALSE;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get number of free history entries
@@ -2357,9 +2484,11 @@ static tOplkError processSubTimeout(tSdoSeqCon* pSdoSeqCon_p)
 
         ret = sendToLowerLayer(pSdoSeqCon_p, frameSize, pFrame);
         if (ret == kErrorDllAsyncTxBufferFull)
-            ret = kErrorOk; // ignore unsent frames
+            return kErrorOk;    // ignore unsent frames
         if (ret != kErrorOk)
             return ret;
+
+        setHistoryFrameSent(pSdoSeqCon_p);
     }
     else
     {   // send empty frame with ack request in own scon
@@ -2439,7 +2568,11 @@ static BOOL checkHistoryAcked(const tSdoSeqCon* pSdoSeqCon_p,
 
     // get pointer to history buffer
     pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
-    pHistoryFrame = (const tPlkFrame*)pHistory->aHistoryFrame[pHistory->ackIndex];
+    if (pHistory->freeEntries == pHistory->windowSize)
+        return FALSE;   // history is empty
+
+    pHistoryFrame = (const tPlkFrame*)pHistory->apHistoryFrame[pHistory->ackIndex];
+
     currentSeqNum = (pHistoryFrame->data.asnd.payload.sdoSequenceFrame.sendSeqNumCon & SEQ_NUM_MASK);
     if (((recvSeqNumber_p - currentSeqNum) & SEQ_NUM_MASK) < SDO_SEQ_NUM_THRESHOLD)
     {   // acknowledges at least the oldest history frame
@@ -2484,7 +2617,10 @@ static BOOL checkConnectionAckValid(const tSdoSeqCon* pSdoSeqCon_p,
 \brief  Send one frame (oldest) of the Tx history buffer
 
 This function transmits the oldest frame of the Tx history buffer, if
-it exists. If the history buffer is empty, nothing happens.
+it exists and the receiver repeated an old acknowledge. If the acknowledge
+advanced, the following frames are still on their way and only the frames
+which could not be passed to the lower layer yet are sent. If the history
+buffer is empty, nothing happens.
 
 \param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
 \param[in]      recvSeqNumber_p     Receive sequence number of frame to delete.
@@ -2495,9 +2631,14 @@ it exists. If the history buffer is empty, nothing happens.
 static tOplkError sendHistoryOldestSegm(tSdoSeqCon* pSdoSeqCon_p,
                                         UINT8 recvSeqNumber_p)
 {
-    tOplkError  ret = kErrorOk;
-    size_t      frameSize;
-    tPlkFrame*  pFrame;
+    tOplkError          ret = kErrorOk;
+    tSdoSeqConHistory*  pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+    size_t              frameSize;
+    tPlkFrame*          pFrame;
+    BOOL                fRepeatedAck;
+
+    fRepeatedAck = ((recvSeqNumber_p & SEQ_NUM_MASK) == pHistory->lastAckSeqNum);
+    pHistory->lastAckSeqNum = recvSeqNumber_p & SEQ_NUM_MASK;
 
     // transmission on server for last segments
     if (((recvSeqNumber_p & SEQ_NUM_MASK) != (pSdoSeqCon_p->recvSeqNum & SEQ_NUM_MASK)) &&
@@ -2505,8 +2646,10 @@ static tOplkError sendHistoryOldestSegm(tSdoSeqCon* pSdoSeqCon_p,
     {   // old acknowledge of receiver
         // Use this as trigger for last segments, since they
         // don't get a trigger otherwise, except a timeout.
+        if (!fRepeatedAck)
+            return sendUnsentTxHistory(pSdoSeqCon_p);
 
-        // send oldest history frame
+        // the receiver is still missing the oldest frame -> send oldest history frame
         ret = readFromHistory(pSdoSeqCon_p, &pFrame, &frameSize, TRUE);
         if (ret == kErrorRetry)
             ret = kErrorOk; // ignore unsent frames info
@@ -2517,10 +2660,12 @@ static tOplkError sendHistoryOldestSegm(tSdoSeqCon* pSdoSeqCon_p,
         {
             ret = sendToLowerLayer(pSdoSeqCon_p, frameSize, pFrame);
             if (ret == kErrorDllAsyncTxBufferFull)
-                ret = kErrorOk; // ignore unsent frame
+                return kErrorOk;    // ignore unsent frame
 
             if (ret != kErrorOk)
                 return ret;
+
+            setHistoryFrameSent(pSdoSeqCon_p);
         }
     }
 
@@ -2551,4 +2696,176 @@ static void forceRetransmissionRequest(tSdoSeqCon* pSdoSeqCon_p, BOOL fEnable_p)
     pSdoSeqCon_p->fForceFlowControl = fEnable_p;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get connection index entry of a lower layer connection
+
+The function returns the entry of the connection index which maps the specified
+lower layer (UDP or ASnd) connection to a sequence layer connection.
+
+\param[in]      conHandle_p         Lower layer connection handle.
+
+\return The function returns a pointer to the index entry or NULL if the handle
+        is invalid.
+*/
+//------------------------------------------------------------------------------
+static UINT16* getConIndexEntry(tSdoConHdl conHandle_p)
+{
+    UINT    array = ((UINT)conHandle_p & ~SDO_ASY_HANDLE_MASK);
+
+    switch (conHandle_p & SDO_ASY_HANDLE_MASK)
+    {
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+        case SDO_UDP_HANDLE:
+            if (array < CONFIG_SDO_MAX_CONNECTION_UDP)
+                return &sdoSeqInstance_l.aUdpConIndex[array];
+            break;
+#endif
+
+#if defined(CONFIG_INCLUDE_SDO_ASND)
+        case SDO_ASND_HANDLE:
+            if (array < CONFIG_SDO_MAX_CONNECTION_ASND)
+                return &sdoSeqInstance_l.aAsndConIndex[array];
+            break;
+#endif
+
+        default:
+            break;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Find connection of a lower layer connection
+
+The function looks up the sequence layer connection which uses the specified
+lower layer connection.
+
+\param[in]      conHandle_p         Lower layer connection handle.
+
+\return The function returns the index of the sequence layer connection or
+        CONFIG_SDO_MAX_CONNECTION_SEQ if no connection exists.
+*/
+//------------------------------------------------------------------------------
+static UINT findCon(tSdoConHdl conHandle_p)
+{
+    UINT16* pIndexEntry;
+
+    pIndexEntry = getConIndexEntry(conHandle_p);
+    if ((pIndexEntry == NULL) || (*pIndexEntry == 0))
+        return CONFIG_SDO_MAX_CONNECTION_SEQ;
+
+    return *pIndexEntry - 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate a connection
+
+The function takes a free sequence layer connection from the free connection
+stack and assigns the specified lower layer connection to it.
+
+\param[in]      conHandle_p         Lower layer connection handle.
+
+\return The function returns the index of the allocated connection or
+        CONFIG_SDO_MAX_CONNECTION_SEQ if no free connection is available.
+*/
+//------------------------------------------------------------------------------
+static UINT allocCon(tSdoConHdl conHandle_p)
+{
+    UINT16*     pIndexEntry;
+    UINT        handle;
+    tSdoSeqCon* pSdoSeqCon;
+
+    pIndexEntry = getConIndexEntry(conHandle_p);
+    if ((pIndexEntry == NULL) || (sdoSeqInstance_l.freeConCount == 0))
+        return CONFIG_SDO_MAX_CONNECTION_SEQ;
+
+    handle = sdoSeqInstance_l.paFreeCon[--sdoSeqInstance_l.freeConCount];
+    *pIndexEntry = (UINT16)(handle + 1);
+
+    pSdoSeqCon = &sdoSeqInstance_l.paSdoSeqCon[handle];
+    pSdoSeqCon->conHandle = conHandle_p;    // save handle from lower layer
+    pSdoSeqCon->useCount++;                 // increment use counter
+
+    return handle;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a connection
+
+The function removes the lower layer connection of the specified sequence layer
+connection from the connection index and returns the connection to the free
+connection stack. The control structure itself is cleaned up by the caller.
+
+\param[in]      handle_p            Index of the sequence layer connection.
+*/
+//------------------------------------------------------------------------------
+static void freeCon(UINT handle_p)
+{
+    UINT16*     pIndexEntry;
+    tSdoSeqCon* pSdoSeqCon = &sdoSeqInstance_l.paSdoSeqCon[handle_p];
+
+    if (pSdoSeqCon->conHandle == 0)
+        return;     // connection is not allocated
+
+    pIndexEntry = getConIndexEntry(pSdoSeqCon->conHandle);
+    if ((pIndexEntry != NULL) && (*pIndexEntry == (handle_p + 1)))
+        *pIndexEntry = 0;
+
+    pSdoSeqCon->conHandle = 0;
+    sdoSeqInstance_l.paFreeCon[sdoSeqInstance_l.freeConCount++] = handle_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free connection table
+
+The function frees the connection table and the free connection stack.
+*/
+//------------------------------------------------------------------------------
+static void freeConTable(void)
+{
+    if (sdoSeqInstance_l.paSdoSeqCon != NULL)
+    {
+        OPLK_FREE(sdoSeqInstance_l.paSdoSeqCon);
+        sdoSeqInstance_l.paSdoSeqCon = NULL;
+    }
+
+    if (sdoSeqInstance_l.paFreeCon != NULL)
+    {
+        OPLK_FREE(sdoSeqInstance_l.paFreeCon);
+        sdoSeqInstance_l.paFreeCon = NULL;
+    }
+
+    sdoSeqInstance_l.freeConCount = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free the history frame pool
+
+The function frees the history frame pool allocated by sdoseq_init().
+*/
+//------------------------------------------------------------------------------
+static void freeHistoryPool(void)
+{
+    if (sdoSeqInstance_l.paHistoryPool != NULL)
+    {
+        OPLK_FREE(sdoSeqInstance_l.paHistoryPool);
+        sdoSeqInstance_l.paHistoryPool = NULL;
+    }
+
+    if (sdoSeqInstance_l.papFreeHistoryFrame != NULL)
+    {
+        OPLK_FREE(sdoSeqInstance_l.papFreeHistoryFrame);
+        sdoSeqInstance_l.papFreeHistoryFrame = NULL;
+    }
+
+    sdoSeqInstance_l.freeHistoryFrameCount = 0;
+}
+
 /// \}
@@ -163,6 +163,7 @@ tOplkError sdotestcom_init(sdoApiCbComTest sdoComCbApi_p)
     // Init circular buffer for module internal communication
     cbret = circbuf_alloc(CIRCBUF_USER_INTERNAL_QUEUE,
                           CONFIG_EVENT_SIZE_CIRCBUF_USER_INTERNAL,
+                          kCircBufModeLocked,
                           &sdoTestComInst_l.tCmdCon.pCbBufInst);
 
     if (cbret != kCircBufOk)
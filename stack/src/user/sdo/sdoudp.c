@@ -53,10 +53,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#ifndef CONFIG_SDO_MAX_CONNECTION_UDP
-#define CONFIG_SDO_MAX_CONNECTION_UDP  5
-#endif
-
 #if (TARGET_SYSTEM == _LINUX_)
 #include <arpa/inet.h>
 #else
@@ -5,7 +5,11 @@
 \brief  Implementation of user timer module for Linux userspace
 
 This file contains the implementation of the user timer module for Linux
-userspace. This implementation uses the posix timer interface.
+userspace. All timers are kept in a hashed timer wheel with one slot per
+millisecond. The wheel is driven by a single timerfd which is armed for the
+next occupied slot. Therefore, setting and deleting a timer doesn't create a
+kernel timer and all timers expiring at the same time are processed with a
+single wakeup of the timer thread.
 
 \ingroup module_timeru
 *******************************************************************************/
@@ -47,9 +51,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 #include <unistd.h>
+#include <errno.h>
+#include <time.h>
 #include <pthread.h>
-#include <semaphore.h>
-#include <signal.h>
+#include <sys/timerfd.h>
 
 // Needed for debugging to extract thread ID on Linux
 #include <sys/syscall.h>
@@ -77,6 +82,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define TIMERU_WHEEL_SLOTS          256                         // Number of wheel slots (power of 2), one slot per millisecond
+#define TIMERU_WHEEL_MASK           (TIMERU_WHEEL_SLOTS - 1)
+#define TIMERU_WHEEL_MAP_WORDS      (TIMERU_WHEEL_SLOTS / 64)   // Number of 64 bit words of the slot occupancy map
+#define TIMERU_POOL_BLOCK_ENTRIES   TIMERU_MAX_ENTRIES          // Number of timer entries allocated at once
 
 //------------------------------------------------------------------------------
 // local types
@@ -85,19 +94,34 @@ typedef struct sTimeruData tTimeruData;
 
 struct sTimeruData
 {
-    timer_t             timer;
-    tTimerArg           timerArgument;
-    tTimeruData*        pNextTimer;
-    tTimeruData*        pPrevTimer;
+    ULONGLONG           expiryTick;                         ///< Expiry time in ms of the monotonic clock
+    tTimerArg           timerArgument;                      ///< Argument of the timer event
+    BOOL                fActive;                            ///< Timer is linked into the wheel
+    tTimeruData*        pNextTimer;                         ///< Next timer in the wheel slot or in the free list
+    tTimeruData*        pPrevTimer;                         ///< Previous timer in the wheel slot
+};
+
+typedef struct sTimeruPoolBlock tTimeruPoolBlock;
+
+struct sTimeruPoolBlock
+{
+    tTimeruPoolBlock*   pNextBlock;                         ///< Next allocated block of timer entries
+    tTimeruData         aTimer[TIMERU_POOL_BLOCK_ENTRIES];  ///< Timer entries
 };
 
 typedef struct
 {
     pthread_t           processThread;
     pthread_mutex_t     mutex;
-    tTimeruData*        pFirstTimer;
-    tTimeruData*        pLastTimer;
-    tTimeruData*        pCurrentTimer;
+    int                 timerFd;                            ///< timerfd driving the timer wheel
+    BOOL                fStopThread;                        ///< Request to terminate the timer thread
+    ULONGLONG           lastTick;                           ///< Last tick which was processed
+    ULONGLONG           armedTick;                          ///< Tick the timerfd is armed for (0 = disarmed)
+    UINT                activeTimers;                       ///< Number of timers in the wheel
+    tTimeruData*        apSlot[TIMERU_WHEEL_SLOTS];         ///< Timer lists of the wheel slots
+    ULONGLONG           aSlotMap[TIMERU_WHEEL_MAP_WORDS];   ///< Occupancy map of the wheel slots
+    tTimeruData*        pFreeTimer;                         ///< List of free timer entries
+    tTimeruPoolBlock*   pFirstBlock;                        ///< List of allocated timer entry blocks
 } tTimeruInstance;
 
 //------------------------------------------------------------------------------
@@ -110,10 +134,15 @@ static tTimeruInstance timeruInstance_g;
 //------------------------------------------------------------------------------
 static void         cbTimer(const tTimeruData* pData_p);
 static void*        processThread(void* pArgument_p);
-static void         addTimer(tTimeruData* pData_p);
+static void         insertTimer(tTimeruData* pData_p, ULONG timeInMs_p);
 static void         removeTimer(tTimeruData* pData_p);
-static void         resetTimerList(void);
-static tTimeruData* getNextTimer(void);
+static void         processExpiredTimers(ULONGLONG currentTick_p);
+static ULONGLONG    getNextTick(void);
+static void         armTimerFd(ULONGLONG tick_p);
+static ULONGLONG    getCurrentTick(BOOL fRoundUp_p);
+static tTimeruData* allocTimer(void);
+static void         freeTimer(tTimeruData* pData_p);
+static void         freeTimerPool(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -136,16 +165,24 @@ tOplkError timeru_init(void)
     int                 retVal;
 
     // reset instance structure
-    timeruInstance_g.processThread = 0;
-    timeruInstance_g.pFirstTimer = NULL;
-    timeruInstance_g.pLastTimer = NULL;
+    OPLK_MEMSET(&timeruInstance_g, 0, sizeof(timeruInstance_g));
+
+    timeruInstance_g.timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (timeruInstance_g.timerFd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't create timerfd!\n", __func__);
+        return kErrorNoResource;
+    }
 
     if (pthread_mutex_init(&timeruInstance_g.mutex, NULL) != 0)
     {
         DEBUG_LVL_ERROR_TRACE("%s() couldn't init mutex!\n", __func__);
+        close(timeruInstance_g.timerFd);
         return kErrorNoResource;
     }
 
+    timeruInstance_g.lastTick = getCurrentTick(FALSE);
+
     retVal = pthread_create(&timeruInstance_g.processThread,
                             NULL,
                             processThread,
@@ -155,7 +192,9 @@ tOplkError timeru_init(void)
         DEBUG_LVL_ERROR_TRACE("%s() couldn't create timer thread! (%d)\n",
                               __func__,
                               retVal);
+        timeruInstance_g.processThread = 0;
         pthread_mutex_destroy(&timeruInstance_g.mutex);
+        close(timeruInstance_g.timerFd);
         return kErrorNoResource;
     }
 
@@ -188,32 +227,32 @@ The function shuts down the user timer instance.
 //------------------------------------------------------------------------------
 tOplkError timeru_exit(void)
 {
-    tTimeruData*    pTimer;
-
     /* Check if the processThread exist */
     if (timeruInstance_g.processThread != 0)
     {
-        /* cancel thread */
-        pthread_cancel(timeruInstance_g.processThread);
+        // Wake up the thread by arming the timerfd for an elapsed time
+        pthread_mutex_lock(&timeruInstance_g.mutex);
+        timeruInstance_g.fStopThread = TRUE;
+        armTimerFd(getCurrentTick(FALSE));
+        pthread_mutex_unlock(&timeruInstance_g.mutex);
         DEBUG_LVL_TIMERU_TRACE("%s() Waiting for thread to exit...\n", __func__);
 
         /* wait for thread to terminate */
         pthread_join(timeruInstance_g.processThread, NULL);
         DEBUG_LVL_TIMERU_TRACE("%s()Thread exited\n", __func__);
-    }
+        timeruInstance_g.processThread = 0;
 
-    /* free up timer list */
-    resetTimerList();
-    while ((pTimer = getNextTimer()) != NULL)
-    {
-        removeTimer(pTimer);
-        OPLK_FREE(pTimer);
+        pthread_mutex_destroy(&timeruInstance_g.mutex);
+        close(timeruInstance_g.timerFd);
     }
 
-    pthread_mutex_destroy(&timeruInstance_g.mutex);
+    /* free up timer entries */
+    freeTimerPool();
 
-    timeruInstance_g.pFirstTimer = NULL;
-    timeruInstance_g.pLastTimer = NULL;
+    OPLK_MEMSET(timeruInstance_g.apSlot, 0, sizeof(timeruInstance_g.apSlot));
+    OPLK_MEMSET(timeruInstance_g.aSlotMap, 0, sizeof(timeruInstance_g.aSlotMap));
+    timeruInstance_g.activeTimers = 0;
+    timeruInstance_g.armedTick = 0;
 
     return kErrorOk;
 }
@@ -257,57 +296,30 @@ tOplkError timeru_setTimer(tTimerHdl* pTimerHdl_p,
                            ULONG timeInMs_p,
                            const tTimerArg* pArgument_p)
 {
-    tTimeruData*        pData;
-    struct itimerspec   relTime;
-    struct itimerspec   curTime;
-    struct sigevent     sev;
+    tTimeruData*    pData;
 
     if (pTimerHdl_p == NULL)
         return kErrorTimerInvalidHandle;
 
-    pData = (tTimeruData*)OPLK_MALLOC(sizeof(tTimeruData));
-    if (pData == NULL)
-        return kErrorNoResource;
-
-    OPLK_MEMCPY(&pData->timerArgument, pArgument_p, sizeof(tTimerArg));
-
-    addTimer(pData);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
 
-    sev.sigev_notify = SIGEV_SIGNAL;
-    sev.sigev_signo = SIGRTMIN;
-    sev.sigev_value.sival_ptr = pData;
-    if (timer_create(CLOCK_MONOTONIC, &sev, &pData->timer) == -1)
+    pData = allocTimer();
+    if (pData == NULL)
     {
-        DEBUG_LVL_ERROR_TRACE("%s() Error creating timer!\n", __func__);
-        OPLK_FREE(pData);
+        pthread_mutex_unlock(&timeruInstance_g.mutex);
         return kErrorNoResource;
     }
 
-    if (timeInMs_p >= 1000)
-    {
-        relTime.it_value.tv_sec = (timeInMs_p / 1000);
-        relTime.it_value.tv_nsec = (timeInMs_p % 1000) * 1000000;
-    }
-    else
-    {
-        relTime.it_value.tv_sec = 0;
-        relTime.it_value.tv_nsec = timeInMs_p * 1000000;
-    }
+    OPLK_MEMCPY(&pData->timerArgument, pArgument_p, sizeof(tTimerArg));
+    insertTimer(pData, timeInMs_p);
+
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
     DEBUG_LVL_TIMERU_TRACE("%s() Set timer: %p, timeInMs_p=%ld\n",
                            __func__,
                            (void*)pData,
                            timeInMs_p);
 
-    relTime.it_interval.tv_sec = 0;
-    relTime.it_interval.tv_nsec = 0;
-
-    if (timer_settime(pData->timer, 0, &relTime, &curTime) < 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Error timer_settime!\n", __func__);
-        return kErrorTimerNoTimerCreated;
-    }
-
     *pTimerHdl_p = (tTimerHdl)pData;
     return kErrorOk;
 }
@@ -332,8 +344,7 @@ tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
                               ULONG timeInMs_p,
                               const tTimerArg* pArgument_p)
 {
-    tTimeruData*        pData;
-    struct itimerspec   relTime, curTime;
+    tTimeruData*    pData;
 
     if (pTimerHdl_p == NULL)
         return kErrorTimerInvalidHandle;
@@ -344,36 +355,23 @@ tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
 
     pData = (tTimeruData*)*pTimerHdl_p;
 
-    if (timeInMs_p >= 1000)
-    {
-        relTime.it_value.tv_sec = (timeInMs_p / 1000);
-        relTime.it_value.tv_nsec = (timeInMs_p % 1000) * 1000000;
-    }
-    else
-    {
-        relTime.it_value.tv_sec = 0;
-        relTime.it_value.tv_nsec = timeInMs_p * 1000000;
-    }
-
     DEBUG_LVL_TIMERU_TRACE("%s() Modify timer:%08x timeInMs_p=%ld\n",
                            __func__,
                            *pTimerHdl_p,
                            timeInMs_p);
 
-    relTime.it_interval.tv_sec = 0;
-    relTime.it_interval.tv_nsec = 0;
-    if (timer_settime(pData->timer, 0, &relTime, &curTime) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Error timer_settime!\n", __func__);
-        return kErrorTimerNoTimerCreated;
-    }
+    // The timer is restarted while the timer thread is locked out. Therefore,
+    // an expiry of the old timeout was either posted with the old argument
+    // already or it doesn't occur at all.
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+
+    if (pData->fActive)
+        removeTimer(pData);
 
-    // copy the TimerArg after the timer is restarted,
-    // so that a timer occurred immediately before timer_settime
-    // won't use the new timerArg and
-    // therefore the old timer cannot be distinguished from the new one.
-    // But if the new timer is too fast, it may get lost.
     OPLK_MEMCPY(&pData->timerArgument, pArgument_p, sizeof(tTimerArg));
+    insertTimer(pData, timeInMs_p);
+
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
     return kErrorOk;
 }
@@ -406,9 +404,14 @@ tOplkError timeru_deleteTimer(tTimerHdl* pTimerHdl_p)
 
     pData = (tTimeruData*)*pTimerHdl_p;
 
-    timer_delete(pData->timer);
-    removeTimer(pData);
-    OPLK_FREE(pData);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+
+    if (pData->fActive)
+        removeTimer(pData);
+
+    freeTimer(pData);
+
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
     // uninitialize handle
     *pTimerHdl_p = 0;
@@ -432,7 +435,7 @@ This function checks if a timer is active (is running).
 BOOL timeru_isActive(tTimerHdl timerHdl_p)
 {
     const tTimeruData*  pData;
-    struct itimerspec   remaining;
+    BOOL                fActive;
 
     // check handle itself, i.e. was the handle initialized before
     if (timerHdl_p == 0)
@@ -441,13 +444,11 @@ BOOL timeru_isActive(tTimerHdl timerHdl_p)
     }
     pData = (const tTimeruData*)timerHdl_p;
 
-    // check if timer is running
-    timer_gettime(pData->timer, &remaining);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+    fActive = pData->fActive;
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
-    if ((remaining.it_value.tv_sec == 0) && (remaining.it_value.tv_nsec == 0))
-        return FALSE;
-    else
-        return TRUE;
+    return fActive;
 }
 
 //============================================================================//
@@ -461,7 +462,8 @@ BOOL timeru_isActive(tTimerHdl timerHdl_p)
 \brief  Timer thread function
 
 This function implements the timer thread function which will be started as
-thread and is responsible for processing expired timers.
+thread and is responsible for processing expired timers. It sleeps on the
+timerfd until the next occupied wheel slot is due.
 
 \param[in,out]  pArgument_p         Thread argument. Not used!
 
@@ -470,34 +472,40 @@ thread and is responsible for processing expired timers.
 //------------------------------------------------------------------------------
 static void* processThread(void* pArgument_p)
 {
-    tTimeruData*    pTimer;
-    sigset_t        awaitedSignal;
-    siginfo_t       signalInfo;
+    UINT64  expirations;
+    ssize_t readSize;
 
     UNUSED_PARAMETER(pArgument_p);
 
     DEBUG_LVL_TIMERU_TRACE("%s() ThreadId:%d\n", __func__, syscall(SYS_gettid));
 
-    sigemptyset(&awaitedSignal);
-    sigaddset(&awaitedSignal, SIGRTMIN);
-    pthread_sigmask(SIG_BLOCK, &awaitedSignal, NULL);
-
-    /* loop forever until thread will be canceled */
+    /* loop until the thread is stopped by timeru_exit() */
     while (1)
     {
-        if (sigwaitinfo(&awaitedSignal, &signalInfo) > 0)
+        readSize = read(timeruInstance_g.timerFd, &expirations, sizeof(expirations));
+        if ((readSize < 0) && (errno != EINTR))
         {
-            pTimer = (tTimeruData*)signalInfo.si_value.sival_ptr;
-            if (pTimer != NULL)
-                /* call callback function of timer */
-                cbTimer(pTimer);
-            else
-            {
-                DEBUG_LVL_ERROR_TRACE("%s() sival_ptr==NULL code=%d\n",
-                                      __func__,
-                                      signalInfo.si_code);
-            }
+            DEBUG_LVL_ERROR_TRACE("%s() Error reading timerfd! (%d)\n", __func__, errno);
+            break;
         }
+
+        pthread_mutex_lock(&timeruInstance_g.mutex);
+
+        if (timeruInstance_g.fStopThread)
+        {
+            pthread_mutex_unlock(&timeruInstance_g.mutex);
+            break;
+        }
+
+        // The timerfd is disarmed after its expiry
+        timeruInstance_g.armedTick = 0;
+
+        processExpiredTimers(getCurrentTick(FALSE));
+
+        timeruInstance_g.armedTick = getNextTick();
+        armTimerFd(timeruInstance_g.armedTick);
+
+        pthread_mutex_unlock(&timeruInstance_g.mutex);
     }
 
     DEBUG_LVL_TIMERU_TRACE("%s() Exiting!\n", __func__);
@@ -508,8 +516,8 @@ static void* processThread(void* pArgument_p)
 /**
 \brief  Timer callback function
 
-This function is registered if a timer is started and therefore will be called
-by the timer when it expires.
+This function is called by the timer thread for every expired timer. It posts
+the timer event to the event sink of the timer.
 
 \param[in]      pData_p             The user defined parameter supplied when starting
                                     the timer.
@@ -537,105 +545,298 @@ static void cbTimer(const tTimeruData* pData_p)
 
 //------------------------------------------------------------------------------
 /**
-\brief  Add a timer to the timer list
+\brief  Insert a timer into the timer wheel
 
-This function adds a new timer to the timer list.
+This function inserts a timer into the wheel slot of its expiry time. The
+timerfd is only rearmed if the timer expires before the currently armed time.
+The caller must hold the instance mutex.
 
 \param[in,out]  pData_p             Pointer to the timer structure.
+\param[in]      timeInMs_p          Timeout in milliseconds.
 */
 //------------------------------------------------------------------------------
-static void addTimer(tTimeruData* pData_p)
+static void insertTimer(tTimeruData* pData_p, ULONG timeInMs_p)
 {
-    tTimeruData*    pTimerData;
-
-    pthread_mutex_lock(&timeruInstance_g.mutex);
-
-    if (timeruInstance_g.pFirstTimer == NULL)
+    UINT        slot;
+
+    // Without any timer in the wheel no tick has to be processed, so the
+    // processing can start with the current time
+    if (timeruInstance_g.activeTimers == 0)
+        timeruInstance_g.lastTick = getCurrentTick(FALSE);
+
+    // Round up the current time so that the timeout is never shortened
+    pData_p->expiryTick = getCurrentTick(TRUE) + timeInMs_p;
+    if (pData_p->expiryTick <= timeruInstance_g.lastTick)
+        pData_p->expiryTick = timeruInstance_g.lastTick + 1;
+
+    slot = (UINT)(pData_p->expiryTick & TIMERU_WHEEL_MASK);
+    pData_p->pPrevTimer = NULL;
+    pData_p->pNextTimer = timeruInstance_g.apSlot[slot];
+    if (pData_p->pNextTimer != NULL)
+        pData_p->pNextTimer->pPrevTimer = pData_p;
+    timeruInstance_g.apSlot[slot] = pData_p;
+    timeruInstance_g.aSlotMap[slot / 64] |= (1ULL << (slot % 64));
+
+    pData_p->fActive = TRUE;
+    timeruInstance_g.activeTimers++;
+
+    if ((timeruInstance_g.armedTick == 0) ||
+        (pData_p->expiryTick < timeruInstance_g.armedTick))
     {
-        timeruInstance_g.pFirstTimer = pData_p;
-        timeruInstance_g.pLastTimer = pData_p;
-        pData_p->pPrevTimer = NULL;
-        pData_p->pNextTimer = NULL;
+        timeruInstance_g.armedTick = pData_p->expiryTick;
+        armTimerFd(timeruInstance_g.armedTick);
     }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove a timer from the timer wheel
+
+This function removes a timer from its wheel slot. The timerfd isn't touched,
+an obsolete wakeup just rearms it for the next occupied slot. The caller must
+hold the instance mutex.
+
+\param[in,out]  pData_p             Pointer to the timer structure.
+*/
+//------------------------------------------------------------------------------
+static void removeTimer(tTimeruData* pData_p)
+{
+    UINT        slot;
+
+    slot = (UINT)(pData_p->expiryTick & TIMERU_WHEEL_MASK);
+
+    if (pData_p->pPrevTimer == NULL)
+        timeruInstance_g.apSlot[slot] = pData_p->pNextTimer;
     else
+        pData_p->pPrevTimer->pNextTimer = pData_p->pNextTimer;
+
+    if (pData_p->pNextTimer != NULL)
+        pData_p->pNextTimer->pPrevTimer = pData_p->pPrevTimer;
+
+    if (timeruInstance_g.apSlot[slot] == NULL)
+        timeruInstance_g.aSlotMap[slot / 64] &= ~(1ULL << (slot % 64));
+
+    pData_p->pNextTimer = NULL;
+    pData_p->pPrevTimer = NULL;
+    pData_p->fActive = FALSE;
+    timeruInstance_g.activeTimers--;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process expired timers
+
+This function processes all wheel slots from the last processed tick up to the
+current tick. Every slot is visited at most once. The timers of a slot which
+are due are removed from the wheel and their events are posted. Timers of later
+wheel rounds stay in the slot. The caller must hold the instance mutex.
+
+\param[in]      currentTick_p       Current tick of the monotonic clock.
+*/
+//------------------------------------------------------------------------------
+static void processExpiredTimers(ULONGLONG currentTick_p)
+{
+    ULONGLONG       tick;
+    UINT            slotCount;
+    tTimeruData*    pTimer;
+    tTimeruData*    pNextTimer;
+
+    for (tick = timeruInstance_g.lastTick + 1, slotCount = 0;
+         (tick <= currentTick_p) && (slotCount < TIMERU_WHEEL_SLOTS);
+         tick++, slotCount++)
     {
-        pTimerData = timeruInstance_g.pLastTimer;
-        pTimerData->pNextTimer = pData_p;
-        pData_p->pPrevTimer = pTimerData;
-        pData_p->pNextTimer = NULL;
-        timeruInstance_g.pLastTimer = pData_p;
+        for (pTimer = timeruInstance_g.apSlot[tick & TIMERU_WHEEL_MASK];
+             pTimer != NULL;
+             pTimer = pNextTimer)
+        {
+            pNextTimer = pTimer->pNextTimer;
+            if (pTimer->expiryTick <= currentTick_p)
+            {
+                removeTimer(pTimer);
+                cbTimer(pTimer);
+            }
+        }
     }
 
-    pthread_mutex_unlock(&timeruInstance_g.mutex);
+    if (currentTick_p > timeruInstance_g.lastTick)
+        timeruInstance_g.lastTick = currentTick_p;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Remove a timer from the timer list
+\brief  Get the next tick to wake up for
 
-This function removes a new timer from the timer list.
+This function searches the occupancy map for the next occupied wheel slot after
+the last processed tick. The returned tick may be earlier than the expiry time
+of the timers in that slot if they belong to a later wheel round. The caller
+must hold the instance mutex.
 
-\param[in,out]  pData_p             Pointer to the timer structure.
+\return The function returns the next tick to wake up for or 0 if the wheel
+        is empty.
 */
 //------------------------------------------------------------------------------
-static void removeTimer(tTimeruData* pData_p)
+static ULONGLONG getNextTick(void)
 {
-    tTimeruData*    pTimerData;
+    UINT        startSlot;
+    UINT        word;
+    UINT        slot;
+    UINT        i;
+    ULONGLONG   slotMap;
 
-    pthread_mutex_lock(&timeruInstance_g.mutex);
+    if (timeruInstance_g.activeTimers == 0)
+        return 0;
 
-    if (pData_p->pPrevTimer == NULL)          // first one
+    startSlot = (UINT)((timeruInstance_g.lastTick + 1) & TIMERU_WHEEL_MASK);
+
+    // The word of the start slot is visited twice: first from the start slot
+    // to its end and, after wrapping around, up to the start slot
+    for (i = 0; i <= TIMERU_WHEEL_MAP_WORDS; i++)
     {
-        timeruInstance_g.pFirstTimer = pData_p->pNextTimer;
-        pTimerData = pData_p->pNextTimer;
-        if (pTimerData != NULL)
-            pTimerData->pPrevTimer = NULL;
+        word = ((startSlot / 64) + i) % TIMERU_WHEEL_MAP_WORDS;
+        slotMap = timeruInstance_g.aSlotMap[word];
+        if (i == 0)
+            slotMap &= (~0ULL << (startSlot % 64));
+        else if (i == TIMERU_WHEEL_MAP_WORDS)
+            slotMap &= ~(~0ULL << (startSlot % 64));
+
+        if (slotMap != 0)
+        {
+            slot = (word * 64) + (UINT)__builtin_ctzll(slotMap);
+            return timeruInstance_g.lastTick + 1 + ((slot - startSlot) & TIMERU_WHEEL_MASK);
+        }
     }
-    else if (pData_p->pNextTimer == NULL)     // last one
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Arm the timerfd
+
+This function arms the timerfd for the absolute time of the given tick.
+
+\param[in]      tick_p              Tick to arm the timerfd for. 0 disarms it.
+*/
+//------------------------------------------------------------------------------
+static void armTimerFd(ULONGLONG tick_p)
+{
+    struct itimerspec   timerSpec;
+
+    timerSpec.it_interval.tv_sec = 0;
+    timerSpec.it_interval.tv_nsec = 0;
+    timerSpec.it_value.tv_sec = (time_t)(tick_p / 1000);
+    timerSpec.it_value.tv_nsec = (long)(tick_p % 1000) * 1000000;
+
+    if (timerfd_settime(timeruInstance_g.timerFd, TFD_TIMER_ABSTIME, &timerSpec, NULL) != 0)
     {
-        timeruInstance_g.pLastTimer = pData_p->pPrevTimer;
-        pTimerData = pData_p->pPrevTimer;
-        pTimerData->pNextTimer = NULL;
+        DEBUG_LVL_ERROR_TRACE("%s() Error timerfd_settime! (%d)\n", __func__, errno);
     }
-    else
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the current tick
+
+This function returns the current time of the monotonic clock in milliseconds.
+
+\param[in]      fRoundUp_p          Round up to the next full millisecond.
+
+\return The function returns the current tick.
+*/
+//------------------------------------------------------------------------------
+static ULONGLONG getCurrentTick(BOOL fRoundUp_p)
+{
+    struct timespec currentTime;
+    ULONGLONG       tick;
+
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    tick = ((ULONGLONG)currentTime.tv_sec * 1000) + (currentTime.tv_nsec / 1000000);
+    if (fRoundUp_p && ((currentTime.tv_nsec % 1000000) != 0))
+        tick++;
+
+    return tick;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate a timer entry
+
+This function takes a timer entry from the free list. If the free list is
+empty, a new block of timer entries is allocated. The caller must hold the
+instance mutex.
+
+\return The function returns a pointer to the timer entry or NULL if no memory
+        is available.
+*/
+//------------------------------------------------------------------------------
+static tTimeruData* allocTimer(void)
+{
+    tTimeruPoolBlock*   pBlock;
+    tTimeruData*        pData;
+    UINT                index;
+
+    if (timeruInstance_g.pFreeTimer == NULL)
     {
-        pData_p->pPrevTimer->pNextTimer = pData_p->pNextTimer;
-        pData_p->pNextTimer->pPrevTimer = pData_p->pPrevTimer;
+        pBlock = (tTimeruPoolBlock*)OPLK_MALLOC(sizeof(tTimeruPoolBlock));
+        if (pBlock == NULL)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() Couldn't allocate timer entries!\n", __func__);
+            return NULL;
+        }
+
+        OPLK_MEMSET(pBlock, 0, sizeof(tTimeruPoolBlock));
+        for (index = 0; index < TIMERU_POOL_BLOCK_ENTRIES; index++)
+            freeTimer(&pBlock->aTimer[index]);
+
+        pBlock->pNextBlock = timeruInstance_g.pFirstBlock;
+        timeruInstance_g.pFirstBlock = pBlock;
     }
 
-    pthread_mutex_unlock(&timeruInstance_g.mutex);
+    pData = timeruInstance_g.pFreeTimer;
+    timeruInstance_g.pFreeTimer = pData->pNextTimer;
+    pData->pNextTimer = NULL;
+
+    return pData;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Reset the timer list
+\brief  Free a timer entry
 
-This function resets the timer list.
+This function puts a timer entry back to the free list. The caller must hold
+the instance mutex.
+
+\param[in,out]  pData_p             Pointer to the timer entry.
 */
 //------------------------------------------------------------------------------
-static void resetTimerList(void)
+static void freeTimer(tTimeruData* pData_p)
 {
-    timeruInstance_g.pCurrentTimer = timeruInstance_g.pFirstTimer;
+    pData_p->fActive = FALSE;
+    pData_p->pPrevTimer = NULL;
+    pData_p->pNextTimer = timeruInstance_g.pFreeTimer;
+    timeruInstance_g.pFreeTimer = pData_p;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Get next timer from the list
-
-This function gets the next timer from the timer list.
+\brief  Free the timer entry pool
 
-\return     The function returns a pointer to the next timer in the timer list.
+This function frees all allocated blocks of timer entries.
 */
 //------------------------------------------------------------------------------
-static tTimeruData* getNextTimer(void)
+static void freeTimerPool(void)
 {
-    tTimeruData*    pTimer;
+    tTimeruPoolBlock*   pBlock;
 
-    pTimer = timeruInstance_g.pCurrentTimer;
-    if (pTimer != NULL)
-        timeruInstance_g.pCurrentTimer = pTimer->pNextTimer;
+    while (timeruInstance_g.pFirstBlock != NULL)
+    {
+        pBlock = timeruInstance_g.pFirstBlock;
+        timeruInstance_g.pFirstBlock = pBlock->pNextBlock;
+        OPLK_FREE(pBlock);
+    }
 
-    return pTimer;
+    timeruInstance_g.pFreeTimer = NULL;
 }
 
 /// \}
@@ -76,6 +76,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static UINT32                   syncSeq_l = 0;
+
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
 static tTimesyncSharedMemory*   pSharedMemory_l = NULL;
 #endif
@@ -108,6 +110,8 @@ tOplkError timesyncu_init(tSyncCb pfnSyncCb_p)
 {
     tOplkError  ret;
 
+    syncSeq_l = 0;
+
     ret = timesyncucal_init(pfnSyncCb_p);
     if (ret != kErrorOk)
         return ret;
@@ -138,6 +142,52 @@ void timesyncu_exit(void)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for a sync event
+
+The function waits for a sync event and provides the information about it. If
+the CAL doesn't signal sync events with a sequence number, the sequence number
+counts the received sync events, no missed sync events are reported and the
+SoC time is invalid.
+
+\param[in]      timeout_p           Specifies a timeout in microseconds. If 0 it waits
+                                    forever.
+\param[out]     pSyncInfo_p         Pointer to store the sync event information.
+                                    It can be NULL if the information isn't needed.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesyncu
+*/
+//------------------------------------------------------------------------------
+tOplkError timesyncu_waitSyncEvent(ULONG timeout_p,
+                                   tOplkApiSyncEventInfo* pSyncInfo_p)
+{
+    tOplkError          ret;
+    tTimesyncSyncEvent  syncEvent;
+
+    OPLK_MEMSET(&syncEvent, 0, sizeof(syncEvent));
+    syncEvent.syncSeq = syncSeq_l + 1;
+
+    ret = timesyncucal_waitSyncEvent(timeout_p, &syncEvent);
+    if (ret != kErrorOk)
+        return ret;
+
+    syncSeq_l = syncEvent.syncSeq;
+
+    if (pSyncInfo_p != NULL)
+    {
+        pSyncInfo_p->syncSeq = syncEvent.syncSeq;
+        pSyncInfo_p->missedCount = syncEvent.missedCount;
+        pSyncInfo_p->socTime.fValidRelTime = (syncEvent.socTime.fRelTimeValid != 0);
+        pSyncInfo_p->socTime.relTime = syncEvent.socTime.relTime;
+        pSyncInfo_p->socTime.netTime = syncEvent.socTime.netTime;
+    }
+
+    return kErrorOk;
+}
+
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
 //------------------------------------------------------------------------------
 /**
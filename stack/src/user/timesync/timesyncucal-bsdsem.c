@@ -141,6 +141,8 @@ The function waits for a sync event.
 
 \param[in]      timeout_p           Specifies a timeout in microseconds. If 0 it waits
                                     forever.
+\param[in,out]  pSyncEvent_p        Information about the received sync event. It
+                                    isn't modified by this implementation.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Successfully received sync event
@@ -149,12 +151,15 @@ The function waits for a sync event.
 \ingroup module_timesyncucal
 */
 //------------------------------------------------------------------------------
-tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p)
+tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p,
+                                      tTimesyncSyncEvent* pSyncEvent_p)
 {
     int                 semRet;
     struct timespec     currentTime;
     struct timespec     semTimeout;
 
+    UNUSED_PARAMETER(pSyncEvent_p);
+
     if (timeout_p != 0)
     {
         if (timeout_p >= 1000000)
@@ -0,0 +1,374 @@
+/**
+********************************************************************************
+\file   timesyncucal-futex.c
+
+\brief  Sync implementation for the user CAL timesync module using futexes
+
+This file contains a sync implementation for the user CAL timesync module. The
+kernel layer counts the sync events with a sequence number in a shared memory
+segment. A waiting thread compares it with the last processed sequence number,
+so it always continues with the latest sync event and detects missed ones. If
+no new sync event is available, it optionally busy-polls the sequence number
+for a bounded time and then sleeps on it with a futex.
+
+\ingroup module_timesyncucal
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/timesync.h>
+#include <user/timesyncucal.h>
+
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef CONFIG_TIMESYNC_BUSY_POLL_TIME
+#define CONFIG_TIMESYNC_BUSY_POLL_TIME      0               // Busy-poll time before sleeping on the next sync event [ns]
+#endif
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief User CAL timesync instance
+
+The structure contains the instance data of the user CAL timesync module.
+*/
+typedef struct
+{
+    int                     fd;             ///< File descriptor of the sync event shared memory
+    tTimesyncSyncMemory*    pSyncMem;       ///< Sync event shared memory
+    UINT32                  syncSeq;        ///< Sequence number of the last processed sync event
+    UINT64                  pollTime;       ///< Busy-poll time before sleeping on the next sync event [ns]
+} tTimesyncuCalInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTimesyncuCalInstance    instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static UINT64     getMonotonicTime(void);
+static tOplkError waitSyncSeq(UINT64 deadline_p);
+static BOOL       pollSyncSeq(UINT64 deadline_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize user CAL timesync module
+
+The function initializes the user CAL timesync module. It maps the sync event
+shared memory which was created by the kernel layer.
+
+\param[in]      pfnSyncCb_p         Function that is called in case of sync event
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesyncucal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesyncucal_init(tSyncCb pfnSyncCb_p)
+{
+    void*       pMem;
+    cpu_set_t   cpuSet;
+
+    UNUSED_PARAMETER(pfnSyncCb_p);
+
+    OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
+
+    instance_l.fd = shm_open(TIMESYNC_SYNC_SHM, O_RDWR, 0);
+    if (instance_l.fd == -1)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() opening shared memory failed!\n", __func__);
+        return kErrorNoResource;
+    }
+
+    pMem = mmap(NULL,
+                sizeof(tTimesyncSyncMemory),
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED,
+                instance_l.fd,
+                0);
+    if (pMem == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mmap failed!\n", __func__);
+        close(instance_l.fd);
+        return kErrorNoResource;
+    }
+
+    instance_l.pSyncMem = (tTimesyncSyncMemory*)pMem;
+
+    // Sync events before the initialization are not reported as missed
+    instance_l.syncSeq = __atomic_load_n(&instance_l.pSyncMem->syncSeq, __ATOMIC_ACQUIRE);
+
+    // Busy-polling on a single CPU would delay the kernel layer which sends
+    // the sync event, so the application only sleeps.
+    instance_l.pollTime = CONFIG_TIMESYNC_BUSY_POLL_TIME;
+    if ((sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0) && (CPU_COUNT(&cpuSet) < 2))
+        instance_l.pollTime = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up user CAL timesync module
+
+The function cleans up the user CAL timesync module
+
+\ingroup module_timesyncucal
+*/
+//------------------------------------------------------------------------------
+void timesyncucal_exit(void)
+{
+    if (instance_l.pSyncMem == NULL)
+        return;
+
+    munmap(instance_l.pSyncMem, sizeof(tTimesyncSyncMemory));
+    instance_l.pSyncMem = NULL;
+
+    close(instance_l.fd);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for a sync event
+
+The function waits for a sync event. If sync events occurred since the last
+call, it returns immediately with the latest one. Otherwise it busy-polls for
+CONFIG_TIMESYNC_BUSY_POLL_TIME (not on single CPU systems) and then sleeps
+until the next sync event.
+
+\param[in]      timeout_p           Specifies a timeout in microseconds. If 0 it waits
+                                    forever.
+\param[in,out]  pSyncEvent_p        Information about the received sync event.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    Successfully received sync event
+\retval kErrorGeneralError          Error or timeout while waiting on sync event
+
+\ingroup module_timesyncucal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p,
+                                      tTimesyncSyncEvent* pSyncEvent_p)
+{
+    tTimesyncSyncMemory*    pSyncMem = instance_l.pSyncMem;
+    tOplkError              ret;
+    UINT32                  syncSeq;
+    UINT64                  deadline = 0;
+
+    // Check parameter validity
+    ASSERT(pSyncEvent_p != NULL);
+
+    if (pSyncMem == NULL)
+        return kErrorNoResource;
+
+    if (__atomic_load_n(&pSyncMem->syncSeq, __ATOMIC_ACQUIRE) == instance_l.syncSeq)
+    {
+        if (timeout_p != 0)
+            deadline = getMonotonicTime() + ((UINT64)timeout_p * 1000ULL);
+
+        ret = waitSyncSeq(deadline);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    // Read the SoC time of the latest sync event. It is read again if the next
+    // sync event was sent meanwhile, because its buffer might be overwritten.
+    do
+    {
+        syncSeq = __atomic_load_n(&pSyncMem->syncSeq, __ATOMIC_ACQUIRE);
+        OPLK_MEMCPY(&pSyncEvent_p->socTime, &pSyncMem->aSocTime[syncSeq & 1], sizeof(tTimesyncSocTime));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&pSyncMem->syncSeq, __ATOMIC_RELAXED) != syncSeq);
+
+    pSyncEvent_p->syncSeq = syncSeq;
+    pSyncEvent_p->missedCount = syncSeq - instance_l.syncSeq - 1;
+    instance_l.syncSeq = syncSeq;
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+\return The function returns the time of CLOCK_MONOTONIC in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getMonotonicTime(void)
+{
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for a new sequence number
+
+The function waits until the sequence number in the shared memory differs from
+the last processed one. It busy-polls first and then sleeps on the sequence
+number with a futex.
+
+\param[in]      deadline_p          Absolute deadline of the wait (CLOCK_MONOTONIC)
+                                    [ns]. If 0 it waits forever.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    A new sync event is available
+\retval kErrorGeneralError          Error or timeout while waiting on sync event
+*/
+//------------------------------------------------------------------------------
+static tOplkError waitSyncSeq(UINT64 deadline_p)
+{
+    tTimesyncSyncMemory*    pSyncMem = instance_l.pSyncMem;
+    struct timespec         futexTimeout;
+    int                     futexRet;
+    int                     futexErrno;
+
+    if ((instance_l.pollTime != 0) && pollSyncSeq(deadline_p))
+        return kErrorOk;
+
+    futexTimeout.tv_sec = (time_t)(deadline_p / 1000000000ULL);
+    futexTimeout.tv_nsec = (long)(deadline_p % 1000000000ULL);
+
+    while (__atomic_load_n(&pSyncMem->syncSeq, __ATOMIC_ACQUIRE) == instance_l.syncSeq)
+    {
+        // The kernel layer only issues a wake-up system call if a thread
+        // is registered as waiter. The futex system call returns immediately
+        // if the sequence number has changed meanwhile.
+        __atomic_add_fetch(&pSyncMem->waiterCount, 1, __ATOMIC_SEQ_CST);
+        futexRet = (int)syscall(SYS_futex,
+                                &pSyncMem->syncSeq,
+                                FUTEX_WAIT_BITSET,
+                                instance_l.syncSeq,
+                                (deadline_p != 0) ? &futexTimeout : NULL,
+                                NULL,
+                                FUTEX_BITSET_MATCH_ANY);
+        futexErrno = errno;
+        __atomic_sub_fetch(&pSyncMem->waiterCount, 1, __ATOMIC_SEQ_CST);
+
+        if ((futexRet != 0) && (futexErrno != EAGAIN) && (futexErrno != EINTR))
+        {
+            if (__atomic_load_n(&pSyncMem->syncSeq, __ATOMIC_ACQUIRE) != instance_l.syncSeq)
+                break;
+
+            if (futexErrno != ETIMEDOUT)
+            {
+                DEBUG_LVL_ERROR_TRACE("%s() futex wait failed (%d)!\n", __func__, futexErrno);
+            }
+
+            return kErrorGeneralError;
+        }
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Busy-poll for a new sequence number
+
+The function polls the sequence number in the shared memory for the busy-poll
+time or until the deadline, whichever comes first.
+This avoids the wake-up latency of the futex if the next sync event is
+expected soon.
+
+\param[in]      deadline_p          Absolute deadline of the wait (CLOCK_MONOTONIC)
+                                    [ns]. If 0 it waits forever.
+
+\return The function returns TRUE if a new sync event is available.
+*/
+//------------------------------------------------------------------------------
+static BOOL pollSyncSeq(UINT64 deadline_p)
+{
+    UINT64  pollEnd;
+
+    pollEnd = getMonotonicTime() + instance_l.pollTime;
+    if ((deadline_p != 0) && (deadline_p < pollEnd))
+        pollEnd = deadline_p;
+
+    do
+    {
+        if (__atomic_load_n(&instance_l.pSyncMem->syncSeq, __ATOMIC_ACQUIRE) != instance_l.syncSeq)
+            return TRUE;
+    } while (getMonotonicTime() < pollEnd);
+
+    return FALSE;
+}
+
+/// \}
@@ -208,6 +208,8 @@ The function waits for a sync event.
 
 \param[in]      timeout_p           Specifies a timeout in microseconds. If 0 it waits
                                     forever.
+\param[in,out]  pSyncEvent_p        Information about the received sync event. It
+                                    isn't modified by this implementation.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Successfully received sync event
@@ -216,9 +218,11 @@ The function waits for a sync event.
 \ingroup module_timesyncucal
 */
 //------------------------------------------------------------------------------
-tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p)
+tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p,
+                                      tTimesyncSyncEvent* pSyncEvent_p)
 {
     UNUSED_PARAMETER(timeout_p);
+    UNUSED_PARAMETER(pSyncEvent_p);
 
     return kErrorOk;
 }
@@ -0,0 +1,128 @@
+/**
+********************************************************************************
+\file   outofline.c
+
+\brief  Workloads with the out-of-line AMI functions
+
+This file compiles the workloads of the unit tests with the out-of-line AMI
+functions of the architecture specific implementation.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#define AMI_OUT_OF_LINE
+#include <common/oplkinc.h>
+#include <common/ami.h>
+
+#include "test-ami.h"
+#include "workload.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run the frame workload with the out-of-line functions
+
+\param[in,out]  pFrame_p            Pointer to the frame.
+\param[in]      frameSize_p         Size of the frame.
+\param[in]      rounds_p            Number of runs over the frame.
+
+\return The function returns the sum of all read values.
+*/
+//------------------------------------------------------------------------------
+UINT64 outofline_runFrameWorkload(UINT8* pFrame_p, UINT frameSize_p, UINT rounds_p)
+{
+    return runFrameWorkload(pFrame_p, frameSize_p, rounds_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy 32 bit variables into a PDO payload with the out-of-line functions
+
+The workload converts the variables one by one as done for single mapped
+objects.
+
+\param[out]     pPayload_p          Pointer to the PDO payload.
+\param[in]      pVar_p              Pointer to the variables.
+\param[in]      count_p             Number of variables.
+\param[in]      rounds_p            Number of copies.
+*/
+//------------------------------------------------------------------------------
+void outofline_setArrayWorkload(UINT8* pPayload_p, const UINT32* pVar_p, UINT count_p, UINT rounds_p)
+{
+    UINT    round;
+    UINT    i;
+
+    for (round = 0; round < rounds_p; round++)
+    {
+        for (i = 0; i < count_p; i++)
+            ami_setUint32Le(pPayload_p + (i * 4), pVar_p[i] + round);
+    }
+}
@@ -0,0 +1,441 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the abstract memory interface
+
+This file contains the unit tests of the inline abstract memory interface.
+Besides the functional tests, it compares the inline functions with the
+out-of-line implementation of the architecture and prints the speed of both.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <common/ami.h>
+
+#include "test-ami.h"
+#include "workload.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_FRAME_SIZE                 1500
+#define TEST_FRAME_ROUNDS               10000
+#define TEST_PDO_VARS                   256
+#define TEST_PDO_ROUNDS                 200000
+#define TEST_GUARD                      0xAA
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void   fillRandom(UINT8* pBuffer_p, size_t size_p);
+static BOOL   checkGuard(const UINT8* pBuffer_p, size_t offset_p, size_t size_p);
+static double getTime(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const UINT8  aPattern_l[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the little endian conversion functions
+
+The test reads and writes all data types at an unaligned address.
+*/
+//------------------------------------------------------------------------------
+void test_ami_valuesLe(void)
+{
+    UINT8       aBuffer[16];
+    UINT8*      pAddr = &aBuffer[1];
+    tTimeOfDay  timeOfDay;
+
+    memcpy(pAddr, aPattern_l, sizeof(aPattern_l));
+
+    CU_ASSERT_EQUAL(ami_getUint8Le(pAddr), 0x01);
+    CU_ASSERT_EQUAL(ami_getUint16Le(pAddr), 0x0201);
+    CU_ASSERT_EQUAL(ami_getUint24Le(pAddr), 0x030201);
+    CU_ASSERT_EQUAL(ami_getUint32Le(pAddr), 0x04030201);
+    CU_ASSERT_EQUAL(ami_getUint40Le(pAddr), 0x0504030201ULL);
+    CU_ASSERT_EQUAL(ami_getUint48Le(pAddr), 0x060504030201ULL);
+    CU_ASSERT_EQUAL(ami_getUint56Le(pAddr), 0x07060504030201ULL);
+    CU_ASSERT_EQUAL(ami_getUint64Le(pAddr), 0x0807060504030201ULL);
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint16Le(pAddr, 0x0201);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 2), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 2));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint24Le(pAddr, 0xFF030201);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 3), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 3));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint32Le(pAddr, 0x04030201);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 4), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 4));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint40Le(pAddr, 0xFFFFFF0504030201ULL);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 5), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 5));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint48Le(pAddr, 0xFFFF060504030201ULL);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 6), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 6));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint56Le(pAddr, 0xFF07060504030201ULL);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 7), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 7));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint64Le(pAddr, 0x0807060504030201ULL);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 8), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 8));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    timeOfDay.msec = 0xF4030201;
+    timeOfDay.days = 0x0605;
+    ami_setTimeOfDay(pAddr, &timeOfDay);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 6), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 6));
+
+    ami_getTimeOfDay(pAddr, &timeOfDay);
+    CU_ASSERT_EQUAL(timeOfDay.msec, 0x04030201);
+    CU_ASSERT_EQUAL(timeOfDay.days, 0x0605);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the big endian conversion functions
+
+The test reads and writes all data types at an unaligned address.
+*/
+//------------------------------------------------------------------------------
+void test_ami_valuesBe(void)
+{
+    UINT8   aBuffer[16];
+    UINT8*  pAddr = &aBuffer[1];
+
+    memcpy(pAddr, aPattern_l, sizeof(aPattern_l));
+
+    CU_ASSERT_EQUAL(ami_getUint8Be(pAddr), 0x01);
+    CU_ASSERT_EQUAL(ami_getUint16Be(pAddr), 0x0102);
+    CU_ASSERT_EQUAL(ami_getUint24Be(pAddr), 0x010203);
+    CU_ASSERT_EQUAL(ami_getUint32Be(pAddr), 0x01020304);
+    CU_ASSERT_EQUAL(ami_getUint40Be(pAddr), 0x0102030405ULL);
+    CU_ASSERT_EQUAL(ami_getUint48Be(pAddr), 0x010203040506ULL);
+    CU_ASSERT_EQUAL(ami_getUint56Be(pAddr), 0x01020304050607ULL);
+    CU_ASSERT_EQUAL(ami_getUint64Be(pAddr), 0x0102030405060708ULL);
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint16Be(pAddr, 0x0102);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 2), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 2));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint24Be(pAddr, 0xFF010203);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 3), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 3));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint32Be(pAddr, 0x01020304);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 4), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 4));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint40Be(pAddr, 0xFFFFFF0102030405ULL);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 5), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 5));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint48Be(pAddr, 0xFFFF010203040506ULL);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 6), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 6));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint56Be(pAddr, 0xFF01020304050607ULL);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 7), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 7));
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint64Be(pAddr, 0x0102030405060708ULL);
+    CU_ASSERT_EQUAL(memcmp(pAddr, aPattern_l, 8), 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 8));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the array conversion functions
+
+The test converts arrays of all sizes to an unaligned buffer and back and
+checks the values in the buffer with the single value functions.
+*/
+//------------------------------------------------------------------------------
+void test_ami_arrays(void)
+{
+    UINT8   aBuffer[8 * 16 + 2];
+    UINT8*  pAddr = &aBuffer[1];
+    UINT16  aVal16[16];
+    UINT32  aVal32[16];
+    UINT64  aVal64[16];
+    UINT16  aRes16[16];
+    UINT32  aRes32[16];
+    UINT64  aRes64[16];
+    UINT    i;
+
+    for (i = 0; i < 16; i++)
+    {
+        aVal16[i] = (UINT16)(0x0102 * (i + 1));
+        aVal32[i] = 0x01020304 * (i + 1);
+        aVal64[i] = 0x0102030405060708ULL * (i + 1);
+    }
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint16ArrayLe(pAddr, aVal16, 16);
+    for (i = 0; i < 16; i++)
+        CU_ASSERT_EQUAL(ami_getUint16Le(pAddr + (i * 2)), aVal16[i]);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 16 * 2));
+    ami_getUint16ArrayLe(pAddr, aRes16, 16);
+    CU_ASSERT_EQUAL(memcmp(aRes16, aVal16, sizeof(aVal16)), 0);
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint32ArrayLe(pAddr, aVal32, 16);
+    for (i = 0; i < 16; i++)
+        CU_ASSERT_EQUAL(ami_getUint32Le(pAddr + (i * 4)), aVal32[i]);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 16 * 4));
+    ami_getUint32ArrayLe(pAddr, aRes32, 16);
+    CU_ASSERT_EQUAL(memcmp(aRes32, aVal32, sizeof(aVal32)), 0);
+
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint64ArrayLe(pAddr, aVal64, 16);
+    for (i = 0; i < 16; i++)
+        CU_ASSERT_EQUAL(ami_getUint64Le(pAddr + (i * 8)), aVal64[i]);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 16 * 8));
+    ami_getUint64ArrayLe(pAddr, aRes64, 16);
+    CU_ASSERT_EQUAL(memcmp(aRes64, aVal64, sizeof(aVal64)), 0);
+
+    // An empty array must not touch the buffer
+    memset(aBuffer, TEST_GUARD, sizeof(aBuffer));
+    ami_setUint32ArrayLe(pAddr, aVal32, 0);
+    CU_ASSERT_TRUE(checkGuard(aBuffer, 1, 0));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the inline with the out-of-line implementation
+
+The test runs the frame workload with both implementations on the same random
+frame and compares the results.
+*/
+//------------------------------------------------------------------------------
+void test_ami_compareOutOfLine(void)
+{
+    UINT8   aFrameInline[TEST_FRAME_SIZE];
+    UINT8   aFrameOutOfLine[TEST_FRAME_SIZE];
+    UINT32  aVar[TEST_PDO_VARS];
+    UINT8   aPayloadInline[TEST_PDO_VARS * 4];
+    UINT8   aPayloadOutOfLine[TEST_PDO_VARS * 4];
+    UINT64  sumInline;
+    UINT64  sumOutOfLine;
+
+    srand(1);
+    fillRandom(aFrameInline, sizeof(aFrameInline));
+    memcpy(aFrameOutOfLine, aFrameInline, sizeof(aFrameOutOfLine));
+
+    sumInline = runFrameWorkload(aFrameInline, sizeof(aFrameInline), 20);
+    sumOutOfLine = outofline_runFrameWorkload(aFrameOutOfLine, sizeof(aFrameOutOfLine), 20);
+
+    CU_ASSERT_EQUAL(sumInline, sumOutOfLine);
+    CU_ASSERT_EQUAL(memcmp(aFrameInline, aFrameOutOfLine, sizeof(aFrameInline)), 0);
+
+    fillRandom((UINT8*)aVar, sizeof(aVar));
+    ami_setUint32ArrayLe(aPayloadInline, aVar, TEST_PDO_VARS);
+    outofline_setArrayWorkload(aPayloadOutOfLine, aVar, TEST_PDO_VARS, 1);
+
+    CU_ASSERT_EQUAL(memcmp(aPayloadInline, aPayloadOutOfLine, sizeof(aPayloadInline)), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the speed of the inline and the out-of-line implementation
+
+The test measures the frame workload and the copying of 32 bit variables into
+a PDO payload. The out-of-line implementation copies the variables one by
+one, the inline implementation uses the array function.
+*/
+//------------------------------------------------------------------------------
+void test_ami_benchmark(void)
+{
+    static UINT8    aFrame[TEST_FRAME_SIZE];
+    static UINT32   aVar[TEST_PDO_VARS];
+    static UINT8    aPayload[TEST_PDO_VARS * 4];
+    double          startTime;
+    double          frameInline;
+    double          frameOutOfLine;
+    double          pdoInline;
+    double          pdoOutOfLine;
+    UINT64          sumInline;
+    UINT64          sumOutOfLine;
+    UINT            accessCount;
+    UINT            round;
+    UINT            i;
+
+    srand(2);
+    fillRandom(aFrame, sizeof(aFrame));
+    startTime = getTime();
+    sumInline = runFrameWorkload(aFrame, sizeof(aFrame), TEST_FRAME_ROUNDS);
+    frameInline = getTime() - startTime;
+
+    srand(2);
+    fillRandom(aFrame, sizeof(aFrame));
+    startTime = getTime();
+    sumOutOfLine = outofline_runFrameWorkload(aFrame, sizeof(aFrame), TEST_FRAME_ROUNDS);
+    frameOutOfLine = getTime() - startTime;
+
+    CU_ASSERT_EQUAL(sumInline, sumOutOfLine);
+
+    fillRandom((UINT8*)aVar, sizeof(aVar));
+    startTime = getTime();
+    for (round = 0; round < TEST_PDO_ROUNDS; round++)
+    {
+        aVar[round % TEST_PDO_VARS]++;
+        ami_setUint32ArrayLe(aPayload, aVar, TEST_PDO_VARS);
+    }
+    pdoInline = getTime() - startTime;
+
+    startTime = getTime();
+    outofline_setArrayWorkload(aPayload, aVar, TEST_PDO_VARS, TEST_PDO_ROUNDS);
+    pdoOutOfLine = getTime() - startTime;
+
+    for (i = 0; i < TEST_PDO_VARS; i++)
+        CU_ASSERT_EQUAL(ami_getUint32Le(&aPayload[i * 4]), aVar[i] + TEST_PDO_ROUNDS - 1);
+
+    // 16 reads and up to 3 writes per field
+    accessCount = ((TEST_FRAME_SIZE - WORKLOAD_FIELD_SIZE) / WORKLOAD_STRIDE) * 16 * TEST_FRAME_ROUNDS;
+    printf("\n    frame fields: inline %.2f ns/access, out-of-line %.2f ns/access\n",
+           frameInline * 1e9 / accessCount, frameOutOfLine * 1e9 / accessCount);
+    printf("    PDO of %u UINT32: inline %.1f ns/PDO, out-of-line %.1f ns/PDO\n",
+           TEST_PDO_VARS,
+           pdoInline * 1e9 / TEST_PDO_ROUNDS, pdoOutOfLine * 1e9 / TEST_PDO_ROUNDS);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill a buffer with random data
+
+\param[out]     pBuffer_p           Pointer to the buffer.
+\param[in]      size_p              Size of the buffer.
+*/
+//------------------------------------------------------------------------------
+static void fillRandom(UINT8* pBuffer_p, size_t size_p)
+{
+    size_t  i;
+
+    for (i = 0; i < size_p; i++)
+        pBuffer_p[i] = (UINT8)rand();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check that a write didn't touch the guard bytes around it
+
+\param[in]      pBuffer_p           Pointer to the buffer.
+\param[in]      offset_p            Offset of the written data.
+\param[in]      size_p              Size of the written data.
+
+\return The function returns TRUE if the guard bytes are unchanged.
+*/
+//------------------------------------------------------------------------------
+static BOOL checkGuard(const UINT8* pBuffer_p, size_t offset_p, size_t size_p)
+{
+    return (pBuffer_p[offset_p - 1] == TEST_GUARD) &&
+           (pBuffer_p[offset_p + size_p] == TEST_GUARD);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the monotonic time
+
+\return The function returns the monotonic time in seconds.
+*/
+//------------------------------------------------------------------------------
+static double getTime(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
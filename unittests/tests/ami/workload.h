@@ -0,0 +1,152 @@
+/**
+********************************************************************************
+\file   workload.h
+
+\brief  Workloads for unit tests of the abstract memory interface
+
+The file contains the workloads which are compiled with the inline and the
+out-of-line AMI functions, so their results and their speed can be compared.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_workload_H_
+#define _INC_workload_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/ami.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define WORKLOAD_STRIDE                 9       // Distance of the accessed fields (odd for unaligned accesses)
+#define WORKLOAD_FIELD_SIZE             8       // Maximum size of an accessed field
+
+//------------------------------------------------------------------------------
+// function implementations
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run the frame workload
+
+The workload emulates the parsing and building of frame headers. It reads
+fields of all sizes in both byte orders at unaligned addresses of the frame
+and writes them back with modified values.
+
+\param[in,out]  pFrame_p            Pointer to the frame.
+\param[in]      frameSize_p         Size of the frame.
+\param[in]      rounds_p            Number of runs over the frame.
+
+\return The function returns the sum of all read values.
+*/
+//------------------------------------------------------------------------------
+static UINT64 runFrameWorkload(UINT8* pFrame_p, UINT frameSize_p, UINT rounds_p)
+{
+    UINT64      sum = 0;
+    UINT        round;
+    UINT        offset;
+    UINT8*      pField;
+    tTimeOfDay  timeOfDay;
+
+    for (round = 0; round < rounds_p; round++)
+    {
+        for (offset = round % WORKLOAD_STRIDE;
+             (offset + WORKLOAD_FIELD_SIZE) <= frameSize_p;
+             offset += WORKLOAD_STRIDE)
+        {
+            pField = pFrame_p + offset;
+
+            sum += ami_getUint16Le(pField);
+            sum += ami_getUint16Be(pField);
+            sum += ami_getUint24Le(pField);
+            sum += ami_getUint24Be(pField);
+            sum += ami_getUint32Le(pField);
+            sum += ami_getUint32Be(pField);
+            sum += ami_getUint40Le(pField);
+            sum += ami_getUint40Be(pField);
+            sum += ami_getUint48Le(pField);
+            sum += ami_getUint48Be(pField);
+            sum += ami_getUint56Le(pField);
+            sum += ami_getUint56Be(pField);
+            sum += ami_getUint64Le(pField);
+            sum += ami_getUint64Be(pField);
+            ami_getTimeOfDay(pField, &timeOfDay);
+            sum += timeOfDay.msec + timeOfDay.days;
+
+            switch (offset % 8)
+            {
+                case 0:
+                    ami_setUint16Le(pField, (UINT16)sum);
+                    ami_setUint16Be(pField + 2, (UINT16)(sum >> 16));
+                    break;
+
+                case 1:
+                    ami_setUint24Le(pField, (UINT32)sum);
+                    ami_setUint24Be(pField + 3, (UINT32)(sum >> 24));
+                    break;
+
+                case 2:
+                    ami_setUint32Le(pField, (UINT32)sum);
+                    ami_setUint32Be(pField + 4, (UINT32)(sum >> 32));
+                    break;
+
+                case 3:
+                    ami_setUint40Le(pField, sum);
+                    break;
+
+                case 4:
+                    ami_setUint40Be(pField, sum);
+                    break;
+
+                case 5:
+                    ami_setUint48Le(pField, sum);
+                    ami_setTimeOfDay(pField, &timeOfDay);
+                    break;
+
+                case 6:
+                    ami_setUint48Be(pField, sum);
+                    ami_setUint56Le(pField, sum >> 3);
+                    ami_setUint56Be(pField, sum >> 5);
+                    break;
+
+                default:
+                    ami_setUint64Le(pField, sum);
+                    ami_setUint64Be(pField, sum * 3);
+                    break;
+            }
+        }
+    }
+
+    return sum;
+}
+
+#endif /* _INC_workload_H_ */
@@ -0,0 +1,402 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for unit tests of configuration manager
+
+This file contains the stubs of the modules used by the configuration manager.
+They simulate a CN with a ConciseDCF in object 0x1F22 and record the SDO
+transfers started by the configuration manager. The test finishes the transfers
+by calling the SDO finished callback like the SDO command layer.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <oplk/frame.h>
+#include <user/sdocom.h>
+#include <user/identu.h>
+#include <user/obdu.h>
+
+#include "test-cfmu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_TRANSFER_COUNT             64
+#define STUB_CYCLE_LEN_US               1000        // Object 0x1006 NMT_CycleLen_U32
+#define STUB_SDO_COM_CON_HDL            1
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tIdentResponse       identResponse_l;
+static const UINT8*         pConciseDcf_l = NULL;
+static size_t               conciseDcfSize_l = 0;
+static tStubSdoTransfer     aTransfer_l[STUB_TRANSFER_COUNT];
+static UINT                 transferCount_l = 0;
+static tSdoFinishedCb       pfnSdoFinishedCb_l = NULL;
+static void*                pSdoUserArg_l = NULL;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset the simulated CN
+
+The function sets the feature flags of the IdentResponse of the CN and its
+ConciseDCF and clears the recorded SDO transfers.
+
+\param[in]      featureFlags_p      Feature flags of the CN.
+\param[in]      pConciseDcf_p       Pointer to the ConciseDCF of the CN.
+\param[in]      conciseDcfSize_p    Size of the ConciseDCF.
+*/
+//------------------------------------------------------------------------------
+void stub_resetCn(UINT32 featureFlags_p,
+                  const UINT8* pConciseDcf_p,
+                  size_t conciseDcfSize_p)
+{
+    memset(&identResponse_l, 0, sizeof(identResponse_l));
+    ami_setUint32Le(&identResponse_l.featureFlagsLe, featureFlags_p);
+
+    pConciseDcf_l = pConciseDcf_p;
+    conciseDcfSize_l = conciseDcfSize_p;
+
+    memset(aTransfer_l, 0, sizeof(aTransfer_l));
+    transferCount_l = 0;
+    pfnSdoFinishedCb_l = NULL;
+    pSdoUserArg_l = NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the number of started SDO transfers
+
+\return The function returns the number of SDO transfers started since the
+        last reset of the simulated CN.
+*/
+//------------------------------------------------------------------------------
+UINT stub_getTransferCount(void)
+{
+    return transferCount_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a started SDO transfer
+
+\param[in]      transfer_p          Number of the transfer, starting with 0.
+
+\return The function returns a pointer to the transfer or NULL if the transfer
+        doesn't exist.
+*/
+//------------------------------------------------------------------------------
+const tStubSdoTransfer* stub_getTransfer(UINT transfer_p)
+{
+    if (transfer_p >= transferCount_l)
+        return NULL;
+
+    return &aTransfer_l[transfer_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish the running SDO transfer
+
+The function calls the SDO finished callback of the last started transfer. A
+finished single write reports the written data size, a finished multiple write
+reports all of its sub-accesses.
+
+\param[in]      sdoComConState_p    State of the command layer connection.
+\param[in]      abortCode_p         SDO abort code.
+\param[in]      targetIndex_p       Index reported by the command layer.
+\param[in]      targetSubIndex_p    Sub-index reported by the command layer.
+
+\return The function returns the return value of the callback or
+        kErrorInvalidOperation if no transfer is running.
+*/
+//------------------------------------------------------------------------------
+tOplkError stub_finishTransfer(tSdoComConState sdoComConState_p,
+                               UINT32 abortCode_p,
+                               UINT targetIndex_p,
+                               UINT targetSubIndex_p)
+{
+    tSdoComFinished         sdoComFinished;
+    tSdoFinishedCb          pfnSdoFinishedCb;
+    const tStubSdoTransfer* pTransfer;
+
+    if ((transferCount_l == 0) || (pfnSdoFinishedCb_l == NULL))
+        return kErrorInvalidOperation;
+
+    pTransfer = &aTransfer_l[transferCount_l - 1];
+
+    memset(&sdoComFinished, 0, sizeof(sdoComFinished));
+    sdoComFinished.sdoComConHdl = STUB_SDO_COM_CON_HDL;
+    sdoComFinished.sdoComConState = sdoComConState_p;
+    sdoComFinished.abortCode = abortCode_p;
+    sdoComFinished.sdoAccessType = pTransfer->sdoAccessType;
+    sdoComFinished.targetIndex = targetIndex_p;
+    sdoComFinished.targetSubIndex = targetSubIndex_p;
+    sdoComFinished.multiSubAccCnt = pTransfer->multiAccCnt;
+    sdoComFinished.pUserArg = pSdoUserArg_l;
+    if (sdoComConState_p == kSdoComTransferFinished)
+        sdoComFinished.transferredBytes = (UINT)pTransfer->dataSize;
+
+    // Like the command layer, inform the application only once about the end of
+    // a transfer. A sub-abort does not end a multiple write.
+    pfnSdoFinishedCb = pfnSdoFinishedCb_l;
+    if (sdoComConState_p != kSdoComTransferRxSubAborted)
+        pfnSdoFinishedCb_l = NULL;
+
+    return pfnSdoFinishedCb(&sdoComFinished);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Define variable
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_defineVar(const tVarParam* pVarParam_p)
+{
+    UNUSED_PARAMETER(pVarParam_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get object data pointer
+
+The stub returns the ConciseDCF of the simulated CN for object 0x1F22.
+*/
+//------------------------------------------------------------------------------
+void* obdu_getObjectDataPtr(UINT index_p, UINT subIndex_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+
+    if (index_p != 0x1F22)
+        return NULL;
+
+    return (void*)pConciseDcf_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get data size
+
+The stub returns the size of the ConciseDCF of the simulated CN for object
+0x1F22.
+*/
+//------------------------------------------------------------------------------
+tObdSize obdu_getDataSize(UINT index_p, UINT subIndex_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+
+    if (index_p != 0x1F22)
+        return 0;
+
+    return (tObdSize)conciseDcfSize_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Read object
+
+The stub returns 0 for the expected configuration date and time.
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_readEntry(UINT index_p,
+                          UINT subIndex_p,
+                          void* pDstData_p,
+                          tObdSize* pSize_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+
+    if ((index_p != 0x1F26) && (index_p != 0x1F27))
+        return kErrorObdIndexNotExist;
+
+    if (*pSize_p < sizeof(UINT32))
+        return kErrorObdValueLengthError;
+
+    memset(pDstData_p, 0, sizeof(UINT32));
+    *pSize_p = sizeof(UINT32);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Read object in little endian byte order
+
+The stub returns the cycle length.
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_readEntryToLe(UINT index_p,
+                              UINT subIndex_p,
+                              void* pDstData_p,
+                              tObdSize* pSize_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+
+    if (index_p != 0x1006)
+        return kErrorObdIndexNotExist;
+
+    if (*pSize_p < sizeof(UINT32))
+        return kErrorObdValueLengthError;
+
+    ami_setUint32Le(pDstData_p, STUB_CYCLE_LEN_US);
+    *pSize_p = sizeof(UINT32);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get IdentResponse
+
+The stub returns the IdentResponse of the simulated CN.
+*/
+//------------------------------------------------------------------------------
+tOplkError identu_getIdentResponse(UINT nodeId_p,
+                                   const tIdentResponse** ppIdentResponse_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+
+    *ppIdentResponse_p = &identResponse_l;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Define SDO command layer connection
+*/
+//------------------------------------------------------------------------------
+tOplkError sdocom_defineConnection(tSdoComConHdl* pSdoComConHdl_p,
+                                   UINT targetNodeId_p,
+                                   tSdoType sdoType_p)
+{
+    UNUSED_PARAMETER(targetNodeId_p);
+    UNUSED_PARAMETER(sdoType_p);
+
+    *pSdoComConHdl_p = STUB_SDO_COM_CON_HDL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Start SDO transfer
+
+The stub records the transfer and its finished callback.
+*/
+//------------------------------------------------------------------------------
+tOplkError sdocom_initTransferByIndex(const tSdoComTransParamByIndex* pSdoComTransParam_p)
+{
+    tStubSdoTransfer*   pTransfer;
+
+    if (transferCount_l >= STUB_TRANSFER_COUNT)
+        return kErrorNoResource;
+
+    pTransfer = &aTransfer_l[transferCount_l];
+    pTransfer->sdoAccessType = pSdoComTransParam_p->sdoAccessType;
+    pTransfer->index = pSdoComTransParam_p->index;
+    pTransfer->subIndex = pSdoComTransParam_p->subindex;
+    pTransfer->dataSize = pSdoComTransParam_p->dataSize;
+    pTransfer->multiAccCnt = pSdoComTransParam_p->multiAccCnt;
+    transferCount_l++;
+
+    pfnSdoFinishedCb_l = pSdoComTransParam_p->pfnSdoFinishedCb;
+    pSdoUserArg_l = pSdoComTransParam_p->pUserArg;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Undefine SDO command layer connection
+*/
+//------------------------------------------------------------------------------
+tOplkError sdocom_undefineConnection(tSdoComConHdl sdoComConHdl_p)
+{
+    UNUSED_PARAMETER(sdoComConHdl_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Abort SDO transfer
+*/
+//------------------------------------------------------------------------------
+tOplkError sdocom_abortTransfer(tSdoComConHdl sdoComConHdl_p,
+                                UINT32 abortCode_p)
+{
+    UNUSED_PARAMETER(sdoComConHdl_p);
+    UNUSED_PARAMETER(abortCode_p);
+
+    return kErrorOk;
+}
@@ -0,0 +1,93 @@
+/**
+********************************************************************************
+\file   test-cfmu.h
+
+\brief  Header file for configuration manager unit tests
+
+This file contains the declarations of the unit tests of the configuration manager and
+of its stubs.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_test_cfmu_H_
+#define _INC_test_cfmu_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <oplk/sdo.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief SDO transfer started by the configuration manager
+*/
+typedef struct
+{
+    tSdoAccessType      sdoAccessType;      ///< SDO access type of the transfer
+    UINT                index;              ///< Index of the (first) written object
+    UINT                subIndex;           ///< Sub-index of the (first) written object
+    size_t              dataSize;           ///< Data size of the (first) written object
+    UINT                multiAccCnt;        ///< Number of objects of a multiple write
+} tStubSdoTransfer;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void                    test_cfmu_multiWrite(void);
+void                    test_cfmu_multiWriteSubAbort(void);
+void                    test_cfmu_multiWriteAbort(void);
+
+void                    stub_resetCn(UINT32 featureFlags_p,
+                                     const UINT8* pConciseDcf_p,
+                                     size_t conciseDcfSize_p);
+UINT                    stub_getTransferCount(void);
+const tStubSdoTransfer* stub_getTransfer(UINT transfer_p);
+tOplkError              stub_finishTransfer(tSdoComConState sdoComConState_p,
+                                            UINT32 abortCode_p,
+                                            UINT targetIndex_p,
+                                            UINT targetSubIndex_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_test_cfmu_H_ */
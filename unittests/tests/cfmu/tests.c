@@ -0,0 +1,338 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the configuration manager
+
+This file contains the unit tests of the ConciseDCF download of the
+configuration manager to a CN which supports SDO multiple write by index. The
+tests cover a successful multiple write, a multiple write with an entry
+rejected by the CN and the fallback to single writes when the CN rejects the
+whole multiple write command.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <oplk/sdoabortcodes.h>
+#include <user/cfmu.h>
+
+#include "test-cfmu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_NODE_ID                    1
+#define TEST_ENTRY_COUNT                14
+#define TEST_ENTRY_INDEX                0x2000      // Index of the first ConciseDCF entry
+#define TEST_ENTRY_SUBINDEX             1
+#define TEST_REJECTED_ENTRY             3           // Entry rejected by the CN
+#define TEST_CONCISEDCF_SIZE            (sizeof(UINT32) + TEST_ENTRY_COUNT * (CDC_OFFSET_DATA + sizeof(UINT32)))
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void         startDownload(void);
+static void         finishDownload(void);
+static tOplkError   cbCnProgress(const tCfmEventCnProgress* pEventCnProgress_p);
+static tOplkError   cbCnResult(UINT nodeId_p, tNmtNodeCommand nodeCommand_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT8                aConciseDcf_l[TEST_CONCISEDCF_SIZE];
+static tCfmEventCnProgress  lastProgress_l;
+static UINT                 progressCount_l;
+static UINT                 abortProgressCount_l;
+static tNmtNodeCommand      nodeCommand_l;
+static BOOL                 fResult_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the ConciseDCF download by multiple write
+
+All entries of the ConciseDCF must be written in a single multiple write by
+index transfer and the CN must be reset afterwards.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_multiWrite(void)
+{
+    const tStubSdoTransfer* pTransfer;
+
+    startDownload();
+
+    CU_ASSERT_EQUAL_FATAL(stub_getTransferCount(), 1);
+    pTransfer = stub_getTransfer(0);
+    CU_ASSERT_EQUAL(pTransfer->sdoAccessType, kSdoAccessTypeMultiWrite);
+    CU_ASSERT_EQUAL(pTransfer->multiAccCnt, TEST_ENTRY_COUNT);
+    CU_ASSERT_EQUAL(pTransfer->index, TEST_ENTRY_INDEX);
+
+    CU_ASSERT_EQUAL(stub_finishTransfer(kSdoComTransferFinished, 0,
+                                        TEST_ENTRY_INDEX + TEST_ENTRY_COUNT - 1,
+                                        TEST_ENTRY_SUBINDEX),
+                    kErrorOk);
+    finishDownload();
+
+    CU_ASSERT_TRUE(fResult_l);
+    CU_ASSERT_EQUAL(nodeCommand_l, kNmtNodeCommandConfReset);
+    CU_ASSERT_EQUAL(abortProgressCount_l, 0);
+    CU_ASSERT_EQUAL(lastProgress_l.bytesDownloaded, lastProgress_l.totalNumberOfBytes);
+
+    cfmu_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test a multiple write with a rejected entry
+
+The rejected entry must be reported with its SDO abort code. When the multiple
+write has finished, the download must fail with the abort code of the rejected
+entry.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_multiWriteSubAbort(void)
+{
+    startDownload();
+    CU_ASSERT_EQUAL_FATAL(stub_getTransferCount(), 1);
+
+    CU_ASSERT_EQUAL(stub_finishTransfer(kSdoComTransferRxSubAborted,
+                                        SDO_AC_VALUE_RANGE_EXCEEDED,
+                                        TEST_ENTRY_INDEX + TEST_REJECTED_ENTRY,
+                                        TEST_ENTRY_SUBINDEX),
+                    kErrorOk);
+    CU_ASSERT_FALSE(fResult_l);
+    CU_ASSERT_EQUAL(progressCount_l, 1);
+    CU_ASSERT_EQUAL(lastProgress_l.sdoAbortCode, SDO_AC_VALUE_RANGE_EXCEEDED);
+    CU_ASSERT_EQUAL(lastProgress_l.objectIndex, TEST_ENTRY_INDEX + TEST_REJECTED_ENTRY);
+
+    CU_ASSERT_EQUAL(stub_finishTransfer(kSdoComTransferFinished, 0,
+                                        TEST_ENTRY_INDEX + TEST_ENTRY_COUNT - 1,
+                                        TEST_ENTRY_SUBINDEX),
+                    kErrorOk);
+
+    CU_ASSERT_TRUE(fResult_l);
+    CU_ASSERT_EQUAL(nodeCommand_l, kNmtNodeCommandConfErr);
+    CU_ASSERT_EQUAL(progressCount_l, 2);
+    CU_ASSERT_EQUAL(lastProgress_l.sdoAbortCode, SDO_AC_VALUE_RANGE_EXCEEDED);
+    CU_ASSERT_EQUAL(lastProgress_l.objectIndex, TEST_ENTRY_INDEX + TEST_REJECTED_ENTRY);
+    CU_ASSERT_EQUAL(stub_getTransferCount(), 1);
+
+    cfmu_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the fallback to single writes
+
+If the CN rejects the whole multiple write command, all entries must be
+written one by one, starting with the first entry.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_multiWriteAbort(void)
+{
+    const tStubSdoTransfer* pTransfer;
+    UINT                    entry;
+
+    startDownload();
+    CU_ASSERT_EQUAL_FATAL(stub_getTransferCount(), 1);
+
+    CU_ASSERT_EQUAL(stub_finishTransfer(kSdoComTransferRxAborted,
+                                        SDO_AC_UNKNOWN_COMMAND_SPECIFIER,
+                                        TEST_ENTRY_INDEX,
+                                        TEST_ENTRY_SUBINDEX),
+                    kErrorOk);
+
+    for (entry = 0; entry < TEST_ENTRY_COUNT; entry++)
+    {
+        CU_ASSERT_EQUAL_FATAL(stub_getTransferCount(), entry + 2);
+        pTransfer = stub_getTransfer(entry + 1);
+        CU_ASSERT_EQUAL(pTransfer->sdoAccessType, kSdoAccessTypeWrite);
+        CU_ASSERT_EQUAL(pTransfer->index, TEST_ENTRY_INDEX + entry);
+        CU_ASSERT_EQUAL(pTransfer->subIndex, TEST_ENTRY_SUBINDEX);
+        CU_ASSERT_EQUAL(pTransfer->dataSize, sizeof(UINT32));
+
+        CU_ASSERT_EQUAL(stub_finishTransfer(kSdoComTransferFinished, 0,
+                                            TEST_ENTRY_INDEX + entry,
+                                            TEST_ENTRY_SUBINDEX),
+                        kErrorOk);
+    }
+    finishDownload();
+
+    CU_ASSERT_TRUE(fResult_l);
+    CU_ASSERT_EQUAL(nodeCommand_l, kNmtNodeCommandConfReset);
+    CU_ASSERT_EQUAL(abortProgressCount_l, 0);
+    CU_ASSERT_EQUAL(lastProgress_l.bytesDownloaded, lastProgress_l.totalNumberOfBytes);
+
+    cfmu_exit();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start the ConciseDCF download
+
+The function initializes the configuration manager and starts the download of
+a ConciseDCF with TEST_ENTRY_COUNT entries of 4 bytes to a CN which supports
+SDO multiple write by index.
+*/
+//------------------------------------------------------------------------------
+static void startDownload(void)
+{
+    UINT8*  pEntry;
+    UINT    entry;
+
+    ami_setUint32Le(aConciseDcf_l, TEST_ENTRY_COUNT);
+    pEntry = &aConciseDcf_l[sizeof(UINT32)];
+    for (entry = 0; entry < TEST_ENTRY_COUNT; entry++)
+    {
+        ami_setUint16Le(&pEntry[CDC_OFFSET_INDEX], TEST_ENTRY_INDEX + entry);
+        ami_setUint8Le(&pEntry[CDC_OFFSET_SUBINDEX], TEST_ENTRY_SUBINDEX);
+        ami_setUint32Le(&pEntry[CDC_OFFSET_SIZE], sizeof(UINT32));
+        ami_setUint32Le(&pEntry[CDC_OFFSET_DATA], entry);
+        pEntry += CDC_OFFSET_DATA + sizeof(UINT32);
+    }
+
+    memset(&lastProgress_l, 0, sizeof(lastProgress_l));
+    progressCount_l = 0;
+    abortProgressCount_l = 0;
+    fResult_l = FALSE;
+
+    stub_resetCn(NMT_FEATUREFLAGS_SDO_RW_MULTIPLE, aConciseDcf_l, sizeof(aConciseDcf_l));
+    CU_ASSERT_EQUAL_FATAL(cfmu_init(cbCnProgress, cbCnResult), kErrorOk);
+
+    // The SDO transfer is running
+    CU_ASSERT_EQUAL(cfmu_processNodeEvent(TEST_NODE_ID,
+                                          kNmtNodeEventUpdateConf,
+                                          kNmtCsPreOperational2),
+                    kErrorReject);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish the ConciseDCF download
+
+The function finishes the write of the cycle length which follows the
+ConciseDCF download if the configuration manager configures the cycle length.
+*/
+//------------------------------------------------------------------------------
+static void finishDownload(void)
+{
+#if (CONFIG_CFM_CONFIGURE_CYCLE_LENGTH != FALSE)
+    const tStubSdoTransfer* pTransfer;
+
+    CU_ASSERT_FALSE(fResult_l);
+    pTransfer = stub_getTransfer(stub_getTransferCount() - 1);
+    CU_ASSERT_FATAL(pTransfer != NULL);
+    CU_ASSERT_EQUAL(pTransfer->index, 0x1006);
+
+    CU_ASSERT_EQUAL(stub_finishTransfer(kSdoComTransferFinished, 0, 0x1006, 0), kErrorOk);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  CN progress callback
+
+The callback records the progress event.
+
+\param[in]      pEventCnProgress_p  Pointer to the progress event.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbCnProgress(const tCfmEventCnProgress* pEventCnProgress_p)
+{
+    lastProgress_l = *pEventCnProgress_p;
+    progressCount_l++;
+    if (pEventCnProgress_p->sdoAbortCode != 0)
+        abortProgressCount_l++;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  CN result callback
+
+The callback records the NMT node command of the configuration result.
+
+\param[in]      nodeId_p            Node ID of the configured CN.
+\param[in]      nodeCommand_p       NMT node command to execute.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbCnResult(UINT nodeId_p, tNmtNodeCommand nodeCommand_p)
+{
+    CU_ASSERT_EQUAL(nodeId_p, TEST_NODE_ID);
+
+    nodeCommand_l = nodeCommand_p;
+    fResult_l = TRUE;
+
+    return kErrorOk;
+}
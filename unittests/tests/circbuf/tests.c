@@ -0,0 +1,573 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the circular buffer library
+
+This file contains the unit tests of the circular buffer library. Besides the
+functional tests, it contains a stress test running a producer and a consumer
+thread on a buffer in SPSC mode and a benchmark comparing the throughput of the
+locked and the SPSC mode.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <common/circbuffer.h>
+
+#include "test-circbuf.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_CIRCBUF_ID                 0
+#define TEST_CIRCBUF_SIZE               8192
+#define TEST_MAX_BLOCK_SIZE             256
+#define TEST_STRESS_BLOCKS              1000000
+#define TEST_BENCHMARK_BLOCKS           2000000
+#define TEST_BENCHMARK_BLOCK_SIZE       32
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    tCircBufInstance*   pInstance;
+    UINT32              blockCount;
+    BOOL                fVariableSize;
+    UINT32              errorCount;
+} tProducerParam;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void   writeRead(tCircBufMode mode_p);
+static void   writeReadMultiple(tCircBufMode mode_p);
+static size_t fillBlock(UINT8* pBlock_p, UINT32 seq_p, BOOL fVariableSize_p);
+static BOOL   checkBlock(const UINT8* pBlock_p, size_t size_p, UINT32 seq_p, BOOL fVariableSize_p);
+static void*  producerThread(void* pArg_p);
+static UINT32 runProducerConsumer(tCircBufMode mode_p, UINT32 blockCount_p,
+                                  BOOL fVariableSize_p, double* pSeconds_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test writing and reading data in locked mode
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_writeReadLocked(void)
+{
+    writeRead(kCircBufModeLocked);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test writing and reading data in SPSC mode
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_writeReadSpsc(void)
+{
+    writeRead(kCircBufModeSpsc);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test wrap-around of data blocks in SPSC mode
+
+The test writes blocks with a size which is not a divider of the buffer size,
+so the blocks are split at the end of the buffer.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_wrapAroundSpsc(void)
+{
+    tCircBufInstance*   pInstance;
+    UINT8               aBlock[TEST_MAX_BLOCK_SIZE];
+    size_t              size;
+    size_t              readSize;
+    UINT32              seq;
+
+    CU_ASSERT_EQUAL_FATAL(circbuf_alloc(TEST_CIRCBUF_ID, 512, kCircBufModeSpsc, &pInstance),
+                          kCircBufOk);
+
+    for (seq = 0; seq < 1000; seq++)
+    {
+        size = fillBlock(aBlock, seq, TRUE);
+        CU_ASSERT_EQUAL(circbuf_writeMultipleData(pInstance, aBlock, 6, &aBlock[6], size - 6),
+                        kCircBufOk);
+        CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), 1);
+
+        OPLK_MEMSET(aBlock, 0, sizeof(aBlock));
+        CU_ASSERT_EQUAL(circbuf_readData(pInstance, aBlock, sizeof(aBlock), &readSize),
+                        kCircBufOk);
+        CU_ASSERT_EQUAL(readSize, size);
+        CU_ASSERT_TRUE(checkBlock(aBlock, readSize, seq, TRUE));
+    }
+
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), 0);
+    circbuf_free(pInstance);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test a full buffer in SPSC mode
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_bufferFullSpsc(void)
+{
+    tCircBufInstance*   pInstance;
+    UINT8               aBlock[28];
+    size_t              readSize;
+    UINT32              count;
+
+    CU_ASSERT_EQUAL_FATAL(circbuf_alloc(TEST_CIRCBUF_ID, 256, kCircBufModeSpsc, &pInstance),
+                          kCircBufOk);
+
+    // Each block occupies 32 bytes including the size header
+    OPLK_MEMSET(aBlock, 0xA5, sizeof(aBlock));
+    for (count = 0; count < 8; count++)
+        CU_ASSERT_EQUAL(circbuf_writeData(pInstance, aBlock, sizeof(aBlock)), kCircBufOk);
+
+    CU_ASSERT_EQUAL(circbuf_writeData(pInstance, aBlock, sizeof(aBlock)), kCircBufBufferFull);
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), 8);
+
+    CU_ASSERT_EQUAL(circbuf_readData(pInstance, aBlock, 4, &readSize), kCircBufReadsizeTooSmall);
+    CU_ASSERT_EQUAL(circbuf_readData(pInstance, aBlock, sizeof(aBlock), &readSize), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_writeData(pInstance, aBlock, sizeof(aBlock)), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_writeData(pInstance, aBlock, sizeof(aBlock)), kCircBufBufferFull);
+
+    circbuf_reset(pInstance);
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), 0);
+    CU_ASSERT_EQUAL(circbuf_readData(pInstance, aBlock, sizeof(aBlock), &readSize),
+                    kCircBufNoReadableData);
+
+    circbuf_free(pInstance);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test writing and reading multiple blocks in locked mode
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_multipleLocked(void)
+{
+    writeReadMultiple(kCircBufModeLocked);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test writing and reading multiple blocks in SPSC mode
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_multipleSpsc(void)
+{
+    writeReadMultiple(kCircBufModeSpsc);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stress test of a buffer in SPSC mode
+
+A producer thread writes blocks of varying size to the buffer while the test
+thread reads and verifies them. The blocks must arrive complete and in order.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_stressSpsc(void)
+{
+    double  seconds;
+
+    CU_ASSERT_EQUAL(runProducerConsumer(kCircBufModeSpsc, TEST_STRESS_BLOCKS, TRUE, &seconds), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the throughput of the locked and the SPSC mode
+
+The test transfers the same number of fixed size blocks between a producer and
+a consumer thread in both modes and prints the achieved block rates.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_throughput(void)
+{
+    double  lockedSeconds;
+    double  spscSeconds;
+
+    CU_ASSERT_EQUAL(runProducerConsumer(kCircBufModeLocked, TEST_BENCHMARK_BLOCKS, FALSE,
+                                        &lockedSeconds), 0);
+    CU_ASSERT_EQUAL(runProducerConsumer(kCircBufModeSpsc, TEST_BENCHMARK_BLOCKS, FALSE,
+                                        &spscSeconds), 0);
+
+    printf("\n    %u blocks of %u bytes: locked %.0f blocks/s, SPSC %.0f blocks/s\n",
+           TEST_BENCHMARK_BLOCKS, TEST_BENCHMARK_BLOCK_SIZE,
+           TEST_BENCHMARK_BLOCKS / lockedSeconds, TEST_BENCHMARK_BLOCKS / spscSeconds);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write and read data blocks in the given mode
+
+\param[in]      mode_p              Access mode of the circular buffer.
+*/
+//------------------------------------------------------------------------------
+static void writeRead(tCircBufMode mode_p)
+{
+    tCircBufInstance*   pInstance;
+    tCircBufInstance*   pReader;
+    UINT8               aBlock[TEST_MAX_BLOCK_SIZE];
+    size_t              readSize;
+    UINT32              seq;
+
+    CU_ASSERT_EQUAL_FATAL(circbuf_alloc(TEST_CIRCBUF_ID, TEST_CIRCBUF_SIZE, mode_p, &pInstance),
+                          kCircBufOk);
+    CU_ASSERT_EQUAL_FATAL(circbuf_connect(TEST_CIRCBUF_ID, &pReader), kCircBufOk);
+
+    CU_ASSERT_EQUAL(circbuf_readData(pReader, aBlock, sizeof(aBlock), &readSize),
+                    kCircBufNoReadableData);
+
+    for (seq = 0; seq < 3; seq++)
+    {
+        CU_ASSERT_EQUAL(circbuf_writeData(pInstance, aBlock, fillBlock(aBlock, seq, TRUE)),
+                        kCircBufOk);
+    }
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pReader), 3);
+
+    for (seq = 0; seq < 3; seq++)
+    {
+        OPLK_MEMSET(aBlock, 0, sizeof(aBlock));
+        CU_ASSERT_EQUAL(circbuf_readData(pReader, aBlock, sizeof(aBlock), &readSize), kCircBufOk);
+        CU_ASSERT_TRUE(checkBlock(aBlock, readSize, seq, TRUE));
+    }
+
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pReader), 0);
+    CU_ASSERT_EQUAL(circbuf_readData(pReader, aBlock, sizeof(aBlock), &readSize),
+                    kCircBufNoReadableData);
+
+    circbuf_disconnect(pReader);
+    circbuf_free(pInstance);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write and read multiple data blocks in the given mode
+
+The test writes batches of blocks until the buffer is full and reads them back
+in batches limited by the block count and by the destination buffer size.
+
+\param[in]      mode_p              Access mode of the circular buffer.
+*/
+//------------------------------------------------------------------------------
+static void writeReadMultiple(tCircBufMode mode_p)
+{
+    tCircBufInstance*   pInstance;
+    tCircBufWriteBlock  aBlocks[8];
+    UINT8               aWriteData[8][TEST_MAX_BLOCK_SIZE];
+    UINT8               aReadData[4 * TEST_MAX_BLOCK_SIZE];
+    size_t              aBlockSize[8];
+    size_t              offset;
+    UINT                count;
+    UINT                i;
+    UINT32              writeSeq = 0;
+    UINT32              readSeq = 0;
+
+    CU_ASSERT_EQUAL_FATAL(circbuf_alloc(TEST_CIRCBUF_ID, 2048, mode_p, &pInstance), kCircBufOk);
+
+    CU_ASSERT_EQUAL(circbuf_readMultiple(pInstance, aReadData, sizeof(aReadData),
+                                         aBlockSize, 8, &count),
+                    kCircBufNoReadableData);
+    CU_ASSERT_EQUAL(count, 0);
+
+    // Fill the buffer, the last batch doesn't fit completely
+    do
+    {
+        for (i = 0; i < 8; i++)
+        {
+            aBlocks[i].size = fillBlock(aWriteData[i], writeSeq + i, TRUE);
+            aBlocks[i].pData = aWriteData[i];
+            aBlocks[i].size2 = 0;
+            aBlocks[i].pData2 = NULL;
+            if ((i % 2) != 0)
+            {
+                // Split odd blocks into two parts
+                aBlocks[i].size = 5;
+                aBlocks[i].pData2 = &aWriteData[i][5];
+                aBlocks[i].size2 = fillBlock(aWriteData[i], writeSeq + i, TRUE) - 5;
+            }
+        }
+        circbuf_writeMultiple(pInstance, aBlocks, 8, &count);
+        writeSeq += count;
+    } while (count == 8);
+
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), writeSeq);
+
+    // Retrying with the block which didn't fit must not write anything
+    i = count;
+    CU_ASSERT_EQUAL(circbuf_writeMultiple(pInstance, &aBlocks[i], 8 - i, &count), kCircBufBufferFull);
+    CU_ASSERT_EQUAL(count, 0);
+
+    // Read back with batches limited by count and destination size
+    while (readSeq < writeSeq)
+    {
+        CU_ASSERT_EQUAL_FATAL(circbuf_readMultiple(pInstance, aReadData, sizeof(aReadData),
+                                                   aBlockSize, 3, &count),
+                              kCircBufOk);
+        CU_ASSERT_TRUE((count > 0) && (count <= 3));
+
+        offset = 0;
+        for (i = 0; i < count; i++)
+        {
+            CU_ASSERT_EQUAL(offset % CIRCBUF_READ_MULTIPLE_ALIGNMENT, 0);
+            CU_ASSERT_TRUE(checkBlock(&aReadData[offset], aBlockSize[i], readSeq, TRUE));
+            offset += (aBlockSize[i] + (CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1)) &
+                      ~(size_t)(CIRCBUF_READ_MULTIPLE_ALIGNMENT - 1);
+            readSeq++;
+        }
+    }
+
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), 0);
+
+    // A block larger than the destination buffer is reported
+    aBlocks[0].pData = aWriteData[0];
+    aBlocks[0].size = 64;
+    aBlocks[0].pData2 = NULL;
+    CU_ASSERT_EQUAL(circbuf_writeMultiple(pInstance, aBlocks, 1, &count), kCircBufOk);
+    CU_ASSERT_EQUAL(count, 1);
+    CU_ASSERT_EQUAL(circbuf_readMultiple(pInstance, aReadData, 32, aBlockSize, 8, &count),
+                    kCircBufReadsizeTooSmall);
+    CU_ASSERT_EQUAL(count, 0);
+
+    circbuf_free(pInstance);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill a test data block
+
+The block starts with the sequence number followed by a pattern derived from
+it. With variable size the block size is derived from the sequence number too.
+
+\param[out]     pBlock_p            Pointer to the block to be filled.
+\param[in]      seq_p               Sequence number of the block.
+\param[in]      fVariableSize_p     Use a block size depending on the sequence number.
+
+\return The function returns the size of the block.
+*/
+//------------------------------------------------------------------------------
+static size_t fillBlock(UINT8* pBlock_p, UINT32 seq_p, BOOL fVariableSize_p)
+{
+    size_t  size;
+    size_t  i;
+
+    if (fVariableSize_p)
+        size = sizeof(UINT32) + 3 + ((seq_p * 7) % (TEST_MAX_BLOCK_SIZE - sizeof(UINT32) - 3));
+    else
+        size = TEST_BENCHMARK_BLOCK_SIZE;
+
+    OPLK_MEMCPY(pBlock_p, &seq_p, sizeof(UINT32));
+    for (i = sizeof(UINT32); i < size; i++)
+        pBlock_p[i] = (UINT8)(seq_p + i);
+
+    return size;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check a test data block
+
+\param[in]      pBlock_p            Pointer to the block to be checked.
+\param[in]      size_p              Size of the block.
+\param[in]      seq_p               Expected sequence number of the block.
+\param[in]      fVariableSize_p     The block size depends on the sequence number.
+
+\return The function returns TRUE if the block contains the expected data.
+*/
+//------------------------------------------------------------------------------
+static BOOL checkBlock(const UINT8* pBlock_p, size_t size_p, UINT32 seq_p, BOOL fVariableSize_p)
+{
+    UINT8   aExpected[TEST_MAX_BLOCK_SIZE];
+
+    if (size_p != fillBlock(aExpected, seq_p, fVariableSize_p))
+        return FALSE;
+
+    return (memcmp(pBlock_p, aExpected, size_p) == 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Producer thread
+
+The thread writes the configured number of test blocks to the buffer. If the
+buffer is full, it retries until the consumer has freed enough space.
+
+\param[in]      pArg_p              Pointer to the producer parameters.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* producerThread(void* pArg_p)
+{
+    tProducerParam* pParam = (tProducerParam*)pArg_p;
+    UINT8           aBlock[TEST_MAX_BLOCK_SIZE];
+    size_t          size;
+    tCircBufError   ret;
+    UINT32          seq;
+
+    for (seq = 0; seq < pParam->blockCount; seq++)
+    {
+        size = fillBlock(aBlock, seq, pParam->fVariableSize);
+        do
+        {
+            ret = circbuf_writeData(pParam->pInstance, aBlock, size);
+            if (ret == kCircBufBufferFull)
+                sched_yield();
+        } while (ret == kCircBufBufferFull);
+
+        if (ret != kCircBufOk)
+            pParam->errorCount++;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Transfer test blocks between a producer and a consumer thread
+
+\param[in]      mode_p              Access mode of the circular buffer.
+\param[in]      blockCount_p        Number of blocks to be transferred.
+\param[in]      fVariableSize_p     Use blocks of varying size.
+\param[out]     pSeconds_p          Pointer to store the duration of the transfer.
+
+\return The function returns the number of detected errors.
+*/
+//------------------------------------------------------------------------------
+static UINT32 runProducerConsumer(tCircBufMode mode_p, UINT32 blockCount_p,
+                                  BOOL fVariableSize_p, double* pSeconds_p)
+{
+    tCircBufInstance*   pReader;
+    tProducerParam      param;
+    pthread_t           producer;
+    struct timespec     startTime;
+    struct timespec     endTime;
+    UINT8               aBlock[TEST_MAX_BLOCK_SIZE];
+    size_t              readSize;
+    tCircBufError       ret;
+    UINT32              seq;
+    UINT32              errorCount = 0;
+
+    OPLK_MEMSET(&param, 0, sizeof(param));
+    param.blockCount = blockCount_p;
+    param.fVariableSize = fVariableSize_p;
+
+    if (circbuf_alloc(TEST_CIRCBUF_ID, TEST_CIRCBUF_SIZE, mode_p, &param.pInstance) != kCircBufOk)
+        return 1;
+
+    if (circbuf_connect(TEST_CIRCBUF_ID, &pReader) != kCircBufOk)
+    {
+        circbuf_free(param.pInstance);
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+    if (pthread_create(&producer, NULL, producerThread, &param) != 0)
+    {
+        circbuf_disconnect(pReader);
+        circbuf_free(param.pInstance);
+        return 1;
+    }
+
+    for (seq = 0; seq < blockCount_p; seq++)
+    {
+        do
+        {
+            ret = circbuf_readData(pReader, aBlock, sizeof(aBlock), &readSize);
+            if (ret == kCircBufNoReadableData)
+                sched_yield();
+        } while (ret == kCircBufNoReadableData);
+
+        if ((ret != kCircBufOk) || !checkBlock(aBlock, readSize, seq, fVariableSize_p))
+            errorCount++;
+    }
+
+    pthread_join(producer, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    if (circbuf_getDataCount(pReader) != 0)
+        errorCount++;
+
+    circbuf_disconnect(pReader);
+    circbuf_free(param.pInstance);
+
+    *pSeconds_p = (double)(endTime.tv_sec - startTime.tv_sec) +
+                  (double)(endTime.tv_nsec - startTime.tv_nsec) / 1e9;
+
+    return errorCount + param.errorCount;
+}
+
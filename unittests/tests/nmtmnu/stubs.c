@@ -0,0 +1,760 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for unit tests of NMT MN module
+
+This file contains the stubs of the modules used by the NMT MN module. They
+simulate a network of CNs which are reset by the MN and answer IdentRequests
+after a short delay. Events posted by the NMT MN module are queued and passed
+back to it by the test, user timers expire on a simulated millisecond clock
+which is also returned as the tick count.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <common/target.h>
+#include <user/nmtmnu.h>
+#include <user/nmtu.h>
+#include <user/obdu.h>
+#include <user/eventu.h>
+#include <user/timeru.h>
+#include <user/dllucal.h>
+#include <user/identu.h>
+#include <user/statusu.h>
+#include <user/syncu.h>
+
+#include "test-nmtmnu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_EVENT_QUEUE_SIZE           1024
+#define STUB_EVENT_ARG_SIZE             C_DLL_MINSIZE_NMTCMDEXT
+#define STUB_TIMER_COUNT                512
+#define STUB_NODE_COUNT                 254
+#define STUB_MN_NODE_ID                 C_ADR_MN_DEF_NODE_ID
+#define STUB_CYCLE_LEN_US               1000        // Object 0x1006 NMT_CycleLen_U32
+#define STUB_IDENT_DELAY_MS             2           // Time until a CN answers an IdentRequest
+#define STUB_NMT_EVENT_COUNT            32
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    tEvent      event;
+    UINT8       aArg[STUB_EVENT_ARG_SIZE];
+} tStubEvent;
+
+typedef struct
+{
+    BOOL        fActive;
+    UINT32      dueTime;
+    tTimerArg   arg;
+} tStubTimer;
+
+typedef struct
+{
+    UINT32              nodeCfg;        // Object 0x1F81 NMT_NodeAssignment_AU32
+    UINT8               currState;      // Object 0x1F8E NMT_MNNodeCurrState_AU8
+    UINT8               expState;       // Object 0x1F8F NMT_MNNodeExpState_AU8
+    tIdentuCbResponse   pfnCbIdent;     // Callback of a pending IdentRequest
+    UINT32              identDueTime;   // Time when the CN answers the IdentRequest
+} tStubNode;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void queueEvent(const tEvent* pEvent_p);
+static void answerIdentRequest(UINT nodeId_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tStubEvent   aEventQueue_l[STUB_EVENT_QUEUE_SIZE];
+static UINT         eventQueueRead_l = 0;
+static UINT         eventQueueWrite_l = 0;
+static tStubTimer   aTimer_l[STUB_TIMER_COUNT];
+static tStubNode    aNode_l[STUB_NODE_COUNT + 1];
+static tNmtState    mnNmtState_l = kNmtGsOff;
+static UINT32       time_l = 0;
+static tNmtEvent    aNmtEvent_l[STUB_NMT_EVENT_COUNT];
+static UINT         nmtEventCount_l = 0;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset the simulated network
+
+The function clears the event queue, the timers and the state of the simulated
+CNs. The CNs with the node IDs 1 to nodeCount_p are configured as mandatory
+CNs in the node assignment object.
+
+\param[in]      nodeCount_p         Number of simulated CNs.
+*/
+//------------------------------------------------------------------------------
+void stub_resetNetwork(UINT nodeCount_p)
+{
+    UINT    nodeId;
+
+    eventQueueRead_l = 0;
+    eventQueueWrite_l = 0;
+    nmtEventCount_l = 0;
+    mnNmtState_l = kNmtGsOff;
+    memset(aTimer_l, 0, sizeof(aTimer_l));
+    memset(aNode_l, 0, sizeof(aNode_l));
+
+    for (nodeId = 1; (nodeId <= nodeCount_p) && (nodeId < STUB_MN_NODE_ID); nodeId++)
+    {
+        aNode_l[nodeId].nodeCfg = NMT_NODEASSIGN_NODE_EXISTS |
+                                  NMT_NODEASSIGN_NODE_IS_CN |
+                                  NMT_NODEASSIGN_MANDATORY_CN;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change the NMT state of the MN
+
+The function sets the NMT state of the simulated MN and passes the state
+change to the NMT MN module.
+
+\param[in]      nmtState_p          New NMT state of the MN.
+\param[in]      nmtEvent_p          NMT event which caused the state change.
+*/
+//------------------------------------------------------------------------------
+void stub_changeMnState(tNmtState nmtState_p, tNmtEvent nmtEvent_p)
+{
+    tEventNmtStateChange    nmtStateChange;
+
+    memset(&nmtStateChange, 0, sizeof(nmtStateChange));
+    nmtStateChange.oldNmtState = mnNmtState_l;
+    nmtStateChange.newNmtState = nmtState_p;
+    nmtStateChange.nmtEvent = nmtEvent_p;
+
+    mnNmtState_l = nmtState_p;
+    nmtmnu_cbNmtStateChange(nmtStateChange);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process queued events
+
+The function passes all queued events to the NMT MN module, including the
+events which are posted while the queue is processed.
+*/
+//------------------------------------------------------------------------------
+void stub_processEvents(void)
+{
+    tStubEvent* pStubEvent;
+
+    while (eventQueueRead_l != eventQueueWrite_l)
+    {
+        pStubEvent = &aEventQueue_l[eventQueueRead_l];
+        eventQueueRead_l = (eventQueueRead_l + 1) % STUB_EVENT_QUEUE_SIZE;
+
+        nmtmnu_processEvent(&pStubEvent->event);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Advance the simulated time
+
+The function advances the simulated clock millisecond by millisecond. In every
+millisecond, the expired timers are queued as timer events and the CNs answer
+their due IdentRequests.
+
+\param[in]      timeMs_p            Time to advance in milliseconds.
+*/
+//------------------------------------------------------------------------------
+void stub_advanceTime(UINT32 timeMs_p)
+{
+    UINT                index;
+    UINT                nodeId;
+    tEvent              event;
+    tTimerEventArg      timerEventArg;
+
+    while (timeMs_p-- > 0)
+    {
+        time_l++;
+
+        for (index = 1; index < STUB_TIMER_COUNT; index++)
+        {
+            if (!aTimer_l[index].fActive ||
+                ((INT32)(time_l - aTimer_l[index].dueTime) < 0))
+                continue;
+
+            aTimer_l[index].fActive = FALSE;
+
+            memset(&timerEventArg, 0, sizeof(timerEventArg));
+            timerEventArg.timerHdl.handle = (tTimerHdl)index;
+            timerEventArg.argument.value = aTimer_l[index].arg.argument.value;
+
+            event.eventSink = aTimer_l[index].arg.eventSink;
+            event.eventType = kEventTypeTimer;
+            memset(&event.netTime, 0, sizeof(event.netTime));
+            event.eventArg.pEventArg = &timerEventArg;
+            event.eventArgSize = sizeof(timerEventArg);
+            queueEvent(&event);
+        }
+
+        for (nodeId = 1; nodeId <= STUB_NODE_COUNT; nodeId++)
+        {
+            if ((aNode_l[nodeId].pfnCbIdent != NULL) &&
+                ((INT32)(time_l - aNode_l[nodeId].identDueTime) >= 0))
+                answerIdentRequest(nodeId);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the simulated time
+
+\return The function returns the simulated time in milliseconds.
+*/
+//------------------------------------------------------------------------------
+UINT32 stub_getTime(void)
+{
+    return time_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if an NMT event was posted
+
+\param[in]      nmtEvent_p          NMT event to look for.
+
+\return The function returns TRUE if the NMT MN module posted the NMT event
+        since the last reset.
+*/
+//------------------------------------------------------------------------------
+BOOL stub_isNmtEventPosted(tNmtEvent nmtEvent_p)
+{
+    UINT    index;
+
+    for (index = 0; index < nmtEventCount_l; index++)
+    {
+        if (aNmtEvent_l[index] == nmtEvent_p)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get tick count
+
+The stub returns the simulated time.
+*/
+//------------------------------------------------------------------------------
+UINT32 target_getTickCount(void)
+{
+    return time_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Post event
+
+The stub queues events for the NMT MN module and discards all other events.
+*/
+//------------------------------------------------------------------------------
+tOplkError eventu_postEvent(const tEvent* pEvent_p)
+{
+    if (pEvent_p->eventSink == kEventSinkNmtMnu)
+        queueEvent(pEvent_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Post error event
+*/
+//------------------------------------------------------------------------------
+tOplkError eventu_postError(tEventSource eventSource_p,
+                            tOplkError error_p,
+                            UINT argSize_p,
+                            const void* pArg_p)
+{
+    UNUSED_PARAMETER(eventSource_p);
+    UNUSED_PARAMETER(error_p);
+    UNUSED_PARAMETER(argSize_p);
+    UNUSED_PARAMETER(pArg_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get NMT state
+
+The stub returns the NMT state of the simulated MN.
+*/
+//------------------------------------------------------------------------------
+tNmtState nmtu_getNmtState(void)
+{
+    return mnNmtState_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Post NMT event
+
+The stub records the NMT event, the MN stays in its current NMT state.
+*/
+//------------------------------------------------------------------------------
+tOplkError nmtu_postNmtEvent(tNmtEvent nmtEvent_p)
+{
+    if (nmtEventCount_l < STUB_NMT_EVENT_COUNT)
+        aNmtEvent_l[nmtEventCount_l++] = nmtEvent_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Read object
+
+The stub implements the objects of the MN used during BootStep1.
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_readEntry(UINT index_p,
+                          UINT subIndex_p,
+                          void* pDstData_p,
+                          tObdSize* pSize_p)
+{
+    UINT32  value;
+
+    if (subIndex_p > STUB_NODE_COUNT)
+        return kErrorObdSubindexNotExist;
+
+    switch (index_p)
+    {
+        case 0x1006:    // NMT_CycleLen_U32
+            value = STUB_CYCLE_LEN_US;
+            break;
+
+        case 0x1F80:    // NMT_StartUp_U32
+            value = NMT_STARTUP_SWVERSIONCHECK;
+            break;
+
+        case 0x1F81:    // NMT_NodeAssignment_AU32
+            if (subIndex_p == 0)
+            {
+                *(UINT8*)pDstData_p = STUB_NODE_COUNT;
+                *pSize_p = 1;
+                return kErrorOk;
+            }
+            value = aNode_l[subIndex_p].nodeCfg;
+            break;
+
+        case 0x1F84:    // NMT_MNDeviceTypeIdList_AU32
+        case 0x1F89:    // NMT_BootTime_REC
+            value = 0;
+            break;
+
+        case 0x1F8E:    // NMT_MNNodeCurrState_AU8
+            *(UINT8*)pDstData_p = aNode_l[subIndex_p].currState;
+            *pSize_p = 1;
+            return kErrorOk;
+
+        case 0x1F8F:    // NMT_MNNodeExpState_AU8
+            *(UINT8*)pDstData_p = aNode_l[subIndex_p].expState;
+            *pSize_p = 1;
+            return kErrorOk;
+
+        default:
+            return kErrorObdIndexNotExist;
+    }
+
+    if (*pSize_p < sizeof(value))
+        return kErrorObdValueLengthError;
+
+    memcpy(pDstData_p, &value, sizeof(value));
+    *pSize_p = sizeof(value);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Write object
+
+The stub stores the current and expected NMT states of the CNs.
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_writeEntry(UINT index_p,
+                           UINT subIndex_p,
+                           const void* pSrcData_p,
+                           tObdSize size_p)
+{
+    UNUSED_PARAMETER(size_p);
+
+    if (subIndex_p > STUB_NODE_COUNT)
+        return kErrorObdSubindexNotExist;
+
+    switch (index_p)
+    {
+        case 0x1F8E:    // NMT_MNNodeCurrState_AU8
+            aNode_l[subIndex_p].currState = *(const UINT8*)pSrcData_p;
+            break;
+
+        case 0x1F8F:    // NMT_MNNodeExpState_AU8
+            aNode_l[subIndex_p].expState = *(const UINT8*)pSrcData_p;
+            break;
+
+        default:
+            return kErrorObdIndexNotExist;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get node ID
+*/
+//------------------------------------------------------------------------------
+UINT obdu_getNodeId(void)
+{
+    return STUB_MN_NODE_ID;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Modify user timer
+
+The stub (re)starts the timer on the simulated clock.
+*/
+//------------------------------------------------------------------------------
+tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
+                              ULONG timeoutMs_p,
+                              const tTimerArg* pArgument_p)
+{
+    UINT    index = (UINT)*pTimerHdl_p;
+
+    if ((index == 0) || (index >= STUB_TIMER_COUNT))
+    {
+        for (index = 1; index < STUB_TIMER_COUNT; index++)
+        {
+            if (!aTimer_l[index].fActive)
+                break;
+        }
+
+        if (index >= STUB_TIMER_COUNT)
+            return kErrorTimerNoTimerCreated;
+    }
+
+    aTimer_l[index].fActive = TRUE;
+    aTimer_l[index].dueTime = time_l + (UINT32)timeoutMs_p;
+    aTimer_l[index].arg = *pArgument_p;
+    *pTimerHdl_p = (tTimerHdl)index;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Delete user timer
+*/
+//------------------------------------------------------------------------------
+tOplkError timeru_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    UINT    index = (UINT)*pTimerHdl_p;
+
+    if ((index != 0) && (index < STUB_TIMER_COUNT))
+        aTimer_l[index].fActive = FALSE;
+
+    *pTimerHdl_p = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Request IdentResponse
+
+The CN answers the IdentRequest after STUB_IDENT_DELAY_MS.
+*/
+//------------------------------------------------------------------------------
+tOplkError identu_requestIdentResponse(UINT nodeId_p,
+                                       tIdentuCbResponse pfnCbResponse_p)
+{
+    if (aNode_l[nodeId_p].pfnCbIdent != NULL)
+        return kErrorInvalidOperation;
+
+    aNode_l[nodeId_p].pfnCbIdent = pfnCbResponse_p;
+    aNode_l[nodeId_p].identDueTime = time_l + STUB_IDENT_DELAY_MS;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Reset IdentRequests
+*/
+//------------------------------------------------------------------------------
+tOplkError identu_reset(void)
+{
+    UINT    nodeId;
+
+    for (nodeId = 1; nodeId <= STUB_NODE_COUNT; nodeId++)
+        aNode_l[nodeId].pfnCbIdent = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Request StatusResponse
+
+The simulated CNs do not answer StatusRequests.
+*/
+//------------------------------------------------------------------------------
+tOplkError statusu_requestStatusResponse(UINT nodeId_p,
+                                         tStatusuCbResponse pfnCbResponse_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(pfnCbResponse_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Reset StatusRequests
+*/
+//------------------------------------------------------------------------------
+tOplkError statusu_reset(void)
+{
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Request SyncResponse
+*/
+//------------------------------------------------------------------------------
+tOplkError syncu_requestSyncResponse(tSyncuCbResponse pfnCbResponse_p,
+                                     const tDllSyncRequest* pSyncRequestData_p,
+                                     size_t size_p)
+{
+    UNUSED_PARAMETER(pfnCbResponse_p);
+    UNUSED_PARAMETER(pSyncRequestData_p);
+    UNUSED_PARAMETER(size_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Reset SyncRequests
+*/
+//------------------------------------------------------------------------------
+tOplkError syncu_reset(void)
+{
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Register ASnd service
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_regAsndService(tDllAsndServiceId ServiceId_p,
+                                  tDlluCbAsnd pfnDlluCbAsnd_p,
+                                  tDllAsndFilter Filter_p)
+{
+    UNUSED_PARAMETER(ServiceId_p);
+    UNUSED_PARAMETER(pfnDlluCbAsnd_p);
+    UNUSED_PARAMETER(Filter_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Send asynchronous frame
+
+The stub sends the NMT command immediately, i.e. it queues the event which
+reports the sent NMT command to the NMT MN module.
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_sendAsyncFrame(const tFrameInfo* pFrameInfo,
+                                  tDllAsyncReqPriority priority_p)
+{
+    tEvent  event;
+
+    UNUSED_PARAMETER(priority_p);
+
+    event.eventSink = kEventSinkNmtMnu;
+    event.eventType = kEventTypeNmtMnuNmtCmdSent;
+    memset(&event.netTime, 0, sizeof(event.netTime));
+    event.eventArg.pEventArg = pFrameInfo->frame.pBuffer;
+    event.eventArgSize = (UINT)pFrameInfo->frameSize;
+    if (event.eventArgSize > STUB_EVENT_ARG_SIZE)
+        event.eventArgSize = STUB_EVENT_ARG_SIZE;
+
+    queueEvent(&event);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Configure node
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_configNode(const tDllNodeInfo* pNodeInfo_p)
+{
+    UNUSED_PARAMETER(pNodeInfo_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Add node to isochronous phase
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_addNode(const tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Delete node from isochronous phase
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_deleteNode(const tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Queue event
+
+The function copies the event and its argument into the event queue.
+
+\param[in]      pEvent_p            Event to queue.
+*/
+//------------------------------------------------------------------------------
+static void queueEvent(const tEvent* pEvent_p)
+{
+    tStubEvent* pStubEvent;
+    UINT        nextWrite;
+
+    nextWrite = (eventQueueWrite_l + 1) % STUB_EVENT_QUEUE_SIZE;
+    if ((nextWrite == eventQueueRead_l) || (pEvent_p->eventArgSize > STUB_EVENT_ARG_SIZE))
+        return;
+
+    pStubEvent = &aEventQueue_l[eventQueueWrite_l];
+    pStubEvent->event = *pEvent_p;
+    if (pEvent_p->eventArgSize > 0)
+        memcpy(pStubEvent->aArg, pEvent_p->eventArg.pEventArg, pEvent_p->eventArgSize);
+    pStubEvent->event.eventArg.pEventArg = pStubEvent->aArg;
+    eventQueueWrite_l = nextWrite;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Answer IdentRequest
+
+The simulated CN answers the pending IdentRequest. A CN starts in
+PreOperational1 and supports all features.
+
+\param[in]      nodeId_p            Node ID of the CN.
+*/
+//------------------------------------------------------------------------------
+static void answerIdentRequest(UINT nodeId_p)
+{
+    tIdentuCbResponse   pfnCbIdent = aNode_l[nodeId_p].pfnCbIdent;
+    tIdentResponse      identResponse;
+
+    aNode_l[nodeId_p].pfnCbIdent = NULL;
+
+    memset(&identResponse, 0, sizeof(identResponse));
+    ami_setUint8Le(&identResponse.nmtStatus, (UINT8)(kNmtCsPreOperational1 & 0xFF));
+    ami_setUint32Le(&identResponse.featureFlagsLe, NMT_FEATUREFLAGS_PRC);
+
+    if (aNode_l[nodeId_p].nodeCfg != 0)
+        pfnCbIdent(nodeId_p, &identResponse);
+    else
+        pfnCbIdent(nodeId_p, NULL);
+}
+
+/// \}
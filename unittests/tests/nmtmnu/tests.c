@@ -0,0 +1,364 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the NMT MN module
+
+This file contains the unit tests of the NMT MN module. The tests boot a
+simulated network of 100 mandatory CNs through BootStep1. The application
+callbacks of the tests check the software of every CN and configure it in the
+background, like the configuration manager does with a ConciseDCF download.
+They check that all CNs are configured concurrently and exactly once and that
+the boot report is consistent. The boot report is printed.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <user/nmtmnu.h>
+
+#include "test-nmtmnu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_NODE_COUNT                 100         // Number of simulated CNs
+#define TEST_CONFIG_TIME_MS             20          // [ms] Minimum configuration time of a CN
+#define TEST_CONFIG_TIME_STEP_MS        10          // [ms] Configuration time added per node ID modulo 5
+#define TEST_BOOT_TIMEOUT_MS            60000       // [ms] Time limit of BootStep1
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    BOOL        fConfigActive;          // Configuration of the CN is running
+    UINT32      configDueTime;          // Time when the configuration is finished
+    UINT        swCheckCount;           // Number of software checks of the CN
+    UINT        configCount;            // Number of finished configurations of the CN
+} tTestNode;
+
+typedef struct
+{
+    tTestNode   aNode[TEST_NODE_COUNT + 1];
+    UINT        activeConfigCount;      // Number of running configurations
+    UINT        peakConfigCount;        // Max. number of running configurations
+    BOOL        fBootStep1Finished;     // Boot event BootStep1Finish was received
+} tTestBoot;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError cbNodeEvent(UINT nodeId_p,
+                              tNmtNodeEvent nodeEvent_p,
+                              tNmtState nmtState_p,
+                              UINT16 errorCode_p,
+                              BOOL fMandatory_p);
+static tOplkError cbBootEvent(tNmtBootEvent bootEvent_p,
+                              tNmtState nmtState_p,
+                              UINT16 errorCode_p);
+static BOOL       runBootStep1(tNmtMnuBootReport* pBootReport_p);
+static void       printBootReport(const tNmtMnuBootReport* pBootReport_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTestBoot    testBoot_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test parallel configuration of CNs
+
+The test boots the network. All CNs must be configured at the same time and
+every CN must be checked and configured exactly once.
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_parallelConfig(void)
+{
+    tNmtMnuBootReport   bootReport;
+    UINT                nodeId;
+
+    CU_ASSERT_TRUE_FATAL(runBootStep1(&bootReport));
+
+    CU_ASSERT_EQUAL(testBoot_l.peakConfigCount, TEST_NODE_COUNT);
+    CU_ASSERT_EQUAL(bootReport.peakParallelConfig, TEST_NODE_COUNT);
+    CU_ASSERT_TRUE(stub_isNmtEventPosted(kNmtEventAllMandatoryCNIdent));
+
+    for (nodeId = 1; nodeId <= TEST_NODE_COUNT; nodeId++)
+    {
+        CU_ASSERT_EQUAL(testBoot_l.aNode[nodeId].swCheckCount, 1);
+        CU_ASSERT_EQUAL(testBoot_l.aNode[nodeId].configCount, 1);
+    }
+
+    CU_ASSERT_EQUAL(bootReport.aPhase[kNmtMnuBootPhaseIdentify].nodeCount, TEST_NODE_COUNT);
+    CU_ASSERT_EQUAL(bootReport.aPhase[kNmtMnuBootPhaseConfig].nodeCount, TEST_NODE_COUNT);
+    CU_ASSERT_EQUAL(bootReport.aPhase[kNmtMnuBootPhaseConfig].maxNodeTime,
+                    TEST_CONFIG_TIME_MS + (4 * TEST_CONFIG_TIME_STEP_MS));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test boot report
+
+The test boots the network and prints the boot report. The configuration
+phase must fit into BootStep1.
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_bootReport(void)
+{
+    tNmtMnuBootReport           bootReport;
+    const tNmtMnuBootPhaseTime* pStep1 = &bootReport.aPhase[kNmtMnuBootPhaseBootStep1];
+    const tNmtMnuBootPhaseTime* pConfig = &bootReport.aPhase[kNmtMnuBootPhaseConfig];
+
+    CU_ASSERT_TRUE_FATAL(runBootStep1(&bootReport));
+
+    printBootReport(&bootReport);
+
+    CU_ASSERT_EQUAL(pStep1->enterCount, 1);
+    CU_ASSERT((INT32)(pConfig->startTime - pStep1->startTime) >= 0);
+    CU_ASSERT((INT32)(pStep1->endTime - pConfig->endTime) >= 0);
+    CU_ASSERT(pConfig->sumNodeTime >= pConfig->nodeCount * TEST_CONFIG_TIME_MS);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Node event callback
+
+The function implements the node event callback of the application. The
+software of every CN is up-to-date. The configuration of a CN is started in the
+background and finished by the test loop after a time which depends on the
+node ID.
+
+\param[in]      nodeId_p            Node ID of the CN.
+\param[in]      nodeEvent_p         Node event.
+\param[in]      nmtState_p          NMT state of the CN.
+\param[in]      errorCode_p         Error code of the event.
+\param[in]      fMandatory_p        Flag for a mandatory CN.
+
+\return The function returns kErrorReject for a started configuration and
+        kErrorOk otherwise.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbNodeEvent(UINT nodeId_p,
+                              tNmtNodeEvent nodeEvent_p,
+                              tNmtState nmtState_p,
+                              UINT16 errorCode_p,
+                              BOOL fMandatory_p)
+{
+    tTestNode*  pNode;
+
+    UNUSED_PARAMETER(nmtState_p);
+    UNUSED_PARAMETER(errorCode_p);
+    UNUSED_PARAMETER(fMandatory_p);
+
+    if ((nodeId_p == 0) || (nodeId_p > TEST_NODE_COUNT))
+        return kErrorOk;
+
+    pNode = &testBoot_l.aNode[nodeId_p];
+    switch (nodeEvent_p)
+    {
+        case kNmtNodeEventUpdateSw:
+            pNode->swCheckCount++;
+            break;
+
+        case kNmtNodeEventCheckConf:
+            pNode->fConfigActive = TRUE;
+            pNode->configDueTime = stub_getTime() + TEST_CONFIG_TIME_MS +
+                                   ((nodeId_p % 5) * TEST_CONFIG_TIME_STEP_MS);
+
+            testBoot_l.activeConfigCount++;
+            if (testBoot_l.activeConfigCount > testBoot_l.peakConfigCount)
+                testBoot_l.peakConfigCount = testBoot_l.activeConfigCount;
+            return kErrorReject;
+
+        default:
+            break;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Boot event callback
+
+The function implements the boot event callback of the application.
+
+\param[in]      bootEvent_p         Boot event.
+\param[in]      nmtState_p          NMT state of the MN.
+\param[in]      errorCode_p         Error code of the event.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbBootEvent(tNmtBootEvent bootEvent_p,
+                              tNmtState nmtState_p,
+                              UINT16 errorCode_p)
+{
+    UNUSED_PARAMETER(nmtState_p);
+    UNUSED_PARAMETER(errorCode_p);
+
+    if (bootEvent_p == kNmtBootEventBootStep1Finish)
+        testBoot_l.fBootStep1Finished = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run BootStep1 of the simulated network
+
+The function initializes the NMT MN module and boots the simulated network
+until BootStep1 is finished. Configurations which are due are reported to the
+NMT MN module every millisecond.
+
+\param[out]     pBootReport_p       Pointer to store the boot report.
+
+\return The function returns TRUE if BootStep1 was finished in time.
+*/
+//------------------------------------------------------------------------------
+static BOOL runBootStep1(tNmtMnuBootReport* pBootReport_p)
+{
+    UINT    nodeId;
+    UINT32  startTime;
+
+    memset(&testBoot_l, 0, sizeof(testBoot_l));
+    stub_resetNetwork(TEST_NODE_COUNT);
+
+    if (nmtmnu_init(cbNodeEvent, cbBootEvent) != kErrorOk)
+        return FALSE;
+
+    stub_changeMnState(kNmtGsResetConfiguration, kNmtEventEnterResetConfig);
+    stub_changeMnState(kNmtMsNotActive, kNmtEventEnterMsNotActive);
+    stub_changeMnState(kNmtMsPreOperational1, kNmtEventTimerMsPreOp1);
+
+    startTime = stub_getTime();
+    while (!testBoot_l.fBootStep1Finished &&
+           ((stub_getTime() - startTime) < TEST_BOOT_TIMEOUT_MS))
+    {
+        stub_processEvents();
+
+        for (nodeId = 1; nodeId <= TEST_NODE_COUNT; nodeId++)
+        {
+            if (!testBoot_l.aNode[nodeId].fConfigActive ||
+                ((INT32)(stub_getTime() - testBoot_l.aNode[nodeId].configDueTime) < 0))
+                continue;
+
+            testBoot_l.aNode[nodeId].fConfigActive = FALSE;
+            testBoot_l.aNode[nodeId].configCount++;
+            testBoot_l.activeConfigCount--;
+            nmtmnu_triggerStateChange(nodeId, kNmtNodeCommandConfOk);
+        }
+
+        stub_processEvents();
+        stub_advanceTime(1);
+    }
+
+    nmtmnu_getBootReport(pBootReport_p);
+
+    return testBoot_l.fBootStep1Finished;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print boot report
+
+The function prints the timing of the boot phases which were entered.
+
+\param[in]      pBootReport_p       Pointer to the boot report.
+*/
+//------------------------------------------------------------------------------
+static void printBootReport(const tNmtMnuBootReport* pBootReport_p)
+{
+    static const char*  apPhaseName[kNmtMnuBootPhaseCount] =
+    {
+        "Identify", "Config", "BootStep1", "BootStep2", "CheckCom", "StartNodes"
+    };
+    const tNmtMnuBootPhaseTime* pPhase;
+    UINT                        phase;
+
+    printf("\n    %u CNs, parallel configurations: peak %u\n",
+           TEST_NODE_COUNT,
+           pBootReport_p->peakParallelConfig);
+    printf("      %-10s %8s %6s %8s %8s\n", "phase", "duration", "CNs", "avg", "max");
+
+    for (phase = 0; phase < kNmtMnuBootPhaseCount; phase++)
+    {
+        pPhase = &pBootReport_p->aPhase[phase];
+        if (pPhase->enterCount == 0)
+            continue;
+
+        printf("      %-10s %5lu ms %6u %5lu ms %5lu ms\n",
+               apPhaseName[phase],
+               (ULONG)(pPhase->endTime - pPhase->startTime),
+               pPhase->nodeCount,
+               (ULONG)((pPhase->nodeCount != 0) ? (pPhase->sumNodeTime / pPhase->nodeCount) : 0),
+               (ULONG)pPhase->maxNodeTime);
+    }
+}
+
+/// \}
@@ -0,0 +1,201 @@
+/**
+********************************************************************************
+\file   test-obdconf.c
+
+\brief  Unit test suite for unit test of OD store/restore module
+
+This file contains the basic functions for the unit tests of the OD store/restore
+module. The OD part archives are stored in a temporary directory.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <CUnit/CUnit.h>
+#include <common/oplkinc.h>
+#include <user/obdconf.h>
+
+#include "test-obdconf.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_ARCHIVE_PATH_TEMPLATE      "/tmp/test_obdconf.XXXXXX"
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static int        obdconfTestsInit(void);
+static int        obdconfTestsCleanup(void);
+static void       removeArchive(const char* pName_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static char aArchivePath_l[] = TEST_ARCHIVE_PATH_TEMPLATE;
+
+static CU_TestInfo obdconfTests[] = {
+    { "Test CRC16 calculation",                                         test_obdconf_calculateCrc16 },
+    { "Test store and restore of an OD part",                           test_obdconf_storeRestore },
+    { "Test validity check of OD part archives",                        test_obdconf_archiveState },
+    { "Measure speed of CRC16, store and restore",                      test_obdconf_benchmark },
+    CU_TEST_INFO_NULL,
+};
+
+static CU_SuiteInfo suites[] = {
+    { "OD Store/Restore Test Suite", obdconfTestsInit,     obdconfTestsCleanup,  obdconfTests },
+    CU_SUITE_INFO_NULL,
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get testsuite info pointer
+
+The function returns a pointer to the testsuite of this unit test.
+
+\return Pointer to testsuite info
+*/
+//------------------------------------------------------------------------------
+CU_pSuiteInfo test_getSuiteInfo(void)
+{
+    return &suites[0];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the OD part archive path
+
+The function returns the temporary directory which holds the OD part archives
+of the tests.
+
+\return Pointer to the archive path
+*/
+//------------------------------------------------------------------------------
+const char* test_obdconf_getArchivePath(void)
+{
+    return aArchivePath_l;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Init function of testsuite
+
+The function does all initializations needed for the tests in this testsuite.
+
+\return Returns an status code
+*/
+//------------------------------------------------------------------------------
+static int obdconfTestsInit(void)
+{
+    if (mkdtemp(aArchivePath_l) == NULL)
+        return 1;
+
+    if (obdconf_init() != kErrorOk)
+        return 1;
+
+    if (obdconf_setBackupArchivePath(aArchivePath_l) != kErrorOk)
+        return 1;
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cleanup function of testsuite
+
+The function does all cleanups needed for the tests in this testsuite.
+
+\return Returns an status code
+*/
+//------------------------------------------------------------------------------
+static int obdconfTestsCleanup(void)
+{
+    obdconf_exit();
+
+    removeArchive("oplkOd_partCom.bin");
+    removeArchive("oplkOd_partMan.bin");
+    removeArchive("oplkOd_partDev.bin");
+    rmdir(aArchivePath_l);
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove an OD part archive
+
+\param[in]      pName_p             File name of the archive.
+*/
+//------------------------------------------------------------------------------
+static void removeArchive(const char* pName_p)
+{
+    char    aFilePath[sizeof(aArchivePath_l) + 32];
+
+    snprintf(aFilePath, sizeof(aFilePath), "%s/%s", aArchivePath_l, pName_p);
+    unlink(aFilePath);
+}
@@ -0,0 +1,469 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the OD store/restore module
+
+This file contains the unit tests of the file based OD store/restore module.
+The tests compare the CRC16 calculation with a byte-wise reference
+implementation, store and restore an OD part and check the validity check of
+the archives. The benchmark measures the CRC16 throughput of both
+implementations and the time needed to store and restore an OD part with
+TEST_OBJECT_COUNT objects.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <user/obdconf.h>
+
+#include "test-obdconf.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_CRC16_POLYNOMIAL           0x1021      // CRC16-CCITT
+#define TEST_CRC_BUFFER_SIZE            (1024 * 1024)
+#define TEST_CRC_ROUNDS                 20
+#define TEST_OBJECT_COUNT               20000
+#define TEST_BENCHMARK_ROUNDS           50
+#define TEST_SIGNATURE                  0x12345678
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void       initCrc16Reference(void);
+static UINT16     calculateCrc16Reference(UINT16 crc_p, const void* pData_p, size_t size_p);
+static size_t     getObjectSize(UINT objectIndex_p);
+static void       getObjectData(UINT objectIndex_p, UINT8* pData_p);
+static tOplkError storePart(tObdPart odPart_p);
+static tOplkError restorePart(tObdPart odPart_p, UINT* pMismatchCount_p);
+static void       fillRandom(UINT8* pData_p, size_t size_p);
+static double     getTime(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT16   aCrc16Table_l[256];
+static UINT8    aCrcBuffer_l[TEST_CRC_BUFFER_SIZE];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the CRC16 calculation
+
+The CRC16 of the standard check string and of random data with all
+alignments and lengths around the block size must match the byte-wise
+reference implementation.
+*/
+//------------------------------------------------------------------------------
+void test_obdconf_calculateCrc16(void)
+{
+    static const char   aCheckString[] = "123456789";
+    size_t              offset;
+    size_t              size;
+    UINT                mismatchCount = 0;
+
+    initCrc16Reference();
+    fillRandom(aCrcBuffer_l, 4096);
+
+    CU_ASSERT_EQUAL(obdconf_calculateCrc16(0, aCheckString, strlen(aCheckString)), 0x31C3);
+    CU_ASSERT_EQUAL(obdconf_calculateCrc16(0, aCrcBuffer_l, 0), 0);
+
+    for (offset = 0; offset < 8; offset++)
+    {
+        for (size = 0; size < 100; size++)
+        {
+            if ((obdconf_calculateCrc16(0, &aCrcBuffer_l[offset], size) !=
+                 calculateCrc16Reference(0, &aCrcBuffer_l[offset], size)) ||
+                (obdconf_calculateCrc16(0xFFFF, &aCrcBuffer_l[offset], size) !=
+                 calculateCrc16Reference(0xFFFF, &aCrcBuffer_l[offset], size)))
+            {
+                mismatchCount++;
+            }
+        }
+    }
+    CU_ASSERT_EQUAL(mismatchCount, 0);
+
+    CU_ASSERT_EQUAL(obdconf_calculateCrc16(0x1D0F, aCrcBuffer_l, 4096),
+                    calculateCrc16Reference(0x1D0F, aCrcBuffer_l, 4096));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the store and restore of an OD part
+
+The objects of an OD part are stored and must be restored unchanged.
+*/
+//------------------------------------------------------------------------------
+void test_obdconf_storeRestore(void)
+{
+    UINT    mismatchCount;
+
+    CU_ASSERT_EQUAL_FATAL(storePart(kObdPartGen), kErrorOk);
+    CU_ASSERT_EQUAL(obdconf_getPartArchiveState(kObdPartGen, TEST_SIGNATURE), kErrorOk);
+
+    CU_ASSERT_EQUAL(restorePart(kObdPartGen, &mismatchCount), kErrorOk);
+    CU_ASSERT_EQUAL(mismatchCount, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the validity check of OD part archives
+
+An archive with a different signature is obsolete. An archive with corrupted
+data, a deleted archive and an opened archive are invalid.
+*/
+//------------------------------------------------------------------------------
+void test_obdconf_archiveState(void)
+{
+    UINT32  value = 5;
+    char    aFilePath[256];
+    FILE*   pFile;
+
+    CU_ASSERT_EQUAL_FATAL(obdconf_createPart(kObdPartDev, 7), kErrorOk);
+    CU_ASSERT_EQUAL(obdconf_storePart(kObdPartDev, &value, sizeof(value)), kErrorOk);
+    CU_ASSERT_EQUAL(obdconf_getPartArchiveState(kObdPartDev, 7), kErrorObdStoreInvalidState);
+    CU_ASSERT_EQUAL_FATAL(obdconf_closePart(kObdPartDev), kErrorOk);
+
+    CU_ASSERT_EQUAL(obdconf_getPartArchiveState(kObdPartDev, 7), kErrorOk);
+    CU_ASSERT_EQUAL(obdconf_getPartArchiveState(kObdPartDev, 8), kErrorObdStoreDataObsolete);
+
+    // Corrupt the stored object
+    snprintf(aFilePath, sizeof(aFilePath), "%s/oplkOd_partDev.bin", test_obdconf_getArchivePath());
+    pFile = fopen(aFilePath, "r+b");
+    CU_ASSERT_FATAL(pFile != NULL);
+    fseek(pFile, 9, SEEK_SET);
+    fputc(0x55, pFile);
+    fclose(pFile);
+    CU_ASSERT_EQUAL(obdconf_getPartArchiveState(kObdPartDev, 7), kErrorObdStoreHwError);
+
+    CU_ASSERT_EQUAL(obdconf_deletePart(kObdPartDev), kErrorOk);
+    CU_ASSERT_NOT_EQUAL(obdconf_getPartArchiveState(kObdPartDev, 7), kErrorOk);
+
+    CU_ASSERT_NOT_EQUAL(obdconf_createPart(kObdPartAll, 7), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Measure the speed of CRC16, store and restore
+
+The test measures the CRC16 throughput of the slicing-by-8 implementation and
+of the byte-wise reference implementation. It also measures the time needed to
+store and restore an OD part with TEST_OBJECT_COUNT objects. The store time
+includes writing the archive file to disk.
+*/
+//------------------------------------------------------------------------------
+void test_obdconf_benchmark(void)
+{
+    double      startTime;
+    double      crcTime;
+    double      referenceTime;
+    double      storeTime = 0.0;
+    double      restoreTime = 0.0;
+    UINT16      crc = 0;
+    UINT16      referenceCrc = 0;
+    UINT        round;
+    UINT        mismatchCount;
+    tOplkError  ret = kErrorOk;
+
+    initCrc16Reference();
+    fillRandom(aCrcBuffer_l, sizeof(aCrcBuffer_l));
+
+    startTime = getTime();
+    for (round = 0; round < TEST_CRC_ROUNDS; round++)
+        referenceCrc = calculateCrc16Reference(referenceCrc, aCrcBuffer_l, sizeof(aCrcBuffer_l));
+    referenceTime = getTime() - startTime;
+
+    startTime = getTime();
+    for (round = 0; round < TEST_CRC_ROUNDS; round++)
+        crc = obdconf_calculateCrc16(crc, aCrcBuffer_l, sizeof(aCrcBuffer_l));
+    crcTime = getTime() - startTime;
+
+    CU_ASSERT_EQUAL(crc, referenceCrc);
+
+    for (round = 0; round < TEST_BENCHMARK_ROUNDS; round++)
+    {
+        startTime = getTime();
+        ret |= storePart(kObdPartGen);
+        storeTime += getTime() - startTime;
+
+        startTime = getTime();
+        ret |= restorePart(kObdPartGen, &mismatchCount);
+        restoreTime += getTime() - startTime;
+        CU_ASSERT_EQUAL(mismatchCount, 0);
+    }
+
+    CU_ASSERT_EQUAL(ret, kErrorOk);
+
+    printf("\n    CRC16 over %u KiB: byte-wise %.0f MB/s, slicing-by-8 %.0f MB/s\n",
+           (UINT)(sizeof(aCrcBuffer_l) / 1024),
+           (double)TEST_CRC_ROUNDS * sizeof(aCrcBuffer_l) / referenceTime / 1e6,
+           (double)TEST_CRC_ROUNDS * sizeof(aCrcBuffer_l) / crcTime / 1e6);
+    printf("    OD part with %u objects: store %.0f us, restore %.0f us\n",
+           TEST_OBJECT_COUNT,
+           storeTime * 1e6 / TEST_BENCHMARK_ROUNDS,
+           restoreTime * 1e6 / TEST_BENCHMARK_ROUNDS);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the CRC16 table of the reference implementation
+
+The function calculates the byte-wise CRC16-CCITT table.
+*/
+//------------------------------------------------------------------------------
+static void initCrc16Reference(void)
+{
+    UINT    value;
+    UINT    bit;
+    UINT16  crc;
+
+    for (value = 0; value < 256; value++)
+    {
+        crc = (UINT16)(value << 8);
+        for (bit = 0; bit < 8; bit++)
+        {
+            if ((crc & 0x8000) != 0)
+                crc = (UINT16)((crc << 1) ^ TEST_CRC16_POLYNOMIAL);
+            else
+                crc = (UINT16)(crc << 1);
+        }
+        aCrc16Table_l[value] = crc;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reference implementation of the CRC16 calculation
+
+The function calculates the CRC16 byte by byte, as obdconf_calculateCrc16()
+did before the slicing-by-8 implementation.
+
+\param[in]      crc_p               Initialized value of CRC.
+\param[in]      pData_p             Pointer to the data buffer.
+\param[in]      size_p              Size of data in the buffer, in bytes.
+
+\return The function returns the CRC16 value.
+*/
+//------------------------------------------------------------------------------
+static UINT16 calculateCrc16Reference(UINT16 crc_p, const void* pData_p, size_t size_p)
+{
+    const UINT8*    pData = (const UINT8*)pData_p;
+
+    while (size_p--)
+    {
+        crc_p = (UINT16)(aCrc16Table_l[((crc_p >> 8) ^ *pData) & 0xFF] ^ (crc_p << 8));
+        pData++;
+    }
+
+    return crc_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the size of a test object
+
+\param[in]      objectIndex_p       Index of the object.
+
+\return The function returns the size of the object in bytes.
+*/
+//------------------------------------------------------------------------------
+static size_t getObjectSize(UINT objectIndex_p)
+{
+    static const size_t aObjectSize[] = {1, 2, 4, 8};
+
+    return aObjectSize[objectIndex_p % 4];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the data of a test object
+
+\param[in]      objectIndex_p       Index of the object.
+\param[out]     pData_p             Pointer to store the object data.
+*/
+//------------------------------------------------------------------------------
+static void getObjectData(UINT objectIndex_p, UINT8* pData_p)
+{
+    size_t  i;
+
+    for (i = 0; i < getObjectSize(objectIndex_p); i++)
+        pData_p[i] = (UINT8)((objectIndex_p * 7) + i);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store the test objects into an OD part archive
+
+\param[in]      odPart_p            OD part to store.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError storePart(tObdPart odPart_p)
+{
+    tOplkError  ret;
+    UINT8       aData[8];
+    UINT        objectIndex;
+
+    ret = obdconf_createPart(odPart_p, TEST_SIGNATURE);
+    if (ret != kErrorOk)
+        return ret;
+
+    for (objectIndex = 0; objectIndex < TEST_OBJECT_COUNT; objectIndex++)
+    {
+        getObjectData(objectIndex, aData);
+        ret = obdconf_storePart(odPart_p, aData, getObjectSize(objectIndex));
+        if (ret != kErrorOk)
+        {
+            obdconf_closePart(odPart_p);
+            return ret;
+        }
+    }
+
+    return obdconf_closePart(odPart_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Restore the test objects from an OD part archive
+
+\param[in]      odPart_p            OD part to restore.
+\param[out]     pMismatchCount_p    Pointer to store the number of objects
+                                    which differ from the stored ones.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError restorePart(tObdPart odPart_p, UINT* pMismatchCount_p)
+{
+    tOplkError  ret;
+    UINT8       aExpected[8];
+    UINT8       aData[8];
+    UINT        objectIndex;
+
+    *pMismatchCount_p = 0;
+
+    ret = obdconf_getPartArchiveState(odPart_p, TEST_SIGNATURE);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = obdconf_openReadPart(odPart_p);
+    if (ret != kErrorOk)
+        return ret;
+
+    for (objectIndex = 0; objectIndex < TEST_OBJECT_COUNT; objectIndex++)
+    {
+        ret = obdconf_loadPart(odPart_p, aData, getObjectSize(objectIndex));
+        if (ret != kErrorOk)
+            break;
+
+        getObjectData(objectIndex, aExpected);
+        if (memcmp(aData, aExpected, getObjectSize(objectIndex)) != 0)
+            (*pMismatchCount_p)++;
+    }
+
+    obdconf_closePart(odPart_p);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill a buffer with random data
+
+\param[out]     pData_p             Pointer to the buffer.
+\param[in]      size_p              Size of the buffer.
+*/
+//------------------------------------------------------------------------------
+static void fillRandom(UINT8* pData_p, size_t size_p)
+{
+    size_t  i;
+
+    srand(1);
+    for (i = 0; i < size_p; i++)
+        pData_p[i] = (UINT8)rand();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the monotonic time
+
+\return The function returns the monotonic time in seconds.
+*/
+//------------------------------------------------------------------------------
+static double getTime(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
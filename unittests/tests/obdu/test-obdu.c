@@ -0,0 +1,196 @@
+/**
+********************************************************************************
+\file   test-obdu.c
+
+\brief  Unit test suite for unit test of OD user module
+
+This file contains the basic functions for the unit tests of the OD user module.
+The tests use the object dictionary of the CiA302-4 MN.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <CUnit/CUnit.h>
+#include <common/oplkinc.h>
+#include <user/obdu.h>
+#include <obdcreate/obdcreate.h>
+
+#include "test-obdu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static int          obduTestsInit(void);
+static int          obduTestsCleanup(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdInitParam    obdInitParam_l;
+
+static CU_TestInfo obduTests[] = {
+    { "Test lookup of all indices",                                     test_obdu_getIndex },
+    { "Test lookup of all sub-indices",                                 test_obdu_getSubindex },
+    { "Test lookups in an OD with gaps",                                test_obdu_gaps },
+    { "Measure speed of OD lookups and accesses",                       test_obdu_benchmark },
+    CU_TEST_INFO_NULL,
+};
+
+static CU_SuiteInfo suites[] = {
+    { "OD User Module Test Suite", obduTestsInit,          obduTestsCleanup,     obduTests },
+    CU_SUITE_INFO_NULL,
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get testsuite info pointer
+
+The function returns a pointer to the testsuite of this unit test.
+
+\return Pointer to testsuite info
+*/
+//------------------------------------------------------------------------------
+CU_pSuiteInfo test_getSuiteInfo(void)
+{
+    return &suites[0];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the OD initialization parameters
+
+The function returns the initialization parameters of the OD which is used by
+the tests.
+
+\return Pointer to the OD initialization parameters
+*/
+//------------------------------------------------------------------------------
+const tObdInitParam* test_obdu_getInitParam(void)
+{
+    return &obdInitParam_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  OD access callback
+
+The callback allows all accesses to the OD.
+
+\param[in,out]  pParam_p            Pointer to the OD callback parameters.
+\param[in]      fUserEvent_p        Flag of the object indicating a user event.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+tOplkError test_obdu_cbObdAccess(tObdCbParam* pParam_p, BOOL fUserEvent_p)
+{
+    UNUSED_PARAMETER(pParam_p);
+    UNUSED_PARAMETER(fUserEvent_p);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Init function of testsuite
+
+The function does all initializations needed for the tests in this testsuite.
+
+\return Returns an status code
+*/
+//------------------------------------------------------------------------------
+static int obduTestsInit(void)
+{
+    if (obdcreate_initObd(&obdInitParam_l) != kErrorOk)
+        return 1;
+
+    if (obdu_init(&obdInitParam_l, test_obdu_cbObdAccess) != kErrorOk)
+        return 1;
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cleanup function of testsuite
+
+The function does all cleanups needed for the tests in this testsuite.
+
+\return Returns an status code
+*/
+//------------------------------------------------------------------------------
+static int obduTestsCleanup(void)
+{
+    obdu_exit();
+
+    return 0;
+}
@@ -0,0 +1,617 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the OD user module
+
+This file contains the unit tests of the index and sub-index lookup of the OD
+user module. The results of all lookups are compared with a reference
+implementation which binary-searches the OD parts and scans the sub-index
+tables. A small OD checks the scan of records with gaps and the indices below
+the first entry of an OD part, which caused an underflow of the previous binary
+search. The benchmark measures the time of a lookup of both implementations and of
+typical OD accesses.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <user/obdu.h>
+
+#include "test-obdu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#if (CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART == FALSE)
+#define TEST_DEVICE_PART_END            0x9FFF
+#else
+#define TEST_DEVICE_PART_END            0xFFFF
+#endif
+
+#define TEST_MAX_INDEX_COUNT            1024
+#define TEST_LOOKUP_ROUNDS              2000
+#define TEST_ACCESS_CALLS               2000000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Object accessed by the benchmark
+*/
+typedef struct
+{
+    UINT                index;              ///< Index of the object
+    UINT                subIndex;           ///< Sub-index of the object
+} tTestObject;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void                 initReference(void);
+static UINT                 getPartIndexNum(const tObdEntry* pObdEntry_p);
+static const tObdEntry*     getIndexReference(UINT index_p);
+static const tObdSubEntry*  getSubindexReference(const tObdEntry* pObdEntry_p,
+                                                 UINT subIndex_p);
+static UINT                 getAllIndices(UINT* pIndex_p, UINT maxCount_p);
+static double               getTime(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT                 numGeneric_l;
+static UINT                 numManufacturer_l;
+static UINT                 numDevice_l;
+
+// Mix of objects which are accessed during the boot-up of CNs
+static const tTestObject    aTestObject_l[] =
+{
+    {0x1006,   0}, {0x1018,   1}, {0x1F81, 100}, {0x1F8E, 200}, {0x1F92,  50},
+    {0x1C14,   0}, {0x1400,   1}, {0x1600,   5}, {0x1800,   1}, {0x1A00,   3},
+    {0x1F9F,   1}, {0x1F26,  77}, {0x1F80,   0}, {0x1F98,   5}, {0x1020,   1},
+    {0x1F9E,   0}, {0xA000,   1}, {0xA040,   1}, {0xA0C0,   2}, {0x1F8B,   9},
+};
+
+// Small OD with a record with a gap in the sub-index numbering
+static const UINT8          aRecordDefault_l[3] = {3, 0x11, 0x33};
+static UINT8                aRecordData_l[3];
+static const UINT8          varDefault_l = 0x55;
+static UINT8                varData_l;
+
+static tObdSubEntry         aRecordSubEntry_l[] =
+{
+    {0, kObdTypeUInt8, kObdAccR,  &aRecordDefault_l[0], &aRecordData_l[0]},
+    {1, kObdTypeUInt8, kObdAccRW, &aRecordDefault_l[1], &aRecordData_l[1]},
+    {3, kObdTypeUInt8, kObdAccRW, &aRecordDefault_l[2], &aRecordData_l[2]},
+};
+
+static tObdSubEntry         varSubEntry_l =
+{
+    0, kObdTypeUInt8, kObdAccRW, &varDefault_l, &varData_l
+};
+
+static tObdEntry            aGenericPart_l[] =
+{
+    {0x1000,                &varSubEntry_l,         1,  FALSE},
+    {0x1010,                aRecordSubEntry_l,      3,  FALSE},
+    {OBD_TABLE_INDEX_END,   NULL,                   0,  FALSE},
+};
+
+static tObdEntry            aManufacturerPart_l[] =
+{
+    {OBD_TABLE_INDEX_END,   NULL,                   0,  FALSE},
+};
+
+static tObdEntry            aDevicePart_l[] =
+{
+    {0x6100,                &varSubEntry_l,         1,  FALSE},
+    {OBD_TABLE_INDEX_END,   NULL,                   0,  FALSE},
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the lookup of all indices
+
+All indices of the OD must be found and all other indices must be rejected
+with the error code of their index range. The indices below the first entry of
+an OD part are checked explicitly.
+*/
+//------------------------------------------------------------------------------
+void test_obdu_getIndex(void)
+{
+    const tObdInitParam*    pInitParam = test_obdu_getInitParam();
+    UINT                    index;
+    UINT                    mismatchCount = 0;
+    tObdAccess              access;
+    tOplkError              ret;
+    tOplkError              expectedRet;
+
+    initReference();
+
+    for (index = 0; index <= 0xFFFF; index++)
+    {
+        if (getIndexReference(index) != NULL)
+            expectedRet = kErrorOk;
+        else if ((index >= 0x1000) && (index < TEST_DEVICE_PART_END))
+            expectedRet = kErrorObdIndexNotExist;
+        else
+            expectedRet = kErrorObdIllegalPart;
+
+        ret = obdu_getAccessType(index, 0, &access);
+        if (ret != expectedRet)
+            mismatchCount++;
+    }
+    CU_ASSERT_EQUAL(mismatchCount, 0);
+
+    // Indices below the first entry of a part
+    CU_ASSERT_EQUAL_FATAL(pInitParam->pGenericPart->index, 0x1000);
+    CU_ASSERT_TRUE_FATAL(pInitParam->pDevicePart->index > 0x6000);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x0FFF, 0, &access), kErrorObdIllegalPart);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x2000, 0, &access), kErrorObdIndexNotExist);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x6000, 0, &access), kErrorObdIndexNotExist);
+    CU_ASSERT_EQUAL(obdu_getAccessType(pInitParam->pDevicePart->index - 1, 0, &access),
+                    kErrorObdIndexNotExist);
+    CU_ASSERT(obdu_getObjectDataPtr(0x6000, 0) == NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the lookup of all sub-indices
+
+All sub-indices of all objects of the OD must resolve to the same sub-index
+entry as the reference implementation. This covers the direct access to array
+elements and records without gaps.
+*/
+//------------------------------------------------------------------------------
+void test_obdu_getSubindex(void)
+{
+    UINT                    aIndex[TEST_MAX_INDEX_COUNT];
+    UINT                    indexCount;
+    UINT                    i;
+    UINT                    subIndex;
+    UINT                    mismatchCount = 0;
+    const tObdEntry*        pObdEntry;
+    const tObdSubEntry*     pSubEntry;
+    tObdAccess              access;
+    tObdType                type;
+    tOplkError              ret;
+
+    initReference();
+
+    indexCount = getAllIndices(aIndex, TEST_MAX_INDEX_COUNT);
+    CU_ASSERT_TRUE_FATAL(indexCount > 0);
+
+    for (i = 0; i < indexCount; i++)
+    {
+        pObdEntry = getIndexReference(aIndex[i]);
+
+        for (subIndex = 0; subIndex <= 0xFF; subIndex++)
+        {
+            pSubEntry = getSubindexReference(pObdEntry, subIndex);
+
+            ret = obdu_getAccessType(aIndex[i], subIndex, &access);
+            if (pSubEntry == NULL)
+            {
+                if (ret != kErrorObdSubindexNotExist)
+                    mismatchCount++;
+                continue;
+            }
+
+            if ((ret != kErrorOk) || (access != pSubEntry->access))
+            {
+                mismatchCount++;
+                continue;
+            }
+
+            ret = obdu_getType(aIndex[i], subIndex, &type);
+            if ((ret != kErrorOk) || (type != pSubEntry->type))
+            {
+                mismatchCount++;
+                continue;
+            }
+
+            // The data of a plain object is located at its current pointer
+            if (((access & (kObdAccArray | kObdAccVar | kObdAccConst)) == 0) &&
+                (type != kObdTypeVString) &&
+                (type != kObdTypeOString) &&
+                (type != kObdTypeDomain) &&
+                (obdu_getObjectDataPtr(aIndex[i], subIndex) != pSubEntry->pCurrent))
+            {
+                mismatchCount++;
+            }
+        }
+    }
+    CU_ASSERT_EQUAL(mismatchCount, 0);
+
+    // Array with 254 elements
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x1F81, 254, &access), kErrorOk);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x1F81, 255, &access), kErrorObdSubindexNotExist);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the lookups in an OD with gaps
+
+The test initializes the OD module with a small OD. It contains a record with a
+gap in the sub-index numbering, which must be resolved by scanning the
+sub-index table, and a device part whose first index is above 0x6000. Then the
+OD of the test suite is initialized again.
+*/
+//------------------------------------------------------------------------------
+void test_obdu_gaps(void)
+{
+    tObdInitParam   initParam;
+    tObdAccess      access;
+    UINT8           value;
+    tObdSize        size;
+
+    OPLK_MEMSET(&initParam, 0, sizeof(initParam));
+    initParam.pGenericPart = aGenericPart_l;
+    initParam.pManufacturerPart = aManufacturerPart_l;
+    initParam.pDevicePart = aDevicePart_l;
+
+    CU_ASSERT_EQUAL_FATAL(obdu_exit(), kErrorOk);
+    CU_ASSERT_EQUAL_FATAL(obdu_init(&initParam, test_obdu_cbObdAccess), kErrorOk);
+
+    CU_ASSERT(obdu_getObjectDataPtr(0x1010, 0) == &aRecordData_l[0]);
+    CU_ASSERT(obdu_getObjectDataPtr(0x1010, 1) == &aRecordData_l[1]);
+    CU_ASSERT(obdu_getObjectDataPtr(0x1010, 2) == NULL);
+    CU_ASSERT(obdu_getObjectDataPtr(0x1010, 3) == &aRecordData_l[2]);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x1010, 2, &access), kErrorObdSubindexNotExist);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x1010, 4, &access), kErrorObdSubindexNotExist);
+
+    size = sizeof(value);
+    CU_ASSERT_EQUAL(obdu_readEntry(0x1010, 3, &value, &size), kErrorOk);
+    CU_ASSERT_EQUAL(value, aRecordDefault_l[2]);
+
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x0FFF, 0, &access), kErrorObdIllegalPart);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x1001, 0, &access), kErrorObdIndexNotExist);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x2000, 0, &access), kErrorObdIndexNotExist);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x6000, 0, &access), kErrorObdIndexNotExist);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x60FF, 0, &access), kErrorObdIndexNotExist);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x6100, 0, &access), kErrorOk);
+    CU_ASSERT_EQUAL(obdu_getAccessType(0x6101, 0, &access), kErrorObdIndexNotExist);
+
+    CU_ASSERT_EQUAL(obdu_exit(), kErrorOk);
+    CU_ASSERT_EQUAL(obdu_init(test_obdu_getInitParam(), test_obdu_cbObdAccess), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Measure the speed of OD lookups and accesses
+
+The benchmark looks up all objects of the OD with the OD user module and with
+the reference implementation and prints the time of a lookup. It also prints
+the time of typical OD reads and writes and of getting data pointers.
+*/
+//------------------------------------------------------------------------------
+void test_obdu_benchmark(void)
+{
+    UINT                    aIndex[TEST_MAX_INDEX_COUNT];
+    UINT                    indexCount;
+    UINT                    round;
+    UINT                    i;
+    UINT                    errorCount = 0;
+    UINT8                   aData[256];
+    tObdSize                size;
+    tObdAccess              access;
+    const tTestObject*      pObject;
+    double                  startTime;
+    double                  lookupTime;
+    double                  referenceTime;
+    double                  readTime;
+    double                  readWriteTime;
+    double                  dataPtrTime;
+
+    initReference();
+
+    indexCount = getAllIndices(aIndex, TEST_MAX_INDEX_COUNT);
+    CU_ASSERT_TRUE_FATAL(indexCount > 0);
+
+    startTime = getTime();
+    for (round = 0; round < TEST_LOOKUP_ROUNDS; round++)
+    {
+        for (i = 0; i < indexCount; i++)
+        {
+            if (getSubindexReference(getIndexReference(aIndex[i]), 0) == NULL)
+                errorCount++;
+        }
+    }
+    referenceTime = getTime() - startTime;
+
+    startTime = getTime();
+    for (round = 0; round < TEST_LOOKUP_ROUNDS; round++)
+    {
+        for (i = 0; i < indexCount; i++)
+        {
+            if (obdu_getAccessType(aIndex[i], 0, &access) != kErrorOk)
+                errorCount++;
+        }
+    }
+    lookupTime = getTime() - startTime;
+
+    startTime = getTime();
+    for (i = 0; i < TEST_ACCESS_CALLS; i++)
+    {
+        pObject = &aTestObject_l[i % tabentries(aTestObject_l)];
+        size = sizeof(aData);
+        if (obdu_readEntry(pObject->index, pObject->subIndex, aData, &size) != kErrorOk)
+            errorCount++;
+    }
+    readTime = getTime() - startTime;
+
+    startTime = getTime();
+    for (i = 0; i < TEST_ACCESS_CALLS; i++)
+    {
+        pObject = &aTestObject_l[i % tabentries(aTestObject_l)];
+        size = sizeof(aData);
+        if ((obdu_readEntry(pObject->index, pObject->subIndex, aData, &size) != kErrorOk) ||
+            (obdu_writeEntry(pObject->index, pObject->subIndex, aData, size) != kErrorOk))
+            errorCount++;
+    }
+    readWriteTime = getTime() - startTime;
+
+    startTime = getTime();
+    for (i = 0; i < TEST_ACCESS_CALLS; i++)
+    {
+        pObject = &aTestObject_l[i % tabentries(aTestObject_l)];
+        if (obdu_getObjectDataPtr(pObject->index, pObject->subIndex) == NULL)
+            errorCount++;
+    }
+    dataPtrTime = getTime() - startTime;
+
+    // The benchmark only accesses existing objects
+    CU_ASSERT_EQUAL(errorCount, 0);
+
+    printf("\n    Lookup of %u objects: reference %.1f ns, obdu %.1f ns\n",
+           indexCount,
+           referenceTime * 1e9 / ((double)TEST_LOOKUP_ROUNDS * indexCount),
+           lookupTime * 1e9 / ((double)TEST_LOOKUP_ROUNDS * indexCount));
+    printf("    %u mixed accesses: read %.1f ns, read+write %.1f ns, data pointer %.1f ns\n",
+           (UINT)tabentries(aTestObject_l),
+           readTime * 1e9 / TEST_ACCESS_CALLS,
+           readWriteTime * 1e9 / TEST_ACCESS_CALLS,
+           dataPtrTime * 1e9 / TEST_ACCESS_CALLS);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the reference implementation
+
+The function determines the number of index entries of the OD parts.
+*/
+//------------------------------------------------------------------------------
+static void initReference(void)
+{
+    const tObdInitParam*    pInitParam = test_obdu_getInitParam();
+
+    numGeneric_l = getPartIndexNum(pInitParam->pGenericPart);
+    numManufacturer_l = getPartIndexNum(pInitParam->pManufacturerPart);
+    numDevice_l = getPartIndexNum(pInitParam->pDevicePart);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the number of index entries of an OD part
+
+\param[in]      pObdEntry_p         Pointer to the first index entry of the part.
+
+\return The function returns the number of index entries.
+*/
+//------------------------------------------------------------------------------
+static UINT getPartIndexNum(const tObdEntry* pObdEntry_p)
+{
+    UINT    numEntries = 0;
+
+    while (pObdEntry_p[numEntries].index != OBD_TABLE_INDEX_END)
+        numEntries++;
+
+    return numEntries;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Look up an index entry with the reference implementation
+
+The function binary-searches the OD part which covers the index.
+
+\param[in]      index_p             Index to search.
+
+\return The function returns the pointer to the index entry or NULL if the
+        index doesn't exist.
+*/
+//------------------------------------------------------------------------------
+static const tObdEntry* getIndexReference(UINT index_p)
+{
+    const tObdInitParam*    pInitParam = test_obdu_getInitParam();
+    const tObdEntry*        pObdEntry;
+    UINT                    first;
+    UINT                    last;
+    UINT                    middle;
+
+    if ((index_p >= 0x1000) && (index_p < 0x2000))
+    {
+        pObdEntry = pInitParam->pGenericPart;
+        last = numGeneric_l;
+    }
+    else if ((index_p >= 0x2000) && (index_p < 0x6000))
+    {
+        pObdEntry = pInitParam->pManufacturerPart;
+        last = numManufacturer_l;
+    }
+    else if ((index_p >= 0x6000) && (index_p < TEST_DEVICE_PART_END))
+    {
+        pObdEntry = pInitParam->pDevicePart;
+        last = numDevice_l;
+    }
+    else
+        return NULL;
+
+    // Search in [first, last) so that the bounds cannot underflow
+    first = 0;
+    while (first < last)
+    {
+        middle = (first + last) >> 1;
+        if (pObdEntry[middle].index == index_p)
+            return &pObdEntry[middle];
+        else if (pObdEntry[middle].index < index_p)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Look up a sub-index entry with the reference implementation
+
+The function scans the sub-index table of an object. All elements of an array
+share the sub-index entry of the first element.
+
+\param[in]      pObdEntry_p         Pointer to the index entry.
+\param[in]      subIndex_p          Sub-index to search.
+
+\return The function returns the pointer to the sub-index entry or NULL if the
+        sub-index doesn't exist.
+*/
+//------------------------------------------------------------------------------
+static const tObdSubEntry* getSubindexReference(const tObdEntry* pObdEntry_p,
+                                                UINT subIndex_p)
+{
+    const tObdSubEntry* pSubEntry;
+    UINT                i;
+
+    if (pObdEntry_p == NULL)
+        return NULL;
+
+    for (i = 0; i < pObdEntry_p->count; i++)
+    {
+        pSubEntry = &pObdEntry_p->pSubIndex[i];
+        if ((pSubEntry->access & kObdAccArray) != 0)
+        {
+            if (subIndex_p < pObdEntry_p->count)
+                return pSubEntry;
+        }
+        else if (pSubEntry->subIndex == subIndex_p)
+            return pSubEntry;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get all indices of the OD
+
+\param[out]     pIndex_p            Pointer to store the indices.
+\param[in]      maxCount_p          Maximum number of indices to store.
+
+\return The function returns the number of stored indices.
+*/
+//------------------------------------------------------------------------------
+static UINT getAllIndices(UINT* pIndex_p, UINT maxCount_p)
+{
+    const tObdInitParam*    pInitParam = test_obdu_getInitParam();
+    const tObdEntry*        apPart[3];
+    const tObdEntry*        pObdEntry;
+    UINT                    count = 0;
+    UINT                    i;
+
+    apPart[0] = pInitParam->pGenericPart;
+    apPart[1] = pInitParam->pManufacturerPart;
+    apPart[2] = pInitParam->pDevicePart;
+
+    for (i = 0; i < tabentries(apPart); i++)
+    {
+        for (pObdEntry = apPart[i];
+             (pObdEntry->index != OBD_TABLE_INDEX_END) && (count < maxCount_p);
+             pObdEntry++)
+        {
+            pIndex_p[count] = pObdEntry->index;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the monotonic time
+
+\return The function returns the monotonic time in seconds.
+*/
+//------------------------------------------------------------------------------
+static double getTime(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
@@ -0,0 +1,496 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the PDO CAL triple buffers
+
+This file contains the unit tests of the triple buffered PDO memory, which the
+kernel layer (pdokcal) and the user layer (pdoucal) share. The tests check the
+layout selected by CONFIG_PDO_CACHE_LINE_SIZE and the transfer of PDOs in both
+directions. The benchmark runs the kernel and the user layer in two threads
+and measures the CPU time of a cycle of each layer. The test is built with
+cache line aligned channels (test_pdocal) and with packed channels
+(test_pdocal_packed) to compare both layouts.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <common/pdo.h>
+#include <kernel/pdokcal.h>
+#include <user/pdoucal.h>
+
+#include "test-pdocal.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_RX_CHANNEL_COUNT           239         // One RPDO channel for each CN
+#define TEST_TX_CHANNEL_COUNT           1           // TPDO channel of the PRes
+#define TEST_RX_CHANNEL_SIZE            8
+#define TEST_TX_CHANNEL_SIZE            40
+#define TEST_BENCHMARK_CYCLES           20000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Result of a benchmark thread
+
+The structure contains the result of the kernel or user layer thread of the
+benchmark.
+*/
+typedef struct
+{
+    double      cpuTime;                ///< CPU time of the thread in seconds
+    UINT        errorCount;             ///< Number of inconsistent PDOs read by the thread
+} tThreadResult;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError initPdoMem(void);
+static BOOL       checkPdo(const UINT8* pPdo_p, UINT8 value_p, UINT size_p);
+static void*      kernelThread(void* pArg_p);
+static void*      userThread(void* pArg_p);
+static int        createThread(pthread_t* pThread_p, void* (*pfnThread_p)(void*), int cpu_p);
+static double     getThreadTime(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tPdoChannel          aRxPdoChannel_l[TEST_RX_CHANNEL_COUNT];
+static tPdoChannel          aTxPdoChannel_l[TEST_TX_CHANNEL_COUNT];
+static tPdoChannelSetup     pdoChannelSetup_l;
+static pthread_barrier_t    startBarrier_l;
+static tThreadResult        kernelResult_l;
+static tThreadResult        userResult_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the layout of the PDO memory
+
+If CONFIG_PDO_CACHE_LINE_SIZE is set, the buffer information and the payload
+of every channel must start at a cache line boundary. Otherwise the channels
+must be packed.
+*/
+//------------------------------------------------------------------------------
+void test_pdocal_layout(void)
+{
+    UINT8*                  pMem;
+    size_t                  memSize;
+    const tPdoMemRegion*    pPdoMem;
+    UINT8*                  pPdo;
+    UINT                    channelId;
+
+    CU_ASSERT_EQUAL_FATAL(initPdoMem(), kErrorOk);
+    CU_ASSERT_EQUAL_FATAL(pdokcal_getPdoMemRegion(&pMem, &memSize), kErrorOk);
+    pPdoMem = (const tPdoMemRegion*)pMem;
+
+#if (CONFIG_PDO_CACHE_LINE_SIZE > 0)
+    CU_ASSERT_EQUAL(sizeof(tPdoBufferInfo), CONFIG_PDO_CACHE_LINE_SIZE);
+    CU_ASSERT_EQUAL(offsetof(tPdoMemRegion, rxChannelInfo) % CONFIG_PDO_CACHE_LINE_SIZE, 0);
+    CU_ASSERT_EQUAL((size_t)pMem % CONFIG_PDO_CACHE_LINE_SIZE, 0);
+
+    for (channelId = 0; channelId < TEST_RX_CHANNEL_COUNT; channelId++)
+    {
+        CU_ASSERT_EQUAL(pPdoMem->rxChannelInfo[channelId].channelOffset % CONFIG_PDO_CACHE_LINE_SIZE, 0);
+        CU_ASSERT_EQUAL(pdoucal_getRxPdo(&pPdo, channelId, TEST_RX_CHANNEL_SIZE), kErrorOk);
+        CU_ASSERT_EQUAL((size_t)pPdo % CONFIG_PDO_CACHE_LINE_SIZE, 0);
+    }
+
+    CU_ASSERT_EQUAL(pPdoMem->txChannelInfo[0].channelOffset % CONFIG_PDO_CACHE_LINE_SIZE, 0);
+    CU_ASSERT_EQUAL((size_t)pdoucal_getTxPdoAdrs(0) % CONFIG_PDO_CACHE_LINE_SIZE, 0);
+#else
+    for (channelId = 0; channelId < TEST_RX_CHANNEL_COUNT; channelId++)
+    {
+        CU_ASSERT_EQUAL(pPdoMem->rxChannelInfo[channelId].channelOffset, channelId * TEST_RX_CHANNEL_SIZE);
+        CU_ASSERT_EQUAL(pdoucal_getRxPdo(&pPdo, channelId, TEST_RX_CHANNEL_SIZE), kErrorOk);
+    }
+
+    CU_ASSERT_EQUAL(pPdoMem->txChannelInfo[0].channelOffset, TEST_RX_CHANNEL_COUNT * TEST_RX_CHANNEL_SIZE);
+#endif
+
+    CU_ASSERT_EQUAL(pPdoMem->pdoMemSize,
+                    (TEST_RX_CHANNEL_COUNT * PDO_CHANNEL_ALIGN(TEST_RX_CHANNEL_SIZE)) +
+                    (TEST_TX_CHANNEL_COUNT * PDO_CHANNEL_ALIGN(TEST_TX_CHANNEL_SIZE)));
+    CU_ASSERT_EQUAL(memSize, (pPdoMem->pdoMemSize * 3) + PDO_CHANNEL_ALIGN(sizeof(tPdoMemRegion)));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the transfer of RPDOs
+
+RPDOs written by the kernel layer must be read by the user layer. The user
+layer must get the latest RPDO if several were written, and must keep the
+current RPDO if none was written.
+*/
+//------------------------------------------------------------------------------
+void test_pdocal_transferRxPdo(void)
+{
+    UINT8   aPayload[TEST_RX_CHANNEL_SIZE];
+    UINT8*  pPdo;
+    UINT    channelId;
+
+    CU_ASSERT_EQUAL_FATAL(initPdoMem(), kErrorOk);
+
+    for (channelId = 0; channelId < TEST_RX_CHANNEL_COUNT; channelId++)
+    {
+        memset(aPayload, (UINT8)channelId, sizeof(aPayload));
+        CU_ASSERT_EQUAL(pdokcal_writeRxPdo(channelId, aPayload, sizeof(aPayload)), kErrorOk);
+    }
+
+    for (channelId = 0; channelId < TEST_RX_CHANNEL_COUNT; channelId++)
+    {
+        CU_ASSERT_EQUAL(pdoucal_getRxPdo(&pPdo, channelId, TEST_RX_CHANNEL_SIZE), kErrorOk);
+        CU_ASSERT_TRUE(checkPdo(pPdo, (UINT8)channelId, TEST_RX_CHANNEL_SIZE));
+    }
+
+    // Only the latest RPDO is read
+    memset(aPayload, 0x11, sizeof(aPayload));
+    CU_ASSERT_EQUAL(pdokcal_writeRxPdo(0, aPayload, sizeof(aPayload)), kErrorOk);
+    memset(aPayload, 0x22, sizeof(aPayload));
+    CU_ASSERT_EQUAL(pdokcal_writeRxPdo(0, aPayload, sizeof(aPayload)), kErrorOk);
+    CU_ASSERT_EQUAL(pdoucal_getRxPdo(&pPdo, 0, TEST_RX_CHANNEL_SIZE), kErrorOk);
+    CU_ASSERT_TRUE(checkPdo(pPdo, 0x22, TEST_RX_CHANNEL_SIZE));
+
+    // The RPDO is kept without new data
+    CU_ASSERT_EQUAL(pdoucal_getRxPdo(&pPdo, 0, TEST_RX_CHANNEL_SIZE), kErrorOk);
+    CU_ASSERT_TRUE(checkPdo(pPdo, 0x22, TEST_RX_CHANNEL_SIZE));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the transfer of TPDOs
+
+TPDOs written by the user layer must be read by the kernel layer.
+*/
+//------------------------------------------------------------------------------
+void test_pdocal_transferTxPdo(void)
+{
+    UINT8   aPayload[TEST_TX_CHANNEL_SIZE];
+    UINT8*  pPdo;
+
+    CU_ASSERT_EQUAL_FATAL(initPdoMem(), kErrorOk);
+
+    pPdo = pdoucal_getTxPdoAdrs(0);
+    memset(pPdo, 0x33, TEST_TX_CHANNEL_SIZE);
+    CU_ASSERT_EQUAL(pdoucal_setTxPdo(0, pPdo, TEST_TX_CHANNEL_SIZE), kErrorOk);
+
+    CU_ASSERT_EQUAL(pdokcal_readTxPdo(0, aPayload, sizeof(aPayload)), kErrorOk);
+    CU_ASSERT_TRUE(checkPdo(aPayload, 0x33, sizeof(aPayload)));
+
+    // The TPDO is kept without new data
+    CU_ASSERT_EQUAL(pdokcal_readTxPdo(0, aPayload, sizeof(aPayload)), kErrorOk);
+    CU_ASSERT_TRUE(checkPdo(aPayload, 0x33, sizeof(aPayload)));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Measure the cycle time of the concurrent PDO transfer
+
+The kernel layer thread writes all RPDOs and reads the TPDO in each cycle. The
+user layer thread reads all RPDOs and writes the TPDO in each cycle. Both
+threads run concurrently on separate CPUs, if available. The CPU time per cycle
+of each thread includes the stalls caused by cache lines shared between the
+threads. Every PDO read must be consistent.
+*/
+//------------------------------------------------------------------------------
+void test_pdocal_benchmark(void)
+{
+    pthread_t   kernelThreadId;
+    pthread_t   userThreadId;
+    long        cpuCount;
+
+    CU_ASSERT_EQUAL_FATAL(initPdoMem(), kErrorOk);
+    CU_ASSERT_EQUAL_FATAL(pthread_barrier_init(&startBarrier_l, NULL, 2), 0);
+
+    cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    CU_ASSERT_EQUAL_FATAL(createThread(&kernelThreadId, kernelThread, (cpuCount > 1) ? 0 : -1), 0);
+    CU_ASSERT_EQUAL_FATAL(createThread(&userThreadId, userThread, (cpuCount > 1) ? 1 : -1), 0);
+
+    pthread_join(kernelThreadId, NULL);
+    pthread_join(userThreadId, NULL);
+    pthread_barrier_destroy(&startBarrier_l);
+
+    CU_ASSERT_EQUAL(kernelResult_l.errorCount, 0);
+    CU_ASSERT_EQUAL(userResult_l.errorCount, 0);
+
+    printf("\n    Cache line size %u, %u RPDO channels on %s: kernel cycle %.1f ns, user cycle %.1f ns\n",
+           (UINT)CONFIG_PDO_CACHE_LINE_SIZE,
+           TEST_RX_CHANNEL_COUNT,
+           (cpuCount > 1) ? "separate CPUs" : "a single CPU",
+           kernelResult_l.cpuTime * 1e9 / TEST_BENCHMARK_CYCLES,
+           userResult_l.cpuTime * 1e9 / TEST_BENCHMARK_CYCLES);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the PDO memory
+
+The function configures the PDO channels and initializes the PDO memory of the
+kernel and the user layer. The sizes of the channels are aligned the same way
+as in pdou.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError initPdoMem(void)
+{
+    tOplkError  ret;
+    size_t      rxPdoMemSize = 0;
+    size_t      txPdoMemSize = 0;
+    UINT        channelId;
+
+    memset(aRxPdoChannel_l, 0, sizeof(aRxPdoChannel_l));
+    for (channelId = 0; channelId < TEST_RX_CHANNEL_COUNT; channelId++)
+    {
+        aRxPdoChannel_l[channelId].nodeId = channelId + 1;
+        aRxPdoChannel_l[channelId].nextChannelOffset = TEST_RX_CHANNEL_SIZE;
+        rxPdoMemSize += PDO_CHANNEL_ALIGN(TEST_RX_CHANNEL_SIZE);
+    }
+
+    memset(aTxPdoChannel_l, 0, sizeof(aTxPdoChannel_l));
+    for (channelId = 0; channelId < TEST_TX_CHANNEL_COUNT; channelId++)
+    {
+        aTxPdoChannel_l[channelId].nodeId = PDO_PRES_NODE_ID;
+        aTxPdoChannel_l[channelId].nextChannelOffset = TEST_TX_CHANNEL_SIZE;
+        txPdoMemSize += PDO_CHANNEL_ALIGN(TEST_TX_CHANNEL_SIZE);
+    }
+
+    pdoChannelSetup_l.allocation.rxPdoChannelCount = TEST_RX_CHANNEL_COUNT;
+    pdoChannelSetup_l.allocation.txPdoChannelCount = TEST_TX_CHANNEL_COUNT;
+    pdoChannelSetup_l.pRxPdoChannel = aRxPdoChannel_l;
+    pdoChannelSetup_l.pTxPdoChannel = aTxPdoChannel_l;
+
+    ret = pdokcal_initPdoMem(&pdoChannelSetup_l, rxPdoMemSize, txPdoMemSize);
+    if (ret != kErrorOk)
+        return ret;
+
+    return pdoucal_initPdoMem(&pdoChannelSetup_l, rxPdoMemSize, txPdoMemSize);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check the payload of a PDO
+
+\param[in]      pPdo_p              Pointer to the PDO payload.
+\param[in]      value_p             Expected value of all bytes.
+\param[in]      size_p              Size of the PDO payload.
+
+\return The function returns TRUE if all bytes of the payload have the
+        expected value.
+*/
+//------------------------------------------------------------------------------
+static BOOL checkPdo(const UINT8* pPdo_p, UINT8 value_p, UINT size_p)
+{
+    UINT    i;
+
+    for (i = 0; i < size_p; i++)
+    {
+        if (pPdo_p[i] != value_p)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Kernel layer thread of the benchmark
+
+The thread writes all RPDOs and reads the TPDO in each cycle. All bytes of an
+RPDO are set to the low byte of the cycle count. A TPDO is inconsistent if its
+bytes differ.
+
+\param[in]      pArg_p              Unused thread argument.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* kernelThread(void* pArg_p)
+{
+    UINT8   aRxPayload[TEST_RX_CHANNEL_SIZE];
+    UINT8   aTxPayload[TEST_TX_CHANNEL_SIZE];
+    UINT    cycle;
+    UINT    channelId;
+    double  startTime;
+
+    UNUSED_PARAMETER(pArg_p);
+
+    kernelResult_l.errorCount = 0;
+    pthread_barrier_wait(&startBarrier_l);
+
+    startTime = getThreadTime();
+    for (cycle = 0; cycle < TEST_BENCHMARK_CYCLES; cycle++)
+    {
+        memset(aRxPayload, (UINT8)cycle, sizeof(aRxPayload));
+        for (channelId = 0; channelId < TEST_RX_CHANNEL_COUNT; channelId++)
+            pdokcal_writeRxPdo(channelId, aRxPayload, sizeof(aRxPayload));
+
+        pdokcal_readTxPdo(0, aTxPayload, sizeof(aTxPayload));
+        if (!checkPdo(aTxPayload, aTxPayload[0], sizeof(aTxPayload)))
+            kernelResult_l.errorCount++;
+    }
+    kernelResult_l.cpuTime = getThreadTime() - startTime;
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  User layer thread of the benchmark
+
+The thread reads all RPDOs and writes the TPDO in each cycle. All bytes of the
+TPDO are set to the low byte of the cycle count. An RPDO is inconsistent if its
+bytes differ.
+
+\param[in]      pArg_p              Unused thread argument.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* userThread(void* pArg_p)
+{
+    UINT8*  pPdo;
+    UINT    cycle;
+    UINT    channelId;
+    double  startTime;
+
+    UNUSED_PARAMETER(pArg_p);
+
+    userResult_l.errorCount = 0;
+    pthread_barrier_wait(&startBarrier_l);
+
+    startTime = getThreadTime();
+    for (cycle = 0; cycle < TEST_BENCHMARK_CYCLES; cycle++)
+    {
+        for (channelId = 0; channelId < TEST_RX_CHANNEL_COUNT; channelId++)
+        {
+            pdoucal_getRxPdo(&pPdo, channelId, TEST_RX_CHANNEL_SIZE);
+            if (!checkPdo(pPdo, pPdo[0], TEST_RX_CHANNEL_SIZE))
+                userResult_l.errorCount++;
+        }
+
+        pPdo = pdoucal_getTxPdoAdrs(0);
+        memset(pPdo, (UINT8)cycle, TEST_TX_CHANNEL_SIZE);
+        pdoucal_setTxPdo(0, pPdo, TEST_TX_CHANNEL_SIZE);
+    }
+    userResult_l.cpuTime = getThreadTime() - startTime;
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create a benchmark thread
+
+\param[out]     pThread_p           Pointer to store the ID of the thread.
+\param[in]      pfnThread_p         Thread function.
+\param[in]      cpu_p               CPU the thread shall run on, -1 for any CPU.
+
+\return The function returns 0 on success, otherwise an error number.
+*/
+//------------------------------------------------------------------------------
+static int createThread(pthread_t* pThread_p, void* (*pfnThread_p)(void*), int cpu_p)
+{
+    pthread_attr_t  attr;
+    cpu_set_t       cpuSet;
+    int             ret;
+
+    pthread_attr_init(&attr);
+    if (cpu_p >= 0)
+    {
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu_p, &cpuSet);
+        pthread_attr_setaffinity_np(&attr, sizeof(cpuSet), &cpuSet);
+    }
+
+    ret = pthread_create(pThread_p, &attr, pfnThread_p, NULL);
+    pthread_attr_destroy(&attr);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the CPU time of the calling thread
+
+\return The function returns the CPU time of the calling thread in seconds.
+*/
+//------------------------------------------------------------------------------
+static double getThreadTime(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
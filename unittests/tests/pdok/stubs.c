@@ -0,0 +1,266 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for unit tests of PDO kernel module
+
+This file contains the stubs of the modules used by the PDO kernel module. The
+PDO kernel CAL copies the received PDO payloads into static buffers of the
+channels, which can be accessed by the tests, and counts the written PDOs. The
+DLL functions only return successfully.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+
+#include <common/oplkinc.h>
+#include <common/pdo.h>
+#include <kernel/pdokcal.h>
+#include <kernel/dllk.h>
+#include <oplk/debugstr.h>
+
+#include "test-pdok.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT8    aRxPdo_l[STUB_CHANNEL_COUNT][STUB_CHANNEL_SIZE];
+static UINT     aRxPdoWriteCount_l[STUB_CHANNEL_COUNT];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the RPDO buffer of a channel
+
+\param[in]      channelId_p         ID of the RPDO channel.
+
+\return The function returns a pointer to the buffer.
+*/
+//------------------------------------------------------------------------------
+UINT8* stub_getRxPdo(UINT channelId_p)
+{
+    return aRxPdo_l[channelId_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the number of written RPDOs of a channel
+
+\param[in]      channelId_p         ID of the RPDO channel.
+
+\return The function returns the number of calls of pdokcal_writeRxPdo() for
+        the channel since the last call of stub_resetRxPdo().
+*/
+//------------------------------------------------------------------------------
+UINT stub_getRxPdoWriteCount(UINT channelId_p)
+{
+    return aRxPdoWriteCount_l[channelId_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear the RPDO buffers and write counters
+*/
+//------------------------------------------------------------------------------
+void stub_resetRxPdo(void)
+{
+    memset(aRxPdo_l, 0, sizeof(aRxPdo_l));
+    memset(aRxPdoWriteCount_l, 0, sizeof(aRxPdoWriteCount_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Initialize PDO kernel CAL
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokcal_init(void)
+{
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Clean up PDO kernel CAL
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokcal_exit(void)
+{
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Initialize PDO memory
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokcal_initPdoMem(const tPdoChannelSetup* pPdoChannels,
+                              size_t rxPdoMemSize_p,
+                              size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(pPdoChannels);
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Clean up PDO memory
+*/
+//------------------------------------------------------------------------------
+void pdokcal_cleanupPdoMem(void)
+{
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Write RPDO
+
+The stub copies the payload into the static buffer of the RPDO channel.
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokcal_writeRxPdo(UINT channelId_p,
+                              const UINT8* pPayload_p,
+                              UINT16 pdoSize_p)
+{
+    if ((channelId_p >= STUB_CHANNEL_COUNT) || (pdoSize_p > STUB_CHANNEL_SIZE))
+        return kErrorInvalidInstanceParam;
+
+    memcpy(aRxPdo_l[channelId_p], pPayload_p, pdoSize_p);
+    aRxPdoWriteCount_l[channelId_p]++;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Read TPDO
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokcal_readTxPdo(UINT channelId_p,
+                             UINT8* pPayload_p,
+                             UINT16 pdoSize_p)
+{
+    UNUSED_PARAMETER(channelId_p);
+    UNUSED_PARAMETER(pPayload_p);
+    UNUSED_PARAMETER(pdoSize_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Register TPDO handler
+*/
+//------------------------------------------------------------------------------
+void dllk_regTpdoHandler(tDllkCbProcessTpdo pfnDllkCbProcessTpdo_p)
+{
+    UNUSED_PARAMETER(pfnDllkCbProcessTpdo_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Add node to the DLL
+*/
+//------------------------------------------------------------------------------
+tOplkError dllk_addNode(const tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Delete node from the DLL
+*/
+//------------------------------------------------------------------------------
+tOplkError dllk_deleteNode(const tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get error string
+*/
+//------------------------------------------------------------------------------
+const char* debugstr_getRetValStr(tOplkError oplkError_p)
+{
+    UNUSED_PARAMETER(oplkError_p);
+
+    return "";
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
@@ -0,0 +1,495 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the PDO kernel module
+
+This file contains the unit tests of the PDO kernel module. The tests configure
+an MN which receives one RPDO channel from each of STUB_NODE_COUNT CNs and
+check that the received PRes frames are decoded with the channel descriptors of
+the PDO lookup table. The benchmark replays the PRes frames of all CNs and
+compares pdok_processRxPdo() with a reference implementation of the former
+decoding, which looks up every channel by pdoklut_getChannel() and reads its
+parameters from the PDO channel table.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <kernel/pdok.h>
+#include <kernel/pdokcal.h>
+#include <kernel/pdoklut.h>
+
+#include "test-pdok.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_MAPPING_VERSION            0x20
+#define TEST_SPARE_CHANNEL              STUB_NODE_COUNT
+#define TEST_BENCHMARK_ROUNDS           20000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void       configureChannels(void);
+static tOplkError configureChannel(UINT channelId_p,
+                                   UINT nodeId_p,
+                                   UINT16 offset_p,
+                                   UINT16 size_p);
+static void       buildFrames(void);
+static tOplkError processFrames(void);
+static BOOL       checkChannel(UINT channelId_p, const tPlkFrame* pFrame_p, UINT16 offset_p, UINT16 size_p);
+static UINT       getWriteCount(void);
+static tOplkError processRxPdoReference(const tPlkFrame* pFrame_p);
+static double     getTime(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tPlkFrame        aFrame_l[STUB_NODE_COUNT];                      // PRes frames of the CNs
+static tPdoChannel      aRefChannel_l[STUB_CHANNEL_COUNT];              // PDO channel table of the reference
+static tPdoklutEntry    aRefLut_l[D_PDO_RPDOChannels_U16];              // PDO lookup table of the reference
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the processing of received PRes frames
+
+The PRes frame of every CN is processed once. Each RPDO channel must be written
+exactly once with its part of the frame payload.
+*/
+//------------------------------------------------------------------------------
+void test_pdok_processRxPdo(void)
+{
+    UINT    channelId;
+
+    configureChannels();
+    buildFrames();
+    stub_resetRxPdo();
+
+    CU_ASSERT_EQUAL(processFrames(), kErrorOk);
+
+    for (channelId = 0; channelId < STUB_NODE_COUNT; channelId++)
+    {
+        CU_ASSERT_EQUAL(stub_getRxPdoWriteCount(channelId), 1);
+        CU_ASSERT_TRUE(checkChannel(channelId,
+                                    &aFrame_l[channelId],
+                                    aRefChannel_l[channelId].offset,
+                                    aRefChannel_l[channelId].nextChannelOffset - aRefChannel_l[channelId].offset));
+    }
+
+    CU_ASSERT_EQUAL(stub_getRxPdoWriteCount(TEST_SPARE_CHANNEL), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the rejection of invalid PRes frames
+
+Frames which aren't ready, which have a different mapping version, which are
+too short or which are received from a node without RPDO channel must not be
+written to an RPDO channel.
+*/
+//------------------------------------------------------------------------------
+void test_pdok_invalidFrames(void)
+{
+    tPlkFrame   frame;
+
+    configureChannels();
+    buildFrames();
+    stub_resetRxPdo();
+
+    // RD flag not set
+    frame = aFrame_l[0];
+    ami_setUint8Le(&frame.data.pres.flag1, 0);
+    CU_ASSERT_EQUAL(pdok_processRxPdo(&frame, sizeof(frame)), kErrorOk);
+
+    // Main mapping version differs
+    frame = aFrame_l[1];
+    ami_setUint8Le(&frame.data.pres.pdoVersion, TEST_MAPPING_VERSION + 0x10);
+    CU_ASSERT_EQUAL(pdok_processRxPdo(&frame, sizeof(frame)), kErrorOk);
+
+    // Payload too short for the channel
+    frame = aFrame_l[2];
+    ami_setUint16Le(&frame.data.pres.sizeLe, aRefChannel_l[2].nextChannelOffset - 1);
+    CU_ASSERT_EQUAL(pdok_processRxPdo(&frame, sizeof(frame)), kErrorOk);
+
+    // Node without RPDO channel
+    frame = aFrame_l[3];
+    ami_setUint8Le(&frame.srcNodeId, STUB_NODE_COUNT + 1);
+    CU_ASSERT_EQUAL(pdok_processRxPdo(&frame, sizeof(frame)), kErrorOk);
+
+    // PReq frame, the MN doesn't receive a PReq channel
+    frame = aFrame_l[4];
+    ami_setUint8Le(&frame.messageType, (UINT8)kMsgTypePreq);
+    CU_ASSERT_EQUAL(pdok_processRxPdo(&frame, sizeof(frame)), kErrorOk);
+
+    CU_ASSERT_EQUAL(getWriteCount(), 0);
+
+    // Only the sub version differs
+    frame = aFrame_l[5];
+    ami_setUint8Le(&frame.data.pres.pdoVersion, TEST_MAPPING_VERSION + 0x01);
+    CU_ASSERT_EQUAL(pdok_processRxPdo(&frame, sizeof(frame)), kErrorOk);
+    CU_ASSERT_EQUAL(stub_getRxPdoWriteCount(5), 1);
+    CU_ASSERT_EQUAL(getWriteCount(), 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the reconfiguration of a PDO channel
+
+A reconfigured channel must update its channel descriptor instead of adding a
+second one. A second channel of the same node must be written as well.
+*/
+//------------------------------------------------------------------------------
+void test_pdok_reconfigureChannel(void)
+{
+    configureChannels();
+    buildFrames();
+
+    // Move the channel of node 1 and add a second channel behind it
+    CU_ASSERT_EQUAL_FATAL(configureChannel(0, 1, 8, 8), kErrorOk);
+    CU_ASSERT_EQUAL_FATAL(configureChannel(TEST_SPARE_CHANNEL, 1, 16, 16), kErrorOk);
+    CU_ASSERT_EQUAL_FATAL(pdok_setupPdoBuffers(0, 0), kErrorOk);
+    ami_setUint16Le(&aFrame_l[0].data.pres.sizeLe, 32);
+
+    stub_resetRxPdo();
+    CU_ASSERT_EQUAL(pdok_processRxPdo(&aFrame_l[0], sizeof(aFrame_l[0])), kErrorOk);
+
+    CU_ASSERT_EQUAL(stub_getRxPdoWriteCount(0), 1);
+    CU_ASSERT_EQUAL(stub_getRxPdoWriteCount(TEST_SPARE_CHANNEL), 1);
+    CU_ASSERT_EQUAL(getWriteCount(), 2);
+    CU_ASSERT_TRUE(checkChannel(0, &aFrame_l[0], 8, 8));
+    CU_ASSERT_TRUE(checkChannel(TEST_SPARE_CHANNEL, &aFrame_l[0], 16, 16));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the speed of per-channel and per-node lookup
+
+The test replays the PRes frames of all CNs with pdok_processRxPdo() and with
+the reference implementation, which looks up each channel separately.
+*/
+//------------------------------------------------------------------------------
+void test_pdok_benchmark(void)
+{
+    double  startTime;
+    double  perChannel;
+    double  perNode;
+    UINT    round;
+    UINT    nodeIndex;
+
+    configureChannels();
+    buildFrames();
+
+    startTime = getTime();
+    for (round = 0; round < TEST_BENCHMARK_ROUNDS; round++)
+    {
+        for (nodeIndex = 0; nodeIndex < STUB_NODE_COUNT; nodeIndex++)
+            processRxPdoReference(&aFrame_l[nodeIndex]);
+    }
+    perChannel = (getTime() - startTime) / ((double)TEST_BENCHMARK_ROUNDS * STUB_NODE_COUNT);
+
+    startTime = getTime();
+    for (round = 0; round < TEST_BENCHMARK_ROUNDS; round++)
+    {
+        for (nodeIndex = 0; nodeIndex < STUB_NODE_COUNT; nodeIndex++)
+            pdok_processRxPdo(&aFrame_l[nodeIndex], sizeof(aFrame_l[nodeIndex]));
+    }
+    perNode = (getTime() - startTime) / ((double)TEST_BENCHMARK_ROUNDS * STUB_NODE_COUNT);
+
+    printf("\n    PRes frames of %u CNs: per-channel lookup %.1f ns/frame, per-node lookup %.1f ns/frame\n",
+           STUB_NODE_COUNT, perChannel * 1e9, perNode * 1e9);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Configure the RPDO channels of all CNs
+
+The function configures one RPDO channel for each CN. The offset and size of
+the channels vary with the node ID. The reference implementation gets the
+same configuration.
+*/
+//------------------------------------------------------------------------------
+static void configureChannels(void)
+{
+    tPdoAllocationParam allocationParam;
+    UINT                nodeId;
+
+    allocationParam.rxPdoChannelCount = STUB_CHANNEL_COUNT;
+    allocationParam.txPdoChannelCount = 0;
+    CU_ASSERT_EQUAL_FATAL(pdok_allocChannelMem(&allocationParam), kErrorOk);
+
+    memset(aRefChannel_l, 0, sizeof(aRefChannel_l));
+    pdoklut_clear(aRefLut_l, D_PDO_RPDOChannels_U16);
+
+    for (nodeId = 1; nodeId <= STUB_NODE_COUNT; nodeId++)
+    {
+        CU_ASSERT_EQUAL_FATAL(configureChannel(nodeId - 1,
+                                               nodeId,
+                                               (UINT16)((nodeId % 4) * 4),
+                                               (UINT16)(4 + (nodeId % 5) * 4)),
+                              kErrorOk);
+    }
+
+    CU_ASSERT_EQUAL_FATAL(pdok_setupPdoBuffers(0, 0), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Configure an RPDO channel
+
+\param[in]      channelId_p         ID of the RPDO channel.
+\param[in]      nodeId_p            Node ID of the PRes frame.
+\param[in]      offset_p            Offset of the channel payload in the frame.
+\param[in]      size_p              Size of the channel payload.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError configureChannel(UINT channelId_p,
+                                   UINT nodeId_p,
+                                   UINT16 offset_p,
+                                   UINT16 size_p)
+{
+    tPdoChannelConf channelConf;
+
+    memset(&channelConf, 0, sizeof(channelConf));
+    channelConf.channelId = channelId_p;
+    channelConf.fTx = FALSE;
+    channelConf.pdoChannel.nodeId = nodeId_p;
+    channelConf.pdoChannel.offset = offset_p;
+    channelConf.pdoChannel.nextChannelOffset = offset_p + size_p;
+    channelConf.pdoChannel.mappingVersion = TEST_MAPPING_VERSION;
+    channelConf.pdoChannel.mappObjectCount = 1;
+
+    aRefChannel_l[channelId_p] = channelConf.pdoChannel;
+    pdoklut_addChannel(aRefLut_l, &aRefChannel_l[channelId_p], channelId_p);
+
+    return pdok_configureChannel(&channelConf);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build the PRes frames of all CNs
+
+The payload of each frame holds random data and exactly fits its RPDO channel.
+*/
+//------------------------------------------------------------------------------
+static void buildFrames(void)
+{
+    UINT        nodeIndex;
+    UINT        i;
+    tPlkFrame*  pFrame;
+
+    srand(1);
+    for (nodeIndex = 0; nodeIndex < STUB_NODE_COUNT; nodeIndex++)
+    {
+        pFrame = &aFrame_l[nodeIndex];
+        memset(pFrame, 0, sizeof(*pFrame));
+        ami_setUint8Le(&pFrame->messageType, (UINT8)kMsgTypePres);
+        ami_setUint8Le(&pFrame->dstNodeId, C_ADR_BROADCAST);
+        ami_setUint8Le(&pFrame->srcNodeId, (UINT8)(nodeIndex + 1));
+        ami_setUint8Le(&pFrame->data.pres.flag1, PLK_FRAME_FLAG1_RD);
+        ami_setUint8Le(&pFrame->data.pres.pdoVersion, TEST_MAPPING_VERSION);
+        ami_setUint16Le(&pFrame->data.pres.sizeLe, aRefChannel_l[nodeIndex].nextChannelOffset);
+
+        for (i = 0; i < sizeof(pFrame->data.pres.aPayload); i++)
+            pFrame->data.pres.aPayload[i] = (UINT8)rand();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the PRes frames of all CNs
+
+\return The function returns the first error of pdok_processRxPdo().
+*/
+//------------------------------------------------------------------------------
+static tOplkError processFrames(void)
+{
+    tOplkError  ret = kErrorOk;
+    tOplkError  frameRet;
+    UINT        nodeIndex;
+
+    for (nodeIndex = 0; nodeIndex < STUB_NODE_COUNT; nodeIndex++)
+    {
+        frameRet = pdok_processRxPdo(&aFrame_l[nodeIndex], sizeof(aFrame_l[nodeIndex]));
+        if (ret == kErrorOk)
+            ret = frameRet;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check the RPDO buffer of a channel
+
+\param[in]      channelId_p         ID of the RPDO channel.
+\param[in]      pFrame_p            Frame the channel was written from.
+\param[in]      offset_p            Offset of the channel payload in the frame.
+\param[in]      size_p              Size of the channel payload.
+
+\return The function returns TRUE if the buffer holds the channel payload.
+*/
+//------------------------------------------------------------------------------
+static BOOL checkChannel(UINT channelId_p, const tPlkFrame* pFrame_p, UINT16 offset_p, UINT16 size_p)
+{
+    return (memcmp(stub_getRxPdo(channelId_p), &pFrame_p->data.pres.aPayload[offset_p], size_p) == 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the number of written RPDOs of all channels
+
+\return The function returns the sum of the write counters of all channels.
+*/
+//------------------------------------------------------------------------------
+static UINT getWriteCount(void)
+{
+    UINT    count = 0;
+    UINT    channelId;
+
+    for (channelId = 0; channelId < STUB_CHANNEL_COUNT; channelId++)
+        count += stub_getRxPdoWriteCount(channelId);
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reference implementation of the RPDO processing
+
+The function decodes a PRes frame the way pdok_processRxPdo() did before the
+lookup table held the channel descriptors. Every channel is looked up by
+pdoklut_getChannel() and its parameters are read from the PDO channel table.
+The PDO version and the payload size are read from the frame for every channel.
+
+\param[in]      pFrame_p            Pointer to the frame to be decoded.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processRxPdoReference(const tPlkFrame* pFrame_p)
+{
+    const tPdoChannel*  pPdoChannel;
+    UINT                nodeId;
+    UINT                channelId;
+    UINT8               index;
+    UINT8               frameData;
+    UINT16              pdoPayloadSize;
+
+    frameData = ami_getUint8Le(&pFrame_p->data.pres.flag1);
+    if ((frameData & PLK_FRAME_FLAG1_RD) == 0)
+        return kErrorOk;
+
+    if ((tMsgType)ami_getUint8Le(&pFrame_p->messageType) == kMsgTypePreq)
+        nodeId = PDO_PREQ_NODE_ID;
+    else
+        nodeId = ami_getUint8Le(&pFrame_p->srcNodeId);
+
+    index = 0;
+    while ((channelId = pdoklut_getChannel(aRefLut_l, index, (UINT8)nodeId)) != PDOKLUT_INVALID_CHANNEL)
+    {
+        index++;
+        pPdoChannel = &aRefChannel_l[channelId];
+
+        frameData = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion);
+        if ((pPdoChannel->mappingVersion & PLK_VERSION_MAIN) != (frameData & PLK_VERSION_MAIN))
+            return kErrorOk;
+
+        pdoPayloadSize = ami_getUint16Le(&pFrame_p->data.pres.sizeLe);
+        if (pPdoChannel->nextChannelOffset > pdoPayloadSize)
+            return kErrorOk;
+
+        pdokcal_writeRxPdo(channelId,
+                           &pFrame_p->data.pres.aPayload[0] + pPdoChannel->offset,
+                           pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the monotonic time
+
+\return The function returns the monotonic time in seconds.
+*/
+//------------------------------------------------------------------------------
+static double getTime(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
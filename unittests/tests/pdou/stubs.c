@@ -0,0 +1,681 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for unit tests of PDO user module
+
+This file contains the stubs of the modules used by the PDO user module. They
+provide an object dictionary with a generated PDO mapping of an MN which
+exchanges one RPDO and one TPDO with each of STUB_CHANNEL_COUNT CNs. Every PDO
+maps STUB_CHANNEL_OBJECTS objects of mixed integer types. The mapped objects are
+located in an output (RPDO) and an input (TPDO) process image, either in the
+order of the PDO payload (contiguous) or in reverse order (scattered). The PDO
+buffers of the channels are static buffers which can be accessed by the tests.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+
+#include <common/oplkinc.h>
+#include <common/target.h>
+#include <common/pdo.h>
+#include <user/pdoucal.h>
+#include <user/obdu.h>
+#include <oplk/debugstr.h>
+
+#include "test-pdou.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_RX_OBJECT_INDEX            0x6000      // Index of the objects mapped to RPDO channel 0
+#define STUB_TX_OBJECT_INDEX            0x6400      // Index of the objects mapped to TPDO channel 0
+#define STUB_PAYLOAD_LIMIT              1490        // Objects 0x1F8B and 0x1F8D
+#define STUB_PATTERN_SIZE               8           // Number of objects in the type pattern
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    tObdType    type;
+    UINT        size;
+} tStubObjectType;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL getMappedObject(UINT index_p,
+                            UINT subIndex_p,
+                            UINT8** ppVar_p,
+                            const tStubObjectType** ppType_p,
+                            tObdAccess* pAccess_p);
+static UINT getPayloadOffset(UINT subIndex_p);
+static void setEntry(void* pDstData_p, tObdSize* pSize_p, UINT64 value_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+// Types of the mapped objects, repeated for every STUB_PATTERN_SIZE objects
+static const tStubObjectType aObjectType_l[STUB_PATTERN_SIZE] =
+{
+    {kObdTypeUInt8,  1},
+    {kObdTypeUInt8,  1},
+    {kObdTypeUInt16, 2},
+    {kObdTypeUInt32, 4},
+    {kObdTypeUInt8,  1},
+    {kObdTypeUInt16, 2},
+    {kObdTypeUInt32, 4},
+    {kObdTypeUInt64, 8},
+};
+
+static UINT8    aRxImage_l[STUB_CHANNEL_COUNT * STUB_CHANNEL_SIZE];
+static UINT8    aTxImage_l[STUB_CHANNEL_COUNT * STUB_CHANNEL_SIZE];
+static UINT8    aRxPdo_l[STUB_CHANNEL_COUNT][STUB_CHANNEL_SIZE];
+static UINT8    aTxPdo_l[STUB_CHANNEL_COUNT][STUB_CHANNEL_SIZE];
+static BOOL     fContiguous_l = TRUE;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up the PDO mapping
+
+The function selects the location of the mapped objects in the process images
+and clears the process images and the PDO buffers. The mapping gets active
+when the PDO user module processes the next NMT reset.
+
+\param[in]      fContiguous_p       TRUE if the objects are located in the order
+                                    of the PDO payload, FALSE if they are
+                                    located in reverse order.
+*/
+//------------------------------------------------------------------------------
+void stub_setupMapping(BOOL fContiguous_p)
+{
+    fContiguous_l = fContiguous_p;
+
+    memset(aRxImage_l, 0, sizeof(aRxImage_l));
+    memset(aTxImage_l, 0, sizeof(aTxImage_l));
+    memset(aRxPdo_l, 0, sizeof(aRxPdo_l));
+    memset(aTxPdo_l, 0, sizeof(aTxPdo_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the output process image
+
+\return The function returns a pointer to the output process image which
+        contains the objects mapped to the RPDOs.
+*/
+//------------------------------------------------------------------------------
+UINT8* stub_getRxImage(void)
+{
+    return aRxImage_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the input process image
+
+\return The function returns a pointer to the input process image which
+        contains the objects mapped to the TPDOs.
+*/
+//------------------------------------------------------------------------------
+UINT8* stub_getTxImage(void)
+{
+    return aTxImage_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the buffer of an RPDO channel
+
+\param[in]      channelId_p         Channel ID of the RPDO.
+
+\return The function returns a pointer to the payload of the RPDO.
+*/
+//------------------------------------------------------------------------------
+UINT8* stub_getRxPdo(UINT channelId_p)
+{
+    return aRxPdo_l[channelId_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the buffer of a TPDO channel
+
+\param[in]      channelId_p         Channel ID of the TPDO.
+
+\return The function returns a pointer to the payload of the TPDO.
+*/
+//------------------------------------------------------------------------------
+UINT8* stub_getTxPdo(UINT channelId_p)
+{
+    return aTxPdo_l[channelId_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Read object
+
+The stub implements the PDO communication and mapping parameter objects and
+the payload limits of the MN.
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_readEntry(UINT index_p,
+                          UINT subIndex_p,
+                          void* pDstData_p,
+                          tObdSize* pSize_p)
+{
+    UINT    channelId = index_p & 0xFF;
+    UINT    objectIndex;
+    UINT64  mapping;
+
+    switch (index_p & 0xFF00)
+    {
+        case 0x1400:    // PDO_RxCommParam_XXh_REC
+        case 0x1800:    // PDO_TxCommParam_XXh_REC
+            if (channelId >= STUB_CHANNEL_COUNT)
+                return kErrorObdIndexNotExist;
+
+            if (subIndex_p == 1)        // NodeID_U8
+                setEntry(pDstData_p, pSize_p, channelId + 1);
+            else if (subIndex_p == 2)   // MappingVersion_U8
+                setEntry(pDstData_p, pSize_p, 0);
+            else
+                return kErrorObdSubindexNotExist;
+            break;
+
+        case 0x1600:    // PDO_RxMappParam_XXh_AU64
+        case 0x1A00:    // PDO_TxMappParam_XXh_AU64
+            if (channelId >= STUB_CHANNEL_COUNT)
+                return kErrorObdIndexNotExist;
+
+            if (subIndex_p > STUB_CHANNEL_OBJECTS)
+                return kErrorObdSubindexNotExist;
+
+            if (subIndex_p == 0)
+            {
+                setEntry(pDstData_p, pSize_p, STUB_CHANNEL_OBJECTS);
+                break;
+            }
+
+            objectIndex = ((index_p & 0xFF00) == 0x1600) ? STUB_RX_OBJECT_INDEX : STUB_TX_OBJECT_INDEX;
+            mapping = (UINT64)(objectIndex + channelId) |
+                      ((UINT64)subIndex_p << 16) |
+                      ((UINT64)(getPayloadOffset(subIndex_p) * 8) << 32) |
+                      ((UINT64)(aObjectType_l[(subIndex_p - 1) % STUB_PATTERN_SIZE].size * 8) << 48);
+            setEntry(pDstData_p, pSize_p, mapping);
+            break;
+
+        case 0x1F00:
+            if ((index_p != 0x1F8B) && (index_p != 0x1F8D))
+                return kErrorObdIndexNotExist;
+
+            // NMT_MNPReqPayloadLimitList_AU16, NMT_PResPayloadLimitList_AU16
+            if (subIndex_p == 0)
+                setEntry(pDstData_p, pSize_p, 254);
+            else
+                setEntry(pDstData_p, pSize_p, STUB_PAYLOAD_LIMIT);
+            break;
+
+        default:
+            return kErrorObdIndexNotExist;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get object data pointer
+*/
+//------------------------------------------------------------------------------
+void* obdu_getObjectDataPtr(UINT index_p, UINT subIndex_p)
+{
+    UINT8*                  pVar;
+    const tStubObjectType*  pType;
+    tObdAccess              access;
+
+    if (!getMappedObject(index_p, subIndex_p, &pVar, &pType, &access))
+        return NULL;
+
+    return pVar;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get object data size
+*/
+//------------------------------------------------------------------------------
+tObdSize obdu_getDataSize(UINT index_p, UINT subIndex_p)
+{
+    UINT8*                  pVar;
+    const tStubObjectType*  pType;
+    tObdAccess              access;
+
+    if (!getMappedObject(index_p, subIndex_p, &pVar, &pType, &access))
+        return 0;
+
+    return pType->size;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Check if object is numerical
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_isNumerical(UINT index_p, UINT subIndex_p, BOOL* pfEntryNumerical_p)
+{
+    UINT8*                  pVar;
+    const tStubObjectType*  pType;
+    tObdAccess              access;
+
+    if (!getMappedObject(index_p, subIndex_p, &pVar, &pType, &access))
+        return kErrorObdIndexNotExist;
+
+    *pfEntryNumerical_p = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get object type
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_getType(UINT index_p, UINT subIndex_p, tObdType* pType_p)
+{
+    UINT8*                  pVar;
+    const tStubObjectType*  pType;
+    tObdAccess              access;
+
+    if (!getMappedObject(index_p, subIndex_p, &pVar, &pType, &access))
+        return kErrorObdIndexNotExist;
+
+    *pType_p = pType->type;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get object access type
+*/
+//------------------------------------------------------------------------------
+tOplkError obdu_getAccessType(UINT index_p,
+                              UINT subIndex_p,
+                              tObdAccess* pAccessType_p)
+{
+    UINT8*                  pVar;
+    const tStubObjectType*  pType;
+
+    if (!getMappedObject(index_p, subIndex_p, &pVar, &pType, pAccessType_p))
+        return kErrorObdIndexNotExist;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Initialize PDO user CAL
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_init(void)
+{
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Clean up PDO user CAL
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_exit(void)
+{
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Post PDO channel allocation
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_postPdokChannelAlloc(const tPdoAllocationParam* pAllocationParam_p)
+{
+    UNUSED_PARAMETER(pAllocationParam_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Post PDO channel configuration
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_postConfigureChannel(const tPdoChannelConf* pChannelConf_p)
+{
+    UNUSED_PARAMETER(pChannelConf_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Post PDO buffer setup
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_postSetupPdoBuffers(size_t rxPdoMemSize_p,
+                                       size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Initialize PDO memory
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_initPdoMem(const tPdoChannelSetup* pPdoChannels_p,
+                              size_t rxPdoMemSize_p,
+                              size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(pPdoChannels_p);
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Clean up PDO memory
+*/
+//------------------------------------------------------------------------------
+void pdoucal_cleanupPdoMem(void)
+{
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get TPDO buffer
+
+The stub returns the static buffer of the TPDO channel.
+*/
+//------------------------------------------------------------------------------
+UINT8* pdoucal_getTxPdoAdrs(UINT channelId_p)
+{
+    return aTxPdo_l[channelId_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Hand over TPDO buffer
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_setTxPdo(UINT channelId_p,
+                            UINT8* pPdo_p,
+                            WORD pdoSize_p)
+{
+    UNUSED_PARAMETER(channelId_p);
+    UNUSED_PARAMETER(pPdo_p);
+    UNUSED_PARAMETER(pdoSize_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get RPDO buffer
+
+The stub returns the static buffer of the RPDO channel.
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_getRxPdo(UINT8** ppPdo_p,
+                            UINT channelId_p,
+                            WORD pdoSize_p)
+{
+    UNUSED_PARAMETER(pdoSize_p);
+
+    *ppPdo_p = aRxPdo_l[channelId_p];
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Create mutex
+
+The tests run in a single thread, therefore the mutex isn't needed.
+*/
+//------------------------------------------------------------------------------
+tOplkError target_createMutex(const char* mutexName_p,
+                              OPLK_MUTEX_T* pMutex_p)
+{
+    UNUSED_PARAMETER(mutexName_p);
+
+    *pMutex_p = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Lock mutex
+*/
+//------------------------------------------------------------------------------
+tOplkError target_lockMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Unlock mutex
+*/
+//------------------------------------------------------------------------------
+void target_unlockMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Destroy mutex
+*/
+//------------------------------------------------------------------------------
+void target_destroyMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Sleep
+
+The stub returns immediately, there is no kernel layer to wait for.
+*/
+//------------------------------------------------------------------------------
+void target_msleep(UINT32 milliSeconds_p)
+{
+    UNUSED_PARAMETER(milliSeconds_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Get error string
+*/
+//------------------------------------------------------------------------------
+const char* debugstr_getRetValStr(tOplkError oplkError_p)
+{
+    UNUSED_PARAMETER(oplkError_p);
+
+    return "";
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a mapped object
+
+\param[in]      index_p             Index of the object.
+\param[in]      subIndex_p          Subindex of the object.
+\param[out]     ppVar_p             Pointer to store the address of the object
+                                    in the process image.
+\param[out]     ppType_p            Pointer to store the type of the object.
+\param[out]     pAccess_p           Pointer to store the access type.
+
+\return The function returns TRUE if the object is mapped to a PDO.
+*/
+//------------------------------------------------------------------------------
+static BOOL getMappedObject(UINT index_p,
+                            UINT subIndex_p,
+                            UINT8** ppVar_p,
+                            const tStubObjectType** ppType_p,
+                            tObdAccess* pAccess_p)
+{
+    UINT8*  pImage;
+    UINT    channelId;
+    UINT    offset;
+
+    if ((index_p >= STUB_RX_OBJECT_INDEX) && (index_p < STUB_RX_OBJECT_INDEX + STUB_CHANNEL_COUNT))
+    {
+        pImage = aRxImage_l;
+        channelId = index_p - STUB_RX_OBJECT_INDEX;
+        *pAccess_p = kObdAccVPRW;
+    }
+    else if ((index_p >= STUB_TX_OBJECT_INDEX) && (index_p < STUB_TX_OBJECT_INDEX + STUB_CHANNEL_COUNT))
+    {
+        pImage = aTxImage_l;
+        channelId = index_p - STUB_TX_OBJECT_INDEX;
+        *pAccess_p = kObdAccVPR;
+    }
+    else
+        return FALSE;
+
+    if ((subIndex_p == 0) || (subIndex_p > STUB_CHANNEL_OBJECTS))
+        return FALSE;
+
+    *ppType_p = &aObjectType_l[(subIndex_p - 1) % STUB_PATTERN_SIZE];
+
+    offset = getPayloadOffset(subIndex_p);
+    if (!fContiguous_l)
+        offset = STUB_CHANNEL_SIZE - offset - (*ppType_p)->size;
+
+    *ppVar_p = pImage + (channelId * STUB_CHANNEL_SIZE) + offset;
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the payload offset of a mapped object
+
+\param[in]      subIndex_p          Subindex of the object in the mapping.
+
+\return The function returns the offset of the object in the PDO payload.
+*/
+//------------------------------------------------------------------------------
+static UINT getPayloadOffset(UINT subIndex_p)
+{
+    UINT    offset = 0;
+    UINT    index;
+
+    for (index = 0; index < subIndex_p - 1; index++)
+        offset += aObjectType_l[index % STUB_PATTERN_SIZE].size;
+
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store the value of an object entry
+
+\param[out]     pDstData_p          Pointer to the destination buffer.
+\param[in,out]  pSize_p             Size of the destination buffer.
+\param[in]      value_p             Value of the object entry.
+*/
+//------------------------------------------------------------------------------
+static void setEntry(void* pDstData_p, tObdSize* pSize_p, UINT64 value_p)
+{
+    switch (*pSize_p)
+    {
+        case 1:
+            *(UINT8*)pDstData_p = (UINT8)value_p;
+            break;
+
+        case 2:
+            *(UINT16*)pDstData_p = (UINT16)value_p;
+            break;
+
+        case 4:
+            *(UINT32*)pDstData_p = (UINT32)value_p;
+            break;
+
+        default:
+            *(UINT64*)pDstData_p = value_p;
+            *pSize_p = 8;
+            break;
+    }
+}
@@ -0,0 +1,313 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the PDO user module
+
+This file contains the unit tests of the PDO user module. The tests configure
+the generated PDO mapping of the stubs and check that the precompiled copy
+programs produce the same process image and PDO payload as the per-object
+copying, which the module uses until the copy programs are compiled in NMT
+state ReadyToOperate. The benchmark compares the speed of both ways of copying.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <user/pdou.h>
+
+#include "test-pdou.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_IMAGE_SIZE                 (STUB_CHANNEL_COUNT * STUB_CHANNEL_SIZE)
+#define TEST_BENCHMARK_ROUNDS           5000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void       checkCopyProgram(BOOL fContiguous_p);
+static void       runBenchmark(BOOL fContiguous_p);
+static tOplkError changeNmtState(tNmtState nmtState_p);
+static double     measureExchange(UINT rounds_p);
+static void       fillRandom(UINT8* pBuffer_p, size_t size_p);
+static double     getTime(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the copy programs of a contiguous mapping
+
+The objects are located in the process images in the order of the PDO
+payload, so the copy program of each channel is a single bulk copy.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_copyProgramContiguous(void)
+{
+    UINT    channelId;
+
+    checkCopyProgram(TRUE);
+
+    // The process image is an exact copy of the payloads
+    for (channelId = 0; channelId < STUB_CHANNEL_COUNT; channelId++)
+    {
+        CU_ASSERT_EQUAL(memcmp(stub_getRxImage() + (channelId * STUB_CHANNEL_SIZE),
+                               stub_getRxPdo(channelId),
+                               STUB_CHANNEL_SIZE), 0);
+        CU_ASSERT_EQUAL(memcmp(stub_getTxPdo(channelId),
+                               stub_getTxImage() + (channelId * STUB_CHANNEL_SIZE),
+                               STUB_CHANNEL_SIZE), 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the copy programs of a scattered mapping
+
+The objects are located in the process images in reverse order, so no objects
+can be merged and the copy program copies every object by a step of its own.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_copyProgramScattered(void)
+{
+    checkCopyProgram(FALSE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the speed of per-object copying and copy programs
+
+The test measures the exchange of both process images (all RPDOs and TPDOs)
+with per-object copying and with the copy programs for the contiguous and the
+scattered mapping.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_benchmark(void)
+{
+    printf("\n    %u RPDOs and %u TPDOs with %u objects each (%u bytes)\n",
+           STUB_CHANNEL_COUNT, STUB_CHANNEL_COUNT, STUB_CHANNEL_OBJECTS, STUB_CHANNEL_SIZE);
+
+    runBenchmark(TRUE);
+    runBenchmark(FALSE);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the copy programs with per-object copying
+
+The function configures the mapping and copies random PDO payloads and a random
+input process image with per-object copying. After the copy programs are
+compiled, the same data is copied again and compared with the first result.
+
+\param[in]      fContiguous_p       Location of the objects in the process
+                                    images, see stub_setupMapping().
+*/
+//------------------------------------------------------------------------------
+static void checkCopyProgram(BOOL fContiguous_p)
+{
+    static UINT8    aRxImage[TEST_IMAGE_SIZE];
+    static UINT8    aTxPdo[STUB_CHANNEL_COUNT][STUB_CHANNEL_SIZE];
+    UINT            channelId;
+
+    stub_setupMapping(fContiguous_p);
+    CU_ASSERT_EQUAL_FATAL(changeNmtState(kNmtGsResetConfiguration), kErrorOk);
+
+    srand(1);
+    for (channelId = 0; channelId < STUB_CHANNEL_COUNT; channelId++)
+        fillRandom(stub_getRxPdo(channelId), STUB_CHANNEL_SIZE);
+    fillRandom(stub_getTxImage(), TEST_IMAGE_SIZE);
+
+    // Per-object copying
+    CU_ASSERT_EQUAL(pdou_copyRxPdoToPi(), kErrorOk);
+    CU_ASSERT_EQUAL(pdou_copyTxPdoFromPi(), kErrorOk);
+
+    memcpy(aRxImage, stub_getRxImage(), sizeof(aRxImage));
+    memset(stub_getRxImage(), 0, TEST_IMAGE_SIZE);
+    for (channelId = 0; channelId < STUB_CHANNEL_COUNT; channelId++)
+    {
+        memcpy(aTxPdo[channelId], stub_getTxPdo(channelId), STUB_CHANNEL_SIZE);
+        memset(stub_getTxPdo(channelId), 0, STUB_CHANNEL_SIZE);
+    }
+
+    // Copy programs
+    CU_ASSERT_EQUAL_FATAL(changeNmtState(kNmtMsReadyToOperate), kErrorOk);
+    CU_ASSERT_EQUAL(pdou_copyRxPdoToPi(), kErrorOk);
+    CU_ASSERT_EQUAL(pdou_copyTxPdoFromPi(), kErrorOk);
+
+    CU_ASSERT_EQUAL(memcmp(stub_getRxImage(), aRxImage, sizeof(aRxImage)), 0);
+    for (channelId = 0; channelId < STUB_CHANNEL_COUNT; channelId++)
+        CU_ASSERT_EQUAL(memcmp(stub_getTxPdo(channelId), aTxPdo[channelId], STUB_CHANNEL_SIZE), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Measure per-object copying and copy programs
+
+\param[in]      fContiguous_p       Location of the objects in the process
+                                    images, see stub_setupMapping().
+*/
+//------------------------------------------------------------------------------
+static void runBenchmark(BOOL fContiguous_p)
+{
+    double  perObject;
+    double  copyProgram;
+    UINT    objectCount = 2 * STUB_CHANNEL_COUNT * STUB_CHANNEL_OBJECTS;
+
+    stub_setupMapping(fContiguous_p);
+    CU_ASSERT_EQUAL_FATAL(changeNmtState(kNmtGsResetConfiguration), kErrorOk);
+    perObject = measureExchange(TEST_BENCHMARK_ROUNDS);
+
+    CU_ASSERT_EQUAL_FATAL(changeNmtState(kNmtMsReadyToOperate), kErrorOk);
+    copyProgram = measureExchange(TEST_BENCHMARK_ROUNDS);
+
+    printf("    %s mapping: per-object %.1f us/cycle (%.2f ns/object), copy program %.1f us/cycle (%.2f ns/object)\n",
+           fContiguous_p ? "contiguous" : "scattered ",
+           perObject * 1e6, perObject * 1e9 / objectCount,
+           copyProgram * 1e6, copyProgram * 1e9 / objectCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Pass an NMT state change to the PDO user module
+
+\param[in]      nmtState_p          New NMT state.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError changeNmtState(tNmtState nmtState_p)
+{
+    tEventNmtStateChange    nmtStateChange;
+
+    memset(&nmtStateChange, 0, sizeof(nmtStateChange));
+    nmtStateChange.newNmtState = nmtState_p;
+
+    return pdou_cbNmtStateChange(nmtStateChange);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Measure the exchange of the process images
+
+\param[in]      rounds_p            Number of exchanged cycles.
+
+\return The function returns the average time of a cycle in seconds.
+*/
+//------------------------------------------------------------------------------
+static double measureExchange(UINT rounds_p)
+{
+    double  startTime;
+    UINT    round;
+
+    startTime = getTime();
+    for (round = 0; round < rounds_p; round++)
+    {
+        pdou_copyRxPdoToPi();
+        pdou_copyTxPdoFromPi();
+    }
+
+    return (getTime() - startTime) / rounds_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill a buffer with random data
+
+\param[out]     pBuffer_p           Pointer to the buffer.
+\param[in]      size_p              Size of the buffer.
+*/
+//------------------------------------------------------------------------------
+static void fillRandom(UINT8* pBuffer_p, size_t size_p)
+{
+    size_t  i;
+
+    for (i = 0; i < size_p; i++)
+        pBuffer_p[i] = (UINT8)rand();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the monotonic time
+
+\return The function returns the monotonic time in seconds.
+*/
+//------------------------------------------------------------------------------
+static double getTime(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
@@ -0,0 +1,640 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for unit tests of SDO stack
+
+This file contains the stubs of the DLL user CAL, the user timer module and the
+SDO over UDP module. The frames sent by the SDO stack are queued and answered
+by simulated CNs, which implement the server side of the SDO sequence layer.
+They respond to read requests with their node ID and accept expedited and
+segmented write requests.
+
+The network can either be processed until it is idle or cycle by cycle. In a
+cycle, one frame of the MN and one frame of a CN are transferred. The CNs
+answer after a configurable number of cycles.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <user/dllucal.h>
+#include <user/timeru.h>
+#include <user/sdoudp.h>
+#include <user/sdocomint.h>
+
+#include "test-sdo.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_FRAME_QUEUE_SIZE           1024
+#define STUB_RESPONSE_QUEUE_SIZE        1024
+#define STUB_FRAME_SIZE                 (C_DLL_MAX_ASYNC_MTU + 14)
+#define STUB_SEQ_HEADER_SIZE            4
+#define STUB_CMD_HEADER_SIZE            8
+#define STUB_CON_MASK                   0x03
+#define STUB_SEQ_NUM_MASK               0xFC
+#define STUB_SEQ_NUM_INC                0x04
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    size_t      frameSize;
+    UINT32      dueCycle;
+    UINT8       aBuffer[STUB_FRAME_SIZE];
+} tStubFrame;
+
+typedef struct
+{
+    UINT8       sendSeqNum;         // Send sequence number of the CN
+    UINT8       recvSeqNum;         // Last received sequence number of the MN
+    UINT32      writeSize;          // Number of bytes received by write requests
+} tStubCn;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void simulateCn(const tPlkFrame* pFrame_p, size_t frameSize_p);
+static void processCommand(UINT nodeId_p,
+                           const tAsySdoCom* pRequest_p,
+                           size_t dataSize_p);
+static void sendResponse(UINT nodeId_p,
+                         UINT8 con_p,
+                         const tAsySdoCom* pRequest_p,
+                         BOOL fData_p);
+static void deliverResponse(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tDlluCbAsnd  pfnSdoAsndCb_l = NULL;
+static tStubFrame   aFrameQueue_l[STUB_FRAME_QUEUE_SIZE];
+static UINT         frameQueueRead_l = 0;
+static UINT         frameQueueWrite_l = 0;
+static UINT         sentFrameCount_l = 0;
+static tStubFrame   aResponseQueue_l[STUB_RESPONSE_QUEUE_SIZE];
+static UINT         responseQueueRead_l = 0;
+static UINT         responseQueueWrite_l = 0;
+static UINT32       cycle_l = 0;
+static UINT         responseDelay_l = 0;
+static tStubCn      aCn_l[C_ADR_BROADCAST];
+static tTimerHdl    timerHdlCounter_l = 0;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset the simulated network
+
+The function clears the frame queues and the state of the simulated CNs.
+*/
+//------------------------------------------------------------------------------
+void stub_resetNetwork(void)
+{
+    frameQueueRead_l = 0;
+    frameQueueWrite_l = 0;
+    responseQueueRead_l = 0;
+    responseQueueWrite_l = 0;
+    sentFrameCount_l = 0;
+    cycle_l = 0;
+    memset(aCn_l, 0, sizeof(aCn_l));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the response delay of the simulated CNs
+
+\param[in]      cycles_p            Number of cycles until a CN answers a frame.
+*/
+//------------------------------------------------------------------------------
+void stub_setResponseDelay(UINT cycles_p)
+{
+    responseDelay_l = cycles_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the simulated network
+
+The function passes all queued frames sent by the SDO stack to the simulated
+CNs and their answers back to the SDO stack until no more frames are sent.
+The response delay is ignored.
+
+\return The function returns the number of frames sent by the SDO stack.
+*/
+//------------------------------------------------------------------------------
+UINT stub_processNetwork(void)
+{
+    UINT        count = 0;
+    tStubFrame* pFrame;
+
+    while ((frameQueueRead_l != frameQueueWrite_l) ||
+           (responseQueueRead_l != responseQueueWrite_l))
+    {
+        while (frameQueueRead_l != frameQueueWrite_l)
+        {
+            pFrame = &aFrameQueue_l[frameQueueRead_l];
+            frameQueueRead_l = (frameQueueRead_l + 1) % STUB_FRAME_QUEUE_SIZE;
+
+            simulateCn((const tPlkFrame*)pFrame->aBuffer, pFrame->frameSize);
+            count++;
+        }
+
+        while (responseQueueRead_l != responseQueueWrite_l)
+            deliverResponse();
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process one cycle of the simulated network
+
+The function transfers the oldest frame sent by the SDO stack to the simulated
+CNs and the oldest due answer of a CN to the SDO stack.
+
+\return The function returns the number of the processed cycle.
+*/
+//------------------------------------------------------------------------------
+UINT32 stub_processCycle(void)
+{
+    tStubFrame* pFrame;
+
+    if (frameQueueRead_l != frameQueueWrite_l)
+    {
+        pFrame = &aFrameQueue_l[frameQueueRead_l];
+        frameQueueRead_l = (frameQueueRead_l + 1) % STUB_FRAME_QUEUE_SIZE;
+
+        simulateCn((const tPlkFrame*)pFrame->aBuffer, pFrame->frameSize);
+    }
+
+    if ((responseQueueRead_l != responseQueueWrite_l) &&
+        ((INT32)(cycle_l - aResponseQueue_l[responseQueueRead_l].dueCycle) >= 0))
+        deliverResponse();
+
+    return cycle_l++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get number of bytes written to a simulated CN
+
+\param[in]      nodeId_p            Node ID of the simulated CN.
+
+\return The function returns the number of bytes received by write requests.
+*/
+//------------------------------------------------------------------------------
+UINT32 stub_getWriteSize(UINT nodeId_p)
+{
+    return aCn_l[nodeId_p].writeSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get number of sent frames
+
+\return The function returns the number of frames sent by the SDO stack since
+        the last reset.
+*/
+//------------------------------------------------------------------------------
+UINT stub_getSentFrameCount(void)
+{
+    return sentFrameCount_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Register ASnd service
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_regAsndService(tDllAsndServiceId ServiceId_p,
+                                  tDlluCbAsnd pfnDlluCbAsnd_p,
+                                  tDllAsndFilter Filter_p)
+{
+    UNUSED_PARAMETER(Filter_p);
+
+    if (ServiceId_p == kDllAsndSdo)
+        pfnSdoAsndCb_l = pfnDlluCbAsnd_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Send asynchronous frame
+
+The stub queues the frame for the simulated CNs.
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_sendAsyncFrame(const tFrameInfo* pFrameInfo,
+                                  tDllAsyncReqPriority priority_p)
+{
+    tStubFrame* pFrame;
+    UINT        nextWrite;
+
+    UNUSED_PARAMETER(priority_p);
+
+    nextWrite = (frameQueueWrite_l + 1) % STUB_FRAME_QUEUE_SIZE;
+    if ((nextWrite == frameQueueRead_l) || (pFrameInfo->frameSize > STUB_FRAME_SIZE))
+        return kErrorDllAsyncTxBufferFull;
+
+    pFrame = &aFrameQueue_l[frameQueueWrite_l];
+    pFrame->frameSize = pFrameInfo->frameSize;
+    memcpy(pFrame->aBuffer, pFrameInfo->frame.pBuffer, pFrameInfo->frameSize);
+    frameQueueWrite_l = nextWrite;
+    sentFrameCount_l++;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Set user timer
+
+The simulated network has no notion of time, so the timers never expire.
+*/
+//------------------------------------------------------------------------------
+tOplkError timeru_setTimer(tTimerHdl* pTimerHdl_p,
+                           ULONG timeoutMs_p,
+                           const tTimerArg* pArgument_p)
+{
+    UNUSED_PARAMETER(timeoutMs_p);
+    UNUSED_PARAMETER(pArgument_p);
+
+    *pTimerHdl_p = ++timerHdlCounter_l;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Modify user timer
+*/
+//------------------------------------------------------------------------------
+tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
+                              ULONG timeoutMs_p,
+                              const tTimerArg* pArgument_p)
+{
+    return timeru_setTimer(pTimerHdl_p, timeoutMs_p, pArgument_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Delete user timer
+*/
+//------------------------------------------------------------------------------
+tOplkError timeru_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    *pTimerHdl_p = 0;
+
+    return kErrorOk;
+}
+
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Initialize SDO over UDP module
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoudp_init(tSequLayerReceiveCb pfnReceiveCb_p)
+{
+    UNUSED_PARAMETER(pfnReceiveCb_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Shut down SDO over UDP module
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoudp_exit(void)
+{
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Initialize SDO over UDP connection
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoudp_initCon(tSdoConHdl* pSdoConHandle_p,
+                          UINT targetNodeId_p)
+{
+    UNUSED_PARAMETER(pSdoConHandle_p);
+    UNUSED_PARAMETER(targetNodeId_p);
+
+    return kErrorSdoUdpNoFreeHandle;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Send data via SDO over UDP connection
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoudp_sendData(tSdoConHdl sdoConHandle_p,
+                           tPlkFrame* pSrcData_p,
+                           size_t dataSize_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+    UNUSED_PARAMETER(pSrcData_p);
+    UNUSED_PARAMETER(dataSize_p);
+
+    return kErrorSdoUdpInvalidHdl;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stub: Delete SDO over UDP connection
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoudp_delConnection(tSdoConHdl sdoConHandle_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+
+    return kErrorOk;
+}
+#endif
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Simulate the SDO server of a CN
+
+The function processes a frame sent by the SDO stack at the simulated CN
+addressed by the frame. The CN acknowledges every new frame of the sequence
+and every acknowledge request.
+
+\param[in]      pFrame_p            Frame sent by the SDO stack.
+\param[in]      frameSize_p         Size of the frame.
+*/
+//------------------------------------------------------------------------------
+static void simulateCn(const tPlkFrame* pFrame_p, size_t frameSize_p)
+{
+    const tAsySdoSeq*   pSeq = &pFrame_p->data.asnd.payload.sdoSequenceFrame;
+    tStubCn*            pCn;
+    size_t              headerSize;
+    UINT                nodeId;
+    UINT8               recvCon;
+    UINT8               sendCon;
+    UINT8               sendSeqNum;
+
+    nodeId = ami_getUint8Le(&pFrame_p->dstNodeId);
+    if ((nodeId == C_ADR_INVALID) || (nodeId >= C_ADR_BROADCAST))
+        return;
+
+    pCn = &aCn_l[nodeId];
+    recvCon = ami_getUint8Le(&pSeq->recvSeqNumCon) & STUB_CON_MASK;
+    sendCon = ami_getUint8Le(&pSeq->sendSeqNumCon) & STUB_CON_MASK;
+    sendSeqNum = ami_getUint8Le(&pSeq->sendSeqNumCon) & STUB_SEQ_NUM_MASK;
+    headerSize = (size_t)((const UINT8*)pSeq - (const UINT8*)pFrame_p) + STUB_SEQ_HEADER_SIZE;
+
+    if ((sendCon == 1) && (recvCon == 0))
+    {   // InitReq -> InitAck
+        pCn->sendSeqNum = 0;
+        pCn->recvSeqNum = sendSeqNum;
+        sendResponse(nodeId, 1, NULL, FALSE);
+    }
+    else if ((sendCon == 2) && (recvCon == 1))
+    {   // InitResp -> Valid
+        pCn->recvSeqNum = sendSeqNum;
+        sendResponse(nodeId, 2, NULL, FALSE);
+    }
+    else if ((sendCon >= 2) && (recvCon >= 2))
+    {
+        if (sendSeqNum == ((pCn->recvSeqNum + STUB_SEQ_NUM_INC) & STUB_SEQ_NUM_MASK))
+        {   // next frame of the sequence
+            pCn->recvSeqNum = sendSeqNum;
+            if (frameSize_p >= headerSize + STUB_CMD_HEADER_SIZE)
+                processCommand(nodeId, &pSeq->sdoSeqPayload, frameSize_p - headerSize);
+            else
+                sendResponse(nodeId, 2, NULL, FALSE);
+        }
+        else if (sendCon == 3)
+        {   // acknowledge request
+            sendResponse(nodeId, 2, NULL, FALSE);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process a command layer request at a simulated CN
+
+The function answers read requests with the node ID as 32 bit data and counts
+the bytes of write requests. Segments which do not complete a transfer are
+only acknowledged.
+
+\param[in]      nodeId_p            Node ID of the simulated CN.
+\param[in]      pRequest_p          Command layer request.
+\param[in]      dataSize_p          Size of the command layer frame.
+*/
+//------------------------------------------------------------------------------
+static void processCommand(UINT nodeId_p,
+                           const tAsySdoCom* pRequest_p,
+                           size_t dataSize_p)
+{
+    UINT8   flags = ami_getUint8Le(&pRequest_p->flags);
+    UINT8   commandId = ami_getUint8Le(&pRequest_p->commandId);
+    UINT    segmentSize = ami_getUint16Le(&pRequest_p->segmentSizeLe);
+
+    UNUSED_PARAMETER(dataSize_p);
+
+    if (((flags & SDO_CMDL_FLAG_RESPONSE) != 0) || (commandId == kSdoServiceNIL))
+    {
+        sendResponse(nodeId_p, 2, NULL, FALSE);
+        return;
+    }
+
+    switch (commandId)
+    {
+        case kSdoServiceReadByIndex:
+            sendResponse(nodeId_p, 2, pRequest_p, TRUE);
+            break;
+
+        case kSdoServiceWriteByIndex:
+            switch (flags & SDO_CMDL_FLAG_SEGM_MASK)
+            {
+                case SDO_CMDL_FLAG_EXPEDITED:
+                    // index and sub-index precede the data
+                    aCn_l[nodeId_p].writeSize += segmentSize - 4;
+                    sendResponse(nodeId_p, 2, pRequest_p, FALSE);
+                    break;
+
+                case SDO_CMDL_FLAG_SEGMINIT:
+                    // data size, index and sub-index precede the data
+                    aCn_l[nodeId_p].writeSize += segmentSize - 8;
+                    sendResponse(nodeId_p, 2, NULL, FALSE);
+                    break;
+
+                case SDO_CMDL_FLAG_SEGMENTED:
+                    aCn_l[nodeId_p].writeSize += segmentSize;
+                    sendResponse(nodeId_p, 2, NULL, FALSE);
+                    break;
+
+                default:
+                    aCn_l[nodeId_p].writeSize += segmentSize;
+                    sendResponse(nodeId_p, 2, pRequest_p, FALSE);
+                    break;
+            }
+            break;
+
+        default:
+            sendResponse(nodeId_p, 2, NULL, FALSE);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a response of a simulated CN
+
+The function builds a frame of the simulated CN and queues it for the SDO stack.
+If a command layer request is specified, the frame carries the response and
+takes the next sequence number of the CN.
+
+\param[in]      nodeId_p            Node ID of the simulated CN.
+\param[in]      con_p               Connection state (rcon and scon) of the frame.
+\param[in]      pRequest_p          Command layer request to respond to (can be NULL).
+\param[in]      fData_p             If TRUE, the response carries the node ID
+                                    as 32 bit data.
+*/
+//------------------------------------------------------------------------------
+static void sendResponse(UINT nodeId_p,
+                         UINT8 con_p,
+                         const tAsySdoCom* pRequest_p,
+                         BOOL fData_p)
+{
+    tStubCn*    pCn = &aCn_l[nodeId_p];
+    tStubFrame* pResponse;
+    tPlkFrame*  pFrame;
+    tAsySdoSeq* pSeq;
+    UINT        nextWrite;
+
+    nextWrite = (responseQueueWrite_l + 1) % STUB_RESPONSE_QUEUE_SIZE;
+    if (nextWrite == responseQueueRead_l)
+        return;     // response lost
+
+    if (pRequest_p != NULL)
+        pCn->sendSeqNum += STUB_SEQ_NUM_INC;
+
+    pResponse = &aResponseQueue_l[responseQueueWrite_l];
+    pFrame = (tPlkFrame*)pResponse->aBuffer;
+    pSeq = &pFrame->data.asnd.payload.sdoSequenceFrame;
+
+    memset(pResponse->aBuffer, 0, sizeof(pResponse->aBuffer));
+    ami_setUint8Le(&pFrame->messageType, (UINT8)kMsgTypeAsnd);
+    ami_setUint8Le(&pFrame->srcNodeId, (UINT8)nodeId_p);
+    ami_setUint8Le(&pFrame->data.asnd.serviceId, (UINT8)kDllAsndSdo);
+    ami_setUint8Le(&pSeq->recvSeqNumCon, pCn->recvSeqNum | con_p);
+    ami_setUint8Le(&pSeq->sendSeqNumCon, pCn->sendSeqNum | con_p);
+    pResponse->frameSize = (size_t)((UINT8*)pSeq - pResponse->aBuffer) + STUB_SEQ_HEADER_SIZE;
+
+    if (pRequest_p != NULL)
+    {
+        ami_setUint8Le(&pSeq->sdoSeqPayload.transactionId, ami_getUint8Le(&pRequest_p->transactionId));
+        ami_setUint8Le(&pSeq->sdoSeqPayload.flags, SDO_CMDL_FLAG_RESPONSE | SDO_CMDL_FLAG_EXPEDITED);
+        ami_setUint8Le(&pSeq->sdoSeqPayload.commandId, ami_getUint8Le(&pRequest_p->commandId));
+        pResponse->frameSize += STUB_CMD_HEADER_SIZE;
+
+        if (fData_p)
+        {
+            ami_setUint16Le(&pSeq->sdoSeqPayload.segmentSizeLe, sizeof(UINT32));
+            ami_setUint32Le(&pSeq->sdoSeqPayload.aCommandData[0], (UINT32)nodeId_p);
+            pResponse->frameSize += sizeof(UINT32);
+        }
+    }
+
+    pResponse->dueCycle = cycle_l + responseDelay_l;
+    responseQueueWrite_l = nextWrite;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Deliver the oldest response of the simulated CNs
+
+The function passes the oldest queued response of the simulated CNs to the
+SDO stack.
+*/
+//------------------------------------------------------------------------------
+static void deliverResponse(void)
+{
+    tStubFrame  response;
+    tFrameInfo  frameInfo;
+
+    // copy the response, the SDO stack can queue new ones while processing it
+    response = aResponseQueue_l[responseQueueRead_l];
+    responseQueueRead_l = (responseQueueRead_l + 1) % STUB_RESPONSE_QUEUE_SIZE;
+
+    frameInfo.frameSize = (UINT)response.frameSize;
+    frameInfo.frame.pBuffer = (tPlkFrame*)response.aBuffer;
+
+    if (pfnSdoAsndCb_l != NULL)
+        pfnSdoAsndCb_l(&frameInfo);
+}
+
+/// \}
@@ -0,0 +1,352 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the SDO stack
+
+This file contains the unit tests of the SDO stack. The tests run SDO client
+sessions to simulated CNs through the command layer, the sequence layer and the
+SDO over ASnd module. They check that a MN can keep a session open to every
+CN of a fully populated network and that closed connections are reused.
+Besides the functional tests, it contains a benchmark which measures the
+throughput of a segmented write for several send windows and cycle times.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <user/sdocom.h>
+#include <user/sdoseq.h>
+
+#include "test-sdo.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_NODE_COUNT                 239         // Number of CNs of a fully populated network
+#define TEST_INDEX                      0x1006      // Object read from the CNs
+#define TEST_REUSE_ROUNDS               4           // Number of define/undefine rounds
+#define TEST_BENCH_NODE_ID              1           // Node ID of the CN of the benchmark
+#define TEST_BENCH_INDEX                0x1F50      // Object written by the benchmark (program data)
+#define TEST_BENCH_DATA_SIZE            65536       // Size of the domain written by the benchmark
+#define TEST_BENCH_CN_DELAY_US          2000        // [us] Time until the CN answers a frame
+#define TEST_BENCH_MAX_CYCLES           1000000     // Cycle limit of one benchmark transfer
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    tSdoComConHdl       sdoComConHdl;
+    UINT8               aData[sizeof(UINT32)];
+    BOOL                fFinished;
+    tSdoComConState     sdoComConState;
+    UINT                transferredBytes;
+} tTestSession;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError sdoFinishedCb(const tSdoComFinished* pSdoComFinished_p);
+static UINT32     runThroughputBenchmark(UINT windowSize_p,
+                                         UINT cycleTimeUs_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTestSession aSession_l[TEST_NODE_COUNT + 1];
+static UINT8        aBenchData_l[TEST_BENCH_DATA_SIZE];
+static const UINT   aBenchWindowSize_l[] = {2, 5, 10, 24};
+static const UINT   aBenchCycleTimeUs_l[] = {400, 1000, 2000};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test concurrent SDO sessions to all CNs
+
+The test opens an SDO connection to every CN of a fully populated network and
+starts an expedited read on all of them before the simulated CNs answer.
+*/
+//------------------------------------------------------------------------------
+void test_sdo_concurrentSessions(void)
+{
+    tSdoComTransParamByIndex    transParam;
+    UINT                        nodeId;
+    UINT                        finishedCount = 0;
+
+    stub_resetNetwork();
+    memset(aSession_l, 0, sizeof(aSession_l));
+
+    for (nodeId = 1; nodeId <= TEST_NODE_COUNT; nodeId++)
+    {
+        CU_ASSERT_EQUAL_FATAL(sdocom_defineConnection(&aSession_l[nodeId].sdoComConHdl,
+                                                      nodeId,
+                                                      kSdoTypeAsnd),
+                              kErrorOk);
+    }
+
+    for (nodeId = 1; nodeId <= TEST_NODE_COUNT; nodeId++)
+    {
+        memset(&transParam, 0, sizeof(transParam));
+        transParam.sdoComConHdl = aSession_l[nodeId].sdoComConHdl;
+        transParam.index = TEST_INDEX;
+        transParam.subindex = 0;
+        transParam.pData = aSession_l[nodeId].aData;
+        transParam.dataSize = sizeof(aSession_l[nodeId].aData);
+        transParam.sdoAccessType = kSdoAccessTypeRead;
+        transParam.pfnSdoFinishedCb = sdoFinishedCb;
+        transParam.pUserArg = &aSession_l[nodeId];
+
+        CU_ASSERT_EQUAL(sdocom_initTransferByIndex(&transParam), kErrorOk);
+    }
+
+    CU_ASSERT(stub_processNetwork() >= 3 * TEST_NODE_COUNT);
+
+    for (nodeId = 1; nodeId <= TEST_NODE_COUNT; nodeId++)
+    {
+        if (aSession_l[nodeId].fFinished &&
+            (aSession_l[nodeId].sdoComConState == kSdoComTransferFinished) &&
+            (aSession_l[nodeId].transferredBytes == sizeof(UINT32)) &&
+            (ami_getUint32Le(aSession_l[nodeId].aData) == nodeId))
+        {
+            finishedCount++;
+        }
+    }
+    CU_ASSERT_EQUAL(finishedCount, TEST_NODE_COUNT);
+
+    for (nodeId = 1; nodeId <= TEST_NODE_COUNT; nodeId++)
+        CU_ASSERT_EQUAL(sdocom_undefineConnection(aSession_l[nodeId].sdoComConHdl), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test reuse of closed SDO connections
+
+The test repeatedly opens connections to all CNs and closes them again. The
+connection tables must not run out of free entries.
+*/
+//------------------------------------------------------------------------------
+void test_sdo_connectionReuse(void)
+{
+    UINT    round;
+    UINT    nodeId;
+
+    stub_resetNetwork();
+
+    for (round = 0; round < TEST_REUSE_ROUNDS; round++)
+    {
+        for (nodeId = 1; nodeId <= TEST_NODE_COUNT; nodeId++)
+        {
+            CU_ASSERT_EQUAL_FATAL(sdocom_defineConnection(&aSession_l[nodeId].sdoComConHdl,
+                                                          nodeId,
+                                                          kSdoTypeAsnd),
+                                  kErrorOk);
+        }
+
+        // A second connection to the same node is rejected
+        CU_ASSERT_EQUAL(sdocom_defineConnection(&aSession_l[0].sdoComConHdl,
+                                                1,
+                                                kSdoTypeAsnd),
+                        kErrorSdoComHandleExists);
+
+        stub_processNetwork();
+
+        for (nodeId = 1; nodeId <= TEST_NODE_COUNT; nodeId++)
+            CU_ASSERT_EQUAL(sdocom_undefineConnection(aSession_l[nodeId].sdoComConHdl), kErrorOk);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark segmented SDO transfer throughput
+
+The benchmark writes a domain to a simulated CN for several send windows of
+the sequence layer and several cycle times. The CN answers each frame after a
+fixed time, so the number of frames in flight limits the throughput.
+*/
+//------------------------------------------------------------------------------
+void test_sdo_throughputBenchmark(void)
+{
+    UINT    window;
+    UINT    cycleTime;
+    UINT32  cycles;
+
+    printf("\n    %u byte write, CN answer after %u us [kB/s]:\n      window",
+           TEST_BENCH_DATA_SIZE, TEST_BENCH_CN_DELAY_US);
+    for (cycleTime = 0; cycleTime < tabentries(aBenchCycleTimeUs_l); cycleTime++)
+        printf(" %7u us", aBenchCycleTimeUs_l[cycleTime]);
+    printf("\n");
+
+    for (window = 0; window < tabentries(aBenchWindowSize_l); window++)
+    {
+        printf("      %6u", aBenchWindowSize_l[window]);
+        for (cycleTime = 0; cycleTime < tabentries(aBenchCycleTimeUs_l); cycleTime++)
+        {
+            cycles = runThroughputBenchmark(aBenchWindowSize_l[window], aBenchCycleTimeUs_l[cycleTime]);
+            CU_ASSERT(cycles != 0);
+            if (cycles == 0)
+            {
+                printf("      fail");
+                continue;
+            }
+
+            printf(" %10.1f",
+                   (TEST_BENCH_DATA_SIZE * 1000000.0) / (1024.0 * cycles * aBenchCycleTimeUs_l[cycleTime]));
+        }
+        printf("\n");
+    }
+
+    CU_ASSERT_EQUAL(sdoseq_setWindowSize(CONFIG_SDO_SEQ_HISTORY_SIZE), kErrorOk);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  SDO transfer finished callback
+
+The function records the result of a finished SDO transfer in the test session
+passed as user argument.
+
+\param[in]      pSdoComFinished_p   Pointer to the finished transfer information.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sdoFinishedCb(const tSdoComFinished* pSdoComFinished_p)
+{
+    tTestSession*   pSession = (tTestSession*)pSdoComFinished_p->pUserArg;
+
+    pSession->fFinished = TRUE;
+    pSession->sdoComConState = pSdoComFinished_p->sdoComConState;
+    pSession->transferredBytes = pSdoComFinished_p->transferredBytes;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run one transfer of the throughput benchmark
+
+The function writes the benchmark domain to the simulated CN with the specified
+send window and processes the simulated network cycle by cycle until the
+transfer is finished.
+
+\param[in]      windowSize_p        Send window of the sequence layer.
+\param[in]      cycleTimeUs_p       Cycle time in microseconds.
+
+\return The function returns the number of cycles of the transfer or 0 if it
+        failed.
+*/
+//------------------------------------------------------------------------------
+static UINT32 runThroughputBenchmark(UINT windowSize_p,
+                                     UINT cycleTimeUs_p)
+{
+    tSdoComTransParamByIndex    transParam;
+    tTestSession*               pSession = &aSession_l[TEST_BENCH_NODE_ID];
+    UINT32                      startCycle;
+    UINT32                      cycle;
+
+    stub_resetNetwork();
+    stub_setResponseDelay((TEST_BENCH_CN_DELAY_US + cycleTimeUs_p - 1) / cycleTimeUs_p);
+    memset(pSession, 0, sizeof(*pSession));
+
+    if ((sdoseq_setWindowSize(windowSize_p) != kErrorOk) ||
+        (sdocom_defineConnection(&pSession->sdoComConHdl, TEST_BENCH_NODE_ID, kSdoTypeAsnd) != kErrorOk))
+        return 0;
+
+    memset(&transParam, 0, sizeof(transParam));
+    transParam.sdoComConHdl = pSession->sdoComConHdl;
+    transParam.index = TEST_BENCH_INDEX;
+    transParam.subindex = 1;
+    transParam.pData = aBenchData_l;
+    transParam.dataSize = sizeof(aBenchData_l);
+    transParam.sdoAccessType = kSdoAccessTypeWrite;
+    transParam.pfnSdoFinishedCb = sdoFinishedCb;
+    transParam.pUserArg = pSession;
+
+    startCycle = 0;
+    cycle = 0;
+    if (sdocom_initTransferByIndex(&transParam) == kErrorOk)
+    {
+        startCycle = stub_processCycle();
+        do
+        {
+            cycle = stub_processCycle();
+        } while (!pSession->fFinished && ((cycle - startCycle) < TEST_BENCH_MAX_CYCLES));
+    }
+
+    sdocom_undefineConnection(pSession->sdoComConHdl);
+    stub_processNetwork();
+
+    if (!pSession->fFinished ||
+        (pSession->sdoComConState != kSdoComTransferFinished) ||
+        (stub_getWriteSize(TEST_BENCH_NODE_ID) != TEST_BENCH_DATA_SIZE))
+        return 0;
+
+    return cycle - startCycle + 1;
+}
+
+/// \}
@@ -0,0 +1,168 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for unit tests of user timer module
+
+This file contains the stub of the user event module. It records the posted
+timer events for the checks of the unit tests.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include <common/oplkinc.h>
+#include <common/timer.h>
+#include <user/eventu.h>
+
+#include "test-timeru.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static pthread_mutex_t  eventMutex_l = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   eventCond_l = PTHREAD_COND_INITIALIZER;
+static UINT             eventCount_l;
+static UINT32           aEventArg_l[TEST_MAX_EVENTS];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+tOplkError eventu_postEvent(const tEvent* pEvent_p)
+{
+    const tTimerEventArg*   pTimerEventArg;
+
+    if (pEvent_p->eventType != kEventTypeTimer)
+        return kErrorOk;
+
+    pTimerEventArg = (const tTimerEventArg*)pEvent_p->eventArg.pEventArg;
+
+    pthread_mutex_lock(&eventMutex_l);
+    if (eventCount_l < TEST_MAX_EVENTS)
+        aEventArg_l[eventCount_l] = pTimerEventArg->argument.value;
+    eventCount_l++;
+    pthread_cond_broadcast(&eventCond_l);
+    pthread_mutex_unlock(&eventMutex_l);
+
+    return kErrorOk;
+}
+
+void stub_resetTimerEvents(void)
+{
+    pthread_mutex_lock(&eventMutex_l);
+    eventCount_l = 0;
+    pthread_mutex_unlock(&eventMutex_l);
+}
+
+UINT stub_getTimerEventCount(void)
+{
+    UINT    count;
+
+    pthread_mutex_lock(&eventMutex_l);
+    count = eventCount_l;
+    pthread_mutex_unlock(&eventMutex_l);
+
+    return count;
+}
+
+UINT32 stub_getTimerEventArg(UINT index_p)
+{
+    UINT32  arg = 0;
+
+    pthread_mutex_lock(&eventMutex_l);
+    if ((index_p < eventCount_l) && (index_p < TEST_MAX_EVENTS))
+        arg = aEventArg_l[index_p];
+    pthread_mutex_unlock(&eventMutex_l);
+
+    return arg;
+}
+
+BOOL stub_waitTimerEvents(UINT count_p, UINT timeoutMs_p)
+{
+    struct timespec timeout;
+    BOOL            fReached;
+    int             ret = 0;
+
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_sec += timeoutMs_p / 1000;
+    timeout.tv_nsec += (timeoutMs_p % 1000) * 1000000;
+    if (timeout.tv_nsec >= 1000000000)
+    {
+        timeout.tv_sec++;
+        timeout.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&eventMutex_l);
+    while ((eventCount_l < count_p) && (ret != ETIMEDOUT))
+        ret = pthread_cond_timedwait(&eventCond_l, &eventMutex_l, &timeout);
+    fReached = (eventCount_l >= count_p);
+    pthread_mutex_unlock(&eventMutex_l);
+
+    return fReached;
+}
@@ -0,0 +1,306 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests of the user timer module
+
+This file contains the unit tests of the Linux userspace user timer module.
+Besides the functional tests, it contains a benchmark which arms, restarts and
+deletes timers in the pattern of the MN NMT module during the boot-up of a
+large network.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <user/timeru.h>
+
+#include "test-timeru.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_NODE_COUNT                 239         // Number of CNs of the boot-up benchmark
+#define TEST_BOOT_ROUNDS                200         // Number of state changes per CN
+#define TEST_STATREQ_TIMEOUT            1000        // [ms] Timeout of the StatusRequest timer
+#define TEST_LONGER_TIMEOUT             5000        // [ms] Timeout of the longer boot step timer
+#define TEST_EXPIRY_TIMEOUT             20          // [ms] Timeout of the expiry batch
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void   setArgument(tTimerArg* pArgument_p, UINT32 value_p);
+static double getSeconds(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTimerHdl    aTimerHdlStatReq_l[TEST_NODE_COUNT];
+static tTimerHdl    aTimerHdlLonger_l[TEST_NODE_COUNT];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the expiry order of timers
+*/
+//------------------------------------------------------------------------------
+void test_timeru_expiryOrder(void)
+{
+    tTimerHdl   aTimerHdl[3] = {0, 0, 0};
+    tTimerArg   argument;
+
+    stub_resetTimerEvents();
+
+    setArgument(&argument, 30);
+    CU_ASSERT_EQUAL(timeru_setTimer(&aTimerHdl[0], 30, &argument), kErrorOk);
+    setArgument(&argument, 10);
+    CU_ASSERT_EQUAL(timeru_setTimer(&aTimerHdl[1], 10, &argument), kErrorOk);
+    setArgument(&argument, 20);
+    CU_ASSERT_EQUAL(timeru_setTimer(&aTimerHdl[2], 20, &argument), kErrorOk);
+    CU_ASSERT_TRUE(timeru_isActive(aTimerHdl[0]));
+
+    CU_ASSERT_TRUE_FATAL(stub_waitTimerEvents(3, 1000));
+    CU_ASSERT_EQUAL(stub_getTimerEventArg(0), 10);
+    CU_ASSERT_EQUAL(stub_getTimerEventArg(1), 20);
+    CU_ASSERT_EQUAL(stub_getTimerEventArg(2), 30);
+    CU_ASSERT_FALSE(timeru_isActive(aTimerHdl[0]));
+
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&aTimerHdl[0]), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&aTimerHdl[1]), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&aTimerHdl[2]), kErrorOk);
+    CU_ASSERT_EQUAL(aTimerHdl[0], 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test modifying and deleting timers
+*/
+//------------------------------------------------------------------------------
+void test_timeru_modifyDelete(void)
+{
+    tTimerHdl   timerHdlModify = 0;
+    tTimerHdl   timerHdlDelete = 0;
+    tTimerArg   argument;
+
+    stub_resetTimerEvents();
+
+    setArgument(&argument, 1);
+    CU_ASSERT_EQUAL(timeru_modifyTimer(&timerHdlModify, 20, &argument), kErrorOk);
+    CU_ASSERT_NOT_EQUAL(timerHdlModify, 0);
+    CU_ASSERT_EQUAL(timeru_setTimer(&timerHdlDelete, 20, &argument), kErrorOk);
+
+    setArgument(&argument, 2);
+    CU_ASSERT_EQUAL(timeru_modifyTimer(&timerHdlModify, 80, &argument), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdlDelete), kErrorOk);
+    CU_ASSERT_EQUAL(timerHdlDelete, 0);
+    CU_ASSERT_FALSE(timeru_isActive(timerHdlDelete));
+
+    CU_ASSERT_FALSE(stub_waitTimerEvents(1, 50));
+    CU_ASSERT_TRUE(timeru_isActive(timerHdlModify));
+
+    CU_ASSERT_TRUE_FATAL(stub_waitTimerEvents(1, 1000));
+    CU_ASSERT_EQUAL(stub_getTimerEventArg(0), 2);
+
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdlModify), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test timers exceeding one wheel round
+
+The two timers use the same wheel slot, the longer one must survive the expiry
+of the shorter one.
+*/
+//------------------------------------------------------------------------------
+void test_timeru_wheelRounds(void)
+{
+    tTimerHdl   timerHdlShort = 0;
+    tTimerHdl   timerHdlLong = 0;
+    tTimerArg   argument;
+
+    stub_resetTimerEvents();
+
+    setArgument(&argument, 300);
+    CU_ASSERT_EQUAL(timeru_setTimer(&timerHdlLong, 300, &argument), kErrorOk);
+    setArgument(&argument, 44);
+    CU_ASSERT_EQUAL(timeru_setTimer(&timerHdlShort, 44, &argument), kErrorOk);
+
+    CU_ASSERT_TRUE_FATAL(stub_waitTimerEvents(1, 1000));
+    CU_ASSERT_EQUAL(stub_getTimerEventArg(0), 44);
+    CU_ASSERT_TRUE(timeru_isActive(timerHdlLong));
+
+    CU_ASSERT_TRUE_FATAL(stub_waitTimerEvents(2, 1000));
+    CU_ASSERT_EQUAL(stub_getTimerEventArg(1), 300);
+
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdlShort), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdlLong), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark the MN boot-up timer pattern
+
+Every CN owns a StatusRequest timer and a timer for the longer boot steps like
+the MN NMT module. Both are restarted with every state change of the CN. At the
+end, all StatusRequest timers expire at the same time.
+*/
+//------------------------------------------------------------------------------
+void test_timeru_bootSequence(void)
+{
+    tTimerArg   argument;
+    UINT        round;
+    UINT        node;
+    UINT32      errorCount = 0;
+    double      startTime;
+    double      restartSeconds;
+    double      expirySeconds;
+
+    stub_resetTimerEvents();
+    OPLK_MEMSET(aTimerHdlStatReq_l, 0, sizeof(aTimerHdlStatReq_l));
+    OPLK_MEMSET(aTimerHdlLonger_l, 0, sizeof(aTimerHdlLonger_l));
+
+    startTime = getSeconds();
+    for (round = 0; round < TEST_BOOT_ROUNDS; round++)
+    {
+        for (node = 0; node < TEST_NODE_COUNT; node++)
+        {
+            setArgument(&argument, (round << 8) | node);
+            if (timeru_modifyTimer(&aTimerHdlStatReq_l[node],
+                                   TEST_STATREQ_TIMEOUT + (node % 16),
+                                   &argument) != kErrorOk)
+                errorCount++;
+
+            if ((round % 4) == 3)
+            {
+                if (timeru_deleteTimer(&aTimerHdlLonger_l[node]) != kErrorOk)
+                    errorCount++;
+            }
+            else
+            {
+                if (timeru_modifyTimer(&aTimerHdlLonger_l[node],
+                                       TEST_LONGER_TIMEOUT,
+                                       &argument) != kErrorOk)
+                    errorCount++;
+            }
+        }
+    }
+    restartSeconds = getSeconds() - startTime;
+
+    CU_ASSERT_EQUAL(errorCount, 0);
+    CU_ASSERT_EQUAL(stub_getTimerEventCount(), 0);
+
+    startTime = getSeconds();
+    for (node = 0; node < TEST_NODE_COUNT; node++)
+    {
+        setArgument(&argument, node);
+        timeru_deleteTimer(&aTimerHdlLonger_l[node]);
+        timeru_modifyTimer(&aTimerHdlStatReq_l[node], TEST_EXPIRY_TIMEOUT, &argument);
+    }
+    CU_ASSERT_TRUE(stub_waitTimerEvents(TEST_NODE_COUNT, 1000));
+    expirySeconds = getSeconds() - startTime;
+
+    for (node = 0; node < TEST_NODE_COUNT; node++)
+        timeru_deleteTimer(&aTimerHdlStatReq_l[node]);
+
+    printf("\n    %u CNs x %u state changes: %.0f timer restarts/s, "
+           "%u timers of %u ms expired after %.1f ms\n",
+           TEST_NODE_COUNT, TEST_BOOT_ROUNDS,
+           (2.0 * TEST_NODE_COUNT * TEST_BOOT_ROUNDS) / restartSeconds,
+           TEST_NODE_COUNT, TEST_EXPIRY_TIMEOUT, expirySeconds * 1000.0);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up a timer argument
+
+\param[out]     pArgument_p         Timer argument to set up.
+\param[in]      value_p             Value of the timer argument.
+*/
+//------------------------------------------------------------------------------
+static void setArgument(tTimerArg* pArgument_p, UINT32 value_p)
+{
+    OPLK_MEMSET(pArgument_p, 0, sizeof(tTimerArg));
+    pArgument_p->eventSink = kEventSinkNmtMnu;
+    pArgument_p->argument.value = value_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the monotonic time in seconds
+
+\return The function returns the current monotonic time in seconds.
+*/
+//------------------------------------------------------------------------------
+static double getSeconds(void)
+{
+    struct timespec currentTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+    return (double)currentTime.tv_sec + ((double)currentTime.tv_nsec / 1e9);
+}